@@ -167,6 +167,7 @@ RZ_API RzAnalysis *rz_analysis_free(RzAnalysis *a) {
 	ht_pp_free(a->ht_global_var);
 	rz_list_free(a->plugins);
 	rz_analysis_debug_info_free(a->debug_info);
+	ht_uu_free(a->coverage);
 	free(a);
 	return NULL;
 }
@@ -298,6 +299,43 @@ RZ_API bool rz_analysis_set_bits(RzAnalysis *analysis, int bits) {
 	return false;
 }
 
+/**
+ * \brief Switch the instruction decoding mode, like ARM/Thumb, to \p bits
+ *
+ * Unlike rz_analysis_set_bits() this does not reload the type database, as it
+ * describes the whole program and not the encoding of single instructions, and
+ * only sets up the register profile again if the size of the addresses changes.
+ * The sizes of the type database still follow, so that e.g. pointers get the
+ * right size after a x86 16/32 bits switch.
+ * Mixed-mode code switches the bits for many instructions so this has to be cheap.
+ */
+RZ_API bool rz_analysis_set_mode_bits(RZ_NONNULL RzAnalysis *analysis, int bits) {
+	rz_return_val_if_fail(analysis, false);
+	if (analysis->bits == bits) {
+		return true;
+	}
+	switch (bits) {
+	case 8:
+	case 16:
+	case 27:
+	case 32:
+	case 64:
+		break;
+	default:
+		return false;
+	}
+	int address_bits = rz_analysis_get_address_bits(analysis);
+	analysis->bits = bits;
+	int v = rz_analysis_archinfo(analysis, RZ_ANALYSIS_ARCHINFO_TEXT_ALIGN);
+	analysis->pcalign = RZ_MAX(0, v);
+	rz_type_db_set_bits(analysis->typedb, bits);
+	rz_type_db_set_address_bits(analysis->typedb, rz_analysis_get_address_bits(analysis));
+	if (rz_analysis_get_address_bits(analysis) != address_bits) {
+		rz_analysis_set_reg_profile(analysis);
+	}
+	return true;
+}
+
 /**
  * \brief The actual size of an address in bits.
  *
@@ -6,4 +6,6 @@
 
 #include <rz_analysis.h>
 
+RZ_IPI void rz_analysis_block_invalidate_cfgs(RZ_NONNULL RzAnalysisBlock *block);
+
 #endif // RZ_ANALYSIS_PRIVATE_H
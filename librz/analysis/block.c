@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: LGPL-3.0-only
 
 #include <rz_analysis.h>
+#include "analysis_private.h"
 #include <rz_hash.h>
 #include <rz_util/ht_uu.h>
 #include <assert.h>
@@ -224,6 +225,8 @@ RZ_API bool rz_analysis_block_relocate(RzAnalysisBlock *block, ut64 addr, ut64 s
 	RzAnalysisFunction *fcn;
 	RzListIter *iter;
 	rz_list_foreach (block->fcns, iter, fcn) {
+		// The edges pointing to the old address don't reach the block anymore
+		rz_analysis_function_invalidate_cfg(fcn);
 		if (fcn->meta._min != UT64_MAX) {
 			if (addr + size > fcn->meta._max) {
 				// we extend after the maximum, so we are the maximum afterwards.
@@ -332,7 +335,7 @@ RZ_API bool rz_analysis_block_merge(RzAnalysisBlock *a, RzAnalysisBlock *b) {
 	RzAnalysisFunction *fcn;
 	RzListIter *iter;
 	rz_list_foreach (a->fcns, iter, fcn) {
-		if (!rz_list_contains(b->fcns, fcn)) {
+		if (!rz_analysis_function_contains_block(fcn, b)) {
 			return false;
 		}
 	}
@@ -364,9 +367,10 @@ RZ_API bool rz_analysis_block_merge(RzAnalysisBlock *a, RzAnalysisBlock *b) {
 	// kill b completely
 	rz_rbtree_aug_delete(&a->analysis->bb_tree, &b->addr, __bb_addr_cmp, NULL, __block_free_rb, NULL, __max_end);
 
-	// invalidate ranges of a's functions
+	// invalidate ranges and graphs of a's functions
 	rz_list_foreach (a->fcns, iter, fcn) {
 		fcn->meta._min = UT64_MAX;
+		rz_analysis_function_invalidate_cfg(fcn);
 	}
 
 	return true;
@@ -577,11 +581,25 @@ RZ_API RzList /*<RzAnalysisBlock *>*/ *rz_analysis_block_recurse_list(RzAnalysis
 	return ret;
 }
 
+/**
+ * \brief Drops the cached CFG of all the functions of \p block
+ *
+ * Must be called whenever the edges of the block change.
+ */
+RZ_IPI void rz_analysis_block_invalidate_cfgs(RZ_NONNULL RzAnalysisBlock *block) {
+	RzListIter *iter;
+	RzAnalysisFunction *fcn;
+	rz_list_foreach (block->fcns, iter, fcn) {
+		rz_analysis_function_invalidate_cfg(fcn);
+	}
+}
+
 RZ_API void rz_analysis_block_add_switch_case(RzAnalysisBlock *block, ut64 switch_addr, ut64 case_value, ut64 case_addr) {
 	if (!block->switch_op) {
 		block->switch_op = rz_analysis_switch_op_new(switch_addr, 0, 0, 0);
 	}
 	rz_analysis_switch_op_add_case(block->switch_op, case_addr, case_value, case_addr);
+	rz_analysis_block_invalidate_cfgs(block);
 }
 
 RZ_API bool rz_analysis_block_op_starts_at(RzAnalysisBlock *bb, ut64 addr) {
@@ -753,7 +771,7 @@ static bool noreturn_successors_reachable_cb(RzAnalysisBlock *block, void *user)
 static bool noreturn_remove_unreachable_cb(void *user, const ut64 k, const void *v) {
 	RzAnalysisFunction *fcn = user;
 	NoreturnSuccessor *succ = (NoreturnSuccessor *)v;
-	if (!succ->reachable && rz_list_contains(succ->block->fcns, fcn)) {
+	if (!succ->reachable && rz_analysis_function_contains_block(fcn, succ->block)) {
 		rz_analysis_function_remove_block(fcn, succ->block);
 	}
 	succ->reachable = false; // reset for next iteration
@@ -790,15 +808,16 @@ RZ_API RzAnalysisBlock *rz_analysis_block_chop_noreturn(RzAnalysisBlock *block,
 	block->fail = UT64_MAX;
 	rz_analysis_switch_op_free(block->switch_op);
 	block->switch_op = NULL;
-
-	// Now, for each fcn, check which of our successors are still reachable in the function remove and the ones that are not.
+	rz_analysis_block_invalidate_cfgs(block);
 	RzListIter *it;
 	RzAnalysisFunction *fcn;
+
+	// Now, for each fcn, check which of our successors are still reachable in the function remove and the ones that are not.
 	// We need to clone the list because block->fcns will get modified in the loop
 	RzList *fcns_cpy = rz_list_clone(block->fcns);
 	rz_list_foreach (fcns_cpy, it, fcn) {
 		RzAnalysisBlock *entry = rz_analysis_get_block_at(block->analysis, fcn->addr);
-		if (entry && rz_list_contains(entry->fcns, fcn)) {
+		if (entry && rz_analysis_function_contains_block(fcn, entry)) {
 			rz_analysis_block_recurse(entry, noreturn_successors_reachable_cb, succs);
 		}
 		ht_up_foreach(succs, noreturn_remove_unreachable_cb, fcn);
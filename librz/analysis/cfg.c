@@ -0,0 +1,718 @@
+// SPDX-FileCopyrightText: 2023 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+/** \file cfg.c
+ * Dominators, post-dominators, natural loops and strongly connected
+ * components of the control flow graph of a function.
+ *
+ * The dominator trees are built with the iterative algorithm from
+ * "A Simple, Fast Dominance Algorithm" by Cooper, Harvey and Kennedy.
+ */
+
+#include <rz_analysis.h>
+
+#define NONE SIZE_MAX
+
+/**
+ * Adjacency lists of a graph with nodes numbered from 0 to n - 1
+ */
+typedef struct {
+	size_t n;
+	RzVector /*<size_t>*/ *succs;
+	RzVector /*<size_t>*/ *preds;
+} Graph;
+
+static bool graph_init(Graph *g, size_t n) {
+	g->n = n;
+	g->succs = RZ_NEWS0(RzVector, n);
+	g->preds = RZ_NEWS0(RzVector, n);
+	if (!g->succs || !g->preds) {
+		free(g->succs);
+		free(g->preds);
+		return false;
+	}
+	for (size_t i = 0; i < n; i++) {
+		rz_vector_init(&g->succs[i], sizeof(size_t), NULL, NULL);
+		rz_vector_init(&g->preds[i], sizeof(size_t), NULL, NULL);
+	}
+	return true;
+}
+
+static void graph_fini(Graph *g) {
+	for (size_t i = 0; i < g->n; i++) {
+		rz_vector_fini(&g->succs[i]);
+		rz_vector_fini(&g->preds[i]);
+	}
+	free(g->succs);
+	free(g->preds);
+}
+
+static void graph_add_edge(Graph *g, size_t from, size_t to) {
+	size_t *it;
+	rz_vector_foreach(&g->succs[from], it) {
+		if (*it == to) {
+			return;
+		}
+	}
+	rz_vector_push(&g->succs[from], &to);
+	rz_vector_push(&g->preds[to], &from);
+}
+
+typedef struct {
+	size_t node;
+	size_t next; ///< index of the next successor to visit
+} DfsFrame;
+
+/**
+ * Computes the reverse postorder of the nodes reachable from \p root.
+ * \p rpo_num receives the position of each node in it, NONE for the unreachable ones.
+ */
+static bool graph_rpo(Graph *g, size_t root, RzVector /*<size_t>*/ *rpo, size_t *rpo_num) {
+	bool *visited = RZ_NEWS0(bool, g->n);
+	if (!visited) {
+		return false;
+	}
+	RzVector stack;
+	rz_vector_init(&stack, sizeof(DfsFrame), NULL, NULL);
+	DfsFrame frame = { root, 0 };
+	rz_vector_push(&stack, &frame);
+	visited[root] = true;
+	while (!rz_vector_empty(&stack)) {
+		DfsFrame *top = rz_vector_tail(&stack);
+		RzVector *succs = &g->succs[top->node];
+		if (top->next < rz_vector_len(succs)) {
+			size_t succ = *(size_t *)rz_vector_index_ptr(succs, top->next++);
+			if (!visited[succ]) {
+				visited[succ] = true;
+				frame.node = succ;
+				frame.next = 0;
+				rz_vector_push(&stack, &frame);
+			}
+			continue;
+		}
+		rz_vector_push(rpo, &top->node);
+		rz_vector_pop(&stack, NULL);
+	}
+	rz_vector_fini(&stack);
+	free(visited);
+
+	// The postorder was collected, reverse it
+	size_t len = rz_vector_len(rpo);
+	size_t *order = rz_vector_index_ptr(rpo, 0);
+	for (size_t i = 0; i < len / 2; i++) {
+		size_t tmp = order[i];
+		order[i] = order[len - 1 - i];
+		order[len - 1 - i] = tmp;
+	}
+	for (size_t i = 0; i < g->n; i++) {
+		rpo_num[i] = NONE;
+	}
+	for (size_t i = 0; i < len; i++) {
+		rpo_num[order[i]] = i;
+	}
+	return true;
+}
+
+static size_t intersect(size_t *idom, size_t *rpo_num, size_t a, size_t b) {
+	while (a != b) {
+		while (rpo_num[a] > rpo_num[b]) {
+			a = idom[a];
+		}
+		while (rpo_num[b] > rpo_num[a]) {
+			b = idom[b];
+		}
+	}
+	return a;
+}
+
+/**
+ * Computes the immediate dominators of the nodes reachable from \p root,
+ * NONE for the root and the unreachable nodes.
+ */
+static bool graph_idoms(Graph *g, size_t root, size_t *idom) {
+	RzVector rpo;
+	rz_vector_init(&rpo, sizeof(size_t), NULL, NULL);
+	size_t *rpo_num = RZ_NEWS(size_t, g->n);
+	if (!rpo_num || !graph_rpo(g, root, &rpo, rpo_num)) {
+		free(rpo_num);
+		rz_vector_fini(&rpo);
+		return false;
+	}
+	for (size_t i = 0; i < g->n; i++) {
+		idom[i] = NONE;
+	}
+	idom[root] = root;
+	bool changed = true;
+	while (changed) {
+		changed = false;
+		size_t *it;
+		rz_vector_foreach(&rpo, it) {
+			size_t node = *it;
+			if (node == root) {
+				continue;
+			}
+			size_t new_idom = NONE;
+			size_t *pred;
+			rz_vector_foreach(&g->preds[node], pred) {
+				if (idom[*pred] == NONE) {
+					continue;
+				}
+				new_idom = new_idom == NONE ? *pred : intersect(idom, rpo_num, *pred, new_idom);
+			}
+			if (idom[node] != new_idom) {
+				idom[node] = new_idom;
+				changed = true;
+			}
+		}
+	}
+	idom[root] = NONE;
+	free(rpo_num);
+	rz_vector_fini(&rpo);
+	return true;
+}
+
+/**
+ * Numbers the nodes of the tree given by \p parent in preorder and postorder,
+ * so that a node is an ancestor of another iff its interval contains the other one.
+ */
+static bool tree_intervals(size_t n, size_t root, const size_t *parent, size_t *pre, size_t *post) {
+	Graph tree;
+	if (!graph_init(&tree, n)) {
+		return false;
+	}
+	for (size_t i = 0; i < n; i++) {
+		pre[i] = NONE;
+		post[i] = NONE;
+		if (parent[i] != NONE) {
+			graph_add_edge(&tree, parent[i], i);
+		}
+	}
+	RzVector stack;
+	rz_vector_init(&stack, sizeof(DfsFrame), NULL, NULL);
+	DfsFrame frame = { root, 0 };
+	rz_vector_push(&stack, &frame);
+	size_t pre_count = 0, post_count = 0;
+	pre[root] = pre_count++;
+	while (!rz_vector_empty(&stack)) {
+		DfsFrame *top = rz_vector_tail(&stack);
+		RzVector *children = &tree.succs[top->node];
+		if (top->next < rz_vector_len(children)) {
+			frame.node = *(size_t *)rz_vector_index_ptr(children, top->next++);
+			frame.next = 0;
+			pre[frame.node] = pre_count++;
+			rz_vector_push(&stack, &frame);
+			continue;
+		}
+		post[top->node] = post_count++;
+		rz_vector_pop(&stack, NULL);
+	}
+	rz_vector_fini(&stack);
+	graph_fini(&tree);
+	return true;
+}
+
+/**
+ * Tarjan's algorithm, without recursion
+ */
+static bool graph_sccs(Graph *g, size_t *scc, size_t *n_sccs) {
+	size_t *num = RZ_NEWS(size_t, g->n);
+	size_t *low = RZ_NEWS(size_t, g->n);
+	bool *on_stack = RZ_NEWS0(bool, g->n);
+	if (!num || !low || !on_stack) {
+		free(num);
+		free(low);
+		free(on_stack);
+		return false;
+	}
+	for (size_t i = 0; i < g->n; i++) {
+		num[i] = NONE;
+		scc[i] = NONE;
+	}
+	RzVector calls, stack;
+	rz_vector_init(&calls, sizeof(DfsFrame), NULL, NULL);
+	rz_vector_init(&stack, sizeof(size_t), NULL, NULL);
+	size_t counter = 0;
+	*n_sccs = 0;
+	for (size_t start = 0; start < g->n; start++) {
+		if (num[start] != NONE) {
+			continue;
+		}
+		DfsFrame frame = { start, 0 };
+		rz_vector_push(&calls, &frame);
+		num[start] = low[start] = counter++;
+		rz_vector_push(&stack, &start);
+		on_stack[start] = true;
+		while (!rz_vector_empty(&calls)) {
+			DfsFrame *top = rz_vector_tail(&calls);
+			size_t node = top->node;
+			RzVector *succs = &g->succs[node];
+			if (top->next < rz_vector_len(succs)) {
+				size_t succ = *(size_t *)rz_vector_index_ptr(succs, top->next++);
+				if (num[succ] == NONE) {
+					num[succ] = low[succ] = counter++;
+					rz_vector_push(&stack, &succ);
+					on_stack[succ] = true;
+					frame.node = succ;
+					frame.next = 0;
+					rz_vector_push(&calls, &frame);
+				} else if (on_stack[succ] && num[succ] < low[node]) {
+					low[node] = num[succ];
+				}
+				continue;
+			}
+			if (low[node] == num[node]) {
+				size_t member;
+				do {
+					rz_vector_pop(&stack, &member);
+					on_stack[member] = false;
+					scc[member] = *n_sccs;
+				} while (member != node);
+				(*n_sccs)++;
+			}
+			rz_vector_pop(&calls, NULL);
+			if (!rz_vector_empty(&calls)) {
+				DfsFrame *caller = rz_vector_tail(&calls);
+				if (low[node] < low[caller->node]) {
+					low[caller->node] = low[node];
+				}
+			}
+		}
+	}
+	rz_vector_fini(&calls);
+	rz_vector_fini(&stack);
+	free(num);
+	free(low);
+	free(on_stack);
+	return true;
+}
+
+typedef struct {
+	size_t header;
+	RzVector /*<size_t>*/ body;
+} LoopBody;
+
+static void loop_body_fini(void *e, void *user) {
+	LoopBody *loop = e;
+	rz_vector_fini(&loop->body);
+}
+
+static int loop_body_cmp(const void *a, const void *b) {
+	const LoopBody *la = a;
+	const LoopBody *lb = b;
+	size_t sa = rz_vector_len(&la->body);
+	size_t sb = rz_vector_len(&lb->body);
+	if (sa != sb) {
+		return sa > sb ? -1 : 1;
+	}
+	return la->header < lb->header ? -1 : la->header > lb->header ? 1
+									: 0;
+}
+
+/**
+ * Collects the natural loops: for every header, the blocks reaching one
+ * of its back edges without going through the header.
+ */
+static bool cfg_loops(RzAnalysisCFG *cfg, Graph *g) {
+	RzVector bodies;
+	rz_vector_init(&bodies, sizeof(LoopBody), loop_body_fini, NULL);
+	size_t *mark = RZ_NEWS(size_t, g->n);
+	if (!mark) {
+		return false;
+	}
+	for (size_t i = 0; i < g->n; i++) {
+		mark[i] = NONE;
+	}
+	RzAnalysisCFGNode *nodes = rz_vector_index_ptr(&cfg->nodes, 0);
+	size_t n = rz_vector_len(&cfg->nodes);
+	RzVector work;
+	rz_vector_init(&work, sizeof(size_t), NULL, NULL);
+	for (size_t header = 0; header < n; header++) {
+		if (nodes[header].dom_pre == NONE) {
+			continue;
+		}
+		LoopBody *loop = NULL;
+		size_t *pred;
+		rz_vector_foreach(&g->preds[header], pred) {
+			// A back edge goes to a block dominating its source
+			RzAnalysisCFGNode *src = &nodes[*pred];
+			if (src->dom_pre == NONE || nodes[header].dom_pre > src->dom_pre || src->dom_post > nodes[header].dom_post) {
+				continue;
+			}
+			if (!loop) {
+				loop = rz_vector_push(&bodies, NULL);
+				if (!loop) {
+					break;
+				}
+				loop->header = header;
+				rz_vector_init(&loop->body, sizeof(size_t), NULL, NULL);
+				rz_vector_push(&loop->body, &header);
+				mark[header] = header;
+			}
+			if (mark[*pred] != header) {
+				mark[*pred] = header;
+				rz_vector_push(&loop->body, pred);
+				rz_vector_push(&work, pred);
+			}
+		}
+		while (loop && !rz_vector_empty(&work)) {
+			size_t node;
+			rz_vector_pop(&work, &node);
+			rz_vector_foreach(&g->preds[node], pred) {
+				if (mark[*pred] != header && nodes[*pred].dom_pre != NONE) {
+					mark[*pred] = header;
+					rz_vector_push(&loop->body, pred);
+					rz_vector_push(&work, pred);
+				}
+			}
+		}
+		rz_vector_clear(&work);
+	}
+	rz_vector_fini(&work);
+	free(mark);
+
+	// The enclosing loops are bigger, so they are processed first and
+	// the innermost loop of each block is the last one assigned to it
+	rz_vector_sort(&bodies, loop_body_cmp, false);
+	LoopBody *body;
+	rz_vector_foreach(&bodies, body) {
+		RzAnalysisLoop *loop = rz_vector_push(&cfg->loops, NULL);
+		if (!loop) {
+			break;
+		}
+		size_t idx = rz_vector_len(&cfg->loops) - 1;
+		loop->header = rz_pvector_at(&cfg->blocks, body->header);
+		loop->parent = nodes[body->header].loop;
+		loop->depth = loop->parent == NONE ? 1 : ((RzAnalysisLoop *)rz_vector_index_ptr(&cfg->loops, loop->parent))->depth + 1;
+		loop->size = rz_vector_len(&body->body);
+		size_t *it;
+		rz_vector_foreach(&body->body, it) {
+			nodes[*it].loop = idx;
+		}
+	}
+	rz_vector_fini(&bodies);
+	return true;
+}
+
+typedef struct {
+	RzAnalysisCFG *cfg;
+	Graph *g;
+	size_t from;
+	RzAnalysis *analysis;
+} EdgeCtx;
+
+static size_t cfg_index(RzAnalysisCFG *cfg, RzAnalysisBlock *bb) {
+	bool found = false;
+	size_t idx = (size_t)ht_up_find(cfg->index, (ut64)(size_t)bb, &found);
+	return found ? idx : NONE;
+}
+
+static bool add_edge_cb(ut64 addr, void *user) {
+	EdgeCtx *ctx = user;
+	RzAnalysisBlock *bb = rz_analysis_get_block_at(ctx->analysis, addr);
+	size_t to = bb ? cfg_index(ctx->cfg, bb) : NONE;
+	if (to != NONE) {
+		graph_add_edge(ctx->g, ctx->from, to);
+	}
+	return true;
+}
+
+static int block_cmp_addr(const void *a, const void *b) {
+	const RzAnalysisBlock *ba = a;
+	const RzAnalysisBlock *bb = b;
+	return ba->addr < bb->addr ? -1 : ba->addr > bb->addr ? 1
+							      : 0;
+}
+
+static void cfg_free(RzAnalysisCFG *cfg) {
+	if (!cfg) {
+		return;
+	}
+	rz_pvector_fini(&cfg->blocks);
+	rz_vector_fini(&cfg->nodes);
+	rz_vector_fini(&cfg->loops);
+	ht_up_free(cfg->index);
+	free(cfg);
+}
+
+/**
+ * \brief Computes the metrics shown by afi and afll
+ *
+ * The loops are counted as the edges to a lower address and the complexity counts all
+ * the edges, also the ones leaving the function, as these metrics always did.
+ */
+static void cfg_metrics(RzAnalysisCFG *cfg, RzAnalysisFunction *fcn) {
+	int E = 0, N = 0, P = 0;
+	void **it;
+	rz_pvector_foreach (&cfg->blocks, it) {
+		RzAnalysisBlock *bb = *it;
+		if (bb->jump != UT64_MAX && bb->jump < bb->addr) {
+			cfg->n_back_jumps++;
+		}
+		if (bb->fail != UT64_MAX && bb->fail < bb->addr) {
+			cfg->n_back_jumps++;
+		}
+		N++; // nodes
+		if (bb->jump == UT64_MAX && bb->fail != UT64_MAX) {
+			RZ_LOG_DEBUG("invalid bb jump/fail pair at 0x%08" PFMT64x " (fcn 0x%08" PFMT64x "\n", bb->addr, fcn->addr);
+		}
+		if (bb->jump == UT64_MAX && bb->fail == UT64_MAX) {
+			P++; // exit nodes
+		} else {
+			E++; // edges
+			if (bb->fail != UT64_MAX) {
+				E++;
+			}
+		}
+		if (bb->switch_op && bb->switch_op->cases) {
+			E += rz_list_length(bb->switch_op->cases);
+		}
+	}
+	cfg->complexity = E - N + (2 * P);
+	if (cfg->complexity < 1) {
+		RZ_LOG_DEBUG("CC = E(%d) - N(%d) + (2 * P(%d)) < 1 at 0x%08" PFMT64x "\n", E, N, P, fcn->addr);
+	}
+}
+
+static bool cfg_build(RzAnalysisCFG *cfg, RzAnalysisFunction *fcn) {
+	RzListIter *iter;
+	RzAnalysisBlock *bb;
+	rz_list_foreach (fcn->bbs, iter, bb) {
+		if (!rz_pvector_push(&cfg->blocks, bb)) {
+			return false;
+		}
+	}
+	rz_pvector_sort(&cfg->blocks, block_cmp_addr);
+	size_t n = rz_pvector_len(&cfg->blocks);
+	cfg->entry = NONE;
+	for (size_t i = 0; i < n; i++) {
+		bb = rz_pvector_at(&cfg->blocks, i);
+		ht_up_insert(cfg->index, (ut64)(size_t)bb, (void *)i);
+		if (bb->addr == fcn->addr) {
+			cfg->entry = i;
+		}
+	}
+	cfg_metrics(cfg, fcn);
+	RzAnalysisCFGNode *nodes = rz_vector_insert_range(&cfg->nodes, 0, NULL, n);
+	if (n && !nodes) {
+		return false;
+	}
+
+	// One more node, the virtual exit, for the post-dominators
+	const size_t exit = n;
+	Graph g;
+	if (!graph_init(&g, n + 1)) {
+		return false;
+	}
+	EdgeCtx ctx = { cfg, &g, 0, fcn->analysis };
+	for (size_t i = 0; i < n; i++) {
+		ctx.from = i;
+		rz_analysis_block_successor_addrs_foreach(rz_pvector_at(&cfg->blocks, i), add_edge_cb, &ctx);
+	}
+	bool ret = false;
+	size_t *idom = RZ_NEWS(size_t, n + 1);
+	size_t *pre = RZ_NEWS(size_t, n + 1);
+	size_t *post = RZ_NEWS(size_t, n + 1);
+	size_t *scc = RZ_NEWS(size_t, n + 1);
+	Graph rev = { 0 };
+	if (!idom || !pre || !post || !scc || !graph_init(&rev, n + 1)) {
+		goto beach;
+	}
+	for (size_t i = 0; i < n; i++) {
+		nodes[i].idom = nodes[i].ipdom = NONE;
+		nodes[i].dom_pre = nodes[i].dom_post = NONE;
+		nodes[i].pdom_pre = nodes[i].pdom_post = NONE;
+		nodes[i].loop = NONE;
+	}
+
+	if (cfg->entry != NONE) {
+		if (!graph_idoms(&g, cfg->entry, idom) || !tree_intervals(n + 1, cfg->entry, idom, pre, post)) {
+			goto beach;
+		}
+		for (size_t i = 0; i < n; i++) {
+			nodes[i].idom = idom[i];
+			nodes[i].dom_pre = pre[i];
+			nodes[i].dom_post = post[i];
+		}
+	}
+
+	// The post-dominators are the dominators of the reversed graph,
+	// where the virtual exit precedes all the blocks without successors
+	for (size_t i = 0; i < n; i++) {
+		size_t *succ;
+		rz_vector_foreach(&g.succs[i], succ) {
+			graph_add_edge(&rev, *succ, i);
+		}
+		if (rz_vector_empty(&g.succs[i])) {
+			graph_add_edge(&rev, exit, i);
+		}
+	}
+	if (!graph_idoms(&rev, exit, idom) || !tree_intervals(n + 1, exit, idom, pre, post)) {
+		goto beach;
+	}
+	for (size_t i = 0; i < n; i++) {
+		nodes[i].ipdom = idom[i] == exit ? NONE : idom[i];
+		nodes[i].pdom_pre = pre[i];
+		nodes[i].pdom_post = post[i];
+	}
+
+	// The virtual exit has no edges in g, so it is a component on its own
+	size_t n_sccs;
+	if (!graph_sccs(&g, scc, &n_sccs)) {
+		goto beach;
+	}
+	cfg->n_sccs = n_sccs - 1;
+	// Renumber the components in the address order of their first block
+	size_t *renum = RZ_NEWS(size_t, n_sccs);
+	if (!renum) {
+		goto beach;
+	}
+	for (size_t i = 0; i < n_sccs; i++) {
+		renum[i] = NONE;
+	}
+	size_t next_scc = 0;
+	for (size_t i = 0; i < n; i++) {
+		if (renum[scc[i]] == NONE) {
+			renum[scc[i]] = next_scc++;
+		}
+		nodes[i].scc = renum[scc[i]];
+	}
+	free(renum);
+
+	ret = cfg_loops(cfg, &g);
+beach:
+	free(idom);
+	free(pre);
+	free(post);
+	free(scc);
+	if (rev.succs) {
+		graph_fini(&rev);
+	}
+	graph_fini(&g);
+	return ret;
+}
+
+/**
+ * \brief Returns the dominators, post-dominators, loops and SCCs of \p fcn
+ *
+ * The result is computed on the first call and cached in the function until
+ * its blocks change. The returned pointer must not be kept across changes.
+ */
+RZ_API RZ_BORROW RzAnalysisCFG *rz_analysis_function_get_cfg(RZ_NONNULL RzAnalysisFunction *fcn) {
+	rz_return_val_if_fail(fcn, NULL);
+	if (fcn->cfg) {
+		return fcn->cfg;
+	}
+	RzAnalysisCFG *cfg = RZ_NEW0(RzAnalysisCFG);
+	if (!cfg) {
+		return NULL;
+	}
+	rz_pvector_init(&cfg->blocks, NULL);
+	rz_vector_init(&cfg->nodes, sizeof(RzAnalysisCFGNode), NULL, NULL);
+	rz_vector_init(&cfg->loops, sizeof(RzAnalysisLoop), NULL, NULL);
+	cfg->index = ht_up_new0();
+	if (!cfg->index || !cfg_build(cfg, fcn)) {
+		cfg_free(cfg);
+		return NULL;
+	}
+	fcn->cfg = cfg;
+	return cfg;
+}
+
+/**
+ * \brief Drops the cached control flow analyses of \p fcn
+ *
+ * Must be called when the edges between the blocks of the function
+ * are changed without adding or removing blocks.
+ */
+RZ_API void rz_analysis_function_invalidate_cfg(RZ_NONNULL RzAnalysisFunction *fcn) {
+	rz_return_if_fail(fcn);
+	cfg_free(fcn->cfg);
+	fcn->cfg = NULL;
+}
+
+static RzAnalysisCFGNode *cfg_node(RzAnalysisFunction *fcn, RzAnalysisBlock *bb, RzAnalysisCFG **out) {
+	RzAnalysisCFG *cfg = rz_analysis_function_get_cfg(fcn);
+	size_t idx = cfg ? cfg_index(cfg, bb) : NONE;
+	if (idx == NONE) {
+		return NULL;
+	}
+	if (out) {
+		*out = cfg;
+	}
+	return rz_vector_index_ptr(&cfg->nodes, idx);
+}
+
+/**
+ * \brief Returns the immediate dominator of \p bb in \p fcn
+ *
+ * \return NULL for the entry block and the blocks not reachable from it
+ */
+RZ_API RZ_BORROW RzAnalysisBlock *rz_analysis_function_idom(RZ_NONNULL RzAnalysisFunction *fcn, RZ_NONNULL RzAnalysisBlock *bb) {
+	rz_return_val_if_fail(fcn && bb, NULL);
+	RzAnalysisCFG *cfg;
+	RzAnalysisCFGNode *node = cfg_node(fcn, bb, &cfg);
+	return node && node->idom != NONE ? rz_pvector_at(&cfg->blocks, node->idom) : NULL;
+}
+
+/**
+ * \brief Returns the immediate post-dominator of \p bb in \p fcn
+ *
+ * \return NULL for the blocks leaving the function and the ones that never reach an exit
+ */
+RZ_API RZ_BORROW RzAnalysisBlock *rz_analysis_function_ipdom(RZ_NONNULL RzAnalysisFunction *fcn, RZ_NONNULL RzAnalysisBlock *bb) {
+	rz_return_val_if_fail(fcn && bb, NULL);
+	RzAnalysisCFG *cfg;
+	RzAnalysisCFGNode *node = cfg_node(fcn, bb, &cfg);
+	return node && node->ipdom != NONE ? rz_pvector_at(&cfg->blocks, node->ipdom) : NULL;
+}
+
+/**
+ * \brief Checks in constant time whether every path from the entry to \p b goes through \p a
+ *
+ * A block dominates itself.
+ */
+RZ_API bool rz_analysis_function_dominates(RZ_NONNULL RzAnalysisFunction *fcn, RZ_NONNULL RzAnalysisBlock *a, RZ_NONNULL RzAnalysisBlock *b) {
+	rz_return_val_if_fail(fcn && a && b, false);
+	RzAnalysisCFGNode *na = cfg_node(fcn, a, NULL);
+	RzAnalysisCFGNode *nb = cfg_node(fcn, b, NULL);
+	if (!na || !nb || na->dom_pre == NONE || nb->dom_pre == NONE) {
+		return false;
+	}
+	return na->dom_pre <= nb->dom_pre && nb->dom_post <= na->dom_post;
+}
+
+/**
+ * \brief Checks in constant time whether every path from \p b to an exit goes through \p a
+ *
+ * A block post-dominates itself.
+ */
+RZ_API bool rz_analysis_function_post_dominates(RZ_NONNULL RzAnalysisFunction *fcn, RZ_NONNULL RzAnalysisBlock *a, RZ_NONNULL RzAnalysisBlock *b) {
+	rz_return_val_if_fail(fcn && a && b, false);
+	RzAnalysisCFGNode *na = cfg_node(fcn, a, NULL);
+	RzAnalysisCFGNode *nb = cfg_node(fcn, b, NULL);
+	if (!na || !nb || na->pdom_pre == NONE || nb->pdom_pre == NONE) {
+		return false;
+	}
+	return na->pdom_pre <= nb->pdom_pre && nb->pdom_post <= na->pdom_post;
+}
+
+/**
+ * \brief Returns the innermost natural loop containing \p bb, NULL if there is none
+ */
+RZ_API RZ_BORROW const RzAnalysisLoop *rz_analysis_function_block_loop(RZ_NONNULL RzAnalysisFunction *fcn, RZ_NONNULL RzAnalysisBlock *bb) {
+	rz_return_val_if_fail(fcn && bb, NULL);
+	RzAnalysisCFG *cfg;
+	RzAnalysisCFGNode *node = cfg_node(fcn, bb, &cfg);
+	return node && node->loop != NONE ? rz_vector_index_ptr(&cfg->loops, node->loop) : NULL;
+}
+
+/**
+ * \brief Returns the id of the strongly connected component of \p bb, SIZE_MAX if it is not in \p fcn
+ *
+ * The components are numbered in the address order of their first block.
+ */
+RZ_API size_t rz_analysis_function_block_scc(RZ_NONNULL RzAnalysisFunction *fcn, RZ_NONNULL RzAnalysisBlock *bb) {
+	rz_return_val_if_fail(fcn && bb, NONE);
+	RzAnalysisCFGNode *node = cfg_node(fcn, bb, NULL);
+	return node ? node->scc : NONE;
+}
@@ -782,8 +782,22 @@ RZ_API RzVector /*<RzAnalysisMethod>*/ *rz_analysis_class_method_get_all(RzAnaly
 	return vec;
 }
 
+/**
+ * Returns the sdb value of the attribute of \p meth, placed at \p addr
+ */
+static char *method_serialize(const RzAnalysisMethod *meth, ut64 addr) {
+	// commas are the sdb array separator, see rz_analysis_class_method_get()
+	char *real_name = rz_str_new(meth->real_name);
+	if (real_name) {
+		real_name = rz_str_replace(real_name, ",", "#_#", 1);
+	}
+	char *content = rz_str_newf("%" PFMT64u "%c%" PFMT64d "%c%" PFMT32u "%c%s", addr, SDB_RS, meth->vtable_offset, SDB_RS, meth->method_type, SDB_RS, real_name);
+	free(real_name);
+	return content;
+}
+
 RZ_API RzAnalysisClassErr rz_analysis_class_method_set(RzAnalysis *analysis, const char *class_name, RzAnalysisMethod *meth) {
-	char *content = rz_str_newf("%" PFMT64u "%c%" PFMT64d "%c%" PFMT32u "%c%s", meth->addr, SDB_RS, meth->vtable_offset, SDB_RS, meth->method_type, SDB_RS, meth->real_name);
+	char *content = method_serialize(meth, meth->addr);
 	if (!content) {
 		return RZ_ANALYSIS_CLASS_ERR_OTHER;
 	}
@@ -1165,6 +1179,13 @@ RZ_API RzVector /*<RzAnalysisVTable>*/ *rz_analysis_class_vtable_get_all(RzAnaly
 	return vec;
 }
 
+/**
+ * Returns the sdb value of the attribute of \p vtable, placed at \p addr
+ */
+static char *vtable_serialize(const RzAnalysisVTable *vtable, ut64 addr) {
+	return rz_str_newf("0x%" PFMT64x SDB_SS "%" PFMT64u SDB_SS "%" PFMT64u, addr, vtable->offset, vtable->size);
+}
+
 RZ_API RzAnalysisClassErr rz_analysis_class_vtable_set(RzAnalysis *analysis, const char *class_name, RzAnalysisVTable *vtable) {
 	/* Check if vtable exists before setting it */
 	RzVector /*<RzAnalysisVTable>*/ *vtables = rz_analysis_class_vtable_get_all(analysis, class_name);
@@ -1179,7 +1200,7 @@ RZ_API RzAnalysisClassErr rz_analysis_class_vtable_set(RzAnalysis *analysis, con
 	}
 	rz_vector_free(vtables);
 
-	char *content = rz_str_newf("0x%" PFMT64x SDB_SS "%" PFMT64u SDB_SS "%" PFMT64u, vtable->addr, vtable->offset, vtable->size);
+	char *content = vtable_serialize(vtable, vtable->addr);
 	if (!content) {
 		return RZ_ANALYSIS_CLASS_ERR_OTHER;
 	}
@@ -1333,6 +1354,49 @@ failure:
 	return NULL;
 }
 
+/**
+ * \brief Moves the methods and vtables of all classes by \p diff
+ *
+ * Their flags are not touched, they are rebased along with all the other flags.
+ */
+RZ_API void rz_analysis_class_rebase(RzAnalysis *analysis, ut64 diff) {
+	rz_return_if_fail(analysis);
+	if (!diff) {
+		return;
+	}
+	SdbList *classes = rz_analysis_class_get_all(analysis, false);
+	SdbListIter *iter;
+	SdbKv *kv;
+	ls_foreach (classes, iter, kv) {
+		const char *name = sdbkv_key(kv);
+		RzVector *methods = rz_analysis_class_method_get_all(analysis, name);
+		if (methods) {
+			RzAnalysisMethod *meth;
+			rz_vector_foreach(methods, meth) {
+				char *content = method_serialize(meth, meth->addr + diff);
+				if (content) {
+					rz_analysis_class_set_attr(analysis, name, RZ_ANALYSIS_CLASS_ATTR_TYPE_METHOD, meth->name, content);
+					free(content);
+				}
+			}
+			rz_vector_free(methods);
+		}
+		RzVector *vtables = rz_analysis_class_vtable_get_all(analysis, name);
+		if (vtables) {
+			RzAnalysisVTable *vtable;
+			rz_vector_foreach(vtables, vtable) {
+				char *content = vtable_serialize(vtable, vtable->addr + diff);
+				if (content) {
+					rz_analysis_class_set_attr(analysis, name, RZ_ANALYSIS_CLASS_ATTR_TYPE_VTABLE, vtable->id, content);
+					free(content);
+				}
+			}
+			rz_vector_free(vtables);
+		}
+	}
+	ls_free(classes);
+}
+
 RZ_API void rz_analysis_class_recover_all(RzAnalysis *analysis) {
 	rz_analysis_class_recover_from_rzbin(analysis);
 	rz_analysis_rtti_recover_all(analysis);
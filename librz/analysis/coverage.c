@@ -0,0 +1,211 @@
+// SPDX-FileCopyrightText: 2023 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+/**
+ * \file coverage.c
+ * Execution coverage imported from external tracers, kept as hit counts per basic block.
+ *
+ * The hits of a block are the highest count of all the hits that intersect it,
+ * which is the number of times the block was executed both for traces of block
+ * starts and for traces of single instructions. Every batch of hits added to the
+ * store is accumulated on top of the previous ones.
+ */
+
+#include <rz_analysis.h>
+
+/**
+ * \brief LSD radix sort of the hits by address, 16 bits at a time
+ *
+ * Traces have millions of entries whose addresses mostly share their upper bits,
+ * so this is much faster than a comparison sort: digits that are equal in all
+ * the hits are skipped and the others take a linear pass each.
+ */
+static bool hits_sort(RzAnalysisCoverageHit *hits, size_t len) {
+	RzAnalysisCoverageHit *tmp = RZ_NEWS(RzAnalysisCoverageHit, len);
+	size_t *counts = RZ_NEWS(size_t, 0x10000);
+	if (!tmp || !counts) {
+		free(tmp);
+		free(counts);
+		return false;
+	}
+	RzAnalysisCoverageHit *src = hits, *dst = tmp;
+	for (int shift = 0; shift < 64; shift += 16) {
+		memset(counts, 0, 0x10000 * sizeof(size_t));
+		for (size_t i = 0; i < len; i++) {
+			counts[(src[i].addr >> shift) & 0xffff]++;
+		}
+		if (counts[(src[0].addr >> shift) & 0xffff] == len) {
+			continue;
+		}
+		size_t pos = 0;
+		for (size_t d = 0; d < 0x10000; d++) {
+			size_t c = counts[d];
+			counts[d] = pos;
+			pos += c;
+		}
+		for (size_t i = 0; i < len; i++) {
+			dst[counts[(src[i].addr >> shift) & 0xffff]++] = src[i];
+		}
+		RzAnalysisCoverageHit *t = src;
+		src = dst;
+		dst = t;
+	}
+	if (src != hits) {
+		memcpy(hits, src, len * sizeof(RzAnalysisCoverageHit));
+	}
+	free(tmp);
+	free(counts);
+	return true;
+}
+
+/**
+ * \brief Sort \p hits by address and merge the ones at the same address
+ *
+ * Merged hits get the sum of the counts and the largest size. This is meant to be
+ * called while hits are collected, to keep their memory bounded by the number of
+ * distinct addresses instead of the length of the trace.
+ */
+RZ_API void rz_analysis_coverage_hits_merge(RZ_NONNULL RzVector /*<RzAnalysisCoverageHit>*/ *hits) {
+	rz_return_if_fail(hits);
+	size_t len = rz_vector_len(hits);
+	if (len < 2) {
+		return;
+	}
+	RzAnalysisCoverageHit *h = rz_vector_index_ptr(hits, 0);
+	if (!hits_sort(h, len)) {
+		return;
+	}
+	size_t n = 0;
+	for (size_t i = 1; i < len; i++) {
+		if (h[i].addr == h[n].addr) {
+			h[n].count += h[i].count;
+			h[n].size = RZ_MAX(h[n].size, h[i].size);
+			continue;
+		}
+		h[++n] = h[i];
+	}
+	rz_vector_remove_range(hits, n + 1, len - n - 1, NULL);
+}
+
+typedef struct {
+	HtUU *batch;
+	ut64 count;
+} CoverageCtx;
+
+static bool block_hit_cb(RzAnalysisBlock *block, void *user) {
+	CoverageCtx *ctx = user;
+	bool found = false;
+	ut64 prev = ht_uu_find(ctx->batch, block->addr, &found);
+	if (!found || prev < ctx->count) {
+		ht_uu_update(ctx->batch, block->addr, ctx->count);
+	}
+	return true;
+}
+
+static bool batch_add_cb(void *user, const ut64 addr, const ut64 count) {
+	HtUU *coverage = user;
+	bool found = false;
+	ut64 prev = ht_uu_find(coverage, addr, &found);
+	ht_uu_update(coverage, addr, prev + count);
+	return true;
+}
+
+/**
+ * \brief Add a batch of coverage hits to the basic blocks they intersect
+ *
+ * \param hits the hits of a single trace, sorted and merged in place
+ * \return the number of basic blocks hit by this batch
+ */
+RZ_API size_t rz_analysis_coverage_add(RZ_NONNULL RzAnalysis *analysis, RZ_NONNULL RzVector /*<RzAnalysisCoverageHit>*/ *hits) {
+	rz_return_val_if_fail(analysis && hits, 0);
+	if (!analysis->coverage) {
+		analysis->coverage = ht_uu_new0();
+		if (!analysis->coverage) {
+			return 0;
+		}
+	}
+	CoverageCtx ctx = { .batch = ht_uu_new0() };
+	if (!ctx.batch) {
+		return 0;
+	}
+	rz_analysis_coverage_hits_merge(hits);
+	RzAnalysisCoverageHit *hit;
+	rz_vector_foreach(hits, hit) {
+		ctx.count = hit->count;
+		rz_analysis_blocks_foreach_intersect(analysis, hit->addr, RZ_MAX(hit->size, 1), block_hit_cb, &ctx);
+	}
+	size_t blocks = ctx.batch->count;
+	ht_uu_foreach(ctx.batch, batch_add_cb, analysis->coverage);
+	ht_uu_free(ctx.batch);
+	return blocks;
+}
+
+/**
+ * \brief Drop all the coverage information
+ */
+RZ_API void rz_analysis_coverage_reset(RZ_NONNULL RzAnalysis *analysis) {
+	rz_return_if_fail(analysis);
+	ht_uu_free(analysis->coverage);
+	analysis->coverage = NULL;
+}
+
+/**
+ * \brief Check whether any coverage has been loaded
+ */
+RZ_API bool rz_analysis_coverage_empty(RZ_NONNULL RzAnalysis *analysis) {
+	rz_return_val_if_fail(analysis, true);
+	return !analysis->coverage || !analysis->coverage->count;
+}
+
+/**
+ * \brief Get the number of times \p block was executed
+ */
+RZ_API ut64 rz_analysis_coverage_block_hits(RZ_NONNULL RzAnalysis *analysis, RZ_NONNULL RzAnalysisBlock *block) {
+	rz_return_val_if_fail(analysis && block, 0);
+	if (!analysis->coverage) {
+		return 0;
+	}
+	return ht_uu_find(analysis->coverage, block->addr, NULL);
+}
+
+/**
+ * \brief Get the number of times the block containing \p addr was executed
+ */
+RZ_API ut64 rz_analysis_coverage_hits_at(RZ_NONNULL RzAnalysis *analysis, ut64 addr) {
+	rz_return_val_if_fail(analysis, 0);
+	if (rz_analysis_coverage_empty(analysis)) {
+		return 0;
+	}
+	RzAnalysisBlock *block = rz_analysis_find_most_relevant_block_in(analysis, addr);
+	return block ? ht_uu_find(analysis->coverage, block->addr, NULL) : 0;
+}
+
+/**
+ * \brief Get the coverage of a function
+ *
+ * \param covered set to the number of basic blocks of \p fcn that were executed
+ * \return the number of times the entry block of \p fcn was executed
+ */
+RZ_API ut64 rz_analysis_coverage_function_hits(RZ_NONNULL RzAnalysis *analysis, RZ_NONNULL RzAnalysisFunction *fcn, RZ_NULLABLE size_t *covered) {
+	rz_return_val_if_fail(analysis && fcn, 0);
+	size_t n = 0;
+	ut64 hits = 0;
+	if (analysis->coverage) {
+		RzListIter *iter;
+		RzAnalysisBlock *block;
+		rz_list_foreach (fcn->bbs, iter, block) {
+			ut64 count = ht_uu_find(analysis->coverage, block->addr, NULL);
+			if (!count) {
+				continue;
+			}
+			n++;
+			if (block->addr == fcn->addr) {
+				hits = count;
+			}
+		}
+	}
+	if (covered) {
+		*covered = n;
+	}
+	return hits;
+}
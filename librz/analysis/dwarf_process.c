@@ -575,6 +575,36 @@ static char *anonymous_type_name(RzBaseTypeKind k, ut64 offset) {
 	return anonymous_name(rz_type_base_type_kind_as_string(k), offset);
 }
 
+static bool anonymous_name_offset(const char *name, ut64 *offset) {
+	if (!rz_str_startswith(name, "anonymous_")) {
+		return false;
+	}
+	const char *off = strrchr(name, '_');
+	if (!off || !rz_str_startswith(off, "_0x")) {
+		return false;
+	}
+	*offset = strtoull(off + 1, NULL, 16);
+	return true;
+}
+
+/**
+ * The base type behind a name given by anonymous_type_name(), found by the
+ * DIE offset in the name since anonymous types are named differently in every unit.
+ */
+static const RzBaseType *anonymous_base_type(void *user, const char *name) {
+	RzAnalysisDebugInfo *debug_info = user;
+	ut64 offset;
+	return anonymous_name_offset(name, &offset) ? ht_up_find(debug_info->base_type_by_offset, offset, NULL) : NULL;
+}
+
+static bool anonymous_callable(void *user, const char *name) {
+	ut64 offset;
+	return anonymous_name_offset(name, &offset);
+}
+
+#define ANONYMOUS_RESOLVER(debug_info) \
+	{ .base_type = anonymous_base_type, .callable = anonymous_callable, .user = (debug_info) }
+
 /**
  * \brief Get the DIE name or create unique one from its offset
  * \return char* DIEs name or NULL if error
@@ -639,11 +669,67 @@ static ut64 die_bits_size(const RzBinDwarfDie *die) {
 	return 0;
 }
 
-static bool RzBaseType_eq(const RzBaseType *a, const RzBaseType *b) {
-	if (a == NULL || b == NULL) {
-		return a == NULL && b == NULL;
+/**
+ * \brief Whether \p btype only declares a struct, union or enum without defining its body
+ */
+static bool RzBaseType_is_declaration(const RzBaseType *btype) {
+	switch (btype->kind) {
+	case RZ_BASE_TYPE_KIND_STRUCT:
+		return !btype->size && rz_vector_empty(&btype->struct_data.members);
+	case RZ_BASE_TYPE_KIND_UNION:
+		return !btype->size && rz_vector_empty(&btype->union_data.members);
+	case RZ_BASE_TYPE_KIND_ENUM:
+		return !btype->size && rz_vector_empty(&btype->enum_data.cases);
+	default:
+		return false;
+	}
+}
+
+/**
+ * \brief Add \p btype to the types to be stored, unless an identical one is there already
+ *
+ * Types are hash-consed on their whole structure, so a type repeated in every
+ * compile unit is stored once, while different types sharing a name are all kept.
+ * Anonymous types are named after their DIE, so the references to them are
+ * compared by the structure of the referred type instead.
+ * Declarations are dropped in favor of a definition of the same name.
+ */
+static void RzBaseType_index(RzAnalysisDebugInfo *debug_info, RzBaseType *btype) {
+	RzTypeAnonymousResolver resolver = ANONYMOUS_RESOLVER(debug_info);
+	ut64 hash = rz_base_type_hash_resolved(btype, &resolver);
+	const RzBaseType *known = ht_up_find(debug_info->base_type_by_hash, hash, NULL);
+	if (known && rz_base_type_equal_resolved(known, btype, &resolver)) {
+		return;
+	}
+	RzPVector *btypes = ht_pp_find(debug_info->base_type_by_name, btype->name, NULL);
+	if (!btypes) {
+		btypes = rz_pvector_new(NULL);
+		if (!btypes) {
+			return;
+		}
+		ht_pp_insert(debug_info->base_type_by_name, btype->name, btypes);
+		rz_pvector_push(btypes, btype);
+		goto indexed;
+	}
+	void **it;
+	rz_pvector_foreach (btypes, it) {
+		RzBaseType *b = *it;
+		if (b->kind != btype->kind) {
+			continue;
+		}
+		if (RzBaseType_is_declaration(btype) || rz_base_type_equal_resolved(b, btype, &resolver)) {
+			return;
+		}
+		if (RzBaseType_is_declaration(b)) {
+			*it = btype;
+			goto indexed;
+		}
+	}
+	rz_pvector_push(btypes, btype);
+indexed:
+	if (!known) {
+		ht_up_insert(debug_info->base_type_by_hash, hash, btype);
 	}
-	return a->kind == b->kind && a->attrs == b->attrs && RZ_STR_EQ(a->name, b->name);
 }
 
 #define RzBaseType_NEW_CHECKED(x, k) \
@@ -735,22 +821,7 @@ static RzBaseType *RzBaseType_from_die(Context *ctx, const RzBinDwarfDie *die) {
 			btype->name, die->offset);
 	}
 
-	RzPVector *btypes = ht_pp_find(ctx->analysis->debug_info->base_type_by_name, btype->name, NULL);
-	if (!btypes) {
-		btypes = rz_pvector_new(NULL);
-		ht_pp_insert(ctx->analysis->debug_info->base_type_by_name, btype->name, btypes);
-		rz_pvector_push(btypes, btype);
-	} else {
-		void **it;
-		rz_pvector_foreach (btypes, it) {
-			RzBaseType *b = *it;
-			if (RzBaseType_eq(btype, b)) {
-				goto ok;
-			}
-		}
-		rz_pvector_push(btypes, btype);
-	}
-ok:
+	RzBaseType_index(ctx->analysis->debug_info, btype);
 	return btype;
 err:
 	rz_type_base_type_free(btype);
@@ -815,26 +886,25 @@ static RzType *type_parse_from_die_internal(
 	return type_parse_from_offset_internal(ctx, rz_bin_dwarf_attr_udata(attr), size, visited);
 }
 
+static RzTypeIdentifierKind base_type_identifier_kind(RzBaseTypeKind kind) {
+	switch (kind) {
+	case RZ_BASE_TYPE_KIND_STRUCT:
+		return RZ_TYPE_IDENTIFIER_KIND_STRUCT;
+	case RZ_BASE_TYPE_KIND_UNION:
+		return RZ_TYPE_IDENTIFIER_KIND_UNION;
+	case RZ_BASE_TYPE_KIND_ENUM:
+		return RZ_TYPE_IDENTIFIER_KIND_ENUM;
+	default:
+		return RZ_TYPE_IDENTIFIER_KIND_UNSPECIFIED;
+	}
+}
+
 static void RzType_from_base_type(RzType *t, RzBaseType *b) {
 	rz_return_if_fail(t && b);
 	t->kind = RZ_TYPE_KIND_IDENTIFIER;
 	free(t->identifier.name);
 	t->identifier.name = rz_str_new(b->name);
-	switch (b->kind) {
-	case RZ_BASE_TYPE_KIND_STRUCT:
-		t->identifier.kind = RZ_TYPE_IDENTIFIER_KIND_STRUCT;
-		break;
-	case RZ_BASE_TYPE_KIND_UNION:
-		t->identifier.kind = RZ_TYPE_IDENTIFIER_KIND_UNION;
-		break;
-	case RZ_BASE_TYPE_KIND_ENUM:
-		t->identifier.kind = RZ_TYPE_IDENTIFIER_KIND_ENUM;
-		break;
-	case RZ_BASE_TYPE_KIND_TYPEDEF:
-	case RZ_BASE_TYPE_KIND_ATOMIC:
-		t->identifier.kind = RZ_TYPE_IDENTIFIER_KIND_UNSPECIFIED;
-		break;
-	}
+	t->identifier.kind = base_type_identifier_kind(b->kind);
 }
 
 /**
@@ -1725,13 +1795,6 @@ RZ_API void rz_analysis_dwarf_preprocess_info(
 	}
 }
 
-#define SWAP(T, a, b) \
-	do { \
-		T temp = a; \
-		a = b; \
-		b = temp; \
-	} while (0)
-
 static inline void update_base_type(const RzTypeDB *typedb, RzBaseType *type) {
 	RzBaseType *t = rz_type_db_get_base_type(typedb, type->name);
 	if (t && t == type) {
@@ -1740,61 +1803,343 @@ static inline void update_base_type(const RzTypeDB *typedb, RzBaseType *type) {
 	rz_type_db_update_base_type(typedb, rz_base_type_clone(type));
 }
 
-static void db_save_renamed(RzTypeDB *db, RzBaseType *b, char *name) {
-	if (!name) {
-		rz_warn_if_reached();
+static bool typedef_of_name(const RzBaseType *btype, const char *name) {
+	return btype->kind == RZ_BASE_TYPE_KIND_TYPEDEF && btype->type &&
+		btype->type->kind == RZ_TYPE_KIND_IDENTIFIER && RZ_STR_EQ(btype->type->identifier.name, name);
+}
+
+typedef struct {
+	RzAnalysisDebugInfo *debug_info;
+	RzBinDWARF *dw;
+	HtUP /*<RzBaseType *, char *>*/ *names; ///< new name of every same-named type which does not keep its name
+	HtPP /*<char *, char *>*/ *renames; ///< "<unit>:<identifier kind>:<name>" to the new name of the type of this name in the unit
+	HtPP /*<char *, NULL>*/ *taken; ///< new names given in the current round
+	ut64 unit; ///< offset of the unit whose references are being re-pointed
+	bool renamed;
+} Disambiguation;
+
+static void HtPP_RzPVector_free(HtPPKv *kv);
+
+static void HtUP_str_free(HtUPKv *kv) {
+	free(kv->value);
+}
+
+static void HtPP_str_free(HtPPKv *kv) {
+	free(kv->key);
+	free(kv->value);
+}
+
+static ut64 die_unit_offset(const RzBinDWARF *dw, ut64 offset) {
+	RzBinDwarfDie *die = ht_up_find(dw->info->die_by_offset, offset, NULL);
+	return die ? die->unit_offset : UT64_MAX;
+}
+
+static char *rename_key(ut64 unit, RzTypeIdentifierKind kind, const char *name) {
+	return rz_str_newf("%" PFMT64x ":%d:%s", unit, (int)kind, name);
+}
+
+static char *fresh_name(Disambiguation *d, const char *name, ut32 *n) {
+	while (true) {
+		char *candidate = rz_str_newf("%s_%" PFMT32u, name, (*n)++);
+		if (!candidate) {
+			return NULL;
+		}
+		bool found = false;
+		ht_pp_find(d->taken, candidate, &found);
+		if (!found && !ht_pp_find(d->debug_info->base_type_by_name, candidate, NULL)) {
+			ht_pp_insert(d->taken, candidate, NULL);
+			return candidate;
+		}
+		free(candidate);
+	}
+}
+
+/**
+ * Gives a new name to all but one of the different types sharing a name.
+ * For typedef struct foo foo, the typedef keeps the name and the types it may
+ * point to are renamed, otherwise the first type keeps it.
+ */
+static bool names_assign(void *u, const void *k, const void *v) {
+	Disambiguation *d = u;
+	const char *name = k;
+	RzPVector *btypes = (RzPVector *)v;
+	if (rz_pvector_len(btypes) < 2) {
+		return true;
+	}
+	RzBaseType *keep = NULL;
+	bool has_target = false;
+	void **it;
+	rz_pvector_foreach (btypes, it) {
+		RzBaseType *b = *it;
+		if (!keep && typedef_of_name(b, name)) {
+			keep = b;
+		}
+		has_target |= b->kind != RZ_BASE_TYPE_KIND_TYPEDEF;
+	}
+	if (!keep || !has_target) {
+		keep = rz_pvector_head(btypes);
+	}
+	ut32 n = 0;
+	rz_pvector_foreach (btypes, it) {
+		RzBaseType *b = *it;
+		if (b == keep) {
+			continue;
+		}
+		char *newname = fresh_name(d, name, &n);
+		if (newname && !ht_up_insert(d->names, (ut64)(size_t)b, newname)) {
+			free(newname);
+		}
+		d->renamed = true;
+	}
+	return true;
+}
+
+/**
+ * The type among the ones indexed under the name of \p btype standing for it,
+ * the one with the same structure or, for a declaration, any definition.
+ */
+static RzBaseType *base_type_indexed(RzAnalysisDebugInfo *debug_info, const RzBaseType *btype) {
+	RzPVector *btypes = ht_pp_find(debug_info->base_type_by_name, btype->name, NULL);
+	if (!btypes) {
+		return NULL;
+	}
+	RzTypeAnonymousResolver resolver = ANONYMOUS_RESOLVER(debug_info);
+	void **it;
+	rz_pvector_foreach (btypes, it) {
+		RzBaseType *b = *it;
+		if (b == btype || (b->kind == btype->kind && (RzBaseType_is_declaration(btype) || rz_base_type_equal_resolved(b, btype, &resolver)))) {
+			return b;
+		}
+	}
+	return NULL;
+}
+
+static void callable_repoint(Disambiguation *d, RzCallable *callable);
+
+static void type_repoint(Disambiguation *d, RzType *type) {
+	if (!type) {
 		return;
 	}
-	RzBaseType *t = rz_type_db_get_base_type(db, b->name);
-	if (t == b) {
+	switch (type->kind) {
+	case RZ_TYPE_KIND_IDENTIFIER: {
+		if (!type->identifier.name) {
+			break;
+		}
+		char *key = rename_key(d->unit, type->identifier.kind, type->identifier.name);
+		const char *newname = key ? ht_pp_find(d->renames, key, NULL) : NULL;
+		free(key);
+		if (newname) {
+			free(type->identifier.name);
+			type->identifier.name = strdup(newname);
+		}
+		break;
+	}
+	case RZ_TYPE_KIND_POINTER:
+		type_repoint(d, type->pointer.type);
+		break;
+	case RZ_TYPE_KIND_ARRAY:
+		type_repoint(d, type->array.type);
+		break;
+	case RZ_TYPE_KIND_CALLABLE:
+		callable_repoint(d, type->callable);
+		break;
+	}
+}
+
+static void callable_repoint(Disambiguation *d, RzCallable *callable) {
+	if (!callable) {
 		return;
 	}
-	free(b->name);
-	b->name = name;
-	rz_type_db_update_base_type(db, b);
+	type_repoint(d, callable->ret);
+	void **it;
+	rz_pvector_foreach (callable->args, it) {
+		RzCallableArg *arg = *it;
+		type_repoint(d, arg->type);
+	}
+}
+
+static void base_type_repoint(Disambiguation *d, RzBaseType *btype) {
+	type_repoint(d, btype->type);
+	if (btype->kind == RZ_BASE_TYPE_KIND_STRUCT) {
+		RzTypeStructMember *member;
+		rz_vector_foreach(&btype->struct_data.members, member) {
+			type_repoint(d, member->type);
+		}
+	} else if (btype->kind == RZ_BASE_TYPE_KIND_UNION) {
+		RzTypeUnionMember *member;
+		rz_vector_foreach(&btype->union_data.members, member) {
+			type_repoint(d, member->type);
+		}
+	}
+}
+
+static bool callable_repoint_cb(void *u, ut64 k, const void *v) {
+	Disambiguation *d = u;
+	d->unit = die_unit_offset(d->dw, k);
+	callable_repoint(d, (RzCallable *)v);
+	return true;
+}
+
+static bool type_repoint_cb(void *u, ut64 k, const void *v) {
+	Disambiguation *d = u;
+	d->unit = die_unit_offset(d->dw, k);
+	type_repoint(d, (RzType *)v);
+	return true;
+}
+
+static bool function_repoint_cb(void *u, ut64 k, const void *v) {
+	Disambiguation *d = u;
+	RzAnalysisDwarfFunction *fn = (RzAnalysisDwarfFunction *)v;
+	d->unit = die_unit_offset(d->dw, k);
+	type_repoint(d, fn->ret_type);
+	RzAnalysisDwarfVariable *var;
+	rz_vector_foreach(&fn->variables, var) {
+		type_repoint(d, var->type);
+	}
+	return true;
+}
+
+static bool base_types_reindex(RzAnalysisDebugInfo *debug_info, RzVector /*<ut64>*/ *offsets) {
+	HtPP *by_name = ht_pp_new(NULL, HtPP_RzPVector_free, NULL);
+	HtUP *by_hash = ht_up_new0();
+	if (!by_name || !by_hash) {
+		ht_pp_free(by_name);
+		ht_up_free(by_hash);
+		return false;
+	}
+	ht_pp_free(debug_info->base_type_by_name);
+	ht_up_free(debug_info->base_type_by_hash);
+	debug_info->base_type_by_name = by_name;
+	debug_info->base_type_by_hash = by_hash;
+	ut64 *off;
+	rz_vector_foreach(offsets, off) {
+		RzBaseType *btype = ht_up_find(debug_info->base_type_by_offset, *off, NULL);
+		if (btype) {
+			RzBaseType_index(debug_info, btype);
+		}
+	}
+	return true;
+}
+
+/**
+ * One round of renaming the different types sharing a name, and of re-pointing
+ * the references in every unit to the type of this name the unit defines.
+ *
+ * \return whether any type was renamed
+ */
+static bool base_types_rename(Disambiguation *d, RzVector /*<ut64>*/ *offsets) {
+	RzAnalysisDebugInfo *debug_info = d->debug_info;
+	d->renamed = false;
+	d->names = ht_up_new(NULL, HtUP_str_free, NULL);
+	d->renames = ht_pp_new(NULL, HtPP_str_free, NULL);
+	d->taken = ht_pp_new0();
+	RzPVector renamed, newnames;
+	rz_pvector_init(&renamed, NULL);
+	rz_pvector_init(&newnames, NULL);
+	if (!d->names || !d->renames || !d->taken) {
+		d->renamed = false;
+		goto beach;
+	}
+	ht_pp_foreach(debug_info->base_type_by_name, names_assign, d);
+	if (!d->renamed) {
+		goto beach;
+	}
+
+	// the types of all DIEs are resolved before renaming any, as resolving compares names
+	ut64 *off;
+	rz_vector_foreach(offsets, off) {
+		RzBaseType *btype = ht_up_find(debug_info->base_type_by_offset, *off, NULL);
+		RzBaseType *indexed = btype ? base_type_indexed(debug_info, btype) : NULL;
+		const char *newname = indexed ? ht_up_find(d->names, (ut64)(size_t)indexed, NULL) : NULL;
+		if (!newname) {
+			continue;
+		}
+		char *key = rename_key(die_unit_offset(d->dw, *off), base_type_identifier_kind(btype->kind), btype->name);
+		char *value = strdup(newname);
+		if (!key || !value || !ht_pp_insert(d->renames, key, value)) {
+			// another type of the unit already has this name, the first one wins
+			free(value);
+		}
+		free(key);
+		rz_pvector_push(&renamed, btype);
+		rz_pvector_push(&newnames, (void *)newname);
+	}
+	for (size_t i = 0; i < rz_pvector_len(&renamed); i++) {
+		RzBaseType *btype = rz_pvector_at(&renamed, i);
+		free(btype->name);
+		btype->name = strdup(rz_pvector_at(&newnames, i));
+	}
+
+	rz_vector_foreach(offsets, off) {
+		RzBaseType *btype = ht_up_find(debug_info->base_type_by_offset, *off, NULL);
+		if (btype) {
+			d->unit = die_unit_offset(d->dw, *off);
+			base_type_repoint(d, btype);
+		}
+	}
+	ht_up_foreach(debug_info->callable_by_offset, callable_repoint_cb, d);
+	ht_up_foreach(debug_info->function_by_offset, function_repoint_cb, d);
+	ht_up_foreach(debug_info->type_by_offset, type_repoint_cb, d);
+	d->renamed = base_types_reindex(debug_info, offsets);
+
+beach:
+	rz_pvector_fini(&renamed);
+	rz_pvector_fini(&newnames);
+	ht_up_free(d->names);
+	ht_pp_free(d->renames);
+	ht_pp_free(d->taken);
+	return d->renamed;
+}
+
+static bool offset_collect(void *u, ut64 k, const void *v) {
+	rz_vector_push(u, &k);
+	return true;
+}
+
+static int offset_cmp(const void *a, const void *b) {
+	ut64 x = *(const ut64 *)a, y = *(const ut64 *)b;
+	return x < y ? -1 : x > y;
+}
+
+/**
+ * \brief Give a distinct name to each of the different types sharing a name
+ *
+ * C only requires a name to be unique in a compile unit, so a name may stand
+ * for a different type in every unit. All but one of them are renamed to
+ * <name>_<n> and the references in a unit are re-pointed to the type of the
+ * unit. Types referring to renamed types may become different themselves,
+ * so this is repeated until no name is shared anymore.
+ */
+static void base_types_disambiguate(RzAnalysisDebugInfo *debug_info, RzBinDWARF *dw) {
+	RzVector offsets;
+	rz_vector_init(&offsets, sizeof(ut64), NULL, NULL);
+	ht_up_foreach(debug_info->base_type_by_offset, offset_collect, &offsets);
+	// the types keep their names in the order they appear
+	rz_vector_sort(&offsets, offset_cmp, false);
+	Disambiguation d = {
+		.debug_info = debug_info,
+		.dw = dw,
+	};
+	// types were indexed as they were parsed, before all the anonymous types they refer to were
+	base_types_reindex(debug_info, &offsets);
+	while (base_types_rename(&d, &offsets)) {
+		// the references changed, so types referring to renamed ones may differ now
+	}
+	rz_vector_fini(&offsets);
 }
 
 static bool store_base_type(void *u, const void *k, const void *v) {
 	RzAnalysis *analysis = u;
 	const char *name = k;
 	RzPVector *types = (RzPVector *)v;
-	ut32 len = rz_pvector_len(types);
-	if (len == 0) {
+	if (rz_pvector_empty(types)) {
 		RZ_LOG_WARN("BaseType %s has nothing", name);
-	} else if (len == 1) {
-		RzBaseType *t = rz_pvector_head(types);
-		update_base_type(analysis->typedb, t);
-	} else if (len == 2) {
-		RzBaseType *a = rz_pvector_head(types);
-		RzBaseType *b = rz_pvector_tail(types);
-		if (a->kind != RZ_BASE_TYPE_KIND_TYPEDEF) {
-			SWAP(RzBaseType *, a, b);
-		}
-		if (a->kind != RZ_BASE_TYPE_KIND_TYPEDEF) {
-			update_base_type(analysis->typedb, a);
-			db_save_renamed(analysis->typedb, rz_base_type_clone(b), rz_str_newf("%s_0", name));
-			goto beach;
-		}
-		if (a->type->kind != RZ_TYPE_KIND_IDENTIFIER) {
-			RZ_LOG_WARN("BaseType: type of typedef [%s] is not RZ_TYPE_KIND_IDENTIFIER\n", name);
-			goto beach;
-		}
-		if (RZ_STR_NE(a->type->identifier.name, name)) {
-			RZ_LOG_WARN("BaseType: type name [%s] of typedef [%s] is not valid\n",
-				a->type->identifier.name, name);
-			goto beach;
-		}
-		free(a->type->identifier.name);
-		char *newname = rz_str_newf("%s_0", name);
-		a->type->identifier.name = rz_str_new(newname);
-		update_base_type(analysis->typedb, a);
-
-		db_save_renamed(analysis->typedb, rz_base_type_clone(b), newname);
-	} else {
-		RZ_LOG_WARN("BaseType: same name [%s] type count is more than 3\n", name);
-		goto beach;
+		return true;
+	}
+	void **it;
+	rz_pvector_foreach (types, it) {
+		update_base_type(analysis->typedb, *it);
 	}
-beach:
 	return true;
 }
 
@@ -1817,6 +2162,7 @@ static bool store_callable(void *u, ut64 k, const void *v) {
 RZ_API void rz_analysis_dwarf_process_info(RzAnalysis *analysis, RzBinDWARF *dw) {
 	rz_return_if_fail(analysis && dw);
 	rz_analysis_dwarf_preprocess_info(analysis, dw);
+	base_types_disambiguate(analysis->debug_info, dw);
 	ht_pp_foreach(analysis->debug_info->base_type_by_name, store_base_type, (void *)analysis);
 	ht_up_foreach(analysis->debug_info->callable_by_offset, store_callable, (void *)analysis);
 }
@@ -2039,7 +2385,11 @@ Ht_FREE_IMPL(UP, RzType, rz_type_free);
 Ht_FREE_IMPL(UP, RzBaseType, rz_type_base_type_free);
 Ht_FREE_IMPL(UP, RzAnalysisDwarfFunction, function_free);
 Ht_FREE_IMPL(UP, RzCallable, rz_type_callable_free);
-Ht_FREE_IMPL(PP, RzPVector, rz_pvector_free);
+
+static void HtPP_RzPVector_free(HtPPKv *kv) {
+	free(kv->key);
+	rz_pvector_free(kv->value);
+}
 
 /**
  * \brief Create a new debug info
@@ -2057,6 +2407,7 @@ RZ_API RzAnalysisDebugInfo *rz_analysis_debug_info_new() {
 	debug_info->callable_by_offset = ht_up_new(NULL, HtUP_RzCallable_free, NULL);
 	debug_info->base_type_by_offset = ht_up_new(NULL, HtUP_RzBaseType_free, NULL);
 	debug_info->base_type_by_name = ht_pp_new(NULL, HtPP_RzPVector_free, NULL);
+	debug_info->base_type_by_hash = ht_up_new0();
 	debug_info->visited = set_u_new();
 	return debug_info;
 }
@@ -2076,6 +2427,7 @@ RZ_API void rz_analysis_debug_info_free(RzAnalysisDebugInfo *debuginfo) {
 	ht_up_free(debuginfo->callable_by_offset);
 	ht_up_free(debuginfo->base_type_by_offset);
 	ht_pp_free(debuginfo->base_type_by_name);
+	ht_up_free(debuginfo->base_type_by_hash);
 	rz_bin_dwarf_free(debuginfo->dw);
 	set_u_free(debuginfo->visited);
 	free(debuginfo);
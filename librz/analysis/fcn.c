@@ -7,6 +7,7 @@
 #include <rz_parse.h>
 #include <rz_util.h>
 #include <rz_list.h>
+#include "analysis_private.h"
 
 #define READ_AHEAD 1
 #define SDB_KEY_BB "bb.0x%" PFMT64x ".0x%" PFMT64x
@@ -116,11 +117,15 @@ RZ_API int rz_analysis_function_resize(RzAnalysisFunction *fcn, int newsize) {
 		}
 		if (bb->jump != UT64_MAX && bb->jump >= eof) {
 			bb->jump = UT64_MAX;
+			rz_analysis_block_invalidate_cfgs(bb);
 		}
 		if (bb->fail != UT64_MAX && bb->fail >= eof) {
 			bb->fail = UT64_MAX;
+			rz_analysis_block_invalidate_cfgs(bb);
 		}
 	}
+	// The removed and resized blocks changed the graph as well
+	rz_analysis_function_invalidate_cfg(fcn);
 	return true;
 }
 
@@ -532,6 +537,7 @@ static int analyze_function_locally(RzAnalysis *analysis, RzAnalysisFunction *fc
 static inline void set_bb_branches(RZ_OUT RzAnalysisBlock *bb, const ut64 jump, const ut64 fail) {
 	bb->jump = jump;
 	bb->fail = fail;
+	rz_analysis_block_invalidate_cfgs(bb);
 }
 
 /**
@@ -617,7 +623,7 @@ static RzAnalysisBBEndCause run_basic_block_analysis(RzAnalysisTaskItem *item, R
 	if (!bb) {
 		RzAnalysisBlock *existing_bb = bbget(analysis, addr, can_jmpmid);
 		if (existing_bb) {
-			bool existing_in_fcn = rz_list_contains(existing_bb->fcns, fcn);
+			bool existing_in_fcn = rz_analysis_function_contains_block(fcn, existing_bb);
 			existing_bb = rz_analysis_block_split(existing_bb, addr);
 			if (!existing_in_fcn && existing_bb) {
 				if (existing_bb->addr == fcn->addr) {
@@ -758,7 +764,7 @@ static RzAnalysisBBEndCause run_basic_block_analysis(RzAnalysisTaskItem *item, R
 		if (idx > 0 && !overlapped) {
 			bbg = bbget(analysis, at, can_jmpmid);
 			if (bbg && bbg != bb) {
-				bb->jump = at;
+				set_bb_branches(bb, at, bb->fail);
 				if (can_jmpmid) {
 					// This happens when we purposefully walked over another block and overlapped it
 					// and now we hit an offset where the instructions match again.
@@ -794,9 +800,9 @@ static RzAnalysisBBEndCause run_basic_block_analysis(RzAnalysisTaskItem *item, R
 					if (filter_addr) {
 						rz_analysis_xrefs_set(analysis, op.addr, filter_addr, RZ_ANALYSIS_XREF_TYPE_CALL);
 					}
-					bb->jump = at + oplen;
+					set_bb_branches(bb, at + oplen, bb->fail);
 					if (from_addr != bb->addr) {
-						bb->fail = handle_addr;
+						set_bb_branches(bb, bb->jump, handle_addr);
 						ret = analyze_function_locally(analysis, fcn, handle_addr);
 						if (bb->size == 0) {
 							rz_analysis_function_remove_block(fcn, bb);
@@ -1201,8 +1207,7 @@ static RzAnalysisBBEndCause run_basic_block_analysis(RzAnalysisTaskItem *item, R
 			if (!continue_after_jump) {
 				if (op.jump < fcn->addr) {
 					if (!overlapped) {
-						bb->jump = op.jump;
-						bb->fail = UT64_MAX;
+						set_bb_branches(bb, op.jump, UT64_MAX);
 					}
 					gotoBeach(RZ_ANALYSIS_RET_END);
 				}
@@ -1414,7 +1419,7 @@ static RzAnalysisBBEndCause run_basic_block_analysis(RzAnalysisTaskItem *item, R
 			if (last_is_push && analysis->opt.pushret) {
 				op.type = RZ_ANALYSIS_OP_TYPE_JMP;
 				op.jump = last_push_addr;
-				bb->jump = op.jump;
+				set_bb_branches(bb, op.jump, bb->fail);
 				rz_analysis_task_item_new(analysis, tasks, fcn, NULL, op.jump, sp);
 				goto beach;
 			}
@@ -1641,6 +1646,8 @@ RZ_API int rz_analysis_fcn(RzAnalysis *analysis, RzAnalysisFunction *fcn, ut64 a
 	rz_vector_init(&tasks, sizeof(RzAnalysisTaskItem), NULL, NULL);
 	rz_analysis_task_item_new(analysis, &tasks, fcn, NULL, addr, 0);
 	int ret = rz_analysis_run_tasks(&tasks);
+	// The analysis may have changed the edges of the already known blocks
+	rz_analysis_function_invalidate_cfg(fcn);
 	rz_vector_fini(&tasks);
 	return ret;
 }
@@ -1759,26 +1766,21 @@ RZ_API bool rz_analysis_fcn_add_bb(RzAnalysis *a, RzAnalysisFunction *fcn, ut64
 
 	block->jump = jump;
 	block->fail = fail;
+	rz_analysis_function_invalidate_cfg(fcn);
 	rz_analysis_block_unref(block);
 	return true;
 }
 
 /**
  * \brief Returns the amount of loops located in the \p fcn function
+ *
+ * These are the jumps to a lower address, see rz_analysis_function_block_loop()
+ * for the natural loops. The result is cached with the CFG of the function.
  */
 RZ_API int rz_analysis_function_loops(RzAnalysisFunction *fcn) {
-	RzListIter *iter;
-	RzAnalysisBlock *bb;
-	ut32 loops = 0;
-	rz_list_foreach (fcn->bbs, iter, bb) {
-		if (bb->jump != UT64_MAX && bb->jump < bb->addr) {
-			loops++;
-		}
-		if (bb->fail != UT64_MAX && bb->fail < bb->addr) {
-			loops++;
-		}
-	}
-	return loops;
+	rz_return_val_if_fail(fcn, 0);
+	RzAnalysisCFG *cfg = rz_analysis_function_get_cfg(fcn);
+	return cfg ? cfg->n_back_jumps : 0;
 }
 
 /**
@@ -1792,36 +1794,12 @@ RZ_API int rz_analysis_function_loops(RzAnalysisFunction *fcn) {
  * N is the number of nodes of the graph.
  * P is the number of connected components (exit nodes).
  *
+ * The result is cached with the CFG of the function.
  */
 RZ_API int rz_analysis_function_complexity(RzAnalysisFunction *fcn) {
-	RzAnalysis *analysis = fcn->analysis;
-	int E = 0, N = 0, P = 0;
-	RzListIter *iter;
-	RzAnalysisBlock *bb;
-
-	rz_list_foreach (fcn->bbs, iter, bb) {
-		N++; // nodes
-		if (!analysis && bb->jump == UT64_MAX && bb->fail != UT64_MAX) {
-			RZ_LOG_DEBUG("invalid bb jump/fail pair at 0x%08" PFMT64x " (fcn 0x%08" PFMT64x "\n", bb->addr, fcn->addr);
-		}
-		if (bb->jump == UT64_MAX && bb->fail == UT64_MAX) {
-			P++; // exit nodes
-		} else {
-			E++; // edges
-			if (bb->fail != UT64_MAX) {
-				E++;
-			}
-		}
-		if (bb->switch_op && bb->switch_op->cases) {
-			E += rz_list_length(bb->switch_op->cases);
-		}
-	}
-
-	int result = E - N + (2 * P);
-	if (result < 1 && !analysis) {
-		RZ_LOG_DEBUG("CC = E(%d) - N(%d) + (2 * P(%d)) < 1 at 0x%08" PFMT64x "\n", E, N, P, fcn->addr);
-	}
-	return result;
+	rz_return_val_if_fail(fcn, 0);
+	RzAnalysisCFG *cfg = rz_analysis_function_get_cfg(fcn);
+	return cfg ? cfg->complexity : 0;
 }
 
 /**
@@ -2236,7 +2214,7 @@ static bool analize_addr_cb(ut64 addr, void *user) {
 	BlockRecurseCtx *ctx = user;
 	RzAnalysis *analysis = ctx->fcn->analysis;
 	RzAnalysisBlock *existing_bb = rz_analysis_get_block_at(analysis, addr);
-	if (!existing_bb || !rz_list_contains(ctx->fcn->bbs, existing_bb)) {
+	if (!existing_bb || !rz_analysis_function_contains_block(ctx->fcn, existing_bb)) {
 		int old_len = rz_list_length(ctx->fcn->bbs);
 		analyze_function_locally(ctx->fcn->analysis, ctx->fcn, addr);
 		if (old_len != rz_list_length(ctx->fcn->bbs)) {
@@ -2358,7 +2336,8 @@ static void update_analysis(RzAnalysis *analysis, RzList /*<RzAnalysisFunction *
 
 static void calc_reachable_and_remove_block(RzList /*<RzAnalysisFunction *>*/ *fcns, RzAnalysisFunction *fcn, RzAnalysisBlock *bb, HtUP *reachable) {
 	clear_bb_vars(fcn, bb, bb->addr, bb->addr + bb->size);
-	if (!rz_list_contains(fcns, fcn)) {
+	// Every function gets its reachable set the first time, so it also tells if fcn is in fcns
+	if (!ht_up_find_kv(reachable, fcn->addr, NULL)) {
 		rz_list_append(fcns, fcn);
 
 		// Calculate reachable blocks from the start of function
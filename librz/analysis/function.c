@@ -4,26 +4,37 @@
 
 #include <rz_analysis.h>
 
+typedef struct {
+	RzList /*<RzAnalysisFunction *>*/ *list;
+	HtUP /*<RzAnalysisFunction *, NULL>*/ *seen;
+} FunctionsInCtx;
+
 static bool get_functions_block_cb(RzAnalysisBlock *block, void *user) {
-	RzList *list = user;
+	FunctionsInCtx *ctx = user;
 	RzListIter *iter;
 	RzAnalysisFunction *fcn;
 	rz_list_foreach (block->fcns, iter, fcn) {
-		if (rz_list_contains(list, fcn)) {
+		if (!ht_up_insert(ctx->seen, (ut64)(size_t)fcn, NULL)) {
 			continue;
 		}
-		rz_list_push(list, fcn);
+		rz_list_push(ctx->list, fcn);
 	}
 	return true;
 }
 
 RZ_API RzList /*<RzAnalysisFunction *>*/ *rz_analysis_get_functions_in(RzAnalysis *analysis, ut64 addr) {
-	RzList *list = rz_list_new();
-	if (!list) {
+	FunctionsInCtx ctx = {
+		.list = rz_list_new(),
+		.seen = ht_up_new0()
+	};
+	if (!ctx.list || !ctx.seen) {
+		rz_list_free(ctx.list);
+		ht_up_free(ctx.seen);
 		return NULL;
 	}
-	rz_analysis_blocks_foreach_in(analysis, addr, get_functions_block_cb, list);
-	return list;
+	rz_analysis_blocks_foreach_in(analysis, addr, get_functions_block_cb, &ctx);
+	ht_up_free(ctx.seen);
+	return ctx.list;
 }
 
 static bool __fcn_exists(RzAnalysis *analysis, const char *name, ut64 addr) {
@@ -75,6 +86,7 @@ RZ_API RzAnalysisFunction *rz_analysis_function_new(RzAnalysis *analysis) {
 	fcn->cc = rz_str_constpool_get(&analysis->constpool, rz_analysis_cc_default(analysis));
 	fcn->bits = analysis->bits;
 	fcn->bbs = rz_list_new();
+	fcn->bbs_index = ht_up_new0();
 	fcn->has_changed = true;
 	fcn->bp_frame = true;
 	fcn->is_noreturn = false;
@@ -99,6 +111,8 @@ RZ_API void rz_analysis_function_free(void *_fcn) {
 		rz_analysis_block_unref(block);
 	}
 	rz_list_free(fcn->bbs);
+	ht_up_free(fcn->bbs_index);
+	rz_analysis_function_invalidate_cfg(fcn);
 
 	RzAnalysis *analysis = fcn->analysis;
 	if (ht_up_find(analysis->ht_addr_fun, fcn->addr, NULL) == _fcn) {
@@ -162,7 +176,15 @@ RZ_API RzAnalysisFunction *rz_analysis_create_function(RzAnalysis *analysis, con
 }
 
 RZ_API bool rz_analysis_function_delete(RzAnalysisFunction *fcn) {
-	return rz_list_delete_data(fcn->analysis->fcns, fcn);
+	// Most of the deleted functions are the ones that were just created, so look from the end
+	RzList *fcns = fcn->analysis->fcns;
+	for (RzListIter *iter = fcns->tail; iter; iter = iter->p) {
+		if (iter->data == fcn) {
+			rz_list_delete(fcns, iter);
+			return true;
+		}
+	}
+	return false;
 }
 
 RZ_API RzAnalysisFunction *rz_analysis_get_function_at(RzAnalysis *analysis, ut64 addr) {
@@ -245,13 +267,79 @@ RZ_API bool rz_analysis_function_rename(RzAnalysisFunction *fcn, const char *nam
 	return true;
 }
 
+/**
+ * \brief Checks whether the \p bb belongs to the \p fcn in constant time
+ */
+RZ_API bool rz_analysis_function_contains_block(RZ_NONNULL RzAnalysisFunction *fcn, RZ_NONNULL RzAnalysisBlock *bb) {
+	rz_return_val_if_fail(fcn && bb, false);
+	bool found = false;
+	ht_up_find(fcn->bbs_index, (ut64)(size_t)bb, &found);
+	return found;
+}
+
+/**
+ * Returns the node of \p bb in fcn->bbs. The list is sorted in place by
+ * many users, which swaps the data of the nodes, so the index is refreshed
+ * whenever it doesn't match anymore.
+ */
+static RzListIter *function_block_iter(RzAnalysisFunction *fcn, RzAnalysisBlock *bb) {
+	RzListIter *iter = ht_up_find(fcn->bbs_index, (ut64)(size_t)bb, NULL);
+	if (!iter || rz_list_iter_get_data(iter) == bb) {
+		return iter;
+	}
+	for (iter = rz_list_iterator(fcn->bbs); iter; iter = rz_list_iter_get_next(iter)) {
+		ht_up_update(fcn->bbs_index, (ut64)(size_t)rz_list_iter_get_data(iter), iter);
+	}
+	return ht_up_find(fcn->bbs_index, (ut64)(size_t)bb, NULL);
+}
+
+/**
+ * \brief Take the stack frame of \p fcn from the stack layout described by unwind tables
+ *
+ * The frame size is the largest distance between the stack pointer and its value at
+ * entry, which unlike the one found by tracking the instructions is exact. Once the
+ * function switches to a frame pointer the tracked value is only raised, never lowered.
+ */
+RZ_API void rz_analysis_function_apply_unwind(RZ_NONNULL RzAnalysisFunction *fcn, RZ_NONNULL const RzBinUnwindFunction *uw) {
+	rz_return_if_fail(fcn && uw);
+	if (rz_vector_empty(&uw->rows)) {
+		return;
+	}
+	const RzBinUnwindRow *entry = rz_vector_index_ptr(&uw->rows, 0);
+	if (entry->frame_based) {
+		return;
+	}
+	st64 maxstack = 0;
+	bool frame_based = false;
+	const RzBinUnwindRow *row;
+	rz_vector_foreach(&uw->rows, row) {
+		if (row->frame_based) {
+			frame_based = true;
+			continue;
+		}
+		maxstack = RZ_MAX(maxstack, row->cfa_offset - entry->cfa_offset);
+	}
+	if (maxstack >= INT_MAX) {
+		return;
+	}
+	if (frame_based) {
+		// the rows only describe the stack up to the frame setup, anything
+		// allocated later through the frame pointer is only known from tracking
+		fcn->maxstack = RZ_MAX(fcn->maxstack, (int)maxstack);
+		fcn->bp_frame = true;
+	} else {
+		fcn->maxstack = maxstack;
+	}
+}
+
 RZ_API void rz_analysis_function_add_block(RzAnalysisFunction *fcn, RzAnalysisBlock *bb) {
-	if (rz_list_contains(bb->fcns, fcn)) {
+	if (rz_analysis_function_contains_block(fcn, bb)) {
 		return;
 	}
 	rz_list_append(bb->fcns, fcn); // associate the given fcn with this bb
 	rz_analysis_block_ref(bb);
-	rz_list_append(fcn->bbs, bb);
+	ht_up_insert(fcn->bbs_index, (ut64)(size_t)bb, rz_list_append(fcn->bbs, bb));
+	rz_analysis_function_invalidate_cfg(fcn);
 
 	if (fcn->meta._min != UT64_MAX) {
 		if (bb->addr + bb->size > fcn->meta._max) {
@@ -275,7 +363,12 @@ RZ_API void rz_analysis_function_remove_block(RzAnalysisFunction *fcn, RzAnalysi
 		fcn->meta._min = UT64_MAX;
 	}
 
-	rz_list_delete_data(fcn->bbs, bb);
+	RzListIter *iter = function_block_iter(fcn, bb);
+	if (iter) {
+		rz_list_delete(fcn->bbs, iter);
+		ht_up_delete(fcn->bbs_index, (ut64)(size_t)bb);
+	}
+	rz_analysis_function_invalidate_cfg(fcn);
 	rz_analysis_block_unref(bb);
 }
 
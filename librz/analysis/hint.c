@@ -73,6 +73,10 @@ void rz_analysis_hint_storage_init(RzAnalysis *a) {
 	a->addr_hints = ht_up_new(NULL, addr_hint_record_ht_free, NULL);
 	a->arch_hints = NULL;
 	a->bits_hints = NULL;
+	a->hint_cursor = RZ_NEW0(RzAnalysisHintCursor);
+	if (a->hint_cursor) {
+		rz_analysis_hint_cursor_init(a->hint_cursor, a);
+	}
 }
 
 // used in analysis.c, but no API needed
@@ -80,11 +84,21 @@ void rz_analysis_hint_storage_fini(RzAnalysis *a) {
 	ht_up_free(a->addr_hints);
 	rz_rbtree_free(a->arch_hints, arch_hint_record_free_rb, NULL);
 	rz_rbtree_free(a->bits_hints, bits_hint_record_free_rb, NULL);
+	free(a->hint_cursor);
+}
+
+static inline void hints_changed(RzAnalysis *a) {
+	a->hints_gen++;
+}
+
+static inline bool hints_empty(RzAnalysis *a) {
+	return !a->addr_hints->count && !a->arch_hints && !a->bits_hints;
 }
 
 RZ_API void rz_analysis_hint_clear(RzAnalysis *a) {
 	rz_analysis_hint_storage_fini(a);
 	rz_analysis_hint_storage_init(a);
+	hints_changed(a);
 }
 
 typedef struct {
@@ -103,6 +117,7 @@ static bool addr_hint_range_delete_cb(void *user, const ut64 key, const void *va
 }
 
 RZ_API void rz_analysis_hint_del(RzAnalysis *a, ut64 addr, ut64 size) {
+	hints_changed(a);
 	if (size <= 1) {
 		// only single address
 		ht_up_delete(a->addr_hints, addr);
@@ -137,6 +152,83 @@ RZ_API void rz_analysis_hint_del(RzAnalysis *a, ut64 addr, ut64 size) {
 	}
 }
 
+typedef struct {
+	HtUP *ht;
+	ut64 diff;
+} RebaseCtx;
+
+static bool addr_hint_rebase_cb(void *user, const ut64 key, const void *value) {
+	RebaseCtx *ctx = user;
+	RzVector *records = (RzVector *)value;
+	RzAnalysisAddrHintRecord *record;
+	rz_vector_foreach(records, record) {
+		if (record->type == RZ_ANALYSIS_ADDR_HINT_TYPE_JUMP) {
+			record->jump += ctx->diff;
+		} else if (record->type == RZ_ANALYSIS_ADDR_HINT_TYPE_FAIL) {
+			record->fail += ctx->diff;
+		}
+	}
+	ht_up_insert(ctx->ht, key + ctx->diff, records);
+	return true;
+}
+
+static void ranged_hints_rebase(RBNode **root, ut64 diff) {
+	if (!*root) {
+		return;
+	}
+	RBIter first = rz_rbtree_first(*root);
+	RBIter last = rz_rbtree_last(*root);
+	ut64 lo = rz_rbtree_iter_get(&first, RzAnalysisRangedHintRecordBase, rb)->addr;
+	ut64 hi = rz_rbtree_iter_get(&last, RzAnalysisRangedHintRecordBase, rb)->addr;
+	RBIter it;
+	RzAnalysisRangedHintRecordBase *record;
+	if (lo + diff <= hi + diff) {
+		// the order of the records is preserved, the tree can be shifted in place
+		rz_rbtree_foreach (*root, it, record, RzAnalysisRangedHintRecordBase, rb) {
+			record->addr += diff;
+		}
+		return;
+	}
+	// some records wrap around, so the tree has to be built again
+	RzPVector records;
+	rz_pvector_init(&records, NULL);
+	rz_rbtree_foreach (*root, it, record, RzAnalysisRangedHintRecordBase, rb) {
+		rz_pvector_push(&records, record);
+	}
+	*root = NULL;
+	void **iter;
+	rz_pvector_foreach (&records, iter) {
+		record = *iter;
+		record->addr += diff;
+		rz_rbtree_insert(root, &record->addr, &record->rb, ranged_hint_record_cmp, NULL);
+	}
+	rz_pvector_fini(&records);
+}
+
+/**
+ * \brief Moves all hints by \p diff, e.g. after the binary was rebased
+ *
+ * Jump and fail targets are moved along with the hinted addresses.
+ */
+RZ_API void rz_analysis_hint_rebase(RzAnalysis *a, ut64 diff) {
+	rz_return_if_fail(a);
+	if (!diff) {
+		return;
+	}
+	HtUP *old = a->addr_hints;
+	RebaseCtx ctx = { ht_up_new_size(old->count, NULL, addr_hint_record_ht_free, NULL), diff };
+	if (ctx.ht) {
+		ht_up_foreach(old, addr_hint_rebase_cb, &ctx);
+		// the records have been moved to the new table
+		old->opt.freefn = NULL;
+		ht_up_free(old);
+		a->addr_hints = ctx.ht;
+	}
+	ranged_hints_rebase(&a->arch_hints, diff);
+	ranged_hints_rebase(&a->bits_hints, diff);
+	hints_changed(a);
+}
+
 static void unset_addr_hint_record(RzAnalysis *analysis, RzAnalysisAddrHintType type, ut64 addr) {
 	RzVector *records = ht_up_find(analysis->addr_hints, addr, NULL);
 	if (!records) {
@@ -148,6 +240,7 @@ static void unset_addr_hint_record(RzAnalysis *analysis, RzAnalysisAddrHintType
 		if (record->type == type) {
 			addr_hint_record_fini(record, NULL);
 			rz_vector_remove_at(records, i, NULL);
+			hints_changed(analysis);
 			return;
 		}
 	}
@@ -155,6 +248,7 @@ static void unset_addr_hint_record(RzAnalysis *analysis, RzAnalysisAddrHintType
 
 // create or return the existing addr hint record of the given type at addr
 static RzAnalysisAddrHintRecord *ensure_addr_hint_record(RzAnalysis *analysis, RzAnalysisAddrHintType type, ut64 addr) {
+	hints_changed(analysis);
 	RzVector *records = ht_up_find(analysis->addr_hints, addr, NULL);
 	if (!records) {
 		records = rz_vector_new(sizeof(RzAnalysisAddrHintRecord), addr_hint_record_fini, NULL);
@@ -281,6 +375,7 @@ RZ_API void rz_analysis_hint_set_arch(RzAnalysis *a, ut64 addr, RZ_NULLABLE cons
 	if (!record) {
 		return;
 	}
+	hints_changed(a);
 	free(record->arch);
 	record->arch = arch ? strdup(arch) : NULL;
 }
@@ -290,6 +385,7 @@ RZ_API void rz_analysis_hint_set_bits(RzAnalysis *a, ut64 addr, int bits) {
 	if (!record) {
 		return;
 	}
+	hints_changed(a);
 	record->bits = bits;
 	if (a->hint_cbs.on_bits) {
 		a->hint_cbs.on_bits(a, addr, bits, true);
@@ -361,10 +457,12 @@ RZ_API void rz_analysis_hint_unset_stackframe(RzAnalysis *a, ut64 addr) {
 }
 
 RZ_API void rz_analysis_hint_unset_arch(RzAnalysis *a, ut64 addr) {
+	hints_changed(a);
 	rz_rbtree_delete(&a->arch_hints, &addr, ranged_hint_record_cmp, NULL, arch_hint_record_free_rb, NULL);
 }
 
 RZ_API void rz_analysis_hint_unset_bits(RzAnalysis *a, ut64 addr) {
+	hints_changed(a);
 	rz_rbtree_delete(&a->bits_hints, &addr, ranged_hint_record_cmp, NULL, bits_hint_record_free_rb, NULL);
 }
 
@@ -450,7 +548,8 @@ RZ_API void rz_analysis_bits_hints_foreach(RzAnalysis *analysis, RzAnalysisBitsH
 	}
 }
 
-static void hint_merge(RzAnalysisHint *hint, RzAnalysisAddrHintRecord *record) {
+// borrow => the strings of hint point into record instead of being copies
+static void hint_merge(RzAnalysisHint *hint, const RzAnalysisAddrHintRecord *record, bool borrow) {
 	switch (record->type) {
 	case RZ_ANALYSIS_ADDR_HINT_TYPE_IMMBASE:
 		hint->immbase = record->immbase;
@@ -480,19 +579,19 @@ static void hint_merge(RzAnalysisHint *hint, RzAnalysisAddrHintRecord *record) {
 		hint->size = record->size;
 		break;
 	case RZ_ANALYSIS_ADDR_HINT_TYPE_SYNTAX:
-		hint->syntax = record->syntax ? strdup(record->syntax) : NULL;
+		hint->syntax = borrow || !record->syntax ? record->syntax : strdup(record->syntax);
 		break;
 	case RZ_ANALYSIS_ADDR_HINT_TYPE_OPTYPE:
 		hint->type = record->optype;
 		break;
 	case RZ_ANALYSIS_ADDR_HINT_TYPE_OPCODE:
-		hint->opcode = record->opcode ? strdup(record->opcode) : NULL;
+		hint->opcode = borrow || !record->opcode ? record->opcode : strdup(record->opcode);
 		break;
 	case RZ_ANALYSIS_ADDR_HINT_TYPE_TYPE_OFFSET:
-		hint->offset = record->type_offset ? strdup(record->type_offset) : NULL;
+		hint->offset = borrow || !record->type_offset ? record->type_offset : strdup(record->type_offset);
 		break;
 	case RZ_ANALYSIS_ADDR_HINT_TYPE_ESIL:
-		hint->esil = record->esil ? strdup(record->esil) : NULL;
+		hint->esil = borrow || !record->esil ? record->esil : strdup(record->esil);
 		break;
 	case RZ_ANALYSIS_ADDR_HINT_TYPE_HIGH:
 		hint->high = true;
@@ -503,22 +602,30 @@ static void hint_merge(RzAnalysisHint *hint, RzAnalysisAddrHintRecord *record) {
 	}
 }
 
-RZ_API RzAnalysisHint *rz_analysis_hint_get(RzAnalysis *a, ut64 addr) {
-	RzAnalysisHint *hint = RZ_NEW0(RzAnalysisHint);
-	if (!hint) {
-		return NULL;
-	}
+static void hint_init(RzAnalysisHint *hint, ut64 addr) {
+	memset(hint, 0, sizeof(*hint));
 	hint->addr = addr;
 	hint->jump = UT64_MAX;
 	hint->fail = UT64_MAX;
 	hint->ret = UT64_MAX;
 	hint->val = UT64_MAX;
 	hint->stackframe = UT64_MAX;
+}
+
+RZ_API RzAnalysisHint *rz_analysis_hint_get(RzAnalysis *a, ut64 addr) {
+	if (hints_empty(a)) {
+		return NULL;
+	}
+	RzAnalysisHint *hint = RZ_NEW(RzAnalysisHint);
+	if (!hint) {
+		return NULL;
+	}
+	hint_init(hint, addr);
 	const RzVector *records = rz_analysis_addr_hints_at(a, addr);
 	if (records) {
 		RzAnalysisAddrHintRecord *record;
 		rz_vector_foreach(records, record) {
-			hint_merge(hint, record);
+			hint_merge(hint, record, false);
 		}
 	}
 	const char *arch = rz_analysis_hint_arch_at(a, addr, NULL);
@@ -531,3 +638,95 @@ RZ_API RzAnalysisHint *rz_analysis_hint_get(RzAnalysis *a, ut64 addr) {
 	}
 	return hint;
 }
+
+/**
+ * \brief Initialize \p cursor for looking up the hints of \p analysis
+ *
+ * The cursor does not own anything and needs no cleanup.
+ */
+RZ_API void rz_analysis_hint_cursor_init(RZ_NONNULL RzAnalysisHintCursor *cursor, RZ_NONNULL RzAnalysis *analysis) {
+	rz_return_if_fail(cursor && analysis);
+	memset(cursor, 0, sizeof(*cursor));
+	cursor->analysis = analysis;
+	cursor->gen = analysis->hints_gen;
+	// empty ranges, so the first lookup fills them
+	cursor->arch_from = cursor->bits_from = 1;
+}
+
+/**
+ * Find the record of \p tree in effect at \p addr and the range [from, to] where it applies.
+ */
+static RzAnalysisRangedHintRecordBase *ranged_hint_range(RBTree tree, ut64 addr, ut64 *from, ut64 *to) {
+	RBNode *node = rz_rbtree_upper_bound(tree, &addr, ranged_hint_record_cmp, NULL);
+	RzAnalysisRangedHintRecordBase *record = node ? container_of(node, RzAnalysisRangedHintRecordBase, rb) : NULL;
+	*from = record ? record->addr : 0;
+	*to = UT64_MAX;
+	if (addr != UT64_MAX) {
+		ut64 next_addr = addr + 1;
+		RBNode *next = rz_rbtree_lower_bound(tree, &next_addr, ranged_hint_record_cmp, NULL);
+		if (next) {
+			*to = container_of(next, RzAnalysisRangedHintRecordBase, rb)->addr - 1;
+		}
+	}
+	return record;
+}
+
+/**
+ * \brief Get all hints affecting \p addr, like rz_analysis_hint_get() but without any allocation
+ *
+ * Lookups for ascending addresses are the fastest, since the arch and bits hints
+ * are only searched again when leaving the range of the previous ones.
+ *
+ * \return a view that borrows all its strings from the hints storage, or NULL if
+ * there are no hints at \p addr. It is valid until the next lookup with \p cursor
+ * or the next change of the hints.
+ */
+RZ_API RZ_NULLABLE RZ_BORROW const RzAnalysisHint *rz_analysis_hint_cursor_at(RZ_NONNULL RzAnalysisHintCursor *cursor, ut64 addr) {
+	rz_return_val_if_fail(cursor && cursor->analysis, NULL);
+	RzAnalysis *a = cursor->analysis;
+	if (hints_empty(a)) {
+		return NULL;
+	}
+	if (cursor->gen != a->hints_gen) {
+		cursor->gen = a->hints_gen;
+		cursor->arch_from = cursor->bits_from = 1;
+		cursor->arch_to = cursor->bits_to = 0;
+	}
+	if (addr < cursor->arch_from || addr > cursor->arch_to) {
+		RzAnalysisArchHintRecord *record = (RzAnalysisArchHintRecord *)ranged_hint_range(a->arch_hints, addr, &cursor->arch_from, &cursor->arch_to);
+		cursor->arch = record ? record->arch : NULL;
+	}
+	if (addr < cursor->bits_from || addr > cursor->bits_to) {
+		RzAnalysisBitsHintRecord *record = (RzAnalysisBitsHintRecord *)ranged_hint_range(a->bits_hints, addr, &cursor->bits_from, &cursor->bits_to);
+		cursor->bits = record ? record->bits : 0;
+	}
+	const RzVector *records = a->addr_hints->count ? rz_analysis_addr_hints_at(a, addr) : NULL;
+	if ((!records || rz_vector_empty(records)) && !cursor->arch && !cursor->bits) {
+		return NULL;
+	}
+	RzAnalysisHint *hint = &cursor->view;
+	hint_init(hint, addr);
+	if (records) {
+		RzAnalysisAddrHintRecord *record;
+		rz_vector_foreach(records, record) {
+			hint_merge(hint, record, true);
+		}
+	}
+	hint->arch = (char *)cursor->arch;
+	hint->bits = cursor->bits;
+	return hint;
+}
+
+/**
+ * \brief Get all hints affecting \p addr through a cursor owned by \p analysis
+ *
+ * Same as rz_analysis_hint_cursor_at(), the view is valid until the next call
+ * of this function or the next change of the hints.
+ */
+RZ_API RZ_NULLABLE RZ_BORROW const RzAnalysisHint *rz_analysis_hint_view_at(RZ_NONNULL RzAnalysis *analysis, ut64 addr) {
+	rz_return_val_if_fail(analysis, NULL);
+	if (!analysis->hint_cursor) {
+		return NULL;
+	}
+	return rz_analysis_hint_cursor_at(analysis->hint_cursor, addr);
+}
@@ -0,0 +1,1765 @@
+// SPDX-FileCopyrightText: 2023 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+/**
+ * \file
+ * \brief SSA form over the IL of a function
+ *
+ * Construction follows "Simple and Efficient Construction of Static Single
+ * Assignment Form" (Braun et al.): blocks are lifted once in reverse postorder,
+ * phis are only created where a variable is actually read and trivial ones are
+ * removed on the fly. The same lookup is used after construction, so queries
+ * about values no instruction reads only create the phis they need.
+ *
+ * Constant propagation runs sparsely on the def-use graph: a query only solves
+ * the backward slice of the definition it is about and caches the results.
+ */
+
+#include <rz_analysis.h>
+#include <rz_util/ht_pu.h>
+#include <rz_util/ht_uu.h>
+
+#define SSA_MAX_CONSTS 8
+
+typedef enum {
+	CONSTS_TOP, ///< nothing flowed in yet
+	CONSTS_SET, ///< one of a few known constants
+	CONSTS_BOTTOM, ///< anything
+} ConstsState;
+
+typedef struct {
+	ConstsState state;
+	bool final; ///< the whole backward slice has been solved
+	ut32 bits;
+	ut32 count;
+	ut64 values[SSA_MAX_CONSTS];
+} Consts;
+
+typedef struct {
+	ut32 var;
+	ut32 prev; ///< definition live before the write, UT32_MAX if none
+} UndoEntry;
+
+typedef struct {
+	RzAnalysisILSSA *ssa;
+	ut32 block;
+	ut64 addr;
+	RzVector /*<UndoEntry>*/ undo; ///< writes of the current instruction
+} Lifter;
+
+static inline RzAnalysisILSSADef *def_at(RzAnalysisILSSA *ssa, ut32 id) {
+	return rz_pvector_at(&ssa->defs, id);
+}
+
+static inline RzAnalysisILSSABlock *block_at(RzAnalysisILSSA *ssa, ut32 idx) {
+	return rz_vector_index_ptr(&ssa->blocks, idx);
+}
+
+static void def_free(RzAnalysisILSSADef *def) {
+	if (!def) {
+		return;
+	}
+	rz_vector_fini(&def->operands);
+	rz_vector_fini(&def->users);
+	free(def);
+}
+
+static void var_free(RzAnalysisILSSAVar *var) {
+	if (!var) {
+		return;
+	}
+	free(var->name);
+	free(var);
+}
+
+static void block_fini(void *e, RZ_UNUSED void *user) {
+	RzAnalysisILSSABlock *block = e;
+	rz_vector_fini(&block->preds);
+	rz_vector_fini(&block->phis);
+	rz_vector_fini(&block->defs);
+	ht_uu_free(block->out);
+	ht_uu_free(block->in);
+}
+
+/**
+ * \name Variables and definitions
+ * @{
+ */
+
+/**
+ * Index of the variable \p name, UT32_MAX if the function never accesses it
+ */
+static ut32 var_find(RzAnalysisILSSA *ssa, const char *name, bool local) {
+	bool found = false;
+	ut32 idx = ht_pu_find(local ? ssa->locals : ssa->globals, name, &found);
+	return found ? idx : UT32_MAX;
+}
+
+static ut32 var_get(RzAnalysisILSSA *ssa, const char *name, bool local, bool mem) {
+	ut32 idx = var_find(ssa, name, local);
+	if (idx != UT32_MAX) {
+		return idx;
+	}
+	RzAnalysisILSSAVar *var = RZ_NEW0(RzAnalysisILSSAVar);
+	if (!var) {
+		return UT32_MAX;
+	}
+	var->name = strdup(name);
+	var->local = local;
+	var->mem = mem;
+	var->entry = UT32_MAX;
+	if (!var->name || !rz_pvector_push(&ssa->vars, var)) {
+		var_free(var);
+		return UT32_MAX;
+	}
+	idx = rz_pvector_len(&ssa->vars) - 1;
+	ht_pu_insert(local ? ssa->locals : ssa->globals, name, idx);
+	return idx;
+}
+
+static ut32 mem_var_get(RzAnalysisILSSA *ssa, RzILMemIndex index) {
+	char name[32];
+	if (index) {
+		rz_strf(name, "mem%u", (unsigned int)index);
+	} else {
+		rz_strf(name, "mem");
+	}
+	return var_get(ssa, name, false, true);
+}
+
+static RzAnalysisILSSADef *def_new(RzAnalysisILSSA *ssa, RzAnalysisILSSADefKind kind, ut32 var, ut32 block, ut64 addr) {
+	RzAnalysisILSSADef *def = RZ_NEW0(RzAnalysisILSSADef);
+	if (!def) {
+		return NULL;
+	}
+	def->id = rz_pvector_len(&ssa->defs);
+	def->kind = kind;
+	def->var = var;
+	def->block = block;
+	def->addr = addr;
+	rz_vector_init(&def->operands, sizeof(RzAnalysisILSSAOperand), NULL, NULL);
+	rz_vector_init(&def->users, sizeof(ut32), NULL, NULL);
+	if (!rz_pvector_push(&ssa->defs, def)) {
+		def_free(def);
+		return NULL;
+	}
+	if (var != UT32_MAX) {
+		RzAnalysisILSSAVar *v = rz_pvector_at(&ssa->vars, var);
+		def->version = v->versions++;
+	}
+	return def;
+}
+
+static void def_add_operand(RzAnalysisILSSA *ssa, RzAnalysisILSSADef *def, ut32 used, RzILOpPure *node, ut64 pred) {
+	RzAnalysisILSSAOperand op = { .def = used, .node = node, .pred = pred };
+	rz_vector_push(&def->operands, &op);
+	if (used != UT32_MAX) {
+		rz_vector_push(&def_at(ssa, used)->users, &def->id);
+	}
+}
+
+static void users_remove(RzAnalysisILSSADef *def, ut32 user) {
+	for (size_t i = 0; i < rz_vector_len(&def->users);) {
+		if (*(ut32 *)rz_vector_index_ptr(&def->users, i) == user) {
+			rz_vector_remove_at(&def->users, i, NULL);
+		} else {
+			i++;
+		}
+	}
+}
+
+static void ids_remove(RzVector /*<ut32>*/ *ids, ut32 id) {
+	for (size_t i = 0; i < rz_vector_len(ids); i++) {
+		if (*(ut32 *)rz_vector_index_ptr(ids, i) == id) {
+			rz_vector_remove_at(ids, i, NULL);
+			return;
+		}
+	}
+}
+
+/**
+ * Follow removed phis to the definition that replaced them.
+ */
+static ut32 def_resolve(RzAnalysisILSSA *ssa, ut32 id) {
+	while (id != UT32_MAX) {
+		RzAnalysisILSSADef *def = def_at(ssa, id);
+		if (def->kind != RZ_ANALYSIS_IL_SSA_DEF_DEAD) {
+			break;
+		}
+		RzAnalysisILSSAOperand *op = rz_vector_head(&def->operands);
+		id = op ? op->def : UT32_MAX;
+	}
+	return id;
+}
+
+static ut32 entry_def_get(RzAnalysisILSSA *ssa, ut32 var) {
+	RzAnalysisILSSAVar *v = rz_pvector_at(&ssa->vars, var);
+	if (v->entry != UT32_MAX) {
+		return v->entry;
+	}
+	RzAnalysisILSSADef *def = def_new(ssa, RZ_ANALYSIS_IL_SSA_DEF_ENTRY, var, ssa->entry, ssa->fcn->addr);
+	if (!def) {
+		return UT32_MAX;
+	}
+	v->entry = def->id;
+	return def->id;
+}
+
+/// @}
+
+/**
+ * \name On-the-fly SSA construction
+ * @{
+ */
+
+static ut32 var_read(RzAnalysisILSSA *ssa, ut32 block, ut32 var);
+
+static ut32 phi_try_remove_trivial(RzAnalysisILSSA *ssa, ut32 phi_id) {
+	RzAnalysisILSSADef *phi = def_at(ssa, phi_id);
+	if (phi->kind != RZ_ANALYSIS_IL_SSA_DEF_PHI) {
+		return phi_id;
+	}
+	ut32 same = UT32_MAX;
+	RzAnalysisILSSAOperand *op;
+	rz_vector_foreach(&phi->operands, op) {
+		ut32 d = def_resolve(ssa, op->def);
+		if (d == same || d == phi_id) {
+			continue;
+		}
+		if (same != UT32_MAX) {
+			// merges at least two values
+			return phi_id;
+		}
+		same = d;
+	}
+	if (same == UT32_MAX) {
+		// unreachable or only reached from itself
+		same = entry_def_get(ssa, phi->var);
+		if (same == UT32_MAX) {
+			return phi_id;
+		}
+	}
+
+	RzVector users;
+	rz_vector_init(&users, sizeof(ut32), NULL, NULL);
+	ut32 *user;
+	rz_vector_foreach(&phi->users, user) {
+		if (*user != phi_id) {
+			rz_vector_push(&users, user);
+		}
+	}
+
+	rz_vector_foreach(&phi->operands, op) {
+		if (op->def != UT32_MAX && op->def != phi_id) {
+			users_remove(def_at(ssa, op->def), phi_id);
+		}
+	}
+	rz_vector_clear(&phi->operands);
+	rz_vector_clear(&phi->users);
+	phi->kind = RZ_ANALYSIS_IL_SSA_DEF_DEAD;
+	def_add_operand(ssa, phi, same, NULL, UT64_MAX);
+	users_remove(def_at(ssa, same), phi_id);
+	ids_remove(&block_at(ssa, phi->block)->phis, phi_id);
+
+	RzAnalysisILSSADef *target = def_at(ssa, same);
+	rz_vector_foreach(&users, user) {
+		RzAnalysisILSSADef *u = def_at(ssa, *user);
+		rz_vector_foreach(&u->operands, op) {
+			if (op->def == phi_id) {
+				op->def = same;
+				rz_vector_push(&target->users, user);
+			}
+		}
+	}
+	rz_vector_foreach(&users, user) {
+		phi_try_remove_trivial(ssa, *user);
+	}
+	rz_vector_fini(&users);
+	return same;
+}
+
+static ut32 phi_add_operands(RzAnalysisILSSA *ssa, ut32 phi_id) {
+	RzAnalysisILSSADef *phi = def_at(ssa, phi_id);
+	RzAnalysisILSSABlock *block = block_at(ssa, phi->block);
+	ut32 var = phi->var;
+	if (phi->block == ssa->entry) {
+		def_add_operand(ssa, phi, entry_def_get(ssa, var), NULL, UT64_MAX);
+	}
+	for (size_t i = 0; i < rz_vector_len(&block->preds); i++) {
+		ut32 pred = *(ut32 *)rz_vector_index_ptr(&block->preds, i);
+		ut32 val = var_read(ssa, pred, var);
+		def_add_operand(ssa, phi, val, NULL, block_at(ssa, pred)->bb->addr);
+	}
+	return phi_try_remove_trivial(ssa, phi_id);
+}
+
+static RzAnalysisILSSADef *phi_new(RzAnalysisILSSA *ssa, ut32 block, ut32 var) {
+	RzAnalysisILSSABlock *b = block_at(ssa, block);
+	RzAnalysisILSSADef *phi = def_new(ssa, RZ_ANALYSIS_IL_SSA_DEF_PHI, var, block, b->bb->addr);
+	if (phi) {
+		rz_vector_push(&b->phis, &phi->id);
+	}
+	return phi;
+}
+
+/**
+ * Value of \p var at the start of \p block, assuming the block itself does not change it before.
+ */
+static ut32 var_read_entry(RzAnalysisILSSA *ssa, ut32 block, ut32 var, bool cache) {
+	RzAnalysisILSSABlock *b = block_at(ssa, block);
+	ut32 val;
+	if (!b->sealed) {
+		RzAnalysisILSSADef *phi = phi_new(ssa, block, var);
+		val = phi ? phi->id : UT32_MAX;
+	} else if (!rz_vector_len(&b->preds)) {
+		val = entry_def_get(ssa, var);
+	} else if (rz_vector_len(&b->preds) == 1 && block != ssa->entry) {
+		val = var_read(ssa, *(ut32 *)rz_vector_head(&b->preds), var);
+	} else {
+		RzAnalysisILSSADef *phi = phi_new(ssa, block, var);
+		if (!phi) {
+			return UT32_MAX;
+		}
+		if (cache) {
+			// break cycles through loops before looking at the predecessors,
+			// otherwise the block's own definition already does
+			ht_uu_update(b->out, var, phi->id);
+		}
+		val = phi_add_operands(ssa, phi->id);
+	}
+	if (cache && val != UT32_MAX) {
+		ht_uu_update(b->out, var, val);
+	}
+	return val;
+}
+
+/**
+ * Value of \p var at the current end of \p block
+ */
+static ut32 var_read(RzAnalysisILSSA *ssa, ut32 block, ut32 var) {
+	RzAnalysisILSSABlock *b = block_at(ssa, block);
+	bool found = false;
+	ut32 id = ht_uu_find(b->out, var, &found);
+	if (found) {
+		return def_resolve(ssa, id);
+	}
+	RzAnalysisILSSAVar *v = rz_pvector_at(&ssa->vars, var);
+	if (v->local) {
+		return UT32_MAX;
+	}
+	return var_read_entry(ssa, block, var, true);
+}
+
+static void block_seal(RzAnalysisILSSA *ssa, ut32 block) {
+	RzAnalysisILSSABlock *b = block_at(ssa, block);
+	if (b->sealed) {
+		return;
+	}
+	b->sealed = true;
+	RzVector *incomplete = rz_vector_clone(&b->phis);
+	if (!incomplete) {
+		return;
+	}
+	ut32 *phi;
+	rz_vector_foreach(incomplete, phi) {
+		if (def_at(ssa, *phi)->kind == RZ_ANALYSIS_IL_SSA_DEF_PHI) {
+			phi_add_operands(ssa, *phi);
+		}
+	}
+	rz_vector_free(incomplete);
+}
+
+static bool block_preds_filled(RzAnalysisILSSA *ssa, ut32 block) {
+	RzAnalysisILSSABlock *b = block_at(ssa, block);
+	ut32 *pred;
+	rz_vector_foreach(&b->preds, pred) {
+		if (!block_at(ssa, *pred)->filled) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/// @}
+
+/**
+ * \name Lifting
+ * @{
+ */
+
+static void var_write(Lifter *l, ut32 var, ut32 def) {
+	RzAnalysisILSSABlock *b = block_at(l->ssa, l->block);
+	bool found = false;
+	ut32 prev = ht_uu_find(b->out, var, &found);
+	UndoEntry e = { .var = var, .prev = found ? prev : UT32_MAX };
+	rz_vector_push(&l->undo, &e);
+	ht_uu_update(b->out, var, def);
+}
+
+static void undo_to(Lifter *l, size_t mark) {
+	RzAnalysisILSSABlock *b = block_at(l->ssa, l->block);
+	while (rz_vector_len(&l->undo) > mark) {
+		UndoEntry e;
+		rz_vector_pop(&l->undo, &e);
+		if (e.prev == UT32_MAX) {
+			ht_uu_delete(b->out, e.var);
+		} else {
+			ht_uu_update(b->out, e.var, e.prev);
+		}
+	}
+}
+
+/**
+ * Variables written since \p mark and the definitions they end up with
+ */
+static void written_since(Lifter *l, size_t mark, RzVector /*<UndoEntry>*/ *out) {
+	RzAnalysisILSSABlock *b = block_at(l->ssa, l->block);
+	for (size_t i = mark; i < rz_vector_len(&l->undo); i++) {
+		UndoEntry *e = rz_vector_index_ptr(&l->undo, i);
+		bool seen = false;
+		UndoEntry *w;
+		rz_vector_foreach(out, w) {
+			if (w->var == e->var) {
+				seen = true;
+				break;
+			}
+		}
+		if (seen) {
+			continue;
+		}
+		UndoEntry n = { .var = e->var, .prev = ht_uu_find(b->out, e->var, NULL) };
+		rz_vector_push(out, &n);
+	}
+}
+
+static size_t pure_children(RzILOpPure *op, RzILOpPure *children[3]) {
+	switch (op->code) {
+	case RZ_IL_OP_VAR:
+	case RZ_IL_OP_B0:
+	case RZ_IL_OP_B1:
+	case RZ_IL_OP_BITV:
+	case RZ_IL_OP_FREQUAL:
+		return 0;
+	case RZ_IL_OP_ITE:
+		children[0] = op->op.ite.condition;
+		children[1] = op->op.ite.x;
+		children[2] = op->op.ite.y;
+		return 3;
+	case RZ_IL_OP_LET:
+		children[0] = op->op.let.exp;
+		children[1] = op->op.let.body;
+		return 2;
+	case RZ_IL_OP_INV:
+		children[0] = op->op.boolinv.x;
+		return 1;
+	case RZ_IL_OP_AND:
+	case RZ_IL_OP_OR:
+	case RZ_IL_OP_XOR:
+		children[0] = op->op.booland.x;
+		children[1] = op->op.booland.y;
+		return 2;
+	case RZ_IL_OP_MSB:
+	case RZ_IL_OP_LSB:
+	case RZ_IL_OP_IS_ZERO:
+		children[0] = op->op.msb.bv;
+		return 1;
+	case RZ_IL_OP_NEG:
+	case RZ_IL_OP_LOGNOT:
+		children[0] = op->op.neg.bv;
+		return 1;
+	case RZ_IL_OP_ADD:
+	case RZ_IL_OP_SUB:
+	case RZ_IL_OP_MUL:
+	case RZ_IL_OP_DIV:
+	case RZ_IL_OP_SDIV:
+	case RZ_IL_OP_MOD:
+	case RZ_IL_OP_SMOD:
+	case RZ_IL_OP_LOGAND:
+	case RZ_IL_OP_LOGOR:
+	case RZ_IL_OP_LOGXOR:
+		children[0] = op->op.add.x;
+		children[1] = op->op.add.y;
+		return 2;
+	case RZ_IL_OP_SHIFTR:
+	case RZ_IL_OP_SHIFTL:
+		children[0] = op->op.shiftl.fill_bit;
+		children[1] = op->op.shiftl.x;
+		children[2] = op->op.shiftl.y;
+		return 3;
+	case RZ_IL_OP_EQ:
+	case RZ_IL_OP_SLE:
+	case RZ_IL_OP_ULE:
+		children[0] = op->op.eq.x;
+		children[1] = op->op.eq.y;
+		return 2;
+	case RZ_IL_OP_CAST:
+		children[0] = op->op.cast.fill;
+		children[1] = op->op.cast.val;
+		return 2;
+	case RZ_IL_OP_APPEND:
+		children[0] = op->op.append.high;
+		children[1] = op->op.append.low;
+		return 2;
+	case RZ_IL_OP_LOAD:
+		children[0] = op->op.load.key;
+		return 1;
+	case RZ_IL_OP_LOADW:
+		children[0] = op->op.loadw.key;
+		return 1;
+	case RZ_IL_OP_FLOAT:
+		children[0] = op->op.float_.bv;
+		return 1;
+	case RZ_IL_OP_FCAST_FLOAT:
+	case RZ_IL_OP_FCAST_SFLOAT:
+		children[0] = op->op.fcast_float.bv;
+		return 1;
+	case RZ_IL_OP_FCAST_INT:
+	case RZ_IL_OP_FCAST_SINT:
+		children[0] = op->op.fcast_int.f;
+		return 1;
+	case RZ_IL_OP_FCONVERT:
+		children[0] = op->op.fconvert.f;
+		return 1;
+	case RZ_IL_OP_FBITS:
+	case RZ_IL_OP_IS_FINITE:
+	case RZ_IL_OP_IS_NAN:
+	case RZ_IL_OP_IS_INF:
+	case RZ_IL_OP_IS_FZERO:
+	case RZ_IL_OP_IS_FNEG:
+	case RZ_IL_OP_IS_FPOS:
+	case RZ_IL_OP_FNEG:
+	case RZ_IL_OP_FABS:
+	case RZ_IL_OP_FSUCC:
+	case RZ_IL_OP_FPRED:
+		children[0] = op->op.fbits.f;
+		return 1;
+	case RZ_IL_OP_FROUND:
+	case RZ_IL_OP_FSQRT:
+	case RZ_IL_OP_FRSQRT:
+		children[0] = op->op.fround.f;
+		return 1;
+	case RZ_IL_OP_FORDER:
+		children[0] = op->op.forder.x;
+		children[1] = op->op.forder.y;
+		return 2;
+	case RZ_IL_OP_FADD:
+	case RZ_IL_OP_FSUB:
+	case RZ_IL_OP_FMUL:
+	case RZ_IL_OP_FDIV:
+	case RZ_IL_OP_FMOD:
+	case RZ_IL_OP_FHYPOT:
+	case RZ_IL_OP_FPOW:
+		children[0] = op->op.fadd.x;
+		children[1] = op->op.fadd.y;
+		return 2;
+	case RZ_IL_OP_FMAD:
+		children[0] = op->op.fmad.x;
+		children[1] = op->op.fmad.y;
+		children[2] = op->op.fmad.z;
+		return 3;
+	case RZ_IL_OP_FROOTN:
+	case RZ_IL_OP_FPOWN:
+	case RZ_IL_OP_FCOMPOUND:
+		children[0] = op->op.frootn.f;
+		children[1] = op->op.frootn.n;
+		return 2;
+	default:
+		return 0;
+	}
+}
+
+/**
+ * Link \p def to the definitions of everything \p op reads
+ */
+static void lift_uses(Lifter *l, RzAnalysisILSSADef *def, RzILOpPure *op) {
+	if (!op) {
+		return;
+	}
+	RzAnalysisILSSA *ssa = l->ssa;
+	switch (op->code) {
+	case RZ_IL_OP_VAR:
+		if (op->op.var.kind == RZ_IL_VAR_KIND_LOCAL_PURE) {
+			return;
+		}
+		ut32 var = var_get(ssa, op->op.var.v, op->op.var.kind == RZ_IL_VAR_KIND_LOCAL, false);
+		if (var != UT32_MAX) {
+			def_add_operand(ssa, def, var_read(ssa, l->block, var), op, UT64_MAX);
+		}
+		return;
+	case RZ_IL_OP_LOAD:
+	case RZ_IL_OP_LOADW: {
+		ut32 mem = mem_var_get(ssa, op->code == RZ_IL_OP_LOAD ? op->op.load.mem : op->op.loadw.mem);
+		if (mem != UT32_MAX) {
+			def_add_operand(ssa, def, var_read(ssa, l->block, mem), op, UT64_MAX);
+		}
+		break;
+	}
+	default:
+		break;
+	}
+	RzILOpPure *children[3];
+	size_t n = pure_children(op, children);
+	for (size_t i = 0; i < n; i++) {
+		lift_uses(l, def, children[i]);
+	}
+}
+
+static RzAnalysisILSSADef *lift_def(Lifter *l, RzAnalysisILSSADefKind kind, ut32 var) {
+	RzAnalysisILSSADef *def = def_new(l->ssa, kind, var, l->block, l->addr);
+	if (def) {
+		rz_vector_push(&block_at(l->ssa, l->block)->defs, &def->id);
+	}
+	return def;
+}
+
+static void lift_effect(Lifter *l, RzILOpEffect *op);
+
+/**
+ * Merge the variables written by two alternative effects, \p y may be NULL.
+ * If \p repeat, the effects run an unknown number of times.
+ */
+static void lift_alternatives(Lifter *l, RzILOpPure *cond, RzILOpEffect *x, RzILOpEffect *y, bool repeat) {
+	RzAnalysisILSSA *ssa = l->ssa;
+	RzVector wx, wy;
+	rz_vector_init(&wx, sizeof(UndoEntry), NULL, NULL);
+	rz_vector_init(&wy, sizeof(UndoEntry), NULL, NULL);
+
+	size_t mark = rz_vector_len(&l->undo);
+	lift_effect(l, x);
+	written_since(l, mark, &wx);
+	undo_to(l, mark);
+	if (y) {
+		lift_effect(l, y);
+		written_since(l, mark, &wy);
+		undo_to(l, mark);
+	}
+
+	// every variable written on either side gets a merged definition
+	UndoEntry *w;
+	rz_vector_foreach(&wy, w) {
+		bool seen = false;
+		UndoEntry *v;
+		rz_vector_foreach(&wx, v) {
+			if (v->var == w->var) {
+				seen = true;
+				break;
+			}
+		}
+		if (!seen) {
+			UndoEntry n = { .var = w->var, .prev = UT32_MAX };
+			rz_vector_push(&wx, &n);
+		}
+	}
+	// all merges read the state from before the branch, so write them last
+	RzVector merged;
+	rz_vector_init(&merged, sizeof(UndoEntry), NULL, NULL);
+	rz_vector_foreach(&wx, w) {
+		ut32 before = var_read(ssa, l->block, w->var);
+		ut32 tx = w->prev != UT32_MAX ? w->prev : before;
+		ut32 ty = before;
+		UndoEntry *v;
+		rz_vector_foreach(&wy, v) {
+			if (v->var == w->var) {
+				ty = v->prev;
+				break;
+			}
+		}
+		RzAnalysisILSSADef *def = lift_def(l, repeat ? RZ_ANALYSIS_IL_SSA_DEF_CLOBBER : RZ_ANALYSIS_IL_SSA_DEF_ITE, w->var);
+		if (!def) {
+			break;
+		}
+		def->value = cond;
+		def_add_operand(ssa, def, def_resolve(ssa, tx), NULL, UT64_MAX);
+		def_add_operand(ssa, def, def_resolve(ssa, ty), NULL, UT64_MAX);
+		lift_uses(l, def, cond);
+		UndoEntry m = { .var = w->var, .prev = def->id };
+		rz_vector_push(&merged, &m);
+	}
+	rz_vector_foreach(&merged, w) {
+		var_write(l, w->var, w->prev);
+	}
+	rz_vector_fini(&merged);
+
+	rz_vector_fini(&wx);
+	rz_vector_fini(&wy);
+}
+
+static void lift_effect(Lifter *l, RzILOpEffect *op) {
+	if (!op) {
+		return;
+	}
+	RzAnalysisILSSA *ssa = l->ssa;
+	switch (op->code) {
+	case RZ_IL_OP_SEQ:
+		lift_effect(l, op->op.seq.x);
+		lift_effect(l, op->op.seq.y);
+		break;
+	case RZ_IL_OP_BLK:
+		lift_effect(l, op->op.blk.data_eff);
+		lift_effect(l, op->op.blk.ctrl_eff);
+		break;
+	case RZ_IL_OP_SET: {
+		ut32 var = var_get(ssa, op->op.set.v, op->op.set.is_local, false);
+		if (var == UT32_MAX) {
+			break;
+		}
+		RzAnalysisILSSADef *def = lift_def(l, RZ_ANALYSIS_IL_SSA_DEF_SET, var);
+		if (!def) {
+			break;
+		}
+		def->value = op->op.set.x;
+		// the value is read before the variable is overwritten
+		lift_uses(l, def, op->op.set.x);
+		var_write(l, var, def->id);
+		break;
+	}
+	case RZ_IL_OP_STORE:
+	case RZ_IL_OP_STOREW: {
+		bool w = op->code == RZ_IL_OP_STOREW;
+		ut32 mem = mem_var_get(ssa, w ? op->op.storew.mem : op->op.store.mem);
+		if (mem == UT32_MAX) {
+			break;
+		}
+		RzAnalysisILSSADef *def = lift_def(l, RZ_ANALYSIS_IL_SSA_DEF_STORE, mem);
+		if (!def) {
+			break;
+		}
+		def->value = w ? op->op.storew.value : op->op.store.value;
+		def_add_operand(ssa, def, var_read(ssa, l->block, mem), NULL, UT64_MAX);
+		lift_uses(l, def, w ? op->op.storew.key : op->op.store.key);
+		lift_uses(l, def, def->value);
+		var_write(l, mem, def->id);
+		break;
+	}
+	case RZ_IL_OP_JMP: {
+		RzAnalysisILSSADef *def = lift_def(l, RZ_ANALYSIS_IL_SSA_DEF_JMP, UT32_MAX);
+		if (def) {
+			def->value = op->op.jmp.dst;
+			lift_uses(l, def, def->value);
+		}
+		break;
+	}
+	case RZ_IL_OP_BRANCH:
+		lift_alternatives(l, op->op.branch.condition, op->op.branch.true_eff, op->op.branch.false_eff, false);
+		break;
+	case RZ_IL_OP_REPEAT:
+		lift_alternatives(l, op->op.repeat.condition, op->op.repeat.data_eff, NULL, true);
+		break;
+	case RZ_IL_OP_GOTO:
+		// labels are hooks of the vm, their effects are not visible here
+	case RZ_IL_OP_EMPTY:
+	case RZ_IL_OP_NOP:
+	default:
+		break;
+	}
+}
+
+static bool lift_block(RzAnalysisILSSA *ssa, ut32 idx) {
+	RzAnalysisILSSABlock *b = block_at(ssa, idx);
+	RzAnalysisBlock *bb = b->bb;
+	RzAnalysis *analysis = ssa->analysis;
+	b->filled = true;
+	if (!bb->size || bb->size > ST32_MAX) {
+		return true;
+	}
+	ut8 *buf = malloc(bb->size);
+	if (!buf) {
+		return false;
+	}
+	if (!analysis->iob.read_at(analysis->iob.io, bb->addr, buf, (int)bb->size)) {
+		free(buf);
+		return false;
+	}
+
+	Lifter l = { .ssa = ssa, .block = idx };
+	rz_vector_init(&l.undo, sizeof(UndoEntry), NULL, NULL);
+	for (int i = 0; i < bb->ninstr; i++) {
+		ut64 addr = rz_analysis_block_get_op_addr(bb, i);
+		if (addr < bb->addr || addr >= bb->addr + bb->size) {
+			break;
+		}
+		ht_uu_insert(ssa->insns, addr, idx);
+
+		RzAnalysisOp op;
+		rz_analysis_op_init(&op);
+		ut64 off = addr - bb->addr;
+		if (rz_analysis_op(analysis, &op, addr, buf + off, (int)(bb->size - off), RZ_ANALYSIS_OP_MASK_IL) <= 0 || !op.il_op) {
+			// without IL nothing is known about the effects of this instruction
+			rz_analysis_op_fini(&op);
+			continue;
+		}
+		RzILOpEffect *eff = op.il_op;
+		op.il_op = NULL;
+		rz_analysis_op_fini(&op);
+		if (!rz_pvector_push(&ssa->ops, eff)) {
+			rz_il_op_effect_free(eff);
+			continue;
+		}
+
+		l.addr = addr;
+		rz_vector_clear(&l.undo);
+		lift_effect(&l, eff);
+
+		// locals do not survive the instruction
+		UndoEntry *e;
+		rz_vector_foreach(&l.undo, e) {
+			RzAnalysisILSSAVar *var = rz_pvector_at(&ssa->vars, e->var);
+			if (var->local) {
+				ht_uu_delete(b->out, e->var);
+			}
+		}
+	}
+	rz_vector_fini(&l.undo);
+	free(buf);
+	return true;
+}
+
+static bool blocks_init(RzAnalysisILSSA *ssa) {
+	RzAnalysisFunction *fcn = ssa->fcn;
+	HtUU *index = ht_uu_new0();
+	if (!index) {
+		return false;
+	}
+	ssa->entry = UT32_MAX;
+	RzListIter *it;
+	RzAnalysisBlock *bb;
+	rz_list_foreach (fcn->bbs, it, bb) {
+		RzAnalysisILSSABlock *b = rz_vector_push(&ssa->blocks, NULL);
+		if (!b) {
+			ht_uu_free(index);
+			return false;
+		}
+		memset(b, 0, sizeof(*b));
+		b->bb = bb;
+		rz_vector_init(&b->preds, sizeof(ut32), NULL, NULL);
+		rz_vector_init(&b->phis, sizeof(ut32), NULL, NULL);
+		rz_vector_init(&b->defs, sizeof(ut32), NULL, NULL);
+		b->out = ht_uu_new0();
+		if (!b->out) {
+			ht_uu_free(index);
+			return false;
+		}
+		ut32 idx = rz_vector_len(&ssa->blocks) - 1;
+		ht_uu_insert(index, bb->addr, idx);
+		if (bb->addr == fcn->addr) {
+			ssa->entry = idx;
+		}
+	}
+	if (ssa->entry == UT32_MAX) {
+		ht_uu_free(index);
+		return false;
+	}
+
+	for (ut32 i = 0; i < rz_vector_len(&ssa->blocks); i++) {
+		bb = block_at(ssa, i)->bb;
+		ut64 succs[2] = { bb->jump, bb->fail };
+		for (size_t j = 0; j < RZ_ARRAY_SIZE(succs); j++) {
+			bool found = false;
+			ut32 s = ht_uu_find(index, succs[j], &found);
+			if (found && (j == 0 || succs[1] != succs[0])) {
+				rz_vector_push(&block_at(ssa, s)->preds, &i);
+			}
+		}
+		if (bb->switch_op) {
+			RzAnalysisCaseOp *cop;
+			rz_list_foreach (bb->switch_op->cases, it, cop) {
+				bool found = false;
+				ut32 s = ht_uu_find(index, cop->jump, &found);
+				if (found) {
+					RzAnalysisILSSABlock *sb = block_at(ssa, s);
+					ut32 *pred;
+					bool dup = false;
+					rz_vector_foreach(&sb->preds, pred) {
+						if (*pred == i) {
+							dup = true;
+							break;
+						}
+					}
+					if (!dup) {
+						rz_vector_push(&sb->preds, &i);
+					}
+				}
+			}
+		}
+	}
+	ht_uu_free(index);
+	return true;
+}
+
+static void succs_fini(void *e, RZ_UNUSED void *user) {
+	rz_vector_fini(e);
+}
+
+/**
+ * Blocks in reverse postorder from the entry, followed by the unreachable ones
+ */
+static bool blocks_order(RzAnalysisILSSA *ssa, RzVector /*<ut32>*/ *order, RzVector /*<RzVector<ut32>>*/ *succs) {
+	size_t n = rz_vector_len(&ssa->blocks);
+	if (!rz_vector_reserve(succs, n)) {
+		return false;
+	}
+	for (size_t i = 0; i < n; i++) {
+		rz_vector_init(rz_vector_push(succs, NULL), sizeof(ut32), NULL, NULL);
+	}
+	for (ut32 i = 0; i < n; i++) {
+		ut32 *pred;
+		rz_vector_foreach(&block_at(ssa, i)->preds, pred) {
+			rz_vector_push(rz_vector_index_ptr(succs, *pred), &i);
+		}
+	}
+
+	ut8 *visited = RZ_NEWS0(ut8, n);
+	if (!visited) {
+		return false;
+	}
+	RzVector stack;
+	rz_vector_init(&stack, sizeof(ut64), NULL, NULL);
+	// (block << 32) | next successor to visit
+	ut64 top = (ut64)ssa->entry << 32;
+	rz_vector_push(&stack, &top);
+	visited[ssa->entry] = 1;
+	while (!rz_vector_empty(&stack)) {
+		ut64 *cur = rz_vector_tail(&stack);
+		ut32 block = *cur >> 32;
+		ut32 next = *cur & UT32_MAX;
+		RzVector *s = rz_vector_index_ptr(succs, block);
+		if (next < rz_vector_len(s)) {
+			(*cur)++;
+			ut32 succ = *(ut32 *)rz_vector_index_ptr(s, next);
+			if (!visited[succ]) {
+				visited[succ] = 1;
+				ut64 e = (ut64)succ << 32;
+				rz_vector_push(&stack, &e);
+			}
+			continue;
+		}
+		rz_vector_pop(&stack, NULL);
+		rz_vector_push(order, &block);
+	}
+	// postorder => reverse postorder
+	size_t len = rz_vector_len(order);
+	for (size_t i = 0; i < len / 2; i++) {
+		ut32 *a = rz_vector_index_ptr(order, i);
+		ut32 *b = rz_vector_index_ptr(order, len - 1 - i);
+		ut32 t = *a;
+		*a = *b;
+		*b = t;
+	}
+	for (ut32 i = 0; i < n; i++) {
+		if (!visited[i]) {
+			rz_vector_push(order, &i);
+		}
+	}
+	free(visited);
+	rz_vector_fini(&stack);
+	return true;
+}
+
+/**
+ * Resolve operands still pointing to removed phis
+ */
+static void operands_resolve(RzAnalysisILSSA *ssa) {
+	void **it;
+	rz_pvector_foreach (&ssa->defs, it) {
+		RzAnalysisILSSADef *def = *it;
+		if (def->kind == RZ_ANALYSIS_IL_SSA_DEF_DEAD) {
+			continue;
+		}
+		RzAnalysisILSSAOperand *op;
+		rz_vector_foreach(&def->operands, op) {
+			ut32 r = def_resolve(ssa, op->def);
+			if (r != op->def) {
+				op->def = r;
+				rz_vector_push(&def_at(ssa, r)->users, &def->id);
+			}
+		}
+	}
+}
+
+/// @}
+
+/**
+ * \brief Lift \p fcn into SSA form
+ *
+ * Every block of the function is lifted to IL once. Instructions without IL
+ * are skipped and `goto` effects are ignored.
+ */
+RZ_API RZ_OWN RzAnalysisILSSA *rz_analysis_il_ssa_new(RZ_NONNULL RzAnalysis *analysis, RZ_NONNULL RzAnalysisFunction *fcn) {
+	rz_return_val_if_fail(analysis && fcn, NULL);
+	if (!analysis->cur || !analysis->cur->il_config) {
+		return NULL;
+	}
+	RzAnalysisILSSA *ssa = RZ_NEW0(RzAnalysisILSSA);
+	if (!ssa) {
+		return NULL;
+	}
+	ssa->analysis = analysis;
+	ssa->fcn = fcn;
+	rz_pvector_init(&ssa->vars, (RzPVectorFree)var_free);
+	rz_vector_init(&ssa->blocks, sizeof(RzAnalysisILSSABlock), block_fini, NULL);
+	rz_pvector_init(&ssa->defs, (RzPVectorFree)def_free);
+	rz_pvector_init(&ssa->ops, (RzPVectorFree)rz_il_op_effect_free);
+	rz_vector_init(&ssa->consts, sizeof(Consts), NULL, NULL);
+	ssa->globals = ht_pu_new0();
+	ssa->locals = ht_pu_new0();
+	ssa->insns = ht_uu_new0();
+	if (!ssa->globals || !ssa->locals || !ssa->insns || !blocks_init(ssa)) {
+		goto err;
+	}
+
+	RzVector order, succs;
+	rz_vector_init(&order, sizeof(ut32), NULL, NULL);
+	rz_vector_init(&succs, sizeof(RzVector), succs_fini, NULL);
+	if (!blocks_order(ssa, &order, &succs)) {
+		rz_vector_fini(&order);
+		rz_vector_fini(&succs);
+		goto err;
+	}
+	ut32 *idx;
+	rz_vector_foreach(&order, idx) {
+		if (block_preds_filled(ssa, *idx)) {
+			block_seal(ssa, *idx);
+		}
+		if (!lift_block(ssa, *idx)) {
+			RZ_LOG_WARN("analysis: cannot read block at 0x%" PFMT64x " for SSA\n", block_at(ssa, *idx)->bb->addr);
+		}
+		// seal successors that were only waiting for this block
+		RzVector *bsuccs = rz_vector_index_ptr(&succs, *idx);
+		ut32 *succ;
+		rz_vector_foreach(bsuccs, succ) {
+			if (block_preds_filled(ssa, *succ)) {
+				block_seal(ssa, *succ);
+			}
+		}
+	}
+	rz_vector_foreach(&order, idx) {
+		block_seal(ssa, *idx);
+	}
+	rz_vector_fini(&order);
+	rz_vector_fini(&succs);
+	operands_resolve(ssa);
+	return ssa;
+
+err:
+	rz_analysis_il_ssa_free(ssa);
+	return NULL;
+}
+
+RZ_API void rz_analysis_il_ssa_free(RZ_NULLABLE RzAnalysisILSSA *ssa) {
+	if (!ssa) {
+		return;
+	}
+	rz_vector_fini(&ssa->consts);
+	rz_pvector_fini(&ssa->defs);
+	rz_vector_fini(&ssa->blocks);
+	rz_pvector_fini(&ssa->vars);
+	rz_pvector_fini(&ssa->ops);
+	ht_pu_free(ssa->globals);
+	ht_pu_free(ssa->locals);
+	ht_uu_free(ssa->insns);
+	free(ssa);
+}
+
+RZ_API RZ_BORROW RzAnalysisILSSADef *rz_analysis_il_ssa_get_def(RZ_NONNULL RzAnalysisILSSA *ssa, ut32 id) {
+	rz_return_val_if_fail(ssa, NULL);
+	id = def_resolve(ssa, id);
+	if (id >= rz_pvector_len(&ssa->defs)) {
+		return NULL;
+	}
+	return def_at(ssa, id);
+}
+
+/**
+ * \brief Get the definition of the global variable \p var live right before the instruction at \p addr
+ *
+ * Phis that were not needed during construction are created here on demand.
+ *
+ * \return the definition or NULL if the function never accesses \p var
+ */
+RZ_API RZ_BORROW RzAnalysisILSSADef *rz_analysis_il_ssa_reaching_def(RZ_NONNULL RzAnalysisILSSA *ssa, ut64 addr, RZ_NONNULL const char *var) {
+	rz_return_val_if_fail(ssa && var, NULL);
+	bool found = false;
+	ut32 block = ht_uu_find(ssa->insns, addr, &found);
+	if (!found) {
+		return NULL;
+	}
+	ut32 v = var_find(ssa, var, false);
+	if (v == UT32_MAX) {
+		return NULL;
+	}
+
+	RzAnalysisILSSABlock *b = block_at(ssa, block);
+	bool defined = false;
+	for (size_t i = rz_vector_len(&b->defs); i > 0; i--) {
+		RzAnalysisILSSADef *def = def_at(ssa, *(ut32 *)rz_vector_index_ptr(&b->defs, i - 1));
+		if (def->var != v) {
+			continue;
+		}
+		if (def->addr < addr) {
+			return def;
+		}
+		defined = true;
+	}
+	ut32 id;
+	if (defined) {
+		// the end of the block does not tell about its start
+		ut32 *phi;
+		rz_vector_foreach(&b->phis, phi) {
+			if (def_at(ssa, *phi)->var == v) {
+				return def_at(ssa, *phi);
+			}
+		}
+		// a trivial phi is removed again, so remember what it resolved to
+		// instead of creating a new one for every query
+		found = false;
+		id = b->in ? ht_uu_find(b->in, v, &found) : UT32_MAX;
+		if (!found) {
+			id = var_read_entry(ssa, block, v, false);
+			if (id != UT32_MAX && (b->in || (b->in = ht_uu_new0()))) {
+				ht_uu_insert(b->in, v, id);
+			}
+		}
+	} else {
+		id = var_read(ssa, block, v);
+	}
+	return rz_analysis_il_ssa_get_def(ssa, id);
+}
+
+/**
+ * \name Sparse constant propagation
+ * @{
+ */
+
+static inline ut64 bits_mask(ut32 bits) {
+	return bits >= 64 ? UT64_MAX : (1ULL << bits) - 1;
+}
+
+static inline st64 sign_extend(ut64 v, ut32 bits) {
+	if (!bits || bits >= 64) {
+		return (st64)v;
+	}
+	ut64 m = 1ULL << (bits - 1);
+	return (st64)((v ^ m) - m);
+}
+
+static Consts consts_bottom(void) {
+	Consts r = { .state = CONSTS_BOTTOM };
+	return r;
+}
+
+static Consts consts_top(void) {
+	Consts r = { .state = CONSTS_TOP };
+	return r;
+}
+
+static Consts consts_single(ut32 bits, ut64 v) {
+	Consts r = { .state = CONSTS_SET, .bits = bits, .count = 1 };
+	r.values[0] = v & bits_mask(bits);
+	return r;
+}
+
+static void consts_add(Consts *c, ut64 v) {
+	if (c->state == CONSTS_BOTTOM) {
+		return;
+	}
+	v &= bits_mask(c->bits);
+	for (ut32 i = 0; i < c->count; i++) {
+		if (c->values[i] == v) {
+			return;
+		}
+	}
+	if (c->count == SSA_MAX_CONSTS) {
+		*c = consts_bottom();
+		return;
+	}
+	c->values[c->count++] = v;
+}
+
+static Consts consts_join(const Consts *a, const Consts *b) {
+	if (a->state == CONSTS_TOP) {
+		return *b;
+	}
+	if (b->state == CONSTS_TOP) {
+		return *a;
+	}
+	if (a->state == CONSTS_BOTTOM || b->state == CONSTS_BOTTOM || a->bits != b->bits) {
+		return consts_bottom();
+	}
+	Consts r = *a;
+	for (ut32 i = 0; i < b->count; i++) {
+		consts_add(&r, b->values[i]);
+	}
+	return r;
+}
+
+static bool consts_eq(const Consts *a, const Consts *b) {
+	if (a->state != b->state) {
+		return false;
+	}
+	if (a->state != CONSTS_SET) {
+		return true;
+	}
+	return a->bits == b->bits && a->count == b->count && !memcmp(a->values, b->values, sizeof(ut64) * a->count);
+}
+
+static Consts *consts_of(RzAnalysisILSSA *ssa, ut32 id) {
+	while (rz_vector_len(&ssa->consts) <= id) {
+		Consts top = consts_top();
+		if (!rz_vector_push(&ssa->consts, &top)) {
+			return NULL;
+		}
+	}
+	return rz_vector_index_ptr(&ssa->consts, id);
+}
+
+typedef struct let_binding_t {
+	const char *name;
+	Consts value;
+	struct let_binding_t *next;
+} LetBinding;
+
+static Consts eval_pure(RzAnalysisILSSA *ssa, RzAnalysisILSSADef *def, RzILOpPure *op, LetBinding *env);
+
+static Consts eval_operand(RzAnalysisILSSA *ssa, RzAnalysisILSSADef *def, RzILOpPure *node) {
+	RzAnalysisILSSAOperand *o;
+	rz_vector_foreach(&def->operands, o) {
+		if (o->node == node) {
+			Consts *c = o->def != UT32_MAX ? consts_of(ssa, o->def) : NULL;
+			return c ? *c : consts_bottom();
+		}
+	}
+	return consts_bottom();
+}
+
+typedef enum {
+	EVAL_UN_INV,
+	EVAL_UN_MSB,
+	EVAL_UN_LSB,
+	EVAL_UN_IS_ZERO,
+	EVAL_UN_NEG,
+	EVAL_UN_LOGNOT,
+} EvalUnOp;
+
+static Consts eval_unop(EvalUnOp kind, const Consts *x) {
+	if (x->state != CONSTS_SET) {
+		return *x;
+	}
+	bool to_bool = kind == EVAL_UN_MSB || kind == EVAL_UN_LSB || kind == EVAL_UN_IS_ZERO;
+	Consts r = { .state = CONSTS_SET, .bits = to_bool ? 1 : x->bits };
+	for (ut32 i = 0; i < x->count; i++) {
+		ut64 v = x->values[i];
+		switch (kind) {
+		case EVAL_UN_INV:
+		case EVAL_UN_LOGNOT:
+			v = ~v;
+			break;
+		case EVAL_UN_MSB:
+			v = x->bits ? (v >> (x->bits - 1)) & 1 : 0;
+			break;
+		case EVAL_UN_LSB:
+			v &= 1;
+			break;
+		case EVAL_UN_IS_ZERO:
+			v = !v;
+			break;
+		case EVAL_UN_NEG:
+			v = -v;
+			break;
+		}
+		consts_add(&r, v);
+	}
+	return r;
+}
+
+static bool eval_binop_one(RzILOpPureCode code, ut32 bits, ut64 x, ut64 y, ut64 *out) {
+	switch (code) {
+	case RZ_IL_OP_AND:
+	case RZ_IL_OP_LOGAND:
+		*out = x & y;
+		return true;
+	case RZ_IL_OP_OR:
+	case RZ_IL_OP_LOGOR:
+		*out = x | y;
+		return true;
+	case RZ_IL_OP_XOR:
+	case RZ_IL_OP_LOGXOR:
+		*out = x ^ y;
+		return true;
+	case RZ_IL_OP_ADD:
+		*out = x + y;
+		return true;
+	case RZ_IL_OP_SUB:
+		*out = x - y;
+		return true;
+	case RZ_IL_OP_MUL:
+		*out = x * y;
+		return true;
+	case RZ_IL_OP_DIV:
+		if (!y) {
+			return false;
+		}
+		*out = x / y;
+		return true;
+	case RZ_IL_OP_MOD:
+		if (!y) {
+			return false;
+		}
+		*out = x % y;
+		return true;
+	case RZ_IL_OP_SDIV:
+	case RZ_IL_OP_SMOD: {
+		st64 sx = sign_extend(x, bits);
+		st64 sy = sign_extend(y, bits);
+		if (!sy || (sy == -1 && sx == INT64_MIN)) {
+			return false;
+		}
+		*out = code == RZ_IL_OP_SDIV ? (ut64)(sx / sy) : (ut64)(sx % sy);
+		return true;
+	}
+	case RZ_IL_OP_EQ:
+		*out = x == y;
+		return true;
+	case RZ_IL_OP_ULE:
+		*out = x <= y;
+		return true;
+	case RZ_IL_OP_SLE:
+		*out = sign_extend(x, bits) <= sign_extend(y, bits);
+		return true;
+	default:
+		return false;
+	}
+}
+
+static Consts eval_binop(RzILOpPureCode code, const Consts *x, const Consts *y) {
+	if (x->state == CONSTS_BOTTOM || y->state == CONSTS_BOTTOM) {
+		return consts_bottom();
+	}
+	if (x->state == CONSTS_TOP || y->state == CONSTS_TOP) {
+		return consts_top();
+	}
+	bool to_bool = code == RZ_IL_OP_EQ || code == RZ_IL_OP_ULE || code == RZ_IL_OP_SLE;
+	Consts r = { .state = CONSTS_SET, .bits = to_bool ? 1 : x->bits };
+	for (ut32 i = 0; i < x->count; i++) {
+		for (ut32 j = 0; j < y->count; j++) {
+			ut64 v;
+			if (!eval_binop_one(code, x->bits, x->values[i], y->values[j], &v)) {
+				return consts_bottom();
+			}
+			consts_add(&r, v);
+			if (r.state == CONSTS_BOTTOM) {
+				return r;
+			}
+		}
+	}
+	return r;
+}
+
+static Consts eval_shift(bool left, const Consts *fill, const Consts *x, const Consts *y) {
+	if (fill->state == CONSTS_BOTTOM || x->state == CONSTS_BOTTOM || y->state == CONSTS_BOTTOM) {
+		return consts_bottom();
+	}
+	if (fill->state == CONSTS_TOP || x->state == CONSTS_TOP || y->state == CONSTS_TOP) {
+		return consts_top();
+	}
+	Consts r = { .state = CONSTS_SET, .bits = x->bits };
+	ut64 mask = bits_mask(x->bits);
+	for (ut32 f = 0; f < fill->count; f++) {
+		ut64 ones = fill->values[f] ? mask : 0;
+		for (ut32 i = 0; i < x->count; i++) {
+			for (ut32 j = 0; j < y->count; j++) {
+				ut64 v = x->values[i];
+				ut64 s = y->values[j];
+				if (s >= x->bits) {
+					v = ones;
+				} else if (left) {
+					v = (v << s) | (ones & bits_mask(s));
+				} else {
+					v = (v >> s) | (ones & ~(mask >> s));
+				}
+				consts_add(&r, v);
+				if (r.state == CONSTS_BOTTOM) {
+					return r;
+				}
+			}
+		}
+	}
+	return r;
+}
+
+static Consts eval_pure(RzAnalysisILSSA *ssa, RzAnalysisILSSADef *def, RzILOpPure *op, LetBinding *env) {
+	if (!op) {
+		return consts_bottom();
+	}
+	switch (op->code) {
+	case RZ_IL_OP_B0:
+		return consts_single(1, 0);
+	case RZ_IL_OP_B1:
+		return consts_single(1, 1);
+	case RZ_IL_OP_BITV: {
+		ut32 bits = rz_bv_len(op->op.bitv.value);
+		if (bits > 64) {
+			return consts_bottom();
+		}
+		return consts_single(bits, rz_bv_to_ut64(op->op.bitv.value));
+	}
+	case RZ_IL_OP_VAR:
+		if (op->op.var.kind == RZ_IL_VAR_KIND_LOCAL_PURE) {
+			for (LetBinding *b = env; b; b = b->next) {
+				if (!strcmp(b->name, op->op.var.v)) {
+					return b->value;
+				}
+			}
+			return consts_bottom();
+		}
+		return eval_operand(ssa, def, op);
+	case RZ_IL_OP_LET: {
+		LetBinding b = { .name = op->op.let.name, .next = env };
+		b.value = eval_pure(ssa, def, op->op.let.exp, env);
+		return eval_pure(ssa, def, op->op.let.body, &b);
+	}
+	case RZ_IL_OP_ITE: {
+		Consts c = eval_pure(ssa, def, op->op.ite.condition, env);
+		if (c.state == CONSTS_TOP) {
+			return c;
+		}
+		if (c.state == CONSTS_SET && c.count == 1) {
+			return eval_pure(ssa, def, c.values[0] ? op->op.ite.x : op->op.ite.y, env);
+		}
+		Consts x = eval_pure(ssa, def, op->op.ite.x, env);
+		Consts y = eval_pure(ssa, def, op->op.ite.y, env);
+		return consts_join(&x, &y);
+	}
+	case RZ_IL_OP_INV: {
+		Consts x = eval_pure(ssa, def, op->op.boolinv.x, env);
+		return eval_unop(EVAL_UN_INV, &x);
+	}
+	case RZ_IL_OP_MSB:
+	case RZ_IL_OP_LSB:
+	case RZ_IL_OP_IS_ZERO: {
+		Consts x = eval_pure(ssa, def, op->op.msb.bv, env);
+		return eval_unop(op->code == RZ_IL_OP_MSB ? EVAL_UN_MSB : op->code == RZ_IL_OP_LSB ? EVAL_UN_LSB
+												    : EVAL_UN_IS_ZERO,
+			&x);
+	}
+	case RZ_IL_OP_NEG:
+	case RZ_IL_OP_LOGNOT: {
+		Consts x = eval_pure(ssa, def, op->op.neg.bv, env);
+		return eval_unop(op->code == RZ_IL_OP_NEG ? EVAL_UN_NEG : EVAL_UN_LOGNOT, &x);
+	}
+	case RZ_IL_OP_AND:
+	case RZ_IL_OP_OR:
+	case RZ_IL_OP_XOR: {
+		Consts x = eval_pure(ssa, def, op->op.booland.x, env);
+		Consts y = eval_pure(ssa, def, op->op.booland.y, env);
+		return eval_binop(op->code, &x, &y);
+	}
+	case RZ_IL_OP_ADD:
+	case RZ_IL_OP_SUB:
+	case RZ_IL_OP_MUL:
+	case RZ_IL_OP_DIV:
+	case RZ_IL_OP_SDIV:
+	case RZ_IL_OP_MOD:
+	case RZ_IL_OP_SMOD:
+	case RZ_IL_OP_LOGAND:
+	case RZ_IL_OP_LOGOR:
+	case RZ_IL_OP_LOGXOR: {
+		Consts x = eval_pure(ssa, def, op->op.add.x, env);
+		Consts y = eval_pure(ssa, def, op->op.add.y, env);
+		return eval_binop(op->code, &x, &y);
+	}
+	case RZ_IL_OP_EQ:
+	case RZ_IL_OP_SLE:
+	case RZ_IL_OP_ULE: {
+		Consts x = eval_pure(ssa, def, op->op.eq.x, env);
+		Consts y = eval_pure(ssa, def, op->op.eq.y, env);
+		return eval_binop(op->code, &x, &y);
+	}
+	case RZ_IL_OP_SHIFTL:
+	case RZ_IL_OP_SHIFTR: {
+		Consts fill = eval_pure(ssa, def, op->op.shiftl.fill_bit, env);
+		Consts x = eval_pure(ssa, def, op->op.shiftl.x, env);
+		Consts y = eval_pure(ssa, def, op->op.shiftl.y, env);
+		return eval_shift(op->code == RZ_IL_OP_SHIFTL, &fill, &x, &y);
+	}
+	case RZ_IL_OP_CAST: {
+		ut32 length = op->op.cast.length;
+		if (!length || length > 64) {
+			return consts_bottom();
+		}
+		Consts fill = eval_pure(ssa, def, op->op.cast.fill, env);
+		Consts x = eval_pure(ssa, def, op->op.cast.val, env);
+		if (fill.state == CONSTS_BOTTOM || x.state == CONSTS_BOTTOM) {
+			return consts_bottom();
+		}
+		if (fill.state == CONSTS_TOP || x.state == CONSTS_TOP) {
+			return consts_top();
+		}
+		Consts r = { .state = CONSTS_SET, .bits = length };
+		ut64 ext = bits_mask(length) & ~bits_mask(x.bits);
+		for (ut32 f = 0; f < fill.count; f++) {
+			for (ut32 i = 0; i < x.count; i++) {
+				consts_add(&r, x.values[i] | (fill.values[f] ? ext : 0));
+			}
+		}
+		return r;
+	}
+	case RZ_IL_OP_APPEND: {
+		Consts h = eval_pure(ssa, def, op->op.append.high, env);
+		Consts lo = eval_pure(ssa, def, op->op.append.low, env);
+		if (h.state == CONSTS_BOTTOM || lo.state == CONSTS_BOTTOM || h.bits + lo.bits > 64) {
+			return consts_bottom();
+		}
+		if (h.state == CONSTS_TOP || lo.state == CONSTS_TOP) {
+			return consts_top();
+		}
+		Consts r = { .state = CONSTS_SET, .bits = h.bits + lo.bits };
+		for (ut32 i = 0; i < h.count; i++) {
+			for (ut32 j = 0; j < lo.count; j++) {
+				consts_add(&r, (lo.bits < 64 ? h.values[i] << lo.bits : 0) | lo.values[j]);
+			}
+		}
+		return r;
+	}
+	default:
+		// memory and floats are not tracked
+		return consts_bottom();
+	}
+}
+
+static Consts transfer(RzAnalysisILSSA *ssa, RzAnalysisILSSADef *def) {
+	switch (def->kind) {
+	case RZ_ANALYSIS_IL_SSA_DEF_SET:
+	case RZ_ANALYSIS_IL_SSA_DEF_JMP:
+		return eval_pure(ssa, def, def->value, NULL);
+	case RZ_ANALYSIS_IL_SSA_DEF_PHI: {
+		Consts r = consts_top();
+		RzAnalysisILSSAOperand *op;
+		rz_vector_foreach(&def->operands, op) {
+			Consts *c = op->def != UT32_MAX ? consts_of(ssa, op->def) : NULL;
+			Consts b = consts_bottom();
+			r = consts_join(&r, c ? c : &b);
+		}
+		return r;
+	}
+	case RZ_ANALYSIS_IL_SSA_DEF_ITE: {
+		if (rz_vector_len(&def->operands) < 2) {
+			return consts_bottom();
+		}
+		Consts arms[2];
+		for (size_t i = 0; i < 2; i++) {
+			RzAnalysisILSSAOperand *op = rz_vector_index_ptr(&def->operands, i);
+			Consts *c = op->def != UT32_MAX ? consts_of(ssa, op->def) : NULL;
+			arms[i] = c ? *c : consts_bottom();
+		}
+		Consts cond = eval_pure(ssa, def, def->value, NULL);
+		if (cond.state == CONSTS_SET && cond.count == 1) {
+			return arms[cond.values[0] ? 0 : 1];
+		}
+		if (cond.state == CONSTS_TOP) {
+			return cond;
+		}
+		return consts_join(&arms[0], &arms[1]);
+	}
+	default:
+		return consts_bottom();
+	}
+}
+
+/**
+ * Solve the backward slice of \p root, reusing what earlier queries solved
+ */
+static bool solve(RzAnalysisILSSA *ssa, ut32 root) {
+	Consts *rc = consts_of(ssa, root);
+	if (!rc) {
+		return false;
+	}
+	if (rc->final) {
+		return true;
+	}
+	size_t n = rz_pvector_len(&ssa->defs);
+	if (!consts_of(ssa, n - 1)) {
+		return false;
+	}
+	SetU *in_slice = set_u_new();
+	if (!in_slice) {
+		return false;
+	}
+	RzVector slice, work;
+	rz_vector_init(&slice, sizeof(ut32), NULL, NULL);
+	rz_vector_init(&work, sizeof(ut32), NULL, NULL);
+
+	rz_vector_push(&work, &root);
+	set_u_add(in_slice, root);
+	while (!rz_vector_empty(&work)) {
+		ut32 id;
+		rz_vector_pop(&work, &id);
+		rz_vector_push(&slice, &id);
+		RzAnalysisILSSAOperand *op;
+		rz_vector_foreach(&def_at(ssa, id)->operands, op) {
+			if (op->def == UT32_MAX || set_u_contains(in_slice, op->def) || consts_of(ssa, op->def)->final) {
+				continue;
+			}
+			set_u_add(in_slice, op->def);
+			rz_vector_push(&work, &op->def);
+		}
+	}
+
+	// operands first, so most definitions are final after one visit
+	for (size_t i = rz_vector_len(&slice); i > 0; i--) {
+		rz_vector_push(&work, rz_vector_index_ptr(&slice, i - 1));
+	}
+	while (!rz_vector_empty(&work)) {
+		ut32 id;
+		rz_vector_pop(&work, &id);
+		RzAnalysisILSSADef *def = def_at(ssa, id);
+		Consts *cur = consts_of(ssa, id);
+		Consts val = transfer(ssa, def);
+		val = consts_join(cur, &val);
+		if (consts_eq(cur, &val)) {
+			continue;
+		}
+		*cur = val;
+		ut32 *user;
+		rz_vector_foreach(&def->users, user) {
+			if (set_u_contains(in_slice, *user)) {
+				rz_vector_push(&work, user);
+			}
+		}
+	}
+
+	ut32 *id;
+	rz_vector_foreach(&slice, id) {
+		Consts *c = consts_of(ssa, *id);
+		if (c->state == CONSTS_TOP) {
+			// only reachable through itself
+			*c = consts_bottom();
+		}
+		c->final = true;
+	}
+	rz_vector_fini(&slice);
+	rz_vector_fini(&work);
+	set_u_free(in_slice);
+	return true;
+}
+
+/// @}
+
+/**
+ * \brief Get the constants \p def can take
+ * \return the possible values or NULL if they are unknown or too many
+ */
+RZ_API RZ_OWN RzVector /*<ut64>*/ *rz_analysis_il_ssa_def_constants(RZ_NONNULL RzAnalysisILSSA *ssa, RZ_NONNULL RzAnalysisILSSADef *def) {
+	rz_return_val_if_fail(ssa && def, NULL);
+	ut32 id = def_resolve(ssa, def->id);
+	if (id == UT32_MAX || !solve(ssa, id)) {
+		return NULL;
+	}
+	Consts *c = consts_of(ssa, id);
+	if (c->state != CONSTS_SET) {
+		return NULL;
+	}
+	RzVector *ret = rz_vector_new(sizeof(ut64), NULL, NULL);
+	if (!ret) {
+		return NULL;
+	}
+	for (ut32 i = 0; i < c->count; i++) {
+		rz_vector_push(ret, &c->values[i]);
+	}
+	return ret;
+}
+
+/**
+ * \brief Get the constants that can reach the global variable \p var right before the instruction at \p addr
+ * \return the possible values or NULL if they are unknown or too many
+ */
+RZ_API RZ_OWN RzVector /*<ut64>*/ *rz_analysis_il_ssa_constants_at(RZ_NONNULL RzAnalysisILSSA *ssa, ut64 addr, RZ_NONNULL const char *var) {
+	rz_return_val_if_fail(ssa && var, NULL);
+	RzAnalysisILSSADef *def = rz_analysis_il_ssa_reaching_def(ssa, addr, var);
+	return def ? rz_analysis_il_ssa_def_constants(ssa, def) : NULL;
+}
+
+/**
+ * \brief Get the constant targets of the jumps of the instruction at \p addr
+ * \return the possible targets or NULL if there is no jump or its targets are unknown
+ */
+RZ_API RZ_OWN RzVector /*<ut64>*/ *rz_analysis_il_ssa_jump_targets(RZ_NONNULL RzAnalysisILSSA *ssa, ut64 addr) {
+	rz_return_val_if_fail(ssa, NULL);
+	bool found = false;
+	ut32 block = ht_uu_find(ssa->insns, addr, &found);
+	if (!found) {
+		return NULL;
+	}
+	RzVector *ret = NULL;
+	ut32 *id;
+	rz_vector_foreach(&block_at(ssa, block)->defs, id) {
+		RzAnalysisILSSADef *def = def_at(ssa, *id);
+		if (def->addr != addr || def->kind != RZ_ANALYSIS_IL_SSA_DEF_JMP) {
+			continue;
+		}
+		RzVector *targets = rz_analysis_il_ssa_def_constants(ssa, def);
+		if (!targets) {
+			rz_vector_free(ret);
+			return NULL;
+		}
+		if (!ret) {
+			ret = targets;
+			continue;
+		}
+		ut64 *t;
+		rz_vector_foreach(targets, t) {
+			rz_vector_push(ret, t);
+		}
+		rz_vector_free(targets);
+	}
+	return ret;
+}
+
+static void def_name(RzAnalysisILSSA *ssa, ut32 id, RzStrBuf *sb) {
+	if (id == UT32_MAX) {
+		rz_strbuf_append(sb, "undefined");
+		return;
+	}
+	RzAnalysisILSSADef *def = def_at(ssa, id);
+	if (def->var == UT32_MAX) {
+		rz_strbuf_appendf(sb, "jmp.%" PFMT32u, def->id);
+		return;
+	}
+	RzAnalysisILSSAVar *var = rz_pvector_at(&ssa->vars, def->var);
+	rz_strbuf_appendf(sb, "%s.%" PFMT32u, var->name, def->version);
+}
+
+/**
+ * \brief Print \p def as `name.version = kind(operands)`
+ */
+RZ_API RZ_OWN char *rz_analysis_il_ssa_def_as_string(RZ_NONNULL RzAnalysisILSSA *ssa, RZ_NONNULL RzAnalysisILSSADef *def) {
+	rz_return_val_if_fail(ssa && def, NULL);
+	static const char *kinds[] = {
+		[RZ_ANALYSIS_IL_SSA_DEF_ENTRY] = "entry",
+		[RZ_ANALYSIS_IL_SSA_DEF_PHI] = "phi",
+		[RZ_ANALYSIS_IL_SSA_DEF_SET] = "set",
+		[RZ_ANALYSIS_IL_SSA_DEF_ITE] = "ite",
+		[RZ_ANALYSIS_IL_SSA_DEF_CLOBBER] = "clobber",
+		[RZ_ANALYSIS_IL_SSA_DEF_STORE] = "store",
+		[RZ_ANALYSIS_IL_SSA_DEF_JMP] = "jmp",
+		[RZ_ANALYSIS_IL_SSA_DEF_DEAD] = "dead",
+	};
+	RzStrBuf sb;
+	rz_strbuf_init(&sb);
+	def_name(ssa, def->id, &sb);
+	rz_strbuf_appendf(&sb, " = %s(", kinds[def->kind]);
+	RzAnalysisILSSAOperand *op;
+	bool first = true;
+	rz_vector_foreach(&def->operands, op) {
+		if (!first) {
+			rz_strbuf_append(&sb, ", ");
+		}
+		first = false;
+		def_name(ssa, op->def, &sb);
+	}
+	rz_strbuf_append(&sb, ")");
+	if (def->value) {
+		rz_strbuf_append(&sb, " ");
+		rz_il_op_pure_stringify(def->value, &sb, false);
+	}
+	return rz_strbuf_drain_nofree(&sb);
+}
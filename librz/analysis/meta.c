@@ -251,7 +251,23 @@ RZ_API const char *rz_meta_type_to_string(int type) {
 }
 
 RZ_API void rz_meta_rebase(RzAnalysis *analysis, ut64 diff) {
-	if (!diff) {
+	if (!diff || !analysis->meta.root) {
+		return;
+	}
+	RBIter first = rz_rbtree_first(&analysis->meta.root->node);
+	ut64 lo = rz_rbtree_iter_get(&first, RzIntervalNode, node)->start;
+	ut64 hi = analysis->meta.root->max_end;
+	if (lo + diff <= hi + diff) {
+		// no interval wraps around, so shifting every node keeps the tree
+		// ordered and the maximum ends of the subtrees valid
+		RzIntervalTreeIter it;
+		RzAnalysisMetaItem *item;
+		rz_interval_tree_foreach (&analysis->meta, it, item) {
+			RzIntervalNode *node = rz_interval_tree_iter_get(&it);
+			node->start += diff;
+			node->end += diff;
+			node->max_end += diff;
+		}
 		return;
 	}
 	RzIntervalTree old = analysis->meta;
@@ -132,10 +132,9 @@ RZ_API int rz_analysis_op(RzAnalysis *analysis, RzAnalysisOp *op, ut64 addr, con
 		RZ_LOG_DEBUG("Warning: unhandled RZ_ANALYSIS_OP_MASK_DISASM in rz_analysis_op\n");
 	}
 	if (mask & RZ_ANALYSIS_OP_MASK_HINT) {
-		RzAnalysisHint *hint = rz_analysis_hint_get(analysis, addr);
+		const RzAnalysisHint *hint = rz_analysis_hint_view_at(analysis, addr);
 		if (hint) {
 			rz_analysis_op_hint(op, hint);
-			rz_analysis_hint_free(hint);
 		}
 	}
 	return ret;
@@ -620,7 +619,7 @@ RZ_API int rz_analysis_op_family_from_string(RZ_NONNULL const char *name) {
 }
 
 /* apply hint to op, return the number of hints applied */
-RZ_API int rz_analysis_op_hint(RzAnalysisOp *op, RzAnalysisHint *hint) {
+RZ_API int rz_analysis_op_hint(RzAnalysisOp *op, const RzAnalysisHint *hint) {
 	int changes = 0;
 	if (hint) {
 		if (hint->val != UT64_MAX) {
@@ -1803,9 +1803,16 @@ static int analysis_op(RzAnalysis *a, RzAnalysisOp *op, ut64 addr, const ut8 *bu
 		}
 	}
 
-	if (mode != ctx->omode || a->bits != ctx->obits) {
+	if (ctx->handle && (a->bits == 64) != (ctx->obits == 64)) {
+		// a different architecture needs a new handle
 		cs_close(&ctx->handle);
-		ctx->handle = 0; // unnecessary
+		ctx->handle = 0;
+	} else if (ctx->handle && mode != ctx->omode) {
+		// switching between ARM and Thumb is only an option of the same handle
+		if (cs_option(ctx->handle, CS_OPT_MODE, mode) != CS_ERR_OK) {
+			cs_close(&ctx->handle);
+			ctx->handle = 0;
+		}
 		ctx->omode = mode;
 		ctx->obits = a->bits;
 	}
@@ -1821,6 +1828,8 @@ static int analysis_op(RzAnalysis *a, RzAnalysisOp *op, ut64 addr, const ut8 *bu
 			ctx->handle = 0;
 			return -1;
 		}
+		ctx->omode = mode;
+		ctx->obits = a->bits;
 	}
 	int haa = hackyArmAnal(a, op, buf, len); // TODO: disable this for capstone 5 after testing that everything works
 	if (haa > 0) {
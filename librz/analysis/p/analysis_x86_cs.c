@@ -3136,7 +3136,8 @@ static int analyze_op(RzAnalysis *a, RzAnalysisOp *op, ut64 addr, const ut8 *buf
 	int n, ret;
 
 	if (ctx->handle && mode != ctx->omode) {
-		if (ctx->handle != 0) {
+		// switching between 16, 32 and 64 bits is only an option of the same handle
+		if (cs_option(ctx->handle, CS_OPT_MODE, mode) != CS_ERR_OK) {
 			cs_close(&ctx->handle);
 			ctx->handle = 0;
 		}
@@ -8,10 +8,14 @@
 RZ_API char *rz_analysis_rtti_demangle_class_name(RzAnalysis *analysis, const char *name) {
 	RVTableContext context;
 	rz_analysis_vtable_begin(analysis, &context);
+	char *ret;
 	if (context.abi == RZ_ANALYSIS_CPP_ABI_MSVC) {
-		return rz_analysis_rtti_msvc_demangle_class_name(&context, name);
+		ret = rz_analysis_rtti_msvc_demangle_class_name(&context, name);
+	} else {
+		ret = rz_analysis_rtti_itanium_demangle_class_name(&context, name);
 	}
-	return rz_analysis_rtti_itanium_demangle_class_name(&context, name);
+	rz_analysis_vtable_end(&context);
+	return ret;
 }
 
 RZ_API void rz_analysis_rtti_print_at_vtable(RzAnalysis *analysis, ut64 addr, RzOutputMode mode) {
@@ -27,6 +31,7 @@ RZ_API void rz_analysis_rtti_print_at_vtable(RzAnalysis *analysis, ut64 addr, Rz
 	} else {
 		rz_analysis_rtti_itanium_print_at_vtable(&context, addr, mode);
 	}
+	rz_analysis_vtable_end(&context);
 
 	if (use_json) {
 		rz_cons_print("]\n");
@@ -76,6 +81,7 @@ RZ_API void rz_analysis_rtti_print_all(RzAnalysis *analysis, RzOutputMode mode)
 		}
 	}
 	rz_list_free(vtables);
+	rz_analysis_vtable_end(&context);
 
 	if (use_json) {
 		rz_cons_print("]\n");
@@ -98,5 +104,6 @@ RZ_API void rz_analysis_rtti_recover_all(RzAnalysis *analysis) {
 		}
 	}
 	rz_list_free(vtables);
+	rz_analysis_vtable_end(&context);
 	rz_cons_break_pop();
 }
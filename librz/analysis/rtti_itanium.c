@@ -74,7 +74,7 @@ typedef struct vmi_class_type_info_t {
 
 static bool rtti_itanium_read_type_name(RVTableContext *context, ut64 addr, class_type_info *cti) {
 	ut64 at;
-	if (!context->read_addr(context->analysis, addr, &at)) {
+	if (!rz_analysis_vtable_read_addr(context, addr, &at)) {
 		return false;
 	}
 	ut64 unique_mask = 1ULL << (VT_WORD_SIZE(context) * 8 - 1);
@@ -82,7 +82,7 @@ static bool rtti_itanium_read_type_name(RVTableContext *context, ut64 addr, clas
 	at &= ~unique_mask;
 	cti->name_addr = at;
 	ut8 buf[NAME_BUF_SIZE];
-	if (!context->analysis->iob.read_at(context->analysis->iob.io, at, buf, sizeof(buf))) {
+	if (!rz_analysis_vtable_read_at(context, at, buf, sizeof(buf))) {
 		return false;
 	}
 	buf[NAME_BUF_SIZE - 1] = 0;
@@ -96,7 +96,7 @@ static bool rtti_itanium_read_type_name(RVTableContext *context, ut64 addr, clas
 // Custom for the prototype now
 static char *rtti_itanium_read_type_name_custom(RVTableContext *context, ut64 addr, ut64 *str_addr, bool *unique_name) {
 	ut64 at;
-	if (!context->read_addr(context->analysis, addr, &at)) {
+	if (!rz_analysis_vtable_read_addr(context, addr, &at)) {
 		return NULL;
 	}
 	ut64 unique_mask = 1ULL << (VT_WORD_SIZE(context) * 8 - 1);
@@ -104,7 +104,7 @@ static char *rtti_itanium_read_type_name_custom(RVTableContext *context, ut64 ad
 	at &= ~unique_mask;
 	*str_addr = at;
 	ut8 buf[NAME_BUF_SIZE];
-	if (!context->analysis->iob.read_at(context->analysis->iob.io, at, buf, sizeof(buf))) {
+	if (!rz_analysis_vtable_read_at(context, at, buf, sizeof(buf))) {
 		return NULL;
 	}
 	buf[NAME_BUF_SIZE - 1] = 0;
@@ -134,7 +134,7 @@ static bool rtti_itanium_class_type_info_init(RVTableContext *context, ut64 addr
 	if (addr == UT64_MAX) {
 		return false;
 	}
-	if (!context->read_addr(context->analysis, addr, &at)) {
+	if (!rz_analysis_vtable_read_addr(context, addr, &at)) {
 		return false;
 	}
 	cti->vtable_addr = at;
@@ -180,7 +180,7 @@ static bool rtti_itanium_vmi_class_type_info_init(RVTableContext *context, ut64
 	if (addr == UT64_MAX) {
 		return false;
 	}
-	if (!context->read_addr(context->analysis, addr, &at)) {
+	if (!rz_analysis_vtable_read_addr(context, addr, &at)) {
 		return false;
 	}
 	vmi_cti->vtable_addr = at;
@@ -189,12 +189,12 @@ static bool rtti_itanium_vmi_class_type_info_init(RVTableContext *context, ut64
 		return false;
 	}
 	addr += VT_WORD_SIZE(context);
-	if (!context->read_addr(context->analysis, addr, &at)) {
+	if (!rz_analysis_vtable_read_addr(context, addr, &at)) {
 		return false;
 	}
 	vmi_cti->vmi_flags = at & 0xffffffff;
 	addr += 0x4;
-	if (!context->read_addr(context->analysis, addr, &at)) {
+	if (!rz_analysis_vtable_read_addr(context, addr, &at)) {
 		return false;
 	}
 	at = at & 0xffffffff;
@@ -211,12 +211,12 @@ static bool rtti_itanium_vmi_class_type_info_init(RVTableContext *context, ut64
 
 	int i;
 	for (i = 0; i < vmi_cti->vmi_base_count; i++) {
-		if (!context->read_addr(context->analysis, tmp_addr, &at)) {
+		if (!rz_analysis_vtable_read_addr(context, tmp_addr, &at)) {
 			return false;
 		}
 		vmi_cti->vmi_bases[i].base_class_addr = at;
 		tmp_addr += VT_WORD_SIZE(context);
-		if (!context->read_addr(context->analysis, tmp_addr, &at)) {
+		if (!rz_analysis_vtable_read_addr(context, tmp_addr, &at)) {
 			return false;
 		}
 		vmi_cti->vmi_bases[i].flags = at;
@@ -263,14 +263,14 @@ static bool rtti_itanium_si_class_type_info_init(RVTableContext *context, ut64 a
 	if (addr == UT64_MAX) {
 		return false;
 	}
-	if (!context->read_addr(context->analysis, addr, &at)) {
+	if (!rz_analysis_vtable_read_addr(context, addr, &at)) {
 		return false;
 	}
 	si_cti->vtable_addr = at;
 	if (!rtti_itanium_read_type_name(context, addr + VT_WORD_SIZE(context), (class_type_info *)si_cti)) {
 		return false;
 	}
-	if (!context->read_addr(context->analysis, addr + 2 * VT_WORD_SIZE(context), &at)) {
+	if (!rz_analysis_vtable_read_addr(context, addr + 2 * VT_WORD_SIZE(context), &at)) {
 		return false;
 	}
 	si_cti->base_class_addr = at;
@@ -561,10 +561,10 @@ static class_type_info *raw_rtti_parse(RVTableContext *context, ut64 vtable_addr
 		*/
 	ut64 rtti_vptr = 0;
 	ut64 addr = rtti_addr;
-	if (!context->read_addr(context->analysis, addr, &rtti_vptr)) {
+	if (!rz_analysis_vtable_read_addr(context, addr, &rtti_vptr)) {
 		return NULL;
 	}
-	RzBinSection *rtti_section = context->analysis->binb.get_vsect_at(context->analysis->binb.bin, rtti_vptr);
+	RzBinSection *rtti_section = rz_analysis_vtable_section_at(context, rtti_vptr);
 	if (rtti_vptr && !can_section_contain_rtti_vpointer(rtti_section)) {
 		;
 		;
@@ -584,11 +584,11 @@ static class_type_info *raw_rtti_parse(RVTableContext *context, ut64 vtable_addr
 	// Right now we already have atleast __class_type_info;
 
 	ut64 base_type_rtti = 0;
-	if (!context->read_addr(context->analysis, addr, &base_type_rtti)) {
+	if (!rz_analysis_vtable_read_addr(context, addr, &base_type_rtti)) {
 		return create_class_type(rtti_vptr, type_name, name_addr, name_unique, rtti_addr, vtable_addr);
 	}
 
-	RzBinSection *base_type_rtti_section = context->analysis->binb.get_vsect_at(context->analysis->binb.bin, base_type_rtti);
+	RzBinSection *base_type_rtti_section = rz_analysis_vtable_section_at(context, base_type_rtti);
 	if (can_section_contain_rtti_vpointer(base_type_rtti_section)) {
 		return (class_type_info *)create_si_class_type(rtti_vptr, type_name, name_addr, name_unique, base_type_rtti, rtti_addr, vtable_addr);
 	}
@@ -596,12 +596,12 @@ static class_type_info *raw_rtti_parse(RVTableContext *context, ut64 vtable_addr
 	// if it's not a valid base_type_rtti ptr, it might be flags for VMI
 	// assume uint are 32bit
 	ut64 integers = 0;
-	if (!context->read_addr(context->analysis, addr, &integers)) {
+	if (!rz_analysis_vtable_read_addr(context, addr, &integers)) {
 		return create_class_type(rtti_vptr, type_name, name_addr, name_unique, rtti_addr, vtable_addr);
 	}
 	ut32 vmi_flags = integers & 0xffffffff;
 	addr += 0x4;
-	if (!context->read_addr(context->analysis, addr, &integers)) {
+	if (!rz_analysis_vtable_read_addr(context, addr, &integers)) {
 		return create_class_type(rtti_vptr, type_name, name_addr, name_unique, rtti_addr, vtable_addr);
 	}
 	integers = integers & 0xffffffff;
@@ -618,13 +618,13 @@ static class_type_info *raw_rtti_parse(RVTableContext *context, ut64 vtable_addr
 
 	int i;
 	for (i = 0; i < vmi_base_count; i++) {
-		if (!context->read_addr(context->analysis, tmp_addr, &integers)) {
+		if (!rz_analysis_vtable_read_addr(context, tmp_addr, &integers)) {
 			free(vmi_bases);
 			return create_class_type(rtti_vptr, type_name, name_addr, name_unique, rtti_addr, vtable_addr);
 		}
 		vmi_bases[i].base_class_addr = integers;
 		tmp_addr += VT_WORD_SIZE(context);
-		if (!context->read_addr(context->analysis, tmp_addr, &integers)) {
+		if (!rz_analysis_vtable_read_addr(context, tmp_addr, &integers)) {
 			free(vmi_bases);
 			return create_class_type(rtti_vptr, type_name, name_addr, name_unique, rtti_addr, vtable_addr);
 		}
@@ -645,7 +645,7 @@ static class_type_info *rtti_itanium_type_info_new(RVTableContext *context, ut64
 	ut64 rtti_ptr = vtable_addr - VT_WORD_SIZE(context); // RTTI pointer
 	ut64 rtti_addr; // RTTI address
 
-	if (!context->read_addr(context->analysis, rtti_ptr, &rtti_addr)) {
+	if (!rz_analysis_vtable_read_addr(context, rtti_ptr, &rtti_addr)) {
 		return NULL;
 	}
 
@@ -654,7 +654,7 @@ static class_type_info *rtti_itanium_type_info_new(RVTableContext *context, ut64
 	// try to find the flag in it's vtable
 	if (type == RZ_TYPEINFO_TYPE_UNKNOWN) {
 		ut64 follow;
-		if (!context->read_addr(context->analysis, rtti_addr, &follow)) {
+		if (!rz_analysis_vtable_read_addr(context, rtti_addr, &follow)) {
 			return NULL;
 		}
 		follow -= 2 * context->word_size;
@@ -67,7 +67,7 @@ static bool rtti_msvc_read_complete_object_locator(RVTableContext *context, ut64
 		return false;
 	}
 
-	if (!context->analysis->iob.read_at(context->analysis->iob.io, addr, buf, colSize)) {
+	if (!rz_analysis_vtable_read_at(context, addr, buf, colSize)) {
 		return false;
 	}
 
@@ -103,7 +103,7 @@ static bool rtti_msvc_read_class_hierarchy_descriptor(RVTableContext *context, u
 		return false;
 	}
 
-	if (!context->analysis->iob.read_at(context->analysis->iob.io, addr, buf, chdSize)) {
+	if (!rz_analysis_vtable_read_at(context, addr, buf, chdSize)) {
 		return false;
 	}
 
@@ -137,7 +137,7 @@ static bool rtti_msvc_read_base_class_descriptor(RVTableContext *context, ut64 a
 		return false;
 	}
 
-	if (!context->analysis->iob.read_at(context->analysis->iob.io, addr, buf, bcdSize)) {
+	if (!rz_analysis_vtable_read_at(context, addr, buf, bcdSize)) {
 		return false;
 	}
 
@@ -179,7 +179,7 @@ static RZ_OWN RzList /*<rtti_base_class_descriptor *>*/ *rtti_msvc_read_base_cla
 
 		ut64 bcdAddr;
 		if (context->word_size <= 4) {
-			if (!context->read_addr(context->analysis, addr, &bcdAddr)) {
+			if (!rz_analysis_vtable_read_addr(context, addr, &bcdAddr)) {
 				break;
 			}
 			if (bcdAddr == UT32_MAX) {
@@ -188,7 +188,7 @@ static RZ_OWN RzList /*<rtti_base_class_descriptor *>*/ *rtti_msvc_read_base_cla
 		} else {
 			// special offset calculation for 64bit
 			ut8 tmp[4] = { 0 };
-			if (!context->analysis->iob.read_at(context->analysis->iob.io, addr, tmp, 4)) {
+			if (!rz_analysis_vtable_read_at(context, addr, tmp, 4)) {
 				rz_list_free(ret);
 				return NULL;
 			}
@@ -228,10 +228,10 @@ static bool rtti_msvc_read_type_descriptor(RVTableContext *context, ut64 addr, r
 		return false;
 	}
 
-	if (!context->read_addr(context->analysis, addr, &td->vtable_addr)) {
+	if (!rz_analysis_vtable_read_addr(context, addr, &td->vtable_addr)) {
 		return false;
 	}
-	if (!context->read_addr(context->analysis, addr + context->word_size, &td->spare)) {
+	if (!rz_analysis_vtable_read_addr(context, addr + context->word_size, &td->spare)) {
 		return false;
 	}
 
@@ -242,7 +242,7 @@ static bool rtti_msvc_read_type_descriptor(RVTableContext *context, ut64 addr, r
 	bool endFound = false;
 	bool endInvalid = false;
 	while (1) {
-		context->analysis->iob.read_at(context->analysis->iob.io, nameAddr + bufOffset, buf, sizeof(buf));
+		rz_analysis_vtable_read_at(context, nameAddr + bufOffset, buf, sizeof(buf));
 		int i;
 		for (i = 0; i < sizeof(buf); i++) {
 			if (buf[i] == '\0') {
@@ -273,7 +273,7 @@ static bool rtti_msvc_read_type_descriptor(RVTableContext *context, ut64 addr, r
 	if (bufOffset == 0) {
 		memcpy(td->name, buf, nameLen + 1);
 	} else {
-		context->analysis->iob.read_at(context->analysis->iob.io, nameAddr,
+		rz_analysis_vtable_read_at(context, nameAddr,
 			(ut8 *)td->name, (int)(nameLen + 1));
 	}
 
@@ -499,7 +499,7 @@ RZ_API void rz_analysis_rtti_msvc_print_base_class_descriptor(RVTableContext *co
 static bool rtti_msvc_print_complete_object_locator_recurse(RVTableContext *context, ut64 atAddress, RzOutputMode mode, bool strict) {
 	ut64 colRefAddr = atAddress - context->word_size;
 	ut64 colAddr;
-	if (!context->read_addr(context->analysis, colRefAddr, &colAddr)) {
+	if (!rz_analysis_vtable_read_addr(context, colRefAddr, &colAddr)) {
 		return false;
 	}
 
@@ -981,7 +981,7 @@ RZ_API void rz_analysis_rtti_msvc_recover_all(RVTableContext *vt_context, RzList
 	rz_list_foreach (vtables, vtableIter, table) {
 		ut64 colRefAddr = table->saddr - vt_context->word_size;
 		ut64 colAddr;
-		if (!vt_context->read_addr(vt_context->analysis, colRefAddr, &colAddr)) {
+		if (!rz_analysis_vtable_read_addr(vt_context, colRefAddr, &colAddr)) {
 			continue;
 		}
 		recovery_analysis_complete_object_locator(&context, colAddr, table);
@@ -0,0 +1,649 @@
+// SPDX-FileCopyrightText: 2023 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+/**
+ * \file type_btf.c
+ * Loader for BTF, the compact type format of Linux kernels and eBPF objects.
+ *
+ * The type and string sections are only indexed when a blob is opened: the
+ * records are converted to RzBaseType and RzCallable when a type id is first
+ * requested, together with the types it depends on. Named types are referred
+ * to by identifiers and queued, so the types they depend on are loaded from a
+ * worklist rather than recursively.
+ *
+ * Format reference: https://www.kernel.org/doc/html/latest/bpf/btf.html
+ */
+
+#include <rz_analysis.h>
+
+#define BTF_MAGIC       0xeb9f
+#define BTF_HEADER_SIZE 0x18
+#define BTF_TYPE_SIZE   0xc
+
+enum {
+	BTF_KIND_UNKN,
+	BTF_KIND_INT,
+	BTF_KIND_PTR,
+	BTF_KIND_ARRAY,
+	BTF_KIND_STRUCT,
+	BTF_KIND_UNION,
+	BTF_KIND_ENUM,
+	BTF_KIND_FWD,
+	BTF_KIND_TYPEDEF,
+	BTF_KIND_VOLATILE,
+	BTF_KIND_CONST,
+	BTF_KIND_RESTRICT,
+	BTF_KIND_FUNC,
+	BTF_KIND_FUNC_PROTO,
+	BTF_KIND_VAR,
+	BTF_KIND_DATASEC,
+	BTF_KIND_FLOAT,
+	BTF_KIND_DECL_TAG,
+	BTF_KIND_TYPE_TAG,
+	BTF_KIND_ENUM64,
+};
+
+#define BTF_INT_SIGNED 0x1
+#define BTF_INT_CHAR   0x2
+#define BTF_INT_BOOL   0x4
+
+// limit for following chains of modifiers, pointers and function prototypes
+#define BTF_MAX_DEPTH 0x40
+
+struct rz_analysis_btf_t {
+	RzTypeDB *typedb;
+	bool big_endian;
+	ut8 *types;
+	ut32 types_len;
+	char *strs;
+	ut32 strs_len;
+	ut32 *offsets; ///< offset in types of every type id, starting with id 1
+	ut32 count; ///< number of type ids, including the implicit void with id 0
+	ut8 *loaded; ///< bitmap of the ids whose base type or function was already loaded or queued
+	RzVector /*<ut32>*/ pending; ///< ids of the base types queued for loading
+};
+
+typedef struct {
+	ut32 name_off;
+	ut32 kind;
+	ut32 vlen;
+	bool kind_flag;
+	ut32 size_or_type;
+	const ut8 *extra; ///< data following the common record
+} BtfType;
+
+static inline ut32 btf_read32(const RzAnalysisBTF *btf, const ut8 *p) {
+	return rz_read_ble32(p, btf->big_endian);
+}
+
+static ut32 btf_extra_size(ut32 kind, ut32 vlen) {
+	switch (kind) {
+	case BTF_KIND_INT:
+	case BTF_KIND_VAR:
+	case BTF_KIND_DECL_TAG:
+		return 4;
+	case BTF_KIND_ARRAY:
+		return 12;
+	case BTF_KIND_STRUCT:
+	case BTF_KIND_UNION:
+	case BTF_KIND_DATASEC:
+	case BTF_KIND_ENUM64:
+		return vlen * 12;
+	case BTF_KIND_ENUM:
+	case BTF_KIND_FUNC_PROTO:
+		return vlen * 8;
+	default:
+		return 0;
+	}
+}
+
+static bool btf_type_get(const RzAnalysisBTF *btf, ut32 id, BtfType *t) {
+	if (!id || id >= btf->count) {
+		return false;
+	}
+	const ut8 *p = btf->types + btf->offsets[id - 1];
+	ut32 info = btf_read32(btf, p + 4);
+	t->name_off = btf_read32(btf, p);
+	t->vlen = info & 0xffff;
+	t->kind = (info >> 24) & 0x1f;
+	t->kind_flag = info >> 31;
+	t->size_or_type = btf_read32(btf, p + 8);
+	t->extra = p + BTF_TYPE_SIZE;
+	return true;
+}
+
+static const char *btf_str(const RzAnalysisBTF *btf, ut32 off) {
+	if (off >= btf->strs_len || !btf->strs[off]) {
+		return NULL;
+	}
+	return btf->strs + off;
+}
+
+static bool btf_index(RzAnalysisBTF *btf) {
+	RzVector offsets;
+	rz_vector_init(&offsets, sizeof(ut32), NULL, NULL);
+	ut32 off = 0;
+	while (off < btf->types_len) {
+		if (btf->types_len - off < BTF_TYPE_SIZE) {
+			goto err;
+		}
+		ut32 info = btf_read32(btf, btf->types + off + 4);
+		ut32 extra = btf_extra_size((info >> 24) & 0x1f, info & 0xffff);
+		if (btf->types_len - off - BTF_TYPE_SIZE < extra) {
+			goto err;
+		}
+		if (!rz_vector_push(&offsets, &off)) {
+			goto err;
+		}
+		off += BTF_TYPE_SIZE + extra;
+	}
+	btf->count = rz_vector_len(&offsets) + 1;
+	btf->offsets = rz_vector_flush(&offsets);
+	btf->loaded = calloc(1, btf->count / 8 + 1);
+	rz_vector_fini(&offsets);
+	return btf->loaded != NULL;
+err:
+	RZ_LOG_ERROR("BTF: invalid type record at 0x%" PFMT32x "\n", off);
+	rz_vector_fini(&offsets);
+	return false;
+}
+
+/**
+ * \brief Open a BTF blob, like the .BTF section of an ELF file or /sys/kernel/btf/vmlinux
+ *
+ * Only the records are indexed here, types are loaded into \p typedb on demand.
+ * Split BTF of kernel modules, which refers to the ids of vmlinux, is not supported.
+ */
+RZ_API RZ_OWN RzAnalysisBTF *rz_analysis_btf_new(RZ_NONNULL RzTypeDB *typedb, RZ_NONNULL RzBuffer *buf) {
+	rz_return_val_if_fail(typedb && buf, NULL);
+	ut8 hdr[BTF_HEADER_SIZE];
+	if (rz_buf_read_at(buf, 0, hdr, sizeof(hdr)) != sizeof(hdr)) {
+		return NULL;
+	}
+	RzAnalysisBTF *btf = RZ_NEW0(RzAnalysisBTF);
+	if (!btf) {
+		return NULL;
+	}
+	btf->typedb = typedb;
+	rz_vector_init(&btf->pending, sizeof(ut32), NULL, NULL);
+	if (rz_read_le16(hdr) != BTF_MAGIC) {
+		if (rz_read_be16(hdr) != BTF_MAGIC) {
+			RZ_LOG_ERROR("BTF: invalid magic\n");
+			goto err;
+		}
+		btf->big_endian = true;
+	}
+	if (hdr[2] != 1) {
+		RZ_LOG_ERROR("BTF: unsupported version %d\n", hdr[2]);
+		goto err;
+	}
+	ut32 hdr_len = btf_read32(btf, hdr + 4);
+	ut32 type_off = btf_read32(btf, hdr + 8);
+	btf->types_len = btf_read32(btf, hdr + 12);
+	ut32 str_off = btf_read32(btf, hdr + 16);
+	btf->strs_len = btf_read32(btf, hdr + 20);
+	ut64 size = rz_buf_size(buf);
+	if ((ut64)hdr_len + type_off + btf->types_len > size || (ut64)hdr_len + str_off + btf->strs_len > size) {
+		RZ_LOG_ERROR("BTF: sections out of bounds\n");
+		goto err;
+	}
+	btf->types = malloc(btf->types_len + 1);
+	btf->strs = malloc(btf->strs_len + 1);
+	if (!btf->types || !btf->strs ||
+		rz_buf_read_at(buf, hdr_len + type_off, btf->types, btf->types_len) != btf->types_len ||
+		rz_buf_read_at(buf, hdr_len + str_off, (ut8 *)btf->strs, btf->strs_len) != btf->strs_len) {
+		goto err;
+	}
+	btf->strs[btf->strs_len] = '\0';
+	if (!btf_index(btf)) {
+		goto err;
+	}
+	return btf;
+err:
+	rz_analysis_btf_free(btf);
+	return NULL;
+}
+
+RZ_API void rz_analysis_btf_free(RZ_NULLABLE RzAnalysisBTF *btf) {
+	if (!btf) {
+		return;
+	}
+	free(btf->types);
+	free(btf->strs);
+	free(btf->offsets);
+	free(btf->loaded);
+	rz_vector_fini(&btf->pending);
+	free(btf);
+}
+
+/**
+ * \brief Number of type ids in \p btf, including the id 0 standing for void
+ */
+RZ_API ut32 rz_analysis_btf_types_count(RZ_NONNULL const RzAnalysisBTF *btf) {
+	rz_return_val_if_fail(btf, 0);
+	return btf->count;
+}
+
+static inline bool btf_loaded(RzAnalysisBTF *btf, ut32 id) {
+	return btf->loaded[id >> 3] & (1 << (id & 7));
+}
+
+static inline void btf_set_loaded(RzAnalysisBTF *btf, ut32 id) {
+	btf->loaded[id >> 3] |= 1 << (id & 7);
+}
+
+/**
+ * Size in bits of the type \p id, following typedefs and modifiers.
+ */
+static ut64 btf_type_bits(RzAnalysisBTF *btf, ut32 id, int depth) {
+	BtfType t;
+	for (; depth < BTF_MAX_DEPTH && btf_type_get(btf, id, &t); depth++) {
+		switch (t.kind) {
+		case BTF_KIND_INT:
+		case BTF_KIND_STRUCT:
+		case BTF_KIND_UNION:
+		case BTF_KIND_ENUM:
+		case BTF_KIND_ENUM64:
+		case BTF_KIND_FLOAT:
+		case BTF_KIND_DATASEC:
+			return (ut64)t.size_or_type * 8;
+		case BTF_KIND_PTR:
+			return rz_type_db_pointer_size(btf->typedb);
+		case BTF_KIND_ARRAY:
+			return btf_read32(btf, t.extra + 8) * btf_type_bits(btf, btf_read32(btf, t.extra), depth + 1);
+		case BTF_KIND_TYPEDEF:
+		case BTF_KIND_VOLATILE:
+		case BTF_KIND_CONST:
+		case BTF_KIND_RESTRICT:
+		case BTF_KIND_TYPE_TAG:
+			id = t.size_or_type;
+			break;
+		default:
+			return 0;
+		}
+	}
+	return 0;
+}
+
+static char *btf_type_name(RzAnalysisBTF *btf, ut32 id, const BtfType *t, const char *kind) {
+	const char *name = btf_str(btf, t->name_off);
+	return name ? strdup(name) : rz_str_newf("anonymous_%s_%" PFMT32u, kind, id);
+}
+
+static const char *btf_kind_name(ut32 kind) {
+	switch (kind) {
+	case BTF_KIND_STRUCT:
+		return "struct";
+	case BTF_KIND_UNION:
+		return "union";
+	case BTF_KIND_ENUM:
+	case BTF_KIND_ENUM64:
+		return "enum";
+	case BTF_KIND_TYPEDEF:
+		return "typedef";
+	default:
+		return "type";
+	}
+}
+
+static RzTypeIdentifierKind btf_identifier_kind(ut32 kind) {
+	switch (kind) {
+	case BTF_KIND_STRUCT:
+		return RZ_TYPE_IDENTIFIER_KIND_STRUCT;
+	case BTF_KIND_UNION:
+		return RZ_TYPE_IDENTIFIER_KIND_UNION;
+	case BTF_KIND_ENUM:
+	case BTF_KIND_ENUM64:
+		return RZ_TYPE_IDENTIFIER_KIND_ENUM;
+	default:
+		return RZ_TYPE_IDENTIFIER_KIND_UNSPECIFIED;
+	}
+}
+
+static RzType *btf_type(RzAnalysisBTF *btf, ut32 id, int depth);
+
+/**
+ * Queue the base type \p id for loading, unless it was loaded or queued already.
+ */
+static void btf_base_type_queue(RzAnalysisBTF *btf, ut32 id) {
+	if (btf_loaded(btf, id)) {
+		return;
+	}
+	// marked when queued, so types referring back to this one do not queue it again
+	btf_set_loaded(btf, id);
+	rz_vector_push(&btf->pending, &id);
+}
+
+static RzType *btf_identifier(const char *name, RzTypeIdentifierKind kind) {
+	RzType *type = RZ_NEW0(RzType);
+	if (!type) {
+		return NULL;
+	}
+	type->kind = RZ_TYPE_KIND_IDENTIFIER;
+	type->identifier.kind = kind;
+	type->identifier.name = strdup(name);
+	return type;
+}
+
+static RzCallable *btf_func_proto(RzAnalysisBTF *btf, const char *name, const BtfType *t, int depth) {
+	RzCallable *callable = rz_type_callable_new(name);
+	if (!callable) {
+		return NULL;
+	}
+	callable->ret = btf_type(btf, t->size_or_type, depth + 1);
+	for (ut32 i = 0; i < t->vlen; i++) {
+		const ut8 *param = t->extra + i * 8;
+		ut32 type_id = btf_read32(btf, param + 4);
+		if (!type_id) {
+			// a last parameter of type void stands for the ellipsis
+			callable->has_unspecified_parameters = true;
+			break;
+		}
+		const char *pname = btf_str(btf, btf_read32(btf, param));
+		char *tmp = pname ? NULL : rz_str_newf("arg%" PFMT32u, i);
+		RzType *ptype = btf_type(btf, type_id, depth + 1);
+		RzCallableArg *arg = ptype ? rz_type_callable_arg_new(btf->typedb, pname ? pname : tmp, ptype) : NULL;
+		free(tmp);
+		if (!arg) {
+			rz_type_free(ptype);
+			continue;
+		}
+		rz_type_callable_arg_add(callable, arg);
+	}
+	return callable;
+}
+
+static RzType *btf_type(RzAnalysisBTF *btf, ut32 id, int depth) {
+	BtfType t;
+	if (!id || depth > BTF_MAX_DEPTH || !btf_type_get(btf, id, &t)) {
+		return btf_identifier("void", RZ_TYPE_IDENTIFIER_KIND_UNSPECIFIED);
+	}
+	RzType *type = NULL;
+	switch (t.kind) {
+	case BTF_KIND_INT:
+	case BTF_KIND_FLOAT:
+	case BTF_KIND_TYPEDEF:
+	case BTF_KIND_STRUCT:
+	case BTF_KIND_UNION:
+	case BTF_KIND_ENUM:
+	case BTF_KIND_ENUM64: {
+		btf_base_type_queue(btf, id);
+		char *name = btf_type_name(btf, id, &t, btf_kind_name(t.kind));
+		type = name ? btf_identifier(name, btf_identifier_kind(t.kind)) : NULL;
+		free(name);
+		break;
+	}
+	case BTF_KIND_FWD: {
+		const char *name = btf_str(btf, t.name_off);
+		type = btf_identifier(name ? name : "void", t.kind_flag ? RZ_TYPE_IDENTIFIER_KIND_UNION : RZ_TYPE_IDENTIFIER_KIND_STRUCT);
+		break;
+	}
+	case BTF_KIND_PTR: {
+		RzType *target = btf_type(btf, t.size_or_type, depth + 1);
+		if (!target) {
+			return NULL;
+		}
+		type = RZ_NEW0(RzType);
+		if (!type) {
+			rz_type_free(target);
+			return NULL;
+		}
+		type->kind = RZ_TYPE_KIND_POINTER;
+		type->pointer.type = target;
+		break;
+	}
+	case BTF_KIND_ARRAY: {
+		RzType *elem = btf_type(btf, btf_read32(btf, t.extra), depth + 1);
+		if (!elem) {
+			return NULL;
+		}
+		type = RZ_NEW0(RzType);
+		if (!type) {
+			rz_type_free(elem);
+			return NULL;
+		}
+		type->kind = RZ_TYPE_KIND_ARRAY;
+		type->array.type = elem;
+		type->array.count = btf_read32(btf, t.extra + 8);
+		break;
+	}
+	case BTF_KIND_CONST:
+		type = btf_type(btf, t.size_or_type, depth + 1);
+		if (type && type->kind == RZ_TYPE_KIND_IDENTIFIER) {
+			type->identifier.is_const = true;
+		} else if (type && type->kind == RZ_TYPE_KIND_POINTER) {
+			type->pointer.is_const = true;
+		}
+		break;
+	case BTF_KIND_VOLATILE:
+	case BTF_KIND_RESTRICT:
+	case BTF_KIND_TYPE_TAG:
+		type = btf_type(btf, t.size_or_type, depth + 1);
+		break;
+	case BTF_KIND_FUNC_PROTO: {
+		RzCallable *callable = btf_func_proto(btf, NULL, &t, depth);
+		type = callable ? rz_type_callable(callable) : NULL;
+		break;
+	}
+	default:
+		return btf_identifier("void", RZ_TYPE_IDENTIFIER_KIND_UNSPECIFIED);
+	}
+	return type;
+}
+
+static bool btf_members_load(RzAnalysisBTF *btf, RzBaseType *btype, const BtfType *t) {
+	for (ut32 i = 0; i < t->vlen; i++) {
+		const ut8 *m = t->extra + i * 12;
+		ut32 type_id = btf_read32(btf, m + 4);
+		ut32 offset = btf_read32(btf, m + 8);
+		ut32 bitfield = 0;
+		if (t->kind_flag) {
+			bitfield = offset >> 24;
+			offset &= 0xffffff;
+		}
+		const char *name = btf_str(btf, btf_read32(btf, m));
+		RzTypeStructMember member = {
+			.name = name ? strdup(name) : rz_str_newf("anonymous_member_%" PFMT32u, i),
+			.type = btf_type(btf, type_id, 0),
+			.offset = offset / 8,
+			.size = bitfield ? bitfield : btf_type_bits(btf, type_id, 0)
+		};
+		if (!member.name || !member.type || !rz_vector_push(&btype->struct_data.members, &member)) {
+			free(member.name);
+			rz_type_free(member.type);
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool btf_enum_load(RzAnalysisBTF *btf, RzBaseType *btype, const BtfType *t) {
+	bool wide = t->kind == BTF_KIND_ENUM64;
+	for (ut32 i = 0; i < t->vlen; i++) {
+		const ut8 *e = t->extra + i * (wide ? 12 : 8);
+		const char *name = btf_str(btf, btf_read32(btf, e));
+		ut32 lo = btf_read32(btf, e + 4);
+		// kind_flag tells whether the values are signed
+		st64 val = wide
+			? (st64)(((ut64)btf_read32(btf, e + 8) << 32) | lo)
+			: (t->kind_flag ? (st64)(st32)lo : (st64)lo);
+		RzTypeEnumCase cas = {
+			.name = name ? strdup(name) : rz_str_newf("anonymous_case_%" PFMT32u, i),
+			.val = val
+		};
+		if (!cas.name || !rz_vector_push(&btype->enum_data.cases, &cas)) {
+			free(cas.name);
+			return false;
+		}
+	}
+	return true;
+}
+
+static RzTypeTypeclass btf_int_typeclass(ut32 encoding) {
+	if (encoding & BTF_INT_BOOL) {
+		return RZ_TYPE_TYPECLASS_NONE;
+	}
+	return encoding & BTF_INT_SIGNED ? RZ_TYPE_TYPECLASS_INTEGRAL_SIGNED : RZ_TYPE_TYPECLASS_INTEGRAL_UNSIGNED;
+}
+
+/**
+ * Convert the record \p t of the queued \p id to a base type and save it in the
+ * type database. The named types it refers to are queued in turn.
+ */
+static void btf_base_type_load(RzAnalysisBTF *btf, ut32 id, const BtfType *t) {
+	RzBaseType *btype = NULL;
+	switch (t->kind) {
+	case BTF_KIND_INT:
+	case BTF_KIND_FLOAT: {
+		const char *name = btf_str(btf, t->name_off);
+		if (!name || rz_type_db_get_base_type(btf->typedb, name)) {
+			// the target's own definition of the primitive types wins
+			return;
+		}
+		btype = rz_type_base_type_new(RZ_BASE_TYPE_KIND_ATOMIC);
+		if (!btype) {
+			return;
+		}
+		btype->attrs = t->kind == BTF_KIND_FLOAT ? RZ_TYPE_TYPECLASS_FLOATING : btf_int_typeclass(btf_read32(btf, t->extra) >> 24);
+		btype->size = (ut64)t->size_or_type * 8;
+		btype->type = btf_identifier(name, RZ_TYPE_IDENTIFIER_KIND_UNSPECIFIED);
+		break;
+	}
+	case BTF_KIND_TYPEDEF: {
+		RzType *type = btf_type(btf, t->size_or_type, 0);
+		const char *name = btf_str(btf, t->name_off);
+		if (!type || !name ||
+			// typedef struct foo foo; the identifier already resolves to the struct
+			(type->kind == RZ_TYPE_KIND_IDENTIFIER && !strcmp(type->identifier.name, name))) {
+			rz_type_free(type);
+			return;
+		}
+		btype = rz_type_base_type_new(RZ_BASE_TYPE_KIND_TYPEDEF);
+		if (!btype) {
+			rz_type_free(type);
+			return;
+		}
+		btype->type = type;
+		break;
+	}
+	case BTF_KIND_STRUCT:
+	case BTF_KIND_UNION:
+		btype = rz_type_base_type_new(t->kind == BTF_KIND_STRUCT ? RZ_BASE_TYPE_KIND_STRUCT : RZ_BASE_TYPE_KIND_UNION);
+		if (!btype || !btf_members_load(btf, btype, t)) {
+			rz_type_base_type_free(btype);
+			return;
+		}
+		btype->size = (ut64)t->size_or_type * 8;
+		break;
+	case BTF_KIND_ENUM:
+	case BTF_KIND_ENUM64:
+		btype = rz_type_base_type_new(RZ_BASE_TYPE_KIND_ENUM);
+		if (!btype || !btf_enum_load(btf, btype, t)) {
+			rz_type_base_type_free(btype);
+			return;
+		}
+		btype->size = (ut64)t->size_or_type * 8;
+		if (t->size_or_type > 4) {
+			btype->type = btf_identifier(t->kind_flag ? "int64_t" : "uint64_t", RZ_TYPE_IDENTIFIER_KIND_UNSPECIFIED);
+		} else {
+			btype->type = btf_identifier(t->kind_flag ? "int" : "unsigned int", RZ_TYPE_IDENTIFIER_KIND_UNSPECIFIED);
+		}
+		break;
+	default:
+		return;
+	}
+	btype->name = btf_type_name(btf, id, t, btf_kind_name(t->kind));
+	if (!btype->name) {
+		rz_type_base_type_free(btype);
+		return;
+	}
+	rz_type_db_update_base_type(btf->typedb, btype);
+}
+
+/**
+ * Load the queued base types, and the ones queued while loading them, one at a time.
+ */
+static void btf_pending_load(RzAnalysisBTF *btf) {
+	while (!rz_vector_empty(&btf->pending)) {
+		ut32 id;
+		rz_vector_pop(&btf->pending, &id);
+		BtfType t;
+		if (btf_type_get(btf, id, &t)) {
+			btf_base_type_load(btf, id, &t);
+		}
+	}
+}
+
+/**
+ * \brief Load the type \p id and every type it depends on into the type database
+ *
+ * \return the type standing for \p id, to be used e.g. for a variable of this type
+ */
+RZ_API RZ_OWN RzType *rz_analysis_btf_type_load(RZ_NONNULL RzAnalysisBTF *btf, ut32 id) {
+	rz_return_val_if_fail(btf, NULL);
+	RzType *type = btf_type(btf, id, 0);
+	btf_pending_load(btf);
+	return type;
+}
+
+/**
+ * \brief Load the signature of the function \p id into the type database
+ */
+RZ_API bool rz_analysis_btf_func_load(RZ_NONNULL RzAnalysisBTF *btf, ut32 id) {
+	rz_return_val_if_fail(btf, false);
+	BtfType t, proto;
+	if (!btf_type_get(btf, id, &t) || t.kind != BTF_KIND_FUNC ||
+		!btf_type_get(btf, t.size_or_type, &proto) || proto.kind != BTF_KIND_FUNC_PROTO) {
+		return false;
+	}
+	const char *name = btf_str(btf, t.name_off);
+	if (!name) {
+		return false;
+	}
+	if (btf_loaded(btf, id)) {
+		return true;
+	}
+	btf_set_loaded(btf, id);
+	RzCallable *callable = btf_func_proto(btf, name, &proto, 0);
+	btf_pending_load(btf);
+	return callable && rz_type_func_update(btf->typedb, callable);
+}
+
+/**
+ * \brief Load all named types and function signatures of \p btf into the type database
+ *
+ * \return the number of types and functions loaded
+ */
+RZ_API size_t rz_analysis_btf_load_all(RZ_NONNULL RzAnalysisBTF *btf) {
+	rz_return_val_if_fail(btf, 0);
+	size_t n = 0;
+	for (ut32 id = 1; id < btf->count; id++) {
+		BtfType t;
+		if (!btf_type_get(btf, id, &t)) {
+			continue;
+		}
+		switch (t.kind) {
+		case BTF_KIND_INT:
+		case BTF_KIND_FLOAT:
+		case BTF_KIND_TYPEDEF:
+		case BTF_KIND_STRUCT:
+		case BTF_KIND_UNION:
+		case BTF_KIND_ENUM:
+		case BTF_KIND_ENUM64:
+			if (!btf_loaded(btf, id)) {
+				btf_base_type_queue(btf, id);
+				btf_pending_load(btf);
+				n++;
+			}
+			break;
+		case BTF_KIND_FUNC:
+			if (!btf_loaded(btf, id) && rz_analysis_btf_func_load(btf, id)) {
+				n++;
+			}
+			break;
+		default:
+			break;
+		}
+	}
+	return n;
+}
@@ -83,15 +83,16 @@ RZ_API bool rz_analysis_var_global_add(RzAnalysis *analysis, RZ_NONNULL RzAnalys
  *
  * \param analysis RzAnalysis
  * \param name Global variable name
- * \param type Global variable type
+ * \param type Global variable type, always owned by the function, it is freed on failure
  * \param addr Global variable address
  * \return true if succeed
  */
-RZ_API bool rz_analysis_var_global_create(RzAnalysis *analysis, RZ_NONNULL const char *name, RZ_NONNULL RZ_BORROW RzType *type, ut64 addr) {
+RZ_API bool rz_analysis_var_global_create(RzAnalysis *analysis, RZ_NONNULL const char *name, RZ_NONNULL RZ_OWN RzType *type, ut64 addr) {
 	rz_return_val_if_fail(analysis && name && type, false);
 
 	RzAnalysisVarGlobal *glob = rz_analysis_var_global_new(name, addr);
 	if (!glob) {
+		rz_type_free(type);
 		return false;
 	}
 
@@ -327,6 +328,47 @@ RZ_API bool rz_analysis_var_global_rename(RzAnalysis *analysis, RZ_NONNULL const
 	return ht_pp_update_key(analysis->ht_global_var, old_name, newname);
 }
 
+/**
+ * \brief Move all the global variables by \p diff
+ *
+ * Their flags are not touched, they are rebased along with all the other flags.
+ *
+ * \param analysis RzAnalysis
+ * \param diff The difference between the new and the old base address
+ */
+RZ_API void rz_analysis_var_global_rebase(RzAnalysis *analysis, ut64 diff) {
+	rz_return_if_fail(analysis);
+	if (!diff || !analysis->global_var_tree) {
+		return;
+	}
+	RBIter first = rz_rbtree_first(analysis->global_var_tree);
+	RBIter last = rz_rbtree_last(analysis->global_var_tree);
+	ut64 lo = rz_rbtree_iter_get(&first, RzAnalysisVarGlobal, rb)->addr;
+	ut64 hi = rz_rbtree_iter_get(&last, RzAnalysisVarGlobal, rb)->addr;
+	RBIter it;
+	RzAnalysisVarGlobal *glob;
+	if (lo + diff <= hi + diff) {
+		// the order of the variables is preserved, the tree can be shifted in place
+		rz_rbtree_foreach (analysis->global_var_tree, it, glob, RzAnalysisVarGlobal, rb) {
+			glob->addr += diff;
+		}
+		return;
+	}
+	RzPVector globals;
+	rz_pvector_init(&globals, NULL);
+	rz_rbtree_foreach (analysis->global_var_tree, it, glob, RzAnalysisVarGlobal, rb) {
+		rz_pvector_push(&globals, glob);
+	}
+	analysis->global_var_tree = NULL;
+	void **iter;
+	rz_pvector_foreach (&globals, iter) {
+		glob = *iter;
+		glob->addr += diff;
+		rz_rbtree_aug_insert(&analysis->global_var_tree, &glob->addr, &glob->rb, global_var_node_cmp, NULL, NULL);
+	}
+	rz_pvector_fini(&globals);
+}
+
 /**
  * \brief Set the type of the global variable
  *
@@ -0,0 +1,606 @@
+// SPDX-FileCopyrightText: 2023 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_analysis.h>
+#include <rz_th.h>
+
+/**
+ * \file var_global_recover.c
+ * Recovery of global variables from the data references found by the analysis.
+ *
+ * Every target of a data xref is an access, sized by the instruction that
+ * makes it when it tells. The accesses are split in ranges which never cross
+ * a section, and every range is turned into objects on its own:
+ *  - a run of at least 3 equally sized and contiguous accesses is an array,
+ *  - accesses repeating the same layout with a period are an array of structures,
+ *  - any other access is a scalar, or an array when it is made through an
+ *    index register, extending up to the next object.
+ * No object extends over a global variable or a function that already exists.
+ * Only the collection of the accesses and the final insertion touch the
+ * analysis, the inference runs on several threads.
+ */
+
+#define GLOBAL_RANGE_GAP      0x1000 ///< Gap between accesses after which a new range starts
+#define GLOBAL_MAX_EXTENT     0x10000 ///< Max size of an object whose end is only given by the next one
+#define GLOBAL_MAX_STRUCT     0x100 ///< Max size of a structure guessed from a stride
+#define GLOBAL_MIN_ARRAY_RUN  3
+#define GLOBAL_MIN_STRUCT_RUN 2
+
+typedef struct {
+	ut64 addr;
+	ut32 size; ///< Size of the access in bytes, 0 if unknown
+	bool indexed; ///< Accessed through an index register
+	bool pointer; ///< Contains the address of mapped memory
+	ut64 string; ///< Size of the string at addr, 0 if there is none
+	ut64 limit; ///< End of the section containing addr
+	ut64 bound; ///< Start of the first existing global or function after addr
+} GlobalAccess;
+
+typedef enum {
+	GLOBAL_KIND_SCALAR,
+	GLOBAL_KIND_POINTER,
+	GLOBAL_KIND_STRING,
+	GLOBAL_KIND_BYTES,
+	GLOBAL_KIND_ARRAY,
+	GLOBAL_KIND_STRUCT_ARRAY,
+} GlobalKind;
+
+typedef struct {
+	ut32 offset;
+	ut32 size;
+} GlobalField;
+
+typedef struct {
+	ut64 addr;
+	GlobalKind kind;
+	ut32 elem_size; ///< Size of the scalar or the structure
+	ut64 count; ///< Number of elements of arrays, bytes of strings and byte blobs
+	RzVector /*<GlobalField>*/ fields; ///< Fields of the structure
+} GlobalCandidate;
+
+typedef struct {
+	const GlobalAccess *accesses;
+	size_t count;
+	ut64 end; ///< Where the last object must end at the latest
+	size_t ptr_size;
+	RzVector /*<GlobalCandidate>*/ candidates;
+} GlobalRange;
+
+typedef struct {
+	RzAnalysis *analysis;
+	ut64 from;
+	ut64 to;
+	size_t ptr_size;
+	RzVector /*<GlobalAccess>*/ accesses;
+	HtUP /*<ut64, GlobalAccess *>*/ *by_addr;
+	RzVector /*<ut64>*/ objects; ///< Sorted addresses of the existing globals and functions
+} GlobalCollect;
+
+static void global_candidate_fini(void *e, void *user) {
+	GlobalCandidate *cand = e;
+	rz_vector_fini(&cand->fields);
+}
+
+static bool global_candidate_push(GlobalRange *range, ut64 addr, GlobalKind kind, ut32 elem_size, ut64 count) {
+	GlobalCandidate *cand = rz_vector_push(&range->candidates, NULL);
+	if (!cand) {
+		return false;
+	}
+	cand->addr = addr;
+	cand->kind = kind;
+	cand->elem_size = elem_size;
+	cand->count = count;
+	rz_vector_init(&cand->fields, sizeof(GlobalField), NULL, NULL);
+	return true;
+}
+
+/**
+ * Decodes the instruction at \p from to learn how it accesses \p acc.
+ */
+static void access_update(GlobalCollect *gc, GlobalAccess *acc, ut64 from) {
+	RzAnalysis *analysis = gc->analysis;
+	ut8 buf[32];
+	if (!analysis->iob.read_at || !analysis->iob.read_at(analysis->iob.io, from, buf, sizeof(buf))) {
+		return;
+	}
+	RzAnalysisOp op;
+	rz_analysis_op_init(&op);
+	if (rz_analysis_op(analysis, &op, from, buf, sizeof(buf), RZ_ANALYSIS_OP_MASK_BASIC) > 0) {
+		// The address is either the operand itself or the displacement
+		// added to registers, which is how arrays are indexed
+		bool direct = op.ptr == acc->addr;
+		bool indexed = !direct && op.disp == acc->addr;
+		if ((direct || indexed) && op.refptr > 0) {
+			acc->size = RZ_MAX(acc->size, (ut32)op.refptr);
+		}
+		acc->indexed |= indexed || (direct && op.ireg);
+	}
+	rz_analysis_op_fini(&op);
+}
+
+static int addr_cmp(const void *a, const void *b) {
+	ut64 x = *(const ut64 *)a;
+	ut64 y = *(const ut64 *)b;
+	if (x < y) {
+		return -1;
+	}
+	return x > y ? 1 : 0;
+}
+
+static bool objects_load(GlobalCollect *gc) {
+	RzAnalysis *analysis = gc->analysis;
+	RBIter it;
+	RzAnalysisVarGlobal *glob;
+	rz_rbtree_foreach (analysis->global_var_tree, it, glob, RzAnalysisVarGlobal, rb) {
+		if (!rz_vector_push(&gc->objects, &glob->addr)) {
+			return false;
+		}
+	}
+	RzListIter *iter;
+	RzAnalysisFunction *fcn;
+	rz_list_foreach (analysis->fcns, iter, fcn) {
+		if (!rz_vector_push(&gc->objects, &fcn->addr)) {
+			return false;
+		}
+	}
+	rz_vector_sort(&gc->objects, addr_cmp, false);
+	return true;
+}
+
+/**
+ * Returns the start of the first existing global or function after \p addr.
+ */
+static ut64 object_after(const RzVector /*<ut64>*/ *objects, ut64 addr) {
+	size_t lo = 0, hi = rz_vector_len(objects);
+	const ut64 *a = objects->a;
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		if (a[mid] <= addr) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo < rz_vector_len(objects) ? a[lo] : UT64_MAX;
+}
+
+static bool pointer_at(GlobalCollect *gc, ut64 addr) {
+	RzAnalysis *analysis = gc->analysis;
+	ut8 buf[8];
+	if (!analysis->iob.read_at || !analysis->iob.is_valid_offset ||
+		!analysis->iob.read_at(analysis->iob.io, addr, buf, gc->ptr_size)) {
+		return false;
+	}
+	ut64 value = rz_read_ble(buf, analysis->big_endian, gc->ptr_size * 8);
+	return value && analysis->iob.is_valid_offset(analysis->iob.io, value, 0);
+}
+
+/**
+ * Returns the access to \p addr, NULL if it cannot be the address of a global.
+ */
+static GlobalAccess *access_get(GlobalCollect *gc, ut64 addr) {
+	bool found;
+	size_t index = (size_t)ht_up_find(gc->by_addr, addr, &found);
+	if (found) {
+		return index ? rz_vector_index_ptr(&gc->accesses, index - 1) : NULL;
+	}
+	RzAnalysis *analysis = gc->analysis;
+	GlobalAccess acc = { .addr = addr, .limit = UT64_MAX, .bound = object_after(&gc->objects, addr) };
+	bool valid = true;
+	RzBinSection *sect = analysis->binb.bin && analysis->binb.get_vsect_at
+		? analysis->binb.get_vsect_at(analysis->binb.bin, addr)
+		: NULL;
+	if (sect) {
+		valid = !(sect->perm & RZ_PERM_X);
+		acc.limit = sect->vaddr + sect->vsize;
+	} else {
+		valid = !rz_analysis_find_most_relevant_block_in(analysis, addr);
+	}
+	if (valid && (rz_analysis_var_global_get_byaddr_in(analysis, addr) || rz_analysis_get_function_at(analysis, addr))) {
+		valid = false;
+	}
+	if (!valid) {
+		ht_up_insert(gc->by_addr, addr, NULL);
+		return NULL;
+	}
+	ut64 size = 0;
+	if (rz_meta_get_at(analysis, addr, RZ_META_TYPE_STRING, &size)) {
+		acc.string = size;
+	}
+	acc.pointer = pointer_at(gc, addr);
+	if (!rz_vector_push(&gc->accesses, &acc)) {
+		return NULL;
+	}
+	size_t len = rz_vector_len(&gc->accesses);
+	ht_up_insert(gc->by_addr, addr, (void *)len);
+	return rz_vector_index_ptr(&gc->accesses, len - 1);
+}
+
+static bool collect_xref_cb(void *user, const ut64 k, const void *v) {
+	GlobalCollect *gc = user;
+	const RzAnalysisXRef *xref = v;
+	if (xref->type != RZ_ANALYSIS_XREF_TYPE_DATA && xref->type != RZ_ANALYSIS_XREF_TYPE_STRING) {
+		return true;
+	}
+	GlobalAccess *acc = access_get(gc, xref->to);
+	if (acc) {
+		access_update(gc, acc, xref->from);
+	}
+	return true;
+}
+
+static bool collect_to_cb(void *user, const ut64 k, const void *v) {
+	GlobalCollect *gc = user;
+	if (k >= gc->from && k < gc->to) {
+		ht_up_foreach((HtUP *)v, collect_xref_cb, gc);
+	}
+	return true;
+}
+
+static int access_cmp(const void *a, const void *b) {
+	ut64 x = ((const GlobalAccess *)a)->addr;
+	ut64 y = ((const GlobalAccess *)b)->addr;
+	if (x < y) {
+		return -1;
+	}
+	return x > y ? 1 : 0;
+}
+
+/**
+ * Length of the run of equally sized, contiguous accesses starting at \p i.
+ */
+static size_t array_run(const GlobalRange *range, size_t i) {
+	const GlobalAccess *acc = range->accesses;
+	ut32 size = acc[i].size;
+	if (!size || acc[i].string) {
+		return 1;
+	}
+	size_t j = i + 1;
+	while (j < range->count && acc[j].size == size && !acc[j].string && acc[j].addr - acc[j - 1].addr == size &&
+		acc[j].addr + size <= acc[i].bound) {
+		j++;
+	}
+	return j - i;
+}
+
+/**
+ * Looks for accesses repeating the same layout with a period, starting at
+ * \p i. Every access up to the last period has to fit the layout.
+ *
+ * \return the number of accesses consumed, 0 if there is no such pattern
+ */
+static size_t struct_array_at(GlobalRange *range, size_t i) {
+	const GlobalAccess *acc = range->accesses;
+	const GlobalAccess *first = &acc[i];
+	if (!first->size || first->string) {
+		return 0;
+	}
+	for (size_t j = i + 1; j < range->count; j++) {
+		ut64 stride = acc[j].addr - first->addr;
+		if (stride > GLOBAL_MAX_STRUCT) {
+			break;
+		}
+		if (acc[j].size != first->size || acc[j].string) {
+			continue;
+		}
+		// The fields are the accesses of the first period
+		GlobalField fields[GLOBAL_MAX_STRUCT];
+		size_t n_fields = 0;
+		bool valid = true;
+		for (size_t k = i; k < j && valid; k++) {
+			ut64 off = acc[k].addr - first->addr;
+			valid = acc[k].size && !acc[k].string && off + acc[k].size <= stride &&
+				(!n_fields || off >= fields[n_fields - 1].offset + fields[n_fields - 1].size);
+			if (valid) {
+				fields[n_fields].offset = (ut32)off;
+				fields[n_fields].size = acc[k].size;
+				n_fields++;
+			}
+		}
+		if (!valid) {
+			continue;
+		}
+		size_t k = j;
+		for (; k < range->count; k++) {
+			ut64 off = (acc[k].addr - first->addr) % stride;
+			size_t f = 0;
+			while (f < n_fields && fields[f].offset < off) {
+				f++;
+			}
+			if (f == n_fields || fields[f].offset != off || fields[f].size != acc[k].size || acc[k].string) {
+				break;
+			}
+		}
+		ut64 periods = (acc[k - 1].addr - first->addr) / stride + 1;
+		if (periods < (n_fields > 1 ? GLOBAL_MIN_STRUCT_RUN : GLOBAL_MIN_ARRAY_RUN) ||
+			first->addr + periods * stride > RZ_MIN(range->end, first->bound)) {
+			continue;
+		}
+		if (!global_candidate_push(range, first->addr, GLOBAL_KIND_STRUCT_ARRAY, (ut32)stride, periods)) {
+			return 0;
+		}
+		GlobalCandidate *cand = rz_vector_tail(&range->candidates);
+		for (size_t f = 0; f < n_fields; f++) {
+			rz_vector_push(&cand->fields, &fields[f]);
+		}
+		return k - i;
+	}
+	return 0;
+}
+
+static void range_infer(void *element, void *user) {
+	GlobalRange *range = element;
+	const GlobalAccess *acc = range->accesses;
+	size_t i = 0;
+	while (i < range->count) {
+		const GlobalAccess *a = &acc[i];
+		ut64 next = i + 1 < range->count ? acc[i + 1].addr : range->end;
+		ut64 extent = RZ_MIN(next, a->bound) - a->addr;
+		if (a->string) {
+			global_candidate_push(range, a->addr, GLOBAL_KIND_STRING, 1, RZ_MIN(a->string, extent));
+			i++;
+			continue;
+		}
+		size_t run = array_run(range, i);
+		if (run >= GLOBAL_MIN_ARRAY_RUN) {
+			global_candidate_push(range, a->addr, GLOBAL_KIND_ARRAY, a->size, run);
+			i += run;
+			continue;
+		}
+		size_t consumed = struct_array_at(range, i);
+		if (consumed) {
+			i += consumed;
+			continue;
+		}
+		if (a->pointer && (!a->size || a->size == range->ptr_size)) {
+			global_candidate_push(range, a->addr, GLOBAL_KIND_POINTER, range->ptr_size, 1);
+		} else if (a->size) {
+			if (a->indexed && extent / a->size >= 2 && extent <= GLOBAL_MAX_EXTENT) {
+				global_candidate_push(range, a->addr, GLOBAL_KIND_ARRAY, a->size, extent / a->size);
+			} else {
+				global_candidate_push(range, a->addr, GLOBAL_KIND_SCALAR, a->size, 1);
+			}
+		} else if (extent <= GLOBAL_MAX_EXTENT) {
+			global_candidate_push(range, a->addr, GLOBAL_KIND_BYTES, 1, extent);
+		}
+		i++;
+	}
+}
+
+static RzType *scalar_type(RzTypeDB *typedb, ut32 size) {
+	const char *name;
+	switch (size) {
+	case 1: name = "uint8_t"; break;
+	case 2: name = "uint16_t"; break;
+	case 4: name = "uint32_t"; break;
+	case 8: name = "uint64_t"; break;
+	default:
+		return rz_type_array_of_base_type_str(typedb, "uint8_t", size);
+	}
+	return rz_type_identifier_of_base_type_str(typedb, name);
+}
+
+static bool struct_member_push(RzTypeDB *typedb, RzBaseType *btype, const char *prefix, ut32 offset, RzType *type) {
+	if (!type) {
+		return false;
+	}
+	RzTypeStructMember member = {
+		.name = rz_str_newf("%s_%" PFMT32x, prefix, offset),
+		.type = type,
+		.offset = offset,
+		.size = rz_type_db_get_bitsize(typedb, type),
+	};
+	if (!member.name || !rz_vector_push(&btype->struct_data.members, &member)) {
+		free(member.name);
+		rz_type_free(type);
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Creates the structure of \p cand, with explicit padding between the fields.
+ */
+static RzType *struct_type(RzTypeDB *typedb, const GlobalCandidate *cand) {
+	char *name = rz_str_newf("gstruct_%" PFMT64x, cand->addr);
+	if (!name || rz_type_db_get_base_type(typedb, name)) {
+		free(name);
+		return NULL;
+	}
+	RzBaseType *btype = rz_type_base_type_new(RZ_BASE_TYPE_KIND_STRUCT);
+	if (!btype) {
+		free(name);
+		return NULL;
+	}
+	btype->name = name;
+	btype->size = (ut64)cand->elem_size * 8;
+	ut32 offset = 0;
+	GlobalField *field;
+	rz_vector_foreach(&cand->fields, field) {
+		if ((field->offset > offset && !struct_member_push(typedb, btype, "pad", offset, rz_type_array_of_base_type_str(typedb, "uint8_t", field->offset - offset))) ||
+			!struct_member_push(typedb, btype, "field", field->offset, scalar_type(typedb, field->size))) {
+			rz_type_base_type_free(btype);
+			return NULL;
+		}
+		offset = field->offset + field->size;
+	}
+	if (offset < cand->elem_size && !struct_member_push(typedb, btype, "pad", offset, rz_type_array_of_base_type_str(typedb, "uint8_t", cand->elem_size - offset))) {
+		rz_type_base_type_free(btype);
+		return NULL;
+	}
+	if (!rz_type_db_save_base_type(typedb, btype)) {
+		rz_type_base_type_free(btype);
+		return NULL;
+	}
+	return rz_type_identifier_of_base_type(typedb, btype, false);
+}
+
+static RzType *candidate_type(RzTypeDB *typedb, const GlobalCandidate *cand) {
+	RzType *elem;
+	switch (cand->kind) {
+	case GLOBAL_KIND_SCALAR:
+		return scalar_type(typedb, cand->elem_size);
+	case GLOBAL_KIND_POINTER:
+		return rz_type_pointer_of_base_type_str(typedb, "void", false);
+	case GLOBAL_KIND_STRING:
+		return rz_type_array_of_base_type_str(typedb, "char", cand->count);
+	case GLOBAL_KIND_BYTES:
+		return rz_type_array_of_base_type_str(typedb, "uint8_t", cand->count);
+	case GLOBAL_KIND_ARRAY:
+		elem = scalar_type(typedb, cand->elem_size);
+		break;
+	case GLOBAL_KIND_STRUCT_ARRAY:
+		elem = struct_type(typedb, cand);
+		break;
+	default:
+		return NULL;
+	}
+	RzType *type = elem ? rz_type_array_of_type(typedb, elem, cand->count) : NULL;
+	if (!type) {
+		rz_type_free(elem);
+	}
+	return type;
+}
+
+static const char *candidate_prefix(const GlobalCandidate *cand) {
+	switch (cand->kind) {
+	case GLOBAL_KIND_STRING:
+		return "gstr";
+	case GLOBAL_KIND_POINTER:
+		return "gptr";
+	case GLOBAL_KIND_ARRAY:
+	case GLOBAL_KIND_STRUCT_ARRAY:
+		return "garr";
+	default:
+		return "gvar";
+	}
+}
+
+static ut64 candidate_size(const GlobalCandidate *cand) {
+	switch (cand->kind) {
+	case GLOBAL_KIND_STRING:
+	case GLOBAL_KIND_BYTES:
+		return cand->count;
+	default:
+		return (ut64)cand->elem_size * cand->count;
+	}
+}
+
+static bool candidate_add(RzAnalysis *analysis, const RzVector /*<ut64>*/ *objects, const GlobalCandidate *cand) {
+	// the whole candidate must fit before the next existing global or function
+	ut64 size = RZ_MAX(candidate_size(cand), 1);
+	if (object_after(objects, cand->addr) - cand->addr < size) {
+		return false;
+	}
+	char *name = rz_str_newf("%s_%" PFMT64x, candidate_prefix(cand), cand->addr);
+	if (!name) {
+		return false;
+	}
+	if (rz_analysis_var_global_get_byname(analysis, name) || rz_analysis_var_global_get_byaddr_in(analysis, cand->addr) ||
+		rz_analysis_get_function_at(analysis, cand->addr)) {
+		free(name);
+		return false;
+	}
+	RzType *type = candidate_type(analysis->typedb, cand);
+	if (!type) {
+		free(name);
+		return false;
+	}
+	// the type is taken by the global, even on failure
+	bool ret = rz_analysis_var_global_create(analysis, name, type, cand->addr);
+	free(name);
+	return ret;
+}
+
+/**
+ * \brief Recovers the global variables referenced by the data xrefs in [\p from, \p to)
+ *
+ * The extent and a basic type of every variable are inferred from the size
+ * of the accesses made by the instructions, the sections, the strings and
+ * the pointers. Equally sized contiguous accesses, or accesses repeating with
+ * a stride, give arrays of scalars and arrays of structures. Addresses already
+ * covered by a global variable or a function, or inside code, are skipped.
+ *
+ * \param analysis RzAnalysis instance, whose xrefs have already been analyzed
+ * \param from Start of the range to look for global variables
+ * \param to End of the range to look for global variables (exclusive)
+ * \param max_threads Maximum number of threads to use, RZ_THREAD_POOL_ALL_CORES for all of them
+ * \return The number of global variables created
+ */
+RZ_API size_t rz_analysis_var_global_recover(RZ_NONNULL RzAnalysis *analysis, ut64 from, ut64 to, size_t max_threads) {
+	rz_return_val_if_fail(analysis, 0);
+	GlobalCollect gc = {
+		.analysis = analysis,
+		.from = from,
+		.to = to,
+		.ptr_size = analysis->bits == 64 ? 8 : (analysis->bits == 16 ? 2 : 4),
+		.by_addr = ht_up_new(NULL, NULL, NULL),
+	};
+	rz_vector_init(&gc.accesses, sizeof(GlobalAccess), NULL, NULL);
+	rz_vector_init(&gc.objects, sizeof(ut64), NULL, NULL);
+	RzVector ranges;
+	rz_vector_init(&ranges, sizeof(GlobalRange), NULL, NULL);
+	RzPVector *jobs = rz_pvector_new(NULL);
+	GlobalRange *range;
+	size_t created = 0;
+	if (!gc.by_addr || !jobs || !objects_load(&gc)) {
+		goto beach;
+	}
+	ht_up_foreach(analysis->ht_xrefs_to, collect_to_cb, &gc);
+	ht_up_free(gc.by_addr);
+	gc.by_addr = NULL;
+	rz_vector_sort(&gc.accesses, access_cmp, false);
+
+	// Split the accesses at section boundaries and large gaps, the object
+	// ending a range may only extend up to the start of the next one
+	const GlobalAccess *acc = gc.accesses.a;
+	size_t count = rz_vector_len(&gc.accesses);
+	size_t start = 0;
+	for (size_t i = 1; i <= count; i++) {
+		if (i < count && acc[i].limit == acc[i - 1].limit && acc[i].addr - acc[i - 1].addr < GLOBAL_RANGE_GAP) {
+			continue;
+		}
+		range = rz_vector_push(&ranges, NULL);
+		if (!range) {
+			goto beach;
+		}
+		range->accesses = acc + start;
+		range->count = i - start;
+		range->end = acc[i - 1].limit;
+		if (i < count && acc[i].addr < range->end) {
+			range->end = acc[i].addr;
+		}
+		range->ptr_size = gc.ptr_size;
+		rz_vector_init(&range->candidates, sizeof(GlobalCandidate), global_candidate_fini, NULL);
+		start = i;
+	}
+	rz_vector_foreach(&ranges, range) {
+		rz_pvector_push(jobs, range);
+	}
+	if (!rz_th_iterate_pvector(jobs, range_infer, max_threads, NULL)) {
+		rz_vector_foreach(&ranges, range) {
+			range_infer(range, NULL);
+		}
+	}
+
+	// The ranges are sorted, so are the candidates within each of them
+	rz_vector_foreach(&ranges, range) {
+		GlobalCandidate *cand;
+		rz_vector_foreach(&range->candidates, cand) {
+			if (candidate_add(analysis, &gc.objects, cand)) {
+				created++;
+			}
+		}
+	}
+
+beach:
+	rz_vector_foreach(&ranges, range) {
+		rz_vector_fini(&range->candidates);
+	}
+	rz_vector_fini(&ranges);
+	rz_pvector_free(jobs);
+	rz_vector_fini(&gc.accesses);
+	rz_vector_fini(&gc.objects);
+	ht_up_free(gc.by_addr);
+	return created;
+}
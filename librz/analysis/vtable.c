@@ -8,6 +8,21 @@
 
 #define VTABLE_BUFF_SIZE 10
 
+typedef struct {
+	ut64 from;
+	ut64 to;
+	ut64 max_to; ///< highest end of this and all the preceding ranges
+	ut32 order; ///< position of the section in the bin section list
+	RzBinSection *section;
+} VTableSection;
+
+typedef struct {
+	ut64 addr;
+	ut64 size;
+	ut8 *data; ///< contents of the section, read in one go on first access
+	bool loaded;
+} VTableBlock;
+
 #define VTABLE_READ_ADDR_FUNC(fname, read_fname, sz) \
 	static bool fname(RzAnalysis *analysis, ut64 addr, ut64 *buf) { \
 		ut8 tmp[sz]; \
@@ -42,6 +57,8 @@ RZ_API bool rz_analysis_vtable_begin(RzAnalysis *analysis, RVTableContext *conte
 	context->analysis = analysis;
 	context->abi = analysis->cpp_abi;
 	context->word_size = (ut8)(analysis->bits / 8);
+	context->sections = NULL;
+	context->blocks = NULL;
 	const bool is_arm = analysis->cur->arch && rz_str_startswith(analysis->cur->arch, "arm");
 	if (is_arm && context->word_size < 4) {
 		context->word_size = 4;
@@ -65,25 +82,14 @@ RZ_API bool rz_analysis_vtable_begin(RzAnalysis *analysis, RVTableContext *conte
 	return true;
 }
 
-static bool vtable_addr_in_text_section(RVTableContext *context, ut64 curAddress) {
-	// section of the curAddress
-	RzBinSection *value = context->analysis->binb.get_vsect_at(context->analysis->binb.bin, curAddress);
-	// If the pointed value lies in .text section
-	return value && strstr(value->name, "text") && (value->perm & 1) != 0;
-}
-
-static bool vtable_is_value_in_text_section(RVTableContext *context, ut64 curAddress, ut64 *value) {
-	// value at the current address
-	ut64 curAddressValue;
-	if (!context->read_addr(context->analysis, curAddress, &curAddressValue)) {
-		return false;
-	}
-	// if the value is in text section
-	bool ret = vtable_addr_in_text_section(context, curAddressValue);
-	if (value) {
-		*value = curAddressValue;
-	}
-	return ret;
+/**
+ * \brief Releases the section tables and the cached section contents of \p context
+ */
+RZ_API void rz_analysis_vtable_end(RVTableContext *context) {
+	rz_vector_free(context->sections);
+	rz_vector_free(context->blocks);
+	context->sections = NULL;
+	context->blocks = NULL;
 }
 
 static bool vtable_section_can_contain_vtables(RzBinSection *section) {
@@ -109,6 +115,195 @@ static bool section_can_contain_rtti(RzBinSection *section) {
 		rz_str_endswith(section->name, "__const");
 }
 
+static void vtable_block_fini(void *e, void *user) {
+	VTableBlock *block = e;
+	free(block->data);
+}
+
+static int vtable_section_cmp(const void *a, const void *b) {
+	const VTableSection *sa = a;
+	const VTableSection *sb = b;
+	if (sa->from != sb->from) {
+		return sa->from < sb->from ? -1 : 1;
+	}
+	return sa->order < sb->order ? -1 : (sa->order > sb->order);
+}
+
+static int vtable_block_cmp(const void *a, const void *b) {
+	const VTableBlock *ba = a;
+	const VTableBlock *bb = b;
+	return ba->addr < bb->addr ? -1 : (ba->addr > bb->addr);
+}
+
+/**
+ * Builds the sorted section table used to classify pointers and the list of
+ * the sections vtables and RTTI are read from, so that they can be read once
+ * in bulk instead of word by word. The ranges are rebased like the ones of
+ * rz_bin_get_section_at(), by the shift of the loaded base address.
+ */
+static bool vtable_index_sections(RVTableContext *context, RzList /*<RzBinSection *>*/ *sections) {
+	if (context->sections) {
+		return true;
+	}
+	context->sections = rz_vector_new(sizeof(VTableSection), NULL, NULL);
+	context->blocks = rz_vector_new(sizeof(VTableBlock), vtable_block_fini, NULL);
+	if (!context->sections || !context->blocks) {
+		rz_analysis_vtable_end(context);
+		return false;
+	}
+	RzBin *bin = context->analysis->binb.bin;
+	RzBinObject *o = bin ? rz_bin_cur_object(bin) : NULL;
+	RzListIter *iter;
+	RzBinSection *section;
+	ut32 order = 0;
+	rz_list_foreach (sections, iter, section) {
+		if (section->is_segment) {
+			continue;
+		}
+		VTableSection *entry = rz_vector_push(context->sections, NULL);
+		if (!entry) {
+			break;
+		}
+		ut64 vaddr = rz_bin_object_addr_with_base(o, section->vaddr);
+		entry->from = vaddr;
+		entry->to = vaddr + section->vsize;
+		entry->order = order++;
+		entry->section = section;
+		if (section->vsize && section->vsize <= ST32_MAX &&
+			(vtable_section_can_contain_vtables(section) || section_can_contain_rtti(section))) {
+			VTableBlock *block = rz_vector_push(context->blocks, NULL);
+			if (block) {
+				block->addr = vaddr;
+				block->size = section->vsize;
+				block->data = NULL;
+				block->loaded = false;
+			}
+		}
+	}
+	rz_vector_sort(context->sections, vtable_section_cmp, false);
+	rz_vector_sort(context->blocks, vtable_block_cmp, false);
+	ut64 max_to = 0;
+	VTableSection *entry;
+	rz_vector_foreach(context->sections, entry) {
+		max_to = RZ_MAX(max_to, entry->to);
+		entry->max_to = max_to;
+	}
+	return true;
+}
+
+/**
+ * \brief Returns the section containing the virtual address \p addr
+ *
+ * The result is the one of RzBinBind.get_vsect_at, including the shift of the
+ * loaded base address. When the section table was built by
+ * rz_analysis_vtable_search() this is a binary search instead of a walk over
+ * all the sections.
+ */
+RZ_API RzBinSection *rz_analysis_vtable_section_at(RVTableContext *context, ut64 addr) {
+	if (!context->sections) {
+		return context->analysis->binb.get_vsect_at(context->analysis->binb.bin, addr);
+	}
+	// find the last range starting at or before addr
+	size_t lo = 0, hi = rz_vector_len(context->sections);
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		VTableSection *entry = rz_vector_index_ptr(context->sections, mid);
+		if (entry->from <= addr) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	// overlapping sections resolve to the first one of the bin section list
+	VTableSection *best = NULL;
+	while (lo > 0) {
+		VTableSection *entry = rz_vector_index_ptr(context->sections, --lo);
+		if (entry->max_to <= addr) {
+			break;
+		}
+		if (addr < entry->to && (!best || entry->order < best->order)) {
+			best = entry;
+		}
+	}
+	return best ? best->section : NULL;
+}
+
+static VTableBlock *vtable_block_at(RVTableContext *context, ut64 addr, ut64 len) {
+	if (!context->blocks) {
+		return NULL;
+	}
+	size_t lo = 0, hi = rz_vector_len(context->blocks);
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		VTableBlock *block = rz_vector_index_ptr(context->blocks, mid);
+		if (block->addr <= addr) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	if (!lo) {
+		return NULL;
+	}
+	VTableBlock *block = rz_vector_index_ptr(context->blocks, lo - 1);
+	if (addr - block->addr > block->size || len > block->size - (addr - block->addr)) {
+		return NULL;
+	}
+	if (!block->loaded) {
+		block->loaded = true;
+		block->data = malloc(block->size);
+		if (block->data && !context->analysis->iob.read_at(context->analysis->iob.io, block->addr, block->data, (int)block->size)) {
+			RZ_FREE(block->data);
+		}
+	}
+	return block->data ? block : NULL;
+}
+
+/**
+ * \brief Reads \p len bytes at \p addr, from the cached section contents when possible
+ */
+RZ_API bool rz_analysis_vtable_read_at(RVTableContext *context, ut64 addr, ut8 *buf, int len) {
+	VTableBlock *block = len > 0 ? vtable_block_at(context, addr, len) : NULL;
+	if (block) {
+		memcpy(buf, block->data + (addr - block->addr), len);
+		return true;
+	}
+	return context->analysis->iob.read_at(context->analysis->iob.io, addr, buf, len);
+}
+
+/**
+ * \brief Reads a pointer-sized word at \p addr, from the cached section contents when possible
+ */
+RZ_API bool rz_analysis_vtable_read_addr(RVTableContext *context, ut64 addr, ut64 *buf) {
+	VTableBlock *block = vtable_block_at(context, addr, context->word_size);
+	if (block) {
+		*buf = rz_read_ble(block->data + (addr - block->addr), context->analysis->big_endian, context->word_size * 8);
+		return true;
+	}
+	return context->read_addr(context->analysis, addr, buf);
+}
+
+static bool vtable_addr_in_text_section(RVTableContext *context, ut64 curAddress) {
+	// section of the curAddress
+	RzBinSection *value = rz_analysis_vtable_section_at(context, curAddress);
+	// If the pointed value lies in .text section
+	return value && strstr(value->name, "text") && (value->perm & 1) != 0;
+}
+
+static bool vtable_is_value_in_text_section(RVTableContext *context, ut64 curAddress, ut64 *value) {
+	// value at the current address
+	ut64 curAddressValue;
+	if (!rz_analysis_vtable_read_addr(context, curAddress, &curAddressValue)) {
+		return false;
+	}
+	// if the value is in text section
+	bool ret = vtable_addr_in_text_section(context, curAddressValue);
+	if (value) {
+		*value = curAddressValue;
+	}
+	return ret;
+}
+
 static bool vtable_is_addr_vtable_start_itanium(RVTableContext *context, RzBinSection *section, ut64 curAddress) {
 	ut64 value;
 	if (!curAddress || curAddress == UT64_MAX) {
@@ -117,14 +312,14 @@ static bool vtable_is_addr_vtable_start_itanium(RVTableContext *context, RzBinSe
 	if (curAddress && !vtable_is_value_in_text_section(context, curAddress, NULL)) { // Vtable beginning referenced from the code
 		return false;
 	}
-	if (!context->read_addr(context->analysis, curAddress - context->word_size, &value)) { // get the RTTI pointer
+	if (!rz_analysis_vtable_read_addr(context, curAddress - context->word_size, &value)) { // get the RTTI pointer
 		return false;
 	}
-	RzBinSection *rtti_section = context->analysis->binb.get_vsect_at(context->analysis->binb.bin, value);
+	RzBinSection *rtti_section = rz_analysis_vtable_section_at(context, value);
 	if (value && !section_can_contain_rtti(rtti_section)) { // RTTI ptr must point somewhere in the data section
 		return false;
 	}
-	if (!context->read_addr(context->analysis, curAddress - 2 * context->word_size, &value)) { // Offset to top
+	if (!rz_analysis_vtable_read_addr(context, curAddress - 2 * context->word_size, &value)) { // Offset to top
 		return false;
 	}
 	if ((st32)value > 0) { // Offset to top has to be negative
@@ -183,7 +378,7 @@ static bool vtable_is_addr_vtable_start(RVTableContext *context, RzBinSection *s
 
 RZ_API RVTableInfo *rz_analysis_vtable_parse_at(RVTableContext *context, ut64 addr) {
 	ut64 offset_to_top;
-	if (!context->read_addr(context->analysis, addr - 2 * context->word_size, &offset_to_top)) {
+	if (!rz_analysis_vtable_read_addr(context, addr - 2 * context->word_size, &offset_to_top)) {
 		return NULL;
 	}
 
@@ -228,7 +423,7 @@ RZ_API RzList /*<RVTableInfo *>*/ *rz_analysis_vtable_search(RVTableContext *con
 	}
 
 	RzList *sections = analysis->binb.get_sections(analysis->binb.bin);
-	if (!sections) {
+	if (!sections || !vtable_index_sections(context, sections)) {
 		rz_list_free(vtables);
 		return NULL;
 	}
@@ -300,6 +495,7 @@ RZ_API void rz_analysis_list_vtables(RzAnalysis *analysis, RzOutputMode mode) {
 		PJ *pj = pj_new();
 		if (!pj) {
 			rz_list_free(vtables);
+			rz_analysis_vtable_end(&context);
 			return;
 		}
 		pj_a(pj);
@@ -352,4 +548,5 @@ RZ_API void rz_analysis_list_vtables(RzAnalysis *analysis, RzOutputMode mode) {
 		}
 	}
 	rz_list_free(vtables);
+	rz_analysis_vtable_end(&context);
 }
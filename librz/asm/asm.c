@@ -787,8 +787,8 @@ RZ_API RzAsmCode *rz_asm_mdisassemble(RzAsm *a, const ut8 *buf, int len) {
 		}
 		rz_strbuf_append(buf_asm, rz_strbuf_get(&op.buf_asm));
 		rz_strbuf_append(buf_asm, "\n");
+		rz_asm_op_fini(&op);
 	}
-	rz_asm_op_fini(&op);
 	acode->assembly = rz_strbuf_drain(buf_asm);
 	acode->len = idx;
 	return acode;
@@ -1599,6 +1599,89 @@ RZ_API RZ_OWN RzAsmTokenString *rz_asm_tokenize_asm_regex(RZ_BORROW RzStrBuf *as
 	return toks;
 }
 
+static bool operand_uses_register(const RzAsmOperand *op, const char *name) {
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(op->regs); i++) {
+		if (op->regs[i] && !strcmp(op->regs[i], name)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * \brief Returns the index of the first operand using the register \p name or -1.
+ */
+static int operand_register_index(RZ_NULLABLE const RzAsmOperand *operands, size_t n_operands, const char *name) {
+	for (size_t i = 0; operands && i < n_operands; i++) {
+		if (operand_uses_register(operands + i, name)) {
+			return (int)i;
+		}
+	}
+	return -1;
+}
+
+static int operand_value_index(const RzAsmOperand *operands, size_t n_operands, ut64 value) {
+	for (size_t i = 0; i < n_operands; i++) {
+		if (operands[i].has_value && (operands[i].value == value || operands[i].value == -value)) {
+			return (int)i;
+		}
+	}
+	return -1;
+}
+
+/**
+ * \brief Links the register and number tokens to the decoded \p operands.
+ *
+ * The operand a token is part of is known from the top level commas of the asm string.
+ * If that operand doesn't contain the register or has no value, the first operand
+ * which does is taken. E.g. the AT&T syntax lists the operands in another order.
+ */
+static void annotate_operands(RZ_INOUT RzAsmTokenString *toks, RZ_NONNULL const RzAsmOperand *operands, size_t n_operands) {
+	const char *str = rz_strbuf_get(toks->str);
+	size_t cur = 0;
+	int depth = 0;
+	RzAsmToken *tok;
+	rz_vector_foreach(toks->tokens, tok) {
+		int idx = -1;
+		switch (tok->type) {
+		case RZ_ASM_TOKEN_SEPARATOR:
+		case RZ_ASM_TOKEN_OPERATOR:
+			for (size_t i = tok->start; i < tok->start + tok->len; i++) {
+				if (str[i] == '[' || str[i] == '(' || str[i] == '{') {
+					depth++;
+				} else if (str[i] == ']' || str[i] == ')' || str[i] == '}') {
+					depth--;
+				} else if (str[i] == ',' && depth <= 0) {
+					cur++;
+				}
+			}
+			break;
+		case RZ_ASM_TOKEN_REGISTER: {
+			char *name = rz_str_ndup(str + tok->start, tok->len);
+			if (!name) {
+				break;
+			}
+			idx = cur < n_operands && operand_uses_register(operands + cur, name)
+				? (int)cur
+				: operand_register_index(operands, n_operands, name);
+			free(name);
+			break;
+		}
+		case RZ_ASM_TOKEN_NUMBER:
+			idx = cur < n_operands && operands[cur].has_value
+				? (int)cur
+				: operand_value_index(operands, n_operands, tok->val.number);
+			break;
+		default:
+			break;
+		}
+		if (idx >= 0) {
+			tok->operand = idx + 1;
+			tok->operand_type = operands[idx].type;
+		}
+	}
+}
+
 /**
  * \brief Seeks from \p str + \p i for a token of the given \p type.
  * If any was found it returns the length of it. Or 0 if non was found.
@@ -1657,9 +1740,12 @@ static size_t seek_to_end_of_token(const char *str, size_t i, RzAsmTokenType typ
  *
  * \param asm_str The asm string.
  * \param param Several parameter which alter the parsing.
+ * \param operands The decoded operands of the instruction, if known.
+ * \param n_operands Number of \p operands.
  * \return RzAsmTokenString* The asm tokens.
  */
-static RZ_OWN RzAsmTokenString *tokenize_asm_generic(RZ_BORROW RzStrBuf *asm_str, RZ_NULLABLE const RzAsmParseParam *param) {
+static RZ_OWN RzAsmTokenString *tokenize_asm_generic(RZ_BORROW RzStrBuf *asm_str, RZ_NULLABLE const RzAsmParseParam *param,
+	RZ_NULLABLE const RzAsmOperand *operands, size_t n_operands) {
 	rz_return_val_if_fail(asm_str, NULL);
 	if (rz_strbuf_is_empty(asm_str)) {
 		return NULL;
@@ -1758,7 +1844,7 @@ static RZ_OWN RzAsmTokenString *tokenize_asm_generic(RZ_BORROW RzStrBuf *asm_str
 			} else if (mnemonic_parsed) {
 				l = seek_to_end_of_token(str, i, RZ_ASM_TOKEN_REGISTER);
 				char *op_name = rz_str_ndup(str + i, l);
-				if (param && is_register(op_name, param->reg_sets)) {
+				if ((param && is_register(op_name, param->reg_sets)) || operand_register_index(operands, n_operands, op_name) >= 0) {
 					add_token(toks, i, l, RZ_ASM_TOKEN_REGISTER, 0);
 				} else if (prefix_less_hex) {
 					// It wasn't a register but still could be a prefixless hex number.
@@ -1792,6 +1878,9 @@ static RZ_OWN RzAsmTokenString *tokenize_asm_generic(RZ_BORROW RzStrBuf *asm_str
 		}
 		i = i + l;
 	}
+	if (operands) {
+		annotate_operands(toks, operands, n_operands);
+	}
 	return toks;
 }
 
@@ -1807,12 +1896,30 @@ static RZ_OWN RzAsmTokenString *tokenize_asm_generic(RZ_BORROW RzStrBuf *asm_str
 RZ_DEPRECATE RZ_API RZ_OWN RzAsmTokenString *rz_asm_tokenize_asm_string(RZ_BORROW RzStrBuf *asm_str, RZ_NULLABLE const RzAsmParseParam *param) {
 	rz_return_val_if_fail(asm_str, NULL);
 
-	return tokenize_asm_generic(asm_str, param);
+	return tokenize_asm_generic(asm_str, param, NULL, 0);
 }
 
 /**
- * \brief Colors a given asm string and returns it. If \p toks is not NULL it uses the tokens to color the asm string accordingly.
- * If \p toks is NULL it parses the asm string generically into tokens and colorizes it afterwards.
+ * \brief Tokenizes the asm string of an instruction with the help of its decoded operands.
+ *
+ * The string is split the same way the generic tokenizer does it, but the words are
+ * classified as registers and the tokens are linked to their operands by what the
+ * disassembler decoded. So the consumers (coloring, flag substitution etc.) neither
+ * need a register profile nor have to parse the text again.
+ *
+ * \param asm_str The asm string as it will be shown.
+ * \param operands The decoded operands in the order of the asm string.
+ * \param count Number of \p operands.
+ * \return RzAsmTokenString* The asm tokens or NULL on failure.
+ */
+RZ_API RZ_OWN RzAsmTokenString *rz_asm_tokenize_asm_operands(RZ_BORROW RzStrBuf *asm_str, RZ_BORROW RZ_NULLABLE const RzAsmOperand *operands, size_t count) {
+	rz_return_val_if_fail(asm_str && (operands || !count), NULL);
+	return tokenize_asm_generic(asm_str, NULL, operands, count);
+}
+
+/**
+ * \brief Colors a given asm string and returns it. If \p toks is not NULL and was made for \p asm_str it uses the tokens to color
+ * the asm string accordingly. Otherwise it parses the asm string generically into tokens and colorizes it afterwards.
  * \p param can be set to alter the generic parsing method.
  *
  * DEPRECATED: This is only a helper method until all plugins set RzAsmOp.asm_toks.
@@ -1829,7 +1936,18 @@ RZ_DEPRECATE RZ_API RZ_OWN RzAsmTokenString *rz_asm_tokenize_asm_string(RZ_BORRO
 RZ_DEPRECATE RZ_API RZ_OWN RzStrBuf *
 rz_asm_colorize_asm_str(RZ_BORROW RzStrBuf *asm_str, RZ_BORROW RzPrint *p, RZ_NULLABLE const RzAsmParseParam *param, RZ_NULLABLE const RzAsmTokenString *toks) {
 	RzStrBuf *colored_asm;
+	if (toks && strcmp(rz_strbuf_get(toks->str), rz_strbuf_get(asm_str))) {
+		// The asm string was changed after disassembling (variable names, pseudo code...),
+		// so the tokens don't describe it anymore.
+		toks = NULL;
+	}
 	if (toks) {
+		if (!toks->op_type && param) {
+			// The asm plugins don't always know the analysis op type
+			RzAsmTokenString typed = *toks;
+			typed.op_type = param->ana_op_type;
+			return rz_print_colorize_asm_str(p, &typed);
+		}
 		colored_asm = rz_print_colorize_asm_str(p, toks);
 	} else {
 		RzAsmTokenString *ts = rz_asm_tokenize_asm_string(asm_str, param);
@@ -93,6 +93,81 @@ static bool check_features(RzAsm *a, cs_insn *insn) {
 	return true;
 }
 
+static const char *reg_name(csh cd, unsigned int reg) {
+	return reg ? cs_reg_name(cd, reg) : NULL;
+}
+
+/**
+ * Tokenizes the asm string with the operands decoded by capstone,
+ * so nobody has to guess the registers and numbers from the text later.
+ */
+static void set_asm_tokens(csh cd, RzAsmOp *op, cs_insn *insn, bool is64) {
+	if (!insn->detail) {
+		return;
+	}
+	RzAsmOperand operands[8] = { 0 };
+	size_t count = 0;
+	if (is64) {
+		cs_arm64 *arm64 = &insn->detail->arm64;
+		count = RZ_MIN(arm64->op_count, RZ_ARRAY_SIZE(operands));
+		for (size_t i = 0; i < count; i++) {
+			cs_arm64_op *xop = &arm64->operands[i];
+			RzAsmOperand *aop = &operands[i];
+			switch (xop->type) {
+			case ARM64_OP_REG:
+				aop->type = RZ_ASM_OPERAND_REG;
+				aop->regs[0] = reg_name(cd, xop->reg);
+				break;
+			case ARM64_OP_IMM:
+			case ARM64_OP_CIMM:
+				aop->type = RZ_ASM_OPERAND_IMM;
+				aop->has_value = true;
+				aop->value = xop->imm;
+				break;
+			case ARM64_OP_MEM:
+				aop->type = RZ_ASM_OPERAND_MEM;
+				aop->regs[0] = reg_name(cd, xop->mem.base);
+				aop->regs[1] = reg_name(cd, xop->mem.index);
+				aop->has_value = true;
+				aop->value = xop->mem.disp;
+				break;
+			default:
+				break;
+			}
+		}
+	} else {
+		cs_arm *arm = &insn->detail->arm;
+		count = RZ_MIN(arm->op_count, RZ_ARRAY_SIZE(operands));
+		for (size_t i = 0; i < count; i++) {
+			cs_arm_op *xop = &arm->operands[i];
+			RzAsmOperand *aop = &operands[i];
+			switch (xop->type) {
+			case ARM_OP_REG:
+				aop->type = RZ_ASM_OPERAND_REG;
+				aop->regs[0] = reg_name(cd, xop->reg);
+				break;
+			case ARM_OP_IMM:
+			case ARM_OP_CIMM:
+			case ARM_OP_PIMM:
+				aop->type = RZ_ASM_OPERAND_IMM;
+				aop->has_value = true;
+				aop->value = (ut32)xop->imm;
+				break;
+			case ARM_OP_MEM:
+				aop->type = RZ_ASM_OPERAND_MEM;
+				aop->regs[0] = reg_name(cd, xop->mem.base);
+				aop->regs[1] = reg_name(cd, xop->mem.index);
+				aop->has_value = true;
+				aop->value = (st64)xop->mem.disp;
+				break;
+			default:
+				break;
+			}
+		}
+	}
+	op->asm_toks = rz_asm_tokenize_asm_operands(&op->buf_asm, operands, count);
+}
+
 static int disassemble(RzAsm *a, RzAsmOp *op, const ut8 *buf, int len) {
 	ArmCSContext *ctx = (ArmCSContext *)a->plugin_data;
 
@@ -104,13 +179,6 @@ static int disassemble(RzAsm *a, RzAsmOp *op, const ut8 *buf, int len) {
 	bool thumb = a->bits == 16;
 	mode |= thumb ? CS_MODE_THUMB : CS_MODE_ARM;
 	mode |= (a->big_endian) ? CS_MODE_BIG_ENDIAN : CS_MODE_LITTLE_ENDIAN;
-	if (mode != ctx->omode || a->bits != ctx->obits) {
-		cs_close(&ctx->cd);
-		ctx->cd = 0; // unnecessary
-		ctx->omode = mode;
-		ctx->obits = a->bits;
-	}
-
 	if (a->cpu) {
 		if (strstr(a->cpu, "cortexm") || strstr(a->cpu, "cortex-m")) {
 			mode |= CS_MODE_MCLASS;
@@ -130,12 +198,27 @@ static int disassemble(RzAsm *a, RzAsmOp *op, const ut8 *buf, int len) {
 		op->size = 4;
 		rz_strbuf_set(&op->buf_asm, "");
 	}
-	if (!ctx->cd || mode != ctx->omode) {
+	if (ctx->cd && (a->bits == 64) != (ctx->obits == 64)) {
+		// a different architecture needs a new handle
+		cs_close(&ctx->cd);
+		ctx->cd = 0;
+	}
+	if (!ctx->cd) {
 		ret = (a->bits == 64) ? cs_open(CS_ARCH_ARM64, mode, &ctx->cd) : cs_open(CS_ARCH_ARM, mode, &ctx->cd);
 		if (ret) {
 			ret = -1;
 			goto beach;
 		}
+		ctx->omode = mode;
+		ctx->obits = a->bits;
+	} else if (mode != ctx->omode) {
+		// switching between ARM and Thumb is only an option of the same handle
+		if (cs_option(ctx->cd, CS_OPT_MODE, mode) != CS_ERR_OK) {
+			cs_close(&ctx->cd);
+			ctx->cd = 0;
+		}
+		ctx->omode = mode;
+		ctx->obits = a->bits;
 	}
 	cs_option(ctx->cd, CS_OPT_SYNTAX, (a->syntax == RZ_ASM_SYNTAX_REGNUM) ? CS_OPT_SYNTAX_NOREGNAME : CS_OPT_SYNTAX_DEFAULT);
 #if CS_NEXT_VERSION >= 6
@@ -191,6 +274,7 @@ static int disassemble(RzAsm *a, RzAsmOp *op, const ut8 *buf, int len) {
 			rz_str_replace_char(buf_asm, '#', 0);
 		}
 		rz_strbuf_set(&op->buf_asm, buf_asm);
+		set_asm_tokens(ctx->cd, op, insn, a->bits == 64);
 	}
 	cs_free(insn, n);
 beach:
@@ -8,6 +8,7 @@
 RZ_IPI int mips_assemble(const char *str, ut64 pc, ut8 *out);
 
 static csh cd = 0;
+static int omode = 0;
 #include "cs_mnemonics.c"
 
 static int disassemble(RzAsm *a, RzAsmOp *op, const ut8 *buf, int len) {
@@ -31,12 +32,19 @@ static int disassemble(RzAsm *a, RzAsmOp *op, const ut8 *buf, int len) {
 	mode |= (a->bits == 64) ? CS_MODE_MIPS64 : CS_MODE_MIPS32;
 	memset(op, 0, sizeof(RzAsmOp));
 	op->size = 4;
-	if (cd != 0) {
-		cs_close(&cd);
+	if (cd && mode != omode) {
+		if (cs_option(cd, CS_OPT_MODE, mode) != CS_ERR_OK) {
+			cs_close(&cd);
+			cd = 0;
+		}
+		omode = mode;
 	}
-	ret = cs_open(CS_ARCH_MIPS, mode, &cd);
-	if (ret) {
-		goto fin;
+	if (!cd) {
+		ret = cs_open(CS_ARCH_MIPS, mode, &cd);
+		if (ret) {
+			goto fin;
+		}
+		omode = mode;
 	}
 	if (a->syntax == RZ_ASM_SYNTAX_REGNUM) {
 		cs_option(cd, CS_OPT_SYNTAX, CS_OPT_SYNTAX_NOREGNAME);
@@ -22,6 +22,49 @@ static int check_features(RzAsm *a, cs_insn *insn);
 
 #include "asm_x86_vm.c"
 
+static const char *reg_name(x86_reg reg) {
+	return reg != X86_REG_INVALID ? cs_reg_name(cd, reg) : NULL;
+}
+
+/**
+ * Tokenizes the asm string with the operands decoded by capstone,
+ * so nobody has to guess the registers and numbers from the text later.
+ */
+static void set_asm_tokens(RzAsmOp *op, cs_insn *insn) {
+	if (!insn->detail) {
+		return;
+	}
+	cs_x86 *x86 = &insn->detail->x86;
+	RzAsmOperand operands[RZ_ARRAY_SIZE(x86->operands)] = { 0 };
+	size_t count = RZ_MIN(x86->op_count, RZ_ARRAY_SIZE(operands));
+	for (size_t i = 0; i < count; i++) {
+		cs_x86_op *xop = &x86->operands[i];
+		RzAsmOperand *aop = &operands[i];
+		switch (xop->type) {
+		case X86_OP_REG:
+			aop->type = RZ_ASM_OPERAND_REG;
+			aop->regs[0] = reg_name(xop->reg);
+			break;
+		case X86_OP_IMM:
+			aop->type = RZ_ASM_OPERAND_IMM;
+			aop->has_value = true;
+			aop->value = xop->imm;
+			break;
+		case X86_OP_MEM:
+			aop->type = RZ_ASM_OPERAND_MEM;
+			aop->regs[0] = reg_name(xop->mem.segment);
+			aop->regs[1] = reg_name(xop->mem.base);
+			aop->regs[2] = reg_name(xop->mem.index);
+			aop->has_value = true;
+			aop->value = xop->mem.disp;
+			break;
+		default:
+			break;
+		}
+	}
+	op->asm_toks = rz_asm_tokenize_asm_operands(&op->buf_asm, operands, count);
+}
+
 static int disassemble(RzAsm *a, RzAsmOp *op, const ut8 *buf, int len) {
 	static int omode = 0;
 	int mode, ret;
@@ -31,8 +74,11 @@ static int disassemble(RzAsm *a, RzAsmOp *op, const ut8 *buf, int len) {
 		: (a->bits == 16)                             ? CS_MODE_16
 							      : 0;
 	if (cd && mode != omode) {
-		cs_close(&cd);
-		cd = 0;
+		// switching between 16, 32 and 64 bits is only an option of the same handle
+		if (cs_option(cd, CS_OPT_MODE, mode) != CS_ERR_OK) {
+			cs_close(&cd);
+			cd = 0;
+		}
 	}
 	if (op) {
 		op->size = 0;
@@ -75,7 +121,9 @@ static int disassemble(RzAsm *a, RzAsmOp *op, const ut8 *buf, int len) {
 			rz_asm_op_set_asm(op, "illegal");
 		}
 	}
+	bool decoded = false;
 	if (op->size == 0 && n > 0 && insn->size > 0) {
+		decoded = true;
 		char *ptrstr;
 		op->size = insn->size;
 		char *buf_asm = rz_str_newf("%s%s%s",
@@ -110,6 +158,9 @@ static int disassemble(RzAsm *a, RzAsmOp *op, const ut8 *buf, int len) {
 			memcpy(buf_asm, "jnz", 3);
 		}
 	}
+	if (decoded) {
+		set_asm_tokens(op, insn);
+	}
 	if (insn) {
 		cs_free(insn, n);
 	}
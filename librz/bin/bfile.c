@@ -516,6 +516,32 @@ RZ_API RZ_OWN RzPVector /*<RzBinTrycatch *>*/ *rz_bin_file_get_trycatch(RZ_NONNU
 	return NULL;
 }
 
+/**
+ * \brief Get the function ranges and stack layouts from the unwind tables of \p bf
+ *
+ * The addresses are rebased like the ones of symbols.
+ */
+RZ_API RZ_OWN RzPVector /*<RzBinUnwindFunction *>*/ *rz_bin_file_get_unwind_functions(RZ_NONNULL RzBinFile *bf) {
+	rz_return_val_if_fail(bf && bf->o && bf->o->plugin, NULL);
+	if (!bf->o->plugin->unwind_functions) {
+		return NULL;
+	}
+	RzPVector *fcns = bf->o->plugin->unwind_functions(bf);
+	if (!fcns || !bf->o->baddr_shift) {
+		return fcns;
+	}
+	void **it;
+	rz_pvector_foreach (fcns, it) {
+		RzBinUnwindFunction *fcn = *it;
+		fcn->vaddr += bf->o->baddr_shift;
+		RzBinUnwindRow *row;
+		rz_vector_foreach(&fcn->rows, row) {
+			row->vaddr += bf->o->baddr_shift;
+		}
+	}
+	return fcns;
+}
+
 RZ_API RzList /*<RzBinSymbol *>*/ *rz_bin_file_get_symbols(RzBinFile *bf) {
 	rz_return_val_if_fail(bf, NULL);
 	RzBinObject *o = bf->o;
@@ -49,6 +49,14 @@ RZ_API void rz_bin_mem_free(RZ_NULLABLE void *data) {
 	free(mem);
 }
 
+RZ_API void rz_bin_thread_free(RZ_NULLABLE RzBinThread *thread) {
+	if (!thread) {
+		return;
+	}
+	free(thread->regstate);
+	free(thread);
+}
+
 /// size of the reloc (where it is supposed to be patched) in bits
 RZ_API ut64 rz_bin_reloc_size(RzBinReloc *reloc) {
 	switch (reloc->type) {
@@ -184,6 +192,7 @@ RZ_IPI void rz_bin_object_free(RzBinObject *o) {
 		return;
 	}
 	free(o->regstate);
+	rz_pvector_free(o->threads);
 	ht_pp_free(o->glue_to_class_field);
 	ht_pp_free(o->glue_to_class_method);
 	ht_pp_free(o->name_to_class_object);
@@ -488,6 +497,7 @@ RZ_IPI RzBinObject *rz_bin_object_new(RzBinFile *bf, RzBinPlugin *plugin, RzBinO
 	o->obj_size = (bytes_sz >= sz + offset) ? sz : 0;
 	o->boffset = offset;
 	o->regstate = NULL;
+	o->threads = NULL;
 	o->baddr_shift = 0;
 	o->plugin = plugin;
 
@@ -761,6 +771,14 @@ RZ_API RZ_BORROW const RzPVector /*<RzBinMem *>*/ *rz_bin_object_get_mem(RZ_NONN
 	return obj->mem;
 }
 
+/**
+ * \brief Get list of \p RzBinThread holding the register state of every thread of a core file.
+ */
+RZ_API RZ_BORROW const RzPVector /*<RzBinThread *>*/ *rz_bin_object_get_threads(RZ_NONNULL RzBinObject *obj) {
+	rz_return_val_if_fail(obj, NULL);
+	return obj->threads;
+}
+
 /**
  * \brief Get list of \p RzBinSymbol representing the symbols in the binary object.
  */
@@ -27,6 +27,11 @@ RZ_IPI void rz_bin_set_and_process_file(RzBinFile *bf, RzBinObject *o) {
 		o->regstate = NULL;
 	}
 
+	rz_pvector_free(o->threads);
+	if (!o->regstate || !plugin->threads || !(o->threads = plugin->threads(bf))) {
+		o->threads = NULL;
+	}
+
 	// set the virtual files.
 	rz_list_free(o->vfiles);
 	if (!plugin->virtual_files || !(o->vfiles = plugin->virtual_files(bf))) {
@@ -52,7 +52,7 @@ static void dmp64_memory_run_endian_to_host(dmp_p_memory_run *run) {
 }
 
 static int rz_bin_dmp64_init_memory_runs(struct rz_bin_dmp64_obj_t *obj) {
-	int i, j;
+	ut64 i;
 	dmp64_p_memory_desc *mem_desc = &obj->header->PhysicalMemoryBlock;
 	if (!memcmp(mem_desc, DMP_UNUSED_MAGIC, 4)) {
 		RZ_LOG_ERROR("Invalid PhysicalMemoryDescriptor magic\n");
@@ -63,7 +63,7 @@ static int rz_bin_dmp64_init_memory_runs(struct rz_bin_dmp64_obj_t *obj) {
 		RZ_LOG_ERROR("Invalid PhysicalMemoryDescriptor offset\n");
 		return false;
 	}
-	obj->pages = rz_list_newf(free);
+	obj->pages = rz_vector_new(sizeof(dmp_page_desc), NULL, NULL);
 	if (!obj->pages) {
 		return false;
 	}
@@ -75,22 +75,36 @@ static int rz_bin_dmp64_init_memory_runs(struct rz_bin_dmp64_obj_t *obj) {
 		return false;
 	};
 
+	// pages of all runs are stored back to back, so physically contiguous runs are merged
 	ut64 num_page = 0;
 	ut64 base = sizeof(dmp64_header);
+	dmp_page_desc *page = NULL;
 	for (i = 0; i < num_runs; i++) {
 		dmp_p_memory_run *run = &runs[i];
 		dmp64_memory_run_endian_to_host(run);
-		for (j = 0; j < run->PageCount; j++) {
-			dmp_page_desc *page = RZ_NEW0(dmp_page_desc);
+		if (!run->PageCount) {
+			continue;
+		}
+		if (UT64_MUL_OVFCHK(run->BasePage, DMP_PAGE_SIZE) || UT64_MUL_OVFCHK(run->PageCount, DMP_PAGE_SIZE) ||
+			UT64_ADD_OVFCHK(num_page, run->PageCount)) {
+			RZ_LOG_WARN("Invalid memory run at page 0x%" PFMT64x ".\n", run->BasePage);
+			break;
+		}
+		ut64 start = run->BasePage * DMP_PAGE_SIZE;
+		ut64 size = run->PageCount * DMP_PAGE_SIZE;
+		if (page && page->start + page->size == start) {
+			page->size += size;
+		} else {
+			page = rz_vector_push(obj->pages, NULL);
 			if (!page) {
 				free(runs);
 				return false;
 			}
-			page->start = (run->BasePage + j) * DMP_PAGE_SIZE;
+			page->start = start;
 			page->file_offset = base + num_page * DMP_PAGE_SIZE;
-			rz_list_append(obj->pages, page);
-			num_page++;
+			page->size = size;
 		}
+		num_page += run->PageCount;
 	}
 	if (mem_desc->NumberOfPages != num_page) {
 		RZ_LOG_WARN("The number of pages in the structure does not match with the counted one.\n");
@@ -268,53 +282,56 @@ static int rz_bin_dmp64_init_bmp_pages(struct rz_bin_dmp64_obj_t *obj) {
 	if (!obj->bmp_header) {
 		return false;
 	}
-	obj->pages = rz_list_newf(free);
+	obj->pages = rz_vector_new(sizeof(dmp_page_desc), NULL, NULL);
 	if (!obj->pages) {
 		return false;
 	}
 	ut64 paddr_base = obj->bmp_header->FirstPage;
-	ut64 num_pages = obj->bmp_header->Pages;
-	RzBitVector *bitmap = rz_bv_new(num_pages);
-	rz_bv_set_from_bytes_le(bitmap, obj->bitmap, 0, num_pages);
+	// only whole bytes of the bitmap are read from the file
+	ut64 num_pages = (obj->bmp_header->Pages / 8) * 8;
+	const ut8 *bitmap = obj->bitmap;
 
 	ut64 num_bitset = 0;
-	bool create_new_page = true;
-	dmp_page_desc *page;
-	for (ut64 i = 0; i < num_pages; i++) {
-		if (!rz_bv_get(bitmap, i)) {
-			create_new_page = true;
-			continue;
+	dmp_page_desc *page = NULL;
+	for (ut64 i = 0; i < num_pages;) {
+		// runs of present or absent pages are consumed a byte of the bitmap at a time
+		ut8 byte = bitmap[i >> 3];
+		ut64 step = 1;
+		bool present;
+		if (!(i & 7) && (byte == 0x00 || byte == 0xff)) {
+			step = 8;
+			present = byte;
+		} else {
+			present = (byte >> (i & 7)) & 1;
 		}
-		if (!create_new_page) {
-			page->size += DMP_PAGE_SIZE;
-			num_bitset++;
+		if (!present) {
+			page = NULL;
+			i += step;
 			continue;
 		}
-		page = RZ_NEW0(dmp_page_desc);
-		if (!page) {
-			rz_bv_free(bitmap);
-			return false;
-		}
-		if (UT64_MUL_OVFCHK(i, DMP_PAGE_SIZE)) {
-			free(page);
-			break;
+		if (page) {
+			page->size += step * DMP_PAGE_SIZE;
+		} else {
+			if (UT64_MUL_OVFCHK(i, DMP_PAGE_SIZE)) {
+				break;
+			}
+			page = rz_vector_push(obj->pages, NULL);
+			if (!page) {
+				return false;
+			}
+			page->start = i * DMP_PAGE_SIZE;
+			page->file_offset = paddr_base + num_bitset * DMP_PAGE_SIZE;
+			page->size = step * DMP_PAGE_SIZE;
 		}
-		page->start = i * DMP_PAGE_SIZE;
-		page->file_offset = paddr_base + num_bitset * DMP_PAGE_SIZE;
-		page->size = DMP_PAGE_SIZE;
-		rz_list_append(obj->pages, page);
-		num_bitset++;
-		create_new_page = false;
+		num_bitset += step;
+		i += step;
 	}
 	if (obj->bmp_header->TotalPresentPages != num_bitset) {
 		RZ_LOG_ERROR("The total present pages number (%" PFMT64u ") in the header "
 			     "does not match with the counted one (%" PFMT64u ").\n",
 			obj->bmp_header->TotalPresentPages, num_bitset);
-		rz_bv_free(bitmap);
 		return false;
 	}
-
-	rz_bv_free(bitmap);
 	return true;
 }
 
@@ -339,6 +356,9 @@ static int rz_bin_dmp64_init_bmp_header(struct rz_bin_dmp64_obj_t *obj) {
 
 	ut64 bitmapsize = obj->bmp_header->Pages / 8;
 	obj->bitmap = calloc(1, bitmapsize);
+	if (!obj->bitmap) {
+		return false;
+	}
 	if (rz_buf_read_at(obj->b, sizeof(dmp64_header) + rz_offsetof(dmp_bmp_header, Bitmap), obj->bitmap, bitmapsize) < 0) {
 		RZ_LOG_ERROR("Cannot read bitmap\n");
 		return false;
@@ -391,7 +411,7 @@ void rz_bin_dmp64_free(struct rz_bin_dmp64_obj_t *obj) {
 	free(obj->triage64_header);
 	free(obj->runs);
 	free(obj->bitmap);
-	rz_list_free(obj->pages);
+	rz_vector_free(obj->pages);
 	free(obj);
 }
 
@@ -29,7 +29,7 @@ struct rz_bin_dmp64_obj_t {
 	dmp_p_memory_run *runs;
 	ut8 *bitmap;
 	ut64 dtb;
-	RzList /*<dmp_page_desc *>*/ *pages;
+	RzVector /*<dmp_page_desc>*/ *pages; // coalesced ranges of present pages
 	RzList /*<dmp64_triage_datablock *>*/ *datablocks;
 	RzList /*<dmp_driver_desc *>*/ *drivers;
 
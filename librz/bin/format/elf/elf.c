@@ -326,6 +326,7 @@ static bool init(ELFOBJ *bin, RzBinObjectLoadOptions *options) {
 	bin->reloc_targets_map_base = Elf_(rz_bin_elf_get_targets_map_base)(bin);
 
 	bin->notes = Elf_(rz_bin_elf_notes_new)(bin);
+	Elf_(rz_bin_elf_notes_index)(bin);
 
 	bin->symbols = Elf_(rz_bin_elf_symbols_new)(bin);
 	bin->bits = Elf_(rz_bin_elf_get_bits)(bin);
@@ -381,6 +382,7 @@ void Elf_(rz_bin_elf_free)(RZ_NONNULL ELFOBJ *bin) {
 
 	rz_vector_free(bin->relocs);
 
+	Elf_(rz_bin_elf_notes_index_fini)(bin);
 	rz_vector_free(bin->notes);
 
 	rz_vector_free(bin->symbols);
@@ -107,6 +107,9 @@ typedef struct prstatus_layout_t {
 	 */
 	ut64 sp_offset;
 
+	/// Offset of pr_pid, the thread id, inside the actual data of an NT_PRSTATUS note
+	ut64 pid_offset;
+
 	// These NT_PRSTATUS notes hold much more than this, but it's not needed for us yet.
 	// If necessary, new members can be introduced here.
 } RzBinElfPrStatusLayout;
@@ -166,6 +169,7 @@ RzBinElfNoteFile;
 
 /// Parsed PT_NOTE of type NT_PRSTATUS
 typedef struct rz_bin_elf_note_prstatus_t {
+	ut32 pid; ///< id of the thread
 	size_t regstate_size;
 	ut8 *regstate;
 	// Hint: there is more info in NT_PRSTATUS notes that could be parsed if needed.
@@ -213,6 +217,8 @@ struct Elf_(rz_bin_elf_obj_t) {
 
 	// This is RzVector of note segment reprensented as RzVector<RzBinElfNote>
 	RzVector /*<RzVector<RzBinElfNote>>*/ *notes; // RzVector<RzVector<RzBinElfNote>>
+	RzPVector /*<RzBinElfNotePrStatus *>*/ *threads; // NT_PRSTATUS of every thread, in note order
+	HtUP /*<ut64, RzBinElfNoteFile *>*/ *note_files; // NT_FILE entries by start address
 
 	RzVector /*<RzBinElfSymbol>*/ *symbols; // RzVector<RzBinElfSymbol>
 	RzVector /*<RzBinElfSymbol>*/ *imports; // RzVector<RzBinElfSymbol>
@@ -236,6 +242,8 @@ void Elf_(rz_bin_elf_fix_arm_thumb_symbol)(RZ_NONNULL RzBinSymbol *symbol);
 
 // elf_corefile.c
 ut64 Elf_(rz_bin_elf_get_sp_val)(RZ_NONNULL ELFOBJ *bin);
+ut64 Elf_(rz_bin_elf_get_thread_sp_val)(RZ_NONNULL ELFOBJ *bin, RZ_NONNULL RzBinElfNotePrStatus *thread);
+RZ_BORROW RzBinElfNoteFile *Elf_(rz_bin_elf_get_note_file)(RZ_NONNULL ELFOBJ *bin, ut64 vaddr);
 
 // elf_dynamic.c
 RZ_BORROW RzVector /*<ut64>*/ *Elf_(rz_bin_elf_get_dt_needed)(RZ_NONNULL ELFOBJ *bin);
@@ -311,6 +319,8 @@ ut64 Elf_(rz_bin_elf_get_main_offset)(RZ_NONNULL ELFOBJ *bin);
 RZ_BORROW RzBinElfPrStatusLayout *Elf_(rz_bin_elf_get_prstatus_layout)(RZ_NONNULL ELFOBJ *bin);
 RZ_OWN RzVector /*<RzVector<RzBinElfNote>>*/ *Elf_(rz_bin_elf_notes_new)(RZ_NONNULL ELFOBJ *bin);
 bool Elf_(rz_bin_elf_has_notes)(RZ_NONNULL ELFOBJ *bin);
+bool Elf_(rz_bin_elf_notes_index)(RZ_NONNULL ELFOBJ *bin);
+void Elf_(rz_bin_elf_notes_index_fini)(RZ_NONNULL ELFOBJ *bin);
 
 // elf_misc.c
 bool Elf_(rz_bin_elf_check_array)(RZ_NONNULL ELFOBJ *bin, Elf_(Off) offset, Elf_(Off) length, Elf_(Off) entry_size);
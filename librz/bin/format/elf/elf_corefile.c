@@ -9,34 +9,49 @@
 /**
  * \brief Get the stack pointer value
  * \param elf binary
- * \return allocated string
+ * \return stack pointer of the first thread
  *
  * Get the value of the stack pointer register in a core file from NT_PRSTATUS
  */
 ut64 Elf_(rz_bin_elf_get_sp_val)(RZ_NONNULL ELFOBJ *bin) {
 	rz_return_val_if_fail(bin, UT64_MAX);
 
+	if (!bin->threads || rz_pvector_empty(bin->threads)) {
+		return UT64_MAX;
+	}
+
+	return Elf_(rz_bin_elf_get_thread_sp_val)(bin, rz_pvector_at(bin->threads, 0));
+}
+
+/**
+ * \brief Get the stack pointer value of a single thread
+ * \param elf binary
+ * \param thread NT_PRSTATUS note of the thread
+ * \return stack pointer or UT64_MAX
+ */
+ut64 Elf_(rz_bin_elf_get_thread_sp_val)(RZ_NONNULL ELFOBJ *bin, RZ_NONNULL RzBinElfNotePrStatus *thread) {
+	rz_return_val_if_fail(bin && thread, UT64_MAX);
+
 	RzBinElfPrStatusLayout *layout = Elf_(rz_bin_elf_get_prstatus_layout)(bin);
-	if (!layout) {
+	if (!layout || layout->sp_offset + layout->sp_size / 8 > thread->regstate_size) {
 		return UT64_MAX;
 	}
 
-	RzVector *notes;
-	rz_bin_elf_foreach_notes_segment(bin, notes) {
-		RzBinElfNote *tmp;
-		rz_vector_foreach(notes, tmp) {
-			if (tmp->type != NT_PRSTATUS) {
-				continue;
-			}
-
-			RzBinElfNotePrStatus *note = &tmp->prstatus;
-			if (layout->sp_offset + layout->sp_size / 8 > note->regstate_size) {
-				return UT64_MAX;
-			}
-
-			return rz_read_ble(note->regstate + layout->sp_offset, bin->big_endian, layout->sp_size);
-		}
+	return rz_read_ble(thread->regstate + layout->sp_offset, bin->big_endian, layout->sp_size);
+}
+
+/**
+ * \brief Get the NT_FILE entry mapped at \p vaddr
+ * \param elf binary
+ * \param vaddr start address of the mapping
+ * \return the file entry or NULL
+ */
+RZ_BORROW RzBinElfNoteFile *Elf_(rz_bin_elf_get_note_file)(RZ_NONNULL ELFOBJ *bin, ut64 vaddr) {
+	rz_return_val_if_fail(bin, NULL);
+
+	if (!bin->note_files) {
+		return NULL;
 	}
 
-	return UT64_MAX;
+	return ht_up_find(bin->note_files, vaddr, NULL);
 }
@@ -15,10 +15,10 @@
 #define ARCH_LEN 4
 
 static RzBinElfPrStatusLayout prstatus_layouts[ARCH_LEN] = {
-	[X86] = { 160, 0x48, 32, 0x3c },
-	[X86_64] = { 216, 0x70, 64, 0x98 },
-	[ARM] = { 72, 0x48, 32, 0x34 },
-	[AARCH64] = { 272, 0x70, 64, 0xf8 }
+	[X86] = { 160, 0x48, 32, 0x3c, 0x18 },
+	[X86_64] = { 216, 0x70, 64, 0x98, 0x20 },
+	[ARM] = { 72, 0x48, 32, 0x34, 0x18 },
+	[AARCH64] = { 272, 0x70, 64, 0xf8, 0x20 }
 };
 
 static bool parse_note_prstatus(ELFOBJ *bin, RzVector /*<RzBinElfNote>*/ *notes, Elf_(Nhdr) * note_segment_header, ut64 offset) {
@@ -46,6 +46,13 @@ static bool parse_note_prstatus(ELFOBJ *bin, RzVector /*<RzBinElfNote>*/ *notes,
 		return false;
 	}
 
+	ut8 pid[4];
+	if (rz_buf_read_at(bin->b, offset + layout->pid_offset, pid, sizeof(pid)) != sizeof(pid)) {
+		RZ_LOG_WARN("Failed to read thread id from CORE file\n");
+		return false;
+	}
+	note->prstatus.pid = rz_read_ble32(pid, bin->big_endian);
+
 	return true;
 }
 
@@ -152,8 +159,9 @@ static bool read_note_segment_header(ELFOBJ *bin, ut64 *offset, Elf_(Nhdr) * not
 
 static bool set_note_segment(ELFOBJ *bin, RzVector /*<RzBinElfNote>*/ *notes, RzBinElfSegment *segment) {
 	ut64 offset = segment->data.p_offset;
+	ut64 end = segment->data.p_offset + segment->data.p_filesz;
 
-	while (offset < segment->data.p_filesz) {
+	while (offset < end) {
 		Elf_(Nhdr) note_segment_header;
 
 		if (!read_note_segment_header(bin, &offset, &note_segment_header)) {
@@ -256,3 +264,48 @@ bool Elf_(rz_bin_elf_has_notes)(RZ_NONNULL ELFOBJ *bin) {
 	rz_return_val_if_fail(bin, false);
 	return bin->notes;
 }
+
+/**
+ * \brief Index the NT_PRSTATUS notes by thread and the NT_FILE entries by start address
+ *
+ * Core files of large processes contain thousands of threads and mappings,
+ * looking them up must not walk all the notes.
+ */
+bool Elf_(rz_bin_elf_notes_index)(RZ_NONNULL ELFOBJ *bin) {
+	rz_return_val_if_fail(bin, false);
+
+	bin->threads = rz_pvector_new(NULL);
+	bin->note_files = ht_up_new0();
+	if (!bin->threads || !bin->note_files) {
+		Elf_(rz_bin_elf_notes_index_fini)(bin);
+		return false;
+	}
+
+	RzVector *notes;
+	rz_bin_elf_foreach_notes_segment(bin, notes) {
+		RzBinElfNote *tmp;
+		rz_vector_foreach(notes, tmp) {
+			switch (tmp->type) {
+			case NT_PRSTATUS:
+				if (tmp->prstatus.regstate) {
+					rz_pvector_push(bin->threads, &tmp->prstatus);
+				}
+				break;
+			case NT_FILE:
+				// keep the first entry for an address
+				ht_up_insert(bin->note_files, tmp->file.start_vaddr, &tmp->file);
+				break;
+			}
+		}
+	}
+
+	return true;
+}
+
+void Elf_(rz_bin_elf_notes_index_fini)(RZ_NONNULL ELFOBJ *bin) {
+	rz_return_if_fail(bin);
+	rz_pvector_free(bin->threads);
+	ht_up_free(bin->note_files);
+	bin->threads = NULL;
+	bin->note_files = NULL;
+}
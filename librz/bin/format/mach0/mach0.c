@@ -1837,6 +1837,7 @@ void *MACH0_(mach0_free)(struct MACH0_(obj_t) * mo) {
 	}
 	free(mo->segs);
 	free(mo->sects);
+	rz_vector_free(mo->va_ranges);
 	free(mo->symtab);
 	free(mo->symstr);
 	free(mo->indirectsyms);
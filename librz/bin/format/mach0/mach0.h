@@ -214,6 +214,7 @@ struct MACH0_(obj_t) {
 	ut64 main_addr;
 
 	RzList /*<RzBinSection *>*/ *sections_cache;
+	RzVector /*<MachoVaRange>*/ *va_ranges; ///< sections_cache split into sorted disjoint ranges, for the ObjC metadata parser
 	RzSkipList /* struct reloc_t * */ *relocs; ///< lazily loaded, use only MACH0_(get_relocs)() to access this
 	bool relocs_parsed; ///< whether relocs have already been parsed and relocs is filled (or NULL on error)
 	bool reloc_targets_map_base_calculated;
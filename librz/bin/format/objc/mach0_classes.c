@@ -134,14 +134,88 @@ static bool is_thumb(RzBinFile *bf) {
 	return false;
 }
 
+/**
+ * Piece of the address space mapped by the first section or segment covering it.
+ */
+typedef struct {
+	ut64 from; ///< First address of the range
+	ut64 to; ///< Address after the last one of the range
+	ut64 vaddr; ///< Start of the covering section or segment
+	ut64 vsize; ///< Size of the covering section or segment
+	ut64 paddr; ///< Physical address of the covering section or segment
+} MachoVaRange;
+
+static int va_range_cmp(ut64 addr, const void *a) {
+	const MachoVaRange *r = a;
+	return RZ_NUM_CMP(addr, r->from);
+}
+
+static int ut64_cmp(const void *a, const void *b) {
+	return RZ_NUM_CMP(*(const ut64 *)a, *(const ut64 *)b);
+}
+
+static ut64 section_end(const RzBinSection *s) {
+	ut64 end = s->vaddr + s->vsize;
+	return end < s->vaddr ? UT64_MAX : end;
+}
+
+/**
+ * Splits the sections into disjoint ranges sorted by address, so an address can be
+ * resolved with a binary search. Every range keeps the section that comes first in the
+ * list, the same one a linear walk over the list would find (segments come first).
+ */
+static RzVector /*<MachoVaRange>*/ *va_ranges_build(const RzList /*<RzBinSection *>*/ *sctns) {
+	RzVector *ranges = rz_vector_new(sizeof(MachoVaRange), NULL, NULL);
+	RzPVector candidates;
+	RzVector bounds;
+	rz_pvector_init(&candidates, NULL);
+	rz_vector_init(&bounds, sizeof(ut64), NULL, NULL);
+	if (!ranges) {
+		goto beach;
+	}
+	RzListIter *iter;
+	RzBinSection *s;
+	rz_list_foreach (sctns, iter, s) {
+		if (!s->vsize) {
+			continue;
+		}
+		ut64 end = section_end(s);
+		rz_pvector_push(&candidates, s);
+		rz_vector_push(&bounds, &s->vaddr);
+		rz_vector_push(&bounds, &end);
+	}
+	rz_vector_sort(&bounds, ut64_cmp, false);
+	for (size_t i = 0; i + 1 < rz_vector_len(&bounds); i++) {
+		ut64 from = *(ut64 *)rz_vector_index_ptr(&bounds, i);
+		ut64 to = *(ut64 *)rz_vector_index_ptr(&bounds, i + 1);
+		if (from == to) {
+			continue;
+		}
+		void **it;
+		rz_pvector_foreach (&candidates, it) {
+			s = *it;
+			if (from < s->vaddr || from >= section_end(s)) {
+				continue;
+			}
+			MachoVaRange *last = rz_vector_empty(ranges) ? NULL : rz_vector_tail(ranges);
+			if (last && last->to == from && last->vaddr == s->vaddr && last->vsize == s->vsize && last->paddr == s->paddr) {
+				last->to = to;
+			} else {
+				MachoVaRange r = { from, to, s->vaddr, s->vsize, s->paddr };
+				rz_vector_push(ranges, &r);
+			}
+			break;
+		}
+	}
+beach:
+	rz_pvector_fini(&candidates);
+	rz_vector_fini(&bounds);
+	return ranges;
+}
+
 static mach0_ut va2pa(mach0_ut p, ut32 *offset, ut32 *left, RzBinFile *bf) {
 	rz_return_val_if_fail(bf && bf->o && bf->o->bin_obj, 0);
 
-	mach0_ut r;
-	mach0_ut addr;
-
-	RzListIter *iter = NULL;
-	RzBinSection *s = NULL;
 	RzBinObject *obj = bf->o;
 
 	struct MACH0_(obj_t) *bin = (struct MACH0_(obj_t) *)obj->bin_obj;
@@ -149,25 +223,32 @@ static mach0_ut va2pa(mach0_ut p, ut32 *offset, ut32 *left, RzBinFile *bf) {
 		return bin->va2pa(p, offset, left, bf);
 	}
 
-	const RzList *sctns = bin->sections_cache;
-	if (!sctns) {
-		sctns = rz_bin_plugin_mach.sections(bf);
+	if (!bin->va_ranges) {
+		// the returned list is a shallow copy of the sections cache
+		RzList *sctns = rz_bin_plugin_mach.sections(bf);
 		if (!sctns) {
 			return 0;
 		}
+		bin->va_ranges = va_ranges_build(sctns);
+		rz_list_free(sctns);
+		if (!bin->va_ranges) {
+			return 0;
+		}
 	}
 
-	addr = p;
-	rz_list_foreach (sctns, iter, s) {
-		if (addr >= s->vaddr && addr < s->vaddr + s->vsize) {
+	ut64 addr = p;
+	size_t i;
+	rz_vector_upper_bound(bin->va_ranges, addr, i, va_range_cmp);
+	if (i) {
+		const MachoVaRange *r = rz_vector_index_ptr(bin->va_ranges, i - 1);
+		if (addr < r->to) {
 			if (offset) {
-				*offset = addr - s->vaddr;
+				*offset = addr - r->vaddr;
 			}
 			if (left) {
-				*left = s->vsize - (addr - s->vaddr);
+				*left = r->vsize - (addr - r->vaddr);
 			}
-			r = (s->paddr - obj->boffset + (addr - s->vaddr));
-			return r;
+			return r->paddr - obj->boffset + (addr - r->vaddr);
 		}
 	}
 
@@ -1224,6 +1305,40 @@ static RzList *parse_swift_classes(RzBinFile *bf) {
 }
 #endif
 
+/**
+ * Loads the whole __objc_* sections into memory with a single read each, so the
+ * many small reads of the metadata parser are served from memory.
+ * Everything else is read through from \p base.
+ */
+static RzBuffer *metadata_view_new(RzBinFile *bf, RzBuffer *base) {
+	RzBuffer *view = rz_buf_new_sparse_overlay(base, RZ_BUF_SPARSE_WRITE_MODE_SPARSE);
+	if (!view) {
+		return rz_buf_ref(base);
+	}
+	struct section_t *sections = MACH0_(get_sections)(bf->o->bin_obj);
+	if (!sections) {
+		return view;
+	}
+	ut64 base_size = rz_buf_size(base);
+	for (size_t i = 0; !sections[i].last; i++) {
+		struct section_t *s = &sections[i];
+		if (!strstr(s->name, "__objc_") || !s->size || s->offset >= base_size) {
+			continue;
+		}
+		ut64 size = RZ_MIN(s->size, base_size - s->offset);
+		ut8 *data = malloc(size);
+		if (!data) {
+			continue;
+		}
+		if (rz_buf_read_at(base, s->offset, data, size) == size) {
+			rz_buf_write_at(view, s->offset, data, size);
+		}
+		free(data);
+	}
+	free(sections);
+	return view;
+}
+
 RZ_API RZ_OWN RzPVector /*<RzBinClass *>*/ *MACH0_(parse_classes)(RzBinFile *bf, objc_cache_opt_info *oi) {
 	RzPVector /*<RzBinClass *>*/ *ret = NULL;
 	ut64 num_of_unnamed_class = 0;
@@ -1247,7 +1362,10 @@ RZ_API RZ_OWN RzPVector /*<RzBinClass *>*/ *MACH0_(parse_classes)(RzBinFile *bf,
 	bigendian = bf->o->info->big_endian;
 	struct MACH0_(obj_t) *obj = bf->o->bin_obj;
 
-	RzBuffer *buf = obj->buf_patched ? obj->buf_patched : bf->buf;
+	RzBuffer *buf = metadata_view_new(bf, obj->buf_patched ? obj->buf_patched : bf->buf);
+	if (!buf) {
+		return NULL;
+	}
 
 	RzSkipList *relocs = MACH0_(get_relocs)(bf->o->bin_obj);
 
@@ -1260,6 +1378,7 @@ RZ_API RZ_OWN RzPVector /*<RzBinClass *>*/ *MACH0_(parse_classes)(RzBinFile *bf,
 
 	struct section_t *sections = NULL;
 	if (!(sections = MACH0_(get_sections)(bf->o->bin_obj))) {
+		rz_buf_free(buf);
 		return ret;
 	}
 
@@ -1331,9 +1450,11 @@ RZ_API RZ_OWN RzPVector /*<RzBinClass *>*/ *MACH0_(parse_classes)(RzBinFile *bf,
 		}
 		rz_pvector_push(ret, klass);
 	}
+	rz_buf_free(buf);
 	return ret;
 
 get_classes_error:
+	rz_buf_free(buf);
 	rz_list_free(sctns);
 	rz_pvector_free(ret);
 	// XXX DOUBLE FREE rz_bin_class_free (klass);
@@ -0,0 +1,419 @@
+// SPDX-FileCopyrightText: 2023 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+/**
+ * \file kallsyms.c
+ * Recovery of the symbols of a Linux kernel from its kallsyms tables.
+ *
+ * The tables are emitted by scripts/kallsyms.c in the kernel tree:
+ *  - kallsyms_num_syms: number of symbols
+ *  - kallsyms_names: for each symbol, its length followed by indexes in the token table
+ *  - kallsyms_markers: offset in kallsyms_names of every 256th symbol
+ *  - kallsyms_token_table: 256 NUL terminated strings
+ *  - kallsyms_token_index: offset in kallsyms_token_table of every token
+ *  - kallsyms_addresses, or kallsyms_offsets relative to kallsyms_relative_base
+ *
+ * Older kernels put the addresses before kallsyms_num_syms, newer ones after
+ * kallsyms_token_index, and some put kallsyms_seqs_of_names between the markers
+ * and the token table. The search starts from the token table, which is easy to
+ * spot since the digits are never replaced by tokens, and every other table is
+ * then validated against the previous ones.
+ */
+
+#include "zimg.h"
+
+#define KALLSYMS_TOKENS      256
+#define KALLSYMS_MARKER_STEP 256
+/* kallsyms_seqs_of_names may sit between the markers and the token table */
+#define KALLSYMS_MARKERS_WINDOW (8 << 20)
+/* Upper bound for the size of a single compressed name */
+#define KALLSYMS_MAX_NAME_SIZE 512
+
+typedef struct {
+	const ut8 *data;
+	size_t size;
+	bool big_endian;
+	size_t token_table;
+	size_t token_index;
+	const char *tokens[KALLSYMS_TOKENS];
+	ut8 token_len[KALLSYMS_TOKENS];
+	size_t markers;
+	size_t markers_width;
+	size_t n_markers;
+	size_t num_syms_pos;
+	size_t names;
+	size_t names_end;
+	ut32 num_syms;
+} Kallsyms;
+
+static inline ut64 ks_read(const Kallsyms *ks, size_t off, size_t width) {
+	return rz_read_ble(ks->data + off, ks->big_endian, (int)width * 8);
+}
+
+static inline size_t align_up(size_t x, size_t align) {
+	return (x + align - 1) & ~(align - 1);
+}
+
+/**
+ * Finds \p pat in \p data from \p from, the scan is driven by memchr()
+ * which libc implements with vector instructions.
+ */
+static const ut8 *scan(const ut8 *data, size_t size, size_t from, const ut8 *pat, size_t pat_len) {
+	if (size < pat_len) {
+		return NULL;
+	}
+	const ut8 *end = data + size - pat_len + 1;
+	const ut8 *p = data + from;
+	while (p < end && (p = memchr(p, pat[0], end - p))) {
+		if (!memcmp(p, pat, pat_len)) {
+			return p;
+		}
+		p++;
+	}
+	return NULL;
+}
+
+static const ut8 *token_end(const Kallsyms *ks, size_t off) {
+	if (off >= ks->size) {
+		return NULL;
+	}
+	const ut8 *nul = memchr(ks->data + off, 0, RZ_MIN(ks->size - off, (size_t)UT8_MAX));
+	return nul && nul != ks->data + off ? nul : NULL;
+}
+
+/**
+ * Checks whether \p digits, the position of "0\01\0...9\0", is inside a token
+ * table followed by its index, trying both endiannesses.
+ */
+static bool token_table_at(Kallsyms *ks, size_t digits) {
+	size_t end = digits;
+	for (size_t i = '0'; i < KALLSYMS_TOKENS; i++) {
+		const ut8 *nul = token_end(ks, end);
+		if (!nul) {
+			return false;
+		}
+		end = nul - ks->data + 1;
+	}
+	for (size_t index = align_up(end, 2); index < end + 8 && index + KALLSYMS_TOKENS * 2 <= ks->size; index += 2) {
+		for (int be = 0; be < 2; be++) {
+			ks->big_endian = be;
+			ut64 digits_off = ks_read(ks, index + '0' * 2, 2);
+			if (ks_read(ks, index, 2) || digits_off > digits) {
+				continue;
+			}
+			size_t table = digits - digits_off;
+			size_t off = 0;
+			size_t i;
+			for (i = 0; i < KALLSYMS_TOKENS; i++) {
+				const ut8 *nul = token_end(ks, table + off);
+				if (!nul || ks_read(ks, index + i * 2, 2) != off) {
+					break;
+				}
+				ks->tokens[i] = (const char *)ks->data + table + off;
+				ks->token_len[i] = nul - (ks->data + table + off);
+				off += ks->token_len[i] + 1;
+			}
+			if (i == KALLSYMS_TOKENS && table + off == end) {
+				ks->token_table = table;
+				ks->token_index = index;
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+static bool find_token_table(Kallsyms *ks) {
+	static const ut8 digits[] = "0\0"
+				    "1\0"
+				    "2\0"
+				    "3\0"
+				    "4\0"
+				    "5\0"
+				    "6\0"
+				    "7\0"
+				    "8\0"
+				    "9";
+	const ut8 *hit;
+	size_t from = 0;
+	while ((hit = scan(ks->data, ks->size, from, digits, sizeof(digits)))) {
+		size_t pos = hit - ks->data;
+		if (token_table_at(ks, pos)) {
+			return true;
+		}
+		from = pos + 1;
+	}
+	return false;
+}
+
+static inline size_t name_size(const Kallsyms *ks, size_t off, size_t *header) {
+	size_t len = ks->data[off];
+	*header = 1;
+	// Since 6.1, names longer than 127 tokens take two bytes
+	if (len & 0x80) {
+		if (off + 1 >= ks->size) {
+			return 0;
+		}
+		len = (len & 0x7f) | ((size_t)ks->data[off + 1] << 7);
+		*header = 2;
+	}
+	return len;
+}
+
+/**
+ * Checks that \p num_syms names starting at \p names agree with the markers
+ * and end right before them.
+ */
+static bool names_at(Kallsyms *ks, size_t names, ut32 num_syms) {
+	size_t off = 0;
+	for (ut32 i = 0; i < num_syms; i++) {
+		if (!(i % KALLSYMS_MARKER_STEP) && ks_read(ks, ks->markers + (i / KALLSYMS_MARKER_STEP) * ks->markers_width, ks->markers_width) != off) {
+			return false;
+		}
+		if (names + off >= ks->markers) {
+			return false;
+		}
+		size_t header;
+		size_t len = name_size(ks, names + off, &header);
+		if (!len) {
+			return false;
+		}
+		off += header + len;
+	}
+	size_t end = names + off;
+	if (end > ks->markers || ks->markers - end >= 8) {
+		return false;
+	}
+	for (size_t i = end; i < ks->markers; i++) {
+		if (ks->data[i]) {
+			return false;
+		}
+	}
+	ks->names = names;
+	ks->names_end = end;
+	ks->num_syms = num_syms;
+	return true;
+}
+
+/**
+ * Looks for kallsyms_num_syms before the names, given the markers.
+ */
+static bool find_names(Kallsyms *ks) {
+	ut64 last = ks_read(ks, ks->markers + (ks->n_markers - 1) * ks->markers_width, ks->markers_width);
+	if (last + 4 >= ks->markers) {
+		return false;
+	}
+	size_t hi = (ks->markers - last - 4) & ~(size_t)3;
+	size_t lo = hi > KALLSYMS_MARKER_STEP * KALLSYMS_MAX_NAME_SIZE ? hi - KALLSYMS_MARKER_STEP * KALLSYMS_MAX_NAME_SIZE : 0;
+	ut64 min = (ks->n_markers - 1) * KALLSYMS_MARKER_STEP;
+	ut64 max = ks->n_markers * KALLSYMS_MARKER_STEP;
+	for (size_t pos = hi + 4; pos > lo; pos -= 4) {
+		size_t q = pos - 4;
+		ut64 n = ks_read(ks, q, 4);
+		if (n <= min || n > max) {
+			continue;
+		}
+		if (names_at(ks, q + 4, n) || (!(q % 8) && names_at(ks, q + 8, n))) {
+			ks->num_syms_pos = q;
+			return true;
+		}
+	}
+	return false;
+}
+
+static bool markers_at(Kallsyms *ks, size_t pos, size_t width) {
+	if (ks_read(ks, pos, width)) {
+		return false;
+	}
+	size_t n = 1;
+	ut64 prev = 0;
+	while (pos + (n + 1) * width <= ks->token_table) {
+		ut64 v = ks_read(ks, pos + n * width, width);
+		if (v <= prev || v - prev < KALLSYMS_MARKER_STEP * 2 || v - prev > KALLSYMS_MARKER_STEP * KALLSYMS_MAX_NAME_SIZE) {
+			break;
+		}
+		prev = v;
+		n++;
+	}
+	ks->markers = pos;
+	ks->markers_width = width;
+	// The first token may look like one more marker
+	for (size_t k = n; k >= 2 && k + 1 >= n; k--) {
+		ks->n_markers = k;
+		if (find_names(ks)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static bool find_markers(Kallsyms *ks) {
+	size_t lo = ks->token_table > KALLSYMS_MARKERS_WINDOW ? ks->token_table - KALLSYMS_MARKERS_WINDOW : 0;
+	for (size_t pos = ks->token_table & ~(size_t)3; pos >= lo + 8; pos -= 4) {
+		size_t p = pos - 8;
+		if (markers_at(ks, p + 4, 4) || (!(p % 8) && markers_at(ks, p, 8))) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/* 64-bit kernels all live in the upper half of the address space */
+static inline bool kernel_address(ut64 addr, size_t ptr_size) {
+	return addr && (ptr_size != 8 || addr >> 63);
+}
+
+static bool sorted(const ut64 *addrs, size_t n) {
+	for (size_t i = 1; i < n; i++) {
+		if (addrs[i] < addrs[i - 1]) {
+			return false;
+		}
+	}
+	return n && addrs[n - 1] > addrs[0];
+}
+
+static bool absolute_at(const Kallsyms *ks, size_t pos, size_t ptr_size, ut64 *addrs) {
+	if (pos + (ut64)ks->num_syms * ptr_size > ks->size) {
+		return false;
+	}
+	for (size_t i = 0; i < ks->num_syms; i++) {
+		addrs[i] = ks_read(ks, pos + i * ptr_size, ptr_size);
+	}
+	return sorted(addrs, ks->num_syms) && kernel_address(addrs[ks->num_syms - 1], ptr_size);
+}
+
+static bool relative_at(const Kallsyms *ks, size_t pos, size_t base_pos, size_t ptr_size, ut64 *addrs) {
+	if (pos + (ut64)ks->num_syms * 4 > ks->size || base_pos + ptr_size > ks->size) {
+		return false;
+	}
+	ut64 base = ks_read(ks, base_pos, ptr_size);
+	if (!kernel_address(base, ptr_size)) {
+		return false;
+	}
+	// With CONFIG_KALLSYMS_ABSOLUTE_PERCPU, positive offsets are absolute
+	// and negative ones are relative to the base
+	bool percpu = false;
+	for (size_t i = 0; i < ks->num_syms; i++) {
+		st32 off = (st32)ks_read(ks, pos + i * 4, 4);
+		if (off < 0) {
+			percpu = true;
+		}
+		addrs[i] = off;
+	}
+	if (percpu) {
+		for (size_t i = 0; i < ks->num_syms; i++) {
+			st32 off = (st32)addrs[i];
+			addrs[i] = off >= 0 ? (ut64)off : base - 1 - off;
+		}
+		if (sorted(addrs, ks->num_syms)) {
+			return true;
+		}
+		for (size_t i = 0; i < ks->num_syms; i++) {
+			addrs[i] = ks_read(ks, pos + i * 4, 4);
+		}
+	}
+	for (size_t i = 0; i < ks->num_syms; i++) {
+		addrs[i] += base;
+	}
+	return sorted(addrs, ks->num_syms);
+}
+
+static bool find_addresses(const Kallsyms *ks, size_t ptr_size, bool relative, ut64 *addrs) {
+	size_t n = ks->num_syms;
+	// Newer layout, right after the token index
+	size_t after = align_up(ks->token_index + KALLSYMS_TOKENS * 2, ptr_size);
+	if (relative ? relative_at(ks, after, align_up(after + n * 4, ptr_size), ptr_size, addrs) : absolute_at(ks, after, ptr_size, addrs)) {
+		return true;
+	}
+	// Older layout, right before kallsyms_num_syms
+	if (ks->num_syms_pos < ptr_size) {
+		return false;
+	}
+	if (!relative) {
+		return ks->num_syms_pos >= n * ptr_size && absolute_at(ks, ks->num_syms_pos - n * ptr_size, ptr_size, addrs);
+	}
+	size_t base = ks->num_syms_pos - ptr_size;
+	for (size_t pad = 0; pad < ptr_size; pad += 4) {
+		if (base >= n * 4 + pad && relative_at(ks, base - n * 4 - pad, base, ptr_size, addrs)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static void decode_names(const Kallsyms *ks, const ut64 *addrs, RzVector /*<RzBinZimgSymbol>*/ *symbols) {
+	char name[KALLSYMS_MAX_NAME_SIZE * 4];
+	size_t off = ks->names;
+	if (!rz_vector_reserve(symbols, rz_vector_len(symbols) + ks->num_syms)) {
+		return;
+	}
+	for (size_t i = 0; i < ks->num_syms; i++) {
+		size_t header;
+		size_t len = name_size(ks, off, &header);
+		const ut8 *tok = ks->data + off + header;
+		off += header + len;
+		size_t n = 0;
+		for (size_t j = 0; j < len; j++) {
+			ut8 t = ks->token_len[tok[j]];
+			if (n + t >= sizeof(name)) {
+				break;
+			}
+			memcpy(name + n, ks->tokens[tok[j]], t);
+			n += t;
+		}
+		if (n < 2) {
+			continue;
+		}
+		RzBinZimgSymbol *sym = rz_vector_push(symbols, NULL);
+		if (!sym) {
+			return;
+		}
+		sym->vaddr = addrs[i];
+		sym->type = name[0];
+		sym->name = rz_str_ndup(name + 1, (int)n - 1);
+	}
+}
+
+/**
+ * \brief Recovers the kernel symbols from the kallsyms tables in \p data
+ *
+ * \param data The uncompressed kernel image
+ * \param ptr_size In: the expected pointer size, 0 if unknown. Out: the pointer size of the kernel
+ * \param symbols Where to push the symbols, sorted by address
+ * \param big_endian Set to the endianness of the tables
+ * \return true if the tables were found
+ */
+bool rz_bin_zimg_kallsyms(const ut8 *data, size_t size, int *ptr_size, RzVector /*<RzBinZimgSymbol>*/ *symbols, bool *big_endian) {
+	rz_return_val_if_fail(data && ptr_size && symbols && big_endian, false);
+	Kallsyms ks = { .data = data, .size = size };
+	if (!find_token_table(&ks) || !find_markers(&ks)) {
+		return false;
+	}
+	ut64 *addrs = RZ_NEWS(ut64, ks.num_syms);
+	if (!addrs) {
+		return false;
+	}
+	size_t sizes[] = { 8, 4 };
+	if (*ptr_size == 4) {
+		sizes[0] = 4;
+		sizes[1] = 8;
+	}
+	// 32-bit offsets could also pass for absolute addresses, so relative
+	// tables are looked for first
+	bool found = false;
+	for (int relative = 1; relative >= 0 && !found; relative--) {
+		for (size_t i = 0; i < RZ_ARRAY_SIZE(sizes) && !found; i++) {
+			if (find_addresses(&ks, sizes[i], relative, addrs)) {
+				*ptr_size = (int)sizes[i];
+				found = true;
+			}
+		}
+	}
+	if (found) {
+		*big_endian = ks.big_endian;
+		decode_names(&ks, addrs, symbols);
+		RZ_LOG_DEBUG("zimg: %" PFMT32u " kallsyms at 0x%" PFMTSZx "\n", ks.num_syms, ks.names);
+	}
+	free(addrs);
+	return found;
+}
@@ -3,8 +3,523 @@
 
 #include <rz_types.h>
 #include <rz_util.h>
+#include <lz4.h>
+#include <zstd.h>
 #include "zimg.h"
 
+#define ZIMG_MAX_FILE_SIZE   ((ut64)1 << 30)
+#define ZIMG_MAX_KERNEL_SIZE ((size_t)1 << 30)
+#define ZIMG_MIN_KERNEL_SIZE 0x10000
+#define ZIMG_MAX_PAYLOADS    16
+
+#define ZIMAGE_MAGIC_OFFSET      0x24
+#define ZIMAGE_MAGIC             0x016f2818
+#define BZIMAGE_SETUP_SECTS      0x1f1
+#define BZIMAGE_BOOT_FLAG        0x1fe
+#define BZIMAGE_HEADER           0x202
+#define BZIMAGE_VERSION          0x206
+#define BZIMAGE_PAYLOAD_OFFSET   0x248
+#define BZIMAGE_PAYLOAD_LENGTH   0x24c
+#define BZIMAGE_HEADER_END       0x250
+#define ARM64_IMAGE_MAGIC_OFFSET 0x38
+
+#define LZ4_LEGACY_MAGIC      0x184c2102
+#define LZ4_LEGACY_BLOCK_SIZE (8 << 20)
+
+typedef ut8 *(*ZimgDecompress)(const ut8 *src, size_t src_size, size_t *out_size);
+
+/**
+ * Output of the decompressors, which refuses to grow past ZIMG_MAX_KERNEL_SIZE
+ * so that the decompression stops as soon as the kernel gets too large.
+ */
+typedef struct {
+	ut8 *data;
+	ut64 size;
+	ut64 cap;
+	ut64 offset;
+} ZimgOutput;
+
+static bool output_init(RzBuffer *b, const void *user) {
+	b->priv = RZ_NEW0(ZimgOutput);
+	return b->priv != NULL;
+}
+
+static bool output_fini(RzBuffer *b) {
+	ZimgOutput *out = b->priv;
+	free(out->data);
+	RZ_FREE(b->priv);
+	return true;
+}
+
+static bool output_resize(RzBuffer *b, ut64 newsize) {
+	ZimgOutput *out = b->priv;
+	if (newsize > ZIMG_MAX_KERNEL_SIZE) {
+		return false;
+	}
+	if (newsize > out->cap) {
+		ut64 cap = RZ_MIN(RZ_MAX(out->cap * 2, newsize), ZIMG_MAX_KERNEL_SIZE);
+		ut8 *tmp = realloc(out->data, cap);
+		if (!tmp) {
+			return false;
+		}
+		out->data = tmp;
+		out->cap = cap;
+	}
+	if (newsize > out->size) {
+		memset(out->data + out->size, 0, newsize - out->size);
+	}
+	out->size = newsize;
+	return true;
+}
+
+static st64 output_read(RzBuffer *b, ut8 *buf, ut64 len) {
+	ZimgOutput *out = b->priv;
+	ut64 n = out->offset < out->size ? RZ_MIN(out->size - out->offset, len) : 0;
+	memcpy(buf, out->data + out->offset, n);
+	out->offset += n;
+	return n;
+}
+
+static st64 output_write(RzBuffer *b, const ut8 *buf, ut64 len) {
+	ZimgOutput *out = b->priv;
+	if (out->offset + len > out->size && !output_resize(b, out->offset + len)) {
+		return -1;
+	}
+	memcpy(out->data + out->offset, buf, len);
+	out->offset += len;
+	return len;
+}
+
+static ut64 output_get_size(RzBuffer *b) {
+	ZimgOutput *out = b->priv;
+	return out->size;
+}
+
+static st64 output_seek(RzBuffer *b, st64 addr, int whence) {
+	ZimgOutput *out = b->priv;
+	st64 val = rz_seek_offset(out->offset, out->size, addr, whence);
+	if (val == -1) {
+		return -1;
+	}
+	return out->offset = val;
+}
+
+static const RzBufferMethods output_methods = {
+	.init = output_init,
+	.fini = output_fini,
+	.read = output_read,
+	.write = output_write,
+	.get_size = output_get_size,
+	.resize = output_resize,
+	.seek = output_seek,
+};
+
+static ut8 *output_steal(RzBuffer *buf, size_t *out_size) {
+	ZimgOutput *out = buf->priv;
+	if (out->size < ZIMG_MIN_KERNEL_SIZE) {
+		return NULL;
+	}
+	ut8 *ret = out->data;
+	*out_size = out->size;
+	out->data = NULL;
+	out->size = out->cap = out->offset = 0;
+	return ret;
+}
+
+static ut8 *decompress_gzip(const ut8 *src, size_t src_size, size_t *out_size) {
+	RzBuffer *in = rz_buf_new_with_pointers(src, src_size, false);
+	RzBuffer *out = rz_buf_new_with_methods(&output_methods, NULL);
+	ut8 *ret = NULL;
+	if (in && out && rz_inflate_buf(in, out, 1 << 13, NULL)) {
+		ret = output_steal(out, out_size);
+	}
+	rz_buf_free(in);
+	rz_buf_free(out);
+	return ret;
+}
+
+static ut8 *decompress_lzma(const ut8 *src, size_t src_size, size_t *out_size) {
+	RzBuffer *in = rz_buf_new_with_pointers(src, src_size, false);
+	RzBuffer *out = rz_buf_new_with_methods(&output_methods, NULL);
+	ut8 *ret = NULL;
+	if (in && out && rz_lzma_dec_buf(in, out, 1 << 13, NULL)) {
+		ret = output_steal(out, out_size);
+	}
+	rz_buf_free(in);
+	rz_buf_free(out);
+	return ret;
+}
+
+/**
+ * The kernel uses the legacy lz4 frame format: the magic followed by blocks
+ * prefixed by their compressed size, each one decompressing to at most 8 MiB.
+ */
+static ut8 *decompress_lz4(const ut8 *src, size_t src_size, size_t *out_size) {
+	ut8 *out = NULL;
+	size_t len = 0, cap = 0;
+	size_t pos = 4;
+	while (pos + 4 <= src_size) {
+		ut32 csize = rz_read_le32(src + pos);
+		if (csize == LZ4_LEGACY_MAGIC) {
+			pos += 4;
+			continue;
+		}
+		if (!csize || csize > LZ4_compressBound(LZ4_LEGACY_BLOCK_SIZE) || csize > src_size - pos - 4) {
+			break;
+		}
+		if (len + LZ4_LEGACY_BLOCK_SIZE > cap) {
+			if (len + LZ4_LEGACY_BLOCK_SIZE > ZIMG_MAX_KERNEL_SIZE) {
+				break;
+			}
+			cap = len + LZ4_LEGACY_BLOCK_SIZE;
+			ut8 *tmp = realloc(out, cap);
+			if (!tmp) {
+				break;
+			}
+			out = tmp;
+		}
+		int r = LZ4_decompress_safe((const char *)src + pos + 4, (char *)out + len, (int)csize, LZ4_LEGACY_BLOCK_SIZE);
+		if (r < 0) {
+			break;
+		}
+		len += r;
+		pos += 4 + csize;
+	}
+	if (len < ZIMG_MIN_KERNEL_SIZE) {
+		free(out);
+		return NULL;
+	}
+	*out_size = len;
+	return out;
+}
+
+static ut8 *decompress_zstd(const ut8 *src, size_t src_size, size_t *out_size) {
+	ZSTD_DStream *ds = ZSTD_createDStream();
+	if (!ds) {
+		return NULL;
+	}
+	ZSTD_initDStream(ds);
+	ZSTD_inBuffer in = { src, src_size, 0 };
+	size_t cap = RZ_MIN(src_size * 4, ZIMG_MAX_KERNEL_SIZE);
+	size_t len = 0;
+	ut8 *out = malloc(cap);
+	while (out) {
+		if (len == cap) {
+			if (cap >= ZIMG_MAX_KERNEL_SIZE) {
+				break;
+			}
+			cap = RZ_MIN(cap * 2, ZIMG_MAX_KERNEL_SIZE);
+			ut8 *tmp = realloc(out, cap);
+			if (!tmp) {
+				break;
+			}
+			out = tmp;
+		}
+		ZSTD_outBuffer ob = { out + len, cap - len, 0 };
+		size_t r = ZSTD_decompressStream(ds, &ob, &in);
+		len += ob.pos;
+		if (ZSTD_isError(r)) {
+			RZ_LOG_ERROR("zimg: zstd: %s\n", ZSTD_getErrorName(r));
+			len = 0;
+			break;
+		}
+		if (!r || (in.pos == in.size && ob.pos < ob.size)) {
+			break;
+		}
+	}
+	ZSTD_freeDStream(ds);
+	if (len < ZIMG_MIN_KERNEL_SIZE) {
+		free(out);
+		return NULL;
+	}
+	*out_size = len;
+	return out;
+}
+
+static const struct {
+	const char *name;
+	const ut8 *magic;
+	size_t magic_size;
+	ZimgDecompress decompress; ///< NULL for the formats recognized but not supported
+	bool scan; ///< Whether the magic is reliable enough to look for the payload
+} compressions[] = {
+	{ "gzip", (const ut8 *)"\x1f\x8b\x08", 3, decompress_gzip, true },
+	{ "xz", (const ut8 *)"\xfd\x37zXZ\x00", 6, decompress_lzma, true },
+	{ "lz4", (const ut8 *)"\x02\x21\x4c\x18", 4, decompress_lz4, true },
+	{ "zstd", (const ut8 *)"\x28\xb5\x2f\xfd", 4, decompress_zstd, true },
+	{ "lzma", (const ut8 *)"\x5d\x00\x00", 3, decompress_lzma, false },
+	{ "bzip2", (const ut8 *)"BZh", 3, NULL, false },
+	{ "lzo", (const ut8 *)"\x89LZO", 4, NULL, false },
+};
+
+/**
+ * Decompresses the payload at \p off of \p data, whatever its compression is.
+ */
+static ut8 *decompress_at(RzBinZimgObj *bin, const ut8 *data, size_t size, size_t off, size_t *out_size) {
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(compressions); i++) {
+		if (size - off < compressions[i].magic_size || memcmp(data + off, compressions[i].magic, compressions[i].magic_size)) {
+			continue;
+		}
+		if (!compressions[i].decompress) {
+			RZ_LOG_WARN("zimg: %s compressed kernels are not supported\n", compressions[i].name);
+			return NULL;
+		}
+		ut8 *out = compressions[i].decompress(data + off, size - off, out_size);
+		if (out) {
+			bin->compression = compressions[i].name;
+		}
+		return out;
+	}
+	return NULL;
+}
+
+static int payload_cmp(const void *a, const void *b) {
+	ut64 x = *(const ut64 *)a, y = *(const ut64 *)b;
+	if (x == y) {
+		return 0;
+	}
+	return x < y ? -1 : 1;
+}
+
+/**
+ * Looks for the compressed kernel in \p data when its position is not known,
+ * trying the candidates in the order they appear.
+ */
+static ut8 *decompress_scan(RzBinZimgObj *bin, const ut8 *data, size_t size, size_t from, size_t *out_size) {
+	RzVector offsets;
+	rz_vector_init(&offsets, sizeof(ut64), NULL, NULL);
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(compressions); i++) {
+		if (!compressions[i].scan) {
+			continue;
+		}
+		const ut8 *magic = compressions[i].magic;
+		const ut8 *end = data + size - compressions[i].magic_size + 1;
+		const ut8 *p = data + from;
+		for (size_t n = 0; n < ZIMG_MAX_PAYLOADS && p < end && (p = memchr(p, magic[0], end - p)); p++) {
+			if (!memcmp(p, magic, compressions[i].magic_size)) {
+				ut64 off = p - data;
+				rz_vector_push(&offsets, &off);
+				n++;
+			}
+		}
+	}
+	rz_vector_sort(&offsets, payload_cmp, false);
+	ut8 *out = NULL;
+	ut64 *off;
+	size_t tries = 0;
+	rz_vector_foreach(&offsets, off) {
+		if (tries++ >= ZIMG_MAX_PAYLOADS || (out = decompress_at(bin, data, size, *off, out_size))) {
+			break;
+		}
+	}
+	rz_vector_fini(&offsets);
+	return out;
+}
+
+static ut8 *decompress_bzimage(RzBinZimgObj *bin, const ut8 *data, size_t size, size_t *out_size) {
+	if (size < BZIMAGE_HEADER_END) {
+		return NULL;
+	}
+	ut8 setup_sects = data[BZIMAGE_SETUP_SECTS];
+	size_t pm_start = ((size_t)(setup_sects ? setup_sects : 4) + 1) * 512;
+	if (pm_start >= size) {
+		return NULL;
+	}
+	// Boot protocol 2.08 added the location of the payload
+	if (rz_read_le16(data + BZIMAGE_VERSION) >= 0x208) {
+		size_t off = pm_start + rz_read_le32(data + BZIMAGE_PAYLOAD_OFFSET);
+		size_t len = rz_read_le32(data + BZIMAGE_PAYLOAD_LENGTH);
+		if (off < size && len <= size - off) {
+			ut8 *out = decompress_at(bin, data, off + len, off, out_size);
+			if (out || bin->compression) {
+				return out;
+			}
+		}
+	}
+	return decompress_scan(bin, data, size, pm_start, out_size);
+}
+
+static const char *elf_arch(ut16 machine) {
+	switch (machine) {
+	case 3: // EM_386
+	case 62: // EM_X86_64
+		return "x86";
+	case 8: // EM_MIPS
+		return "mips";
+	case 20: // EM_PPC
+	case 21: // EM_PPC64
+		return "ppc";
+	case 40: // EM_ARM
+	case 183: // EM_AARCH64
+		return "arm";
+	case 243: // EM_RISCV
+		return "riscv";
+	default:
+		return NULL;
+	}
+}
+
+/**
+ * Takes the segments of a vmlinux ELF, which is what x86 bzImages carry.
+ */
+static bool parse_elf(RzBinZimgObj *bin, const ut8 *data, size_t size) {
+	if (size < 0x40 || memcmp(data, "\177ELF", 4)) {
+		return false;
+	}
+	bool is64 = data[4] == 2;
+	bool be = data[5] == 2;
+	ut64 phoff = is64 ? rz_read_ble64(data + 0x20, be) : rz_read_ble32(data + 0x1c, be);
+	ut16 phentsize = rz_read_ble16(data + (is64 ? 0x36 : 0x2a), be);
+	ut16 phnum = rz_read_ble16(data + (is64 ? 0x38 : 0x2c), be);
+	if (phentsize < (is64 ? 0x38 : 0x20)) {
+		return false;
+	}
+	for (ut16 i = 0; i < phnum; i++) {
+		ut64 off = phoff + (ut64)i * phentsize;
+		if (off > size || size - off < phentsize) {
+			break;
+		}
+		const ut8 *ph = data + off;
+		if (rz_read_ble32(ph, be) != 1) { // PT_LOAD
+			continue;
+		}
+		RzBinZimgSegment seg;
+		ut32 flags;
+		if (is64) {
+			flags = rz_read_ble32(ph + 4, be);
+			seg.paddr = rz_read_ble64(ph + 8, be);
+			seg.vaddr = rz_read_ble64(ph + 0x10, be);
+			seg.psize = rz_read_ble64(ph + 0x20, be);
+			seg.vsize = rz_read_ble64(ph + 0x28, be);
+		} else {
+			seg.paddr = rz_read_ble32(ph + 4, be);
+			seg.vaddr = rz_read_ble32(ph + 8, be);
+			seg.psize = rz_read_ble32(ph + 0x10, be);
+			seg.vsize = rz_read_ble32(ph + 0x14, be);
+			flags = rz_read_ble32(ph + 0x18, be);
+		}
+		if (seg.paddr > size) {
+			seg.psize = 0;
+		}
+		seg.psize = RZ_MIN(seg.psize, size - RZ_MIN(seg.paddr, size));
+		seg.perm = (flags & 1 ? RZ_PERM_X : 0) | (flags & 2 ? RZ_PERM_W : 0) | (flags & 4 ? RZ_PERM_R : 0);
+		rz_vector_push(&bin->segments, &seg);
+	}
+	bin->bits = is64 ? 64 : 32;
+	bin->big_endian = be;
+	const char *arch = elf_arch(rz_read_ble16(data + 0x12, be));
+	if (arch) {
+		bin->arch = arch;
+	}
+	return !rz_vector_empty(&bin->segments);
+}
+
+static void load_symbols(RzBinZimgObj *bin, const ut8 *data, size_t size) {
+	int ptr_size = bin->bits / 8;
+	bool big_endian = bin->big_endian;
+	if (!rz_bin_zimg_kallsyms(data, size, &ptr_size, &bin->symbols, &big_endian)) {
+		return;
+	}
+	bin->bits = ptr_size * 8;
+	bin->big_endian = big_endian;
+	if (bin->kind == RZ_BIN_ZIMG_KIND_RAW && !bin->arch) {
+		bin->arch = rz_bin_zimg_get_symbol(bin, "startup_64") || rz_bin_zimg_get_symbol(bin, "startup_32") ? "x86" : "arm";
+	}
+
+	// The image starts at _text
+	static const char *starts[] = { "_text", "_stext", "stext", "_head" };
+	const RzBinZimgSymbol *start = NULL;
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(starts) && !start; i++) {
+		start = rz_bin_zimg_get_symbol(bin, starts[i]);
+	}
+	if (start) {
+		bin->base = start->vaddr;
+	}
+	if (!rz_vector_empty(&bin->segments) || bin->base == UT64_MAX) {
+		return;
+	}
+	const RzBinZimgSymbol *end = rz_bin_zimg_get_symbol(bin, "_end");
+	RzBinZimgSegment seg = {
+		.paddr = 0,
+		.psize = size,
+		.vaddr = bin->base,
+		.vsize = end && end->vaddr > bin->base ? RZ_MAX(end->vaddr - bin->base, size) : size,
+		.perm = RZ_PERM_RWX,
+	};
+	rz_vector_push(&bin->segments, &seg);
+}
+
+static void load_kernel(RzBinZimgObj *bin) {
+	ut64 file_size = rz_buf_size(bin->b);
+	if (file_size > ZIMG_MAX_FILE_SIZE) {
+		return;
+	}
+	ut8 *file = malloc(file_size);
+	if (!file || rz_buf_read_at(bin->b, 0, file, file_size) != file_size) {
+		free(file);
+		return;
+	}
+	size_t size = 0;
+	ut8 *kernel = NULL;
+	switch (bin->kind) {
+	case RZ_BIN_ZIMG_KIND_X86_BZIMAGE:
+		bin->arch = "x86";
+		kernel = decompress_bzimage(bin, file, file_size, &size);
+		break;
+	case RZ_BIN_ZIMG_KIND_ARM_ZIMAGE:
+		bin->arch = "arm";
+		bin->bits = 32;
+		kernel = decompress_scan(bin, file, file_size, 0, &size);
+		break;
+	case RZ_BIN_ZIMG_KIND_ARM64_IMAGE:
+		bin->arch = "arm";
+		bin->bits = 64;
+		break;
+	default:
+		break;
+	}
+	const ut8 *data = file;
+	if (kernel) {
+		bin->kernel = rz_buf_new_with_pointers(kernel, size, true);
+		if (!bin->kernel) {
+			free(kernel);
+			free(file);
+			return;
+		}
+		data = kernel;
+	} else {
+		size = file_size;
+	}
+	parse_elf(bin, data, size);
+	load_symbols(bin, data, size);
+	free(file);
+}
+
+static void zimg_symbol_fini(void *e, void *user) {
+	RzBinZimgSymbol *sym = e;
+	free(sym->name);
+}
+
+RzBinZimgKind rz_bin_zimg_kind(RzBuffer *buf) {
+	ut8 tmp[8];
+	ut16 flag;
+	ut32 magic;
+	if (rz_buf_read_at(buf, ARM64_IMAGE_MAGIC_OFFSET, tmp, 4) == 4 && !memcmp(tmp, "ARM\x64", 4)) {
+		return RZ_BIN_ZIMG_KIND_ARM64_IMAGE;
+	}
+	if (rz_buf_read_at(buf, BZIMAGE_HEADER, tmp, 4) == 4 && !memcmp(tmp, "HdrS", 4) &&
+		rz_buf_read_le16_at(buf, BZIMAGE_BOOT_FLAG, &flag) && flag == 0xaa55) {
+		return RZ_BIN_ZIMG_KIND_X86_BZIMAGE;
+	}
+	if (rz_buf_read_at(buf, 0, tmp, 8) == 8 && !memcmp(tmp, "\x00\x00\xa0\xe1\x00\x00\xa0\xe1", 8)) {
+		return RZ_BIN_ZIMG_KIND_ARM_ZIMAGE;
+	}
+	if (rz_buf_read_le32_at(buf, ZIMAGE_MAGIC_OFFSET, &magic) && magic == ZIMAGE_MAGIC) {
+		return RZ_BIN_ZIMG_KIND_ARM_ZIMAGE;
+	}
+	return RZ_BIN_ZIMG_KIND_RAW;
+}
+
 struct rz_bin_zimg_obj_t *rz_bin_zimg_new_buf(RzBuffer *buf) {
 	struct rz_bin_zimg_obj_t *bin = RZ_NEW0(struct rz_bin_zimg_obj_t);
 	if (!bin) {
@@ -16,6 +531,11 @@ struct rz_bin_zimg_obj_t *rz_bin_zimg_new_buf(RzBuffer *buf) {
 		goto fail;
 	}
 	rz_buf_read_at(bin->b, 0, (ut8 *)&bin->header, sizeof(bin->header));
+	rz_vector_init(&bin->segments, sizeof(RzBinZimgSegment), NULL, NULL);
+	rz_vector_init(&bin->symbols, sizeof(RzBinZimgSymbol), zimg_symbol_fini, NULL);
+	bin->kind = rz_bin_zimg_kind(buf);
+	bin->base = UT64_MAX;
+	load_kernel(bin);
 	return bin;
 
 fail:
@@ -25,3 +545,37 @@ fail:
 	}
 	return NULL;
 }
+
+void rz_bin_zimg_free(struct rz_bin_zimg_obj_t *bin) {
+	if (!bin) {
+		return;
+	}
+	rz_vector_fini(&bin->symbols);
+	rz_vector_fini(&bin->segments);
+	rz_buf_free(bin->kernel);
+	rz_buf_free(bin->b);
+	free(bin);
+}
+
+const RzBinZimgSymbol *rz_bin_zimg_get_symbol(struct rz_bin_zimg_obj_t *bin, const char *name) {
+	RzBinZimgSymbol *sym;
+	rz_vector_foreach(&bin->symbols, sym) {
+		if (!strcmp(sym->name, name)) {
+			return sym;
+		}
+	}
+	return NULL;
+}
+
+/**
+ * \brief Translates \p vaddr to an offset in the kernel, UT64_MAX if it is not backed by data
+ */
+ut64 rz_bin_zimg_vaddr_to_paddr(struct rz_bin_zimg_obj_t *bin, ut64 vaddr) {
+	RzBinZimgSegment *seg;
+	rz_vector_foreach(&bin->segments, seg) {
+		if (vaddr >= seg->vaddr && vaddr - seg->vaddr < seg->psize) {
+			return seg->paddr + (vaddr - seg->vaddr);
+		}
+	}
+	return UT64_MAX;
+}
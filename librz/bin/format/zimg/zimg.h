@@ -19,6 +19,33 @@ struct zimg_header_t {
 	ut32 kernel_end;
 };
 
+typedef enum {
+	RZ_BIN_ZIMG_KIND_RAW, ///< vmlinux or Image blob without any header, only loaded when forced
+	RZ_BIN_ZIMG_KIND_ARM_ZIMAGE, ///< ARM zImage, self-decompressing
+	RZ_BIN_ZIMG_KIND_X86_BZIMAGE, ///< x86 bzImage, real mode setup followed by the compressed vmlinux
+	RZ_BIN_ZIMG_KIND_ARM64_IMAGE, ///< Uncompressed arm64 Image
+} RzBinZimgKind;
+
+/**
+ * \brief A symbol recovered from the kallsyms tables
+ */
+typedef struct rz_bin_zimg_symbol_t {
+	ut64 vaddr;
+	char type; ///< Type as printed by nm, e.g. 'T' for global text or 'd' for local data
+	char *name;
+} RzBinZimgSymbol;
+
+/**
+ * \brief A loadable part of the kernel image, either an ELF segment or the whole raw image
+ */
+typedef struct rz_bin_zimg_segment_t {
+	ut64 paddr; ///< Offset in the kernel image
+	ut64 psize;
+	ut64 vaddr;
+	ut64 vsize;
+	ut32 perm;
+} RzBinZimgSegment;
+
 typedef struct rz_bin_zimg_obj_t {
 	int size;
 	const char *file;
@@ -28,6 +55,15 @@ typedef struct rz_bin_zimg_obj_t {
 	ut64 code_from;
 	ut64 code_to;
 	Sdb *kv;
+	RzBinZimgKind kind;
+	const char *compression; ///< Compression of the kernel payload, NULL if it is not compressed
+	RzBuffer *kernel; ///< Decompressed kernel, NULL if the kernel is the file itself
+	const char *arch;
+	int bits;
+	bool big_endian;
+	ut64 base; ///< Virtual address of the start of the kernel, UT64_MAX if unknown
+	RzVector /*<RzBinZimgSegment>*/ segments;
+	RzVector /*<RzBinZimgSymbol>*/ symbols; ///< Sorted by address
 } RzBinZimgObj;
 
 struct rz_bin_zimg_str_t {
@@ -39,6 +75,13 @@ struct rz_bin_zimg_str_t {
 };
 
 struct rz_bin_zimg_obj_t *rz_bin_zimg_new_buf(RzBuffer *buf);
+void rz_bin_zimg_free(struct rz_bin_zimg_obj_t *bin);
+RzBinZimgKind rz_bin_zimg_kind(RzBuffer *buf);
+const RzBinZimgSymbol *rz_bin_zimg_get_symbol(struct rz_bin_zimg_obj_t *bin, const char *name);
+ut64 rz_bin_zimg_vaddr_to_paddr(struct rz_bin_zimg_obj_t *bin, ut64 vaddr);
 struct rz_bin_zimg_str_t *rz_bin_zimg_get_strings(struct rz_bin_zimg_obj_t *bin);
 
+/* kallsyms.c */
+bool rz_bin_zimg_kallsyms(const ut8 *data, size_t size, int *ptr_size, RzVector /*<RzBinZimgSymbol>*/ *symbols, bool *big_endian);
+
 #endif
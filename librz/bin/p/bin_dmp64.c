@@ -196,18 +196,20 @@ static RzList /*<RzBinMap *>*/ *maps(RzBinFile *bf) {
 		return NULL;
 	}
 
-	rz_list_foreach (obj->pages, it, page) {
-		RzBinMap *map = RZ_NEW0(RzBinMap);
-		if (!map) {
-			return ret;
+	if (obj->pages) {
+		rz_vector_foreach(obj->pages, page) {
+			RzBinMap *map = RZ_NEW0(RzBinMap);
+			if (!map) {
+				return ret;
+			}
+			map->name = rz_str_newf("page.0x%" PFMT64x, page->start);
+			map->paddr = page->file_offset;
+			map->psize = page->size;
+			map->vaddr = page->start;
+			map->vsize = page->size;
+			map->perm = RZ_PERM_R;
+			rz_list_append(ret, map);
 		}
-		map->name = rz_str_newf("page.0x%" PFMT64x, page->start);
-		map->paddr = page->file_offset;
-		map->psize = page->size;
-		map->vaddr = page->start;
-		map->vsize = page->size;
-		map->perm = RZ_PERM_R;
-		rz_list_append(ret, map);
 	}
 
 	rz_list_foreach (obj->datablocks, it, datablock) {
@@ -39,10 +39,12 @@ RzBinPlugin rz_bin_plugin_elf64 = {
 	.size = &size,
 	.libs = &libs,
 	.relocs = &relocs,
+	.unwind_functions = &unwind_functions,
 	.create = &create_elf,
 	.get_vaddr = &get_elf_vaddr64,
 	.file_type = &get_file_type,
 	.regstate = &regstate,
+	.threads = &threads,
 	.section_type_to_string = &Elf_(rz_bin_elf_section_type_to_string),
 	.section_flag_to_rzlist = &Elf_(rz_bin_elf_section_flag_to_rzlist),
 	.destroy = destroy,
@@ -576,6 +576,133 @@ static RzPVector /*<RzBinTrycatch *>*/ *trycatch(RzBinFile *bf) {
 	return tc_vec;
 }
 
+typedef struct {
+	ut8 offset; ///< offset of the end of the prolog instruction
+	ut32 size; ///< bytes allocated on the stack
+	bool set_fp;
+} WinUnwindOp;
+
+/**
+ * Convert the prolog unwind codes at \p paddr to stack layout rows of \p fcn.
+ */
+static void unwind_rows_read(RzBinPEObj *bin, RzBinUnwindFunction *fcn, ut64 paddr) {
+	WinUnwindInfo info;
+	if (!windows_unwind_info_read(&info, bin->b, paddr) || (info.Version != 1 && info.Version != 2)) {
+		return;
+	}
+	if (info.Flags & PE64_UNW_FLAG_CHAININFO) {
+		// the prolog is the one of the function this entry is chained to
+		fcn->fragment = true;
+		return;
+	}
+	ut8 slots[0x200];
+	st64 len = info.CountOfCodes * sizeof(PE64_UNWIND_CODE);
+	if (rz_buf_read_at(bin->b, paddr + offsetof(PE64_UNWIND_INFO, UnwindCode), slots, len) != len) {
+		return;
+	}
+	WinUnwindOp ops[0x100];
+	size_t n = 0;
+	for (size_t i = 0; i < info.CountOfCodes; i++) {
+		WinUnwindOp op = { .offset = slots[i * 2] };
+		ut8 info_bits = slots[i * 2 + 1] >> 4;
+		switch (slots[i * 2 + 1] & 0xf) {
+		case UWOP_PUSH_NONVOL:
+			op.size = 8;
+			break;
+		case UWOP_ALLOC_LARGE:
+			if (!info_bits && i + 1 < info.CountOfCodes) {
+				op.size = rz_read_le16(slots + (i + 1) * 2) * 8;
+				i++;
+			} else if (info_bits && i + 2 < info.CountOfCodes) {
+				op.size = rz_read_le32(slots + (i + 1) * 2);
+				i += 2;
+			} else {
+				return;
+			}
+			break;
+		case UWOP_ALLOC_SMALL:
+			op.size = info_bits * 8 + 8;
+			break;
+		case UWOP_SET_FPREG:
+			op.set_fp = true;
+			break;
+		case UWOP_SAVE_NONVOL:
+		case UWOP_UNKNOWN1:
+		case UWOP_SAVE_XMM128:
+			i++;
+			continue;
+		case UWOP_SAVE_NONVOL_FAR:
+		case UWOP_UNKNOWN2:
+		case UWOP_SAVE_XMM128_FAR:
+			i += 2;
+			continue;
+		case UWOP_PUSH_MACHFRAME:
+			op.size = info_bits ? 48 : 40;
+			break;
+		default:
+			return;
+		}
+		ops[n++] = op;
+	}
+	// the codes are sorted from the end of the prolog to its start
+	st64 cfa_offset = 8;
+	bool frame_based = false;
+	while (n--) {
+		if (ops[n].set_fp && !frame_based) {
+			frame_based = true;
+			cfa_offset -= info.FrameOffset * 16;
+		} else if (!frame_based) {
+			cfa_offset += ops[n].size;
+		}
+		rz_bin_unwind_function_push_row(fcn, fcn->vaddr + ops[n].offset, cfa_offset, frame_based);
+	}
+}
+
+static RzPVector /*<RzBinUnwindFunction *>*/ *unwind_functions(RzBinFile *bf) {
+	struct PE_(rz_bin_pe_obj_t) *bin = bf->o->bin_obj;
+	if (bin->optional_header->NumberOfRvaAndSizes <= PE_IMAGE_DIRECTORY_ENTRY_EXCEPTION) {
+		return NULL;
+	}
+	PE_(image_data_directory) *dir = &bin->optional_header->DataDirectory[PE_IMAGE_DIRECTORY_ENTRY_EXCEPTION];
+	if (!dir->VirtualAddress || !dir->Size) {
+		return NULL;
+	}
+	const struct rz_bin_pe_section_t *pdata = get_section(bin, NULL, dir->VirtualAddress);
+	if (!pdata) {
+		return NULL;
+	}
+	RzPVector *fcns = rz_pvector_new((RzPVectorFree)rz_bin_unwind_function_free);
+	if (!fcns) {
+		return NULL;
+	}
+	const ut64 ba = baddr(bf);
+	const ut64 paddr = rva_to_paddr(pdata, dir->VirtualAddress);
+	const ut64 end = RZ_MIN(rz_buf_size(bin->b), paddr + dir->Size);
+	const struct rz_bin_pe_section_t *unwind_data_section = NULL;
+	for (ut64 offset = paddr; offset + sizeof(PE64_RUNTIME_FUNCTION) <= end; offset += sizeof(PE64_RUNTIME_FUNCTION)) {
+		PE64_RUNTIME_FUNCTION rfcn = { 0 };
+		if (!read_pe64_runtime_function(bin->b, offset, &rfcn, bin->big_endian) || !rfcn.BeginAddress) {
+			break;
+		}
+		if (rfcn.EndAddress <= rfcn.BeginAddress) {
+			continue;
+		}
+		RzBinUnwindFunction *fcn = rz_bin_unwind_function_new(ba + rfcn.BeginAddress, rfcn.EndAddress - rfcn.BeginAddress);
+		if (!fcn) {
+			break;
+		}
+		// only the return address is on the stack at entry
+		rz_bin_unwind_function_push_row(fcn, fcn->vaddr, 8, false);
+		if (rfcn.UnwindData & 1) {
+			fcn->fragment = true;
+		} else if ((unwind_data_section = get_section(bin, unwind_data_section, rfcn.UnwindData))) {
+			unwind_rows_read(bin, fcn, rva_to_paddr(unwind_data_section, rfcn.UnwindData));
+		}
+		rz_pvector_push(fcns, fcn);
+	}
+	return fcns;
+}
+
 RzBinPlugin rz_bin_plugin_pe64 = {
 	.name = "pe64",
 	.desc = "PE64 (PE32+) bin plugin",
@@ -600,6 +727,7 @@ RzBinPlugin rz_bin_plugin_pe64 = {
 	.get_offset = &get_offset,
 	.get_vaddr = &get_vaddr,
 	.trycatch = &trycatch,
+	.unwind_functions = &unwind_functions,
 	.hashes = &compute_hashes,
 	.resources = &resources,
 	.section_flag_to_rzlist = &PE_(section_flag_to_rzlist),
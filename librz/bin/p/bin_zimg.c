@@ -13,44 +13,226 @@ static Sdb *get_sdb(RzBinFile *bf) {
 	return bin ? bin->kv : NULL;
 }
 
+#define VFILE_NAME_KERNEL "kernel"
+
 static bool load_buffer(RzBinFile *bf, RzBinObject *obj, RzBuffer *b, Sdb *sdb) {
 	obj->bin_obj = rz_bin_zimg_new_buf(b);
 	return obj->bin_obj != NULL;
 }
 
+static void destroy(RzBinFile *bf) {
+	rz_bin_zimg_free(bf->o->bin_obj);
+}
+
 static ut64 baddr(RzBinFile *bf) {
-	return 0;
+	RzBinZimgObj *bin = bf->o->bin_obj;
+	return bin->base != UT64_MAX ? bin->base : 0;
 }
 
 static bool check_buffer(RzBuffer *b) {
-	ut8 zimghdr[8];
-	if (rz_buf_read_at(b, 0, zimghdr, sizeof(zimghdr))) {
-		// Checking ARM zImage kernel
-		if (!memcmp(zimghdr, "\x00\x00\xa0\xe1\x00\x00\xa0\xe1", 8)) {
-			return true;
+	return rz_bin_zimg_kind(b) != RZ_BIN_ZIMG_KIND_RAW;
+}
+
+static RzList /*<RzBinVirtualFile *>*/ *virtual_files(RzBinFile *bf) {
+	RzList *ret = rz_list_newf((RzListFree)rz_bin_virtual_file_free);
+	if (!ret) {
+		return NULL;
+	}
+	RzBinZimgObj *bin = bf->o->bin_obj;
+	if (bin->kernel) {
+		RzBinVirtualFile *vf = RZ_NEW0(RzBinVirtualFile);
+		if (!vf) {
+			return ret;
+		}
+		vf->buf = bin->kernel;
+		vf->buf_owned = false;
+		vf->name = strdup(VFILE_NAME_KERNEL);
+		rz_list_push(ret, vf);
+	}
+	return ret;
+}
+
+static RzList /*<RzBinMap *>*/ *maps(RzBinFile *bf) {
+	RzBinZimgObj *bin = bf->o->bin_obj;
+	if (rz_vector_empty(&bin->segments)) {
+		// Nothing known about the layout, let the whole file be mapped
+		return NULL;
+	}
+	RzList *ret = rz_list_newf((RzListFree)rz_bin_map_free);
+	if (!ret) {
+		return NULL;
+	}
+	RzBinZimgSegment *seg;
+	size_t i = 0;
+	rz_vector_foreach(&bin->segments, seg) {
+		RzBinMap *map = RZ_NEW0(RzBinMap);
+		if (!map) {
+			return ret;
+		}
+		map->name = rz_vector_len(&bin->segments) > 1 ? rz_str_newf("LOAD%" PFMTSZu, i) : strdup(VFILE_NAME_KERNEL);
+		map->paddr = seg->paddr;
+		map->psize = seg->psize;
+		map->vaddr = seg->vaddr;
+		map->vsize = seg->vsize;
+		map->perm = seg->perm;
+		map->vfile_name = bin->kernel ? strdup(VFILE_NAME_KERNEL) : NULL;
+		rz_list_append(ret, map);
+		i++;
+	}
+	return ret;
+}
+
+static const struct {
+	const char *name;
+	const char *start;
+	const char *end;
+	ut32 perm;
+} kernel_sections[] = {
+	{ ".text", "_stext", "_etext", RZ_PERM_RX },
+	{ ".rodata", "__start_rodata", "__end_rodata", RZ_PERM_R },
+	{ ".init", "__init_begin", "__init_end", RZ_PERM_RWX },
+	{ ".data", "_sdata", "_edata", RZ_PERM_RW },
+	{ ".bss", "__bss_start", "__bss_stop", RZ_PERM_RW },
+};
+
+static RzList /*<RzBinSection *>*/ *sections(RzBinFile *bf) {
+	RzBinZimgObj *bin = bf->o->bin_obj;
+	RzList *mappies = maps(bf);
+	if (!mappies) {
+		return NULL;
+	}
+	RzList *ret = rz_list_newf((RzListFree)rz_bin_section_free);
+	if (!ret) {
+		rz_list_free(mappies);
+		return NULL;
+	}
+	// The kernel has no section headers, the linker script marks their bounds
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(kernel_sections); i++) {
+		const RzBinZimgSymbol *start = rz_bin_zimg_get_symbol(bin, kernel_sections[i].start);
+		const RzBinZimgSymbol *end = rz_bin_zimg_get_symbol(bin, kernel_sections[i].end);
+		if (!start || !end || end->vaddr <= start->vaddr) {
+			continue;
+		}
+		RzBinSection *ptr = rz_bin_section_new(kernel_sections[i].name);
+		if (!ptr) {
+			break;
 		}
+		ptr->vaddr = start->vaddr;
+		ptr->vsize = end->vaddr - start->vaddr;
+		ptr->paddr = rz_bin_zimg_vaddr_to_paddr(bin, start->vaddr);
+		if (ptr->paddr == UT64_MAX) {
+			ptr->paddr = 0;
+		} else {
+			ptr->size = ptr->vsize;
+		}
+		ptr->perm = kernel_sections[i].perm;
+		rz_list_append(ret, ptr);
+	}
+	RzList *msecs = rz_bin_sections_of_maps(mappies);
+	if (msecs) {
+		rz_list_join(ret, msecs);
+		rz_list_free(msecs);
+	}
+	rz_list_free(mappies);
+	return ret;
+}
+
+static RzList /*<RzBinSymbol *>*/ *symbols(RzBinFile *bf) {
+	RzBinZimgObj *bin = bf->o->bin_obj;
+	if (rz_vector_empty(&bin->symbols)) {
+		return NULL;
+	}
+	RzList *ret = rz_list_newf((RzListFree)rz_bin_symbol_free);
+	if (!ret) {
+		return NULL;
+	}
+	size_t count = rz_vector_len(&bin->symbols);
+	for (size_t i = 0; i < count; i++) {
+		RzBinZimgSymbol *sym = rz_vector_index_ptr(&bin->symbols, i);
+		ut64 paddr = bin->kernel ? UT64_MAX : rz_bin_zimg_vaddr_to_paddr(bin, sym->vaddr);
+		RzBinSymbol *ptr = rz_bin_symbol_new(sym->name, paddr, sym->vaddr);
+		if (!ptr) {
+			break;
+		}
+		char type = sym->type;
+		bool func = type == 'T' || type == 't' || type == 'W' || type == 'w';
+		ptr->type = func ? RZ_BIN_TYPE_FUNC_STR : RZ_BIN_TYPE_OBJECT_STR;
+		ptr->bind = type == 'W' || type == 'w' ? RZ_BIN_BIND_WEAK_STR : IS_UPPER(type) ? RZ_BIN_BIND_GLOBAL_STR
+											   : RZ_BIN_BIND_LOCAL_STR;
+		// Functions are laid out one after the other, so their size is the
+		// distance to the next symbol
+		for (size_t j = i + 1; func && j < count; j++) {
+			RzBinZimgSymbol *next = rz_vector_index_ptr(&bin->symbols, j);
+			if (next->vaddr > sym->vaddr) {
+				ptr->size = next->vaddr - sym->vaddr;
+				break;
+			}
+		}
+		ptr->ordinal = i;
+		rz_list_append(ret, ptr);
+	}
+	return ret;
+}
+
+static RzList /*<RzBinAddr *>*/ *entries(RzBinFile *bf) {
+	RzBinZimgObj *bin = bf->o->bin_obj;
+	if (bin->base == UT64_MAX) {
+		return NULL;
+	}
+	RzList *ret = rz_list_newf(free);
+	if (!ret) {
+		return NULL;
+	}
+	RzBinAddr *ptr = RZ_NEW0(RzBinAddr);
+	if (!ptr) {
+		return ret;
+	}
+	ptr->vaddr = bin->base;
+	ptr->paddr = bin->kernel ? UT64_MAX : rz_bin_zimg_vaddr_to_paddr(bin, bin->base);
+	rz_list_append(ret, ptr);
+	return ret;
+}
+
+static const char *kind_type(RzBinZimgKind kind) {
+	switch (kind) {
+	case RZ_BIN_ZIMG_KIND_ARM_ZIMAGE:
+		return "Linux zImage Kernel";
+	case RZ_BIN_ZIMG_KIND_X86_BZIMAGE:
+		return "Linux bzImage Kernel";
+	case RZ_BIN_ZIMG_KIND_ARM64_IMAGE:
+		return "Linux arm64 Image Kernel";
+	default:
+		return "Linux Kernel";
 	}
-	return false;
 }
 
 static RzBinInfo *info(RzBinFile *bf) {
+	RzBinZimgObj *bin = bf->o->bin_obj;
 	RzBinInfo *ret = RZ_NEW0(RzBinInfo);
 	if (!ret) {
 		return NULL;
 	}
+	const char *arch = bin->arch ? bin->arch : "arm";
 	ret->file = bf->file ? strdup(bf->file) : NULL;
-	ret->type = strdup("Linux zImage Kernel");
-	ret->has_va = false;
-	ret->bclass = strdup("Compressed Linux Kernel");
+	ret->type = strdup(kind_type(bin->kind));
+	ret->has_va = !rz_vector_empty(&bin->segments);
+	ret->bclass = bin->compression ? rz_str_newf("Compressed Linux Kernel (%s)", bin->compression) : strdup(bin->kernel ? "Compressed Linux Kernel" : "Linux Kernel");
 	ret->rclass = strdup("zimg");
 	ret->os = strdup("linux");
 	ret->subsystem = strdup("linux");
-	ret->machine = strdup("ARM"); // TODO: can be other cpus
-	ret->arch = strdup("arm");
+	if (!strcmp(arch, "x86")) {
+		ret->machine = strdup(bin->bits == 64 ? "AMD x86-64" : "Intel 80386");
+	} else if (!strcmp(arch, "arm")) {
+		ret->machine = strdup(bin->bits == 64 ? "ARM64" : "ARM");
+	} else {
+		ret->machine = strdup(arch);
+		rz_str_case(ret->machine, true);
+	}
+	ret->arch = strdup(arch);
 	ret->lang = "C";
-	ret->bits = 32;
-	ret->big_endian = 0;
-	ret->dbg_info = 0; // 1 | 4 | 8; /* Stripped | LineNums | Syms */
+	ret->bits = bin->bits ? bin->bits : 32;
+	ret->big_endian = bin->big_endian;
+	ret->dbg_info = rz_vector_empty(&bin->symbols) ? 0 : RZ_BIN_DBG_SYMS;
 	return ret;
 }
 
@@ -60,8 +242,14 @@ RzBinPlugin rz_bin_plugin_zimg = {
 	.license = "LGPL3",
 	.get_sdb = &get_sdb,
 	.load_buffer = &load_buffer,
+	.destroy = &destroy,
 	.check_buffer = &check_buffer,
 	.baddr = &baddr,
+	.entries = &entries,
+	.virtual_files = &virtual_files,
+	.maps = &maps,
+	.sections = &sections,
+	.symbols = &symbols,
 	.info = &info,
 };
 
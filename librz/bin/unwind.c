@@ -0,0 +1,551 @@
+// SPDX-FileCopyrightText: 2023 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+/**
+ * \file unwind.c
+ * Function ranges and stack layouts described by unwind tables.
+ *
+ * Only the location of the canonical frame address (CFA) is tracked, which is
+ * all that is needed to know the stack pointer at every address of a function.
+ */
+
+#include <rz_bin.h>
+
+// pointer encodings of .eh_frame, see the LSB Core Specification
+#define DW_EH_PE_absptr   0x00
+#define DW_EH_PE_uleb128  0x01
+#define DW_EH_PE_udata2   0x02
+#define DW_EH_PE_udata4   0x03
+#define DW_EH_PE_udata8   0x04
+#define DW_EH_PE_sleb128  0x09
+#define DW_EH_PE_sdata2   0x0a
+#define DW_EH_PE_sdata4   0x0b
+#define DW_EH_PE_sdata8   0x0c
+#define DW_EH_PE_pcrel    0x10
+#define DW_EH_PE_indirect 0x80
+#define DW_EH_PE_omit     0xff
+
+#define DW_CFA_GNU_args_size                0x2e
+#define DW_CFA_GNU_negative_offset_extended 0x2f
+
+// depth of DW_CFA_remember_state nesting that is tracked
+#define EH_FRAME_MAX_STATES 0x10
+
+RZ_API RZ_OWN RzBinUnwindFunction *rz_bin_unwind_function_new(ut64 vaddr, ut64 size) {
+	RzBinUnwindFunction *fcn = RZ_NEW0(RzBinUnwindFunction);
+	if (!fcn) {
+		return NULL;
+	}
+	fcn->vaddr = vaddr;
+	fcn->size = size;
+	rz_vector_init(&fcn->rows, sizeof(RzBinUnwindRow), NULL, NULL);
+	return fcn;
+}
+
+RZ_API void rz_bin_unwind_function_free(RZ_NULLABLE RzBinUnwindFunction *fcn) {
+	if (!fcn) {
+		return;
+	}
+	rz_vector_fini(&fcn->rows);
+	free(fcn);
+}
+
+/**
+ * \brief Append the stack layout from \p vaddr on, merging it with the last row if possible
+ */
+RZ_API bool rz_bin_unwind_function_push_row(RZ_NONNULL RzBinUnwindFunction *fcn, ut64 vaddr, st64 cfa_offset, bool frame_based) {
+	rz_return_val_if_fail(fcn, false);
+	RzBinUnwindRow *last = rz_vector_empty(&fcn->rows) ? NULL : rz_vector_tail(&fcn->rows);
+	if (last && last->cfa_offset == cfa_offset && last->frame_based == frame_based) {
+		return true;
+	}
+	if (last && last->vaddr >= vaddr) {
+		last->cfa_offset = cfa_offset;
+		last->frame_based = frame_based;
+		return true;
+	}
+	RzBinUnwindRow row = { vaddr, cfa_offset, frame_based };
+	return rz_vector_push(&fcn->rows, &row) != NULL;
+}
+
+/**
+ * \brief Get the stack layout in effect at \p vaddr, or NULL if it is outside of \p fcn
+ */
+RZ_API RZ_BORROW const RzBinUnwindRow *rz_bin_unwind_function_row_at(RZ_NONNULL const RzBinUnwindFunction *fcn, ut64 vaddr) {
+	rz_return_val_if_fail(fcn, NULL);
+	if (vaddr < fcn->vaddr || vaddr - fcn->vaddr >= fcn->size) {
+		return NULL;
+	}
+	const RzBinUnwindRow *rows = rz_vector_index_ptr(&fcn->rows, 0);
+	size_t lo = 0, hi = rz_vector_len(&fcn->rows);
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		if (rows[mid].vaddr <= vaddr) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo ? &rows[lo - 1] : NULL;
+}
+
+typedef struct {
+	const ut8 *data;
+	const ut8 *end;
+	ut64 vaddr; ///< address of data, for pc-relative pointers
+	int addr_size;
+	bool big_endian;
+	ut32 sp_reg;
+} EhFrameCtx;
+
+typedef struct {
+	ut64 code_align;
+	st64 data_align;
+	ut8 fde_enc;
+	bool has_aug_data;
+	const ut8 *insns;
+	const ut8 *insns_end;
+} EhCie;
+
+typedef struct {
+	ut64 cfa_reg;
+	st64 cfa_offset;
+	bool cfa_expr;
+} EhCfa;
+
+static bool eh_uleb(const ut8 **p, const ut8 *end, ut64 *v) {
+	if (*p >= end) {
+		return false;
+	}
+	const ut8 *next = rz_uleb128(*p, end - *p, v, NULL);
+	if (!next || next > end) {
+		return false;
+	}
+	*p = next;
+	return true;
+}
+
+static bool eh_sleb(const ut8 **p, const ut8 *end, st64 *v) {
+	if (*p >= end) {
+		return false;
+	}
+	*v = rz_sleb128(p, end);
+	return *p <= end;
+}
+
+static bool eh_read_encoded(const EhFrameCtx *ctx, const ut8 **p, const ut8 *end, ut8 enc, ut64 *out) {
+	if (enc == DW_EH_PE_omit) {
+		*out = 0;
+		return true;
+	}
+	if (enc & DW_EH_PE_indirect) {
+		return false;
+	}
+	const ut8 *start = *p;
+	size_t avail = end - *p;
+	ut64 v;
+	switch (enc & 0x0f) {
+	case DW_EH_PE_absptr:
+		if (avail < (size_t)ctx->addr_size) {
+			return false;
+		}
+		v = ctx->addr_size == 8 ? rz_read_ble64(*p, ctx->big_endian) : rz_read_ble32(*p, ctx->big_endian);
+		*p += ctx->addr_size;
+		break;
+	case DW_EH_PE_uleb128:
+		if (!eh_uleb(p, end, &v)) {
+			return false;
+		}
+		break;
+	case DW_EH_PE_sleb128: {
+		st64 s;
+		if (!eh_sleb(p, end, &s)) {
+			return false;
+		}
+		v = s;
+		break;
+	}
+	case DW_EH_PE_udata2:
+	case DW_EH_PE_sdata2:
+		if (avail < 2) {
+			return false;
+		}
+		v = rz_read_ble16(*p, ctx->big_endian);
+		if ((enc & 0x0f) == DW_EH_PE_sdata2) {
+			v = (st16)v;
+		}
+		*p += 2;
+		break;
+	case DW_EH_PE_udata4:
+	case DW_EH_PE_sdata4:
+		if (avail < 4) {
+			return false;
+		}
+		v = rz_read_ble32(*p, ctx->big_endian);
+		if ((enc & 0x0f) == DW_EH_PE_sdata4) {
+			v = (st32)v;
+		}
+		*p += 4;
+		break;
+	case DW_EH_PE_udata8:
+	case DW_EH_PE_sdata8:
+		if (avail < 8) {
+			return false;
+		}
+		v = rz_read_ble64(*p, ctx->big_endian);
+		*p += 8;
+		break;
+	default:
+		return false;
+	}
+	switch (enc & 0x70) {
+	case DW_EH_PE_absptr:
+		break;
+	case DW_EH_PE_pcrel:
+		v += ctx->vaddr + (start - ctx->data);
+		break;
+	default:
+		// text, data and function relative pointers are not used for code ranges in practice
+		return false;
+	}
+	*out = ctx->addr_size == 4 ? v & UT32_MAX : v;
+	return true;
+}
+
+static bool eh_cie_parse(const EhFrameCtx *ctx, const ut8 *p, const ut8 *end, EhCie *cie) {
+	memset(cie, 0, sizeof(*cie));
+	cie->fde_enc = DW_EH_PE_absptr;
+	if (p >= end) {
+		return false;
+	}
+	ut8 version = *p++;
+	const char *aug = (const char *)p;
+	const ut8 *aug_end = memchr(p, 0, end - p);
+	if (!aug_end) {
+		return false;
+	}
+	p = aug_end + 1;
+	if (strstr(aug, "eh")) {
+		p += ctx->addr_size;
+	}
+	ut64 ret_reg;
+	if (!eh_uleb(&p, end, &cie->code_align) || !eh_sleb(&p, end, &cie->data_align)) {
+		return false;
+	}
+	if (version == 1) {
+		p++;
+	} else if (!eh_uleb(&p, end, &ret_reg)) {
+		return false;
+	}
+	if (*aug == 'z') {
+		ut64 aug_len;
+		if (!eh_uleb(&p, end, &aug_len) || aug_len > (ut64)(end - p)) {
+			return false;
+		}
+		const ut8 *data = p;
+		const ut8 *data_end = p + aug_len;
+		for (const char *c = aug + 1; *c; c++) {
+			ut64 personality;
+			switch (*c) {
+			case 'L':
+				data++;
+				break;
+			case 'P': {
+				// only skipped, so its application does not matter
+				if (data >= data_end) {
+					return false;
+				}
+				ut8 enc = *data++;
+				if (!eh_read_encoded(ctx, &data, data_end, enc & 0x0f, &personality)) {
+					return false;
+				}
+				break;
+			}
+			case 'R':
+				if (data < data_end) {
+					cie->fde_enc = *data++;
+				}
+				break;
+			default:
+				// 'S' and 'B' carry no data, anything else ends the parsable augmentations
+				break;
+			}
+		}
+		cie->has_aug_data = true;
+		p = data_end;
+	}
+	if (p > end) {
+		return false;
+	}
+	cie->insns = p;
+	cie->insns_end = end;
+	return true;
+}
+
+static void eh_cfa_record(const EhFrameCtx *ctx, const EhCfa *cfa, RzBinUnwindFunction *fcn, ut64 loc) {
+	if (fcn) {
+		rz_bin_unwind_function_push_row(fcn, loc, cfa->cfa_offset, cfa->cfa_expr || cfa->cfa_reg != ctx->sp_reg);
+	}
+}
+
+/**
+ * Run the call frame instructions in [p, end) starting at \p loc, recording every
+ * change of the CFA in \p fcn if it is given.
+ */
+static bool eh_cfa_run(const EhFrameCtx *ctx, const EhCie *cie, const ut8 *p, const ut8 *end, EhCfa *cfa, RZ_NULLABLE RzBinUnwindFunction *fcn, ut64 loc) {
+	EhCfa states[EH_FRAME_MAX_STATES];
+	size_t depth = 0;
+	while (p < end) {
+		ut8 op = *p++;
+		ut64 a, b;
+		st64 s;
+		switch (op & 0xc0) {
+		case DW_CFA_advance_loc:
+			loc += (op & 0x3f) * cie->code_align;
+			continue;
+		case DW_CFA_offset:
+			if (!eh_uleb(&p, end, &a)) {
+				return false;
+			}
+			continue;
+		case DW_CFA_restore:
+			continue;
+		default:
+			break;
+		}
+		switch (op) {
+		case DW_CFA_nop:
+			break;
+		case DW_CFA_set_loc:
+			if (!eh_read_encoded(ctx, &p, end, cie->fde_enc, &loc)) {
+				return false;
+			}
+			break;
+		case DW_CFA_advance_loc1:
+			if (end - p < 1) {
+				return false;
+			}
+			loc += *p++ * cie->code_align;
+			break;
+		case DW_CFA_advance_loc2:
+			if (end - p < 2) {
+				return false;
+			}
+			loc += rz_read_ble16(p, ctx->big_endian) * cie->code_align;
+			p += 2;
+			break;
+		case DW_CFA_advance_loc4:
+			if (end - p < 4) {
+				return false;
+			}
+			loc += rz_read_ble32(p, ctx->big_endian) * cie->code_align;
+			p += 4;
+			break;
+		case DW_CFA_restore_extended:
+		case DW_CFA_undefined:
+		case DW_CFA_same_value:
+		case DW_CFA_GNU_args_size:
+			if (!eh_uleb(&p, end, &a)) {
+				return false;
+			}
+			break;
+		case DW_CFA_offse_extended:
+		case DW_CFA_register:
+		case DW_CFA_val_offset:
+		case DW_CFA_GNU_negative_offset_extended:
+			if (!eh_uleb(&p, end, &a) || !eh_uleb(&p, end, &b)) {
+				return false;
+			}
+			break;
+		case DW_CFA_offset_extended_sf:
+		case DW_CFA_val_offset_sf:
+			if (!eh_uleb(&p, end, &a) || !eh_sleb(&p, end, &s)) {
+				return false;
+			}
+			break;
+		case DW_CFA_expression:
+		case DW_CFA_val_expression:
+			if (!eh_uleb(&p, end, &a) || !eh_uleb(&p, end, &b) || b > (ut64)(end - p)) {
+				return false;
+			}
+			p += b;
+			break;
+		case DW_CFA_remember_state:
+			if (depth < EH_FRAME_MAX_STATES) {
+				states[depth] = *cfa;
+			}
+			depth++;
+			break;
+		case DW_CFA_restore_state:
+			if (!depth) {
+				return false;
+			}
+			depth--;
+			if (depth < EH_FRAME_MAX_STATES) {
+				*cfa = states[depth];
+				eh_cfa_record(ctx, cfa, fcn, loc);
+			}
+			break;
+		case DW_CFA_def_cfa:
+			if (!eh_uleb(&p, end, &a) || !eh_uleb(&p, end, &b)) {
+				return false;
+			}
+			cfa->cfa_reg = a;
+			cfa->cfa_offset = b;
+			cfa->cfa_expr = false;
+			eh_cfa_record(ctx, cfa, fcn, loc);
+			break;
+		case DW_CFA_def_cfa_sf:
+			if (!eh_uleb(&p, end, &a) || !eh_sleb(&p, end, &s)) {
+				return false;
+			}
+			cfa->cfa_reg = a;
+			cfa->cfa_offset = s * cie->data_align;
+			cfa->cfa_expr = false;
+			eh_cfa_record(ctx, cfa, fcn, loc);
+			break;
+		case DW_CFA_def_cfa_register:
+			if (!eh_uleb(&p, end, &a)) {
+				return false;
+			}
+			cfa->cfa_reg = a;
+			cfa->cfa_expr = false;
+			eh_cfa_record(ctx, cfa, fcn, loc);
+			break;
+		case DW_CFA_def_cfa_offset:
+			if (!eh_uleb(&p, end, &a)) {
+				return false;
+			}
+			cfa->cfa_offset = a;
+			eh_cfa_record(ctx, cfa, fcn, loc);
+			break;
+		case DW_CFA_def_cfa_offset_sf:
+			if (!eh_sleb(&p, end, &s)) {
+				return false;
+			}
+			cfa->cfa_offset = s * cie->data_align;
+			eh_cfa_record(ctx, cfa, fcn, loc);
+			break;
+		case DW_CFA_def_cfa_expression:
+			if (!eh_uleb(&p, end, &a) || a > (ut64)(end - p)) {
+				return false;
+			}
+			p += a;
+			cfa->cfa_expr = true;
+			eh_cfa_record(ctx, cfa, fcn, loc);
+			break;
+		default:
+			// unknown vendor extension, the operands cannot be skipped
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Parse the CIE at \p at and run its initial instructions, which give the CFA at function entry.
+ */
+static bool eh_cie_load(const EhFrameCtx *ctx, const ut8 *at, EhCie *cie, EhCfa *cfa) {
+	if (ctx->end - at < 8) {
+		return false;
+	}
+	const ut8 *p = at;
+	ut64 len = rz_read_ble32(p, ctx->big_endian);
+	p += 4;
+	if (len == UT32_MAX) {
+		if (ctx->end - p < 12) {
+			return false;
+		}
+		len = rz_read_ble64(p, ctx->big_endian);
+		p += 8;
+	}
+	if (len < 4 || len > (ut64)(ctx->end - p) || rz_read_ble32(p, ctx->big_endian)) {
+		return false;
+	}
+	const ut8 *end = p + len;
+	if (!eh_cie_parse(ctx, p + 4, end, cie)) {
+		return false;
+	}
+	memset(cfa, 0, sizeof(*cfa));
+	return eh_cfa_run(ctx, cie, cie->insns, cie->insns_end, cfa, NULL, 0);
+}
+
+/**
+ * \brief Get the function ranges and stack layouts described by the contents of an .eh_frame section
+ *
+ * \param data contents of the section
+ * \param vaddr address the section is loaded at, for pc-relative pointers
+ * \param sp_reg DWARF register number of the stack pointer
+ */
+RZ_API RZ_OWN RzPVector /*<RzBinUnwindFunction *>*/ *rz_bin_eh_frame_parse(RZ_NONNULL const ut8 *data, ut64 size, ut64 vaddr, ut32 sp_reg, int addr_size, bool big_endian) {
+	rz_return_val_if_fail(data && (addr_size == 4 || addr_size == 8), NULL);
+	RzPVector *fcns = rz_pvector_new((RzPVectorFree)rz_bin_unwind_function_free);
+	if (!fcns) {
+		return NULL;
+	}
+	EhFrameCtx ctx = {
+		.data = data,
+		.end = data + size,
+		.vaddr = vaddr,
+		.addr_size = addr_size,
+		.big_endian = big_endian,
+		.sp_reg = sp_reg
+	};
+	const ut8 *cie_at = NULL;
+	EhCie cie;
+	EhCfa cie_cfa;
+	const ut8 *p = data;
+	while (ctx.end - p >= 8) {
+		ut64 len = rz_read_ble32(p, big_endian);
+		p += 4;
+		if (!len) {
+			// terminator
+			break;
+		}
+		if (len == UT32_MAX) {
+			if (ctx.end - p < 8) {
+				break;
+			}
+			len = rz_read_ble64(p, big_endian);
+			p += 8;
+		}
+		if (len < 4 || len > (ut64)(ctx.end - p)) {
+			break;
+		}
+		const ut8 *entry_end = p + len;
+		ut32 cie_off = rz_read_ble32(p, big_endian);
+		if (!cie_off || cie_off > (ut64)(p - data)) {
+			// a CIE, which is parsed when an FDE refers to it
+			p = entry_end;
+			continue;
+		}
+		const ut8 *cie_ptr = p - cie_off;
+		p += 4;
+		if (cie_ptr != cie_at) {
+			cie_at = eh_cie_load(&ctx, cie_ptr, &cie, &cie_cfa) ? cie_ptr : NULL;
+		}
+		ut64 begin, range;
+		if (!cie_at || !eh_read_encoded(&ctx, &p, entry_end, cie.fde_enc, &begin) ||
+			!eh_read_encoded(&ctx, &p, entry_end, cie.fde_enc & 0x0f, &range) || !begin || !range) {
+			p = entry_end;
+			continue;
+		}
+		ut64 aug_len = 0;
+		if (cie.has_aug_data && (!eh_uleb(&p, entry_end, &aug_len) || aug_len > (ut64)(entry_end - p))) {
+			p = entry_end;
+			continue;
+		}
+		p += aug_len;
+		RzBinUnwindFunction *fcn = rz_bin_unwind_function_new(begin, range);
+		if (!fcn) {
+			break;
+		}
+		EhCfa cfa = cie_cfa;
+		eh_cfa_record(&ctx, &cfa, fcn, begin);
+		// the rows decoded before an error are still valid
+		eh_cfa_run(&ctx, &cie, p, entry_end, &cfa, fcn, begin);
+		rz_pvector_push(fcns, fcn);
+		p = entry_end;
+	}
+	return fcns;
+}
@@ -2148,7 +2148,7 @@ static char *get_bb_body(RzCore *core, RzAnalysisBlock *b, int opts, RzAnalysisF
 	if (b->jump != UT64_MAX) {
 		if (b->jump > b->addr) {
 			RzAnalysisBlock *jumpbb = rz_analysis_get_block_at(b->analysis, b->jump);
-			if (jumpbb && rz_list_contains(jumpbb->fcns, fcn)) {
+			if (jumpbb && rz_analysis_function_contains_block(fcn, jumpbb)) {
 				if (emu && core->analysis->last_disasm_reg != NULL && !jumpbb->parent_reg_arena) {
 					jumpbb->parent_reg_arena = rz_reg_arena_dup(core->analysis->reg, core->analysis->last_disasm_reg);
 				}
@@ -2158,7 +2158,7 @@ static char *get_bb_body(RzCore *core, RzAnalysisBlock *b, int opts, RzAnalysisF
 	if (b->fail != UT64_MAX) {
 		if (b->fail > b->addr) {
 			RzAnalysisBlock *failbb = rz_analysis_get_block_at(b->analysis, b->fail);
-			if (failbb && rz_list_contains(failbb->fcns, fcn)) {
+			if (failbb && rz_analysis_function_contains_block(fcn, failbb)) {
 				if (emu && core->analysis->last_disasm_reg != NULL && !failbb->parent_reg_arena) {
 					failbb->parent_reg_arena = rz_reg_arena_dup(core->analysis->reg, core->analysis->last_disasm_reg);
 				}
@@ -2241,7 +2241,7 @@ static void fold_asm_trace(RzCore *core, RzAGraph *g) {
 		}
 		ut64 addr = rz_num_get(NULL, n->title);
 		RzDebugTracepoint *tp = rz_debug_trace_get(core->dbg, addr);
-		n->is_mini = (tp == NULL);
+		n->is_mini = !tp && !rz_analysis_coverage_hits_at(core->analysis, addr);
 	}
 	g->need_update_dim = 1;
 	// agraph_refresh (rz_cons_singleton ()->event_data);
@@ -4468,7 +4468,7 @@ RZ_API void rz_core_analysis_propagate_noreturn(RzCore *core, ut64 addr) {
 			RzList *block_fcns = rz_list_clone(block->fcns);
 			if (request_fcn) {
 				// specific function requested, check if it contains the bb
-				if (!rz_list_contains(block->fcns, request_fcn)) {
+				if (!rz_analysis_function_contains_block(request_fcn, block)) {
 					goto kontinue;
 				}
 			} else {
@@ -6241,9 +6241,7 @@ static void _analysis_calls(RzCore *core, ut64 addr, ut64 addr_end, bool imports
 			setBits = hint->bits;
 		}
 		rz_analysis_hint_free(hint);
-		if (setBits != core->rasm->bits) {
-			rz_config_set_i(core->config, "asm.bits", setBits);
-		}
+		rz_core_set_mode_bits(core, setBits);
 		if (rz_analysis_op(core->analysis, &op, addr, buf + bufi, bsz - bufi, 0) > 0) {
 			if (op.size < 1) {
 				op.size = minop;
@@ -6284,6 +6282,7 @@ static void _analysis_calls(RzCore *core, ut64 addr, ut64 addr_end, bool imports
 		rz_analysis_op_fini(&op);
 	}
 	rz_cons_break_pop();
+	rz_core_set_mode_bits(core, rz_config_get_i(core->config, "asm.bits"));
 	free(buf);
 	free(block0);
 	free(block1);
@@ -6335,6 +6334,52 @@ RZ_API void rz_core_analysis_calls(RZ_NONNULL RzCore *core, bool imports_only) {
 	rz_list_free(ranges);
 }
 
+/**
+ * \brief Create the functions listed in the unwind tables of the current binary
+ *
+ * The tables give the exact start of every function with unwind information, so
+ * they are analyzed in a single pass over the table without following calls, and
+ * their stack frames are taken from the unwind rows.
+ *
+ * \return the number of functions found in the tables
+ */
+RZ_API int rz_core_analysis_unwind_functions(RZ_NONNULL RzCore *core) {
+	rz_return_val_if_fail(core, 0);
+	RzBinFile *bf = rz_bin_cur(core->bin);
+	if (!bf || !bf->o) {
+		return 0;
+	}
+	RzPVector *fcns = rz_bin_file_get_unwind_functions(bf);
+	if (!fcns) {
+		return 0;
+	}
+	int n = 0;
+	void **it;
+	rz_cons_break_push(NULL, NULL);
+	rz_pvector_foreach (fcns, it) {
+		RzBinUnwindFunction *uw = *it;
+		if (rz_cons_is_breaked()) {
+			break;
+		}
+		if (uw->fragment) {
+			continue;
+		}
+		RzAnalysisFunction *fcn = rz_analysis_get_function_at(core->analysis, uw->vaddr);
+		if (!fcn) {
+			rz_core_analysis_function_add(core, NULL, uw->vaddr, false);
+			fcn = rz_analysis_get_function_at(core->analysis, uw->vaddr);
+		}
+		if (!fcn) {
+			continue;
+		}
+		rz_analysis_function_apply_unwind(fcn, uw);
+		n++;
+	}
+	rz_cons_break_pop();
+	rz_pvector_free(fcns);
+	return n;
+}
+
 /**
  * Try to guess the address of the instruction before addr
  */
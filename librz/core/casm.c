@@ -500,6 +500,7 @@ static int handle_forward_disassemble(RzCore *core, RzList /*<RzCoreAsmHit *>*/
 		temp_instr_len = len - tmp_current_buf_pos;
 		RZ_LOG_DEBUG("Current position: %" PFMT64d " instr_addr: 0x%" PFMT64x "\n", tmp_current_buf_pos, temp_instr_addr);
 		temp_instr_len = rz_asm_disassemble(core->rasm, &op, buf + tmp_current_buf_pos, temp_instr_len);
+		rz_asm_op_fini(&op);
 
 		if (temp_instr_len == 0) {
 			is_valid = false;
@@ -653,6 +654,7 @@ RZ_API RzList /*<RzCoreAsmHit *>*/ *rz_core_asm_bwdisassemble(RzCore *core, ut64
 	for (hit_count = 0; hit_count < n; hit_count++) {
 		int instrlen = rz_asm_disassemble(core->rasm, &op,
 			buf + len - addrbytes * (addr - at), addrbytes * (addr - at));
+		rz_asm_op_fini(&op);
 		add_hit_to_hits(hits, at, instrlen, true);
 		at += instrlen;
 	}
@@ -702,6 +704,7 @@ static RzList /*<RzCoreAsmHit *>*/ *rz_core_asm_back_disassemble_all(RzCore *cor
 		current_instr_len = len - current_buf_pos + extra_padding;
 		RZ_LOG_DEBUG("current_buf_pos: 0x%" PFMT64x ", current_instr_len: %d\n", current_buf_pos, current_instr_len);
 		current_instr_len = rz_asm_disassemble(core->rasm, &op, buf + current_buf_pos, current_instr_len);
+		rz_asm_op_fini(&op);
 		hit = rz_core_asm_hit_new();
 		hit->addr = current_instr_addr;
 		hit->len = current_instr_len;
@@ -825,6 +828,7 @@ static RzList /*<RzCoreAsmHit *>*/ *rz_core_asm_back_disassemble(RzCore *core, u
 			hit_count = rz_list_length(hits);
 			last_num_invalid = 0;
 		}
+		rz_asm_op_fini(&op);
 
 		// walk backwards by one instruction
 		RZ_LOG_DEBUG(" current_instr_addr: 0x%" PFMT64x " current_instr_len: %d next_instr_addr: 0x%04" PFMT64x "\n",
@@ -4970,6 +4970,42 @@ RZ_API bool rz_core_bin_memory_print(RZ_NONNULL RzCore *core, RZ_NONNULL RzBinFi
 	return true;
 }
 
+RZ_API bool rz_core_bin_threads_print(RZ_NONNULL RzCore *core, RZ_NONNULL RzBinFile *bf, RZ_NONNULL RzCmdStateOutput *state) {
+	rz_return_val_if_fail(core && bf && bf->o && state, false);
+
+	rz_cmd_state_output_array_start(state);
+	rz_cmd_state_output_set_columnsf(state, "nb", "tid", "main");
+
+	const RzPVector *threads = rz_bin_object_get_threads(bf->o);
+	if (threads) {
+		void **it;
+		rz_pvector_foreach (threads, it) {
+			RzBinThread *thread = *it;
+			bool main = it == threads->v.a;
+			switch (state->mode) {
+			case RZ_OUTPUT_MODE_QUIET:
+				rz_cons_printf("%" PFMT64u "\n", thread->tid);
+				break;
+			case RZ_OUTPUT_MODE_JSON:
+				pj_o(state->d.pj);
+				pj_kn(state->d.pj, "tid", thread->tid);
+				pj_kb(state->d.pj, "main", main);
+				pj_end(state->d.pj);
+				break;
+			case RZ_OUTPUT_MODE_TABLE:
+				rz_table_add_rowf(state->d.t, "nb", thread->tid, main);
+				break;
+			default:
+				rz_warn_if_reached();
+				break;
+			}
+		}
+	}
+
+	rz_cmd_state_output_array_end(state);
+	return true;
+}
+
 static void bin_resources_print_standard(RzCore *core, RzList /*<char *>*/ *hashes, RzBinResource *resource) {
 	char humansz[8];
 	rz_num_units(humansz, sizeof(humansz), resource->size);
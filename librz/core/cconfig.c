@@ -517,7 +517,9 @@ static bool cb_asmarch(void *user, void *data) {
 			return false;
 		}
 	}
-	rz_egg_setup(core->egg, node->value, bits, 0, RZ_SYS_OS);
+	if (core->egg) {
+		rz_egg_setup(core->egg, node->value, bits, 0, RZ_SYS_OS);
+	}
 
 	if (!rz_asm_use(core->rasm, node->value)) {
 		RZ_LOG_ERROR("core: asm.arch: cannot find (%s)\n", node->value);
@@ -3164,6 +3166,7 @@ RZ_API int rz_core_config_init(RzCore *core) {
 	SETI("asm.tabs.off", 0, "tabulate spaces after the offset");
 	SETBPREF("asm.trace", "false", "Show execution traces for each opcode");
 	SETBPREF("asm.tracespace", "false", "Indent disassembly with trace.count information");
+	SETBPREF("asm.coverage", "false", "Show the hit counts of the basic blocks loaded with aC and highlight the covered ones");
 	SETBPREF("asm.ucase", "false", "Use uppercase syntax at disassembly");
 	SETBPREF("asm.capitalize", "false", "Use camelcase at disassembly");
 	SETBPREF("asm.var", "true", "Show local function variables in disassembly");
@@ -3230,7 +3233,10 @@ RZ_API int rz_core_config_init(RzCore *core) {
 	SETCB("bin.str.purge", "", &cb_strpurge, "Purge strings (e bin.str.purge=? provides more detail)");
 	SETBPREF("bin.b64str", "false", "Try to debase64 the strings");
 	SETCB("bin.at", "false", &cb_binat, "RzBin.cur depends on RzCore.offset");
-	SETBPREF("bin.libs", "false", "Try to load libraries after loading main binary");
+	SETBPREF("bin.libs", "false", "Load the libraries needed by the main binary, and theirs, and link their imports");
+	SETPREF("bin.libs.path", "", "Additional library search directories for bin.libs, separated by '" RZ_SYS_ENVSEP "'");
+	SETPREF("bin.libs.sysroot", "", "Look up absolute and system library paths relative to this directory");
+	SETBPREF("bin.libs.bind", "false", "Write the resolved import addresses into the GOT/IAT through the io cache");
 	n = NODECB("bin.str.filter", "", &cb_strfilter);
 	SETDESC(n, "Filter strings");
 	SETOPTIONS(n, "a", "8", "p", "e", "u", "i", "U", "f", NULL);
@@ -3523,7 +3529,7 @@ RZ_API int rz_core_config_init(RzCore *core) {
 
 	/* graph */
 	SETBPREF("graph.aeab", "false", "Show aeab info on each basic block instead of disasm");
-	SETBPREF("graph.trace", "false", "Fold all non-traced basic blocks");
+	SETBPREF("graph.trace", "false", "Fold all basic blocks that were not traced or covered");
 	SETBPREF("graph.dummy", "true", "Create dummy nodes in the graph for better layout (20% slower)");
 	SETBPREF("graph.few", "false", "Show few basic blocks in the graph");
 	SETBPREF("graph.comments", "true", "Show disasm comments in graph");
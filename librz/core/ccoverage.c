@@ -0,0 +1,608 @@
+// SPDX-FileCopyrightText: 2023 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+/**
+ * \file ccoverage.c
+ * Import of execution coverage produced by external tracers.
+ *
+ * Supported formats are drcov logs from DynamoRIO (and the tools producing the same
+ * format, like Frida or Intel PIN based tracers), `perf script` output and plain
+ * address lists, e.g. from QEMU or AFL++, with either absolute addresses or
+ * `module+offset` entries. Files are read in chunks and the hits are merged while
+ * they are collected, so the memory used depends on the number of distinct
+ * addresses and not on the length of the trace.
+ */
+
+#include <rz_core.h>
+
+#define READER_CHUNK     0x10000
+#define HITS_MERGE_BATCH 0x100000
+
+typedef struct {
+	RzBuffer *buf;
+	ut8 data[READER_CHUNK];
+	size_t pos;
+	size_t len;
+	char *line;
+	size_t line_cap;
+} CoverageReader;
+
+typedef struct {
+	RzCore *core;
+	CoverageReader reader;
+	RzVector /*<RzAnalysisCoverageHit>*/ batch; ///< hits read since the last merge
+	RzVector /*<RzAnalysisCoverageHit>*/ hits; ///< sorted and merged hits
+	HtPU *modules; ///< module basename => load address in rizin, UT64_MAX if not loaded
+	HtPU *perf_bases; ///< perf dso path => runtime load address
+	bool perf_callchain; ///< inside the callchain of a sample
+	bool perf_want_frame; ///< the next frame of the callchain is the sampled ip
+	size_t skipped;
+} CoverageLoad;
+
+static bool reader_fill(CoverageReader *r) {
+	if (r->pos < r->len) {
+		return true;
+	}
+	st64 len = rz_buf_read(r->buf, r->data, sizeof(r->data));
+	r->pos = 0;
+	r->len = len > 0 ? len : 0;
+	return r->len > 0;
+}
+
+/**
+ * \return the next line without its terminator, or NULL at the end of the file
+ */
+static char *reader_line(CoverageReader *r) {
+	size_t n = 0;
+	bool got = false;
+	while (reader_fill(r)) {
+		got = true;
+		ut8 *start = r->data + r->pos;
+		ut8 *nl = memchr(start, '\n', r->len - r->pos);
+		size_t chunk = nl ? nl - start : r->len - r->pos;
+		if (n + chunk + 1 > r->line_cap) {
+			size_t cap = RZ_MAX(r->line_cap * 2, n + chunk + 1);
+			char *line = realloc(r->line, cap);
+			if (!line) {
+				return NULL;
+			}
+			r->line = line;
+			r->line_cap = cap;
+		}
+		memcpy(r->line + n, start, chunk);
+		n += chunk;
+		r->pos += chunk + (nl ? 1 : 0);
+		if (nl) {
+			break;
+		}
+	}
+	if (!got) {
+		return NULL;
+	}
+	if (n && r->line[n - 1] == '\r') {
+		n--;
+	}
+	r->line[n] = '\0';
+	return r->line;
+}
+
+static bool reader_read(CoverageReader *r, ut8 *dst, size_t len) {
+	while (len) {
+		if (!reader_fill(r)) {
+			return false;
+		}
+		size_t chunk = RZ_MIN(len, r->len - r->pos);
+		memcpy(dst, r->data + r->pos, chunk);
+		r->pos += chunk;
+		dst += chunk;
+		len -= chunk;
+	}
+	return true;
+}
+
+static bool reader_peek(CoverageReader *r, const char *prefix) {
+	size_t len = strlen(prefix);
+	if (!reader_fill(r)) {
+		return false;
+	}
+	if (r->len - r->pos < len) {
+		// keep the partial data at the start of the buffer and read the rest behind it
+		memmove(r->data, r->data + r->pos, r->len - r->pos);
+		r->len -= r->pos;
+		r->pos = 0;
+		st64 more = rz_buf_read(r->buf, r->data + r->len, sizeof(r->data) - r->len);
+		r->len += more > 0 ? more : 0;
+	}
+	return r->len - r->pos >= len && !memcmp(r->data + r->pos, prefix, len);
+}
+
+/**
+ * \brief Merge the sorted \p batch into the sorted hits, in linear time
+ */
+static bool hits_merge_batch(CoverageLoad *ld) {
+	rz_analysis_coverage_hits_merge(&ld->batch);
+	RzVector merged;
+	rz_vector_init(&merged, sizeof(RzAnalysisCoverageHit), NULL, NULL);
+	if (!rz_vector_reserve(&merged, rz_vector_len(&ld->hits) + rz_vector_len(&ld->batch))) {
+		return false;
+	}
+	RzAnalysisCoverageHit *a = rz_vector_index_ptr(&ld->hits, 0);
+	RzAnalysisCoverageHit *b = rz_vector_index_ptr(&ld->batch, 0);
+	size_t i = 0, j = 0, alen = rz_vector_len(&ld->hits), blen = rz_vector_len(&ld->batch);
+	while (i < alen || j < blen) {
+		RzAnalysisCoverageHit hit;
+		if (j == blen || (i < alen && a[i].addr < b[j].addr)) {
+			hit = a[i++];
+		} else if (i == alen || b[j].addr < a[i].addr) {
+			hit = b[j++];
+		} else {
+			hit = a[i++];
+			hit.count += b[j].count;
+			hit.size = RZ_MAX(hit.size, b[j].size);
+			j++;
+		}
+		rz_vector_push(&merged, &hit);
+	}
+	rz_vector_fini(&ld->hits);
+	ld->hits = merged;
+	rz_vector_remove_range(&ld->batch, 0, rz_vector_len(&ld->batch), NULL);
+	return true;
+}
+
+static void hits_push(CoverageLoad *ld, ut64 addr, ut64 size, ut64 count) {
+	RzAnalysisCoverageHit hit = { addr, size, count };
+	if (rz_vector_push(&ld->batch, &hit) && rz_vector_len(&ld->batch) >= HITS_MERGE_BATCH) {
+		hits_merge_batch(ld);
+	}
+}
+
+/**
+ * \brief Get the address a module is loaded at in rizin
+ *
+ * \param path path or name of the module, matched against the basename of the open files
+ */
+static ut64 module_baddr(CoverageLoad *ld, const char *path) {
+	const char *name = rz_file_basename(path);
+	bool found = false;
+	ut64 baddr = ht_pu_find(ld->modules, name, &found);
+	if (found) {
+		return baddr;
+	}
+	baddr = UT64_MAX;
+	RzListIter *iter;
+	RzBinFile *bf;
+	rz_list_foreach (ld->core->bin->binfiles, iter, bf) {
+		if (bf->file && !rz_str_casecmp(rz_file_basename(bf->file), name)) {
+			baddr = rz_bin_file_get_baddr(bf);
+			break;
+		}
+	}
+	if (baddr == UT64_MAX) {
+		RZ_LOG_WARN("core: coverage of module %s is ignored, it is not loaded\n", name);
+	}
+	ht_pu_insert(ld->modules, name, baddr);
+	return baddr;
+}
+
+static ut64 parse_hex(const char *s, char **end) {
+	if (s[0] == '0' && (s[1] == 'x' || s[1] == 'X')) {
+		s += 2;
+	}
+	return strtoull(s, end, 16);
+}
+
+static bool is_hex_token(const char *s, size_t len) {
+	if (len > 2 && s[0] == '0' && (s[1] == 'x' || s[1] == 'X')) {
+		s += 2;
+		len -= 2;
+	}
+	if (!len || len > 16) {
+		return false;
+	}
+	for (size_t i = 0; i < len; i++) {
+		if (!IS_HEXCHAR(s[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/* Address lists */
+
+static void address_line(CoverageLoad *ld, char *line) {
+	line += strspn(line, " \t");
+	if (!*line || *line == '#') {
+		return;
+	}
+	char *end;
+	ut64 addr;
+	char *plus = strchr(line, '+');
+	char *sep = strpbrk(line, " \t,:");
+	if (plus && (!sep || plus < sep)) {
+		// module+offset
+		*plus = '\0';
+		ut64 baddr = module_baddr(ld, line);
+		ut64 off = parse_hex(plus + 1, &end);
+		if (baddr == UT64_MAX) {
+			ld->skipped++;
+			return;
+		}
+		addr = baddr + off;
+	} else {
+		addr = parse_hex(line, &end);
+		if (end == line) {
+			ld->skipped++;
+			return;
+		}
+	}
+	ut64 count = 1;
+	end += strspn(end, " \t,:");
+	if (IS_DIGIT(*end)) {
+		count = strtoull(end, NULL, 10);
+	}
+	hits_push(ld, addr, 1, count);
+}
+
+/* perf script */
+
+static void perf_mmap_line(CoverageLoad *ld, const char *line) {
+	// PERF_RECORD_MMAP2 pid/tid: [0x<start>(0x<len>) @ <pgoff> ...]: <prot> <path>
+	const char *p = strstr(line, ": [");
+	if (!p) {
+		return;
+	}
+	char *end;
+	ut64 start = parse_hex(p + 3, &end);
+	p = strstr(end, " @ ");
+	if (!p) {
+		return;
+	}
+	ut64 pgoff = parse_hex(p + 3, &end);
+	p = strstr(end, "]: ");
+	if (!p) {
+		return;
+	}
+	p += 3;
+	p = strchr(p, ' ');
+	if (!p || !*++p || *p == '[') {
+		// anonymous maps and [vdso] or similar
+		return;
+	}
+	ht_pu_insert(ld->perf_bases, p, start - pgoff);
+}
+
+static ut64 perf_rebase(CoverageLoad *ld, const char *dso, ut64 ip) {
+	bool found = false;
+	ut64 runtime_base = ht_pu_find(ld->perf_bases, dso, &found);
+	if (!found) {
+		return ip;
+	}
+	ut64 baddr = module_baddr(ld, dso);
+	return baddr == UT64_MAX ? UT64_MAX : ip - runtime_base + baddr;
+}
+
+static void perf_line(CoverageLoad *ld, char *line) {
+	if (strstr(line, "PERF_RECORD_MMAP")) {
+		perf_mmap_line(ld, line);
+		return;
+	}
+	size_t len = strlen(line);
+	while (len && IS_WHITESPACE(line[len - 1])) {
+		len--;
+	}
+	if (!len) {
+		ld->perf_callchain = false;
+		return;
+	}
+	if (line[len - 1] != ')') {
+		// sample header followed by its callchain, the first frame is the sampled ip
+		ld->perf_callchain = true;
+		ld->perf_want_frame = true;
+		return;
+	}
+	line[len - 1] = '\0';
+	char *dso = strrchr(line, '(');
+	if (!dso) {
+		return;
+	}
+	*dso++ = '\0';
+
+	// the ip is the first hex number after the last field ending with a colon (the event
+	// name), or the first one if there is none, as in callchain frames or with -F ip,sym,dso
+	char *ip_tok = NULL;
+	size_t ip_len = 0;
+	bool header = false;
+	char *p = line;
+	while (*p) {
+		p += strspn(p, " \t");
+		size_t tlen = strcspn(p, " \t");
+		if (!tlen) {
+			break;
+		}
+		if (p[tlen - 1] == ':') {
+			header = true;
+			ip_tok = NULL;
+		} else if (!ip_tok && is_hex_token(p, tlen)) {
+			ip_tok = p;
+			ip_len = tlen;
+		}
+		p += tlen;
+	}
+	if (!ip_tok || (!header && ld->perf_callchain && !ld->perf_want_frame)) {
+		return;
+	}
+	if (header) {
+		ld->perf_callchain = false;
+	}
+	ld->perf_want_frame = false;
+	ip_tok[ip_len] = '\0';
+	ut64 addr = perf_rebase(ld, dso, parse_hex(ip_tok, NULL));
+	if (addr == UT64_MAX) {
+		ld->skipped++;
+		return;
+	}
+	hits_push(ld, addr, 1, 1);
+}
+
+/* drcov */
+
+typedef struct {
+	ut64 base;
+	char *path;
+} DrcovModule;
+
+static void drcov_module_fini(void *e, void *user) {
+	DrcovModule *m = e;
+	free(m->path);
+}
+
+static int drcov_column(RzList /*<char *>*/ *columns, const char *name) {
+	RzListIter *iter;
+	char *col;
+	int i = 0;
+	rz_list_foreach (columns, iter, col) {
+		if (!strcmp(col, name)) {
+			return i;
+		}
+		i++;
+	}
+	return -1;
+}
+
+static bool drcov_modules(CoverageLoad *ld, RzVector /*<DrcovModule>*/ *modules, RzVector /*<ut64>*/ *bases) {
+	int ncols = 3, id_col = 0, base_col = -1, path_col = 2;
+	char *line;
+	while ((line = reader_line(&ld->reader))) {
+		if (rz_str_startswith(line, "BB Table:")) {
+			break;
+		}
+		if (rz_str_startswith(line, "Columns:")) {
+			RzList *columns = rz_str_split_duplist(line + strlen("Columns:"), ",", true);
+			if (!columns) {
+				return false;
+			}
+			ncols = rz_list_length(columns);
+			id_col = drcov_column(columns, "id");
+			base_col = drcov_column(columns, "base");
+			if (base_col < 0) {
+				base_col = drcov_column(columns, "start");
+			}
+			path_col = drcov_column(columns, "path");
+			rz_list_free(columns);
+			if (id_col < 0 || path_col < 0) {
+				RZ_LOG_ERROR("core: unsupported drcov module table columns\n");
+				return false;
+			}
+			continue;
+		}
+		if (!strchr(line, ',') || rz_str_startswith(line, "DRCOV") || rz_str_startswith(line, "Module Table")) {
+			continue;
+		}
+		// the path is the last column and may contain commas
+		RzList *fields = rz_str_split_duplist_n(line, ",", ncols - 1, true);
+		if (!fields || rz_list_length(fields) < ncols) {
+			rz_list_free(fields);
+			continue;
+		}
+		ut64 id = strtoull(rz_list_get_n(fields, id_col), NULL, 0);
+		DrcovModule m = {
+			.base = base_col >= 0 ? strtoull(rz_list_get_n(fields, base_col), NULL, 0) : 0,
+			.path = strdup(rz_list_get_n(fields, path_col))
+		};
+		rz_list_free(fields);
+		if (id >= UT16_MAX || !m.path) {
+			free(m.path);
+			continue;
+		}
+		while (rz_vector_len(modules) <= id) {
+			DrcovModule empty = { 0 };
+			rz_vector_push(modules, &empty);
+		}
+		DrcovModule *slot = rz_vector_index_ptr(modules, id);
+		free(slot->path);
+		*slot = m;
+	}
+	if (!line) {
+		RZ_LOG_ERROR("core: drcov file without a basic block table\n");
+		return false;
+	}
+
+	// blocks are relative to the segment they are in, rebase them on the lowest
+	// segment of the same module, which is the start of its image
+	DrcovModule *m;
+	rz_vector_foreach(modules, m) {
+		ut64 base = UT64_MAX;
+		if (m->path) {
+			ut64 baddr = module_baddr(ld, m->path);
+			ut64 image = m->base;
+			DrcovModule *other;
+			rz_vector_foreach(modules, other) {
+				if (other->path && other->base < image && !strcmp(other->path, m->path)) {
+					image = other->base;
+				}
+			}
+			base = baddr == UT64_MAX ? UT64_MAX : baddr + m->base - image;
+		}
+		rz_vector_push(bases, &base);
+	}
+	return true;
+}
+
+static bool drcov_blocks(CoverageLoad *ld, RzVector /*<ut64>*/ *bases) {
+	size_t nbases = rz_vector_len(bases);
+	if (reader_peek(&ld->reader, "module[")) {
+		// text table: module[  1]: 0x0000000000001234,  12
+		char *line;
+		while ((line = reader_line(&ld->reader))) {
+			char *p = strchr(line, '[');
+			if (!p) {
+				continue;
+			}
+			ut64 id = strtoull(p + 1, &p, 10);
+			p = strchr(p, ':');
+			if (!p || id >= nbases) {
+				ld->skipped++;
+				continue;
+			}
+			char *end;
+			ut64 start = parse_hex(rz_str_trim_head_ro(p + 1), &end);
+			ut64 size = strtoull(end + strspn(end, " ,"), NULL, 10);
+			ut64 base = *(ut64 *)rz_vector_index_ptr(bases, id);
+			if (base == UT64_MAX) {
+				ld->skipped++;
+				continue;
+			}
+			hits_push(ld, base + start, size, 1);
+		}
+		return true;
+	}
+	ut8 entry[8];
+	while (reader_read(&ld->reader, entry, sizeof(entry))) {
+		ut32 start = rz_read_le32(entry);
+		ut16 size = rz_read_le16(entry + 4);
+		ut16 id = rz_read_le16(entry + 6);
+		ut64 base = id < nbases ? *(ut64 *)rz_vector_index_ptr(bases, id) : UT64_MAX;
+		if (base == UT64_MAX) {
+			ld->skipped++;
+			continue;
+		}
+		hits_push(ld, base + start, size, 1);
+	}
+	return true;
+}
+
+static bool drcov_load(CoverageLoad *ld) {
+	RzVector modules, bases;
+	rz_vector_init(&modules, sizeof(DrcovModule), drcov_module_fini, NULL);
+	rz_vector_init(&bases, sizeof(ut64), NULL, NULL);
+	bool ret = drcov_modules(ld, &modules, &bases) && drcov_blocks(ld, &bases);
+	rz_vector_fini(&modules);
+	rz_vector_fini(&bases);
+	return ret;
+}
+
+static RzCoreCoverageFormat guess_format(CoverageLoad *ld) {
+	if (reader_peek(&ld->reader, "DRCOV VERSION")) {
+		return RZ_CORE_COVERAGE_FORMAT_DRCOV;
+	}
+	// perf script always prints the dso between parentheses at the end of the samples
+	const char *data = (const char *)ld->reader.data + ld->reader.pos;
+	size_t len = ld->reader.len - ld->reader.pos;
+	const char *nl = memchr(data, '\n', len);
+	size_t first = nl ? nl - data : len;
+	if (rz_mem_mem((const ut8 *)data, len, (const ut8 *)"PERF_RECORD_", strlen("PERF_RECORD_")) || (first && data[first - 1] == ')')) {
+		return RZ_CORE_COVERAGE_FORMAT_PERF;
+	}
+	return RZ_CORE_COVERAGE_FORMAT_ADDRESSES;
+}
+
+/**
+ * \brief Load execution coverage from a file into the basic block hit counts
+ *
+ * Module relative addresses are rebased on the files open in rizin with the same
+ * basename, hits in modules that are not open are ignored.
+ *
+ * \param format format of the file, RZ_CORE_COVERAGE_FORMAT_AUTO to guess it from its contents
+ * \param blocks set to the number of basic blocks hit by the file
+ */
+RZ_API bool rz_core_coverage_load(RZ_NONNULL RzCore *core, RZ_NONNULL const char *path, RzCoreCoverageFormat format, RZ_NULLABLE size_t *blocks) {
+	rz_return_val_if_fail(core && path, false);
+	CoverageLoad *ld = RZ_NEW0(CoverageLoad);
+	if (!ld) {
+		return false;
+	}
+	bool ret = false;
+	ld->core = core;
+	rz_vector_init(&ld->batch, sizeof(RzAnalysisCoverageHit), NULL, NULL);
+	rz_vector_init(&ld->hits, sizeof(RzAnalysisCoverageHit), NULL, NULL);
+	ld->reader.buf = rz_buf_new_file(path, O_RDONLY, 0);
+	ld->modules = ht_pu_new0();
+	ld->perf_bases = ht_pu_new0();
+	if (!ld->reader.buf) {
+		RZ_LOG_ERROR("core: cannot open coverage file %s\n", path);
+		goto beach;
+	}
+	if (!ld->modules || !ld->perf_bases) {
+		goto beach;
+	}
+	if (format == RZ_CORE_COVERAGE_FORMAT_AUTO) {
+		format = guess_format(ld);
+	}
+	char *line;
+	switch (format) {
+	case RZ_CORE_COVERAGE_FORMAT_DRCOV:
+		ret = drcov_load(ld);
+		break;
+	case RZ_CORE_COVERAGE_FORMAT_PERF:
+		while ((line = reader_line(&ld->reader))) {
+			perf_line(ld, line);
+		}
+		ret = true;
+		break;
+	case RZ_CORE_COVERAGE_FORMAT_ADDRESSES:
+	default:
+		while ((line = reader_line(&ld->reader))) {
+			address_line(ld, line);
+		}
+		ret = true;
+		break;
+	}
+	if (ld->skipped) {
+		RZ_LOG_WARN("core: %" PFMTSZu " coverage entries could not be mapped\n", ld->skipped);
+	}
+	if (ret && hits_merge_batch(ld)) {
+		size_t n = rz_analysis_coverage_add(core->analysis, &ld->hits);
+		if (blocks) {
+			*blocks = n;
+		}
+	}
+
+beach:
+	rz_buf_free(ld->reader.buf);
+	free(ld->reader.line);
+	rz_vector_fini(&ld->batch);
+	rz_vector_fini(&ld->hits);
+	ht_pu_free(ld->modules);
+	ht_pu_free(ld->perf_bases);
+	free(ld);
+	return ret;
+}
+
+/**
+ * \brief Parse the name of a coverage format as used by the commands
+ */
+RZ_API RzCoreCoverageFormat rz_core_coverage_format_from_string(RZ_NULLABLE const char *name) {
+	if (RZ_STR_ISEMPTY(name) || !strcmp(name, "auto")) {
+		return RZ_CORE_COVERAGE_FORMAT_AUTO;
+	}
+	if (!strcmp(name, "drcov")) {
+		return RZ_CORE_COVERAGE_FORMAT_DRCOV;
+	}
+	if (!strcmp(name, "perf")) {
+		return RZ_CORE_COVERAGE_FORMAT_PERF;
+	}
+	if (!strcmp(name, "addr")) {
+		return RZ_CORE_COVERAGE_FORMAT_ADDRESSES;
+	}
+	return RZ_CORE_COVERAGE_FORMAT_INVALID;
+}
@@ -901,6 +901,18 @@ static void get_backtrace_info(RzCore *core, RzDebugFrame *frame, ut64 addr,
 				*flagdesc2 = rz_str_newf("%s", f2->name);
 			}
 		}
+	} else {
+		RzBinFile *bf = NULL;
+		ut64 delta = 0;
+		RzBinSymbol *sym = rz_core_debug_symbol_at(core, frame->addr, &bf, &delta);
+		if (sym) {
+			const char *lib = rz_file_basename(bf->file);
+			if (delta) {
+				*flagdesc = rz_str_newf("%s!%s+%" PFMT64u, lib, sym->name, delta);
+			} else {
+				*flagdesc = rz_str_newf("%s!%s", lib, sym->name);
+			}
+		}
 	}
 	if (!rz_str_cmp(*flagdesc, *flagdesc2, -1)) {
 		free(*flagdesc2);
@@ -0,0 +1,435 @@
+// SPDX-FileCopyrightText: 2023 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+/**
+ * \file cdebug_symbols.c
+ * Symbolization of addresses inside the modules loaded by the debuggee.
+ *
+ * Modules are parsed on first use into a private RzBin and kept in a cache keyed
+ * by path. A cached module is reused while its file keeps the same mtime and size,
+ * it is still loaded at the same base and the build-id found in memory is the one
+ * of the parsed file. Modules without a file on disk, or whose file does not match
+ * the loaded image anymore, are parsed from the process memory.
+ *
+ * The address ranges of the modules are rebuilt only when the debugger maps change,
+ * so a lookup is a binary search among the modules followed by a binary search
+ * among the symbols of the module.
+ */
+
+#include <rz_core.h>
+#include "core_private.h"
+
+#define MODULE_MEMORY_MAX 0x20000000
+#define BUILD_ID_MAX      0x40
+
+typedef struct {
+	RzBin *bin;
+	char *path;
+	ut64 base;
+	ut64 mtime;
+	ut64 size;
+	char *build_id; ///< NULL if the module has no GNU build-id note
+	ut64 build_id_addr; ///< Address of the build-id note in the process memory
+	bool from_memory;
+	RzBinFile *bf;
+	RzPVector /*<RzBinSymbol *>*/ index; ///< Symbols sorted by address
+} DebugModule;
+
+typedef struct {
+	ut64 base;
+	ut64 end;
+	char *path;
+	DebugModule *module; ///< Owned by the cache, NULL until the first lookup
+	bool failed; ///< Set when the module could not be parsed
+} ModuleRange;
+
+struct rz_core_debug_symbols_t {
+	RzBin *bin;
+	HtPP /*<char *, DebugModule *>*/ *modules;
+	RzVector /*<ModuleRange>*/ ranges; ///< Sorted by base
+	ut32 maps_gen; ///< Value of RzDebug.maps_gen when ranges were built
+};
+
+static void module_free(DebugModule *m) {
+	if (!m) {
+		return;
+	}
+	rz_pvector_fini(&m->index);
+	if (m->bf) {
+		rz_bin_file_delete(m->bin, m->bf);
+	}
+	free(m->build_id);
+	free(m->path);
+	free(m);
+}
+
+static void module_kv_free(HtPPKv *kv) {
+	free(kv->key);
+	module_free(kv->value);
+}
+
+static void range_fini(void *e, void *user) {
+	ModuleRange *r = e;
+	free(r->path);
+}
+
+static RzCoreDebugSymbols *debug_symbols_new(RzCore *core) {
+	RzCoreDebugSymbols *ds = RZ_NEW0(RzCoreDebugSymbols);
+	if (!ds) {
+		return NULL;
+	}
+	ds->bin = rz_bin_new();
+	ds->modules = ht_pp_new(NULL, module_kv_free, NULL);
+	if (!ds->bin || !ds->modules) {
+		rz_bin_free(ds->bin);
+		ht_pp_free(ds->modules);
+		free(ds);
+		return NULL;
+	}
+	rz_vector_init(&ds->ranges, sizeof(ModuleRange), range_fini, NULL);
+	rz_io_bind(core->io, &ds->bin->iob);
+	ds->bin->want_dbginfo = false;
+	ds->bin->demangle = core->bin->demangle;
+	ds->maps_gen = core->dbg->maps_gen - 1;
+	return ds;
+}
+
+static void debug_symbols_free(RzCoreDebugSymbols *ds) {
+	if (!ds) {
+		return;
+	}
+	rz_vector_fini(&ds->ranges);
+	ht_pp_free(ds->modules);
+	rz_bin_free(ds->bin);
+	free(ds);
+}
+
+/**
+ * \brief Read a GNU build-id note at \p off of \p buf as an hex string
+ */
+static char *build_id_read(RzBuffer *buf, ut64 off, bool big_endian) {
+	ut8 hdr[12];
+	if (rz_buf_read_at(buf, off, hdr, sizeof(hdr)) != sizeof(hdr)) {
+		return NULL;
+	}
+	ut32 namesz = rz_read_ble32(hdr, big_endian);
+	ut32 descsz = rz_read_ble32(hdr + 4, big_endian);
+	ut32 type = rz_read_ble32(hdr + 8, big_endian);
+	if (type != 3 /* NT_GNU_BUILD_ID */ || !descsz || descsz > BUILD_ID_MAX || namesz > 0x10) {
+		return NULL;
+	}
+	ut8 desc[BUILD_ID_MAX];
+	if (rz_buf_read_at(buf, off + sizeof(hdr) + ((namesz + 3) & ~3), desc, descsz) != descsz) {
+		return NULL;
+	}
+	return rz_hex_bin2strdup(desc, (int)descsz);
+}
+
+static char *build_id_in_memory(RzCoreDebugSymbols *ds, ut64 addr, bool big_endian) {
+	RzBuffer *buf = rz_buf_new_with_io(&ds->bin->iob);
+	if (!buf) {
+		return NULL;
+	}
+	char *id = build_id_read(buf, addr, big_endian);
+	rz_buf_free(buf);
+	return id;
+}
+
+static void module_build_id(DebugModule *m) {
+	const RzBinInfo *info = rz_bin_object_get_info(m->bf->o);
+	bool big_endian = info && info->big_endian;
+	const RzList *sections = rz_bin_object_get_sections_all(m->bf->o);
+	RzListIter *iter;
+	RzBinSection *s;
+	rz_list_foreach (sections, iter, s) {
+		if (s->is_segment || !s->name || strcmp(s->name, ".note.gnu.build-id")) {
+			continue;
+		}
+		m->build_id = build_id_read(m->bf->buf, s->paddr, big_endian);
+		m->build_id_addr = s->vaddr;
+		break;
+	}
+}
+
+static bool module_build_id_matches(RzCoreDebugSymbols *ds, DebugModule *m) {
+	if (!m->build_id) {
+		return true;
+	}
+	const RzBinInfo *info = rz_bin_object_get_info(m->bf->o);
+	char *id = build_id_in_memory(ds, m->build_id_addr, info && info->big_endian);
+	// the note is not always mapped, only a different id means a different image
+	bool ret = !id || !strcmp(id, m->build_id);
+	free(id);
+	return ret;
+}
+
+static int symbol_cmp(const void *a, const void *b) {
+	const RzBinSymbol *x = a, *y = b;
+	if (x->vaddr != y->vaddr) {
+		return x->vaddr < y->vaddr ? -1 : 1;
+	}
+	// with aliases at the same address the sized one goes last and wins the lookup
+	return (x->size > y->size) - (x->size < y->size);
+}
+
+static void module_index(DebugModule *m) {
+	rz_pvector_init(&m->index, NULL);
+	const RzList *symbols = rz_bin_object_get_symbols(m->bf->o);
+	RzListIter *iter;
+	RzBinSymbol *sym;
+	rz_list_foreach (symbols, iter, sym) {
+		if (sym->is_imported || !sym->vaddr || sym->vaddr == UT64_MAX || RZ_STR_ISEMPTY(sym->name)) {
+			continue;
+		}
+		if (sym->type && (!strcmp(sym->type, RZ_BIN_TYPE_FILE_STR) || !strcmp(sym->type, RZ_BIN_TYPE_SECTION_STR))) {
+			continue;
+		}
+		rz_pvector_push(&m->index, sym);
+	}
+	rz_pvector_sort(&m->index, symbol_cmp);
+}
+
+static RzBuffer *module_memory_read(RzCore *core, ModuleRange *r) {
+	ut64 size = r->end - r->base;
+	if (!size || size > MODULE_MEMORY_MAX) {
+		return NULL;
+	}
+	ut8 *bytes = calloc(1, size);
+	if (!bytes) {
+		return NULL;
+	}
+	// read only the mapped parts, the holes between segments stay zeroed
+	RzListIter *iter;
+	RzDebugMap *map;
+	rz_list_foreach (core->dbg->maps, iter, map) {
+		const char *path = map->file ? map->file : map->name;
+		if (!path || strcmp(path, r->path) || map->addr < r->base || map->addr_end > r->end) {
+			continue;
+		}
+		rz_io_read_at(core->io, map->addr, bytes + (map->addr - r->base), map->addr_end - map->addr);
+	}
+	return rz_buf_new_with_pointers(bytes, size, true);
+}
+
+static DebugModule *module_open(RzCoreDebugSymbols *ds, ModuleRange *r, RzBuffer *buf, bool from_memory) {
+	DebugModule *m = RZ_NEW0(DebugModule);
+	if (!m) {
+		return NULL;
+	}
+	RzBinOptions opt;
+	rz_bin_options_init(&opt, -1, r->base, UT64_MAX, false);
+	opt.obj_opts.elf_load_sections = true;
+	opt.obj_opts.elf_checks_sections = true;
+	opt.obj_opts.elf_checks_segments = true;
+	opt.filename = r->path;
+	opt.sz = rz_buf_size(buf);
+	m->bin = ds->bin;
+	m->bf = rz_bin_open_buf(ds->bin, buf, &opt);
+	m->path = strdup(r->path);
+	if (!m->bf || !m->bf->o || !m->path) {
+		module_free(m);
+		return NULL;
+	}
+	m->base = r->base;
+	m->from_memory = from_memory;
+	module_build_id(m);
+	module_index(m);
+	return m;
+}
+
+static DebugModule *module_load(RzCore *core, RzCoreDebugSymbols *ds, ModuleRange *r) {
+	DebugModule *m = NULL;
+	if (rz_file_is_regular(r->path)) {
+		RzBuffer *buf = rz_buf_new_mmap(r->path, RZ_PERM_R, 0);
+		if (buf) {
+			m = module_open(ds, r, buf, false);
+			rz_buf_free(buf);
+		}
+		if (m && !module_build_id_matches(ds, m)) {
+			RZ_LOG_WARN("core: %s does not match the image loaded in memory\n", r->path);
+			module_free(m);
+			m = NULL;
+		}
+		if (m) {
+			m->mtime = rz_file_mtime(r->path);
+			m->size = rz_file_size(r->path);
+			return m;
+		}
+	}
+	RzBuffer *buf = module_memory_read(core, r);
+	if (!buf) {
+		return NULL;
+	}
+	m = module_open(ds, r, buf, true);
+	rz_buf_free(buf);
+	return m;
+}
+
+static bool module_valid(RzCoreDebugSymbols *ds, DebugModule *m, ModuleRange *r) {
+	if (m->base != r->base || (m->from_memory && !m->build_id)) {
+		// without a build-id there is nothing telling that the memory still holds the same image
+		return false;
+	}
+	if (!m->from_memory && (rz_file_mtime(r->path) != m->mtime || rz_file_size(r->path) != m->size)) {
+		return false;
+	}
+	return module_build_id_matches(ds, m);
+}
+
+static DebugModule *module_get(RzCore *core, RzCoreDebugSymbols *ds, ModuleRange *r) {
+	if (r->module || r->failed) {
+		return r->module;
+	}
+	DebugModule *m = ht_pp_find(ds->modules, r->path, NULL);
+	if (m && !module_valid(ds, m, r)) {
+		ht_pp_delete(ds->modules, r->path);
+		m = NULL;
+	}
+	if (!m) {
+		m = module_load(core, ds, r);
+		if (m) {
+			ht_pp_insert(ds->modules, r->path, m);
+		}
+	}
+	r->module = m;
+	r->failed = !m;
+	return m;
+}
+
+static int range_cmp(const void *a, const void *b) {
+	const ModuleRange *x = a, *y = b;
+	return (x->base > y->base) - (x->base < y->base);
+}
+
+/**
+ * \brief Group the debugger maps by the file backing them into sorted module ranges
+ */
+static void ranges_update(RzCore *core, RzCoreDebugSymbols *ds) {
+	if (ds->maps_gen == core->dbg->maps_gen) {
+		return;
+	}
+	ds->maps_gen = core->dbg->maps_gen;
+	rz_vector_clear(&ds->ranges);
+	HtPU *seen = ht_pu_new0();
+	if (!seen) {
+		return;
+	}
+	RzListIter *iter;
+	RzDebugMap *map;
+	rz_list_foreach (core->dbg->maps, iter, map) {
+		const char *path = map->file ? map->file : map->name;
+		if (RZ_STR_ISEMPTY(path) || map->addr >= map->addr_end) {
+			continue;
+		}
+		bool found = false;
+		ut64 idx = ht_pu_find(seen, path, &found);
+		if (found) {
+			ModuleRange *r = rz_vector_index_ptr(&ds->ranges, idx);
+			r->base = RZ_MIN(r->base, map->addr);
+			r->end = RZ_MAX(r->end, map->addr_end);
+			continue;
+		}
+		ModuleRange *r = rz_vector_push(&ds->ranges, NULL);
+		if (!r) {
+			break;
+		}
+		memset(r, 0, sizeof(*r));
+		r->base = map->addr;
+		r->end = map->addr_end;
+		r->path = strdup(path);
+		ht_pu_insert(seen, path, rz_vector_len(&ds->ranges) - 1);
+	}
+	ht_pu_free(seen);
+	rz_vector_sort(&ds->ranges, range_cmp, false);
+}
+
+static ModuleRange *range_at(RzCoreDebugSymbols *ds, ut64 addr) {
+	size_t lo = 0, hi = rz_vector_len(&ds->ranges);
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		ModuleRange *r = rz_vector_index_ptr(&ds->ranges, mid);
+		if (r->base <= addr) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	if (!lo) {
+		return NULL;
+	}
+	ModuleRange *r = rz_vector_index_ptr(&ds->ranges, lo - 1);
+	return addr < r->end ? r : NULL;
+}
+
+static DebugModule *module_at(RzCore *core, ut64 addr) {
+	if (!core->dbg || rz_list_empty(core->dbg->maps)) {
+		return NULL;
+	}
+	if (!core->dbg_symbols) {
+		core->dbg_symbols = debug_symbols_new(core);
+		if (!core->dbg_symbols) {
+			return NULL;
+		}
+	}
+	ranges_update(core, core->dbg_symbols);
+	ModuleRange *r = range_at(core->dbg_symbols, addr);
+	return r ? module_get(core, core->dbg_symbols, r) : NULL;
+}
+
+/**
+ * \brief Get the parsed module of the debuggee that contains \p addr
+ *
+ * The module is parsed at the address it is loaded at and cached, the returned
+ * file belongs to the cache and is not part of `core->bin`. The debugger maps
+ * are not synchronized by this function.
+ */
+RZ_API RZ_BORROW RzBinFile *rz_core_debug_module_at(RZ_NONNULL RzCore *core, ut64 addr) {
+	rz_return_val_if_fail(core, NULL);
+	DebugModule *m = module_at(core, addr);
+	return m ? m->bf : NULL;
+}
+
+/**
+ * \brief Find the symbol of a debuggee module that \p addr belongs to
+ *
+ * \param bf set to the module containing the symbol
+ * \param delta set to the distance of \p addr from the start of the symbol
+ * \return the closest symbol at or before \p addr in the same module
+ */
+RZ_API RZ_BORROW RzBinSymbol *rz_core_debug_symbol_at(RZ_NONNULL RzCore *core, ut64 addr, RZ_NULLABLE RzBinFile **bf, RZ_NULLABLE ut64 *delta) {
+	rz_return_val_if_fail(core, NULL);
+	DebugModule *m = module_at(core, addr);
+	if (!m) {
+		return NULL;
+	}
+	size_t lo = 0, hi = rz_pvector_len(&m->index);
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		RzBinSymbol *sym = rz_pvector_at(&m->index, mid);
+		if (sym->vaddr <= addr) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	if (!lo) {
+		return NULL;
+	}
+	RzBinSymbol *sym = rz_pvector_at(&m->index, lo - 1);
+	if (bf) {
+		*bf = m->bf;
+	}
+	if (delta) {
+		*delta = addr - sym->vaddr;
+	}
+	return sym;
+}
+
+/**
+ * \brief Drop all the parsed debuggee modules
+ */
+RZ_API void rz_core_debug_symbols_reset(RZ_NONNULL RzCore *core) {
+	rz_return_if_fail(core);
+	debug_symbols_free(core->dbg_symbols);
+	core->dbg_symbols = NULL;
+}
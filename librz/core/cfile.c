@@ -167,6 +167,15 @@ static void __rebase_everything(RzCore *core, RzList /*<RzBinSection *>*/ *old_s
 	// META
 	rz_meta_rebase(core->analysis, diff);
 
+	// HINTS
+	rz_analysis_hint_rebase(core->analysis, diff);
+
+	// GLOBAL VARIABLES
+	rz_analysis_var_global_rebase(core->analysis, diff);
+
+	// CLASSES
+	rz_analysis_class_rebase(core->analysis, diff);
+
 	// XREFS
 	HtUP *xrefs_from = core->analysis->ht_xrefs_from;
 	HtUP *xrefs_to = core->analysis->ht_xrefs_to;
@@ -761,56 +770,95 @@ static bool core_file_do_load_for_io_plugin(RzCore *r, ut64 baseaddr, ut64 loada
 	return true;
 }
 
-static bool try_loadlib(RzCore *core, const char *lib, ut64 addr) {
-	if (rz_core_file_open(core, lib, 0, addr) != NULL) {
-		rz_core_bin_load(core, lib, addr);
-		return true;
+static bool is_abs_libpath(const char *lib) {
+#ifdef __WINDOWS__
+	return strlen(lib) >= 3 && lib[1] == ':' && lib[2] == '\\';
+#else
+	return *lib == '/';
+#endif
+}
+
+static char *find_lib_in(const char *dir, const char *lib) {
+	char *path = rz_file_path_join(dir, lib);
+	if (path && rz_file_is_regular(path)) {
+		return path;
 	}
-	return false;
+	free(path);
+	// import tables of PE files do not always match the case of the file on disk
+	char *lower = strdup(lib);
+	if (!lower) {
+		return NULL;
+	}
+	rz_str_case(lower, false);
+	path = strcmp(lower, lib) ? rz_file_path_join(dir, lower) : NULL;
+	free(lower);
+	if (path && rz_file_is_regular(path)) {
+		return path;
+	}
+	free(path);
+	return NULL;
 }
 
-RZ_API bool rz_core_file_loadlib(RzCore *core, const char *lib, ut64 libaddr) {
-	const char *dirlibs = rz_config_get(core->config, "dir.libs");
-	char *libdir = rz_path_libdir();
-	if (!dirlibs || !*dirlibs) {
-		dirlibs = "." RZ_SYS_DIR;
+/**
+ * \brief Find a library in the search path
+ *
+ * Absolute names are looked up relative to `bin.libs.sysroot` first. Other names are looked
+ * up in the directories from `bin.libs.path`, `dir.libs`, the rizin library directory and
+ * the system library directories, the latter being relative to `bin.libs.sysroot` too.
+ *
+ * \return the path of the library or NULL if it cannot be found
+ */
+static char *core_file_find_lib(RzCore *core, const char *lib) {
+	const char *sysroot = rz_config_get(core->config, "bin.libs.sysroot");
+	bool has_sysroot = RZ_STR_ISNOTEMPTY(sysroot);
+	if (is_abs_libpath(lib)) {
+		char *path = has_sysroot ? rz_file_path_join(sysroot, lib) : NULL;
+		if (path && rz_file_is_regular(path)) {
+			return path;
+		}
+		free(path);
+		return rz_file_is_regular(lib) ? strdup(lib) : NULL;
+	}
+
+	const char *libspath = rz_config_get(core->config, "bin.libs.path");
+	RzList *dirs = RZ_STR_ISNOTEMPTY(libspath) ? rz_str_split_duplist(libspath, RZ_SYS_ENVSEP, true) : rz_list_newf(free);
+	if (!dirs) {
+		return NULL;
 	}
-	const char *ldlibrarypath[] = {
-		dirlibs,
-		libdir,
+	const char *dirlibs = rz_config_get(core->config, "dir.libs");
+	rz_list_append(dirs, strdup(RZ_STR_ISNOTEMPTY(dirlibs) ? dirlibs : "." RZ_SYS_DIR));
+	rz_list_append(dirs, rz_path_libdir());
 #ifndef __WINDOWS__
-		"/usr/local/lib",
-		"/usr/lib",
-		"/lib",
+	const char *sysdirs[] = { "/usr/local/lib", "/usr/lib", "/lib" };
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(sysdirs); i++) {
+		rz_list_append(dirs, has_sysroot ? rz_file_path_join(sysroot, sysdirs[i]) : strdup(sysdirs[i]));
+	}
 #endif
-		"." RZ_SYS_DIR,
-		NULL
-	};
-	const char **libpath = (const char **)&ldlibrarypath;
+	rz_list_append(dirs, strdup("." RZ_SYS_DIR));
 
-	bool ret = false;
-#ifdef __WINDOWS__
-	if (strlen(lib) >= 3 && lib[1] == ':' && lib[2] == '\\') {
-#else
-	if (*lib == '/') {
-#endif
-		if (try_loadlib(core, lib, libaddr)) {
-			ret = true;
-		}
-	} else {
-		while (*libpath) {
-			char *s = rz_str_newf("%s" RZ_SYS_DIR "%s", *libpath, lib);
-			if (try_loadlib(core, s, libaddr)) {
-				ret = true;
-			}
-			free(s);
-			if (ret) {
-				break;
-			}
-			libpath++;
+	char *path = NULL;
+	RzListIter *iter;
+	const char *dir;
+	rz_list_foreach (dirs, iter, dir) {
+		if (RZ_STR_ISNOTEMPTY(dir) && (path = find_lib_in(dir, lib))) {
+			break;
 		}
 	}
-	free(libdir);
+	rz_list_free(dirs);
+	return path;
+}
+
+RZ_API bool rz_core_file_loadlib(RzCore *core, const char *lib, ut64 libaddr) {
+	char *path = core_file_find_lib(core, lib);
+	if (!path) {
+		return false;
+	}
+	bool ret = false;
+	if (rz_core_file_open(core, path, 0, libaddr) != NULL) {
+		rz_core_bin_load(core, path, libaddr);
+		ret = true;
+	}
+	free(path);
 	return ret;
 }
 
@@ -856,48 +904,232 @@ static void load_scripts_for(RzCore *core, const char *name) {
 	free(hdir);
 }
 
-typedef struct {
-	const char *name;
-	bool found;
-} RzCoreFileData;
-
-static bool filecb(void *user, void *data, ut32 id) {
-	RzCoreFileData *filedata = user;
-	RzIODesc *desc = (RzIODesc *)data;
-	if (!strcmp(desc->name, filedata->name)) {
-		filedata->found = true;
+static char *lib_key(const char *lib) {
+	char *key = strdup(rz_file_basename(lib));
+	if (key) {
+		rz_str_case(key, false);
 	}
-	return true;
+	return key;
 }
 
-static bool file_is_loaded(RzCore *core, const char *lib) {
-	RzCoreFileData filedata = { lib, false };
-	rz_id_storage_foreach(core->io->files, filecb, &filedata);
-	return filedata.found;
+static void enqueue_libs(RzList /*<char *>*/ *queue, RzBinFile *bf) {
+	const RzPVector *libs = bf && bf->o ? rz_bin_object_get_libs(bf->o) : NULL;
+	if (!libs) {
+		return;
+	}
+	void **iter;
+	rz_pvector_foreach (libs, iter) {
+		rz_list_append(queue, strdup(*iter));
+	}
 }
 
-typedef struct {
-	const char *name;
-	ut64 addr;
-	RzBin *bin;
-} RzCoreLinkData;
+/**
+ * \brief Load the whole dependency graph of \p main_bf
+ *
+ * Libraries are loaded breadth-first, which is the order the ELF dynamic linker and the
+ * Windows loader search them in, and every library is loaded only once.
+ *
+ * \param scope filled with the loaded RzBinFile in lookup order, starting with \p main_bf
+ */
+static void core_bin_load_libs(RzCore *core, RzBinFile *main_bf, RzPVector /*<RzBinFile *>*/ *scope) {
+	HtPU *loaded = ht_pu_new0();
+	RzList *queue = rz_list_newf(free);
+	if (!loaded || !queue) {
+		goto beach;
+	}
+	rz_pvector_push(scope, main_bf);
+	char *key = lib_key(main_bf->file);
+	if (key) {
+		ht_pu_insert(loaded, key, 1);
+		free(key);
+	}
+	enqueue_libs(queue, main_bf);
+
+	// the libraries of each library are queued here instead of being loaded recursively
+	rz_config_set_b(core->config, "bin.libs", false);
+	char *lib;
+	while ((lib = rz_list_pop_head(queue))) {
+		key = lib_key(lib);
+		if (!key || !ht_pu_insert(loaded, key, 1)) {
+			free(key);
+			free(lib);
+			continue;
+		}
+		free(key);
+		ut64 baddr = rz_io_map_location(core->io, 0x200000);
+		if (baddr == UT64_MAX) {
+			RZ_LOG_ERROR("Cannot find a location to map library %s\n", lib);
+			free(lib);
+			break;
+		}
+		RZ_LOG_INFO("Opening library %s\n", lib);
+		if (!rz_core_file_loadlib(core, lib, baddr)) {
+			RZ_LOG_WARN("Cannot find library %s\n", lib);
+			free(lib);
+			continue;
+		}
+		RzBinFile *bf = rz_bin_cur(core->bin);
+		if (bf && bf != main_bf) {
+			rz_pvector_push(scope, bf);
+			enqueue_libs(queue, bf);
+		}
+		free(lib);
+	}
+	rz_config_set_b(core->config, "bin.libs", true);
 
-static bool resolve_import_cb(RzCoreLinkData *ld, RzIODesc *desc, ut32 id) {
-	rz_return_val_if_fail(ld && desc, false);
-	RzBinFile *bf = rz_bin_file_find_by_fd(ld->bin, desc->fd);
-	if (!bf) {
-		return true;
+beach:
+	rz_list_free(queue);
+	ht_pu_free(loaded);
+}
+
+static void export_insert(HtPU *exports, const char *lib, const char *name, ut64 addr) {
+	// the first definition in lookup order wins, so existing names are never replaced
+	ht_pu_insert(exports, name, addr);
+	if (lib) {
+		char *qualified = rz_str_newf("%s!%s", lib, name);
+		if (qualified) {
+			ht_pu_insert(exports, qualified, addr);
+			free(qualified);
+		}
 	}
+}
+
+static void index_exports(HtPU *exports, RzBinFile *bf, bool default_version) {
+	const RzList *symbols = bf->o ? rz_bin_object_get_symbols(bf->o) : NULL;
+	char *lib = lib_key(bf->file);
 	RzListIter *iter;
 	RzBinSymbol *sym;
-	RzList *symbols = rz_bin_file_get_symbols(bf);
 	rz_list_foreach (symbols, iter, sym) {
-		if (!strcmp(sym->name, ld->name)) {
-			ld->addr = sym->vaddr;
-			return false;
+		if (sym->is_imported || RZ_STR_ISEMPTY(sym->name) || !sym->vaddr || sym->vaddr == UT64_MAX ||
+			(sym->bind && !strcmp(sym->bind, RZ_BIN_BIND_LOCAL_STR))) {
+			continue;
+		}
+		// versioned definitions are named sym@VER or sym@@VER, the latter being the default
+		// one that unversioned references bind to
+		const char *at = strchr(sym->name, '@');
+		if (!at) {
+			if (default_version) {
+				export_insert(exports, lib, sym->name, sym->vaddr);
+			}
+			continue;
+		}
+		if (default_version != (at[1] == '@')) {
+			continue;
+		}
+		export_insert(exports, lib, sym->name, sym->vaddr);
+		char *base = rz_str_ndup(sym->name, at - sym->name);
+		if (base) {
+			export_insert(exports, lib, base, sym->vaddr);
+			free(base);
 		}
 	}
-	return true;
+	free(lib);
+}
+
+/**
+ * \brief Build the global symbol namespace of the libraries in \p scope
+ *
+ * \return a map from the exported names to their addresses. Names are also
+ *         indexed as `lib!name` for imports that name their library.
+ */
+static HtPU *core_bin_exports(RzPVector /*<RzBinFile *>*/ *scope) {
+	HtPU *exports = ht_pu_new0();
+	if (!exports) {
+		return NULL;
+	}
+	void **iter;
+	rz_pvector_foreach (scope, iter) {
+		RzBinFile *bf = *iter;
+		index_exports(exports, bf, true);
+		index_exports(exports, bf, false);
+	}
+	return exports;
+}
+
+static ut64 resolve_import(HtPU *exports, const char *libname, const char *name) {
+	bool found = false;
+	ut64 addr;
+	if (RZ_STR_ISNOTEMPTY(libname)) {
+		char *lib = lib_key(libname);
+		char *qualified = lib ? rz_str_newf("%s!%s", lib, name) : NULL;
+		addr = qualified ? ht_pu_find(exports, qualified, &found) : 0;
+		free(qualified);
+		free(lib);
+		if (found) {
+			return addr;
+		}
+	}
+	addr = ht_pu_find(exports, name, &found);
+	return found ? addr : UT64_MAX;
+}
+
+/**
+ * \brief Bind the imports of all the files in \p scope to the library definitions
+ *
+ * Import stubs get a code xref and GOT/IAT slots a data xref to the definition.
+ * When `bin.libs.bind` is set the definitions are also written into the slots
+ * through the io cache, like the dynamic linker would do.
+ */
+static void core_bin_link_imports(RzCore *core, RzPVector /*<RzBinFile *>*/ *scope, HtPU *exports) {
+	bool bind = rz_config_get_b(core->config, "bin.libs.bind");
+	size_t resolved = 0, unresolved = 0;
+	void **iter;
+	rz_pvector_foreach (scope, iter) {
+		RzBinFile *bf = *iter;
+		RzBinObject *o = bf->o;
+		if (!o) {
+			continue;
+		}
+		RzBinRelocStorage *relocs = o->relocs;
+		const RzList *symbols = rz_bin_object_get_symbols(o);
+		RzListIter *it;
+		RzBinSymbol *sym;
+		rz_list_foreach (symbols, it, sym) {
+			if (!sym->is_imported || !sym->vaddr || sym->vaddr == UT64_MAX || RZ_STR_ISEMPTY(sym->name)) {
+				continue;
+			}
+			if (relocs && rz_bin_reloc_storage_get_reloc_in(relocs, sym->vaddr, 1)) {
+				// the import is the slot itself, e.g. in an IAT, handled with the relocs below
+				continue;
+			}
+			ut64 addr = resolve_import(exports, sym->libname, sym->name);
+			if (addr == UT64_MAX) {
+				RZ_LOG_DEBUG("Cannot resolve %s\n", sym->name);
+				unresolved++;
+				continue;
+			}
+			RZ_LOG_DEBUG("Resolved %s with address 0x%08" PFMT64x "\n", sym->name, addr);
+			rz_analysis_xrefs_set(core->analysis, sym->vaddr, addr, RZ_ANALYSIS_XREF_TYPE_CODE);
+			resolved++;
+		}
+		if (!relocs) {
+			continue;
+		}
+		bool big_endian = o->info && o->info->big_endian;
+		for (size_t i = 0; i < relocs->relocs_count; i++) {
+			RzBinReloc *reloc = relocs->relocs[i];
+			if (!reloc->import || RZ_STR_ISEMPTY(reloc->import->name) || reloc->vaddr == UT64_MAX) {
+				continue;
+			}
+			ut64 addr = resolve_import(exports, reloc->import->libname, reloc->import->name);
+			if (addr == UT64_MAX) {
+				unresolved++;
+				continue;
+			}
+			rz_analysis_xrefs_set(core->analysis, reloc->vaddr, addr, RZ_ANALYSIS_XREF_TYPE_DATA);
+			resolved++;
+			int size = rz_bin_reloc_size(reloc);
+			if (bind && size) {
+				ut8 buf[8];
+				rz_write_ble(buf, addr + reloc->addend, big_endian, size);
+				rz_io_cache_write(core->io, reloc->vaddr, buf, size / 8);
+			}
+		}
+	}
+	if (bind && resolved) {
+		rz_config_set_b(core->config, "io.cache.read", true);
+	}
+	RZ_LOG_INFO("Resolved %" PFMTSZu " imports, %" PFMTSZu " unresolved\n", resolved, unresolved);
 }
 
 static bool map_multi_dex(RzCore *core, RzIODesc *desc, ut32 id) {
@@ -1054,61 +1286,25 @@ RZ_API bool rz_core_bin_load(RZ_NONNULL RzCore *r, RZ_NULLABLE const char *filen
 	if (!rz_config_get_b(r->config, "cfg.debug")) {
 		loadGP(r);
 	}
-	if (rz_config_get_b(r->config, "bin.libs")) {
-		const char *lib;
-		void **iter;
-
-		RzBinObject *o = rz_bin_cur_object(r->bin);
-		const RzPVector *libs = rz_bin_object_get_libs(o);
-		if (libs) {
-			rz_pvector_foreach (libs, iter) {
-				lib = *iter;
-				if (file_is_loaded(r, lib)) {
-					continue;
-				}
-				RZ_LOG_INFO("Opening library %s\n", lib);
-				ut64 baddr = rz_io_map_location(r->io, 0x200000);
-				if (baddr != UT64_MAX) {
-					rz_core_file_loadlib(r, lib, baddr);
-				}
-			}
-		}
+	if (rz_config_get_b(r->config, "bin.libs") && binfile) {
+		RzPVector scope;
+		rz_pvector_init(&scope, NULL);
+		core_bin_load_libs(r, binfile, &scope);
 
-		rz_core_bin_raise(r, 0);
+		rz_core_file_set_by_file(r, cf);
+		rz_core_bin_raise(r, binfile->id);
 		ut64 ocurr = r->offset;
 		ut64 entry0addr = rz_num_math(r->num, "entry0");
 		rz_core_seek(r, entry0addr, true);
 
 		rz_config_set_b(r->config, "bin.at", true);
 		RZ_LOG_INFO("Linking imports...\n");
-		RzBinImport *imp;
-		RzBinObject *bin_obj = rz_bin_cur_object(r->bin);
-		const RzPVector *imports = rz_bin_object_get_imports(bin_obj);
-		void **vec_iter;
-		rz_pvector_foreach (imports, vec_iter) {
-			imp = *vec_iter;
-			char *name = rz_str_newf("sym.imp.%s", imp->name);
-			rz_name_filter(name + 8, strlen(name + 8) + 1, true);
-
-			RzFlagItem *flag = rz_flag_get(r->flags, name);
-			if (!flag) {
-				// RZ_LOG_DEBUG("Cannot find flag %s\n", name);
-				free(name);
-				continue;
-			}
-			ut64 imp_addr = flag->offset;
-			RzCoreLinkData linkdata = { imp->name, UT64_MAX, r->bin };
-			rz_id_storage_foreach(r->io->files, (RzIDStorageForeachCb)resolve_import_cb, &linkdata);
-			if (linkdata.addr != UT64_MAX) {
-				RZ_LOG_INFO("Resolved %s with address 0x%08" PFMT64x "\n", name, linkdata.addr);
-				ut64 a = linkdata.addr;
-				ut64 b = imp_addr;
-				rz_analysis_xrefs_set(r->analysis, b, a, RZ_ANALYSIS_XREF_TYPE_NULL);
-			} else {
-				RZ_LOG_ERROR("Cannot resolve %s\n", name);
-			}
-			free(name);
+		HtPU *exports = core_bin_exports(&scope);
+		if (exports) {
+			core_bin_link_imports(r, &scope, exports);
+			ht_pu_free(exports);
 		}
+		rz_pvector_fini(&scope);
 		rz_core_seek(r, ocurr, true);
 	}
 
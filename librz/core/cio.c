@@ -129,16 +129,46 @@ RZ_API void rz_core_arch_bits_at(RzCore *core, ut64 addr, RZ_OUT RZ_NULLABLE int
 	}
 }
 
+/**
+ * \brief Switch the decoding mode of the assembler and analysis to \p bits
+ *
+ * This is the cheap way to follow per-address bits, as in ARM/Thumb interworking
+ * code: unlike setting asm.bits it does not set up again the debugger, calling
+ * conventions, syscalls and types, which depend on the program and not on the
+ * encoding of the instructions. The asm.bits value is left untouched and setting
+ * it restores the mode of all the engines.
+ */
+RZ_API bool rz_core_set_mode_bits(RZ_NONNULL RzCore *core, int bits) {
+	rz_return_val_if_fail(core, false);
+	if (core->rasm->bits == bits && core->analysis->bits == bits) {
+		return true;
+	}
+	int old_bits = core->rasm->bits;
+	if (!rz_asm_set_bits(core->rasm, bits)) {
+		return false;
+	}
+	if (!rz_analysis_set_mode_bits(core->analysis, bits)) {
+		// do not leave the assembler decoding in a mode the analysis is not in
+		rz_asm_set_bits(core->rasm, old_bits);
+		return false;
+	}
+	core->rasm->pcalign = core->analysis->pcalign;
+	core->print->bits = bits;
+	return true;
+}
+
 RZ_API void rz_core_seek_arch_bits(RzCore *core, ut64 addr) {
 	int bits = 0;
 	const char *arch = NULL;
 	rz_core_arch_bits_at(core, addr, &bits, &arch);
-	if (bits) {
-		rz_config_set_i(core->config, "asm.bits", bits);
-	}
-	if (arch) {
+	if (arch && strcmp(arch, rz_config_get(core->config, "asm.arch"))) {
 		rz_config_set(core->config, "asm.arch", arch);
 	}
+	if (!bits) {
+		// no specific bits here, go back to the default ones
+		bits = rz_config_get_i(core->config, "asm.bits");
+	}
+	rz_core_set_mode_bits(core, bits);
 }
 
 RZ_API bool rz_core_write_at(RzCore *core, ut64 addr, const ut8 *buf, int size) {
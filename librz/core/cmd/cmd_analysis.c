@@ -447,6 +447,7 @@ static void core_analysis_bytes_desc(RzCore *core, const ut8 *buf, int len, int
 
 		if (ret < 1) {
 			RZ_LOG_ERROR("Invalid instruction at 0x%08" PFMT64x "...\n", core->offset + idx);
+			rz_asm_op_fini(&asmop);
 			break;
 		}
 
@@ -463,6 +464,7 @@ static void core_analysis_bytes_desc(RzCore *core, const ut8 *buf, int len, int
 			free(opname);
 		}
 		rz_analysis_op_fini(&op);
+		rz_asm_op_fini(&asmop);
 	}
 	rz_analysis_op_fini(&op);
 }
@@ -1986,6 +1988,12 @@ RZ_IPI RzCmdStatus rz_analysis_global_variable_add_handler(RzCore *core, int arg
 	return RZ_CMD_STATUS_OK;
 }
 
+RZ_IPI RzCmdStatus rz_analysis_global_variable_recover_handler(RzCore *core, int argc, const char **argv) {
+	size_t count = rz_analysis_var_global_recover(core->analysis, 0, UT64_MAX, RZ_THREAD_POOL_ALL_CORES);
+	RZ_LOG_INFO("Recovered %" PFMTSZu " global variables\n", count);
+	return RZ_CMD_STATUS_OK;
+}
+
 RZ_IPI RzCmdStatus rz_analysis_global_variable_delete_byaddr_handler(RzCore *core, int argc, const char **argv) {
 	ut64 addr = rz_num_math(core->num, argv[1]);
 
@@ -2189,6 +2197,58 @@ RZ_IPI RzCmdStatus rz_analysis_function_blocks_color_handler(RzCore *core, int a
 	return RZ_CMD_STATUS_OK;
 }
 
+static void cfg_block_addr_print(RzCmdStateOutput *state, const char *key, RzAnalysisBlock *bb) {
+	if (state->mode == RZ_OUTPUT_MODE_JSON) {
+		if (bb) {
+			pj_kn(state->d.pj, key, bb->addr);
+		} else {
+			pj_knull(state->d.pj, key);
+		}
+	} else if (bb) {
+		rz_cons_printf(" %s=0x%08" PFMT64x, key, bb->addr);
+	} else {
+		rz_cons_printf(" %s=-", key);
+	}
+}
+
+RZ_IPI RzCmdStatus rz_analysis_function_blocks_dominators_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state) {
+	RzAnalysisFunction *fcn = analysis_get_function_in(core->analysis, core->offset);
+	if (!fcn) {
+		return RZ_CMD_STATUS_ERROR;
+	}
+	RzAnalysisCFG *cfg = rz_analysis_function_get_cfg(fcn);
+	if (!cfg) {
+		return RZ_CMD_STATUS_ERROR;
+	}
+	rz_cmd_state_output_array_start(state);
+	void **it;
+	rz_pvector_foreach (&cfg->blocks, it) {
+		RzAnalysisBlock *bb = *it;
+		RzAnalysisBlock *idom = rz_analysis_function_idom(fcn, bb);
+		RzAnalysisBlock *ipdom = rz_analysis_function_ipdom(fcn, bb);
+		const RzAnalysisLoop *loop = rz_analysis_function_block_loop(fcn, bb);
+		size_t scc = rz_analysis_function_block_scc(fcn, bb);
+		if (state->mode == RZ_OUTPUT_MODE_JSON) {
+			pj_o(state->d.pj);
+			pj_kn(state->d.pj, "addr", bb->addr);
+		} else {
+			rz_cons_printf("0x%08" PFMT64x, bb->addr);
+		}
+		cfg_block_addr_print(state, "idom", idom);
+		cfg_block_addr_print(state, "ipdom", ipdom);
+		cfg_block_addr_print(state, "loop", loop ? loop->header : NULL);
+		if (state->mode == RZ_OUTPUT_MODE_JSON) {
+			pj_kn(state->d.pj, "depth", loop ? loop->depth : 0);
+			pj_kn(state->d.pj, "scc", scc);
+			pj_end(state->d.pj);
+		} else {
+			rz_cons_printf(" depth=%u scc=%" PFMTSZu "\n", loop ? loop->depth : 0, scc);
+		}
+	}
+	rz_cmd_state_output_array_end(state);
+	return RZ_CMD_STATUS_OK;
+}
+
 RZ_IPI RzCmdStatus rz_analysis_function_setbits_handler(RzCore *core, int argc, const char **argv) {
 	int bits = atoi(argv[1]);
 	RzAnalysisFunction *fcn = analysis_get_function_in(core->analysis, core->offset);
@@ -3258,6 +3318,7 @@ RZ_IPI RzCmdStatus rz_analysis_xrefs_from_list_handler(RzCore *core, int argc, c
 				RzAnalysisHint *hint = rz_analysis_hint_get(core->analysis, xref->to);
 				rz_parse_filter(core->parser, xref->from, core->flags, hint, rz_asm_op_get_asm(&asmop),
 					str, sizeof(str), core->print->big_endian);
+				rz_asm_op_fini(&asmop);
 				rz_analysis_hint_free(hint);
 				desc = str;
 			}
@@ -6058,6 +6119,94 @@ RZ_IPI RzCmdStatus rz_analysis_basic_block_find_paths_handler(RzCore *core, int
 	return status;
 }
 
+RZ_IPI RzCmdStatus rz_analysis_coverage_load_handler(RzCore *core, int argc, const char **argv) {
+	RzCoreCoverageFormat format = rz_core_coverage_format_from_string(argc > 2 ? argv[2] : NULL);
+	if (format == RZ_CORE_COVERAGE_FORMAT_INVALID) {
+		RZ_LOG_ERROR("core: unknown coverage format '%s'\n", argv[2]);
+		return RZ_CMD_STATUS_WRONG_ARGS;
+	}
+	size_t blocks = 0;
+	if (!rz_core_coverage_load(core, argv[1], format, &blocks)) {
+		return RZ_CMD_STATUS_ERROR;
+	}
+	RZ_LOG_INFO("core: %" PFMTSZu " basic blocks covered by %s\n", blocks, argv[1]);
+	return RZ_CMD_STATUS_OK;
+}
+
+RZ_IPI RzCmdStatus rz_analysis_coverage_blocks_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state) {
+	rz_cmd_state_output_array_start(state);
+	rz_cmd_state_output_set_columnsf(state, "xnn", "addr", "size", "hits");
+	RBIter iter;
+	RzAnalysisBlock *block;
+	rz_rbtree_foreach (core->analysis->bb_tree, iter, block, RzAnalysisBlock, _rb) {
+		ut64 hits = rz_analysis_coverage_block_hits(core->analysis, block);
+		if (!hits) {
+			continue;
+		}
+		switch (state->mode) {
+		case RZ_OUTPUT_MODE_JSON:
+			pj_o(state->d.pj);
+			pj_kn(state->d.pj, "addr", block->addr);
+			pj_kn(state->d.pj, "size", block->size);
+			pj_kn(state->d.pj, "hits", hits);
+			pj_end(state->d.pj);
+			break;
+		case RZ_OUTPUT_MODE_TABLE:
+			rz_table_add_rowf(state->d.t, "xnn", block->addr, block->size, hits);
+			break;
+		case RZ_OUTPUT_MODE_STANDARD:
+			rz_cons_printf("0x%08" PFMT64x " %" PFMT64u "\n", block->addr, hits);
+			break;
+		default:
+			rz_warn_if_reached();
+			break;
+		}
+	}
+	rz_cmd_state_output_array_end(state);
+	return RZ_CMD_STATUS_OK;
+}
+
+RZ_IPI RzCmdStatus rz_analysis_coverage_functions_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state) {
+	rz_cmd_state_output_array_start(state);
+	rz_cmd_state_output_set_columnsf(state, "xnnnns", "addr", "hits", "covered", "blocks", "percent", "name");
+	RzListIter *iter;
+	RzAnalysisFunction *fcn;
+	rz_list_foreach (core->analysis->fcns, iter, fcn) {
+		size_t covered = 0;
+		ut64 hits = rz_analysis_coverage_function_hits(core->analysis, fcn, &covered);
+		size_t blocks = rz_list_length(fcn->bbs);
+		ut64 percent = blocks ? covered * 100 / blocks : 0;
+		switch (state->mode) {
+		case RZ_OUTPUT_MODE_JSON:
+			pj_o(state->d.pj);
+			pj_kn(state->d.pj, "addr", fcn->addr);
+			pj_ks(state->d.pj, "name", fcn->name);
+			pj_kn(state->d.pj, "hits", hits);
+			pj_kn(state->d.pj, "covered", covered);
+			pj_kn(state->d.pj, "blocks", blocks);
+			pj_end(state->d.pj);
+			break;
+		case RZ_OUTPUT_MODE_TABLE:
+			rz_table_add_rowf(state->d.t, "xnnnns", fcn->addr, hits, (ut64)covered, (ut64)blocks, percent, fcn->name);
+			break;
+		case RZ_OUTPUT_MODE_STANDARD:
+			rz_cons_printf("0x%08" PFMT64x " %3" PFMT64u "%% %" PFMTSZu "/%" PFMTSZu " %" PFMT64u " %s\n",
+				fcn->addr, percent, covered, blocks, hits, fcn->name);
+			break;
+		default:
+			rz_warn_if_reached();
+			break;
+		}
+	}
+	rz_cmd_state_output_array_end(state);
+	return RZ_CMD_STATUS_OK;
+}
+
+RZ_IPI RzCmdStatus rz_analysis_coverage_reset_handler(RzCore *core, int argc, const char **argv) {
+	rz_analysis_coverage_reset(core->analysis);
+	return RZ_CMD_STATUS_OK;
+}
+
 RZ_IPI RzCmdStatus rz_analyze_simple_handler(RzCore *core, int argc, const char **argv) {
 	rz_core_perform_auto_analysis(core, RZ_CORE_ANALYSIS_SIMPLE);
 	return RZ_CMD_STATUS_OK;
@@ -6230,6 +6379,12 @@ RZ_IPI RzCmdStatus rz_analyze_all_preludes_handler(RzCore *core, int argc, const
 	return RZ_CMD_STATUS_OK;
 }
 
+RZ_IPI RzCmdStatus rz_analyze_unwind_functions_handler(RzCore *core, int argc, const char **argv) {
+	int n = rz_core_analysis_unwind_functions(core);
+	RZ_LOG_INFO("Found %d functions in the unwind tables\n", n);
+	return RZ_CMD_STATUS_OK;
+}
+
 RZ_IPI RzCmdStatus rz_analyze_xrefs_section_bytes_handler(RzCore *core, int argc, const char **argv) {
 	size_t n_bytes = argc == 2 ? rz_num_math(core->num, argv[1]) : 0;
 	return bool2status(rz_core_analysis_refs(core, n_bytes));
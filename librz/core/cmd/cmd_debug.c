@@ -290,6 +290,7 @@ static bool step_until_inst(RzCore *core, const char *instr, bool regex) {
 	ut64 pc;
 	int ret;
 	bool is_x86 = rz_str_startswith(rz_config_get(core->config, "asm.arch"), "x86");
+	rz_asm_op_init(&asmop);
 	rz_cons_break_push(NULL, NULL);
 	for (;;) {
 		if (rz_cons_is_breaked()) {
@@ -310,6 +311,7 @@ static bool step_until_inst(RzCore *core, const char *instr, bool regex) {
 		rz_asm_set_pc(core->rasm, pc);
 		// TODO: speedup if instructions are in the same block as the previous
 		rz_io_read_at(core->io, pc, buf, sizeof(buf));
+		rz_asm_op_fini(&asmop);
 		ret = rz_asm_disassemble(core->rasm, &asmop, buf, sizeof(buf));
 		rz_cons_printf("0x%08" PFMT64x " %d %s\n", pc, ret, rz_asm_op_get_asm(&asmop)); // asmop.buf_asm);
 		if (ret > 0) {
@@ -326,6 +328,7 @@ static bool step_until_inst(RzCore *core, const char *instr, bool regex) {
 			}
 		}
 	}
+	rz_asm_op_fini(&asmop);
 	rz_core_reg_update_flags(core);
 	rz_cons_break_pop();
 	return true;
@@ -691,23 +694,9 @@ static RzOutputMode rad2mode(int mode) {
 	}
 }
 
-static bool get_bin_info(RzCore *core, const char *file, ut64 baseaddr, PJ *pj,
-	int mode, bool symbols_only, RzCoreBinFilter *filter) {
-	int fd;
-	if ((fd = rz_io_fd_open(core->io, file, RZ_PERM_R, 0)) == -1) {
-		return false;
-	}
-	RzBinOptions opt = { 0 };
-	opt.obj_opts.elf_load_sections = true;
-	opt.obj_opts.elf_checks_sections = true;
-	opt.obj_opts.elf_checks_segments = true;
-	opt.fd = fd;
-	opt.sz = rz_io_fd_size(core->io, fd);
-	opt.obj_opts.baseaddr = baseaddr;
-	RzBinFile *obf = rz_bin_cur(core->bin);
-	RzBinFile *bf = rz_bin_open_io(core->bin, &opt);
+static bool get_bin_info(RzCore *core, ut64 addr, int mode, bool symbols_only, RzCoreBinFilter *filter) {
+	RzBinFile *bf = rz_core_debug_module_at(core, addr);
 	if (!bf) {
-		rz_io_fd_close(core->io, fd);
 		return false;
 	}
 	int action = RZ_CORE_BIN_ACC_ALL & ~RZ_CORE_BIN_ACC_INFO;
@@ -717,7 +706,7 @@ static bool get_bin_info(RzCore *core, const char *file, ut64 baseaddr, PJ *pj,
 		action &= ~RZ_CORE_BIN_ACC_ENTRIES & ~RZ_CORE_BIN_ACC_MAIN & ~RZ_CORE_BIN_ACC_MAPS;
 	}
 	if (mode == RZ_MODE_SET) {
-		rz_core_bin_apply_info(core, core->bin->cur, action);
+		rz_core_bin_apply_info(core, bf, action);
 	} else {
 		RzCmdStateOutput state;
 		rz_cmd_state_output_init(&state, rad2mode(mode));
@@ -725,9 +714,6 @@ static bool get_bin_info(RzCore *core, const char *file, ut64 baseaddr, PJ *pj,
 		rz_cmd_state_output_print(&state);
 		rz_cmd_state_output_fini(&state);
 	}
-	rz_bin_file_delete(core->bin, bf);
-	rz_bin_file_set_cur_binfile(core->bin, obf);
-	rz_io_fd_close(core->io, fd);
 	return true;
 }
 
@@ -831,7 +817,6 @@ RZ_IPI RzCmdStatus rz_cmd_debug_dump_maps_writable_handler(RzCore *core, int arg
 RZ_IPI int rz_cmd_debug_dmi(void *data, const char *input) {
 	RzCore *core = (RzCore *)data;
 	CMD_CHECK_DEBUG_DEAD(core);
-	RzListIter *iter;
 	RzDebugMap *map;
 	ut64 addr = core->offset;
 	switch (input[0]) {
@@ -920,21 +905,8 @@ RZ_IPI int rz_cmd_debug_dmi(void *data, const char *input) {
 			baddr = map->addr;
 
 			if (libname) {
-				const char *file = map->file ? map->file : map->name;
-				char *newfile = NULL;
-				if (!rz_file_exists(file)) {
-					newfile = rz_file_temp("memlib");
-					if (newfile) {
-						file = newfile;
-						rz_core_dump(core, file, baddr, map->size, false);
-					}
-				}
-				get_bin_info(core, file, baddr, pj, mode, symbols_only, &filter);
-				if (newfile) {
-					if (!rz_file_rm(newfile)) {
-						RZ_LOG_ERROR("core: Error when removing %s\n", newfile);
-					}
-					free(newfile);
+				if (!get_bin_info(core, addr, mode, symbols_only, &filter)) {
+					RZ_LOG_ERROR("core: Cannot parse the module at 0x%" PFMT64x "\n", addr);
 				}
 			} else {
 				RzBinFile *bf = rz_bin_cur(core->bin);
@@ -957,38 +929,19 @@ RZ_IPI int rz_cmd_debug_dmi(void *data, const char *input) {
 	} break;
 	case '.': // "dmi."
 	{
-		map = get_closest_map(core, addr);
-		if (map) {
-			ut64 closest_addr = UT64_MAX;
-			RzList *symbols = rz_bin_get_symbols(core->bin);
-			RzBinSymbol *symbol, *closest_symbol = NULL;
-
-			rz_list_foreach (symbols, iter, symbol) {
-				if (symbol->vaddr > addr) {
-					if (symbol->vaddr - addr < closest_addr) {
-						closest_addr = symbol->vaddr - addr;
-						closest_symbol = symbol;
-					}
-				} else {
-					if (addr - symbol->vaddr < closest_addr) {
-						closest_addr = addr - symbol->vaddr;
-						closest_symbol = symbol;
-					}
-				}
-			}
-			RzBinFile *bf = rz_bin_cur(core->bin);
-			if (closest_symbol && bf) {
-				RzCoreBinFilter filter;
-				filter.offset = UT64_MAX;
-				filter.name = (char *)closest_symbol->name;
-
-				rz_bin_set_baddr(core->bin, map->addr);
-				RzCmdStateOutput state;
-				rz_cmd_state_output_init(&state, RZ_OUTPUT_MODE_STANDARD);
-				rz_core_bin_print(core, bf, RZ_CORE_BIN_ACC_SYMBOLS, &filter, &state, NULL);
-				rz_cmd_state_output_print(&state);
-				rz_cmd_state_output_fini(&state);
-			}
+		rz_debug_map_sync(core->dbg);
+		RzBinFile *bf = NULL;
+		RzBinSymbol *symbol = rz_core_debug_symbol_at(core, addr, &bf, NULL);
+		if (symbol) {
+			RzCoreBinFilter filter;
+			filter.offset = UT64_MAX;
+			filter.name = (char *)symbol->name;
+
+			RzCmdStateOutput state;
+			rz_cmd_state_output_init(&state, RZ_OUTPUT_MODE_STANDARD);
+			rz_core_bin_print(core, bf, RZ_CORE_BIN_ACC_SYMBOLS, &filter, &state, NULL);
+			rz_cmd_state_output_print(&state);
+			rz_cmd_state_output_fini(&state);
 		}
 	} break;
 	default:
@@ -2993,7 +2946,10 @@ RZ_IPI RzCmdStatus rz_cmd_debug_inject_assembly_handler(RzCore *core, int argc,
 }
 
 RZ_IPI RzCmdStatus rz_cmd_debug_inject_egg_handler(RzCore *core, int argc, const char **argv) {
-	RzEgg *egg = core->egg;
+	RzEgg *egg = rz_core_get_egg(core);
+	if (!egg) {
+		return RZ_CMD_STATUS_ERROR;
+	}
 	RzBuffer *b;
 	const char *asm_arch = rz_config_get(core->config, "asm.arch");
 	int asm_bits = rz_config_get_i(core->config, "asm.bits");
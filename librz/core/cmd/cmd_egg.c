@@ -95,7 +95,10 @@ static bool rz_core_egg_compile(RzEgg *egg) {
 }
 
 static RzEgg *rz_core_egg_setup(RzCore *core) {
-	RzEgg *egg = core->egg;
+	RzEgg *egg = rz_core_get_egg(core);
+	if (!egg) {
+		return NULL;
+	}
 	const char *arch = rz_config_get(core->config, "asm.arch");
 	const char *os = rz_config_get(core->config, "asm.os");
 	int bits = rz_config_get_i(core->config, "asm.bits");
@@ -600,6 +600,35 @@ RZ_IPI RzCmdStatus rz_cmd_info_memory_handler(RzCore *core, int argc, const char
 	return bool2status(rz_core_bin_memory_print(core, bf, state));
 }
 
+RZ_IPI RzCmdStatus rz_cmd_info_threads_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state) {
+	GET_CHECK_CUR_BINFILE(core);
+	return bool2status(rz_core_bin_threads_print(core, bf, state));
+}
+
+RZ_IPI RzCmdStatus rz_cmd_info_thread_select_handler(RzCore *core, int argc, const char **argv) {
+	GET_CHECK_CUR_BINFILE(core);
+	const RzPVector *threads = rz_bin_object_get_threads(bf->o);
+	if (!threads) {
+		RZ_LOG_ERROR("core: The current file has no threads\n");
+		return RZ_CMD_STATUS_ERROR;
+	}
+	ut64 tid = rz_num_math(core->num, argv[1]);
+	void **it;
+	rz_pvector_foreach (threads, it) {
+		RzBinThread *thread = *it;
+		if (thread->tid != tid) {
+			continue;
+		}
+		if (rz_reg_arena_set_bytes(core->analysis->reg, thread->regstate)) {
+			RZ_LOG_ERROR("core: Cannot set the registers of thread %" PFMT64u "\n", tid);
+			return RZ_CMD_STATUS_ERROR;
+		}
+		return RZ_CMD_STATUS_OK;
+	}
+	RZ_LOG_ERROR("core: Cannot find thread %" PFMT64u "\n", tid);
+	return RZ_CMD_STATUS_ERROR;
+}
+
 RZ_IPI RzCmdStatus rz_cmd_info_resources_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state) {
 	GET_CHECK_CUR_BINFILE(core);
 	RzList *hashes = rz_list_new_from_array((const void **)argv + 1, argc - 1);
@@ -25,7 +25,7 @@ RZ_IPI RzCmdStatus rz_plugins_core_print_handler(RzCore *core, int argc, const c
 }
 
 RZ_IPI RzCmdStatus rz_plugins_crypto_print_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state) {
-	return rz_core_crypto_plugins_print(core->crypto, state);
+	return rz_core_crypto_plugins_print(rz_core_get_crypto(core), state);
 }
 
 RZ_IPI RzCmdStatus rz_plugins_debug_print_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state) {
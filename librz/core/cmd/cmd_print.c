@@ -2170,7 +2170,7 @@ static void pr_bb(RzCore *core, RzAnalysisFunction *fcn, RzAnalysisBlock *b, boo
 	if (b->jump != UT64_MAX) {
 		if (b->jump > b->addr) {
 			RzAnalysisBlock *jumpbb = rz_analysis_get_block_at(b->analysis, b->jump);
-			if (jumpbb && rz_list_contains(jumpbb->fcns, fcn)) {
+			if (jumpbb && rz_analysis_function_contains_block(fcn, jumpbb)) {
 				if (emu && core->analysis->last_disasm_reg && !jumpbb->parent_reg_arena) {
 					jumpbb->parent_reg_arena = rz_reg_arena_dup(core->analysis->reg, core->analysis->last_disasm_reg);
 				}
@@ -2183,7 +2183,7 @@ static void pr_bb(RzCore *core, RzAnalysisFunction *fcn, RzAnalysisBlock *b, boo
 	if (b->fail != UT64_MAX) {
 		if (b->fail > b->addr) {
 			RzAnalysisBlock *failbb = rz_analysis_get_block_at(b->analysis, b->fail);
-			if (failbb && rz_list_contains(failbb->fcns, fcn)) {
+			if (failbb && rz_analysis_function_contains_block(fcn, failbb)) {
 				if (emu && core->analysis->last_disasm_reg && !failbb->parent_reg_arena) {
 					failbb->parent_reg_arena = rz_reg_arena_dup(core->analysis->reg, core->analysis->last_disasm_reg);
 				}
@@ -4148,6 +4148,7 @@ RZ_IPI RzCmdStatus rz_cmd_sizes_of_n_instructions_handler(RzCore *core, int argc
 	for (ut32 i = 0, j = 0; i < core->blocksize && j < RZ_ABS(n_instrs); i += ret, j++) {
 		RzAsmOp asm_op = { 0 };
 		ret = rz_asm_disassemble(core->rasm, &asm_op, core->block + i, core->blocksize - i);
+		rz_asm_op_fini(&asm_op);
 		if (rz_cons_is_breaked()) {
 			break;
 		}
@@ -1177,6 +1177,7 @@ static void print_rop(RzCore *core, RzList /*<RzCoreAsmHit *>*/ *hitlist, PJ *pj
 			pj_end(pj);
 			free(buf);
 			rz_analysis_op_fini(&aop);
+			rz_asm_op_fini(&asmop);
 		}
 		pj_end(pj);
 		if (db && hit) {
@@ -1219,6 +1220,7 @@ static void print_rop(RzCore *core, RzList /*<RzCoreAsmHit *>*/ *hitlist, PJ *pj
 			}
 			free(buf);
 			rz_analysis_op_fini(&aop);
+			rz_asm_op_fini(&asmop);
 		}
 		if (db && hit) {
 			const ut64 addr = ((RzCoreAsmHit *)hitlist->head->data)->addr;
@@ -1273,6 +1275,7 @@ static void print_rop(RzCore *core, RzList /*<RzCoreAsmHit *>*/ *hitlist, PJ *pj
 			free(asm_op_hex);
 			free(buf);
 			rz_analysis_op_fini(&aop);
+			rz_asm_op_fini(&asmop);
 		}
 		if (db && hit) {
 			const ut64 addr = ((RzCoreAsmHit *)hitlist->head->data)->addr;
@@ -1486,6 +1489,7 @@ static int rz_core_search_rop(RzCore *core, RzInterval search_itv, int opt, cons
 					end = i + 2048;
 				}
 				ret = rz_asm_disassemble(core->rasm, &asmop, buf + i, delta - i);
+				rz_asm_op_fini(&asmop);
 				if (ret) {
 					rz_asm_set_pc(core->rasm, from + i);
 					RzList *hitlist = construct_rop_gadget(core,
@@ -1926,6 +1930,7 @@ static void do_ref_search(RzCore *core, ut64 addr, ut64 from, ut64 to, struct se
 			RzAnalysisHint *hint = rz_analysis_hint_get(core->analysis, xref->from);
 			rz_parse_filter(core->parser, xref->from, core->flags, hint, rz_strbuf_get(&asmop.buf_asm),
 				str, sizeof(str), core->print->big_endian);
+			rz_asm_op_fini(&asmop);
 			rz_analysis_hint_free(hint);
 			const char *comment = rz_meta_get_string(core->analysis, RZ_META_TYPE_COMMENT, xref->from);
 			char *print_comment = NULL;
@@ -2892,6 +2897,7 @@ static void __core_cmd_search_asm_byteswap(RzCore *core, int nth) {
 				rz_cons_printf("%02x  %s\n", i, asmstr);
 			}
 		}
+		rz_asm_op_fini(&asmop);
 	}
 }
 
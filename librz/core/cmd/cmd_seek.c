@@ -54,6 +54,7 @@ RZ_IPI int rz_core_seek_opcode_backward(RzCore *core, int numinstr, bool silent)
 				op.size = mininstrsize;
 			}
 			val += op.size;
+			rz_asm_op_fini(&op);
 			addr = prev_addr;
 		}
 	}
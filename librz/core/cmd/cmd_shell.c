@@ -592,9 +592,15 @@ RZ_IPI RzCmdStatus rz_cmd_shell_pkill_handler(RzCore *core, int argc, const char
 }
 
 RZ_IPI RzCmdStatus rz_print_init_time_values_handler(RzCore *core, int argc, const char **argv) {
-	rz_cons_printf("plug.init = %" PFMT64d "\n"
+	rz_cons_printf("core.init = %" PFMT64d "\n"
+		       "cmd.init = %" PFMT64d "\n"
+		       "config.init = %" PFMT64d "\n"
+		       "plug.init = %" PFMT64d "\n"
 		       "plug.load = %" PFMT64d "\n"
 		       "file.load = %" PFMT64d "\n",
+		core->times->core_init_time,
+		core->times->cmd_init_time,
+		core->times->config_init_time,
 		core->times->loadlibs_init_time,
 		core->times->loadlibs_time,
 		core->times->file_open_time);
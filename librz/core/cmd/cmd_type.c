@@ -506,6 +506,9 @@ RZ_IPI RzCmdStatus rz_type_noreturn_del_all_handler(RzCore *core, int argc, cons
 }
 
 RZ_IPI RzCmdStatus rz_type_open_file_handler(RzCore *core, int argc, const char **argv) {
+	if (argc > 2) {
+		return rz_types_open_files(core, argv + 1, argc - 1) ? RZ_CMD_STATUS_OK : RZ_CMD_STATUS_ERROR;
+	}
 	if (!rz_types_open_file(core, argv[1])) {
 		return RZ_CMD_STATUS_ERROR;
 	}
@@ -524,6 +527,10 @@ RZ_IPI RzCmdStatus rz_type_open_sdb_handler(RzCore *core, int argc, const char *
 	return RZ_CMD_STATUS_OK;
 }
 
+RZ_IPI RzCmdStatus rz_type_open_btf_handler(RzCore *core, int argc, const char **argv) {
+	return rz_types_open_btf(core, argc > 1 ? argv[1] : NULL) ? RZ_CMD_STATUS_OK : RZ_CMD_STATUS_ERROR;
+}
+
 RZ_IPI RzCmdStatus rz_type_print_handler(RzCore *core, int argc, const char **argv) {
 	const char *addr_or_var = argc > 2 ? argv[2] : NULL;
 	if (!addr_or_var) {
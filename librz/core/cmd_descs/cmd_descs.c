@@ -45,6 +45,7 @@ static const RzCmdDescDetail analysis_hint_set_val_details[2];
 static const RzCmdDescDetail analysis_hint_set_optype_details[2];
 static const RzCmdDescDetail analysis_hint_set_immbase_details[3];
 static const RzCmdDescDetail analysis_hint_set_offset_details[2];
+static const RzCmdDescDetail analysis_coverage_load_details[2];
 static const RzCmdDescDetail cmd_cmp_unified_details[2];
 static const RzCmdDescDetail cw_details[2];
 static const RzCmdDescDetail cmd_debug_list_bp_details[2];
@@ -300,6 +301,7 @@ static const RzCmdDescArg analyze_cycles_args[2];
 static const RzCmdDescArg convert_mne_args[2];
 static const RzCmdDescArg analyse_name_args[2];
 static const RzCmdDescArg analysis_basic_block_find_paths_args[2];
+static const RzCmdDescArg analysis_coverage_load_args[3];
 static const RzCmdDescArg analysis_syscall_show_args[2];
 static const RzCmdDescArg analysis_syscall_dump_assembly_args[2];
 static const RzCmdDescArg analysis_syscall_dump_c_args[2];
@@ -515,6 +517,7 @@ static const RzCmdDescArg cmd_info_plugins_args[2];
 static const RzCmdDescArg cmd_info_resources_args[2];
 static const RzCmdDescArg cmd_info_sections_args[2];
 static const RzCmdDescArg cmd_info_segments_args[2];
+static const RzCmdDescArg cmd_info_thread_select_args[2];
 static const RzCmdDescArg plugins_load_args[2];
 static const RzCmdDescArg plugins_unload_args[2];
 static const RzCmdDescArg plugins_debug_print_args[2];
@@ -739,6 +742,7 @@ static const RzCmdDescArg type_noreturn_del_args[2];
 static const RzCmdDescArg type_open_file_args[2];
 static const RzCmdDescArg type_open_editor_args[2];
 static const RzCmdDescArg type_open_sdb_args[2];
+static const RzCmdDescArg type_open_btf_args[2];
 static const RzCmdDescArg type_print_args[3];
 static const RzCmdDescArg type_print_value_args[3];
 static const RzCmdDescArg type_print_hexstring_args[3];
@@ -2549,6 +2553,15 @@ static const RzCmdDescHelp print_areas_no_functions_help = {
 	.args = print_areas_no_functions_args,
 };
 
+static const RzCmdDescArg analyze_unwind_functions_args[] = {
+	{ 0 },
+};
+static const RzCmdDescHelp analyze_unwind_functions_help = {
+	.summary = "Analyze all functions listed in the unwind tables",
+	.description = "Functions are created at the ranges of .eh_frame or .pdata, without following calls, and their stack frame sizes are taken from the unwind information.",
+	.args = analyze_unwind_functions_args,
+};
+
 static const RzCmdDescArg analyze_value_to_maps_args[] = {
 	{ 0 },
 };
@@ -2880,6 +2893,14 @@ static const RzCmdDescHelp analysis_function_blocks_color_help = {
 	.args = analysis_function_blocks_color_args,
 };
 
+static const RzCmdDescArg analysis_function_blocks_dominators_args[] = {
+	{ 0 },
+};
+static const RzCmdDescHelp analysis_function_blocks_dominators_help = {
+	.summary = "Show dominators, loops and strongly connected components of the function blocks",
+	.args = analysis_function_blocks_dominators_args,
+};
+
 static const RzCmdDescArg analysis_function_setbits_args[] = {
 	{
 		.name = "bits",
@@ -4866,6 +4887,14 @@ static const RzCmdDescHelp analysis_global_variable_retype_help = {
 	.args = analysis_global_variable_retype_args,
 };
 
+static const RzCmdDescArg analysis_global_variable_recover_args[] = {
+	{ 0 },
+};
+static const RzCmdDescHelp analysis_global_variable_recover_help = {
+	.summary = "recover global variables from the data xrefs",
+	.args = analysis_global_variable_recover_args,
+};
+
 static const RzCmdDescArg analysis_print_rtti_args[] = {
 	{ 0 },
 };
@@ -6147,6 +6176,65 @@ static const RzCmdDescHelp analysis_basic_block_find_paths_help = {
 	.args = analysis_basic_block_find_paths_args,
 };
 
+static const RzCmdDescHelp aC_help = {
+	.summary = "Execution coverage",
+};
+static const RzCmdDescDetailEntry analysis_coverage_load_Formats_detail_entries[] = {
+	{ .text = "drcov", .arg_str = "", .comment = "DynamoRIO drcov log, module offsets are rebased on the open files with the same name" },
+	{ .text = "perf", .arg_str = "", .comment = "`perf script` output, rebased with the mmap events of `perf script --show-mmap-events`" },
+	{ .text = "addr", .arg_str = "", .comment = "One `<addr> [count]` or `<module>+<offset> [count]` per line" },
+	{ 0 },
+};
+static const RzCmdDescDetail analysis_coverage_load_details[] = {
+	{ .name = "Formats", .entries = analysis_coverage_load_Formats_detail_entries },
+	{ 0 },
+};
+static const char *analysis_coverage_load_format_choices[] = { "auto", "drcov", "perf", "addr", NULL };
+static const RzCmdDescArg analysis_coverage_load_args[] = {
+	{
+		.name = "file",
+		.type = RZ_CMD_ARG_TYPE_FILE,
+
+	},
+	{
+		.name = "format",
+		.type = RZ_CMD_ARG_TYPE_CHOICES,
+		.default_value = "auto",
+		.choices.choices = analysis_coverage_load_format_choices,
+
+	},
+	{ 0 },
+};
+static const RzCmdDescHelp analysis_coverage_load_help = {
+	.summary = "Load coverage from a drcov log, `perf script` output or address list",
+	.details = analysis_coverage_load_details,
+	.args = analysis_coverage_load_args,
+};
+
+static const RzCmdDescArg analysis_coverage_blocks_args[] = {
+	{ 0 },
+};
+static const RzCmdDescHelp analysis_coverage_blocks_help = {
+	.summary = "List the hit counts of the covered basic blocks",
+	.args = analysis_coverage_blocks_args,
+};
+
+static const RzCmdDescArg analysis_coverage_functions_args[] = {
+	{ 0 },
+};
+static const RzCmdDescHelp analysis_coverage_functions_help = {
+	.summary = "Show the coverage of every function",
+	.args = analysis_coverage_functions_args,
+};
+
+static const RzCmdDescArg analysis_coverage_reset_args[] = {
+	{ 0 },
+};
+static const RzCmdDescHelp analysis_coverage_reset_help = {
+	.summary = "Remove all the coverage information",
+	.args = analysis_coverage_reset_args,
+};
+
 static const RzCmdDescHelp as_help = {
 	.summary = "Syscalls",
 };
@@ -11404,6 +11492,27 @@ static const RzCmdDescHelp cmd_info_cur_segment_help = {
 	.args = cmd_info_cur_segment_args,
 };
 
+static const RzCmdDescArg cmd_info_threads_args[] = {
+	{ 0 },
+};
+static const RzCmdDescHelp cmd_info_threads_help = {
+	.summary = "List threads of a core file",
+	.args = cmd_info_threads_args,
+};
+
+static const RzCmdDescArg cmd_info_thread_select_args[] = {
+	{
+		.name = "tid",
+		.type = RZ_CMD_ARG_TYPE_NUM,
+
+	},
+	{ 0 },
+};
+static const RzCmdDescHelp cmd_info_thread_select_help = {
+	.summary = "Load the registers of thread <tid> of a core file",
+	.args = cmd_info_thread_select_args,
+};
+
 static const RzCmdDescArg cmd_info_hashes_args[] = {
 	{ 0 },
 };
@@ -16366,12 +16475,14 @@ static const RzCmdDescArg type_open_file_args[] = {
 	{
 		.name = "file",
 		.type = RZ_CMD_ARG_TYPE_FILE,
+		.flags = RZ_CMD_ARG_FLAG_ARRAY,
 
 	},
 	{ 0 },
 };
 static const RzCmdDescHelp type_open_file_help = {
-	.summary = "Open C header file and load types from it",
+	.summary = "Open C header files and load types from them",
+	.description = "The headers are preprocessed for the current target, `#include` directives are resolved relative to the header and in dir.types. Several headers are parsed in parallel.",
 	.args = type_open_file_args,
 };
 
@@ -16401,6 +16512,21 @@ static const RzCmdDescHelp type_open_sdb_help = {
 	.args = type_open_sdb_args,
 };
 
+static const RzCmdDescArg type_open_btf_args[] = {
+	{
+		.name = "file",
+		.type = RZ_CMD_ARG_TYPE_FILE,
+		.optional = true,
+
+	},
+	{ 0 },
+};
+static const RzCmdDescHelp type_open_btf_help = {
+	.summary = "Load BTF types and function signatures",
+	.description = "Without a file, the types are loaded from the .BTF section of the current binary. The kernel of the running system exposes its own types in /sys/kernel/btf/vmlinux.",
+	.args = type_open_btf_args,
+};
+
 static const RzCmdDescHelp tp_help = {
 	.summary = "Print formatted type casted to the address",
 };
@@ -19007,6 +19133,9 @@ RZ_IPI void rzshell_cmddescs_init(RzCore *core) {
 	RzCmdDesc *print_areas_no_functions_cd = rz_cmd_desc_argv_new(core->rcmd, aa_cd, "aau", rz_print_areas_no_functions_handler, &print_areas_no_functions_help);
 	rz_warn_if_fail(print_areas_no_functions_cd);
 
+	RzCmdDesc *analyze_unwind_functions_cd = rz_cmd_desc_argv_new(core->rcmd, aa_cd, "aaU", rz_analyze_unwind_functions_handler, &analyze_unwind_functions_help);
+	rz_warn_if_fail(analyze_unwind_functions_cd);
+
 	RzCmdDesc *analyze_value_to_maps_cd = rz_cmd_desc_argv_state_new(core->rcmd, aa_cd, "aav", RZ_OUTPUT_MODE_STANDARD | RZ_OUTPUT_MODE_RIZIN, rz_analyze_value_to_maps_handler, &analyze_value_to_maps_help);
 	rz_warn_if_fail(analyze_value_to_maps_cd);
 
@@ -19076,6 +19205,9 @@ RZ_IPI void rzshell_cmddescs_init(RzCore *core) {
 	RzCmdDesc *analysis_function_blocks_color_cd = rz_cmd_desc_argv_new(core->rcmd, afb_cd, "afbc", rz_analysis_function_blocks_color_handler, &analysis_function_blocks_color_help);
 	rz_warn_if_fail(analysis_function_blocks_color_cd);
 
+	RzCmdDesc *analysis_function_blocks_dominators_cd = rz_cmd_desc_argv_state_new(core->rcmd, afb_cd, "afbd", RZ_OUTPUT_MODE_STANDARD | RZ_OUTPUT_MODE_JSON, rz_analysis_function_blocks_dominators_handler, &analysis_function_blocks_dominators_help);
+	rz_warn_if_fail(analysis_function_blocks_dominators_cd);
+
 	RzCmdDesc *analysis_function_setbits_cd = rz_cmd_desc_argv_new(core->rcmd, af_cd, "afB", rz_analysis_function_setbits_handler, &analysis_function_setbits_help);
 	rz_warn_if_fail(analysis_function_setbits_cd);
 
@@ -19481,6 +19613,9 @@ RZ_IPI void rzshell_cmddescs_init(RzCore *core) {
 	RzCmdDesc *analysis_global_variable_retype_cd = rz_cmd_desc_argv_new(core->rcmd, avg_cd, "avgt", rz_analysis_global_variable_retype_handler, &analysis_global_variable_retype_help);
 	rz_warn_if_fail(analysis_global_variable_retype_cd);
 
+	RzCmdDesc *analysis_global_variable_recover_cd = rz_cmd_desc_argv_new(core->rcmd, avg_cd, "avgr", rz_analysis_global_variable_recover_handler, &analysis_global_variable_recover_help);
+	rz_warn_if_fail(analysis_global_variable_recover_cd);
+
 	RzCmdDesc *analysis_print_rtti_cd = rz_cmd_desc_argv_modes_new(core->rcmd, av_cd, "avr", RZ_OUTPUT_MODE_STANDARD | RZ_OUTPUT_MODE_JSON, rz_analysis_print_rtti_handler, &analysis_print_rtti_help);
 	rz_warn_if_fail(analysis_print_rtti_cd);
 
@@ -19744,6 +19879,17 @@ RZ_IPI void rzshell_cmddescs_init(RzCore *core) {
 	RzCmdDesc *analysis_basic_block_find_paths_cd = rz_cmd_desc_argv_state_new(core->rcmd, ab_cd, "abt", RZ_OUTPUT_MODE_STANDARD | RZ_OUTPUT_MODE_JSON, rz_analysis_basic_block_find_paths_handler, &analysis_basic_block_find_paths_help);
 	rz_warn_if_fail(analysis_basic_block_find_paths_cd);
 
+	RzCmdDesc *aC_cd = rz_cmd_desc_group_new(core->rcmd, cmd_analysis_cd, "aC", rz_analysis_coverage_load_handler, &analysis_coverage_load_help, &aC_help);
+	rz_warn_if_fail(aC_cd);
+	RzCmdDesc *analysis_coverage_blocks_cd = rz_cmd_desc_argv_state_new(core->rcmd, aC_cd, "aCb", RZ_OUTPUT_MODE_STANDARD | RZ_OUTPUT_MODE_JSON | RZ_OUTPUT_MODE_TABLE, rz_analysis_coverage_blocks_handler, &analysis_coverage_blocks_help);
+	rz_warn_if_fail(analysis_coverage_blocks_cd);
+
+	RzCmdDesc *analysis_coverage_functions_cd = rz_cmd_desc_argv_state_new(core->rcmd, aC_cd, "aCf", RZ_OUTPUT_MODE_STANDARD | RZ_OUTPUT_MODE_JSON | RZ_OUTPUT_MODE_TABLE, rz_analysis_coverage_functions_handler, &analysis_coverage_functions_help);
+	rz_warn_if_fail(analysis_coverage_functions_cd);
+
+	RzCmdDesc *analysis_coverage_reset_cd = rz_cmd_desc_argv_new(core->rcmd, aC_cd, "aC-", rz_analysis_coverage_reset_handler, &analysis_coverage_reset_help);
+	rz_warn_if_fail(analysis_coverage_reset_cd);
+
 	RzCmdDesc *as_cd = rz_cmd_desc_group_new(core->rcmd, cmd_analysis_cd, "as", rz_analysis_syscall_show_handler, &analysis_syscall_show_help, &as_help);
 	rz_warn_if_fail(as_cd);
 	RzCmdDesc *analysis_syscall_print_cd = rz_cmd_desc_argv_state_new(core->rcmd, as_cd, "asl", RZ_OUTPUT_MODE_STANDARD | RZ_OUTPUT_MODE_JSON, rz_analysis_syscall_print_handler, &analysis_syscall_print_help);
@@ -20952,6 +21098,13 @@ RZ_IPI void rzshell_cmddescs_init(RzCore *core) {
 	rz_warn_if_fail(cmd_info_cur_segment_cd);
 	rz_cmd_desc_set_default_mode(cmd_info_cur_segment_cd, RZ_OUTPUT_MODE_TABLE);
 
+	RzCmdDesc *cmd_info_threads_cd = rz_cmd_desc_argv_state_new(core->rcmd, i_cd, "it", RZ_OUTPUT_MODE_TABLE | RZ_OUTPUT_MODE_JSON | RZ_OUTPUT_MODE_QUIET, rz_cmd_info_threads_handler, &cmd_info_threads_help);
+	rz_warn_if_fail(cmd_info_threads_cd);
+	rz_cmd_desc_set_default_mode(cmd_info_threads_cd, RZ_OUTPUT_MODE_TABLE);
+
+	RzCmdDesc *cmd_info_thread_select_cd = rz_cmd_desc_argv_new(core->rcmd, i_cd, "it=", rz_cmd_info_thread_select_handler, &cmd_info_thread_select_help);
+	rz_warn_if_fail(cmd_info_thread_select_cd);
+
 	RzCmdDesc *cmd_info_hashes_cd = rz_cmd_desc_argv_state_new(core->rcmd, i_cd, "iT", RZ_OUTPUT_MODE_STANDARD | RZ_OUTPUT_MODE_JSON, rz_cmd_info_hashes_handler, &cmd_info_hashes_help);
 	rz_warn_if_fail(cmd_info_hashes_cd);
 
@@ -21976,6 +22129,9 @@ RZ_IPI void rzshell_cmddescs_init(RzCore *core) {
 	RzCmdDesc *type_open_sdb_cd = rz_cmd_desc_argv_new(core->rcmd, to_cd, "tos", rz_type_open_sdb_handler, &type_open_sdb_help);
 	rz_warn_if_fail(type_open_sdb_cd);
 
+	RzCmdDesc *type_open_btf_cd = rz_cmd_desc_argv_new(core->rcmd, to_cd, "tob", rz_type_open_btf_handler, &type_open_btf_help);
+	rz_warn_if_fail(type_open_btf_cd);
+
 	RzCmdDesc *tp_cd = rz_cmd_desc_group_new(core->rcmd, t_cd, "tp", rz_type_print_handler, &type_print_help, &tp_help);
 	rz_warn_if_fail(tp_cd);
 	RzCmdDesc *type_print_value_cd = rz_cmd_desc_argv_new(core->rcmd, tp_cd, "tpv", rz_type_print_value_handler, &type_print_value_help);
@@ -236,6 +236,8 @@ RZ_IPI RzCmdStatus rz_analyze_function_linked_offsets_handler(RzCore *core, int
 RZ_IPI RzCmdStatus rz_print_commands_after_traps_handler(RzCore *core, int argc, const char **argv);
 // "aau"
 RZ_IPI RzCmdStatus rz_print_areas_no_functions_handler(RzCore *core, int argc, const char **argv);
+// "aaU"
+RZ_IPI RzCmdStatus rz_analyze_unwind_functions_handler(RzCore *core, int argc, const char **argv);
 // "aav"
 RZ_IPI RzCmdStatus rz_analyze_value_to_maps_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state);
 // "ad"
@@ -280,6 +282,8 @@ RZ_IPI RzCmdStatus rz_analysis_function_blocks_asciiart_handler(RzCore *core, in
 RZ_IPI RzCmdStatus rz_analysis_function_blocks_info_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state);
 // "afbc"
 RZ_IPI RzCmdStatus rz_analysis_function_blocks_color_handler(RzCore *core, int argc, const char **argv);
+// "afbd"
+RZ_IPI RzCmdStatus rz_analysis_function_blocks_dominators_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state);
 // "afB"
 RZ_IPI RzCmdStatus rz_analysis_function_setbits_handler(RzCore *core, int argc, const char **argv);
 // "afs"
@@ -563,6 +567,8 @@ RZ_IPI RzCmdStatus rz_analysis_global_variable_delete_byname_handler(RzCore *cor
 RZ_IPI RzCmdStatus rz_analysis_global_variable_rename_handler(RzCore *core, int argc, const char **argv);
 // "avgt"
 RZ_IPI RzCmdStatus rz_analysis_global_variable_retype_handler(RzCore *core, int argc, const char **argv);
+// "avgr"
+RZ_IPI RzCmdStatus rz_analysis_global_variable_recover_handler(RzCore *core, int argc, const char **argv);
 // "avr"
 RZ_IPI RzCmdStatus rz_analysis_print_rtti_handler(RzCore *core, int argc, const char **argv, RzOutputMode mode);
 // "avra"
@@ -741,6 +747,14 @@ RZ_IPI RzCmdStatus rz_analysis_basic_block_info_handler(RzCore *core, int argc,
 RZ_IPI RzCmdStatus rz_analysis_basic_block_list_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state);
 // "abt"
 RZ_IPI RzCmdStatus rz_analysis_basic_block_find_paths_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state);
+// "aC"
+RZ_IPI RzCmdStatus rz_analysis_coverage_load_handler(RzCore *core, int argc, const char **argv);
+// "aCb"
+RZ_IPI RzCmdStatus rz_analysis_coverage_blocks_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state);
+// "aCf"
+RZ_IPI RzCmdStatus rz_analysis_coverage_functions_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state);
+// "aC-"
+RZ_IPI RzCmdStatus rz_analysis_coverage_reset_handler(RzCore *core, int argc, const char **argv);
 // "as"
 RZ_IPI RzCmdStatus rz_analysis_syscall_show_handler(RzCore *core, int argc, const char **argv);
 // "asl"
@@ -1552,6 +1566,10 @@ RZ_IPI RzCmdStatus rz_cmd_info_section_bars_handler(RzCore *core, int argc, cons
 RZ_IPI RzCmdStatus rz_cmd_info_segments_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state);
 // "iSS."
 RZ_IPI RzCmdStatus rz_cmd_info_cur_segment_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state);
+// "it"
+RZ_IPI RzCmdStatus rz_cmd_info_threads_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state);
+// "it="
+RZ_IPI RzCmdStatus rz_cmd_info_thread_select_handler(RzCore *core, int argc, const char **argv);
 // "iT"
 RZ_IPI RzCmdStatus rz_cmd_info_hashes_handler(RzCore *core, int argc, const char **argv, RzCmdStateOutput *state);
 // "iV"
@@ -2256,6 +2274,8 @@ RZ_IPI RzCmdStatus rz_type_open_file_handler(RzCore *core, int argc, const char
 RZ_IPI RzCmdStatus rz_type_open_editor_handler(RzCore *core, int argc, const char **argv);
 // "tos"
 RZ_IPI RzCmdStatus rz_type_open_sdb_handler(RzCore *core, int argc, const char **argv);
+// "tob"
+RZ_IPI RzCmdStatus rz_type_open_btf_handler(RzCore *core, int argc, const char **argv);
 // "tp"
 RZ_IPI RzCmdStatus rz_type_print_handler(RzCore *core, int argc, const char **argv);
 // "tpv"
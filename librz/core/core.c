@@ -1959,6 +1959,7 @@ RZ_API char *rz_core_analysis_hasrefs_to_depth(RzCore *core, ut64 value, PJ *pj,
 				rz_asm_set_pc(core->rasm, value);
 				rz_asm_disassemble(core->rasm, &op, buf, sizeof(buf));
 				rz_strbuf_appendf(s, "'%s' ", rz_asm_op_get_asm(&op));
+				rz_asm_op_fini(&op);
 				/* get library name */
 				{ // NOTE: dup for mapname?
 					RzDebugMap *map;
@@ -2318,6 +2319,7 @@ RZ_IPI void rz_core_file_free(RzCoreFile *cf);
 RZ_IPI extern RzIOPlugin rz_core_io_plugin_vfile;
 
 RZ_API bool rz_core_init(RzCore *core) {
+	ut64 init_start = rz_time_now_mono();
 	core->blocksize = RZ_CORE_BLOCKSIZE;
 	core->block = (ut8 *)calloc(RZ_CORE_BLOCKSIZE + 1, 1);
 	if (!core->block) {
@@ -2375,9 +2377,9 @@ RZ_API bool rz_core_init(RzCore *core) {
 	core->cmdrepeat = true;
 	core->yank_buf = rz_buf_new_with_bytes(NULL, 0);
 	core->num = rz_num_new(&num_callback, &str_callback, core);
-	core->egg = rz_egg_new();
-	rz_egg_setup(core->egg, RZ_SYS_ARCH, RZ_SYS_BITS, 0, RZ_SYS_OS);
-	core->crypto = rz_crypto_new();
+	// egg and crypto are created on first use, see rz_core_get_egg() and rz_core_get_crypto()
+	core->egg = NULL;
+	core->crypto = NULL;
 
 	core->fixedarch = false;
 	core->fixedbits = false;
@@ -2479,7 +2481,9 @@ RZ_API bool rz_core_init(RzCore *core) {
 	core->files = rz_list_newf((RzListFree)rz_core_file_free);
 	core->offset = 0LL;
 	core->prompt_offset = 0LL;
+	ut64 prev = rz_time_now_mono();
 	rz_core_cmd_init(core);
+	core->times->cmd_init_time = rz_time_now_mono() - prev;
 	rz_core_plugin_init(core);
 
 	RzBreakpointContext bp_ctx = {
@@ -2506,7 +2510,9 @@ RZ_API bool rz_core_init(RzCore *core) {
 	// Initialize visual modes after everything else but before config init
 	core->visual = rz_core_visual_new();
 	// initialize config before any corebind
+	prev = rz_time_now_mono();
 	rz_core_config_init(core);
+	core->times->config_init_time = rz_time_now_mono() - prev;
 
 	rz_core_loadlibs_init(core);
 
@@ -2534,6 +2540,7 @@ RZ_API bool rz_core_init(RzCore *core) {
 	}
 	rz_core_analysis_type_init(core);
 	__init_autocomplete(core);
+	core->times->core_init_time = rz_time_now_mono() - init_start;
 	return 0;
 }
 
@@ -2584,6 +2591,7 @@ RZ_API void rz_core_fini(RzCore *c) {
 	RZ_FREE_CUSTOM(c->gadgets, rz_list_free);
 	RZ_FREE_CUSTOM(c->num, rz_num_free);
 	RZ_FREE(c->table_query);
+	rz_core_debug_symbols_reset(c);
 	RZ_FREE_CUSTOM(c->io, rz_io_free);
 	RZ_FREE_CUSTOM(c->files, rz_list_free);
 	RZ_FREE_CUSTOM(c->watchers, rz_list_free);
@@ -3223,6 +3231,38 @@ RZ_API RzBin *rz_core_get_bin(RzCore *core) {
 	return core->bin;
 }
 
+/**
+ * \brief Returns the RzEgg instance of \p core, creating it on the first call
+ *
+ * The egg carries its own assembler with all the plugins, so it is not
+ * built at startup but set up for the current asm.arch and asm.bits when needed.
+ */
+RZ_API RZ_BORROW RzEgg *rz_core_get_egg(RZ_NONNULL RzCore *core) {
+	rz_return_val_if_fail(core, NULL);
+	if (core->egg) {
+		return core->egg;
+	}
+	core->egg = rz_egg_new();
+	if (!core->egg) {
+		return NULL;
+	}
+	const char *arch = core->config ? rz_config_get(core->config, "asm.arch") : NULL;
+	int bits = core->config ? rz_config_get_i(core->config, "asm.bits") : 0;
+	rz_egg_setup(core->egg, RZ_STR_ISNOTEMPTY(arch) ? arch : RZ_SYS_ARCH, bits ? bits : RZ_SYS_BITS, 0, RZ_SYS_OS);
+	return core->egg;
+}
+
+/**
+ * \brief Returns the RzCrypto instance of \p core, creating it on the first call
+ */
+RZ_API RZ_BORROW RzCrypto *rz_core_get_crypto(RZ_NONNULL RzCore *core) {
+	rz_return_val_if_fail(core, NULL);
+	if (!core->crypto) {
+		core->crypto = rz_crypto_new();
+	}
+	return core->crypto;
+}
+
 RZ_API RzBuffer *rz_core_syscallf(RzCore *core, const char *name, const char *fmt, ...) {
 	char str[1024];
 	RzBuffer *buf;
@@ -3273,17 +3313,21 @@ RZ_API RzBuffer *rz_core_syscall(RzCore *core, const char *name, const char *arg
 		":int3\n" /// XXX USE trap
 		"}\n",
 		num, args);
-	rz_egg_reset(core->egg);
+	RzEgg *egg = rz_core_get_egg(core);
+	if (!egg) {
+		return NULL;
+	}
+	rz_egg_reset(egg);
 	// TODO: setup arch/bits/os?
-	rz_egg_load(core->egg, code, 0);
+	rz_egg_load(egg, code, 0);
 
-	if (!rz_egg_compile(core->egg)) {
+	if (!rz_egg_compile(egg)) {
 		RZ_LOG_ERROR("core: cannot compile.\n");
 	}
-	if (!rz_egg_assemble(core->egg)) {
+	if (!rz_egg_assemble(egg)) {
 		RZ_LOG_ERROR("core: rz_egg_assemble: invalid assembly\n");
 	}
-	return rz_egg_get_bin(core->egg);
+	return rz_egg_get_bin(egg);
 }
 
 RZ_API RzCoreAutocomplete *rz_core_autocomplete_add(RzCoreAutocomplete *parent, const char *cmd, int type, bool lock) {
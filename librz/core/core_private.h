@@ -95,6 +95,8 @@ RZ_IPI void rz_core_types_union_print_format_all(RzCore *core);
 RZ_IPI void rz_core_types_print_all(RzCore *core, RzOutputMode mode);
 RZ_IPI void rz_types_define(RzCore *core, const char *type);
 RZ_IPI bool rz_types_open_file(RzCore *core, const char *path);
+RZ_IPI bool rz_types_open_files(RzCore *core, const char **paths, int count);
+RZ_IPI bool rz_types_open_btf(RzCore *core, RZ_NULLABLE const char *path);
 RZ_IPI bool rz_types_open_editor(RzCore *core, RZ_NONNULL const char *typename);
 
 /* agraph.c */
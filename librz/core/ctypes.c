@@ -940,33 +940,140 @@ RZ_IPI void rz_types_define(RzCore *core, const char *type) {
 	}
 }
 
+/**
+ * Creates the C preprocessor for the current target, the headers
+ * are searched in the directories from `dir.types`
+ */
+static RzTypePreprocessor *types_preprocessor_new(RzCore *core) {
+	RzTypePreprocessor *pp = rz_type_preprocessor_new(core->analysis->typedb->target);
+	if (!pp) {
+		return NULL;
+	}
+	RzList *dirs = rz_str_split_duplist(rz_config_get(core->config, "dir.types"), RZ_SYS_ENVSEP, true);
+	RzListIter *it;
+	const char *dir;
+	rz_list_foreach (dirs, it, dir) {
+		if (RZ_STR_ISNOTEMPTY(dir)) {
+			rz_type_preprocessor_add_include_dir(pp, dir);
+		}
+	}
+	rz_list_free(dirs);
+	return pp;
+}
+
+static void types_report_errors(char *error_msg) {
+	if (!error_msg) {
+		return;
+	}
+	rz_str_trim_tail(error_msg);
+	if (*error_msg) {
+		RZ_LOG_ERROR("%s\n", error_msg);
+	}
+	free(error_msg);
+}
+
 RZ_IPI bool rz_types_open_file(RzCore *core, const char *path) {
-	const char *dir = rz_config_get(core->config, "dir.types");
 	RzTypeDB *typedb = core->analysis->typedb;
+	RzTypePreprocessor *pp = types_preprocessor_new(core);
+	if (!pp) {
+		return false;
+	}
+	char *code = NULL;
+	char *error_msg = NULL;
 	if (!strcmp(path, "-")) {
 		char *tmp = rz_core_editor(core, "*.h", "");
 		if (tmp) {
-			char *error_msg = NULL;
-			int result = rz_type_parse_string_stateless(typedb->parser, tmp, &error_msg);
-			if (result && error_msg) {
-				rz_str_trim_tail(error_msg);
-				RZ_LOG_ERROR("%s\n", error_msg);
-				free(error_msg);
-			}
+			code = rz_type_preprocess_string(pp, tmp, NULL, &error_msg);
 			free(tmp);
 		}
 	} else {
 		if (!rz_file_exists(path)) {
 			RZ_LOG_ERROR("File \"%s\" does not exist\n", path);
+			rz_type_preprocessor_free(pp);
 			return false;
 		}
-		char *error_msg = NULL;
-		int result = rz_type_parse_file_stateless(typedb->parser, path, dir, &error_msg);
-		if (result && error_msg) {
-			RZ_LOG_ERROR("%s", error_msg);
-			free(error_msg);
+		code = rz_type_preprocess_file(pp, path, &error_msg);
+	}
+	rz_type_preprocessor_free(pp);
+	types_report_errors(error_msg);
+	if (!code) {
+		return true;
+	}
+	error_msg = NULL;
+	int result = rz_type_parse_string_stateless(typedb->parser, code, &error_msg);
+	if (result) {
+		types_report_errors(error_msg);
+	} else {
+		free(error_msg);
+	}
+	free(code);
+	return true;
+}
+
+static RzBuffer *btf_section_buf(RzCore *core) {
+	RzBinFile *bf = rz_bin_cur(core->bin);
+	if (!bf || !bf->o || !bf->buf) {
+		return NULL;
+	}
+	RzBuffer *buf = NULL;
+	RzList *sections = rz_bin_object_get_sections(bf->o);
+	RzListIter *iter;
+	RzBinSection *section;
+	rz_list_foreach (sections, iter, section) {
+		if (section->name && !strcmp(section->name, ".BTF")) {
+			buf = rz_buf_new_slice(bf->buf, section->paddr, section->size);
+			break;
+		}
+	}
+	rz_list_free(sections);
+	return buf;
+}
+
+/**
+ * \brief Loads the BTF types and function signatures from \p path or the .BTF section of the current binary
+ */
+RZ_IPI bool rz_types_open_btf(RzCore *core, RZ_NULLABLE const char *path) {
+	rz_return_val_if_fail(core, false);
+	RzBuffer *buf = path ? rz_buf_new_slurp(path) : btf_section_buf(core);
+	if (!buf) {
+		RZ_LOG_ERROR("Cannot find BTF data in %s\n", path ? path : "the current binary");
+		return false;
+	}
+	RzAnalysisBTF *btf = rz_analysis_btf_new(core->analysis->typedb, buf);
+	rz_buf_free(buf);
+	if (!btf) {
+		return false;
+	}
+	rz_analysis_btf_load_all(btf);
+	rz_analysis_btf_free(btf);
+	return true;
+}
+
+/**
+ * \brief Loads the types from several C headers at once, parsing them in parallel
+ */
+RZ_IPI bool rz_types_open_files(RzCore *core, const char **paths, int count) {
+	rz_return_val_if_fail(core && paths, false);
+	RzPVector files;
+	rz_pvector_init(&files, NULL);
+	for (int i = 0; i < count; i++) {
+		if (!rz_file_exists(paths[i])) {
+			RZ_LOG_ERROR("File \"%s\" does not exist\n", paths[i]);
+			rz_pvector_fini(&files);
+			return false;
 		}
+		rz_pvector_push(&files, (void *)paths[i]);
 	}
+	RzTypePreprocessor *pp = types_preprocessor_new(core);
+	if (!pp) {
+		rz_pvector_fini(&files);
+		return false;
+	}
+	char *error_msg = NULL;
+	rz_type_parse_headers(core->analysis->typedb, pp, &files, RZ_THREAD_POOL_ALL_CORES, &error_msg);
+	types_report_errors(error_msg);
+	rz_type_preprocessor_free(pp);
+	rz_pvector_fini(&files);
 	return true;
 }
 
@@ -121,6 +121,7 @@ typedef struct {
 	ut32 debuginfo;
 	bool show_size;
 	bool show_trace;
+	bool show_coverage;
 	bool show_family;
 	bool asm_describe;
 	int linesout;
@@ -640,6 +641,7 @@ static RzDisasmState *ds_init(RzCore *core) {
 	ds->show_lines_ret = ds->show_lines ? rz_config_get_b(core->config, "asm.lines.ret") : false;
 	ds->show_size = rz_config_get_b(core->config, "asm.size");
 	ds->show_trace = rz_config_get_b(core->config, "asm.trace");
+	ds->show_coverage = rz_config_get_b(core->config, "asm.coverage") && !rz_analysis_coverage_empty(core->analysis);
 	ds->linesout = rz_config_get_i(core->config, "asm.lines.out");
 	ds->adistrick = rz_config_get_i(core->config, "asm.middle"); // TODO: find better name
 	ds->asm_describe = rz_config_get_b(core->config, "asm.describe");
@@ -770,6 +772,9 @@ static RzDisasmState *ds_init(RzCore *core) {
 	if (ds->show_trace) {
 		ds->ocols += 8;
 	}
+	if (ds->show_coverage) {
+		ds->ocols += 9;
+	}
 	if (ds->show_stackptr) {
 		ds->ocols += 4;
 	}
@@ -1042,7 +1047,7 @@ static void ds_build_op_str(RzDisasmState *ds, bool print_color) {
 		}
 
 		ds_opstr_try_colorize(ds, print_color);
-		rz_parse_filter(core->parser, ds->vat, core->flags, ds->hint, ds->opstr,
+		rz_parse_filter_tokens(core->parser, ds->vat, core->flags, ds->hint, ds->asmop.asm_toks, ds->opstr,
 			ds->str, sizeof(ds->str), core->print->big_endian);
 		// subvar depends on filter
 		if (ds->subvar) {
@@ -2462,7 +2467,7 @@ static int ds_disassemble(RzDisasmState *ds, ut8 *buf, int len) {
 	}
 	if (ds->hint && ds->hint->bits) {
 		if (!ds->core->analysis->opt.ignbithints) {
-			rz_config_set_i(core->config, "asm.bits", ds->hint->bits);
+			rz_core_set_mode_bits(core, ds->hint->bits);
 		}
 	}
 	if (ds->hint && ds->hint->size) {
@@ -2843,6 +2848,9 @@ static void ds_print_offset(RzDisasmState *ds) {
 			RzDebugTracepoint *tp = rz_debug_trace_get(ds->core->dbg, ds->at);
 			show_trace = (tp ? !!tp->count : false);
 		}
+		if (ds->show_coverage && rz_analysis_coverage_hits_at(core->analysis, at)) {
+			show_trace = true;
+		}
 		if (ds->hint && ds->hint->high) {
 			show_trace = true;
 		}
@@ -2915,6 +2923,14 @@ static void ds_print_trace(RzDisasmState *ds) {
 		tp = rz_debug_trace_get(ds->core->dbg, ds->at);
 		rz_cons_printf("%02x:%04x ", tp ? tp->times : 0, tp ? tp->count : 0);
 	}
+	if (ds->show_coverage) {
+		ut64 hits = rz_analysis_coverage_hits_at(ds->core->analysis, ds->at);
+		if (hits) {
+			rz_cons_printf("%8" PFMT64u " ", hits);
+		} else {
+			rz_cons_strcat("         ");
+		}
+	}
 	if (ds->tracespace) {
 		char spaces[32];
 		int times;
@@ -3008,7 +3024,7 @@ static bool ds_print_data_type(RzDisasmState *ds, const ut8 *buf, int ib, int si
 
 	if (size == 4 || size == 8) {
 		if (rz_str_startswith(rz_config_get(core->config, "asm.arch"), "arm")) {
-			ut64 bits = rz_config_get_i(core->config, "asm.bits");
+			int bits = core->rasm->bits;
 			// adjust address for arm/thumb address
 			if (bits < 64) {
 				if (n & 1) {
@@ -3514,16 +3530,12 @@ static int ds_print_shortcut(RzDisasmState *ds, ut64 addr, int pos) {
 static bool ds_print_core_vmode_jump_hit(RzDisasmState *ds, int pos) {
 	RzCore *core = ds->core;
 	RzAnalysis *a = core->analysis;
-	RzAnalysisHint *hint = rz_analysis_hint_get(a, ds->at);
-	bool res = false;
-	if (hint) {
-		if (hint->jump != UT64_MAX) {
-			ds_print_shortcut(ds, hint->jump, pos);
-			res = true;
-		}
-		rz_analysis_hint_free(hint);
+	const RzAnalysisHint *hint = rz_analysis_hint_view_at(a, ds->at);
+	if (hint && hint->jump != UT64_MAX) {
+		ds_print_shortcut(ds, hint->jump, pos);
+		return true;
 	}
-	return res;
+	return false;
 }
 
 static ut64 get_ptr(RzDisasmState *ds, ut64 addr) {
@@ -5470,6 +5482,7 @@ toro:
 				rz_asm_set_syntax(core->rasm, RZ_ASM_SYNTAX_INTEL);
 				rz_asm_disassemble(core->rasm, &ao, buf + addrbytes * idx,
 					len - addrbytes * idx + 5);
+				rz_asm_op_fini(&ao);
 				rz_asm_set_syntax(core->rasm, os);
 			}
 			if (mi_type == RZ_META_TYPE_FORMAT) {
@@ -5510,6 +5523,7 @@ toro:
 				rz_asm_set_syntax(core->rasm, RZ_ASM_SYNTAX_INTEL);
 				rz_asm_disassemble(core->rasm, &ao, buf + addrbytes * idx,
 					len - addrbytes * idx + 5);
+				rz_asm_op_fini(&ao);
 				rz_asm_set_syntax(core->rasm, os);
 			}
 			if (ds->show_bytes_right && ds->show_bytes) {
@@ -5680,6 +5694,7 @@ toro:
 		rz_asm_set_pc(core->rasm, ds->at);
 		// XXX copypasta from main disassembler function
 		// rz_analysis_get_fcn_in (core->analysis, ds->at, RZ_ANALYSIS_FCN_TYPE_NULL);
+		rz_asm_op_fini(&ds->asmop);
 		ret = rz_asm_disassemble(core->rasm, &ds->asmop,
 			buf + addrbytes * i, len);
 		ds->oplen = ret;
@@ -6074,7 +6089,7 @@ RZ_API int rz_core_print_disasm_all(RzCore *core, ut64 addr, int l, int len, int
 			count++;
 			switch (mode) {
 			case 'i':
-				rz_parse_filter(core->parser, ds->vat, core->flags, ds->hint, rz_asm_op_get_asm(&asmop),
+				rz_parse_filter_tokens(core->parser, ds->vat, core->flags, ds->hint, asmop.asm_toks, rz_asm_op_get_asm(&asmop),
 					str, sizeof(str), core->print->big_endian);
 				if (scr_color) {
 					RzAnalysisOp aop;
@@ -6132,6 +6147,7 @@ RZ_API int rz_core_print_disasm_all(RzCore *core, ut64 addr, int l, int len, int
 			}
 			}
 		}
+		rz_asm_op_fini(&asmop);
 	}
 	rz_cons_break_pop();
 	if (buf != core->block) {
@@ -6185,6 +6201,8 @@ RZ_API int rz_core_disasm_pdi_with_buf(RzCore *core, ut64 address, ut8 *buf, ut3
 	i = 0;
 	j = 0;
 	RzAnalysisMetaItem *meta = NULL;
+	RzAnalysisHintCursor hint_cursor;
+	rz_analysis_hint_cursor_init(&hint_cursor, core->analysis);
 toro:
 	for (; rz_disasm_check_end(nb_opcodes, j, nb_bytes, addrbytes * i); j++) {
 		if (rz_cons_is_breaked()) {
@@ -6285,6 +6303,7 @@ toro:
 			if (comment) {
 				rz_cons_printf("0x%08" PFMT64x " %s\n", core->offset + i, comment);
 			}
+			rz_asm_op_fini(&asmop);
 			i += ret;
 			continue;
 		}
@@ -6343,10 +6362,9 @@ toro:
 					rz_parse_immtrim(asm_str);
 				}
 				if (subnames) {
-					RzAnalysisHint *hint = rz_analysis_hint_get(core->analysis, at);
-					rz_parse_filter(core->parser, at, core->flags, hint,
+					const RzAnalysisHint *hint = rz_analysis_hint_cursor_at(&hint_cursor, at);
+					rz_parse_filter_tokens(core->parser, at, core->flags, hint, asmop.asm_toks,
 						asm_str, opstr, sizeof(opstr) - 1, core->print->big_endian);
-					rz_analysis_hint_free(hint);
 					asm_str = (char *)&opstr;
 				}
 				if (show_color) {
@@ -6367,6 +6385,7 @@ toro:
 				}
 			}
 		}
+		rz_asm_op_fini(&asmop);
 		i += ret;
 	}
 	if (buf == core->block && nb_opcodes > 0 && j < nb_opcodes) {
@@ -6622,10 +6641,9 @@ RZ_API RZ_OWN char *rz_core_disasm_instruction(RzCore *core, ut64 addr, ut64 rel
 			ba, ba, sizeof(asmop.buf_asm));
 		rz_analysis_op_fini(&op);
 	}
-	RzAnalysisHint *hint = rz_analysis_hint_get(core->analysis, addr);
-	rz_parse_filter(core->parser, addr, core->flags, hint,
+	const RzAnalysisHint *hint = rz_analysis_hint_view_at(core->analysis, addr);
+	rz_parse_filter_tokens(core->parser, addr, core->flags, hint, asmop.asm_toks,
 		ba, str, sizeof(str), core->print->big_endian);
-	rz_analysis_hint_free(hint);
 	rz_asm_op_set_asm(&asmop, ba);
 	free(ba);
 	if (color && has_color) {
@@ -6634,10 +6652,12 @@ RZ_API RZ_OWN char *rz_core_disasm_instruction(RzCore *core, ut64 addr, ut64 rel
 		colored_asm = rz_asm_colorize_asm_str(bw_str, core->print, param, asmop.asm_toks);
 		rz_strbuf_free(bw_str);
 		free(param);
+		rz_asm_op_fini(&asmop);
 		return colored_asm ? rz_strbuf_drain(colored_asm) : NULL;
 	} else {
 		buf_asm = rz_str_new(str);
 	}
+	rz_asm_op_fini(&asmop);
 	return buf_asm;
 }
 
@@ -17,6 +17,19 @@
 		return rz_##x##_plugin_del(core->y, hand); \
 	}
 
+// Same as CB, for the instances created on first use
+#define CB_LAZY(x) \
+	static bool lib_##x##_cb(RzLibPlugin *pl, void *user, void *data) { \
+		struct rz_##x##_plugin_t *hand = (struct rz_##x##_plugin_t *)data; \
+		struct rz_##x##_t *x = rz_core_get_##x((RzCore *)user); \
+		return x && rz_##x##_plugin_add(x, hand); \
+	} \
+	static bool lib_##x##_dt(RzLibPlugin *pl, void *user, void *data) { \
+		struct rz_##x##_plugin_t *hand = (struct rz_##x##_plugin_t *)data; \
+		RzCore *core = (RzCore *)user; \
+		return core->x && rz_##x##_plugin_del(core->x, hand); \
+	}
+
 static bool lib_core_cb(RzLibPlugin *pl, void *user, void *data) {
 	RzCore *core = (RzCore *)user;
 	return rz_core_plugin_add(core, (RzCorePlugin *)data);
@@ -28,7 +41,7 @@ static bool lib_core_dt(RzLibPlugin *pl, void *user, void *data) {
 }
 
 CB(io, io)
-CB(crypto, crypto)
+CB_LAZY(crypto)
 CB(debug, dbg)
 CB(bp, dbg->bp)
 CB(lang, lang)
@@ -37,7 +50,7 @@ CB(asm, rasm)
 CB(parse, parser)
 CB(bin, bin)
 CB(demangler, bin->demangler)
-CB(egg, egg)
+CB_LAZY(egg)
 CB(hash, hash)
 
 static void loadSystemPlugins(RzCore *core, int where) {
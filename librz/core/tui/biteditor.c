@@ -37,9 +37,11 @@ RZ_IPI bool rz_core_visual_bit_editor(RzCore *core) {
 		cur = core->print->cur;
 	}
 	memcpy(buf, core->block + cur, sizeof(ut64));
+	rz_asm_op_init(&asmop);
 	for (;;) {
 		rz_cons_clear00();
 		bool use_color = core->print->flags & RZ_PRINT_FLAGS_COLOR;
+		rz_asm_op_fini(&asmop);
 		(void)rz_asm_disassemble(core->rasm, &asmop, buf, sizeof(ut64));
 		aop.type = -1;
 		(void)rz_analysis_op(core->analysis, &aop, core->offset, buf, sizeof(ut64), RZ_ANALYSIS_OP_MASK_ESIL);
@@ -177,6 +179,7 @@ RZ_IPI bool rz_core_visual_bit_editor(RzCore *core) {
 			rz_core_write_at(core, core->offset, buf, 4);
 			free(res);
 			free(op_hex);
+			rz_asm_op_fini(&asmop);
 		}
 			return false;
 		case 'H': {
@@ -277,5 +280,6 @@ RZ_IPI bool rz_core_visual_bit_editor(RzCore *core) {
 		} break;
 		}
 	}
+	rz_asm_op_fini(&asmop);
 	return true;
 }
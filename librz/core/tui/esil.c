@@ -116,6 +116,7 @@ RZ_IPI bool rz_core_visual_esil(RzCore *core) {
 		rz_cons_printf("esil stack:\n");
 		rz_core_esil_dumpstack(esil);
 		rz_analysis_op_fini(&aop);
+		rz_asm_op_fini(&asmop);
 		rz_cons_newline();
 		rz_cons_visual_flush();
 
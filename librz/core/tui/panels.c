@@ -1543,6 +1543,7 @@ void __fix_cursor_down(RzCore *core) {
 			RzAsmOp op;
 			int sz = rz_asm_disassemble(core->rasm,
 				&op, core->block, 32);
+			rz_asm_op_fini(&op);
 			if (sz < 1) {
 				sz = 1;
 			}
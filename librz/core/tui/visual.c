@@ -1581,6 +1581,7 @@ static void cursor_nextrow(RzCore *core, bool use_ocur) {
 		if (next_roff + 32 < core->blocksize) {
 			sz = rz_asm_disassemble(core->rasm, &op,
 				core->block + next_roff, 32);
+			rz_asm_op_fini(&op);
 			if (sz < 1) {
 				sz = 1;
 			}
@@ -1668,6 +1669,7 @@ static void cursor_prevrow(RzCore *core, bool use_ocur) {
 				rz_core_seek(core, prev_addr, true);
 				prev_sz = rz_asm_disassemble(core->rasm, &op,
 					core->block, 32);
+				rz_asm_op_fini(&op);
 			}
 		} else {
 			prev_sz = roff - prev_roff;
@@ -1731,6 +1733,7 @@ static bool fix_cursor(RzCore *core) {
 			RzAsmOp op;
 			int sz = rz_asm_disassemble(core->rasm,
 				&op, core->block, 32);
+			rz_asm_op_fini(&op);
 			if (sz < 1) {
 				sz = 1;
 			}
@@ -2652,6 +2655,7 @@ RZ_IPI int rz_core_visual_cmd(RzCore *core, const char *arg) {
 					if (isDisasmPrint(visual->printidx)) {
 						if (core->print->screen_bounds == core->offset) {
 							rz_asm_disassemble(core->rasm, &op, core->block, 32);
+							rz_asm_op_fini(&op);
 						}
 						if (addr == core->offset || addr == UT64_MAX) {
 							addr = core->offset + 48;
@@ -3635,6 +3639,7 @@ RZ_IPI void rz_core_visual_disasm_down(RzCore *core, RzAsmOp *op, int *cols) {
 	if (*cols < 1) {
 		*cols = op->size > 1 ? op->size : 1;
 	}
+	rz_asm_op_fini(op);
 }
 
 #ifdef __WINDOWS__
@@ -1349,61 +1349,101 @@ RZ_API int rz_debug_continue_until_nontraced(RzDebug *dbg) {
 	return false;
 }
 
-RZ_API int rz_debug_continue_until_optype(RzDebug *dbg, int type, int over) {
-	int ret, n = 0;
-	ut64 pc, buf_pc = 0;
-	RzAnalysisOp op;
-	ut8 buf[DBG_BUF_SIZE];
-
-	if (rz_debug_is_dead(dbg)) {
-		return false;
+// Block-level "continue until" engine
+
+typedef enum {
+	RUN_STOP_MATCH, ///< the instruction at stop has the wanted type
+	RUN_STOP_EXIT, ///< the instruction at stop ends the block and must be stepped
+	RUN_STOP_PARTIAL, ///< the lookahead ended before the block, decode again from stop
+} RunStopKind;
+
+typedef struct {
+	ut64 stop; ///< address of the first instruction that is not executed natively
+	ut32 ninstr; ///< number of instructions executed before reaching stop
+	RunStopKind kind;
+} RunBlock;
+
+static bool op_ends_block(RzAnalysisOp *op) {
+	switch (op->type & 0xffff) {
+	case RZ_ANALYSIS_OP_TYPE_NULL:
+	case RZ_ANALYSIS_OP_TYPE_JMP:
+	case RZ_ANALYSIS_OP_TYPE_UJMP:
+	case RZ_ANALYSIS_OP_TYPE_CALL:
+	case RZ_ANALYSIS_OP_TYPE_UCALL:
+	case RZ_ANALYSIS_OP_TYPE_RET:
+	case RZ_ANALYSIS_OP_TYPE_ILL:
+	case RZ_ANALYSIS_OP_TYPE_UNK:
+	case RZ_ANALYSIS_OP_TYPE_TRAP:
+	case RZ_ANALYSIS_OP_TYPE_SWI:
+		return true;
+	default:
+		return op->eob || op->delay;
 	}
+}
 
-	if (!dbg->analysis || !dbg->reg) {
-		eprintf("Undefined pointer at dbg->analysis\n");
+/**
+ * Decodes the instructions starting at \p addr up to the first one
+ * of the wanted \p type or the first control flow transfer.
+ */
+static bool run_block_decode(RzDebug *dbg, ut64 addr, int type, RunBlock *block) {
+	ut8 buf[DBG_BUF_SIZE];
+	// Leave enough room for the longest instruction we may meet
+	const int max_op_size = 32;
+	if (dbg->iob.read_at(dbg->iob.io, addr, buf, sizeof(buf)) < 1) {
 		return false;
 	}
-
-	rz_debug_step(dbg, 1);
-	rz_debug_reg_sync(dbg, RZ_REG_TYPE_GPR, false);
-
-	// Initial refill
-	buf_pc = rz_debug_reg_get(dbg, dbg->reg->name[RZ_REG_NAME_PC]);
-	dbg->iob.read_at(dbg->iob.io, buf_pc, buf, sizeof(buf));
-
-	// step first, we don't want to check current optype
-	for (;;) {
-		if (!rz_debug_reg_sync(dbg, RZ_REG_TYPE_GPR, false)) {
-			break;
-		}
-
-		pc = rz_debug_reg_get(dbg, dbg->reg->name[RZ_REG_NAME_PC]);
-		// Try to keep the buffer full
-		if (pc - buf_pc > sizeof(buf)) {
-			buf_pc = pc;
-			dbg->iob.read_at(dbg->iob.io, buf_pc, buf, sizeof(buf));
-		}
-		// Analyze the opcode
-		if (rz_analysis_op(dbg->analysis, &op, pc, buf + (pc - buf_pc), sizeof(buf) - (pc - buf_pc), RZ_ANALYSIS_OP_MASK_BASIC) < 1) {
-			eprintf("Decode error at %" PFMT64x "\n", pc);
-			return false;
+	RzAnalysisOp op;
+	int offset = 0;
+	block->ninstr = 0;
+	while (offset <= (int)sizeof(buf) - max_op_size) {
+		ut64 cur = addr + offset;
+		rz_analysis_op_init(&op);
+		int size = rz_analysis_op(dbg->analysis, &op, cur, buf + offset, sizeof(buf) - offset, RZ_ANALYSIS_OP_MASK_BASIC);
+		if (size < 1) {
+			rz_analysis_op_fini(&op);
+			if (!block->ninstr) {
+				eprintf("Decode error at %" PFMT64x "\n", cur);
+				return false;
+			}
+			// Let the single step deal with it
+			block->stop = cur;
+			block->kind = RUN_STOP_EXIT;
+			return true;
 		}
-		if (op.type == type) {
-			break;
+		bool match = op.type == type;
+		bool end = op_ends_block(&op);
+		rz_analysis_op_fini(&op);
+		if (match || end) {
+			block->stop = cur;
+			block->kind = match ? RUN_STOP_MATCH : RUN_STOP_EXIT;
+			return true;
 		}
-		// Step over and repeat
-		ret = over
-			? rz_debug_step_over(dbg, 1)
-			: rz_debug_step(dbg, 1);
+		block->ninstr++;
+		offset += size;
+	}
+	block->stop = addr + offset;
+	block->kind = RUN_STOP_PARTIAL;
+	return true;
+}
 
-		if (!ret) {
-			eprintf("rz_debug_step: failed\n");
-			break;
-		}
-		n++;
+static RunBlock *run_block_get(RzDebug *dbg, HtUP *cache, ut64 addr, int type) {
+	RunBlock *block = ht_up_find(cache, addr, NULL);
+	if (block) {
+		return block;
+	}
+	block = RZ_NEW0(RunBlock);
+	if (!block) {
+		return NULL;
 	}
+	if (!run_block_decode(dbg, addr, type, block) || !ht_up_insert(cache, addr, block)) {
+		free(block);
+		return NULL;
+	}
+	return block;
+}
 
-	return n;
+static void run_block_kv_free(HtUPKv *kv) {
+	free(kv->value);
 }
 
 static int rz_debug_continue_until_internal(RzDebug *dbg, ut64 addr, bool block) {
@@ -1438,6 +1478,92 @@ static int rz_debug_continue_until_internal(RzDebug *dbg, ut64 addr, bool block)
 	return true;
 }
 
+/**
+ * \brief Continues the execution until an instruction of the given \p type is reached
+ *
+ * The instructions up to the end of the current basic block are decoded ahead
+ * and the process runs natively until the first matching instruction or the
+ * block exit, using a temporary breakpoint. Only the block exits are stepped.
+ * The decoded blocks are cached for the duration of the call.
+ *
+ * \param dbg The debugger
+ * \param type The RzAnalysisOpType to stop at, the stop happens before executing it
+ * \param over Step over the calls instead of stepping into them
+ * \return The number of instructions executed before the stop
+ */
+RZ_API int rz_debug_continue_until_optype(RzDebug *dbg, int type, int over) {
+	int n = 0;
+
+	if (rz_debug_is_dead(dbg)) {
+		return false;
+	}
+
+	if (!dbg->analysis || !dbg->reg) {
+		eprintf("Undefined pointer at dbg->analysis\n");
+		return false;
+	}
+	HtUP *cache = ht_up_new(NULL, run_block_kv_free, NULL);
+	if (!cache) {
+		return false;
+	}
+
+	// step first, we don't want to check current optype
+	rz_debug_step(dbg, 1);
+
+	for (;;) {
+		if (rz_debug_is_dead(dbg) || rz_cons_singleton()->context->breaked) {
+			break;
+		}
+		if (!rz_debug_reg_sync(dbg, RZ_REG_TYPE_GPR, false)) {
+			break;
+		}
+		ut64 pc = rz_debug_reg_get(dbg, dbg->reg->name[RZ_REG_NAME_PC]);
+		RunBlock *block = run_block_get(dbg, cache, pc, type);
+		if (!block) {
+			break;
+		}
+		if (block->stop != pc) {
+			if (rz_bp_get_at(dbg->bp, pc)) {
+				// A user breakpoint here would stop the continue right away
+				if (!rz_debug_step(dbg, 1)) {
+					eprintf("rz_debug_step: failed\n");
+					break;
+				}
+				n++;
+				continue;
+			}
+			rz_debug_continue_until_internal(dbg, block->stop, true);
+			if (rz_debug_is_dead(dbg) || !rz_debug_reg_sync(dbg, RZ_REG_TYPE_GPR, false)) {
+				break;
+			}
+			ut64 npc = rz_debug_reg_get(dbg, dbg->reg->name[RZ_REG_NAME_PC]);
+			if (npc != block->stop) {
+				// Stopped by something else, e.g. another breakpoint or a signal
+				break;
+			}
+			n += block->ninstr;
+		}
+		if (block->kind == RUN_STOP_MATCH) {
+			break;
+		}
+		if (block->kind == RUN_STOP_PARTIAL) {
+			continue;
+		}
+		// Step over and repeat
+		int ret = over
+			? rz_debug_step_over(dbg, 1)
+			: rz_debug_step(dbg, 1);
+		if (!ret) {
+			eprintf("rz_debug_step: failed\n");
+			break;
+		}
+		n++;
+	}
+
+	ht_up_free(cache);
+	return n;
+}
+
 RZ_API int rz_debug_continue_until(RzDebug *dbg, ut64 addr) {
 	return rz_debug_continue_until_internal(dbg, addr, true);
 }
@@ -34,6 +34,7 @@ RZ_API bool rz_debug_map_sync(RzDebug *dbg) {
 		if (newmaps) {
 			rz_list_free(dbg->maps);
 			dbg->maps = newmaps;
+			dbg->maps_gen++;
 			ret = true;
 		}
 	}
@@ -169,6 +169,8 @@ typedef struct rz_analysis_function_t {
 	bool is_noreturn : 1; // true if function does not return
 	int argnum; // number of arguments;
 	RzList /*<RzAnalysisBlock *>*/ *bbs; // TODO: should be RzPVector
+	HtUP /*<RzAnalysisBlock *, RzListIter *>*/ *bbs_index; ///< block => its node in bbs, for fast membership and removal
+	struct rz_analysis_cfg_t *cfg; ///< PRIVATE, cached control flow analyses, use rz_analysis_function_get_cfg() to access
 	RzAnalysisFcnMeta meta;
 	RzList /*<char *>*/ *imports; // maybe bound to class?
 	struct rz_analysis_t *analysis; // this function is associated with this instance
@@ -454,6 +456,7 @@ typedef struct {
 	HtUP /*<ut64, RzType *>*/ *type_by_offset; ///< Store all RzType parsed from DWARF by DIE offset
 	HtUP /*<ut64, RzBaseType *>*/ *base_type_by_offset; ///< Store all RzBaseType parsed from DWARF by DIE offset
 	HtPP /*<const char*, RzPVector<const RzBaseType *>>*/ *base_type_by_name; ///< Store all RzBaseType parsed from DWARF by DIE offset
+	HtUP /*<ut64, const RzBaseType *>*/ *base_type_by_hash; ///< First RzBaseType of every structure, to store identical types of different units only once
 	DWARF_RegisterMapping dwarf_register_mapping; ///< Store the mapping function between DWARF registers number and register name in current architecture
 	RzBinDWARF *dw; ///< Holds ownership of RzBinDwarf, avoid releasing it prematurely
 	SetU *visited;
@@ -502,6 +505,8 @@ typedef struct rz_analysis_t {
 	HtUP /*<RzVector<RzAnalysisAddrHintRecord>>*/ *addr_hints; // all hints that correspond to a single address
 	RBTree /*<RzAnalysisArchHintRecord>*/ arch_hints;
 	RBTree /*<RzAnalysisArchBitsRecord>*/ bits_hints;
+	ut32 hints_gen; // incremented on every change of the hints, to invalidate cursors
+	struct rz_analysis_hint_cursor_t *hint_cursor; // used by rz_analysis_hint_view_at()
 	RHintCb hint_cbs;
 	RzIntervalTree meta;
 	RzSpaces meta_spaces;
@@ -529,6 +534,7 @@ typedef struct rz_analysis_t {
 	RBTree global_var_tree; // global variables by address. must not overlap
 	RzHash *hash;
 	RzAnalysisDebugInfo *debug_info; ///< store all debug info parsed from DWARF, etc.
+	HtUU *coverage; ///< basic block address => hit count, see coverage.c
 } RzAnalysis;
 
 typedef enum rz_analysis_addr_hint_type_t {
@@ -593,6 +599,25 @@ typedef struct rz_analysis_hint_t {
 	ut64 stackframe;
 } RzAnalysisHint;
 
+/**
+ * \brief Cached lookup position for the hints of ascending addresses
+ *
+ * The arch and bits hints in effect are kept together with the range where they
+ * apply and only looked up again once an address falls outside of it, so a
+ * linear sweep costs one hash lookup per address plus one tree lookup per range.
+ */
+typedef struct rz_analysis_hint_cursor_t {
+	RzAnalysis *analysis;
+	ut32 gen; ///< analysis->hints_gen at the time the ranges below were computed
+	ut64 arch_from; ///< first address where arch applies
+	ut64 arch_to; ///< last address where arch applies
+	const char *arch;
+	ut64 bits_from; ///< first address where bits applies
+	ut64 bits_to; ///< last address where bits applies
+	int bits;
+	RzAnalysisHint view; ///< returned by the last lookup, borrows all its strings
+} RzAnalysisHintCursor;
+
 typedef RzAnalysisFunction *(*RzAnalysisGetFcnIn)(RzAnalysis *analysis, ut64 addr, int type);
 typedef RzAnalysisHint *(*RzAnalysisGetHint)(RzAnalysis *analysis, ut64 addr);
 
@@ -970,6 +995,47 @@ typedef struct rz_analysis_bb_t {
 	int ref;
 } RzAnalysisBlock;
 
+/**
+ * \brief A natural loop of a function
+ */
+typedef struct rz_analysis_loop_t {
+	RzAnalysisBlock *header; ///< Entry of the loop, it dominates all the blocks of the loop
+	size_t parent; ///< Index of the enclosing loop in RzAnalysisCFG.loops, SIZE_MAX for the outermost loops
+	ut32 depth; ///< Nesting depth, 1 for the outermost loops
+	size_t size; ///< Number of blocks of the loop, including the ones of the nested loops
+} RzAnalysisLoop;
+
+/**
+ * \brief Structural information about a block in RzAnalysisCFG
+ *
+ * All the indexes refer to RzAnalysisCFG.blocks, SIZE_MAX means none.
+ */
+typedef struct rz_analysis_cfg_node_t {
+	size_t idom; ///< Immediate dominator, none for the entry and the unreachable blocks
+	size_t ipdom; ///< Immediate post-dominator, none for the exits and the blocks never reaching an exit
+	size_t scc; ///< Strongly connected component id
+	size_t loop; ///< Innermost loop containing the block, index in RzAnalysisCFG.loops
+	size_t dom_pre, dom_post; ///< Interval in the dominator tree
+	size_t pdom_pre, pdom_post; ///< Interval in the post-dominator tree
+} RzAnalysisCFGNode;
+
+/**
+ * \brief Dominators, post-dominators, loops and SCCs of a function
+ *
+ * It is computed lazily by rz_analysis_function_get_cfg() and dropped
+ * whenever the blocks of the function change.
+ */
+typedef struct rz_analysis_cfg_t {
+	RzPVector /*<RzAnalysisBlock *>*/ blocks; ///< Blocks of the function sorted by address
+	RzVector /*<RzAnalysisCFGNode>*/ nodes; ///< Information about the blocks, same order as blocks
+	RzVector /*<RzAnalysisLoop>*/ loops; ///< Natural loops, the enclosing loops come before the nested ones
+	HtUP /*<RzAnalysisBlock *, size_t>*/ *index; ///< Block => index in blocks
+	size_t entry; ///< Index of the entry block, SIZE_MAX if the function has no block at its address
+	size_t n_sccs; ///< Number of strongly connected components
+	int n_back_jumps; ///< Number of edges to a lower address, see rz_analysis_function_loops()
+	int complexity; ///< Cyclomatic complexity, see rz_analysis_function_complexity()
+} RzAnalysisCFG;
+
 typedef struct rz_analysis_task_item {
 	RzAnalysisFunction *fcn; ///< current function
 	RzAnalysisBlock *block; ///< block being analyzed
@@ -1239,6 +1305,80 @@ struct rz_analysis_il_vm_t {
 	RZ_NONNULL RzILRegBinding *reg_binding; ///< specifies which (global) variables are bound to registers
 } /* RzAnalysisILVM */;
 
+/**
+ * \brief Kind of a definition in the SSA form of a function
+ */
+typedef enum {
+	RZ_ANALYSIS_IL_SSA_DEF_ENTRY, ///< value of a variable when entering the function
+	RZ_ANALYSIS_IL_SSA_DEF_PHI, ///< merge of the values flowing in from the predecessors of a block
+	RZ_ANALYSIS_IL_SSA_DEF_SET, ///< variable set to the value of an expression
+	RZ_ANALYSIS_IL_SSA_DEF_ITE, ///< merge of the values set in the two branches of a `branch` effect
+	RZ_ANALYSIS_IL_SSA_DEF_CLOBBER, ///< variable set inside a `repeat` effect, value unknown
+	RZ_ANALYSIS_IL_SSA_DEF_STORE, ///< new state of a memory after a store
+	RZ_ANALYSIS_IL_SSA_DEF_JMP, ///< target of a `jmp` effect, not bound to any variable
+	RZ_ANALYSIS_IL_SSA_DEF_DEAD ///< trivial phi, replaced by its only operand
+} RzAnalysisILSSADefKind;
+
+typedef struct rz_analysis_il_ssa_operand_t {
+	ut32 def; ///< id of the used definition, UT32_MAX if the variable is undefined at this point
+	RZ_BORROW RzILOpPure *node; ///< `var` or `load` op reading the definition, NULL for phi and ite operands
+	ut64 pred; ///< address of the block the value flows in from, for phi operands
+} RzAnalysisILSSAOperand;
+
+/**
+ * \brief A single static assignment of an IL variable or memory
+ */
+typedef struct rz_analysis_il_ssa_def_t {
+	ut32 id; ///< index in RzAnalysisILSSA.defs
+	RzAnalysisILSSADefKind kind;
+	ut32 var; ///< index in RzAnalysisILSSA.vars, UT32_MAX for jumps
+	ut32 version; ///< number of the definition among the ones of the same variable
+	ut64 addr; ///< address of the defining instruction, or of the block for phis
+	ut32 block; ///< index in RzAnalysisILSSA.blocks
+	RZ_BORROW RzILOpPure *value; ///< expression for set, store and jmp, condition for ite
+	RzVector /*<RzAnalysisILSSAOperand>*/ operands; ///< definitions this one depends on, ite arms come first
+	RzVector /*<ut32>*/ users; ///< ids of the definitions depending on this one, may repeat
+} RzAnalysisILSSADef;
+
+typedef struct rz_analysis_il_ssa_var_t {
+	char *name;
+	bool local; ///< local IL variable, only live inside a single instruction
+	bool mem; ///< state of a memory rather than a variable
+	ut32 versions; ///< number of definitions created so far
+	ut32 entry; ///< id of the RZ_ANALYSIS_IL_SSA_DEF_ENTRY definition or UT32_MAX
+} RzAnalysisILSSAVar;
+
+typedef struct rz_analysis_il_ssa_block_t {
+	RZ_BORROW RzAnalysisBlock *bb;
+	RzVector /*<ut32>*/ preds; ///< indices of the predecessor blocks inside the function
+	RzVector /*<ut32>*/ phis; ///< ids of the phi definitions at the start of the block
+	RzVector /*<ut32>*/ defs; ///< ids of the other definitions, in program order
+	HtUU /*<ut32, ut32>*/ *out; ///< variable index => id of the definition live at the end of the block
+	HtUU /*<ut32, ut32>*/ *in; ///< variable index => id of the definition live at the start of the block, cached by queries, may be NULL
+	bool filled; ///< all instructions have been lifted
+	bool sealed; ///< all predecessors are filled, no more incomplete phis
+} RzAnalysisILSSABlock;
+
+/**
+ * \brief SSA form of the IL of a function
+ *
+ * Each block is lifted once, definitions are linked to their operands and users,
+ * and phis for values only needed by later queries are created on demand.
+ */
+typedef struct rz_analysis_il_ssa_t {
+	RZ_BORROW RzAnalysis *analysis;
+	RZ_BORROW RzAnalysisFunction *fcn;
+	ut32 entry; ///< index of the entry block
+	RzPVector /*<RzAnalysisILSSAVar *>*/ vars;
+	RzVector /*<RzAnalysisILSSABlock>*/ blocks;
+	RzPVector /*<RzAnalysisILSSADef *>*/ defs; ///< all definitions, indexed by id
+	RzPVector /*<RzILOpEffect *>*/ ops; ///< lifted instructions, owning the expressions of the definitions
+	HtPU /*<char *, ut32>*/ *globals; ///< global variable and memory name => variable index
+	HtPU /*<char *, ut32>*/ *locals; ///< local variable name => variable index
+	HtUU /*<ut64, ut32>*/ *insns; ///< instruction address => block index
+	RzVector consts; ///< private, cached results of the constant propagation indexed by definition id
+} RzAnalysisILSSA;
+
 typedef enum {
 	RZ_ANALYSIS_IL_STEP_RESULT_SUCCESS,
 	RZ_ANALYSIS_IL_STEP_RESULT_NOT_SET_UP,
@@ -1356,7 +1496,7 @@ RZ_API const char *rz_analysis_optype_to_string(int t);
 RZ_API int rz_analysis_optype_from_string(RZ_NONNULL const char *type);
 RZ_API const char *rz_analysis_op_family_to_string(int n);
 RZ_API int rz_analysis_op_family_from_string(RZ_NONNULL const char *f);
-RZ_API int rz_analysis_op_hint(RzAnalysisOp *op, RzAnalysisHint *hint);
+RZ_API int rz_analysis_op_hint(RzAnalysisOp *op, const RzAnalysisHint *hint);
 
 /* block.c */
 typedef bool (*RzAnalysisBlockCb)(RzAnalysisBlock *block, void *user);
@@ -1457,6 +1597,7 @@ RZ_API bool rz_analysis_block_was_modified(RzAnalysisBlock *block);
 RZ_API RzAnalysisBlock *rz_analysis_find_most_relevant_block_in(RzAnalysis *analysis, ut64 off);
 
 RZ_API ut16 rz_analysis_block_get_op_offset(RzAnalysisBlock *block, size_t i);
+
 RZ_API ut64 rz_analysis_block_get_op_addr(RzAnalysisBlock *block, size_t i);
 RZ_API int rz_analysis_block_get_op_index_in(RzAnalysisBlock *bb, ut64 addr);
 RZ_API ut64 rz_analysis_block_get_op_addr_in(RzAnalysisBlock *bb, ut64 addr);
@@ -1502,8 +1643,11 @@ RZ_API bool rz_analysis_function_relocate(RzAnalysisFunction *fcn, ut64 addr);
 // This can fail (and return false) if there is another function with the name given
 RZ_API bool rz_analysis_function_rename(RzAnalysisFunction *fcn, const char *name);
 
+RZ_API void rz_analysis_function_apply_unwind(RZ_NONNULL RzAnalysisFunction *fcn, RZ_NONNULL const RzBinUnwindFunction *uw);
+
 RZ_API void rz_analysis_function_add_block(RzAnalysisFunction *fcn, RzAnalysisBlock *bb);
 RZ_API void rz_analysis_function_remove_block(RzAnalysisFunction *fcn, RzAnalysisBlock *bb);
+RZ_API bool rz_analysis_function_contains_block(RZ_NONNULL RzAnalysisFunction *fcn, RZ_NONNULL RzAnalysisBlock *bb);
 
 // size of the entire range that the function spans, including holes.
 // this is exactly rz_analysis_function_max_addr() - rz_analysis_function_min_addr()
@@ -1532,6 +1676,25 @@ RZ_API bool rz_analysis_function_was_modified(RzAnalysisFunction *fcn);
 RZ_API bool rz_analysis_function_is_autonamed(RZ_NONNULL char *name);
 RZ_API RZ_OWN char *rz_analysis_function_name_guess(RzTypeDB *typedb, RZ_NONNULL char *name);
 
+/* coverage.c */
+
+/**
+ * \brief A range of executed code imported from an external coverage trace
+ */
+typedef struct rz_analysis_coverage_hit_t {
+	ut64 addr;
+	ut64 size; ///< 0 or 1 for a single instruction
+	ut64 count; ///< number of times the range was executed
+} RzAnalysisCoverageHit;
+
+RZ_API void rz_analysis_coverage_hits_merge(RZ_NONNULL RzVector /*<RzAnalysisCoverageHit>*/ *hits);
+RZ_API size_t rz_analysis_coverage_add(RZ_NONNULL RzAnalysis *analysis, RZ_NONNULL RzVector /*<RzAnalysisCoverageHit>*/ *hits);
+RZ_API void rz_analysis_coverage_reset(RZ_NONNULL RzAnalysis *analysis);
+RZ_API bool rz_analysis_coverage_empty(RZ_NONNULL RzAnalysis *analysis);
+RZ_API ut64 rz_analysis_coverage_block_hits(RZ_NONNULL RzAnalysis *analysis, RZ_NONNULL RzAnalysisBlock *block);
+RZ_API ut64 rz_analysis_coverage_hits_at(RZ_NONNULL RzAnalysis *analysis, ut64 addr);
+RZ_API ut64 rz_analysis_coverage_function_hits(RZ_NONNULL RzAnalysis *analysis, RZ_NONNULL RzAnalysisFunction *fcn, RZ_NULLABLE size_t *covered);
+
 /* analysis.c */
 RZ_API RzAnalysis *rz_analysis_new(void);
 RZ_API void rz_analysis_purge(RzAnalysis *analysis);
@@ -1543,6 +1706,7 @@ RZ_API bool rz_analysis_use(RzAnalysis *analysis, const char *name);
 RZ_API bool rz_analysis_set_reg_profile(RzAnalysis *analysis);
 RZ_API char *rz_analysis_get_reg_profile(RzAnalysis *analysis);
 RZ_API bool rz_analysis_set_bits(RzAnalysis *analysis, int bits);
+RZ_API bool rz_analysis_set_mode_bits(RZ_NONNULL RzAnalysis *analysis, int bits);
 RZ_API bool rz_analysis_set_os(RzAnalysis *analysis, const char *os);
 RZ_API void rz_analysis_set_cpu(RzAnalysis *analysis, const char *cpu);
 RZ_API int rz_analysis_set_big_endian(RzAnalysis *analysis, int boolean);
@@ -1679,6 +1843,16 @@ RZ_API RzAnalysisILStepResult rz_analysis_il_vm_step_while(RZ_NONNULL RzAnalysis
 RZ_API bool rz_analysis_il_vm_setup(RzAnalysis *analysis);
 RZ_API void rz_analysis_il_vm_cleanup(RzAnalysis *analysis);
 
+/* il ssa */
+RZ_API RZ_OWN RzAnalysisILSSA *rz_analysis_il_ssa_new(RZ_NONNULL RzAnalysis *analysis, RZ_NONNULL RzAnalysisFunction *fcn);
+RZ_API void rz_analysis_il_ssa_free(RZ_NULLABLE RzAnalysisILSSA *ssa);
+RZ_API RZ_BORROW RzAnalysisILSSADef *rz_analysis_il_ssa_get_def(RZ_NONNULL RzAnalysisILSSA *ssa, ut32 id);
+RZ_API RZ_BORROW RzAnalysisILSSADef *rz_analysis_il_ssa_reaching_def(RZ_NONNULL RzAnalysisILSSA *ssa, ut64 addr, RZ_NONNULL const char *var);
+RZ_API RZ_OWN RzVector /*<ut64>*/ *rz_analysis_il_ssa_def_constants(RZ_NONNULL RzAnalysisILSSA *ssa, RZ_NONNULL RzAnalysisILSSADef *def);
+RZ_API RZ_OWN RzVector /*<ut64>*/ *rz_analysis_il_ssa_constants_at(RZ_NONNULL RzAnalysisILSSA *ssa, ut64 addr, RZ_NONNULL const char *var);
+RZ_API RZ_OWN RzVector /*<ut64>*/ *rz_analysis_il_ssa_jump_targets(RZ_NONNULL RzAnalysisILSSA *ssa, ut64 addr);
+RZ_API RZ_OWN char *rz_analysis_il_ssa_def_as_string(RZ_NONNULL RzAnalysisILSSA *ssa, RZ_NONNULL RzAnalysisILSSADef *def);
+
 /* trace */
 RZ_API RzAnalysisRzilTrace *rz_analysis_rzil_trace_new(RzAnalysis *analysis, RZ_NONNULL RzAnalysisILVM *rzil);
 RZ_API void rz_analysis_rzil_trace_free(RzAnalysisRzilTrace *trace);
@@ -1712,6 +1886,16 @@ RZ_API int rz_analysis_run_tasks(RZ_NONNULL RzVector /*<RzAnalysisTaskItem>*/ *t
 
 RZ_API int rz_analysis_function_complexity(RzAnalysisFunction *fcn);
 RZ_API int rz_analysis_function_loops(RzAnalysisFunction *fcn);
+
+/* cfg.c */
+RZ_API RZ_BORROW RzAnalysisCFG *rz_analysis_function_get_cfg(RZ_NONNULL RzAnalysisFunction *fcn);
+RZ_API void rz_analysis_function_invalidate_cfg(RZ_NONNULL RzAnalysisFunction *fcn);
+RZ_API RZ_BORROW RzAnalysisBlock *rz_analysis_function_idom(RZ_NONNULL RzAnalysisFunction *fcn, RZ_NONNULL RzAnalysisBlock *bb);
+RZ_API RZ_BORROW RzAnalysisBlock *rz_analysis_function_ipdom(RZ_NONNULL RzAnalysisFunction *fcn, RZ_NONNULL RzAnalysisBlock *bb);
+RZ_API bool rz_analysis_function_dominates(RZ_NONNULL RzAnalysisFunction *fcn, RZ_NONNULL RzAnalysisBlock *a, RZ_NONNULL RzAnalysisBlock *b);
+RZ_API bool rz_analysis_function_post_dominates(RZ_NONNULL RzAnalysisFunction *fcn, RZ_NONNULL RzAnalysisBlock *a, RZ_NONNULL RzAnalysisBlock *b);
+RZ_API RZ_BORROW const RzAnalysisLoop *rz_analysis_function_block_loop(RZ_NONNULL RzAnalysisFunction *fcn, RZ_NONNULL RzAnalysisBlock *bb);
+RZ_API size_t rz_analysis_function_block_scc(RZ_NONNULL RzAnalysisFunction *fcn, RZ_NONNULL RzAnalysisBlock *bb);
 RZ_API void rz_analysis_trim_jmprefs(RzAnalysis *analysis, RzAnalysisFunction *fcn);
 RZ_API void rz_analysis_del_jmprefs(RzAnalysis *analysis, RzAnalysisFunction *fcn);
 RZ_API char *rz_analysis_function_get_json(RzAnalysisFunction *function);
@@ -1848,7 +2032,7 @@ RZ_API void rz_analysis_fcn_vars_add_types(RzAnalysis *analysis, RZ_NONNULL RzAn
 // Global vars
 RZ_API RZ_OWN RzAnalysisVarGlobal *rz_analysis_var_global_new(RZ_NONNULL const char *name, ut64 addr);
 RZ_API bool rz_analysis_var_global_add(RzAnalysis *analysis, RZ_NONNULL RzAnalysisVarGlobal *global_var);
-RZ_API bool rz_analysis_var_global_create(RzAnalysis *analysis, RZ_NONNULL const char *name, RZ_NONNULL RZ_BORROW RzType *type, ut64 addr);
+RZ_API bool rz_analysis_var_global_create(RzAnalysis *analysis, RZ_NONNULL const char *name, RZ_NONNULL RZ_OWN RzType *type, ut64 addr);
 RZ_API void rz_analysis_var_global_free(RzAnalysisVarGlobal *glob);
 RZ_API RZ_NULLABLE RzFlagItem *rz_analysis_var_global_get_flag_item(RzAnalysisVarGlobal *glob);
 RZ_API bool rz_analysis_var_global_delete(RZ_NONNULL RzAnalysis *analysis, RZ_NONNULL RzAnalysisVarGlobal *glob);
@@ -1860,9 +2044,11 @@ RZ_API RZ_BORROW RzAnalysisVarGlobal *rz_analysis_var_global_get_byaddr_at(RzAna
 RZ_API RZ_BORROW RzAnalysisVarGlobal *rz_analysis_var_global_get_byaddr_in(RzAnalysis *analysis, ut64 addr);
 RZ_API RZ_OWN RzList /*<RzAnalysisVarGlobal *>*/ *rz_analysis_var_global_get_all(RzAnalysis *analysis);
 RZ_API bool rz_analysis_var_global_rename(RzAnalysis *analysis, RZ_NONNULL const char *old_name, RZ_NONNULL const char *newname);
+RZ_API void rz_analysis_var_global_rebase(RzAnalysis *analysis, ut64 diff);
 RZ_API void rz_analysis_var_global_set_type(RzAnalysisVarGlobal *glob, RZ_NONNULL RZ_BORROW RzType *type);
 RZ_API void rz_analysis_var_global_add_constraint(RzAnalysisVarGlobal *glob, RzTypeConstraint *constraint);
 RZ_API RZ_OWN char *rz_analysis_var_global_get_constraints_readable(RzAnalysisVarGlobal *glob);
+RZ_API size_t rz_analysis_var_global_recover(RZ_NONNULL RzAnalysis *analysis, ut64 from, ut64 to, size_t max_threads);
 RZ_API RZ_OWN RzList /*<RzTypePathTuple *>*/ *rz_analysis_type_paths_by_address(RzAnalysis *analysis, ut64 addr);
 
 /* project */
@@ -2072,6 +2258,7 @@ RZ_API const char *rz_meta_type_to_string(int type);
 
 RZ_API void rz_analysis_hint_del(RzAnalysis *analysis, ut64 addr, ut64 size); // delete all hints that are contained within the given range, if size > 1, this operation is quite heavy!
 RZ_API void rz_analysis_hint_clear(RzAnalysis *a);
+RZ_API void rz_analysis_hint_rebase(RzAnalysis *a, ut64 diff);
 RZ_API void rz_analysis_hint_free(RzAnalysisHint *h);
 RZ_API void rz_analysis_hint_set_syntax(RzAnalysis *a, ut64 addr, const char *syn);
 RZ_API void rz_analysis_hint_set_type(RzAnalysis *a, ut64 addr, int type);
@@ -2128,6 +2315,9 @@ RZ_API RZ_NULLABLE RZ_BORROW const char *rz_analysis_hint_arch_at(RzAnalysis *an
 RZ_API int rz_analysis_hint_bits_at(RzAnalysis *analysis, ut64 addr, RZ_NULLABLE ut64 *hint_addr);
 
 RZ_API RzAnalysisHint *rz_analysis_hint_get(RzAnalysis *analysis, ut64 addr); // accumulate all available hints affecting the given address
+RZ_API void rz_analysis_hint_cursor_init(RZ_NONNULL RzAnalysisHintCursor *cursor, RZ_NONNULL RzAnalysis *analysis);
+RZ_API RZ_NULLABLE RZ_BORROW const RzAnalysisHint *rz_analysis_hint_cursor_at(RZ_NONNULL RzAnalysisHintCursor *cursor, ut64 addr);
+RZ_API RZ_NULLABLE RZ_BORROW const RzAnalysisHint *rz_analysis_hint_view_at(RZ_NONNULL RzAnalysis *analysis, ut64 addr);
 
 /* switch.c APIs */
 RZ_API RzAnalysisSwitchOp *rz_analysis_switch_op_new(ut64 addr, ut64 min_val, ut64 max_val, ut64 def_val);
@@ -2162,6 +2352,8 @@ typedef struct {
 	RzAnalysisCPPABI abi;
 	ut8 word_size;
 	bool (*read_addr)(RzAnalysis *analysis, ut64 addr, ut64 *buf);
+	RzVector *sections; // sorted section ranges, built by rz_analysis_vtable_search()
+	RzVector *blocks; // contents of the sections vtables and RTTI are read from
 } RVTableContext;
 
 typedef struct vtable_info_t {
@@ -2177,6 +2369,10 @@ typedef struct vtable_method_info_t {
 RZ_API void rz_analysis_vtable_info_free(RVTableInfo *vtable);
 RZ_API ut64 rz_analysis_vtable_info_get_size(RVTableContext *context, RVTableInfo *vtable);
 RZ_API bool rz_analysis_vtable_begin(RzAnalysis *analysis, RVTableContext *context);
+RZ_API void rz_analysis_vtable_end(RVTableContext *context);
+RZ_API RzBinSection *rz_analysis_vtable_section_at(RVTableContext *context, ut64 addr);
+RZ_API bool rz_analysis_vtable_read_at(RVTableContext *context, ut64 addr, ut8 *buf, int len);
+RZ_API bool rz_analysis_vtable_read_addr(RVTableContext *context, ut64 addr, ut64 *buf);
 RZ_API RVTableInfo *rz_analysis_vtable_parse_at(RVTableContext *context, ut64 addr);
 RZ_API RzList /*<RVTableInfo *>*/ *rz_analysis_vtable_search(RVTableContext *context);
 RZ_API void rz_analysis_list_vtables(RzAnalysis *analysis, RzOutputMode mode);
@@ -2242,6 +2438,7 @@ typedef enum {
 
 RZ_API void rz_analysis_class_recover_from_rzbin(RzAnalysis *analysis);
 RZ_API void rz_analysis_class_recover_all(RzAnalysis *analysis);
+RZ_API void rz_analysis_class_rebase(RzAnalysis *analysis, ut64 diff);
 RZ_API RzAnalysisClassErr rz_analysis_class_create(RzAnalysis *analysis, const char *name);
 RZ_API void rz_analysis_class_delete(RzAnalysis *analysis, const char *name);
 RZ_API bool rz_analysis_class_exists(RzAnalysis *analysis, const char *name);
@@ -2283,6 +2480,16 @@ RZ_API RZ_OWN RzCallable *rz_analysis_function_derive_type(RzAnalysis *analysis,
 /* PDB */
 RZ_API void rz_parse_pdb_types(const RzTypeDB *typedb, const RzPdb *pdb);
 
+/* BTF */
+typedef struct rz_analysis_btf_t RzAnalysisBTF;
+
+RZ_API RZ_OWN RzAnalysisBTF *rz_analysis_btf_new(RZ_NONNULL RzTypeDB *typedb, RZ_NONNULL RzBuffer *buf);
+RZ_API void rz_analysis_btf_free(RZ_NULLABLE RzAnalysisBTF *btf);
+RZ_API ut32 rz_analysis_btf_types_count(RZ_NONNULL const RzAnalysisBTF *btf);
+RZ_API RZ_OWN RzType *rz_analysis_btf_type_load(RZ_NONNULL RzAnalysisBTF *btf, ut32 id);
+RZ_API bool rz_analysis_btf_func_load(RZ_NONNULL RzAnalysisBTF *btf, ut32 id);
+RZ_API size_t rz_analysis_btf_load_all(RZ_NONNULL RzAnalysisBTF *btf);
+
 /* DWARF */
 RZ_API void rz_analysis_dwarf_preprocess_info(
 	RZ_NONNULL RZ_BORROW RzAnalysis *analysis,
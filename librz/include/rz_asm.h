@@ -74,6 +74,19 @@ typedef struct rz_asm_op_t {
 	RzAsmTokenString *asm_toks; ///< Tokenized asm string.
 } RzAsmOp;
 
+/**
+ * \brief Instruction operand as decoded by the disassembler.
+ *
+ * Plugins pass these to rz_asm_tokenize_asm_operands() so the tokens of the
+ * asm string are classified by what was actually decoded instead of guessing.
+ */
+typedef struct {
+	RzAsmOperandType type;
+	const char *regs[3]; ///< Names of the registers used by the operand, e.g. segment, base and index. NULL if unused.
+	bool has_value; ///< True if \p value is set.
+	ut64 value; ///< Immediate value or displacement.
+} RzAsmOperand;
+
 typedef struct rz_asm_code_t {
 #if 1
 	int len;
@@ -209,6 +222,7 @@ RZ_API RZ_OWN RzAsmTokenString *rz_asm_token_string_clone(RZ_OWN RZ_NONNULL RzAs
 RZ_API void rz_asm_token_pattern_free(void *p);
 RZ_API void rz_asm_compile_token_patterns(RZ_INOUT RzPVector /*<RzAsmTokenPattern *>*/ *patterns);
 RZ_API RZ_OWN RzAsmTokenString *rz_asm_tokenize_asm_regex(RZ_BORROW RzStrBuf *asm_str, RzPVector /*<RzAsmTokenPattern *>*/ *patterns);
+RZ_API RZ_OWN RzAsmTokenString *rz_asm_tokenize_asm_operands(RZ_BORROW RzStrBuf *asm_str, RZ_BORROW RZ_NULLABLE const RzAsmOperand *operands, size_t count);
 RZ_API RZ_OWN RzAsmParseParam *rz_asm_get_parse_param(RZ_NULLABLE const RzReg *reg, ut32 ana_op_type);
 RZ_DEPRECATE RZ_API RZ_OWN RzAsmTokenString *rz_asm_tokenize_asm_string(RZ_BORROW RzStrBuf *asm_str, RZ_NULLABLE const RzAsmParseParam *param);
 RZ_DEPRECATE RZ_API RZ_OWN RzStrBuf *rz_asm_colorize_asm_str(RZ_BORROW RzStrBuf *asm_str, RZ_BORROW RzPrint *p, RZ_NULLABLE const RzAsmParseParam *param, RZ_NULLABLE const RzAsmTokenString *toks);
@@ -290,6 +290,7 @@ typedef struct rz_bin_object_t {
 	RzBinSourceLineInfo *lines;
 	RzPVector /*<RzBinMem *>*/ *mem;
 	char *regstate;
+	RzPVector /*<RzBinThread *>*/ *threads; ///< per-thread register state of core files
 	RzBinInfo *info;
 	RzBinAddr *binsym[RZ_BIN_SPECIAL_SYMBOL_LAST];
 	struct rz_bin_plugin_t *plugin;
@@ -434,6 +435,31 @@ typedef struct rz_bin_trycatch_t {
 RZ_API RzBinTrycatch *rz_bin_trycatch_new(ut64 source, ut64 from, ut64 to, ut64 handler, ut64 filter);
 RZ_API void rz_bin_trycatch_free(RzBinTrycatch *tc);
 
+/**
+ * \brief Location of the canonical frame address (CFA), the stack pointer before the call, from an address on
+ */
+typedef struct rz_bin_unwind_row_t {
+	ut64 vaddr; ///< first address this row applies to
+	st64 cfa_offset; ///< CFA minus the stack pointer, or minus the frame register if frame_based
+	bool frame_based; ///< the CFA is not computed from the stack pointer
+} RzBinUnwindRow;
+
+/**
+ * \brief A function range from the unwind tables, e.g. an FDE of .eh_frame or a PE runtime function
+ */
+typedef struct rz_bin_unwind_function_t {
+	ut64 vaddr;
+	ut64 size;
+	bool fragment; ///< part of another function, like a chained PE runtime function
+	RzVector /*<RzBinUnwindRow>*/ rows; ///< sorted by address, the first one at vaddr
+} RzBinUnwindFunction;
+
+RZ_API RZ_OWN RzBinUnwindFunction *rz_bin_unwind_function_new(ut64 vaddr, ut64 size);
+RZ_API void rz_bin_unwind_function_free(RZ_NULLABLE RzBinUnwindFunction *fcn);
+RZ_API bool rz_bin_unwind_function_push_row(RZ_NONNULL RzBinUnwindFunction *fcn, ut64 vaddr, st64 cfa_offset, bool frame_based);
+RZ_API RZ_BORROW const RzBinUnwindRow *rz_bin_unwind_function_row_at(RZ_NONNULL const RzBinUnwindFunction *fcn, ut64 vaddr);
+RZ_API RZ_OWN RzPVector /*<RzBinUnwindFunction *>*/ *rz_bin_eh_frame_parse(RZ_NONNULL const ut8 *data, ut64 size, ut64 vaddr, ut32 sp_reg, int addr_size, bool big_endian);
+
 /**
  * \brief A single sample of source line info for a specific address
  *
@@ -542,6 +568,7 @@ typedef struct rz_bin_plugin_t {
 	RzPVector /*<char *>*/ *(*libs)(RzBinFile *bf);
 	RzPVector /*<RzBinReloc *>*/ *(*relocs)(RzBinFile *bf);
 	RzPVector /*<RzBinTrycatch *>*/ *(*trycatch)(RzBinFile *bf);
+	RzPVector /*<RzBinUnwindFunction *>*/ *(*unwind_functions)(RzBinFile *bf);
 	RzPVector /*<RzBinClass *>*/ *(*classes)(RzBinFile *bf);
 	RzPVector /*<RzBinMem *>*/ *(*mem)(RzBinFile *bf);
 	RzPVector /*<RzBinReloc *>*/ *(*patch_relocs)(RzBinFile *bf);
@@ -559,6 +586,7 @@ typedef struct rz_bin_plugin_t {
 	RzBuffer *(*create)(RzBin *bin, const ut8 *code, int codelen, const ut8 *data, int datalen, RzBinArchOptions *opt);
 	char *(*demangle)(const char *str);
 	char *(*regstate)(RzBinFile *bf);
+	RzPVector /*<RzBinThread *>*/ *(*threads)(RzBinFile *bf);
 	int (*file_type)(RzBinFile *bf);
 	/* default value if not specified by user */
 	int minstrlen;
@@ -791,6 +819,12 @@ typedef struct rz_bin_class_field_t {
 	ut64 flags;
 } RzBinClassField;
 
+/// Thread of a core file
+typedef struct rz_bin_thread_t {
+	ut64 tid;
+	char *regstate; ///< register arena in hex, same format as RzBinObject.regstate
+} RzBinThread;
+
 typedef struct rz_bin_mem_t {
 	char *name;
 	ut64 addr;
@@ -928,6 +962,7 @@ RZ_DEPRECATE RZ_API RZ_BORROW RzList /*<RzBinString *>*/ *rz_bin_get_strings(RZ_
 RZ_DEPRECATE RZ_API RZ_BORROW RzList /*<RzBinSymbol *>*/ *rz_bin_get_symbols(RZ_NONNULL RzBin *bin);
 RZ_DEPRECATE RZ_API int rz_bin_is_static(RZ_NONNULL RzBin *bin);
 RZ_API RZ_OWN RzPVector /*<RzBinTrycatch *>*/ *rz_bin_file_get_trycatch(RZ_NONNULL RzBinFile *bf);
+RZ_API RZ_OWN RzPVector /*<RzBinUnwindFunction *>*/ *rz_bin_file_get_unwind_functions(RZ_NONNULL RzBinFile *bf);
 
 RZ_API const RzList /*<RzBinAddr *>*/ *rz_bin_object_get_entries(RZ_NONNULL RzBinObject *obj);
 RZ_API const RzPVector /*<RzBinField *>*/ *rz_bin_object_get_fields(RZ_NONNULL RzBinObject *obj);
@@ -943,6 +978,7 @@ RZ_API const RzList /*<RzBinString *>*/ *rz_bin_object_get_strings(RZ_NONNULL Rz
 RZ_API RZ_BORROW const RzPVector /*<RzBinMem *>*/ *rz_bin_object_get_mem(RZ_NONNULL RzBinObject *obj);
 RZ_API const RzPVector /*<RzBinResource *>*/ *rz_bin_object_get_resources(RZ_NONNULL RzBinObject *obj);
 RZ_API const RzList /*<RzBinSymbol *>*/ *rz_bin_object_get_symbols(RZ_NONNULL RzBinObject *obj);
+RZ_API RZ_BORROW const RzPVector /*<RzBinThread *>*/ *rz_bin_object_get_threads(RZ_NONNULL RzBinObject *obj);
 RZ_API bool rz_bin_object_reset_strings(RZ_NONNULL RzBin *bin, RZ_NONNULL RzBinFile *bf, RZ_NONNULL RzBinObject *obj);
 RZ_API RZ_BORROW RzBinString *rz_bin_object_get_string_at(RZ_NONNULL RzBinObject *obj, ut64 address, bool is_va);
 RZ_API bool rz_bin_object_is_big_endian(RZ_NONNULL RzBinObject *obj);
@@ -1011,6 +1047,7 @@ RZ_API RZ_BORROW RzBinSymbol *rz_bin_object_add_method(RZ_NONNULL RzBinObject *o
 RZ_API RZ_BORROW RzBinClassField *rz_bin_object_add_field(RZ_NONNULL RzBinObject *o, RZ_NONNULL const char *klass, RZ_NONNULL const char *field, ut64 paddr, ut64 vaddr);
 
 RZ_API void rz_bin_mem_free(RZ_NULLABLE void *data);
+RZ_API void rz_bin_thread_free(RZ_NULLABLE RzBinThread *thread);
 
 // demangle functions
 RZ_API void rz_bin_demangle_with_flags(RZ_NONNULL RzBin *bin, RzDemanglerFlag flags);
@@ -152,11 +152,16 @@ typedef struct rz_core_io_map_info_t {
 } RzCoreIOMapInfo;
 
 typedef struct rz_core_times_t {
+	ut64 core_init_time; ///< Total time spent in rz_core_init()
+	ut64 cmd_init_time; ///< Time spent registering the commands
+	ut64 config_init_time; ///< Time spent creating the config variables
 	ut64 loadlibs_init_time;
 	ut64 loadlibs_time;
 	ut64 file_open_time;
 } RzCoreTimes;
 
+typedef struct rz_core_debug_symbols_t RzCoreDebugSymbols;
+
 #define RZ_CORE_ASMQJMPS_NUM         10
 #define RZ_CORE_ASMQJMPS_LETTERS     26
 #define RZ_CORE_ASMQJMPS_MAX_LETTERS (26 * 26 * 26 * 26 * 26)
@@ -274,10 +279,11 @@ struct rz_core_t {
 	RzPrint *print;
 	RzLang *lang;
 	RzDebug *dbg;
+	RzCoreDebugSymbols *dbg_symbols; ///< Lazily created cache of the parsed debuggee modules, see rz_core_debug_symbol_at()
 	RzFlag *flags;
 	RzSearch *search;
-	RzEgg *egg;
-	RzCrypto *crypto;
+	RzEgg *egg; ///< Lazily created, use rz_core_get_egg()
+	RzCrypto *crypto; ///< Lazily created, use rz_core_get_crypto()
 	RzAGraph *graph;
 	char *cmdqueue;
 	char *lastcmd;
@@ -416,6 +422,8 @@ RZ_API const char *rz_core_get_section_name(RzCore *core, ut64 addr);
 RZ_API RzCons *rz_core_get_cons(RzCore *core);
 RZ_API RzBin *rz_core_get_bin(RzCore *core);
 RZ_API RzConfig *rz_core_get_config(RzCore *core);
+RZ_API RZ_BORROW RzEgg *rz_core_get_egg(RZ_NONNULL RzCore *core);
+RZ_API RZ_BORROW RzCrypto *rz_core_get_crypto(RZ_NONNULL RzCore *core);
 RZ_API bool rz_core_init(RzCore *core);
 RZ_API void rz_core_bind_cons(RzCore *core); // to restore pointers in cons
 RZ_API RzCore *rz_core_new(void);
@@ -469,6 +477,7 @@ RZ_API bool rz_core_seek_align(RzCore *core, ut64 align, bool save);
 RZ_API bool rz_core_seek_delta(RzCore *core, st64 delta, bool save);
 RZ_API bool rz_core_seek_analysis_bb(RzCore *core, ut64 addr, bool save);
 RZ_API void rz_core_arch_bits_at(RzCore *core, ut64 addr, RZ_OUT RZ_NULLABLE int *bits, RZ_OUT RZ_BORROW RZ_NULLABLE const char **arch);
+RZ_API bool rz_core_set_mode_bits(RZ_NONNULL RzCore *core, int bits);
 RZ_API void rz_core_seek_arch_bits(RzCore *core, ut64 addr);
 RZ_API int rz_core_block_read(RzCore *core);
 RZ_API bool rz_core_block_size(RzCore *core, ut32 bsize);
@@ -559,6 +568,23 @@ RZ_API ut64 rz_core_reg_getv_by_role_or_name(RzCore *core, const char *name);
 RZ_API bool rz_core_reg_set_by_role_or_name(RzCore *core, const char *name, ut64 num);
 RZ_API void rz_core_reg_update_flags(RzCore *core);
 
+/* ccoverage.c */
+typedef enum {
+	RZ_CORE_COVERAGE_FORMAT_AUTO, ///< Guess the format from the contents of the file
+	RZ_CORE_COVERAGE_FORMAT_DRCOV, ///< DynamoRIO drcov log, with binary or text basic block table
+	RZ_CORE_COVERAGE_FORMAT_PERF, ///< Output of `perf script`, rebased with the mmap events if present
+	RZ_CORE_COVERAGE_FORMAT_ADDRESSES, ///< One `addr [count]` or `module+offset [count]` per line
+	RZ_CORE_COVERAGE_FORMAT_INVALID,
+} RzCoreCoverageFormat;
+
+RZ_API bool rz_core_coverage_load(RZ_NONNULL RzCore *core, RZ_NONNULL const char *path, RzCoreCoverageFormat format, RZ_NULLABLE size_t *blocks);
+RZ_API RzCoreCoverageFormat rz_core_coverage_format_from_string(RZ_NULLABLE const char *name);
+
+/* cdebug_symbols.c */
+RZ_API RZ_BORROW RzBinFile *rz_core_debug_module_at(RZ_NONNULL RzCore *core, ut64 addr);
+RZ_API RZ_BORROW RzBinSymbol *rz_core_debug_symbol_at(RZ_NONNULL RzCore *core, ut64 addr, RZ_NULLABLE RzBinFile **bf, RZ_NULLABLE ut64 *delta);
+RZ_API void rz_core_debug_symbols_reset(RZ_NONNULL RzCore *core);
+
 /* cdebug.c */
 RZ_API bool rz_core_is_debug(RzCore *core);
 RZ_API bool rz_core_debug_step_one(RzCore *core, int times);
@@ -724,6 +750,7 @@ RZ_API void rz_core_analysis_sigdb_print(RZ_NONNULL RzCore *core, RZ_NONNULL RzT
 RZ_API RzList /*<RzAnalysisCycleHook *>*/ *rz_core_analysis_cycles(RzCore *core, int ccl);
 RZ_API RZ_OWN RzList /*<RzAnalysisXRef *>*/ *rz_core_analysis_fcn_get_calls(RzCore *core, RzAnalysisFunction *fcn); // get all calls from a function
 RZ_API void rz_core_analysis_calls(RZ_NONNULL RzCore *core, bool imports_only);
+RZ_API int rz_core_analysis_unwind_functions(RZ_NONNULL RzCore *core);
 RZ_API int rz_core_get_stacksz(RzCore *core, ut64 from, ut64 to);
 RZ_API bool rz_core_analysis_hint_set_offset(RZ_NONNULL RzCore *core, RZ_NONNULL const char *struct_member);
 RZ_API bool rz_core_analysis_continue_until_syscall(RZ_NONNULL RzCore *core);
@@ -1026,6 +1053,7 @@ RZ_API bool rz_core_bin_fields_print(RZ_NONNULL RzCore *core, RZ_NONNULL RzBinFi
 RZ_API bool rz_core_bin_headers_print(RZ_NONNULL RzCore *core, RZ_NONNULL RzBinFile *bf);
 RZ_API bool rz_core_bin_dwarf_print(RZ_NONNULL RzCore *core, RZ_NONNULL RzBinFile *bf, RZ_NONNULL RzCmdStateOutput *state);
 RZ_API bool rz_core_bin_memory_print(RZ_NONNULL RzCore *core, RZ_NONNULL RzBinFile *bf, RZ_NONNULL RzCmdStateOutput *state);
+RZ_API bool rz_core_bin_threads_print(RZ_NONNULL RzCore *core, RZ_NONNULL RzBinFile *bf, RZ_NONNULL RzCmdStateOutput *state);
 RZ_API bool rz_core_bin_resources_print(RZ_NONNULL RzCore *core, RZ_NONNULL RzBinFile *bf, RZ_NONNULL RzCmdStateOutput *state, RZ_NULLABLE RzList /*<char *>*/ *hashes);
 RZ_API bool rz_core_bin_versions_print(RZ_NONNULL RzCore *core, RZ_NONNULL RzBinFile *bf, RZ_NONNULL RzCmdStateOutput *state);
 RZ_API bool rz_core_bin_trycatch_print(RZ_NONNULL RzCore *core, RZ_NONNULL RzBinFile *bf, RZ_NONNULL RzCmdStateOutput *state);
@@ -303,6 +303,7 @@ typedef struct rz_debug_t {
 	RzAnalysis *analysis;
 	RzList /*<RzDebugMap *>*/ *maps;
 	RzList /*<RzDebugMap *>*/ *maps_user;
+	ut32 maps_gen; ///< Incremented every time \p maps is synchronized, to invalidate lookups cached on it
 
 	bool trace_continue;
 	RzAnalysisOp *cur_op;
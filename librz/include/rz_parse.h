@@ -64,7 +64,9 @@ RZ_API bool rz_parse_use(RzParse *p, const char *name);
 /* action */
 RZ_API char *rz_parse_pseudocode(RzParse *p, const char *data);
 RZ_API bool rz_parse_assemble(RzParse *p, char *data, char *str); // XXX deprecate, unused and probably useless, related to write-hack
-RZ_API bool rz_parse_filter(RzParse *p, ut64 addr, RzFlag *f, RzAnalysisHint *hint, char *data, char *str, int len, bool big_endian);
+RZ_API bool rz_parse_filter(RzParse *p, ut64 addr, RzFlag *f, const RzAnalysisHint *hint, char *data, char *str, int len, bool big_endian);
+RZ_API bool rz_parse_filter_tokens(RzParse *p, ut64 addr, RzFlag *f, const RzAnalysisHint *hint, RZ_NULLABLE const RzAsmTokenString *toks,
+	char *data, char *str, int len, bool big_endian);
 RZ_API bool rz_parse_subvar(RzParse *p, RZ_NULLABLE RzAnalysisFunction *f, RZ_NONNULL RzAnalysisOp *op, RZ_NONNULL RZ_IN char *data, RZ_BORROW RZ_NONNULL RZ_OUT char *str, int len);
 RZ_API char *rz_parse_immtrim(char *opstr);
 
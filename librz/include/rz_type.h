@@ -27,6 +27,7 @@ typedef struct rz_type_target_t {
 } RzTypeTarget;
 
 typedef struct rz_type_parser_t RzTypeParser;
+typedef struct rz_type_preprocessor_t RzTypePreprocessor;
 
 typedef struct rz_type_db_t {
 	void *user;
@@ -172,6 +173,20 @@ struct rz_type_t {
 	};
 };
 
+/**
+ * \brief Finds the types behind the names generated for anonymous types
+ *
+ * Types referred to by such a name are compared and hashed by their structure
+ * instead of their name, so identical types of different sources stay equal.
+ */
+typedef struct rz_type_anonymous_resolver_t {
+	/// The base type of the identifier \p name if it is anonymous, NULL to compare it by name
+	RZ_BORROW const RzBaseType *(*base_type)(void *user, const char *name);
+	/// Whether the callable \p name is anonymous, to compare it by its signature
+	bool (*callable)(void *user, const char *name);
+	void *user;
+} RzTypeAnonymousResolver;
+
 typedef struct rz_type_path_t {
 	RzType *typ; ///< type at the leaf
 	char *path;
@@ -258,6 +273,10 @@ RZ_API bool rz_base_type_clone_into(
 	RZ_NONNULL RZ_BORROW RZ_OUT RzBaseType *dst,
 	RZ_NONNULL RZ_BORROW RZ_IN RzBaseType *src);
 RZ_API RZ_OWN RzBaseType *rz_base_type_clone(RZ_NULLABLE RZ_BORROW RzBaseType *b);
+RZ_API ut64 rz_base_type_hash(RZ_NONNULL const RzBaseType *btype);
+RZ_API bool rz_base_type_equal(RZ_NONNULL const RzBaseType *a, RZ_NONNULL const RzBaseType *b);
+RZ_API ut64 rz_base_type_hash_resolved(RZ_NONNULL const RzBaseType *btype, RZ_NULLABLE const RzTypeAnonymousResolver *resolver);
+RZ_API bool rz_base_type_equal_resolved(RZ_NONNULL const RzBaseType *a, RZ_NONNULL const RzBaseType *b, RZ_NULLABLE const RzTypeAnonymousResolver *resolver);
 RZ_API void rz_type_base_type_free(RzBaseType *type);
 RZ_API RZ_OWN RzBaseType *rz_type_base_type_new(RzBaseTypeKind kind);
 RZ_API RZ_BORROW const char *rz_type_base_type_kind_as_string(RzBaseTypeKind kind);
@@ -285,6 +304,7 @@ RZ_API RZ_BORROW RzType *rz_type_db_base_type_unwrap_typedef(RZ_NONNULL const Rz
 RZ_API RZ_OWN RzType *rz_type_clone(RZ_BORROW RZ_NONNULL const RzType *type);
 RZ_API RZ_BORROW const char *rz_type_identifier(RZ_NONNULL const RzType *type);
 RZ_API bool rz_types_equal(RZ_NONNULL const RzType *type1, RZ_NONNULL const RzType *type2);
+RZ_API ut64 rz_type_hash(RZ_NONNULL const RzType *type);
 RZ_API RZ_OWN char *rz_type_as_string(const RzTypeDB *typedb, RZ_NONNULL const RzType *type);
 RZ_API RZ_OWN char *rz_type_declaration_as_string(const RzTypeDB *typedb, RZ_NONNULL const RzType *type);
 RZ_API RZ_OWN char *rz_type_identifier_declaration_as_string(const RzTypeDB *typedb, RZ_NONNULL const RzType *type, RZ_NONNULL const char *identifier);
@@ -338,8 +358,19 @@ RZ_API RZ_OWN RzType *rz_type_parse_string_declaration_single(RzTypeParser *pars
 
 RZ_API int rz_type_parse_string(RzTypeDB *typedb, const char *code, char **error_msg);
 RZ_API int rz_type_parse_file(RzTypeDB *typedb, const char *path, const char *dir, char **error_msg);
+RZ_API int rz_type_parse_headers(RZ_NONNULL RzTypeDB *typedb, RZ_NONNULL const RzTypePreprocessor *pp, RZ_NONNULL const RzPVector /*<char *>*/ *paths, size_t max_threads, RZ_NULLABLE char **error_msg);
 RZ_API void rz_type_parse_reset(RzTypeDB *typedb);
 
+// C preprocessor
+
+RZ_API RZ_OWN RzTypePreprocessor *rz_type_preprocessor_new(RZ_NULLABLE const RzTypeTarget *target);
+RZ_API void rz_type_preprocessor_free(RZ_NULLABLE RzTypePreprocessor *pp);
+RZ_API bool rz_type_preprocessor_add_include_dir(RZ_NONNULL RzTypePreprocessor *pp, RZ_NONNULL const char *dir);
+RZ_API bool rz_type_preprocessor_define(RZ_NONNULL RzTypePreprocessor *pp, RZ_NONNULL const char *name, RZ_NULLABLE const char *value);
+RZ_API void rz_type_preprocessor_undef(RZ_NONNULL RzTypePreprocessor *pp, RZ_NONNULL const char *name);
+RZ_API RZ_OWN char *rz_type_preprocess_string(RZ_NONNULL const RzTypePreprocessor *pp, RZ_NONNULL const char *code, RZ_NULLABLE const char *dir, RZ_NULLABLE char **error_msg);
+RZ_API RZ_OWN char *rz_type_preprocess_file(RZ_NONNULL const RzTypePreprocessor *pp, RZ_NONNULL const char *path, RZ_NULLABLE char **error_msg);
+
 // Type-specific APIs
 
 RZ_API RzBaseType *rz_type_db_get_enum(const RzTypeDB *typedb, RZ_NONNULL const char *name);
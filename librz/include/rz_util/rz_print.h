@@ -54,6 +54,16 @@ typedef enum {
 	RZ_ASM_TOKEN_LAST,
 } RzAsmTokenType;
 
+/**
+ * \brief Kind of the decoded instruction operand a token belongs to.
+ */
+typedef enum {
+	RZ_ASM_OPERAND_UNKNOWN = 0, ///< Not part of an operand or not reported by the disassembler.
+	RZ_ASM_OPERAND_REG, ///< Register operand.
+	RZ_ASM_OPERAND_IMM, ///< Immediate value.
+	RZ_ASM_OPERAND_MEM, ///< Memory reference. Its numbers are displacements.
+} RzAsmOperandType;
+
 /**
  *  \brief A token of an asm string holding meta data.
  */
@@ -64,6 +74,8 @@ typedef struct {
 	union {
 		ut64 number; ///< Number of RZ_ASM_TOKEN_NUMBER
 	} val;
+	ut8 operand; ///< 1-based index of the decoded operand this token belongs to, 0 if unknown.
+	RzAsmOperandType operand_type; ///< Kind of the decoded operand this token belongs to.
 } RzAsmToken;
 
 /**
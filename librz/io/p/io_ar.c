@@ -6,6 +6,9 @@
 #include <rz_cons.h>
 #include "ar.h"
 
+// member names are sanitized by ar.c and never contain ':'
+#define AR_SYMBOL_PREFIX "sym:"
+
 static bool rz_io_ar_plugin_open(RzIO *io, const char *file, bool many) {
 	return !strncmp("ar://", file, 5) || !strncmp("lib://", file, 6);
 }
@@ -73,15 +76,22 @@ static RzIODesc *rz_io_ar_open(RzIO *io, const char *file, int perm, int mode) {
 	*filename = 0;
 	filename += 2;
 
-	RzArFp *arf = ar_open_file(arname, rz_sys_open_perms(perm), filename);
+	RzArFp *arf;
+	if (rz_str_startswith(filename, AR_SYMBOL_PREFIX)) {
+		// ar://lib.a//sym:name opens only the member defining the symbol
+		arf = ar_open_symbol(arname, rz_sys_open_perms(perm), filename + strlen(AR_SYMBOL_PREFIX));
+	} else {
+		arf = ar_open_file(arname, rz_sys_open_perms(perm), filename);
+	}
 	if (!arf) {
 		goto err;
 	}
-	res = rz_io_desc_new(io, &rz_io_plugin_ar, filename, perm, mode, arf);
+	res = rz_io_desc_new(io, &rz_io_plugin_ar, arf->name, perm, mode, arf);
 	if (!res) {
+		ar_close(arf);
 		goto err;
 	}
-	res->name = strdup(filename);
+	res->name = strdup(arf->name);
 err:
 	free(uri);
 	return res;
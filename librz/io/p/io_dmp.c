@@ -17,6 +17,10 @@ typedef struct {
 static int op_at_phys(void *user, ut64 address, const ut8 *in, ut8 *out, int len, bool write) {
 	ReadAtCtx *ctx = user;
 	DmpCtx *dmp = ctx->fd->data;
+	if (write) {
+		// the page tables may be among the written bytes
+		winkd_tlb_flush(&dmp->windctx);
+	}
 	const ut64 saved_target = dmp->target;
 	dmp->target = TARGET_BACKEND;
 	int saved_va = ctx->io->va;
@@ -74,8 +78,11 @@ static RzIODesc *dmp_open(RzIO *io, const char *file, int rw, int mode) {
 	ctx->windctx.read_at_physical = read_at_phys;
 	ctx->windctx.write_at_physical = write_at_phys;
 	ctx->windctx.read_at_kernel_virtual = read_at_kernel_virtual;
+	// a dump is a snapshot, so translations stay valid until something is written
+	ctx->windctx.tlb = RZ_NEWS0(WindTlbEntry, WINKD_TLB_SIZE);
 	ReadAtCtx *c = RZ_NEW0(ReadAtCtx);
 	if (!c) {
+		free(ctx->windctx.tlb);
 		free(ctx);
 		return NULL;
 	}
@@ -83,6 +90,7 @@ static RzIODesc *dmp_open(RzIO *io, const char *file, int rw, int mode) {
 	c->fd = rz_io_desc_new(io, &rz_io_plugin_dmp, file, rw, mode, ctx);
 	if (!c->fd) {
 		free(c);
+		free(ctx->windctx.tlb);
 		free(ctx);
 		return NULL;
 	}
@@ -97,6 +105,7 @@ static int dmp_write(RzIO *io, RzIODesc *fd, const ut8 *buf, int count) {
 	}
 	DmpCtx *ctx = fd->data;
 	if (ctx->target == TARGET_BACKEND) {
+		winkd_tlb_flush(&ctx->windctx);
 		return rz_io_desc_write_at(ctx->backend, io->off, buf, count);
 	}
 	ut64 address = io->off;
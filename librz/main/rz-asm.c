@@ -344,6 +344,7 @@ static int rasm_disasm(RzAsmState *as, ut64 addr, const char *buf, int len, int
 				rz_asm_op_get_asm(&op));
 			free(op_hex);
 			ret += op.size;
+			rz_asm_op_fini(&op);
 			rz_asm_set_pc(as->a, addr + ret);
 		}
 		break;
@@ -26,6 +26,8 @@ typedef struct {
 	bool widestr;
 	bool nonstop;
 	bool json;
+	bool parallel; /* search the files with a pool of workers */
+	size_t threads;
 	int mode;
 	int align;
 	ut8 *buf;
@@ -51,66 +53,46 @@ static void rzfind_options_init(RzfindOptions *ro) {
 	ro->bsize = 4096;
 	ro->to = UT64_MAX;
 	ro->keywords = rz_list_newf(NULL);
+	ro->comma = "";
 }
 
 static int rzfind_open(RzfindOptions *ro, const char *file);
 
-static int hit(RzSearchKeyword *kw, void *user, ut64 addr) {
-	RzfindOptions *ro = (RzfindOptions *)user;
-	int delta = addr - ro->cur;
-	if (ro->cur > addr && (ro->cur - addr == kw->keyword_length - 1)) {
-		// This case occurs when there is hit in search left over
-		delta = ro->cur - addr;
-	}
-	if (delta < 0 || delta >= ro->bsize) {
-		eprintf("Invalid delta\n");
-		return 0;
-	}
+/**
+ * Formats a single search hit at \p addr, \p buf points to the data
+ * at the hit address and holds \p size bytes.
+ */
+static void rzfind_format_hit(RzfindOptions *ro, RzStrBuf *sb, RzSearchKeyword *kw, ut64 addr, const ut8 *buf, ut64 size, const char *comma, const char *file) {
 	char _str[128];
 	char *str = _str;
 	*_str = 0;
-	if (ro->showstr) {
-		if (ro->widestr) {
-			str = _str;
-			int i, j = 0;
-			for (i = delta; ro->buf[i] && i < sizeof(_str); i++) {
-				char ch = ro->buf[i];
-				if (ch == '"' || ch == '\\') {
-					ch = '\'';
-				}
-				if (!IS_PRINTABLE(ch)) {
-					break;
-				}
-				str[j++] = ch;
-				i++;
-				if (j > 80) {
-					strcpy(str + j, "...");
-					j += 3;
-					break;
-				}
-				if (ro->buf[i]) {
-					break;
-				}
+	size_t max = RZ_MIN(size, sizeof(_str) - 1);
+	if (ro->showstr && ro->widestr) {
+		size_t i, j = 0;
+		for (i = 0; i < max && buf[i]; i++) {
+			char ch = buf[i];
+			if (ch == '"' || ch == '\\') {
+				ch = '\'';
 			}
-			str[j] = 0;
-		} else {
-			size_t i;
-			for (i = 0; i < sizeof(_str) - 1; i++) {
-				char ch = ro->buf[delta + i];
-				if (ch == '"' || ch == '\\') {
-					ch = '\'';
-				}
-				if (!ch || !IS_PRINTABLE(ch)) {
-					break;
-				}
-				str[i] = ch;
+			if (!IS_PRINTABLE(ch)) {
+				break;
+			}
+			str[j++] = ch;
+			i++;
+			if (j > 80) {
+				strcpy(str + j, "...");
+				j += 3;
+				break;
+			}
+			if (i < max && buf[i]) {
+				break;
 			}
-			str[i] = 0;
 		}
+		str[j] = 0;
 	} else {
 		size_t i;
-		for (i = 0; i < sizeof(_str) - 1; i++) {
-			char ch = ro->buf[delta + i];
+		for (i = 0; i < max; i++) {
+			char ch = buf[i];
 			if (ch == '"' || ch == '\\') {
 				ch = '\'';
 			}
@@ -123,23 +105,44 @@ static int hit(RzSearchKeyword *kw, void *user, ut64 addr) {
 	}
 	if (ro->json) {
 		const char *type = "string";
-		printf("%s{\"offset\":%" PFMT64d ",\"type\":\"%s\",\"data\":\"%s\"}",
-			ro->comma, addr, type, str);
-		ro->comma = ",";
+		rz_strbuf_appendf(sb, "%s{\"offset\":%" PFMT64d ",\"type\":\"%s\",\"data\":\"%s\"}",
+			comma, addr, type, str);
 	} else if (ro->rad) {
-		printf("f hit%d_%d @ 0x%08" PFMT64x " ; %s\n", 0, kw->count, addr, ro->curfile);
+		rz_strbuf_appendf(sb, "f hit%d_%d @ 0x%08" PFMT64x " ; %s\n", 0, kw->count, addr, file);
+	} else if (ro->showstr) {
+		rz_strbuf_appendf(sb, "0x%" PFMT64x " %s\n", addr, str);
 	} else {
-		if (ro->showstr) {
-			printf("0x%" PFMT64x " %s\n", addr, str);
-		} else {
-			printf("0x%" PFMT64x "\n", addr);
-			if (ro->pr) {
-				char *dump = rz_print_hexdump_str(ro->pr, addr, (ut8 *)ro->buf + delta, 78, 16, 1, 1);
-				printf("%s", dump);
+		rz_strbuf_appendf(sb, "0x%" PFMT64x "\n", addr);
+		if (ro->pr) {
+			// The data past the end of the buffer is shown as zeroes
+			ut8 dump_buf[78] = { 0 };
+			memcpy(dump_buf, buf, RZ_MIN(size, sizeof(dump_buf)));
+			char *dump = rz_print_hexdump_str(ro->pr, addr, dump_buf, sizeof(dump_buf), 16, 1, 1);
+			if (dump) {
+				rz_strbuf_append(sb, dump);
 				free(dump);
 			}
 		}
 	}
+}
+
+static int hit(RzSearchKeyword *kw, void *user, ut64 addr) {
+	RzfindOptions *ro = (RzfindOptions *)user;
+	int delta = addr - ro->cur;
+	if (ro->cur > addr && (ro->cur - addr == kw->keyword_length - 1)) {
+		// This case occurs when there is hit in search left over
+		delta = ro->cur - addr;
+	}
+	if (delta < 0 || delta >= ro->bsize) {
+		eprintf("Invalid delta\n");
+		return 0;
+	}
+	RzStrBuf sb;
+	rz_strbuf_init(&sb);
+	rzfind_format_hit(ro, &sb, kw, addr, ro->buf + delta, ro->bsize - delta, ro->comma, ro->curfile);
+	printf("%s", rz_strbuf_get(&sb));
+	rz_strbuf_fini(&sb);
+	ro->comma = ",";
 	return 1;
 }
 
@@ -171,7 +174,7 @@ static void print_bin_string(RzBinFile *bf, RzBinString *string, PJ *pj) {
 }
 
 static int show_help(const char *argv0, int line) {
-	printf("Usage: %s [-mXnzZhqv] [-a align] [-b sz] [-f/t from/to] [-[e|s|w|S|I] str] [-x hex] -|file|dir ..\n", argv0);
+	printf("Usage: %s [-mXnzZhqv] [-a align] [-P threads] [-b sz] [-f/t from/to] [-[e|s|w|S|I] str] [-x hex] -|file|dir ..\n", argv0);
 	if (line) {
 		return 0;
 	}
@@ -187,6 +190,7 @@ static int show_help(const char *argv0, int line) {
 		" -m         magic search, file-type carver\n"
 		" -M [str]   set a binary mask to be applied on keywords\n"
 		" -n         do not stop on read errors\n"
+		" -P [n]     search the files of a directory in parallel with n threads (0 = all cores)\n"
 		" -r         print using rizin commands\n"
 		" -s [str]   search for a specific string (can be used multiple times)\n"
 		" -w [str]   search for a specific wide string (can be used multiple times). Assumes str is UTF-8.\n"
@@ -202,6 +206,33 @@ static int show_help(const char *argv0, int line) {
 	return 0;
 }
 
+static RzSearch *rzfind_search_new(RzfindOptions *ro) {
+	RzSearch *rs = rz_search_new(ro->mode);
+	if (!rs) {
+		return NULL;
+	}
+	rs->align = ro->align;
+	if (ro->mode != RZ_SEARCH_KEYWORD) {
+		return rs;
+	}
+	RzListIter *iter;
+	const char *kw;
+	rz_list_foreach (ro->keywords, iter, kw) {
+		if (ro->hexstr) {
+			if (ro->mask) {
+				rz_search_kw_add(rs, rz_search_keyword_new_hex(kw, ro->mask, NULL));
+			} else {
+				rz_search_kw_add(rs, rz_search_keyword_new_hexmask(kw, NULL));
+			}
+		} else if (ro->widestr) {
+			rz_search_kw_add(rs, rz_search_keyword_new_wide(kw, ro->mask, NULL, 0));
+		} else {
+			rz_search_kw_add(rs, rz_search_keyword_new_str(kw, ro->mask, NULL, 0));
+		}
+	}
+	return rs;
+}
+
 static int rzfind_open_file(RzfindOptions *ro, const char *file, const ut8 *data, int datalen) {
 	RzListIter *iter;
 	RzSearch *rs = NULL;
@@ -308,7 +339,7 @@ static int rzfind_open_file(RzfindOptions *ro, const char *file, const ut8 *data
 		rz_io_write_at(io, 0, data, datalen);
 	}
 
-	rs = rz_search_new(ro->mode);
+	rs = rzfind_search_new(ro);
 	if (!rs) {
 		result = 1;
 		goto err;
@@ -320,7 +351,6 @@ static int rzfind_open_file(RzfindOptions *ro, const char *file, const ut8 *data
 		result = 1;
 		goto err;
 	}
-	rs->align = ro->align;
 	rz_search_set_callback(rs, &hit, ro);
 	ut64 to = ro->to;
 	if (to == -1) {
@@ -384,24 +414,6 @@ static int rzfind_open_file(RzfindOptions *ro, const char *file, const ut8 *data
 		}
 		goto done;
 	}
-	if (ro->mode == RZ_SEARCH_KEYWORD) {
-		rz_list_foreach (ro->keywords, iter, kw) {
-			if (ro->hexstr) {
-				if (ro->mask) {
-					rz_search_kw_add(rs, rz_search_keyword_new_hex(kw, ro->mask, NULL));
-				} else {
-					rz_search_kw_add(rs, rz_search_keyword_new_hexmask(kw, NULL));
-				}
-			} else if (ro->widestr) {
-				rz_search_kw_add(rs, rz_search_keyword_new_wide(kw, ro->mask, NULL, 0));
-			} else {
-				rz_search_kw_add(rs, rz_search_keyword_new_str(kw, ro->mask, NULL, 0));
-			}
-		}
-	} else if (ro->mode == RZ_SEARCH_STRING) {
-		rz_search_kw_add(rs, rz_search_keyword_new_hexmask("00", NULL)); // XXX
-	}
-
 	ro->curfile = file;
 	rz_search_begin(rs);
 	(void)rz_io_seek(io, ro->from, RZ_IO_SEEK_SET);
@@ -480,6 +492,278 @@ static int rzfind_open(RzfindOptions *ro, const char *file) {
 		: rzfind_open_file(ro, file, NULL, -1);
 }
 
+/* Parallel search over a corpus of files */
+
+// Files bigger than this are scanned in chunks by different workers
+#define RZFIND_CHUNK_SIZE (64ULL << 20)
+
+typedef struct {
+	const char *file; ///< Shared between all the chunks of the file
+	ut64 from; ///< Start of the chunk
+	ut64 to; ///< The hits at or after this address belong to the next chunk
+	ut64 end; ///< End of the scanned data, includes the overlap with the next chunk
+	bool first; ///< First chunk of the file
+	bool error;
+	bool done;
+	RzStrBuf out;
+} RzfindJob;
+
+typedef struct {
+	RzfindOptions *ro;
+	RzPVector /*<RzfindJob *>*/ jobs;
+	RzPVector /*<char *>*/ files;
+	RzThreadLock *lock;
+	size_t next_job; ///< Index of the next job to scan
+	size_t next_flush; ///< Index of the next job to print, the output follows the job order
+} RzfindCorpus;
+
+typedef struct {
+	RzfindCorpus *corpus;
+	RzSearch *rs; ///< Reused for all the jobs of the worker
+	RzMmap *map; ///< Mapping of the last scanned file, reused by its next chunks
+	RzfindJob *job;
+} RzfindWorker;
+
+static void rzfind_job_free(RzfindJob *job) {
+	if (!job) {
+		return;
+	}
+	rz_strbuf_fini(&job->out);
+	free(job);
+}
+
+static void rzfind_collect_files(RzPVector /*<char *>*/ *files, const char *path) {
+	if (!rz_file_is_directory(path)) {
+		rz_pvector_push(files, strdup(path));
+		return;
+	}
+	RzList *entries = rz_sys_dir(path);
+	if (!entries) {
+		return;
+	}
+	RzListIter *iter;
+	char *fname;
+	rz_list_foreach (entries, iter, fname) {
+		/* Filter-out unwanted entries */
+		if (*fname == '.') {
+			continue;
+		}
+		char *fullpath = rz_file_path_join(path, fname);
+		if (fullpath) {
+			rzfind_collect_files(files, fullpath);
+			free(fullpath);
+		}
+	}
+	rz_list_free(entries);
+}
+
+static bool rzfind_add_job(RzfindCorpus *corpus, const char *file, ut64 from, ut64 to, ut64 end, bool first) {
+	RzfindJob *job = RZ_NEW0(RzfindJob);
+	if (!job) {
+		return false;
+	}
+	job->file = file;
+	job->from = from;
+	job->to = to;
+	job->end = end;
+	job->first = first;
+	rz_strbuf_init(&job->out);
+	if (!rz_pvector_push(&corpus->jobs, job)) {
+		rzfind_job_free(job);
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Splits the big files in chunks overlapping by \p overlap bytes,
+ * so that the hits crossing the chunk boundaries are still found.
+ */
+static bool rzfind_add_file_jobs(RzfindCorpus *corpus, const char *file, ut64 overlap) {
+	RzfindOptions *ro = corpus->ro;
+	ut64 size = rz_file_size(file);
+	ut64 to = RZ_MIN(ro->to, size);
+	// The hit numbering of the rizin commands is per file, so these are never split
+	if (ro->rad || to <= ro->from || to - ro->from <= RZFIND_CHUNK_SIZE) {
+		return rzfind_add_job(corpus, file, ro->from, ro->to, ro->to, true);
+	}
+	for (ut64 from = ro->from; from < to; from += RZFIND_CHUNK_SIZE) {
+		ut64 chunk_to = to - from > RZFIND_CHUNK_SIZE ? from + RZFIND_CHUNK_SIZE : to;
+		ut64 chunk_end = RZ_MIN(chunk_to + overlap, to);
+		if (!rzfind_add_job(corpus, file, from, chunk_to, chunk_end, from == ro->from)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static int rzfind_job_hit(RzSearchKeyword *kw, void *user, ut64 addr) {
+	RzfindWorker *worker = (RzfindWorker *)user;
+	RzfindJob *job = worker->job;
+	if (addr >= job->to) {
+		return 1;
+	}
+	// The comma is removed from the very first printed hit
+	rzfind_format_hit(worker->corpus->ro, &job->out, kw, addr, worker->map->buf + addr,
+		worker->map->len - addr, ",", job->file);
+	return 1;
+}
+
+static bool rzfind_scan_job(RzfindWorker *worker, RzfindJob *job) {
+	if (!worker->map || strcmp(worker->map->filename, job->file)) {
+		rz_file_mmap_free(worker->map);
+		worker->map = rz_file_mmap(job->file, O_RDONLY, 0, 0);
+		if (!worker->map) {
+			return false;
+		}
+	}
+	ut64 end = RZ_MIN(job->end, worker->map->len);
+	if (job->from >= end) {
+		return true;
+	}
+	worker->job = job;
+	rz_search_begin(worker->rs);
+	rz_search_set_callback(worker->rs, &rzfind_job_hit, worker);
+	return rz_search_update(worker->rs, job->from, worker->map->buf + job->from, end - job->from) != -1;
+}
+
+/**
+ * Prints the output of all the consecutive finished jobs, must be called with the lock held.
+ */
+static void rzfind_flush_jobs(RzfindCorpus *corpus) {
+	RzfindOptions *ro = corpus->ro;
+	while (corpus->next_flush < rz_pvector_len(&corpus->jobs)) {
+		RzfindJob *job = rz_pvector_at(&corpus->jobs, corpus->next_flush);
+		if (!job->done) {
+			break;
+		}
+		if (job->first && !ro->quiet) {
+			printf("File: %s\n", job->file);
+		}
+		if (job->error && job->first) {
+			eprintf("Cannot open file '%s'\n", job->file);
+		}
+		const char *out = rz_strbuf_get(&job->out);
+		if (ro->json && *out == ',' && RZ_STR_ISEMPTY(ro->comma)) {
+			out++;
+		}
+		if (*out) {
+			printf("%s", out);
+			ro->comma = ",";
+		}
+		fflush(stdout);
+		rz_strbuf_fini(&job->out);
+		corpus->next_flush++;
+	}
+}
+
+static void *rzfind_worker_run(void *user) {
+	RzfindWorker *worker = (RzfindWorker *)user;
+	RzfindCorpus *corpus = worker->corpus;
+	while (true) {
+		rz_th_lock_enter(corpus->lock);
+		if (corpus->next_job >= rz_pvector_len(&corpus->jobs)) {
+			rz_th_lock_leave(corpus->lock);
+			break;
+		}
+		RzfindJob *job = rz_pvector_at(&corpus->jobs, corpus->next_job++);
+		rz_th_lock_leave(corpus->lock);
+
+		bool error = !rzfind_scan_job(worker, job);
+
+		rz_th_lock_enter(corpus->lock);
+		job->error = error;
+		job->done = true;
+		rzfind_flush_jobs(corpus);
+		rz_th_lock_leave(corpus->lock);
+	}
+	return NULL;
+}
+
+/**
+ * \brief Searches all the files found in \p path using a bounded pool of workers
+ *
+ * Each worker owns its search context and maps the files instead of reading them
+ * through RzIO. The results are printed as soon as all the previous files are done,
+ * so the output is the same as the one of the sequential search.
+ */
+static int rzfind_open_parallel(RzfindOptions *ro, const char *path, size_t max_threads) {
+	RzfindCorpus corpus = { .ro = ro };
+	RzThreadPool *pool = NULL;
+	RzfindWorker *workers = NULL;
+	size_t n_workers = 0;
+	int result = 1;
+	rz_pvector_init(&corpus.jobs, (RzPVectorFree)rzfind_job_free);
+	rz_pvector_init(&corpus.files, free);
+
+	// Used to compute the overlap of the chunks and to validate the keywords
+	RzSearch *rs = rzfind_search_new(ro);
+	if (!rs) {
+		goto beach;
+	}
+	ut64 overlap = 0;
+	RzListIter *iter;
+	RzSearchKeyword *kw;
+	rz_list_foreach (rs->kws, iter, kw) {
+		if (kw->keyword_length > overlap + 1) {
+			overlap = kw->keyword_length - 1;
+		}
+	}
+	rz_search_free(rs);
+
+	rzfind_collect_files(&corpus.files, path);
+	void **it;
+	rz_pvector_foreach (&corpus.files, it) {
+		if (!rzfind_add_file_jobs(&corpus, *it, overlap)) {
+			goto beach;
+		}
+	}
+	if (rz_pvector_empty(&corpus.jobs)) {
+		result = 0;
+		goto beach;
+	}
+
+	corpus.lock = rz_th_lock_new(false);
+	pool = rz_th_pool_new(RZ_MIN(max_threads ? max_threads : SIZE_MAX, rz_pvector_len(&corpus.jobs)));
+	if (!corpus.lock || !pool) {
+		goto beach;
+	}
+	n_workers = rz_th_pool_size(pool);
+	workers = RZ_NEWS0(RzfindWorker, n_workers);
+	if (!workers) {
+		goto beach;
+	}
+	for (size_t i = 0; i < n_workers; i++) {
+		workers[i].corpus = &corpus;
+		workers[i].rs = rzfind_search_new(ro);
+		if (!workers[i].rs) {
+			goto beach;
+		}
+	}
+	for (size_t i = 0; i < n_workers; i++) {
+		RzThread *th = rz_th_new(rzfind_worker_run, &workers[i]);
+		if (!th || !rz_th_pool_add_thread(pool, th)) {
+			rz_th_free(th);
+			// The already running workers will take care of all the jobs
+			break;
+		}
+	}
+	rz_th_pool_wait(pool);
+	result = corpus.next_flush == rz_pvector_len(&corpus.jobs) ? 0 : 1;
+
+beach:
+	rz_th_pool_free(pool);
+	for (size_t i = 0; workers && i < n_workers; i++) {
+		rz_search_free(workers[i].rs);
+		rz_file_mmap_free(workers[i].map);
+	}
+	free(workers);
+	rz_th_lock_free(corpus.lock);
+	rz_pvector_fini(&corpus.jobs);
+	rz_pvector_fini(&corpus.files);
+	return result;
+}
+
 RZ_API int rz_main_rz_find(int argc, const char **argv) {
 	RzfindOptions ro;
 	rzfind_options_init(&ro);
@@ -488,7 +772,7 @@ RZ_API int rz_main_rz_find(int argc, const char **argv) {
 	const char *file = NULL;
 
 	RzGetopt opt;
-	rz_getopt_init(&opt, argc, argv, "a:ie:b:jmM:s:w:S:I:x:Xzf:F:t:E:rqnhvZ");
+	rz_getopt_init(&opt, argc, argv, "a:ie:b:jmM:P:s:w:S:I:x:Xzf:F:t:E:rqnhvZ");
 	while ((c = rz_getopt_next(&opt)) != -1) {
 		switch (c) {
 		case 'a':
@@ -541,6 +825,10 @@ RZ_API int rz_main_rz_find(int argc, const char **argv) {
 		case 'b':
 			ro.bsize = rz_num_math(NULL, opt.arg);
 			break;
+		case 'P':
+			ro.parallel = true;
+			ro.threads = rz_num_math(NULL, opt.arg);
+			break;
 		case 'M':
 			// XXX should be from hexbin
 			ro.mask = opt.arg;
@@ -611,7 +899,12 @@ RZ_API int rz_main_rz_find(int argc, const char **argv) {
 			rz_list_free(ro.keywords);
 			return 1;
 		}
-		rzfind_open(&ro, file);
+		// Only the byte pattern searches are done by the workers
+		if (ro.parallel && ro.mode == RZ_SEARCH_KEYWORD && !ro.identify && !ro.import && !ro.symbol && strcmp(file, "-")) {
+			rzfind_open_parallel(&ro, file, ro.threads);
+		} else {
+			rzfind_open(&ro, file);
+		}
 	}
 	rz_list_free(ro.keywords);
 	if (ro.json) {
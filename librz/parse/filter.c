@@ -144,6 +144,92 @@ static char *findNextNumber(char *op) {
 	return NULL;
 }
 
+typedef struct {
+	size_t off; ///< Offset of the character in the filtered string
+	bool after_ansi; ///< Whether an ANSI escape code is right before it
+} TokenOffset;
+
+/**
+ * \brief Maps the offsets of the asm string the tokens were made for into \p data.
+ *
+ * \p data can be the same string colored by the tokens, the ANSI escape codes are skipped.
+ * \return The offset of every character of the tokens string (and its end) in \p data,
+ * or NULL if \p data shows another string.
+ */
+static TokenOffset *token_offsets_new(const RzAsmTokenString *toks, const char *data) {
+	const char *plain = rz_strbuf_get(toks->str);
+	size_t len = strlen(plain);
+	TokenOffset *map = RZ_NEWS0(TokenOffset, len + 1);
+	if (!map) {
+		return NULL;
+	}
+	const char *d = data;
+	for (size_t i = 0; i <= len; i++) {
+		bool ansi = false;
+		while (d[0] == 0x1b && d[1] == '[') {
+			for (d += 2; *d && *d != 'J' && *d != 'm' && *d != 'H'; d++) {
+				;
+			}
+			if (*d) {
+				d++;
+			}
+			ansi = true;
+		}
+		map[i].off = d - data;
+		map[i].after_ansi = ansi;
+		if (i == len) {
+			break;
+		}
+		if (*d != plain[i]) {
+			free(map);
+			return NULL;
+		}
+		d++;
+	}
+	return map;
+}
+
+/**
+ * \brief Returns the next number of \p data after \p ptr from the tokens of the disassembler.
+ *
+ * Works like findNextNumber(), only numbers starting a word (or a colored token) are taken,
+ * but the numbers and their values come from the decoded instruction.
+ */
+static char *findNextNumberToken(char *data, char *ptr, const RzAsmTokenString *toks, const TokenOffset *map, size_t *idx, const RzAsmToken **tok) {
+	const char *plain = rz_strbuf_get(toks->str);
+	while (*idx < rz_vector_len(toks->tokens)) {
+		const RzAsmToken *t = rz_vector_index_ptr(toks->tokens, (*idx)++);
+		char *start = data + map[t->start].off;
+		if (t->type != RZ_ASM_TOKEN_NUMBER || start < ptr || !t->start || !IS_DIGIT(*start)) {
+			continue;
+		}
+		size_t prev = t->start - 1;
+		if (map[t->start].after_ansi) {
+			*tok = t;
+			return start;
+		}
+		if (plain[prev] == '-' && prev > 0) {
+			if (map[prev].after_ansi) {
+				*tok = t;
+				return start;
+			}
+			prev--;
+		}
+		if (plain[prev] == ' ' || plain[prev] == ',' || plain[prev] == '[') {
+			*tok = t;
+			return start;
+		}
+	}
+	return NULL;
+}
+
+/**
+ * \brief Returns the offset in the filtered string right after the last character of \p tok.
+ */
+static size_t map_token_end(const TokenOffset *map, const RzAsmToken *tok) {
+	return tok->len ? map[tok->start + tok->len - 1].off + 1 : map[tok->start].off;
+}
+
 static void __replaceRegisters(RzReg *reg, char *s, bool x86) {
 	int i;
 	for (i = 0; i < 64; i++) {
@@ -182,7 +268,7 @@ static bool is_lea(const char *asm_str) {
 	return rz_regex_match("(^\x1b\\[[[:digit:]]{1,3}mlea\x1b\\[0m.+)", "ei", asm_str) != RZ_REGEX_NOMATCH;
 }
 
-static bool filter(RzParse *p, ut64 addr, RzFlag *f, RzAnalysisHint *hint, char *data, char *str, int len, bool big_endian) {
+static bool filter(RzParse *p, ut64 addr, RzFlag *f, const RzAnalysisHint *hint, const RzAsmTokenString *toks, const TokenOffset *tok_map, char *data, char *str, int len, bool big_endian) {
 	char *ptr = data, *ptr2, *ptr_backup;
 	RzAnalysisFunction *fcn;
 	RzFlagItem *flag;
@@ -207,6 +293,10 @@ static bool filter(RzParse *p, ut64 addr, RzFlag *f, RzAnalysisHint *hint, char
 	replaceWords(ptr, "dword ", src);
 	replaceWords(ptr, "qword ", src);
 #endif
+	if (!tok_map || p->subreg) {
+		// The tokens only describe the untouched asm string
+		toks = NULL;
+	}
 	if (p->subreg) {
 		__replaceRegisters(p->analb.analysis->reg, ptr, false);
 		if (x86) {
@@ -217,7 +307,9 @@ static bool filter(RzParse *p, ut64 addr, RzFlag *f, RzAnalysisHint *hint, char
 	// remove "dword" 2
 	char *nptr;
 	int count = 0;
-	for (count = 0; (nptr = findNextNumber(ptr)); count++) {
+	size_t tok_idx = 0;
+	const RzAsmToken *tok = NULL;
+	for (count = 0; (nptr = toks ? findNextNumberToken(data, ptr, toks, tok_map, &tok_idx, &tok) : findNextNumber(ptr)); count++) {
 		ptr = nptr;
 
 		// Skip floats
@@ -232,16 +324,21 @@ static bool filter(RzParse *p, ut64 addr, RzFlag *f, RzAnalysisHint *hint, char
 			continue;
 		}
 
-		if (x86) {
-			for (ptr2 = ptr; *ptr2 && !isx86separator(*ptr2); ptr2++) {
-				;
-			}
+		if (toks) {
+			ptr2 = data + map_token_end(tok_map, tok);
+			off = tok->val.number;
 		} else {
-			for (ptr2 = ptr; *ptr2 && (*ptr2 != ']' && (*ptr2 != '\x1b') && !IS_SEPARATOR(*ptr2)); ptr2++) {
-				;
+			if (x86) {
+				for (ptr2 = ptr; *ptr2 && !isx86separator(*ptr2); ptr2++) {
+					;
+				}
+			} else {
+				for (ptr2 = ptr; *ptr2 && (*ptr2 != ']' && (*ptr2 != '\x1b') && !IS_SEPARATOR(*ptr2)); ptr2++) {
+					;
+				}
 			}
+			off = rz_num_math(NULL, ptr);
 		}
-		off = rz_num_math(NULL, ptr);
 		if (off >= p->minval) {
 			fcn = p->analb.get_fcn_in(p->analb.analysis, off, 0);
 			if (fcn && fcn->addr == off) {
@@ -411,6 +508,8 @@ static bool filter(RzParse *p, ut64 addr, RzFlag *f, RzAnalysisHint *hint, char
 				}
 				if (p->subtail) { //  && off > UT32_MAX && addr > UT32_MAX)
 					if (off != UT64_MAX) {
+						// The text is changed in place, the token offsets are not valid anymore
+						toks = NULL;
 						if (off == addr) {
 							insert(ptr, "$$");
 						} else {
@@ -586,8 +685,25 @@ static bool filter(RzParse *p, ut64 addr, RzFlag *f, RzAnalysisHint *hint, char
 // TODO we shouhld use RzCoreBind and use the hintGet/flagGet methods, but we can also have rflagbind+ranalbind, but kiss pls
 // TODO: NEW SIGNATURE: RZ_API char *rz_parse_filter(RzParse *p, ut64 addr, const char *str)
 // DEPRECATE
-RZ_API bool rz_parse_filter(RzParse *p, ut64 addr, RzFlag *f, RzAnalysisHint *hint, char *data, char *str, int len, bool big_endian) {
-	filter(p, addr, f, hint, data, str, len, big_endian);
+RZ_API bool rz_parse_filter(RzParse *p, ut64 addr, RzFlag *f, const RzAnalysisHint *hint, char *data, char *str, int len, bool big_endian) {
+	return rz_parse_filter_tokens(p, addr, f, hint, NULL, data, str, len, big_endian);
+}
+
+/**
+ * \brief Same as rz_parse_filter(), but takes the numbers from the tokens of the disassembler.
+ *
+ * The tokens are used only if \p data is the asm string they were made for, also when
+ * it was colored with ANSI escape codes. Otherwise the numbers are searched in the text
+ * as rz_parse_filter() does.
+ *
+ * \param toks The tokens of the asm string, see RzAsmOp.asm_toks.
+ */
+RZ_API bool rz_parse_filter_tokens(RzParse *p, ut64 addr, RzFlag *f, const RzAnalysisHint *hint, RZ_NULLABLE const RzAsmTokenString *toks,
+	char *data, char *str, int len, bool big_endian) {
+	// The tokens map into the asm string even when it was colored by them already
+	TokenOffset *tok_map = toks && data ? token_offsets_new(toks, data) : NULL;
+	filter(p, addr, f, hint, toks, tok_map, data, str, len, big_endian);
+	free(tok_map);
 	if (p->cur && p->cur->filter) {
 		return p->cur->filter(p, addr, f, data, str, len, big_endian);
 	}
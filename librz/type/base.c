@@ -4,6 +4,7 @@
 #include <rz_util.h>
 #include <rz_type.h>
 #include <string.h>
+#include "type_private.h"
 
 RZ_API void rz_type_base_enum_case_free(void *e, void *user) {
 	(void)user;
@@ -172,6 +173,208 @@ RZ_API RZ_OWN RzBaseType *rz_base_type_clone(RZ_NULLABLE RZ_BORROW RzBaseType *b
 	return type;
 }
 
+static inline ut64 hash_mix(ut64 h, ut64 v) {
+	return (h ^ v) * 0x100000001b3ULL;
+}
+
+static ut64 members_hash(TypeCompare *tc, ut64 h, const RzVector /*<RzTypeStructMember>*/ *members) {
+	// union members have the same layout as struct members
+	RzTypeStructMember *memb;
+	rz_vector_foreach(members, memb) {
+		h = hash_mix(h, rz_str_djb2_hash(memb->name));
+		h = hash_mix(h, memb->offset);
+		h = hash_mix(h, memb->size);
+		h = hash_mix(h, memb->type ? type_hash(tc, memb->type) : 0);
+	}
+	return h;
+}
+
+static bool stack_has(const RzPVector /*<const RzBaseType *>*/ *stack, const RzBaseType *btype) {
+	void **it;
+	rz_pvector_foreach (stack, it) {
+		if (*it == btype) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Hashes \p btype, without its name if it is \p anonymous and reached through a reference.
+ */
+RZ_IPI ut64 base_type_hash(TypeCompare *tc, const RzBaseType *btype, bool anonymous) {
+	ut64 h = hash_mix(0xcbf29ce484222325ULL, btype->kind);
+	if (anonymous) {
+		if (stack_has(&tc->stack, btype)) {
+			// a cycle back to a type being hashed
+			return h;
+		}
+		rz_pvector_push(&tc->stack, (void *)btype);
+	} else {
+		h = hash_mix(h, rz_str_djb2_hash(btype->name));
+	}
+	h = hash_mix(h, btype->size);
+	h = hash_mix(h, btype->attrs);
+	h = hash_mix(h, btype->type ? type_hash(tc, btype->type) : 0);
+	switch (btype->kind) {
+	case RZ_BASE_TYPE_KIND_STRUCT:
+		h = members_hash(tc, h, &btype->struct_data.members);
+		break;
+	case RZ_BASE_TYPE_KIND_UNION:
+		h = members_hash(tc, h, &btype->union_data.members);
+		break;
+	case RZ_BASE_TYPE_KIND_ENUM: {
+		RzTypeEnumCase *cas;
+		rz_vector_foreach(&btype->enum_data.cases, cas) {
+			h = hash_mix(h, rz_str_djb2_hash(cas->name));
+			h = hash_mix(h, cas->val);
+		}
+		break;
+	}
+	default:
+		break;
+	}
+	if (anonymous) {
+		rz_pvector_pop(&tc->stack);
+	}
+	return h;
+}
+
+/**
+ * \brief Hash the whole structure of \p btype, consistently with rz_base_type_equal()
+ *
+ * Together with rz_base_type_equal() this allows to store every type only once
+ * when importing the same types from many sources, like compile units of debug info.
+ */
+RZ_API ut64 rz_base_type_hash(RZ_NONNULL const RzBaseType *btype) {
+	return rz_base_type_hash_resolved(btype, NULL);
+}
+
+/**
+ * \brief Hash \p btype consistently with rz_base_type_equal_resolved()
+ *
+ * \param resolver Finds the anonymous types to hash by their structure, or NULL
+ */
+RZ_API ut64 rz_base_type_hash_resolved(RZ_NONNULL const RzBaseType *btype, RZ_NULLABLE const RzTypeAnonymousResolver *resolver) {
+	rz_return_val_if_fail(btype, 0);
+	TypeCompare tc;
+	type_compare_init(&tc, resolver);
+	ut64 h = base_type_hash(&tc, btype, false);
+	type_compare_fini(&tc);
+	return h;
+}
+
+static bool nullable_types_equal(TypeCompare *tc, const RzType *a, const RzType *b) {
+	if (!a || !b) {
+		return a == b;
+	}
+	return type_equal(tc, a, b);
+}
+
+static bool members_equal(TypeCompare *tc, const RzVector /*<RzTypeStructMember>*/ *a, const RzVector /*<RzTypeStructMember>*/ *b) {
+	if (rz_vector_len(a) != rz_vector_len(b)) {
+		return false;
+	}
+	for (size_t i = 0; i < rz_vector_len(a); i++) {
+		const RzTypeStructMember *ma = rz_vector_index_ptr(a, i);
+		const RzTypeStructMember *mb = rz_vector_index_ptr(b, i);
+		if (ma->offset != mb->offset || ma->size != mb->size || RZ_STR_NE(ma->name, mb->name) ||
+			!nullable_types_equal(tc, ma->type, mb->type)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool stack_has_pair(const RzPVector /*<const RzBaseType *>*/ *stack, const RzBaseType *a, const RzBaseType *b) {
+	for (size_t i = 0; i + 1 < rz_pvector_len(stack); i += 2) {
+		if (rz_pvector_at(stack, i) == a && rz_pvector_at(stack, i + 1) == b) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static bool base_type_body_equal(TypeCompare *tc, const RzBaseType *a, const RzBaseType *b) {
+	if (a->kind != b->kind || a->size != b->size || a->attrs != b->attrs ||
+		!nullable_types_equal(tc, a->type, b->type)) {
+		return false;
+	}
+	switch (a->kind) {
+	case RZ_BASE_TYPE_KIND_STRUCT:
+		return members_equal(tc, &a->struct_data.members, &b->struct_data.members);
+	case RZ_BASE_TYPE_KIND_UNION:
+		return members_equal(tc, &a->union_data.members, &b->union_data.members);
+	case RZ_BASE_TYPE_KIND_ENUM: {
+		const RzVector *ca = &a->enum_data.cases;
+		const RzVector *cb = &b->enum_data.cases;
+		if (rz_vector_len(ca) != rz_vector_len(cb)) {
+			return false;
+		}
+		for (size_t i = 0; i < rz_vector_len(ca); i++) {
+			const RzTypeEnumCase *x = rz_vector_index_ptr(ca, i);
+			const RzTypeEnumCase *y = rz_vector_index_ptr(cb, i);
+			if (x->val != y->val || RZ_STR_NE(x->name, y->name)) {
+				return false;
+			}
+		}
+		return true;
+	}
+	default:
+		return true;
+	}
+}
+
+/**
+ * Compares \p a and \p b, without their names if they are \p anonymous and reached through a reference.
+ */
+RZ_IPI bool base_type_equal(TypeCompare *tc, const RzBaseType *a, const RzBaseType *b, bool anonymous) {
+	if (a == b) {
+		return true;
+	}
+	if (!anonymous) {
+		return RZ_STR_EQ(a->name, b->name) && base_type_body_equal(tc, a, b);
+	}
+	if (stack_has_pair(&tc->stack, a, b)) {
+		// a cycle back to types being compared, they are equal unless something else differs
+		return true;
+	}
+	rz_pvector_push(&tc->stack, (void *)a);
+	rz_pvector_push(&tc->stack, (void *)b);
+	bool ret = base_type_body_equal(tc, a, b);
+	rz_pvector_pop(&tc->stack);
+	rz_pvector_pop(&tc->stack);
+	return ret;
+}
+
+/**
+ * \brief Check whether two base types have the same name and structure
+ *
+ * Unlike comparing names only, this compares sizes, attributes, the underlying
+ * type and every member or enum case. Referenced types are compared with
+ * rz_types_equal().
+ */
+RZ_API bool rz_base_type_equal(RZ_NONNULL const RzBaseType *a, RZ_NONNULL const RzBaseType *b) {
+	return rz_base_type_equal_resolved(a, b, NULL);
+}
+
+/**
+ * \brief Check whether two base types have the same name and structure
+ *
+ * Like rz_base_type_equal(), but the referenced types that \p resolver finds
+ * to be anonymous are compared by their structure, recursively.
+ *
+ * \param resolver Finds the anonymous types to compare by their structure, or NULL
+ */
+RZ_API bool rz_base_type_equal_resolved(RZ_NONNULL const RzBaseType *a, RZ_NONNULL const RzBaseType *b, RZ_NULLABLE const RzTypeAnonymousResolver *resolver) {
+	rz_return_val_if_fail(a && b, false);
+	TypeCompare tc;
+	type_compare_init(&tc, resolver);
+	bool ret = base_type_equal(&tc, a, b, false);
+	type_compare_fini(&tc);
+	return ret;
+}
+
 /**
  * \brief Frees the RzBaseType instance and all of its members
  *
@@ -6,6 +6,7 @@
 #include <rz_list.h>
 #include <rz_util/rz_file.h>
 #include <rz_type.h>
+#include <rz_th.h>
 #include <tree_sitter/api.h>
 
 #include <types_parser.h>
@@ -16,12 +17,6 @@
 		end = ts_node_end_byte(node); \
 	} while (0)
 
-static char *ts_node_sub_string(TSNode node, const char *cstr) {
-	ut32 start, end;
-	TS_START_END(node, start, end);
-	return rz_str_newf("%.*s", end - start, cstr + start);
-}
-
 // Declare the `tree_sitter_c` function, which is
 // implemented by the `tree-sitter-c` library.
 TSLanguage *tree_sitter_c();
@@ -85,8 +80,52 @@ void c_parser_state_reset_keep_ht(CParserState *state) {
 
 struct rz_type_parser_t {
 	CParserState *state;
+	TSParser *tsparser; ///< Reused tree-sitter parser, created on the first use
+	RzStrBuf *expr; ///< Reused buffer for the patched type expressions
+	HtPP /*<char *, TypeExprCacheEntry *>*/ *expr_cache; ///< Parsed type expressions
 };
 
+static RzTypeParser *type_parser_new(CParserState *state) {
+	RzTypeParser *parser = RZ_NEW0(RzTypeParser);
+	if (!parser) {
+		return NULL;
+	}
+	parser->state = state;
+	parser->expr = rz_strbuf_new("");
+	parser->expr_cache = c_parser_type_expression_cache_new();
+	if (!parser->state || !parser->expr || !parser->expr_cache) {
+		rz_type_parser_free(parser);
+		return NULL;
+	}
+	return parser;
+}
+
+static void type_parser_fini(RzTypeParser *parser) {
+	if (parser->tsparser) {
+		ts_parser_delete(parser->tsparser);
+	}
+	rz_strbuf_free(parser->expr);
+	ht_pp_free(parser->expr_cache);
+}
+
+/**
+ * Creating the tree-sitter parser is not cheap, so we keep
+ * the single instance per RzTypeParser and reset it between uses
+ */
+static TSParser *type_parser_ts_get(RzTypeParser *parser) {
+	if (!parser->tsparser) {
+		parser->tsparser = ts_parser_new();
+		if (!parser->tsparser) {
+			return NULL;
+		}
+		// Set the parser's language (C in this case)
+		ts_parser_set_language(parser->tsparser, tree_sitter_c());
+	} else {
+		ts_parser_reset(parser->tsparser);
+	}
+	return parser->tsparser;
+}
+
 /**
  * \brief Creates a new instance of the C type parser
  *
@@ -94,12 +133,7 @@ struct rz_type_parser_t {
  * hashtables for RzBaseTypes and RzCallable types.
  */
 RZ_API RZ_OWN RzTypeParser *rz_type_parser_new() {
-	RzTypeParser *parser = RZ_NEW0(RzTypeParser);
-	if (!parser) {
-		return NULL;
-	}
-	parser->state = c_parser_state_new(NULL, NULL);
-	return parser;
+	return type_parser_new(c_parser_state_new(NULL, NULL));
 }
 
 /**
@@ -113,12 +147,7 @@ RZ_API RZ_OWN RzTypeParser *rz_type_parser_new() {
  * \param type RzCallable hashtable to preload into the parser state
  */
 RZ_API RZ_OWN RzTypeParser *rz_type_parser_init(HtPP *types, HtPP *callables) {
-	RzTypeParser *parser = RZ_NEW0(RzTypeParser);
-	if (!parser) {
-		return NULL;
-	}
-	parser->state = c_parser_state_new(types, callables);
-	return parser;
+	return type_parser_new(c_parser_state_new(types, callables));
 }
 
 /**
@@ -126,7 +155,10 @@ RZ_API RZ_OWN RzTypeParser *rz_type_parser_init(HtPP *types, HtPP *callables) {
  */
 RZ_API void rz_type_parser_free(RZ_NONNULL RzTypeParser *parser) {
 	// We do not destroy HT by default since it might be used after
-	c_parser_state_free_keep_ht(parser->state);
+	if (parser->state) {
+		c_parser_state_free_keep_ht(parser->state);
+	}
+	type_parser_fini(parser);
 	free(parser);
 }
 
@@ -135,15 +167,14 @@ RZ_API void rz_type_parser_free(RZ_NONNULL RzTypeParser *parser) {
  */
 RZ_API void rz_type_parser_free_purge(RZ_NONNULL RzTypeParser *parser) {
 	c_parser_state_free(parser->state);
+	type_parser_fini(parser);
 	free(parser);
 }
 
-static int type_parse_string(CParserState *state, const char *code, char **error_msg) {
-	// Create a parser.
-	TSParser *parser = ts_parser_new();
-	// Set the parser's language (C in this case)
-	ts_parser_set_language(parser, tree_sitter_c());
-
+static int type_parse_string(CParserState *state, TSParser *parser, const char *code, char **error_msg) {
+	if (!parser) {
+		return -1;
+	}
 	TSTree *tree = ts_parser_parse_string(parser, NULL, code, strlen(code));
 
 	// Get the root node of the syntax tree.
@@ -152,7 +183,6 @@ static int type_parse_string(CParserState *state, const char *code, char **error
 	if (!root_node_child_count) {
 		parser_warning(state, "Root node is empty!\n");
 		ts_tree_delete(tree);
-		ts_parser_delete(parser);
 		return 0;
 	}
 
@@ -180,12 +210,11 @@ static int type_parse_string(CParserState *state, const char *code, char **error
 	for (i = 0; i < root_node_child_count; i++) {
 		TSNode child = ts_node_named_child(root_node, i);
 		// We skip ";" or "," - empty expressions
-		char *node_code = ts_node_sub_string(child, code);
-		if (!strcmp(node_code, ";") || !strcmp(node_code, ",")) {
-			free(node_code);
+		ut32 start, end;
+		TS_START_END(child, start, end);
+		if (end - start == 1 && (code[start] == ';' || code[start] == ',')) {
 			continue;
 		}
-		free(node_code);
 		parser_debug(state, "Processing %d child...\n", i);
 		result += parse_type_nodes_save(state, child, code);
 	}
@@ -213,7 +242,6 @@ static int type_parse_string(CParserState *state, const char *code, char **error
 	// After everything parsed, we should preserve the base type database
 	// And the state of the parser - anonymous structs, forward declarations, etc
 	ts_tree_delete(tree);
-	ts_parser_delete(parser);
 	return result;
 }
 
@@ -225,7 +253,7 @@ static int type_parse_string(CParserState *state, const char *code, char **error
  * \param error_msg A pointer where all error messages will be stored
  */
 RZ_API int rz_type_parse_string_stateless(RzTypeParser *parser, const char *code, char **error_msg) {
-	return type_parse_string(parser->state, code, error_msg);
+	return type_parse_string(parser->state, type_parser_ts_get(parser), code, error_msg);
 }
 
 /**
@@ -286,11 +314,391 @@ RZ_API int rz_type_parse_string(RzTypeDB *typedb, const char *code, char **error
 		return -1;
 	}
 	state->verbose = verbose;
-	int ret = type_parse_string(state, code, error_msg);
+	int ret = type_parse_string(state, type_parser_ts_get(typedb->parser), code, error_msg);
 	c_parser_state_free_keep_ht(state);
 	return ret;
 }
 
+typedef struct {
+	const char *path;
+	const RzTypePreprocessor *pp;
+	HtPP *base_types;
+	CParserState *state; ///< Private parser state with the types found in the header
+	char *error_msg;
+	bool failed;
+} TypeHeaderJob;
+
+static void type_header_job_parse(void *element, void *user) {
+	TypeHeaderJob *job = element;
+	char *code = rz_type_preprocess_file(job->pp, job->path, &job->error_msg);
+	if (!code) {
+		job->failed = true;
+		return;
+	}
+	// Every job has its own tables, the types database itself is only read
+	job->state = c_parser_state_new(NULL, NULL);
+	TSParser *tsparser = ts_parser_new();
+	if (!job->state || !tsparser) {
+		job->failed = true;
+		goto beach;
+	}
+	job->state->base_types = job->base_types;
+	ts_parser_set_language(tsparser, tree_sitter_c());
+	char *parse_error = NULL;
+	job->failed = type_parse_string(job->state, tsparser, code, &parse_error) != 0;
+	if (parse_error) {
+		char *msg = rz_str_newf("%s%s", rz_str_get(job->error_msg), parse_error);
+		free(job->error_msg);
+		free(parse_error);
+		job->error_msg = msg;
+	}
+beach:
+	if (tsparser) {
+		ts_parser_delete(tsparser);
+	}
+	free(code);
+}
+
+static bool callables_equal(const RzCallable *a, const RzCallable *b) {
+	if ((!a->ret) != (!b->ret) || (a->ret && !rz_types_equal(a->ret, b->ret))) {
+		return false;
+	}
+	size_t nargs = a->args ? rz_pvector_len(a->args) : 0;
+	if (nargs != (b->args ? rz_pvector_len(b->args) : 0)) {
+		return false;
+	}
+	for (size_t i = 0; i < nargs; i++) {
+		RzCallableArg *arg_a = rz_pvector_at(a->args, i);
+		RzCallableArg *arg_b = rz_pvector_at(b->args, i);
+		if ((!arg_a->type) != (!arg_b->type) || (arg_a->type && !rz_types_equal(arg_a->type, arg_b->type))) {
+			return false;
+		}
+	}
+	return a->noret == b->noret && a->has_unspecified_parameters == b->has_unspecified_parameters;
+}
+
+static bool base_types_equal(const RzBaseType *a, const RzBaseType *b) {
+	if (a->kind != b->kind || a->size != b->size || (!a->type) != (!b->type) || (a->type && !rz_types_equal(a->type, b->type))) {
+		return false;
+	}
+	switch (a->kind) {
+	case RZ_BASE_TYPE_KIND_STRUCT: {
+		if (rz_vector_len(&a->struct_data.members) != rz_vector_len(&b->struct_data.members)) {
+			return false;
+		}
+		for (size_t i = 0; i < rz_vector_len(&a->struct_data.members); i++) {
+			RzTypeStructMember *ma = rz_vector_index_ptr((RzVector *)&a->struct_data.members, i);
+			RzTypeStructMember *mb = rz_vector_index_ptr((RzVector *)&b->struct_data.members, i);
+			if (rz_str_cmp(ma->name, mb->name, -1) || ma->offset != mb->offset || ma->size != mb->size || !rz_types_equal(ma->type, mb->type)) {
+				return false;
+			}
+		}
+		return true;
+	}
+	case RZ_BASE_TYPE_KIND_UNION: {
+		if (rz_vector_len(&a->union_data.members) != rz_vector_len(&b->union_data.members)) {
+			return false;
+		}
+		for (size_t i = 0; i < rz_vector_len(&a->union_data.members); i++) {
+			RzTypeUnionMember *ma = rz_vector_index_ptr((RzVector *)&a->union_data.members, i);
+			RzTypeUnionMember *mb = rz_vector_index_ptr((RzVector *)&b->union_data.members, i);
+			if (rz_str_cmp(ma->name, mb->name, -1) || ma->size != mb->size || !rz_types_equal(ma->type, mb->type)) {
+				return false;
+			}
+		}
+		return true;
+	}
+	case RZ_BASE_TYPE_KIND_ENUM: {
+		if (rz_vector_len(&a->enum_data.cases) != rz_vector_len(&b->enum_data.cases)) {
+			return false;
+		}
+		for (size_t i = 0; i < rz_vector_len(&a->enum_data.cases); i++) {
+			RzTypeEnumCase *ca = rz_vector_index_ptr((RzVector *)&a->enum_data.cases, i);
+			RzTypeEnumCase *cb = rz_vector_index_ptr((RzVector *)&b->enum_data.cases, i);
+			if (rz_str_cmp(ca->name, cb->name, -1) || ca->val != cb->val) {
+				return false;
+			}
+		}
+		return true;
+	}
+	default:
+		return true;
+	}
+}
+
+typedef struct {
+	RzTypeDB *typedb;
+	const char *path;
+	CParserState *state;
+	size_t *anon_counter; ///< Counter for the fresh names of the anonymous types
+	HtPP /*<char *, char *>*/ *renamed; ///< Anonymous types renamed to avoid the clashes
+	HtUP /*<RzCallable *, RzCallable *>*/ *callables_map; ///< Duplicated callables to the ones from the types database
+	RzPVector /*<RzBaseType *>*/ anon_types;
+	RzPVector /*<RzBaseType *>*/ dup_types;
+	RzPVector /*<RzCallable *>*/ dup_callables;
+	RzStrBuf *errors;
+} TypeHeaderMerge;
+
+static bool merge_is_anonymous(const char *name) {
+	return rz_str_startswith(name, "anonymous ");
+}
+
+/**
+ * Generates the name like "anonymous struct 42" that is not used
+ * neither in the types database nor in the header being merged
+ */
+static char *merge_fresh_name(TypeHeaderMerge *m, const char *name, HtPP *db, HtPP *local) {
+	const char *space = strrchr(name, ' ');
+	int prefix_len = space ? (int)(space - name) : (int)strlen(name);
+	while (true) {
+		char *fresh = rz_str_newf("%.*s %zu", prefix_len, name, (*m->anon_counter)++);
+		if (!fresh || (!ht_pp_find_kv(db, fresh, NULL) && !ht_pp_find_kv(local, fresh, NULL))) {
+			return fresh;
+		}
+		free(fresh);
+	}
+}
+
+/**
+ * Points the type to the renamed anonymous types and to the callables
+ * already present in the types database
+ */
+static void merge_fix_type(TypeHeaderMerge *m, RzType *type) {
+	while (type) {
+		switch (type->kind) {
+		case RZ_TYPE_KIND_IDENTIFIER: {
+			const char *fresh = type->identifier.name ? ht_pp_find(m->renamed, type->identifier.name, NULL) : NULL;
+			if (fresh) {
+				free(type->identifier.name);
+				type->identifier.name = strdup(fresh);
+			}
+			return;
+		}
+		case RZ_TYPE_KIND_POINTER:
+			type = type->pointer.type;
+			break;
+		case RZ_TYPE_KIND_ARRAY:
+			type = type->array.type;
+			break;
+		case RZ_TYPE_KIND_CALLABLE: {
+			RzCallable *existing = ht_up_find(m->callables_map, (ut64)(size_t)type->callable, NULL);
+			if (existing) {
+				type->callable = existing;
+			}
+			return;
+		}
+		default:
+			return;
+		}
+	}
+}
+
+static void merge_fix_base_type(TypeHeaderMerge *m, RzBaseType *btype) {
+	merge_fix_type(m, btype->type);
+	if (btype->kind == RZ_BASE_TYPE_KIND_STRUCT) {
+		RzTypeStructMember *member;
+		rz_vector_foreach(&btype->struct_data.members, member) {
+			merge_fix_type(m, member->type);
+		}
+	} else if (btype->kind == RZ_BASE_TYPE_KIND_UNION) {
+		RzTypeUnionMember *member;
+		rz_vector_foreach(&btype->union_data.members, member) {
+			merge_fix_type(m, member->type);
+		}
+	}
+}
+
+static void merge_fix_callable(TypeHeaderMerge *m, RzCallable *callable) {
+	merge_fix_type(m, callable->ret);
+	void **it;
+	if (callable->args) {
+		rz_pvector_foreach (callable->args, it) {
+			RzCallableArg *arg = *it;
+			merge_fix_type(m, arg->type);
+		}
+	}
+}
+
+static bool merge_collect_anonymous_type(void *user, const void *k, const void *v) {
+	TypeHeaderMerge *m = user;
+	RzBaseType *btype = (RzBaseType *)v;
+	RzBaseType *existing = ht_pp_find(m->typedb->types, k, NULL);
+	if (existing && merge_is_anonymous(k) && !base_types_equal(existing, btype)) {
+		rz_pvector_push(&m->anon_types, btype);
+	}
+	return true;
+}
+
+static bool merge_collect_callable(void *user, const void *k, const void *v) {
+	TypeHeaderMerge *m = user;
+	RzCallable *callable = (RzCallable *)v;
+	RzCallable *existing = ht_pp_find(m->typedb->callables, k, NULL);
+	if (!existing) {
+		return true;
+	}
+	bool equal = callables_equal(existing, callable);
+	if (!equal && merge_is_anonymous(k)) {
+		char *fresh = merge_fresh_name(m, k, m->typedb->callables, m->state->callables);
+		if (fresh) {
+			free(callable->name);
+			callable->name = fresh;
+			return true;
+		}
+	}
+	if (!equal) {
+		rz_strbuf_appendf(m->errors, "%s: conflicting declaration of function \"%s\", keeping the previous one\n", m->path, (const char *)k);
+	}
+	ht_up_insert(m->callables_map, (ut64)(size_t)callable, existing);
+	rz_pvector_push(&m->dup_callables, callable);
+	return true;
+}
+
+static bool merge_insert_callable(void *user, const void *k, const void *v) {
+	TypeHeaderMerge *m = user;
+	RzCallable *callable = (RzCallable *)v;
+	if (ht_up_find_kv(m->callables_map, (ut64)(size_t)callable, NULL)) {
+		return true;
+	}
+	merge_fix_callable(m, callable);
+	ht_pp_insert(m->typedb->callables, callable->name, callable);
+	return true;
+}
+
+static bool merge_insert_base_type(void *user, const void *k, const void *v) {
+	TypeHeaderMerge *m = user;
+	RzBaseType *btype = (RzBaseType *)v;
+	merge_fix_base_type(m, btype);
+	RzBaseType *existing = ht_pp_find(m->typedb->types, btype->name, NULL);
+	if (existing) {
+		if (!base_types_equal(existing, btype)) {
+			rz_strbuf_appendf(m->errors, "%s: conflicting definition of type \"%s\", keeping the previous one\n", m->path, btype->name);
+		}
+		rz_pvector_push(&m->dup_types, btype);
+		return true;
+	}
+	ht_pp_insert(m->typedb->types, btype->name, btype);
+	return true;
+}
+
+static void merge_renamed_kv_free(HtPPKv *kv) {
+	free(kv->key);
+	free(kv->value);
+}
+
+/**
+ * Moves the types found in the header into the types database. The types
+ * that are already there win, the structurally equal duplicates are dropped
+ * silently and the differing ones are reported. The anonymous types get
+ * fresh names instead, since the names are generated by every worker independently.
+ */
+static void type_header_job_merge(RzTypeDB *typedb, TypeHeaderJob *job, size_t *anon_counter, RzStrBuf *errors) {
+	if (!job->state) {
+		return;
+	}
+	TypeHeaderMerge m = {
+		.typedb = typedb,
+		.path = job->path,
+		.state = job->state,
+		.anon_counter = anon_counter,
+		.renamed = ht_pp_new(NULL, merge_renamed_kv_free, NULL),
+		.callables_map = ht_up_new0(),
+		.errors = errors,
+	};
+	rz_pvector_init(&m.anon_types, NULL);
+	rz_pvector_init(&m.dup_types, (RzPVectorFree)rz_type_base_type_free);
+	rz_pvector_init(&m.dup_callables, (RzPVectorFree)rz_type_callable_free);
+	ht_pp_foreach(job->state->types, merge_collect_anonymous_type, &m);
+	void **it;
+	rz_pvector_foreach (&m.anon_types, it) {
+		RzBaseType *btype = *it;
+		char *fresh = merge_fresh_name(&m, btype->name, typedb->types, job->state->types);
+		if (!fresh) {
+			continue;
+		}
+		ht_pp_insert(m.renamed, btype->name, strdup(fresh));
+		free(btype->name);
+		btype->name = fresh;
+	}
+	// The callables go first, since the base types might refer to them
+	ht_pp_foreach(job->state->callables, merge_collect_callable, &m);
+	ht_pp_foreach(job->state->callables, merge_insert_callable, &m);
+	ht_pp_foreach(job->state->types, merge_insert_base_type, &m);
+	// The duplicates are freed only now, after no one refers to them anymore
+	rz_pvector_fini(&m.anon_types);
+	rz_pvector_fini(&m.dup_types);
+	rz_pvector_fini(&m.dup_callables);
+	ht_up_free(m.callables_map);
+	ht_pp_free(m.renamed);
+	c_parser_state_free(job->state);
+	job->state = NULL;
+}
+
+/**
+ * \brief Parses the C headers in parallel and loads the types into the types database
+ *
+ * Every header is preprocessed with \p pp and parsed in its own worker
+ * against the read-only view of the types database. The results are merged
+ * in the order of \p paths, so if several headers define the same type
+ * differently, the first definition wins (as does the one already present
+ * in the database) and the conflict is reported in \p error_msg.
+ *
+ * \param typedb RzTypeDB instance
+ * \param pp The preprocessor to use, it's shared by all workers
+ * \param paths Paths of the headers to parse
+ * \param max_threads Maximum number of the threads to use, RZ_THREAD_POOL_ALL_CORES for all of them
+ * \param error_msg A pointer where all error messages will be stored
+ * \return The number of headers that failed to be parsed
+ */
+RZ_API int rz_type_parse_headers(RZ_NONNULL RzTypeDB *typedb, RZ_NONNULL const RzTypePreprocessor *pp, RZ_NONNULL const RzPVector /*<char *>*/ *paths, size_t max_threads, RZ_NULLABLE char **error_msg) {
+	rz_return_val_if_fail(typedb && pp && paths, -1);
+	size_t count = rz_pvector_len(paths);
+	TypeHeaderJob *jobs = RZ_NEWS0(TypeHeaderJob, count);
+	RzPVector *elements = rz_pvector_new(NULL);
+	RzStrBuf *errors = rz_strbuf_new("");
+	if (!elements || !errors || (count && (!jobs || !rz_pvector_reserve(elements, count)))) {
+		free(jobs);
+		rz_pvector_free(elements);
+		rz_strbuf_free(errors);
+		return -1;
+	}
+	for (size_t i = 0; i < count; i++) {
+		jobs[i].path = rz_pvector_at(paths, i);
+		jobs[i].pp = pp;
+		jobs[i].base_types = typedb->types;
+		rz_pvector_push(elements, &jobs[i]);
+	}
+	if (!rz_th_iterate_pvector(elements, type_header_job_parse, max_threads, NULL)) {
+		// Fall back to parsing everything on this thread
+		for (size_t i = 0; i < count; i++) {
+			if (!jobs[i].state && !jobs[i].failed) {
+				type_header_job_parse(&jobs[i], NULL);
+			}
+		}
+	}
+	int failed = 0;
+	size_t anon_counter = 0;
+	for (size_t i = 0; i < count; i++) {
+		TypeHeaderJob *job = &jobs[i];
+		if (job->error_msg) {
+			rz_strbuf_append(errors, job->error_msg);
+			free(job->error_msg);
+		}
+		failed += job->failed ? 1 : 0;
+		// Even the headers with errors might contain some valid types
+		type_header_job_merge(typedb, job, &anon_counter, errors);
+	}
+	if (rz_strbuf_length(errors)) {
+		RZ_LOG_DEBUG("%s", rz_strbuf_get(errors));
+		if (error_msg) {
+			*error_msg = rz_strbuf_drain_nofree(errors);
+		}
+	}
+	rz_strbuf_free(errors);
+	rz_pvector_free(elements);
+	free(jobs);
+	return failed;
+}
+
 /**
  * \brief Reset the C parser state
  *
@@ -301,23 +709,36 @@ RZ_API void rz_type_parse_reset(RzTypeDB *typedb) {
 	typedb->parser = rz_type_parser_new();
 }
 
-/**
- * \brief Parses the single C type definition
- *
- * \param parser RzTypeParser parser instance
- * \param code The C type itself
- * \param error_msg A pointer where all error messages will be stored
- */
-RZ_API RZ_OWN RzType *rz_type_parse_string_single(RzTypeParser *parser, const char *code, char **error_msg) {
-	rz_return_val_if_fail(parser && code, NULL);
-	if (error_msg) {
-		*error_msg = NULL;
+static void type_parse_report(CParserState *state, bool failed, char **error_msg) {
+	// If there were errors during the parser then the result is different from 0
+	if (failed) {
+		char *error_msgs = rz_strbuf_drain_nofree(state->errors);
+		RZ_LOG_DEBUG("Errors:\n");
+		RZ_LOG_DEBUG("%s", error_msgs);
+		char *warning_msgs = rz_strbuf_drain_nofree(state->warnings);
+		RZ_LOG_DEBUG("Warnings:\n");
+		RZ_LOG_DEBUG("%s", warning_msgs);
+		if (error_msg) {
+			*error_msg = strdup(error_msgs);
+		}
+		free(error_msgs);
+		free(warning_msgs);
 	}
-	// Create a parser.
-	TSParser *tsparser = ts_parser_new();
-	// Set the parser's language (C in this case)
-	ts_parser_set_language(tsparser, tree_sitter_c());
+	if (state->verbose) {
+		char *debug_msgs = rz_strbuf_drain_nofree(state->debug);
+		RZ_LOG_DEBUG("%s", debug_msgs);
+		free(debug_msgs);
+	}
+	// After everything parsed, we should preserve the base type database
+	// Also we don't free the parser state, just reset the buffers for new use
+	c_parser_state_reset_keep_ht(state);
+}
 
+static RzType *type_parse_string_single_ts(RzTypeParser *parser, const char *code, char **error_msg) {
+	TSParser *tsparser = type_parser_ts_get(parser);
+	if (!tsparser) {
+		return NULL;
+	}
 	// Note, that the original C grammar doesn't have support for alternate roots,
 	// see:
 	// - https://github.com/tree-sitter/tree-sitter-c/issues/65
@@ -325,9 +746,12 @@ RZ_API RZ_OWN RzType *rz_type_parse_string_single(RzTypeParser *parser, const ch
 	// Thus, we use our own patched C grammar that has an additional rule
 	// for type descriptor, but we use the `__TYPE_EXPRESSION` prefix for every
 	// such type descriptor expression.
-	char *patched_code = rz_str_newf("__TYPE_EXPRESSION %s", code);
+	if (!rz_strbuf_setf(parser->expr, "__TYPE_EXPRESSION %s", code)) {
+		return NULL;
+	}
+	const char *patched_code = rz_strbuf_get(parser->expr);
 
-	TSTree *tree = ts_parser_parse_string(tsparser, NULL, patched_code, strlen(patched_code));
+	TSTree *tree = ts_parser_parse_string(tsparser, NULL, patched_code, rz_strbuf_length(parser->expr));
 
 	// Get the root node of the syntax tree.
 	TSNode root_node = ts_tree_root_node(tree);
@@ -335,8 +759,6 @@ RZ_API RZ_OWN RzType *rz_type_parse_string_single(RzTypeParser *parser, const ch
 	if (!root_node_child_count) {
 		parser_warning(parser->state, "Root node is empty!\n");
 		ts_tree_delete(tree);
-		ts_parser_delete(tsparser);
-		free(patched_code);
 		return NULL;
 	}
 
@@ -351,18 +773,8 @@ RZ_API RZ_OWN RzType *rz_type_parse_string_single(RzTypeParser *parser, const ch
 		free(string);
 	}
 
-	// At first step we should handle defines
-	// #define
-	// #if / #ifdef
-	// #else
-	// #endif
-	// After that, we should process include files and #error/#warning/#pragma
-	// Temporarily we could just run preprocessing step using tccpp code
-	//
-	// And only after that - run the normal C/C++ syntax parsing
-
 	// Filter types function prototypes and start parsing
-	int i = 0, result = 0;
+	int i = 0;
 	ParserTypePair *tpair = NULL;
 	for (i = 0; i < root_node_child_count; i++) {
 		parser_debug(parser->state, "Processing %d child...\n", i);
@@ -372,37 +784,44 @@ RZ_API RZ_OWN RzType *rz_type_parse_string_single(RzTypeParser *parser, const ch
 		}
 	}
 
-	// If there were errors during the parser then the result is different from 0
-	if (result || !tpair) {
-		char *error_msgs = rz_strbuf_drain_nofree(parser->state->errors);
-		RZ_LOG_DEBUG("Errors:\n");
-		RZ_LOG_DEBUG("%s", error_msgs);
-		char *warning_msgs = rz_strbuf_drain_nofree(parser->state->warnings);
-		RZ_LOG_DEBUG("Warnings:\n");
-		RZ_LOG_DEBUG("%s", warning_msgs);
-		if (error_msg) {
-			*error_msg = strdup(error_msgs);
-		}
-		free(error_msgs);
-		free(warning_msgs);
-	}
-	if (parser->state->verbose) {
-		char *debug_msgs = rz_strbuf_drain_nofree(parser->state->debug);
-		RZ_LOG_DEBUG("%s", debug_msgs);
-		free(debug_msgs);
-	}
-
-	// After everything parsed, we should preserve the base type database
-	// Also we don't free the parser state, just reset the buffers for new use
-	c_parser_state_reset_keep_ht(parser->state);
+	type_parse_report(parser->state, !tpair, error_msg);
 	ts_tree_delete(tree);
-	ts_parser_delete(tsparser);
-	free(patched_code);
 	RzType *ret = tpair ? tpair->type : NULL;
 	free(tpair);
 	return ret;
 }
 
+/**
+ * \brief Parses the single C type definition
+ *
+ * Simple type expressions referring to the already known types (e.g. "const char *",
+ * "struct foo *[4]") are parsed directly, everything else goes through the full C parser.
+ * The results are cached by the type string and reused as long as the types
+ * they refer to are not redefined.
+ *
+ * \param parser RzTypeParser parser instance
+ * \param code The C type itself
+ * \param error_msg A pointer where all error messages will be stored
+ */
+RZ_API RZ_OWN RzType *rz_type_parse_string_single(RzTypeParser *parser, const char *code, char **error_msg) {
+	rz_return_val_if_fail(parser && code, NULL);
+	if (error_msg) {
+		*error_msg = NULL;
+	}
+	RzType *type = c_parser_type_expression_cache_get(parser->state, parser->expr_cache, code);
+	if (type) {
+		return type;
+	}
+	type = c_parser_type_expression_fast(parser->state, code);
+	if (!type) {
+		type = type_parse_string_single_ts(parser, code, error_msg);
+	}
+	if (type) {
+		c_parser_type_expression_cache_put(parser->state, parser->expr_cache, code, type);
+	}
+	return type;
+}
+
 /**
  * \brief Parses the single C type declaration
  *
@@ -414,10 +833,10 @@ RZ_API RZ_OWN RzType *rz_type_parse_string_declaration_single(RzTypeParser *pars
 	if (error_msg) {
 		*error_msg = NULL;
 	}
-	// Create a parser.
-	TSParser *tsparser = ts_parser_new();
-	// Set the parser's language (C in this case)
-	ts_parser_set_language(tsparser, tree_sitter_c());
+	TSParser *tsparser = type_parser_ts_get(parser);
+	if (!tsparser) {
+		return NULL;
+	}
 
 	TSTree *tree = ts_parser_parse_string(tsparser, NULL, code, strlen(code));
 
@@ -427,7 +846,6 @@ RZ_API RZ_OWN RzType *rz_type_parse_string_declaration_single(RzTypeParser *pars
 	if (!root_node_child_count) {
 		parser_warning(parser->state, "Root node is empty!\n");
 		ts_tree_delete(tree);
-		ts_parser_delete(tsparser);
 		return NULL;
 	}
 
@@ -441,18 +859,8 @@ RZ_API RZ_OWN RzType *rz_type_parse_string_declaration_single(RzTypeParser *pars
 		free(string);
 	}
 
-	// At first step we should handle defines
-	// #define
-	// #if / #ifdef
-	// #else
-	// #endif
-	// After that, we should process include files and #error/#warning/#pragma
-	// Temporarily we could just run preprocessing step using tccpp code
-	//
-	// And only after that - run the normal C/C++ syntax parsing
-
 	// Filter types function prototypes and start parsing
-	int i = 0, result = 0;
+	int i = 0;
 	ParserTypePair *tpair = NULL;
 	for (i = 0; i < root_node_child_count; i++) {
 		parser_debug(parser->state, "Processing %d child...\n", i);
@@ -462,30 +870,9 @@ RZ_API RZ_OWN RzType *rz_type_parse_string_declaration_single(RzTypeParser *pars
 		}
 	}
 
-	// If there were errors during the parser then the result is different from 0
-	if (result || !tpair) {
-		char *error_msgs = rz_strbuf_drain_nofree(parser->state->errors);
-		RZ_LOG_DEBUG("Errors:\n");
-		RZ_LOG_DEBUG("%s", error_msgs);
-		char *warning_msgs = rz_strbuf_drain_nofree(parser->state->warnings);
-		RZ_LOG_DEBUG("Warnings:\n");
-		RZ_LOG_DEBUG("%s", warning_msgs);
-		if (error_msg) {
-			*error_msg = strdup(error_msgs);
-		}
-		free(error_msgs);
-		free(warning_msgs);
-	}
-	if (parser->state->verbose) {
-		char *debug_msgs = rz_strbuf_drain_nofree(parser->state->debug);
-		RZ_LOG_DEBUG("%s", debug_msgs);
-		free(debug_msgs);
-	}
-
-	// After everything parsed, we should preserve the base type database
-	// Also we don't free the parser state, just reset the buffers for new use
-	c_parser_state_reset_keep_ht(parser->state);
+	type_parse_report(parser->state, !tpair, error_msg);
 	ts_tree_delete(tree);
-	ts_parser_delete(tsparser);
-	return tpair ? tpair->type : NULL;
+	RzType *ret = tpair ? tpair->type : NULL;
+	free(tpair);
+	return ret;
 }
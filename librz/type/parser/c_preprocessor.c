@@ -0,0 +1,1865 @@
+// SPDX-FileCopyrightText: 2023 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_types.h>
+#include <rz_list.h>
+#include <rz_vector.h>
+#include <rz_util.h>
+#include <rz_type.h>
+
+/**
+ * \file c_preprocessor.c
+ * Simple C preprocessor used for loading real-world headers into the types database.
+ *
+ * Supports `#include` with search paths, object-like and function-like macros
+ * (including stringification, token pasting and variadic arguments),
+ * conditional compilation and `#pragma once`. Macro expansion follows
+ * the classic hide set algorithm by Dave Prosser.
+ */
+
+#define PP_MAX_INCLUDE_DEPTH 200
+
+typedef struct {
+	char *name;
+	bool function_like;
+	bool variadic;
+	RzPVector /*<char *>*/ params;
+	RzVector /*<PPToken>*/ body;
+} PPMacro;
+
+struct rz_type_preprocessor_t {
+	HtPP /*<char *, PPMacro *>*/ *macros;
+	RzPVector /*<char *>*/ include_dirs;
+};
+
+typedef enum {
+	PP_TOKEN_IDENT,
+	PP_TOKEN_NUMBER,
+	PP_TOKEN_STRING,
+	PP_TOKEN_PUNCT,
+	PP_TOKEN_SPACE,
+	PP_TOKEN_NEWLINE,
+	PP_TOKEN_PLACEMARKER, ///< Empty argument in the token pasting
+} PPTokenKind;
+
+/**
+ * Immutable list of macro names, shared between the tokens
+ */
+typedef struct pp_hideset_t {
+	const char *name;
+	struct pp_hideset_t *next;
+} PPHideSet;
+
+typedef struct {
+	PPTokenKind kind;
+	char *text;
+	PPHideSet *hs;
+} PPToken;
+
+typedef struct {
+	bool parent_active; ///< Whether the enclosing block is active
+	bool active; ///< Whether the current branch is active
+	bool taken; ///< Whether any of the branches was taken already
+	bool seen_else;
+} PPCond;
+
+typedef struct {
+	const RzTypePreprocessor *pp;
+	HtPP /*<char *, PPMacro *>*/ *macros; ///< Macros (re)defined during the run, NULL value means #undef
+	HtPP /*<char *, void *>*/ *once; ///< Files with `#pragma once`
+	RzPVector /*<PPHideSet *>*/ hidesets; ///< All allocated hide set nodes
+	RzStrBuf *out;
+	RzStrBuf *errors;
+	RzStrBuf *warnings;
+	bool failed;
+	int depth;
+} PPContext;
+
+typedef struct {
+	const char *path; ///< Path of the file being processed, NULL for strings
+	const char *dir; ///< Directory of the file being processed
+	const char *once_key; ///< Absolute path of the file for `#pragma once`
+	int dir_index; ///< Index of the include directory where the file was found, -1 otherwise
+	int line;
+} PPFile;
+
+static void pp_token_fini(void *e, void *user) {
+	PPToken *tok = e;
+	free(tok->text);
+}
+
+static void pp_token_vector_fini(void *e, void *user) {
+	rz_vector_fini(e);
+}
+
+static void pp_macro_free(PPMacro *macro) {
+	if (!macro) {
+		return;
+	}
+	free(macro->name);
+	rz_pvector_fini(&macro->params);
+	rz_vector_fini(&macro->body);
+	free(macro);
+}
+
+static void pp_macro_kv_free(HtPPKv *kv) {
+	free(kv->key);
+	pp_macro_free(kv->value);
+}
+
+static void pp_vector_init(RzVector *vec) {
+	rz_vector_init(vec, sizeof(PPToken), pp_token_fini, NULL);
+}
+
+static bool pp_push(RzVector *vec, PPTokenKind kind, const char *text, size_t len, PPHideSet *hs) {
+	PPToken tok = { .kind = kind, .text = rz_str_ndup(text, len), .hs = hs };
+	if (!tok.text || !rz_vector_push(vec, &tok)) {
+		free(tok.text);
+		return false;
+	}
+	return true;
+}
+
+static bool pp_push_copy(RzVector *vec, const PPToken *tok) {
+	return pp_push(vec, tok->kind, tok->text, strlen(tok->text), tok->hs);
+}
+
+static bool pp_is_ident_start(char c) {
+	return IS_UPPER(c) || IS_LOWER(c) || c == '_' || c == '$';
+}
+
+static bool pp_is_ident_char(char c) {
+	return pp_is_ident_start(c) || IS_DIGIT(c);
+}
+
+static const char *pp_punctuators[] = {
+	"...", "<<=", ">>=", "##", "->", "++", "--", "<<", ">>", "<=", ">=", "==", "!=",
+	"&&", "||", "+=", "-=", "*=", "/=", "%=", "&=", "|=", "^=", "::"
+};
+
+/**
+ * Splits the preprocessed line (without comments) into tokens
+ */
+static bool pp_tokenize(const char *s, size_t len, RzVector *out) {
+	const char *end = s + len;
+	while (s < end) {
+		const char *start = s;
+		char c = *s;
+		if (c == '\n') {
+			if (!pp_push(out, PP_TOKEN_NEWLINE, s, 1, NULL)) {
+				return false;
+			}
+			s++;
+			continue;
+		}
+		if (IS_WHITESPACE(c) || c == '\r' || c == '\f' || c == '\v') {
+			while (s < end && (IS_WHITESPACE(*s) || *s == '\r' || *s == '\f' || *s == '\v')) {
+				s++;
+			}
+			if (!pp_push(out, PP_TOKEN_SPACE, " ", 1, NULL)) {
+				return false;
+			}
+			continue;
+		}
+		PPTokenKind kind = PP_TOKEN_PUNCT;
+		// Encoding prefixes of the literals: L'x', u"x", U"x", u8"x"
+		size_t prefix = 0;
+		if (c == 'L' || c == 'U' || c == 'u') {
+			prefix = c == 'u' && s + 1 < end && s[1] == '8' ? 2 : 1;
+			if (s + prefix >= end || (s[prefix] != '"' && s[prefix] != '\'')) {
+				prefix = 0;
+			}
+		}
+		if (prefix) {
+			s += prefix;
+			c = *s;
+		}
+		if (!prefix && pp_is_ident_start(c)) {
+			while (s < end && pp_is_ident_char(*s)) {
+				s++;
+			}
+			kind = PP_TOKEN_IDENT;
+		} else if (IS_DIGIT(c) || (c == '.' && s + 1 < end && IS_DIGIT(s[1]))) {
+			// pp-number
+			s++;
+			while (s < end) {
+				if ((*s == '+' || *s == '-') && strchr("eEpP", s[-1])) {
+					s++;
+				} else if (pp_is_ident_char(*s) || *s == '.') {
+					s++;
+				} else {
+					break;
+				}
+			}
+			kind = PP_TOKEN_NUMBER;
+		} else if (c == '"' || c == '\'') {
+			s++;
+			while (s < end && *s != c && *s != '\n') {
+				if (*s == '\\' && s + 1 < end) {
+					s++;
+				}
+				s++;
+			}
+			if (s < end && *s == c) {
+				s++;
+			}
+			kind = PP_TOKEN_STRING;
+		} else {
+			size_t plen = 1;
+			for (size_t i = 0; i < RZ_ARRAY_SIZE(pp_punctuators); i++) {
+				size_t l = strlen(pp_punctuators[i]);
+				if (s + l <= end && !strncmp(s, pp_punctuators[i], l)) {
+					plen = l;
+					break;
+				}
+			}
+			s += plen;
+		}
+		if (!pp_push(out, kind, start, s - start, NULL)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool pp_tok_is(const PPToken *tok, const char *text) {
+	return tok->kind == PP_TOKEN_PUNCT && !strcmp(tok->text, text);
+}
+
+static bool pp_is_blank(const PPToken *tok) {
+	return tok->kind == PP_TOKEN_SPACE || tok->kind == PP_TOKEN_NEWLINE;
+}
+
+/**
+ * Removes the comments and joins the lines ending with backslash.
+ * Block comments are replaced by a single space.
+ */
+static char *pp_clean_source(const char *code) {
+	size_t len = strlen(code);
+	char *out = malloc(len + 1);
+	if (!out) {
+		return NULL;
+	}
+	const char *s = code;
+	char *o = out;
+	char quote = 0;
+	while (*s) {
+		if (s[0] == '\\' && (s[1] == '\n' || (s[1] == '\r' && s[2] == '\n'))) {
+			s += s[1] == '\r' ? 3 : 2;
+			continue;
+		}
+		if (quote) {
+			if (*s == '\\' && s[1]) {
+				*o++ = *s++;
+			} else if (*s == quote || *s == '\n') {
+				quote = 0;
+			}
+			*o++ = *s++;
+			continue;
+		}
+		if (*s == '"' || *s == '\'') {
+			quote = *s;
+			*o++ = *s++;
+			continue;
+		}
+		if (s[0] == '/' && s[1] == '*') {
+			s += 2;
+			while (*s && !(s[0] == '*' && s[1] == '/')) {
+				s++;
+			}
+			s += *s ? 2 : 0;
+			*o++ = ' ';
+			continue;
+		}
+		if (s[0] == '/' && s[1] == '/') {
+			while (*s && *s != '\n') {
+				if (s[0] == '\\' && s[1] == '\n') {
+					s++;
+				}
+				s++;
+			}
+			continue;
+		}
+		*o++ = *s++;
+	}
+	*o = '\0';
+	return out;
+}
+
+// Macros
+
+static PPMacro *pp_macro_new(const char *name) {
+	PPMacro *macro = RZ_NEW0(PPMacro);
+	if (!macro) {
+		return NULL;
+	}
+	macro->name = strdup(name);
+	rz_pvector_init(&macro->params, free);
+	pp_vector_init(&macro->body);
+	if (!macro->name) {
+		pp_macro_free(macro);
+		return NULL;
+	}
+	return macro;
+}
+
+static void pp_trim_tokens(RzVector *tokens) {
+	size_t n = 0;
+	while (n < rz_vector_len(tokens) && pp_is_blank(rz_vector_index_ptr(tokens, n))) {
+		PPToken *tok = rz_vector_index_ptr(tokens, n);
+		free(tok->text);
+		n++;
+	}
+	if (n) {
+		rz_vector_remove_range(tokens, 0, n, NULL);
+	}
+	while (!rz_vector_empty(tokens) && pp_is_blank(rz_vector_tail(tokens))) {
+		PPToken tok;
+		rz_vector_pop(tokens, &tok);
+		free(tok.text);
+	}
+}
+
+/**
+ * Parses the macro definition in the form used by `#define`,
+ * e.g. "NAME value" or "NAME(a, b) a + b"
+ */
+static PPMacro *pp_macro_parse(const char *def) {
+	const char *p = def;
+	while (IS_WHITESPACE(*p)) {
+		p++;
+	}
+	const char *name_start = p;
+	if (!pp_is_ident_start(*p)) {
+		return NULL;
+	}
+	while (pp_is_ident_char(*p)) {
+		p++;
+	}
+	char *name = rz_str_ndup(name_start, p - name_start);
+	PPMacro *macro = name ? pp_macro_new(name) : NULL;
+	free(name);
+	if (!macro) {
+		return NULL;
+	}
+	if (*p == '(') {
+		// Function-like macro only if there is no space between the name and the parenthesis
+		macro->function_like = true;
+		p++;
+		while (true) {
+			while (IS_WHITESPACE(*p)) {
+				p++;
+			}
+			if (*p == ')') {
+				p++;
+				break;
+			}
+			if (!strncmp(p, "...", 3)) {
+				macro->variadic = true;
+				rz_pvector_push(&macro->params, strdup("__VA_ARGS__"));
+				p += 3;
+			} else if (pp_is_ident_start(*p)) {
+				const char *pstart = p;
+				while (pp_is_ident_char(*p)) {
+					p++;
+				}
+				char *param = rz_str_ndup(pstart, p - pstart);
+				if (!param) {
+					goto fail;
+				}
+				rz_pvector_push(&macro->params, param);
+				while (IS_WHITESPACE(*p)) {
+					p++;
+				}
+				// GNU named variadic arguments: "args..."
+				if (!strncmp(p, "...", 3)) {
+					macro->variadic = true;
+					p += 3;
+				}
+			} else {
+				goto fail;
+			}
+			while (IS_WHITESPACE(*p)) {
+				p++;
+			}
+			if (*p == ',') {
+				p++;
+			} else if (*p != ')') {
+				goto fail;
+			}
+		}
+	}
+	if (!pp_tokenize(p, strlen(p), &macro->body)) {
+		goto fail;
+	}
+	pp_trim_tokens(&macro->body);
+	return macro;
+fail:
+	pp_macro_free(macro);
+	return NULL;
+}
+
+static PPMacro *pp_macro_find(PPContext *ctx, const char *name) {
+	bool found = false;
+	PPMacro *macro = ht_pp_find(ctx->macros, name, &found);
+	if (found) {
+		return macro;
+	}
+	return ht_pp_find(ctx->pp->macros, name, NULL);
+}
+
+static int pp_macro_param_index(const PPMacro *macro, const PPToken *tok) {
+	if (tok->kind != PP_TOKEN_IDENT || !macro->function_like) {
+		return -1;
+	}
+	for (size_t i = 0; i < rz_pvector_len(&macro->params); i++) {
+		if (!strcmp(rz_pvector_at(&macro->params, i), tok->text)) {
+			return (int)i;
+		}
+	}
+	return -1;
+}
+
+// Hide sets
+
+static bool pp_hideset_contains(const PPHideSet *hs, const char *name) {
+	for (; hs; hs = hs->next) {
+		if (!strcmp(hs->name, name)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static PPHideSet *pp_hideset_add(PPContext *ctx, PPHideSet *hs, const char *name) {
+	if (pp_hideset_contains(hs, name)) {
+		return hs;
+	}
+	PPHideSet *node = RZ_NEW0(PPHideSet);
+	if (!node) {
+		return hs;
+	}
+	node->name = strdup(name);
+	node->next = hs;
+	if (!node->name || !rz_pvector_push(&ctx->hidesets, node)) {
+		free((char *)node->name);
+		free(node);
+		return hs;
+	}
+	return node;
+}
+
+static PPHideSet *pp_hideset_intersect(PPContext *ctx, const PPHideSet *a, const PPHideSet *b) {
+	PPHideSet *r = NULL;
+	for (; a; a = a->next) {
+		if (pp_hideset_contains(b, a->name)) {
+			r = pp_hideset_add(ctx, r, a->name);
+		}
+	}
+	return r;
+}
+
+static PPHideSet *pp_hideset_union(PPContext *ctx, PPHideSet *a, const PPHideSet *b) {
+	for (; b; b = b->next) {
+		a = pp_hideset_add(ctx, a, b->name);
+	}
+	return a;
+}
+
+static void pp_hideset_free(void *e) {
+	PPHideSet *hs = e;
+	free((char *)hs->name);
+	free(hs);
+}
+
+// Macro expansion
+
+static bool pp_expand(PPContext *ctx, const PPFile *file, RzVector *in, RzVector *out);
+
+/**
+ * Finds the arguments of the function-like macro invocation on the \p stack.
+ * The stack top is the last element. On success the indices of the argument
+ * tokens are stored in \p args as (start, end) pairs and the index
+ * of the closing parenthesis is returned, otherwise -1.
+ */
+static st64 pp_find_args(const RzVector *stack, RzVector /*<size_t>*/ *args) {
+	st64 i = (st64)rz_vector_len(stack) - 1;
+	while (i >= 0 && pp_is_blank(rz_vector_index_ptr((RzVector *)stack, i))) {
+		i--;
+	}
+	if (i < 0 || !pp_tok_is(rz_vector_index_ptr((RzVector *)stack, i), "(")) {
+		return -1;
+	}
+	i--;
+	int depth = 0;
+	size_t arg_start = i;
+	for (; i >= 0; i--) {
+		PPToken *tok = rz_vector_index_ptr((RzVector *)stack, i);
+		if (pp_tok_is(tok, "(")) {
+			depth++;
+		} else if (pp_tok_is(tok, ")")) {
+			if (!depth) {
+				size_t range[2] = { arg_start, i };
+				rz_vector_push(args, &range);
+				return i;
+			}
+			depth--;
+		} else if (pp_tok_is(tok, ",") && !depth) {
+			size_t range[2] = { arg_start, i };
+			rz_vector_push(args, &range);
+			arg_start = i - 1;
+		}
+	}
+	return -1;
+}
+
+/**
+ * Copies the tokens of the argument from the stack (stored in reverse order)
+ */
+static void pp_arg_tokens(const RzVector *stack, size_t start, size_t end, RzVector *out) {
+	// start is the topmost (first) token, end is the delimiter
+	for (st64 i = (st64)start; i > (st64)end; i--) {
+		PPToken *tok = rz_vector_index_ptr((RzVector *)stack, i);
+		if (tok->kind == PP_TOKEN_NEWLINE) {
+			pp_push(out, PP_TOKEN_SPACE, " ", 1, tok->hs);
+		} else {
+			pp_push_copy(out, tok);
+		}
+	}
+	pp_trim_tokens(out);
+}
+
+static bool pp_stringify(const RzVector *arg, RzVector *out) {
+	RzStrBuf sb;
+	rz_strbuf_init(&sb);
+	rz_strbuf_append(&sb, "\"");
+	PPToken *tok;
+	rz_vector_foreach(arg, tok) {
+		if (tok->kind == PP_TOKEN_STRING) {
+			for (const char *c = tok->text; *c; c++) {
+				if (*c == '"' || *c == '\\') {
+					rz_strbuf_append_n(&sb, "\\", 1);
+				}
+				rz_strbuf_append_n(&sb, c, 1);
+			}
+		} else {
+			rz_strbuf_append(&sb, tok->text);
+		}
+	}
+	rz_strbuf_append(&sb, "\"");
+	bool ret = pp_push(out, PP_TOKEN_STRING, rz_strbuf_get(&sb), rz_strbuf_length(&sb), NULL);
+	rz_strbuf_fini(&sb);
+	return ret;
+}
+
+static size_t pp_next_nonblank(const RzVector *tokens, size_t i) {
+	while (i < rz_vector_len(tokens) && pp_is_blank(rz_vector_index_ptr((RzVector *)tokens, i))) {
+		i++;
+	}
+	return i;
+}
+
+static void pp_pop_blank(RzVector *tokens) {
+	while (!rz_vector_empty(tokens) && pp_is_blank(rz_vector_tail(tokens))) {
+		PPToken tok;
+		rz_vector_pop(tokens, &tok);
+		free(tok.text);
+	}
+}
+
+static void pp_append_arg(RzVector *out, const RzVector *arg) {
+	if (rz_vector_empty(arg)) {
+		pp_push(out, PP_TOKEN_PLACEMARKER, "", 0, NULL);
+		return;
+	}
+	PPToken *tok;
+	rz_vector_foreach(arg, tok) {
+		pp_push_copy(out, tok);
+	}
+}
+
+/**
+ * Substitutes the parameters in the macro body, applies `#` and `##` operators
+ */
+static bool pp_substitute(PPContext *ctx, const PPFile *file, const PPMacro *macro, RzVector /*<RzVector>*/ *args, PPHideSet *hs, RzVector *out) {
+	size_t nparams = rz_pvector_len(&macro->params);
+	RzVector *expanded = nparams ? RZ_NEWS0(RzVector, nparams) : NULL;
+	if (nparams && !expanded) {
+		return false;
+	}
+	bool *is_expanded = nparams ? RZ_NEWS0(bool, nparams) : NULL;
+	const RzVector *body = &macro->body;
+	size_t i = 0;
+	bool ret = true;
+	while (i < rz_vector_len(body)) {
+		PPToken *tok = rz_vector_index_ptr((RzVector *)body, i);
+		if (macro->function_like && pp_tok_is(tok, "#")) {
+			size_t n = pp_next_nonblank(body, i + 1);
+			int idx = n < rz_vector_len(body) ? pp_macro_param_index(macro, rz_vector_index_ptr((RzVector *)body, n)) : -1;
+			if (idx >= 0) {
+				pp_stringify(rz_vector_index_ptr(args, idx), out);
+				i = n + 1;
+				continue;
+			}
+		}
+		if (pp_tok_is(tok, "##")) {
+			size_t n = pp_next_nonblank(body, i + 1);
+			pp_pop_blank(out);
+			if (n >= rz_vector_len(body) || rz_vector_empty(out)) {
+				i = n;
+				continue;
+			}
+			PPToken *rtok = rz_vector_index_ptr((RzVector *)body, n);
+			int idx = pp_macro_param_index(macro, rtok);
+			RzVector right;
+			pp_vector_init(&right);
+			if (idx >= 0) {
+				RzVector *arg = rz_vector_index_ptr(args, idx);
+				PPToken *left = rz_vector_tail(out);
+				if (macro->variadic && (size_t)idx == nparams - 1 && pp_tok_is(left, ",")) {
+					// GNU extension: ", ## __VA_ARGS__" swallows the comma if there are no arguments
+					if (rz_vector_empty(arg)) {
+						PPToken tmp;
+						rz_vector_pop(out, &tmp);
+						free(tmp.text);
+					} else {
+						pp_append_arg(out, arg);
+					}
+					rz_vector_fini(&right);
+					i = n + 1;
+					continue;
+				}
+				pp_append_arg(&right, arg);
+			} else {
+				pp_push_copy(&right, rtok);
+			}
+			// Paste the last token of the left side and the first one of the right side
+			PPToken left;
+			rz_vector_pop(out, &left);
+			PPToken *first = rz_vector_head(&right);
+			char *pasted = rz_str_newf("%s%s", left.text, first->text);
+			free(left.text);
+			if (pasted && *pasted) {
+				pp_tokenize(pasted, strlen(pasted), out);
+			} else {
+				pp_push(out, PP_TOKEN_PLACEMARKER, "", 0, NULL);
+			}
+			free(pasted);
+			for (size_t k = 1; k < rz_vector_len(&right); k++) {
+				pp_push_copy(out, rz_vector_index_ptr(&right, k));
+			}
+			rz_vector_fini(&right);
+			i = n + 1;
+			continue;
+		}
+		int idx = pp_macro_param_index(macro, tok);
+		if (idx >= 0) {
+			RzVector *arg = rz_vector_index_ptr(args, idx);
+			size_t n = pp_next_nonblank(body, i + 1);
+			if (n < rz_vector_len(body) && pp_tok_is(rz_vector_index_ptr((RzVector *)body, n), "##")) {
+				// Operands of the token pasting are not macro-expanded
+				pp_append_arg(out, arg);
+			} else {
+				if (!is_expanded[idx]) {
+					RzVector tmp;
+					pp_vector_init(&tmp);
+					pp_vector_init(&expanded[idx]);
+					PPToken *atok;
+					rz_vector_foreach_prev(arg, atok) {
+						pp_push_copy(&tmp, atok);
+					}
+					ret &= pp_expand(ctx, file, &tmp, &expanded[idx]);
+					rz_vector_fini(&tmp);
+					is_expanded[idx] = true;
+				}
+				PPToken *etok;
+				rz_vector_foreach(&expanded[idx], etok) {
+					pp_push_copy(out, etok);
+				}
+			}
+			i++;
+			continue;
+		}
+		pp_push_copy(out, tok);
+		i++;
+	}
+	for (size_t k = 0; k < nparams; k++) {
+		if (is_expanded[k]) {
+			rz_vector_fini(&expanded[k]);
+		}
+	}
+	free(expanded);
+	free(is_expanded);
+	// Drop the placemarkers and extend the hide sets
+	for (size_t k = 0; k < rz_vector_len(out);) {
+		PPToken *otok = rz_vector_index_ptr(out, k);
+		if (otok->kind == PP_TOKEN_PLACEMARKER) {
+			free(otok->text);
+			rz_vector_remove_at(out, k, NULL);
+			continue;
+		}
+		otok->hs = pp_hideset_union(ctx, hs, otok->hs);
+		k++;
+	}
+	return ret;
+}
+
+static bool pp_expand_builtin(PPContext *ctx, const PPFile *file, const PPToken *tok, RzVector *out) {
+	if (!strcmp(tok->text, "__FILE__")) {
+		char *s = rz_str_newf("\"%s\"", file->path ? file->path : "<string>");
+		if (s) {
+			pp_push(out, PP_TOKEN_STRING, s, strlen(s), NULL);
+		}
+		free(s);
+		return true;
+	} else if (!strcmp(tok->text, "__LINE__")) {
+		char *s = rz_str_newf("%d", file->line);
+		if (s) {
+			pp_push(out, PP_TOKEN_NUMBER, s, strlen(s), NULL);
+		}
+		free(s);
+		return true;
+	}
+	return false;
+}
+
+/**
+ * Expands all macros in the tokens. \p in is used as a stack
+ * and contains the tokens in the reverse order, it's consumed.
+ */
+static bool pp_expand(PPContext *ctx, const PPFile *file, RzVector *in, RzVector *out) {
+	bool ret = true;
+	RzVector args_ranges;
+	rz_vector_init(&args_ranges, sizeof(size_t) * 2, NULL, NULL);
+	while (!rz_vector_empty(in)) {
+		PPToken tok;
+		rz_vector_pop(in, &tok);
+		if (tok.kind != PP_TOKEN_IDENT || pp_hideset_contains(tok.hs, tok.text)) {
+			rz_vector_push(out, &tok);
+			continue;
+		}
+		PPMacro *macro = pp_macro_find(ctx, tok.text);
+		if (!macro) {
+			if (!pp_expand_builtin(ctx, file, &tok, out)) {
+				rz_vector_push(out, &tok);
+			} else {
+				free(tok.text);
+			}
+			continue;
+		}
+		PPHideSet *hs = tok.hs;
+		RzVector args;
+		rz_vector_init(&args, sizeof(RzVector), pp_token_vector_fini, NULL);
+		if (macro->function_like) {
+			rz_vector_clear(&args_ranges);
+			st64 close = pp_find_args(in, &args_ranges);
+			if (close < 0) {
+				// Not an invocation
+				rz_vector_push(out, &tok);
+				rz_vector_fini(&args);
+				continue;
+			}
+			size_t nparams = rz_pvector_len(&macro->params);
+			size_t nargs = rz_vector_len(&args_ranges);
+			if (macro->variadic && nargs > nparams) {
+				// The variadic argument takes all the remaining ones, including the commas
+				size_t *first = rz_vector_index_ptr(&args_ranges, nparams - 1);
+				size_t *last = rz_vector_tail(&args_ranges);
+				first[1] = last[1];
+				args_ranges.len = nparams;
+				nargs = nparams;
+			}
+			size_t *range;
+			rz_vector_foreach(&args_ranges, range) {
+				RzVector *arg = rz_vector_push(&args, NULL);
+				pp_vector_init(arg);
+				pp_arg_tokens(in, range[0], range[1], arg);
+			}
+			// "F()" has one empty argument, for the macros without parameters it means no arguments
+			if (!nparams && nargs == 1 && rz_vector_empty((RzVector *)rz_vector_head(&args))) {
+				rz_vector_clear(&args);
+				nargs = 0;
+			}
+			if (macro->variadic && nargs + 1 == nparams) {
+				RzVector *arg = rz_vector_push(&args, NULL);
+				pp_vector_init(arg);
+				nargs++;
+			}
+			if (nargs != nparams) {
+				rz_strbuf_appendf(ctx->warnings, "%s:%d: macro \"%s\" requires %zu arguments, but %zu given\n",
+					file->path ? file->path : "<string>", file->line, macro->name, nparams, nargs);
+				rz_vector_push(out, &tok);
+				rz_vector_fini(&args);
+				continue;
+			}
+			// The hide set of the expansion is HS(name) & HS(')'), see Prosser's algorithm
+			PPToken *rparen = rz_vector_index_ptr(in, close);
+			hs = pp_hideset_intersect(ctx, tok.hs, rparen->hs);
+			// Drop the invocation from the stack
+			while ((st64)rz_vector_len(in) > close) {
+				PPToken tmp;
+				rz_vector_pop(in, &tmp);
+				free(tmp.text);
+			}
+		}
+		hs = pp_hideset_add(ctx, hs, tok.text);
+		free(tok.text);
+		RzVector subst;
+		pp_vector_init(&subst);
+		ret &= pp_substitute(ctx, file, macro, &args, hs, &subst);
+		rz_vector_fini(&args);
+		// Push the result back to be rescanned with the rest of the input
+		while (!rz_vector_empty(&subst)) {
+			PPToken stok;
+			rz_vector_pop(&subst, &stok);
+			rz_vector_push(in, &stok);
+		}
+		rz_vector_fini(&subst);
+	}
+	rz_vector_fini(&args_ranges);
+	return ret;
+}
+
+// Conditional expressions
+
+typedef struct {
+	RzVector /*<PPToken>*/ *tokens;
+	size_t pos;
+	bool error;
+} PPExpr;
+
+static PPToken *pp_expr_peek(PPExpr *e) {
+	e->pos = pp_next_nonblank(e->tokens, e->pos);
+	return e->pos < rz_vector_len(e->tokens) ? rz_vector_index_ptr(e->tokens, e->pos) : NULL;
+}
+
+static bool pp_expr_accept(PPExpr *e, const char *punct) {
+	PPToken *tok = pp_expr_peek(e);
+	if (tok && pp_tok_is(tok, punct)) {
+		e->pos++;
+		return true;
+	}
+	return false;
+}
+
+/**
+ * A value of a conditional expression: all the arithmetic is done on 64 bits
+ * and the unsigned flag selects between signed and unsigned semantics, as in
+ * intmax_t/uintmax_t evaluation of the C standard.
+ */
+typedef struct {
+	ut64 val;
+	bool is_unsigned;
+} PPValue;
+
+static PPValue pp_value_signed(st64 val) {
+	PPValue v = { .val = (ut64)val, .is_unsigned = false };
+	return v;
+}
+
+static bool pp_value_true(PPValue v) {
+	return v.val != 0;
+}
+
+static PPValue pp_parse_number(const char *s, bool *ok) {
+	PPValue ret = { 0 };
+	char *num = strdup(s);
+	if (!num) {
+		*ok = false;
+		return ret;
+	}
+	// Drop the integer suffixes
+	size_t len = strlen(num);
+	while (len && strchr("uUlL", num[len - 1])) {
+		if (num[len - 1] == 'u' || num[len - 1] == 'U') {
+			ret.is_unsigned = true;
+		}
+		num[--len] = '\0';
+	}
+	char *end = NULL;
+	if (num[0] == '0' && (num[1] == 'b' || num[1] == 'B')) {
+		ret.val = strtoull(num + 2, &end, 2);
+	} else {
+		ret.val = strtoull(num, &end, 0);
+	}
+	// Constants that do not fit intmax_t only fit uintmax_t
+	if (ret.val > (ut64)ST64_MAX) {
+		ret.is_unsigned = true;
+	}
+	*ok = end && !*end && len;
+	free(num);
+	return ret;
+}
+
+static st64 pp_parse_char(const char *s) {
+	const char *p = strchr(s, '\'');
+	if (!p) {
+		return 0;
+	}
+	p++;
+	if (*p != '\\') {
+		return (ut8)*p;
+	}
+	p++;
+	switch (*p) {
+	case 'n': return '\n';
+	case 't': return '\t';
+	case 'r': return '\r';
+	case 'a': return '\a';
+	case 'b': return '\b';
+	case 'f': return '\f';
+	case 'v': return '\v';
+	case 'x': return (st64)strtoull(p + 1, NULL, 16);
+	default:
+		if (*p >= '0' && *p <= '7') {
+			return (st64)strtoull(p, NULL, 8);
+		}
+		return (ut8)*p;
+	}
+}
+
+static PPValue pp_expr_ternary(PPExpr *e);
+
+static PPValue pp_expr_unary(PPExpr *e) {
+	PPToken *tok = pp_expr_peek(e);
+	if (!tok) {
+		e->error = true;
+		return pp_value_signed(0);
+	}
+	e->pos++;
+	if (pp_tok_is(tok, "(")) {
+		PPValue val = pp_expr_ternary(e);
+		if (!pp_expr_accept(e, ")")) {
+			e->error = true;
+		}
+		return val;
+	} else if (pp_tok_is(tok, "!")) {
+		return pp_value_signed(!pp_value_true(pp_expr_unary(e)));
+	} else if (pp_tok_is(tok, "~")) {
+		PPValue val = pp_expr_unary(e);
+		val.val = ~val.val;
+		return val;
+	} else if (pp_tok_is(tok, "-")) {
+		PPValue val = pp_expr_unary(e);
+		val.val = 0 - val.val;
+		return val;
+	} else if (pp_tok_is(tok, "+")) {
+		return pp_expr_unary(e);
+	}
+	switch (tok->kind) {
+	case PP_TOKEN_NUMBER: {
+		bool ok = true;
+		PPValue val = pp_parse_number(tok->text, &ok);
+		e->error |= !ok;
+		return val;
+	}
+	case PP_TOKEN_STRING:
+		if (!strchr(tok->text, '"')) {
+			return pp_value_signed(pp_parse_char(tok->text));
+		}
+		e->error = true;
+		return pp_value_signed(0);
+	case PP_TOKEN_IDENT:
+		// All the identifiers remaining after macro expansion are replaced by 0
+		return pp_value_signed(0);
+	default:
+		e->error = true;
+		return pp_value_signed(0);
+	}
+}
+
+static int pp_binop_prec(const PPToken *tok) {
+	static const struct {
+		const char *op;
+		int prec;
+	} ops[] = {
+		{ "*", 10 }, { "/", 10 }, { "%", 10 }, { "+", 9 }, { "-", 9 }, { "<<", 8 }, { ">>", 8 },
+		{ "<", 7 }, { ">", 7 }, { "<=", 7 }, { ">=", 7 }, { "==", 6 }, { "!=", 6 },
+		{ "&", 5 }, { "^", 4 }, { "|", 3 }, { "&&", 2 }, { "||", 1 }
+	};
+	if (!tok || tok->kind != PP_TOKEN_PUNCT) {
+		return -1;
+	}
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(ops); i++) {
+		if (!strcmp(tok->text, ops[i].op)) {
+			return ops[i].prec;
+		}
+	}
+	return -1;
+}
+
+static PPValue pp_expr_binary(PPExpr *e, int min_prec) {
+	PPValue lhs = pp_expr_unary(e);
+	while (!e->error) {
+		PPToken *tok = pp_expr_peek(e);
+		int prec = pp_binop_prec(tok);
+		if (prec < min_prec) {
+			break;
+		}
+		const char *op = tok->text;
+		e->pos++;
+		PPValue rhs = pp_expr_binary(e, prec + 1);
+		// The usual arithmetic conversions, the shifts keep the type of the left operand
+		bool is_unsigned = lhs.is_unsigned || rhs.is_unsigned;
+		ut64 l = lhs.val;
+		ut64 r = rhs.val;
+		st64 sl = (st64)l;
+		st64 sr = (st64)r;
+		switch (op[0]) {
+		case '*': lhs.val = l * r; break;
+		case '/':
+			if (!r) {
+				lhs.val = 0;
+			} else if (is_unsigned) {
+				lhs.val = l / r;
+			} else {
+				// ST64_MIN / -1 does not fit, wrap it like the other operations
+				lhs.val = sr == -1 ? 0 - l : (ut64)(sl / sr);
+			}
+			break;
+		case '%':
+			if (!r) {
+				lhs.val = 0;
+			} else if (is_unsigned) {
+				lhs.val = l % r;
+			} else {
+				lhs.val = sr == -1 ? 0 : (ut64)(sl % sr);
+			}
+			break;
+		case '+': lhs.val = l + r; break;
+		case '-': lhs.val = l - r; break;
+		case '^': lhs.val = l ^ r; break;
+		case '<':
+			if (op[1] == '<') {
+				lhs.val = l << (r & 63);
+				continue;
+			}
+			lhs = pp_value_signed(op[1] == '='
+					? (is_unsigned ? l <= r : sl <= sr)
+					: (is_unsigned ? l < r : sl < sr));
+			continue;
+		case '>':
+			if (op[1] == '>') {
+				lhs.val = lhs.is_unsigned ? l >> (r & 63) : (ut64)(sl >> (r & 63));
+				continue;
+			}
+			lhs = pp_value_signed(op[1] == '='
+					? (is_unsigned ? l >= r : sl >= sr)
+					: (is_unsigned ? l > r : sl > sr));
+			continue;
+		case '=': lhs = pp_value_signed(l == r); continue;
+		case '!': lhs = pp_value_signed(l != r); continue;
+		case '&':
+			if (op[1] == '&') {
+				lhs = pp_value_signed(l && r);
+				continue;
+			}
+			lhs.val = l & r;
+			break;
+		case '|':
+			if (op[1] == '|') {
+				lhs = pp_value_signed(l || r);
+				continue;
+			}
+			lhs.val = l | r;
+			break;
+		default: break;
+		}
+		lhs.is_unsigned = is_unsigned;
+	}
+	return lhs;
+}
+
+static PPValue pp_expr_ternary(PPExpr *e) {
+	PPValue cond = pp_expr_binary(e, 1);
+	if (!pp_expr_accept(e, "?")) {
+		return cond;
+	}
+	PPValue a = pp_expr_ternary(e);
+	if (!pp_expr_accept(e, ":")) {
+		e->error = true;
+		return pp_value_signed(0);
+	}
+	PPValue b = pp_expr_ternary(e);
+	PPValue ret = pp_value_true(cond) ? a : b;
+	ret.is_unsigned = a.is_unsigned || b.is_unsigned;
+	return ret;
+}
+
+// Includes
+
+static char *pp_resolve_include(PPContext *ctx, const PPFile *file, const char *name, bool quoted, bool next, int *dir_index) {
+	*dir_index = -1;
+	if (rz_file_is_abspath(name)) {
+		return rz_file_exists(name) ? strdup(name) : NULL;
+	}
+	if (quoted && !next && file->dir) {
+		char *path = rz_file_path_join(file->dir, name);
+		if (path && rz_file_exists(path)) {
+			*dir_index = file->dir_index;
+			return path;
+		}
+		free(path);
+	}
+	const RzPVector *dirs = &ctx->pp->include_dirs;
+	size_t start = next && file->dir_index >= 0 ? file->dir_index + 1 : 0;
+	for (size_t i = start; i < rz_pvector_len(dirs); i++) {
+		char *path = rz_file_path_join(rz_pvector_at(dirs, i), name);
+		if (path && rz_file_exists(path)) {
+			*dir_index = (int)i;
+			return path;
+		}
+		free(path);
+	}
+	return NULL;
+}
+
+/**
+ * Reads the header name of the `#include` or `__has_include` from the tokens,
+ * starting at \p pos. Both `"name"` and `<name>` forms are supported.
+ */
+static char *pp_header_name(const RzVector *tokens, size_t *pos, bool *quoted) {
+	size_t i = pp_next_nonblank(tokens, *pos);
+	if (i >= rz_vector_len(tokens)) {
+		return NULL;
+	}
+	PPToken *tok = rz_vector_index_ptr((RzVector *)tokens, i);
+	if (tok->kind == PP_TOKEN_STRING && tok->text[0] == '"') {
+		*quoted = true;
+		*pos = i + 1;
+		size_t len = strlen(tok->text);
+		return len >= 2 ? rz_str_ndup(tok->text + 1, len - 2) : NULL;
+	}
+	if (!pp_tok_is(tok, "<")) {
+		return NULL;
+	}
+	RzStrBuf sb;
+	rz_strbuf_init(&sb);
+	for (i++; i < rz_vector_len(tokens); i++) {
+		tok = rz_vector_index_ptr((RzVector *)tokens, i);
+		if (pp_tok_is(tok, ">")) {
+			*quoted = false;
+			*pos = i + 1;
+			return rz_strbuf_drain_nofree(&sb);
+		}
+		if (tok->kind == PP_TOKEN_NEWLINE) {
+			break;
+		}
+		rz_strbuf_append(&sb, tok->text);
+	}
+	rz_strbuf_fini(&sb);
+	return NULL;
+}
+
+static void pp_reverse_into(RzVector *from, RzVector *stack) {
+	while (!rz_vector_empty(from)) {
+		PPToken tok;
+		rz_vector_pop(from, &tok);
+		rz_vector_push(stack, &tok);
+	}
+}
+
+/**
+ * Replaces `defined X`, `defined(X)` and the `__has_*` operators
+ * in the condition by their values before the macro expansion.
+ */
+static bool pp_replace_defined(PPContext *ctx, const PPFile *file, RzVector *in, RzVector *out) {
+	size_t i = 0;
+	while (i < rz_vector_len(in)) {
+		PPToken *tok = rz_vector_index_ptr(in, i);
+		if (tok->kind != PP_TOKEN_IDENT) {
+			pp_push_copy(out, tok);
+			i++;
+			continue;
+		}
+		if (!strcmp(tok->text, "defined")) {
+			size_t n = pp_next_nonblank(in, i + 1);
+			bool paren = n < rz_vector_len(in) && pp_tok_is(rz_vector_index_ptr(in, n), "(");
+			if (paren) {
+				n = pp_next_nonblank(in, n + 1);
+			}
+			if (n >= rz_vector_len(in) || ((PPToken *)rz_vector_index_ptr(in, n))->kind != PP_TOKEN_IDENT) {
+				return false;
+			}
+			PPToken *name = rz_vector_index_ptr(in, n);
+			bool defined = pp_macro_find(ctx, name->text) || !strcmp(name->text, "__FILE__") || !strcmp(name->text, "__LINE__");
+			if (paren) {
+				n = pp_next_nonblank(in, n + 1);
+				if (n >= rz_vector_len(in) || !pp_tok_is(rz_vector_index_ptr(in, n), ")")) {
+					return false;
+				}
+			}
+			pp_push(out, PP_TOKEN_NUMBER, defined ? "1" : "0", 1, NULL);
+			i = n + 1;
+			continue;
+		}
+		if (!strcmp(tok->text, "__has_include") || !strcmp(tok->text, "__has_include_next")) {
+			size_t n = pp_next_nonblank(in, i + 1);
+			if (n >= rz_vector_len(in) || !pp_tok_is(rz_vector_index_ptr(in, n), "(")) {
+				return false;
+			}
+			n++;
+			bool quoted = false;
+			char *name = pp_header_name(in, &n, &quoted);
+			n = pp_next_nonblank(in, n);
+			if (!name || n >= rz_vector_len(in) || !pp_tok_is(rz_vector_index_ptr(in, n), ")")) {
+				free(name);
+				return false;
+			}
+			int dir_index;
+			char *path = pp_resolve_include(ctx, file, name, quoted, !strcmp(tok->text, "__has_include_next"), &dir_index);
+			pp_push(out, PP_TOKEN_NUMBER, path ? "1" : "0", 1, NULL);
+			free(path);
+			free(name);
+			i = n + 1;
+			continue;
+		}
+		if (rz_str_startswith(tok->text, "__has_")) {
+			// __has_attribute, __has_builtin, __has_feature, ... are considered unsupported
+			size_t n = pp_next_nonblank(in, i + 1);
+			if (n < rz_vector_len(in) && pp_tok_is(rz_vector_index_ptr(in, n), "(")) {
+				int depth = 0;
+				for (; n < rz_vector_len(in); n++) {
+					PPToken *t = rz_vector_index_ptr(in, n);
+					if (pp_tok_is(t, "(")) {
+						depth++;
+					} else if (pp_tok_is(t, ")") && !--depth) {
+						break;
+					}
+				}
+				pp_push(out, PP_TOKEN_NUMBER, "0", 1, NULL);
+				i = n + 1;
+				continue;
+			}
+		}
+		pp_push_copy(out, tok);
+		i++;
+	}
+	return true;
+}
+
+static bool pp_eval_condition(PPContext *ctx, const PPFile *file, const char *expr, bool *result) {
+	RzVector raw, replaced, stack, expanded;
+	pp_vector_init(&raw);
+	pp_vector_init(&replaced);
+	pp_vector_init(&stack);
+	pp_vector_init(&expanded);
+	bool ok = pp_tokenize(expr, strlen(expr), &raw) && pp_replace_defined(ctx, file, &raw, &replaced);
+	if (ok) {
+		pp_reverse_into(&replaced, &stack);
+		ok = pp_expand(ctx, file, &stack, &expanded);
+	}
+	if (ok) {
+		PPExpr e = { .tokens = &expanded };
+		*result = pp_value_true(pp_expr_ternary(&e));
+		ok = !e.error && !pp_expr_peek(&e);
+	}
+	rz_vector_fini(&raw);
+	rz_vector_fini(&replaced);
+	rz_vector_fini(&stack);
+	rz_vector_fini(&expanded);
+	return ok;
+}
+
+// Directives
+
+static void pp_emit(PPContext *ctx, const RzVector *tokens) {
+	PPToken *tok;
+	rz_vector_foreach(tokens, tok) {
+		if (tok->kind == PP_TOKEN_PLACEMARKER || !*tok->text) {
+			continue;
+		}
+		// Keep the adjacent tokens of the expansion apart, "unsigned" "int" must not become "unsignedint"
+		size_t len = rz_strbuf_length(ctx->out);
+		if (len && pp_is_ident_char(rz_strbuf_get(ctx->out)[len - 1]) && pp_is_ident_char(tok->text[0])) {
+			rz_strbuf_append_n(ctx->out, " ", 1);
+		}
+		rz_strbuf_append(ctx->out, tok->text);
+	}
+}
+
+static bool pp_flush_text(PPContext *ctx, const PPFile *file, RzStrBuf *text) {
+	if (!rz_strbuf_length(text)) {
+		return true;
+	}
+	RzVector tokens, stack, out;
+	pp_vector_init(&tokens);
+	pp_vector_init(&stack);
+	pp_vector_init(&out);
+	bool ok = pp_tokenize(rz_strbuf_get(text), rz_strbuf_length(text), &tokens);
+	if (ok) {
+		pp_reverse_into(&tokens, &stack);
+		ok = pp_expand(ctx, file, &stack, &out);
+		pp_emit(ctx, &out);
+	}
+	rz_vector_fini(&tokens);
+	rz_vector_fini(&stack);
+	rz_vector_fini(&out);
+	rz_strbuf_fini(text);
+	rz_strbuf_init(text);
+	return ok;
+}
+
+static void pp_error(PPContext *ctx, const PPFile *file, const char *msg, const char *arg) {
+	rz_strbuf_appendf(ctx->errors, "%s:%d: %s%s\n", file->path ? file->path : "<string>", file->line, msg, arg ? arg : "");
+	ctx->failed = true;
+}
+
+static void pp_warning(PPContext *ctx, const PPFile *file, const char *msg, const char *arg) {
+	rz_strbuf_appendf(ctx->warnings, "%s:%d: %s%s\n", file->path ? file->path : "<string>", file->line, msg, arg ? arg : "");
+}
+
+static bool pp_process_file(PPContext *ctx, const char *path, int dir_index);
+
+static void pp_include(PPContext *ctx, const PPFile *file, const char *args, bool next) {
+	RzVector tokens;
+	pp_vector_init(&tokens);
+	pp_tokenize(args, strlen(args), &tokens);
+	size_t pos = 0;
+	bool quoted = false;
+	char *name = pp_header_name(&tokens, &pos, &quoted);
+	if (!name) {
+		// #include MACRO
+		RzVector stack, expanded;
+		pp_vector_init(&stack);
+		pp_vector_init(&expanded);
+		pp_reverse_into(&tokens, &stack);
+		if (pp_expand(ctx, file, &stack, &expanded)) {
+			pos = 0;
+			name = pp_header_name(&expanded, &pos, &quoted);
+		}
+		rz_vector_fini(&stack);
+		rz_vector_fini(&expanded);
+	}
+	rz_vector_fini(&tokens);
+	if (!name) {
+		pp_error(ctx, file, "invalid #include argument: ", args);
+		return;
+	}
+	int found_index;
+	char *path = pp_resolve_include(ctx, file, name, quoted, next, &found_index);
+	if (!path) {
+		// The system headers are often not available, it's not fatal
+		pp_warning(ctx, file, "header not found: ", name);
+	} else if (ctx->depth >= PP_MAX_INCLUDE_DEPTH) {
+		pp_error(ctx, file, "#include nested too deeply: ", name);
+	} else {
+		pp_process_file(ctx, path, found_index);
+	}
+	free(path);
+	free(name);
+}
+
+static const char *pp_skip_spaces(const char *p) {
+	while (IS_WHITESPACE(*p)) {
+		p++;
+	}
+	return p;
+}
+
+static void pp_define(PPContext *ctx, const PPFile *file, const char *args) {
+	PPMacro *macro = pp_macro_parse(args);
+	if (!macro) {
+		pp_error(ctx, file, "invalid macro definition: ", args);
+		return;
+	}
+	if (!ht_pp_update(ctx->macros, macro->name, macro)) {
+		pp_macro_free(macro);
+	}
+}
+
+static void pp_undef(PPContext *ctx, const char *args) {
+	const char *end = args;
+	while (pp_is_ident_char(*end)) {
+		end++;
+	}
+	char *name = rz_str_ndup(args, end - args);
+	if (name && *name) {
+		// NULL value hides the macro of the preprocessor itself
+		ht_pp_update(ctx->macros, name, NULL);
+	}
+	free(name);
+}
+
+static bool pp_cond_active(RzVector *conds) {
+	return rz_vector_empty(conds) || ((PPCond *)rz_vector_tail(conds))->active;
+}
+
+/**
+ * Handles the conditional directives, returns false if \p directive is not one of them
+ */
+static bool pp_conditional(PPContext *ctx, const PPFile *file, RzVector *conds, const char *directive, const char *args) {
+	bool is_if = !strcmp(directive, "if");
+	bool is_ifdef = !strcmp(directive, "ifdef");
+	bool is_ifndef = !strcmp(directive, "ifndef");
+	if (is_if || is_ifdef || is_ifndef) {
+		PPCond cond = { .parent_active = pp_cond_active(conds) };
+		if (cond.parent_active) {
+			bool value = false;
+			if (is_if) {
+				if (!pp_eval_condition(ctx, file, args, &value)) {
+					pp_error(ctx, file, "invalid #if expression: ", args);
+				}
+			} else {
+				char *name = strdup(args);
+				if (name) {
+					rz_str_trim(name);
+					value = pp_macro_find(ctx, name) != NULL;
+					value = is_ifdef ? value : !value;
+				}
+				free(name);
+			}
+			cond.active = cond.taken = value;
+		}
+		rz_vector_push(conds, &cond);
+		return true;
+	}
+	bool is_elif = !strcmp(directive, "elif");
+	bool is_elifdef = !strcmp(directive, "elifdef");
+	bool is_elifndef = !strcmp(directive, "elifndef");
+	bool is_else = !strcmp(directive, "else");
+	if (is_elif || is_elifdef || is_elifndef || is_else) {
+		if (rz_vector_empty(conds)) {
+			pp_error(ctx, file, "conditional directive without #if: #", directive);
+			return true;
+		}
+		PPCond *cond = rz_vector_tail(conds);
+		if (cond->seen_else) {
+			pp_error(ctx, file, "conditional directive after #else: #", directive);
+			return true;
+		}
+		cond->seen_else = is_else;
+		if (!cond->parent_active || cond->taken) {
+			cond->active = false;
+			return true;
+		}
+		bool value = true;
+		if (is_elif) {
+			if (!pp_eval_condition(ctx, file, args, &value)) {
+				pp_error(ctx, file, "invalid #elif expression: ", args);
+				value = false;
+			}
+		} else if (!is_else) {
+			char *name = strdup(args);
+			if (name) {
+				rz_str_trim(name);
+				value = pp_macro_find(ctx, name) != NULL;
+				value = is_elifdef ? value : !value;
+			}
+			free(name);
+		}
+		cond->active = cond->taken = value;
+		return true;
+	}
+	if (!strcmp(directive, "endif")) {
+		if (rz_vector_empty(conds)) {
+			pp_error(ctx, file, "#endif without #if", NULL);
+		} else {
+			rz_vector_pop(conds, NULL);
+		}
+		return true;
+	}
+	return false;
+}
+
+static void pp_directive(PPContext *ctx, PPFile *file, RzVector *conds, const char *line) {
+	const char *p = pp_skip_spaces(line);
+	const char *dstart = p;
+	while (pp_is_ident_char(*p)) {
+		p++;
+	}
+	char *directive = rz_str_ndup(dstart, p - dstart);
+	char *args = strdup(pp_skip_spaces(p));
+	if (!directive || !args) {
+		goto beach;
+	}
+	rz_str_trim_tail(args);
+	if (pp_conditional(ctx, file, conds, directive, args) || !pp_cond_active(conds) || !*directive) {
+		goto beach;
+	}
+	if (!strcmp(directive, "include") || !strcmp(directive, "import")) {
+		pp_include(ctx, file, args, false);
+	} else if (!strcmp(directive, "include_next")) {
+		pp_include(ctx, file, args, true);
+	} else if (!strcmp(directive, "define")) {
+		pp_define(ctx, file, args);
+	} else if (!strcmp(directive, "undef")) {
+		pp_undef(ctx, args);
+	} else if (!strcmp(directive, "error")) {
+		// Headers often refuse to work with the unknown compilers, but the types are still useful
+		rz_strbuf_appendf(ctx->errors, "%s:%d: warning: #error %s\n", file->path ? file->path : "<string>", file->line, args);
+	} else if (!strcmp(directive, "warning")) {
+		pp_warning(ctx, file, "#warning ", args);
+	} else if (!strcmp(directive, "pragma")) {
+		if (!strcmp(args, "once") && file->once_key) {
+			ht_pp_update(ctx->once, file->once_key, NULL);
+		}
+	} else if (strcmp(directive, "line") && strcmp(directive, "ident") && strcmp(directive, "sccs") && strcmp(directive, "assert") && strcmp(directive, "unassert")) {
+		pp_warning(ctx, file, "unknown directive #", directive);
+	}
+beach:
+	free(directive);
+	free(args);
+}
+
+static bool pp_process(PPContext *ctx, PPFile *file, const char *code) {
+	char *clean = pp_clean_source(code);
+	if (!clean) {
+		return false;
+	}
+	RzVector conds;
+	rz_vector_init(&conds, sizeof(PPCond), NULL, NULL);
+	RzStrBuf text;
+	rz_strbuf_init(&text);
+	int text_line = 1;
+	int line_no = 1;
+	char *line = clean;
+	while (line && *line && !ctx->failed) {
+		char *next = strchr(line, '\n');
+		if (next) {
+			*next++ = '\0';
+		}
+		const char *p = pp_skip_spaces(line);
+		if (*p == '#') {
+			file->line = text_line;
+			pp_flush_text(ctx, file, &text);
+			file->line = line_no;
+			pp_directive(ctx, file, &conds, p + 1);
+			text_line = line_no + 1;
+		} else if (pp_cond_active(&conds)) {
+			rz_strbuf_append(&text, line);
+			rz_strbuf_append_n(&text, "\n", 1);
+		}
+		line = next;
+		line_no++;
+	}
+	file->line = text_line;
+	pp_flush_text(ctx, file, &text);
+	if (!rz_vector_empty(&conds) && !ctx->failed) {
+		file->line = line_no;
+		pp_error(ctx, file, "unterminated conditional directive", NULL);
+	}
+	rz_strbuf_fini(&text);
+	rz_vector_fini(&conds);
+	free(clean);
+	return !ctx->failed;
+}
+
+static bool pp_process_file(PPContext *ctx, const char *path, int dir_index) {
+	char *abspath = rz_file_abspath(path);
+	if (!abspath) {
+		return false;
+	}
+	bool ret = true;
+	char *code = NULL;
+	char *dir = NULL;
+	PPFile file = { .path = path, .dir_index = dir_index, .line = 1 };
+	if (ht_pp_find_kv(ctx->once, abspath, NULL)) {
+		goto beach;
+	}
+	code = rz_file_slurp(path, NULL);
+	if (!code) {
+		rz_strbuf_appendf(ctx->errors, "Cannot read file %s\n", path);
+		ctx->failed = true;
+		ret = false;
+		goto beach;
+	}
+	file.dir = dir = rz_file_dirname(path);
+	file.once_key = abspath;
+	ctx->depth++;
+	ret = pp_process(ctx, &file, code);
+	ctx->depth--;
+beach:
+	free(dir);
+	free(code);
+	free(abspath);
+	return ret;
+}
+
+// Public API
+
+static bool pp_predefine(RzTypePreprocessor *pp, const char *def) {
+	PPMacro *macro = pp_macro_parse(def);
+	if (!macro) {
+		return false;
+	}
+	if (!ht_pp_update(pp->macros, macro->name, macro)) {
+		pp_macro_free(macro);
+		return false;
+	}
+	return true;
+}
+
+static const char *pp_common_defines[] = {
+	"__STDC__ 1",
+	"__STDC_VERSION__ 201112L",
+	"__STDC_HOSTED__ 1",
+	"__CHAR_BIT__ 8",
+	"__SIZEOF_INT__ 4",
+	"__SIZEOF_SHORT__ 2",
+	"__SIZEOF_LONG_LONG__ 8",
+	"__SIZEOF_FLOAT__ 4",
+	"__SIZEOF_DOUBLE__ 8",
+	"__ORDER_LITTLE_ENDIAN__ 1234",
+	"__ORDER_BIG_ENDIAN__ 4321",
+	// Compiler extensions the C parser doesn't understand
+	"__attribute__(x)",
+	"__attribute(x)",
+	"__declspec(x)",
+	"__asm__(...)",
+	"__asm(...)",
+	"__extension__",
+	"__restrict restrict",
+	"__restrict__ restrict",
+	"__inline inline",
+	"__inline__ inline",
+	"__forceinline inline",
+	"__volatile__ volatile",
+	"__const const",
+	"__signed__ signed",
+	"__cdecl",
+	"__stdcall",
+	"__fastcall",
+	"__thiscall",
+	"__ptr32",
+	"__ptr64",
+	"__unaligned",
+	"_Nullable",
+	"_Nonnull",
+	"_Null_unspecified",
+	"__nullable",
+	"__nonnull",
+	"_Noreturn",
+	"__builtin_va_list void *",
+	"__int64 long long",
+	"__int32 int",
+	"__int16 short",
+	"__int8 char",
+	NULL
+};
+
+static void pp_predefine_target(RzTypePreprocessor *pp, const RzTypeTarget *target) {
+	int bits = target->addr_bits > 0 ? target->addr_bits : target->bits;
+	const char *cpu = target->cpu ? target->cpu : "";
+	const char *os = target->os ? target->os : "";
+	bool windows = !strcmp(os, "windows");
+	char *def = rz_str_newf("__SIZEOF_POINTER__ %d", bits / 8);
+	pp_predefine(pp, def);
+	free(def);
+	// Windows uses LLP64, everyone else LP64
+	def = rz_str_newf("__SIZEOF_LONG__ %d", bits == 64 && !windows ? 8 : 4);
+	pp_predefine(pp, def);
+	free(def);
+	pp_predefine(pp, target->big_endian ? "__BYTE_ORDER__ __ORDER_BIG_ENDIAN__" : "__BYTE_ORDER__ __ORDER_LITTLE_ENDIAN__");
+	if (bits == 64 && !windows) {
+		pp_predefine(pp, "__LP64__ 1");
+		pp_predefine(pp, "_LP64 1");
+	}
+	if (!strcmp(cpu, "x86")) {
+		if (bits == 64) {
+			pp_predefine(pp, "__x86_64__ 1");
+			pp_predefine(pp, "__x86_64 1");
+			pp_predefine(pp, "__amd64__ 1");
+			pp_predefine(pp, windows ? "_M_X64 100" : "__amd64 1");
+		} else {
+			pp_predefine(pp, "__i386__ 1");
+			pp_predefine(pp, "__i386 1");
+			pp_predefine(pp, windows ? "_M_IX86 600" : "i386 1");
+		}
+	} else if (!strcmp(cpu, "arm")) {
+		if (bits == 64) {
+			pp_predefine(pp, "__aarch64__ 1");
+			pp_predefine(pp, windows ? "_M_ARM64 1" : "__arm64__ 1");
+		} else {
+			pp_predefine(pp, "__arm__ 1");
+			pp_predefine(pp, windows ? "_M_ARM 7" : "__ARM_ARCH 7");
+		}
+	} else if (!strcmp(cpu, "mips")) {
+		pp_predefine(pp, "__mips__ 1");
+		pp_predefine(pp, bits == 64 ? "__mips 64" : "__mips 32");
+	} else if (!strcmp(cpu, "ppc")) {
+		pp_predefine(pp, bits == 64 ? "__powerpc64__ 1" : "__powerpc__ 1");
+	} else if (!strcmp(cpu, "riscv")) {
+		pp_predefine(pp, "__riscv 1");
+		pp_predefine(pp, bits == 64 ? "__riscv_xlen 64" : "__riscv_xlen 32");
+	} else if (!strcmp(cpu, "sparc")) {
+		pp_predefine(pp, bits == 64 ? "__sparc_v9__ 1" : "__sparc__ 1");
+	}
+	if (windows) {
+		pp_predefine(pp, "_WIN32 1");
+		if (bits == 64) {
+			pp_predefine(pp, "_WIN64 1");
+		}
+		pp_predefine(pp, "_MSC_VER 1900");
+	} else {
+		// Everything else is considered to be GCC-compatible
+		pp_predefine(pp, "__GNUC__ 4");
+		pp_predefine(pp, "__GNUC_MINOR__ 2");
+		pp_predefine(pp, "__unix__ 1");
+		if (!strcmp(os, "linux") || !strcmp(os, "android")) {
+			pp_predefine(pp, "__linux__ 1");
+			pp_predefine(pp, "__linux 1");
+			pp_predefine(pp, "__gnu_linux__ 1");
+			if (!strcmp(os, "android")) {
+				pp_predefine(pp, "__ANDROID__ 1");
+			}
+		} else if (!strcmp(os, "darwin") || !strcmp(os, "macos") || !strcmp(os, "ios")) {
+			pp_predefine(pp, "__APPLE__ 1");
+			pp_predefine(pp, "__MACH__ 1");
+		} else if (!strcmp(os, "freebsd")) {
+			pp_predefine(pp, "__FreeBSD__ 13");
+		} else if (!strcmp(os, "netbsd")) {
+			pp_predefine(pp, "__NetBSD__ 1");
+		} else if (!strcmp(os, "openbsd")) {
+			pp_predefine(pp, "__OpenBSD__ 1");
+		}
+	}
+}
+
+/**
+ * \brief Creates a new C preprocessor
+ *
+ * The predefined macros depend on the \p target, e.g. `__x86_64__` and `__linux__`
+ * for the 64-bit x86 Linux target. Additionally the common compiler extensions
+ * like `__attribute__` or `__declspec` are erased, since the C parser doesn't support them.
+ *
+ * \param target The target to predefine the macros for, might be NULL
+ */
+RZ_API RZ_OWN RzTypePreprocessor *rz_type_preprocessor_new(RZ_NULLABLE const RzTypeTarget *target) {
+	RzTypePreprocessor *pp = RZ_NEW0(RzTypePreprocessor);
+	if (!pp) {
+		return NULL;
+	}
+	pp->macros = ht_pp_new(NULL, pp_macro_kv_free, NULL);
+	if (!pp->macros) {
+		free(pp);
+		return NULL;
+	}
+	rz_pvector_init(&pp->include_dirs, free);
+	for (size_t i = 0; pp_common_defines[i]; i++) {
+		pp_predefine(pp, pp_common_defines[i]);
+	}
+	if (target) {
+		pp_predefine_target(pp, target);
+	}
+	return pp;
+}
+
+RZ_API void rz_type_preprocessor_free(RZ_NULLABLE RzTypePreprocessor *pp) {
+	if (!pp) {
+		return;
+	}
+	ht_pp_free(pp->macros);
+	rz_pvector_fini(&pp->include_dirs);
+	free(pp);
+}
+
+/**
+ * \brief Appends the directory to the list of include search paths
+ */
+RZ_API bool rz_type_preprocessor_add_include_dir(RZ_NONNULL RzTypePreprocessor *pp, RZ_NONNULL const char *dir) {
+	rz_return_val_if_fail(pp && dir, false);
+	char *copy = strdup(dir);
+	if (!copy || !rz_pvector_push(&pp->include_dirs, copy)) {
+		free(copy);
+		return false;
+	}
+	return true;
+}
+
+/**
+ * \brief Defines the macro
+ *
+ * \param pp The preprocessor
+ * \param name The macro name, optionally with the parameters, e.g. "MAX(a, b)"
+ * \param value The macro body, "1" if NULL
+ */
+RZ_API bool rz_type_preprocessor_define(RZ_NONNULL RzTypePreprocessor *pp, RZ_NONNULL const char *name, RZ_NULLABLE const char *value) {
+	rz_return_val_if_fail(pp && name, false);
+	char *def = rz_str_newf("%s %s", name, value ? value : "1");
+	bool ret = def && pp_predefine(pp, def);
+	free(def);
+	return ret;
+}
+
+RZ_API void rz_type_preprocessor_undef(RZ_NONNULL RzTypePreprocessor *pp, RZ_NONNULL const char *name) {
+	rz_return_if_fail(pp && name);
+	ht_pp_delete(pp->macros, name);
+}
+
+static bool pp_context_init(PPContext *ctx, const RzTypePreprocessor *pp) {
+	memset(ctx, 0, sizeof(*ctx));
+	ctx->pp = pp;
+	ctx->macros = ht_pp_new(NULL, pp_macro_kv_free, NULL);
+	ctx->once = ht_pp_new0();
+	ctx->out = rz_strbuf_new(NULL);
+	ctx->errors = rz_strbuf_new(NULL);
+	ctx->warnings = rz_strbuf_new(NULL);
+	rz_pvector_init(&ctx->hidesets, pp_hideset_free);
+	return ctx->macros && ctx->once && ctx->out && ctx->errors && ctx->warnings;
+}
+
+static char *pp_context_fini(PPContext *ctx, char **error_msg) {
+	char *out = NULL;
+	if (!ctx->failed && ctx->out) {
+		out = rz_strbuf_drain(ctx->out);
+		ctx->out = NULL;
+	}
+	if (ctx->warnings && rz_strbuf_length(ctx->warnings)) {
+		RZ_LOG_DEBUG("C preprocessor warnings:\n%s", rz_strbuf_get(ctx->warnings));
+	}
+	if (error_msg) {
+		*error_msg = ctx->errors && rz_strbuf_length(ctx->errors) ? rz_strbuf_drain(ctx->errors) : NULL;
+		if (*error_msg) {
+			ctx->errors = NULL;
+		}
+	}
+	ht_pp_free(ctx->macros);
+	ht_pp_free(ctx->once);
+	rz_strbuf_free(ctx->out);
+	rz_strbuf_free(ctx->errors);
+	rz_strbuf_free(ctx->warnings);
+	rz_pvector_fini(&ctx->hidesets);
+	return out;
+}
+
+/**
+ * \brief Preprocesses the C code
+ *
+ * The preprocessor itself is not modified, the macros defined by the code
+ * are local to this call, so the same preprocessor can be used
+ * from several threads at once.
+ *
+ * \param pp The preprocessor
+ * \param code The C code
+ * \param dir The directory used for resolving the `#include "..."`, might be NULL
+ * \param error_msg Set to the error messages if there are any
+ * \return The preprocessed code or NULL on failure
+ */
+RZ_API RZ_OWN char *rz_type_preprocess_string(RZ_NONNULL const RzTypePreprocessor *pp, RZ_NONNULL const char *code, RZ_NULLABLE const char *dir, RZ_NULLABLE char **error_msg) {
+	rz_return_val_if_fail(pp && code, NULL);
+	PPContext ctx;
+	if (pp_context_init(&ctx, pp)) {
+		PPFile file = { .path = NULL, .dir = dir, .dir_index = -1, .line = 1 };
+		pp_process(&ctx, &file, code);
+	} else {
+		ctx.failed = true;
+	}
+	return pp_context_fini(&ctx, error_msg);
+}
+
+/**
+ * \brief Preprocesses the C file
+ *
+ * \see rz_type_preprocess_string
+ */
+RZ_API RZ_OWN char *rz_type_preprocess_file(RZ_NONNULL const RzTypePreprocessor *pp, RZ_NONNULL const char *path, RZ_NULLABLE char **error_msg) {
+	rz_return_val_if_fail(pp && path, NULL);
+	PPContext ctx;
+	if (pp_context_init(&ctx, pp)) {
+		pp_process_file(&ctx, path, -1);
+	} else {
+		ctx.failed = true;
+	}
+	return pp_context_fini(&ctx, error_msg);
+}
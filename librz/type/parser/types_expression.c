@@ -0,0 +1,361 @@
+// SPDX-FileCopyrightText: 2023 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_types.h>
+#include <rz_list.h>
+#include <rz_vector.h>
+#include <rz_util/rz_str.h>
+#include <rz_util/rz_assert.h>
+#include <rz_type.h>
+#include <tree_sitter/api.h>
+
+#include <types_parser.h>
+
+// Fast path and cache for the single type expressions, like
+// "int", "const char *", "struct foo * const *", "uint8_t [16]".
+//
+// The function signature databases contain tens of thousands of such strings,
+// so parsing them with a brand new tree-sitter syntax tree every time is
+// a huge waste. Everything that is not trivially recognized here is handed
+// over to the tree-sitter based parser.
+
+/**
+ * Names that tree-sitter recognizes as `primitive_type` rather than as `type_identifier`.
+ * Such names are handled differently by the tree-sitter parser if they are not atomic
+ * types, so the fast path only accepts them when they are atomic.
+ */
+static bool is_primitive_like(const char *name) {
+	static const char *primitives[] = {
+		"bool", "char", "int", "float", "double", "void",
+		"size_t", "ssize_t", "ptrdiff_t", "intptr_t", "uintptr_t",
+		"charptr_t", "nullptr_t", "max_align_t"
+	};
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(primitives); i++) {
+		if (!strcmp(name, primitives[i])) {
+			return true;
+		}
+	}
+	return rz_str_endswith(name, "_t");
+}
+
+static bool is_sized_keyword(const char *word, size_t len) {
+	static const char *keywords[] = {
+		"signed", "unsigned", "short", "long", "int", "char", "double"
+	};
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(keywords); i++) {
+		if (strlen(keywords[i]) == len && !strncmp(word, keywords[i], len)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static bool is_word_char(char c) {
+	return IS_DIGIT(c) || IS_UPPER(c) || IS_LOWER(c) || c == '_';
+}
+
+static const char *skip_spaces(const char *p) {
+	while (IS_WHITESPACE(*p)) {
+		p++;
+	}
+	return p;
+}
+
+/**
+ * Reads the next identifier-like word, returns its length or 0 if there is none
+ */
+static size_t next_word(const char *p) {
+	if (IS_DIGIT(*p)) {
+		return 0;
+	}
+	size_t len = 0;
+	while (is_word_char(p[len])) {
+		len++;
+	}
+	return len;
+}
+
+static bool word_is(const char *p, size_t len, const char *kw) {
+	return strlen(kw) == len && !strncmp(p, kw, len);
+}
+
+/**
+ * Resolves the base (leftmost) type of the expression the same way
+ * parse_type_node_single() would do it, but only if the type is already known.
+ * Returns NULL when the tree-sitter parser should decide.
+ */
+static ParserTypePair *fast_base_type(CParserState *state, const char *kw, const char *name, bool is_const, bool is_sized) {
+	if (kw) {
+		// Specifiers like "struct foo" ignore the const qualifier in the tree-sitter parser as well
+		if (!strcmp(kw, "struct")) {
+			return c_parser_get_structure_type(state, name);
+		} else if (!strcmp(kw, "union")) {
+			return c_parser_get_union_type(state, name);
+		} else if (!strcmp(kw, "enum")) {
+			return c_parser_get_enum_type(state, name);
+		}
+		return NULL;
+	}
+	ParserTypePair *tpair = c_parser_get_primitive_type(state, name, is_const);
+	if (tpair || is_sized || is_primitive_like(name)) {
+		return tpair;
+	}
+	if ((tpair = c_parser_get_typedef(state, name))) {
+		return tpair;
+	}
+	if (c_parser_base_type_is_forward_definition(state, name)) {
+		return c_parser_new_unspecified_naked_type(state, name, is_const);
+	}
+	if ((tpair = c_parser_get_structure_type(state, name))) {
+		return tpair;
+	}
+	return c_parser_get_union_type(state, name);
+}
+
+/**
+ * \brief Parses the simple type expressions without tree-sitter
+ *
+ * Accepts `[const] [struct|union|enum] name {* [const]} {[N]}` where the
+ * name is already known to the parser state.
+ *
+ * \param state The parser state
+ * \param code The C type expression
+ * \return The parsed type or NULL if the expression should be parsed by tree-sitter
+ */
+RZ_OWN RzType *c_parser_type_expression_fast(CParserState *state, RZ_NONNULL const char *code) {
+	rz_return_val_if_fail(state && code, NULL);
+	const char *p = skip_spaces(code);
+	bool is_const = false;
+	const char *kw = NULL;
+	size_t len = next_word(p);
+	if (word_is(p, len, "const")) {
+		is_const = true;
+		p = skip_spaces(p + len);
+		len = next_word(p);
+	}
+	if (word_is(p, len, "struct")) {
+		kw = "struct";
+	} else if (word_is(p, len, "union")) {
+		kw = "union";
+	} else if (word_is(p, len, "enum")) {
+		kw = "enum";
+	}
+	if (kw) {
+		p = skip_spaces(p + len);
+		len = next_word(p);
+	}
+	if (!len || word_is(p, len, "const") || word_is(p, len, "volatile") || word_is(p, len, "restrict")) {
+		return NULL;
+	}
+	// Sized primitive types like "unsigned long long" are kept verbatim,
+	// exactly as the tree-sitter parser takes them from the source
+	const char *name_start = p;
+	const char *name_end = p + len;
+	bool is_sized = !kw && is_sized_keyword(p, len);
+	if (is_sized) {
+		const char *q = skip_spaces(name_end);
+		size_t qlen;
+		while ((qlen = next_word(q)) && is_sized_keyword(q, qlen)) {
+			name_end = q + qlen;
+			q = skip_spaces(name_end);
+		}
+	}
+	char *name = rz_str_ndup(name_start, name_end - name_start);
+	if (!name) {
+		return NULL;
+	}
+	// Only fetching the already known types here, so there are no side effects
+	// on the parser state if we give up later and fall back to tree-sitter
+	ParserTypePair *tpair = fast_base_type(state, kw, name, is_const, is_sized);
+	free(name);
+	if (!tpair) {
+		return NULL;
+	}
+	RzType *type = tpair->type;
+	free(tpair);
+
+	// Pointers are applied from left to right, the qualifiers
+	// following the asterisk belong to the pointer itself
+	p = skip_spaces(name_end);
+	while (*p == '*') {
+		RzType *ptr = RZ_NEW0(RzType);
+		if (!ptr) {
+			goto fail;
+		}
+		ptr->kind = RZ_TYPE_KIND_POINTER;
+		ptr->pointer.type = type;
+		type = ptr;
+		p = skip_spaces(p + 1);
+		len = next_word(p);
+		if (word_is(p, len, "const")) {
+			ptr->pointer.is_const = true;
+			p = skip_spaces(p + len);
+		}
+	}
+	// Array dimensions are nested from right to left: "int [2][3]" is an array of 2 arrays of 3 ints
+	RzVector counts;
+	rz_vector_init(&counts, sizeof(size_t), NULL, NULL);
+	while (*p == '[') {
+		p = skip_spaces(p + 1);
+		size_t count = 0;
+		if (*p != ']') {
+			const char *num_start = p;
+			while (is_word_char(*p)) {
+				p++;
+			}
+			char *num = rz_str_ndup(num_start, p - num_start);
+			if (!num || !rz_num_is_valid_input(NULL, num)) {
+				free(num);
+				rz_vector_fini(&counts);
+				goto fail;
+			}
+			count = rz_num_get(NULL, num);
+			free(num);
+			p = skip_spaces(p);
+		}
+		if (*p != ']') {
+			rz_vector_fini(&counts);
+			goto fail;
+		}
+		rz_vector_push(&counts, &count);
+		p = skip_spaces(p + 1);
+	}
+	if (*p) {
+		rz_vector_fini(&counts);
+		goto fail;
+	}
+	while (!rz_vector_empty(&counts)) {
+		size_t count;
+		rz_vector_pop(&counts, &count);
+		RzType *arr = RZ_NEW0(RzType);
+		if (!arr) {
+			rz_vector_fini(&counts);
+			goto fail;
+		}
+		arr->kind = RZ_TYPE_KIND_ARRAY;
+		arr->array.count = count;
+		arr->array.type = type;
+		type = arr;
+	}
+	rz_vector_fini(&counts);
+	return type;
+fail:
+	rz_type_free(type);
+	return NULL;
+}
+
+// Type expressions cache
+
+typedef struct {
+	char *name; ///< Name of the base type the parsed expression refers to
+	int kind; ///< RzBaseTypeKind of the base type at the moment of parsing, -1 if it was not defined
+} TypeExprDependency;
+
+typedef struct {
+	RzType *type; ///< Parsed type, never exposed directly
+	RzVector /*<TypeExprDependency>*/ deps;
+} TypeExprCacheEntry;
+
+static void type_expr_dep_fini(void *e, void *user) {
+	TypeExprDependency *dep = e;
+	free(dep->name);
+}
+
+static void type_expr_cache_entry_free(TypeExprCacheEntry *entry) {
+	if (!entry) {
+		return;
+	}
+	rz_type_free(entry->type);
+	rz_vector_fini(&entry->deps);
+	free(entry);
+}
+
+static void type_expr_cache_kv_free(HtPPKv *kv) {
+	free(kv->key);
+	type_expr_cache_entry_free(kv->value);
+}
+
+static int base_type_kind(CParserState *state, const char *name) {
+	RzBaseType *btype = c_parser_base_type_find(state, name);
+	return btype ? (int)btype->kind : -1;
+}
+
+/**
+ * Collects the names of all base types referenced by the \p type.
+ * Returns false for the types that can't be cached, e.g. callables,
+ * since they are shared with the callables storage.
+ */
+static bool collect_dependencies(CParserState *state, const RzType *type, RzVector *deps) {
+	while (type) {
+		switch (type->kind) {
+		case RZ_TYPE_KIND_IDENTIFIER: {
+			if (!type->identifier.name) {
+				return false;
+			}
+			TypeExprDependency *dep = rz_vector_push(deps, NULL);
+			if (!dep) {
+				return false;
+			}
+			dep->name = strdup(type->identifier.name);
+			dep->kind = base_type_kind(state, type->identifier.name);
+			return dep->name != NULL;
+		}
+		case RZ_TYPE_KIND_POINTER:
+			type = type->pointer.type;
+			break;
+		case RZ_TYPE_KIND_ARRAY:
+			type = type->array.type;
+			break;
+		case RZ_TYPE_KIND_CALLABLE:
+		default:
+			return false;
+		}
+	}
+	return false;
+}
+
+HtPP *c_parser_type_expression_cache_new(void) {
+	return ht_pp_new(NULL, type_expr_cache_kv_free, NULL);
+}
+
+/**
+ * \brief Returns a copy of the cached type for the \p code
+ *
+ * The cached type is valid only if all base types it refers to
+ * still have the same kinds as when the expression was parsed.
+ * Stale entries are dropped.
+ */
+RZ_OWN RzType *c_parser_type_expression_cache_get(CParserState *state, HtPP *cache, RZ_NONNULL const char *code) {
+	rz_return_val_if_fail(state && cache && code, NULL);
+	TypeExprCacheEntry *entry = ht_pp_find(cache, code, NULL);
+	if (!entry) {
+		return NULL;
+	}
+	TypeExprDependency *dep;
+	rz_vector_foreach(&entry->deps, dep) {
+		if (base_type_kind(state, dep->name) != dep->kind) {
+			ht_pp_delete(cache, code);
+			return NULL;
+		}
+	}
+	return rz_type_clone(entry->type);
+}
+
+/**
+ * \brief Stores the copy of the parsed \p type for the \p code
+ */
+void c_parser_type_expression_cache_put(CParserState *state, HtPP *cache, RZ_NONNULL const char *code, RZ_NONNULL const RzType *type) {
+	rz_return_if_fail(state && cache && code && type);
+	TypeExprCacheEntry *entry = RZ_NEW0(TypeExprCacheEntry);
+	if (!entry) {
+		return;
+	}
+	rz_vector_init(&entry->deps, sizeof(TypeExprDependency), type_expr_dep_fini, NULL);
+	if (!collect_dependencies(state, type, &entry->deps) || !(entry->type = rz_type_clone(type))) {
+		type_expr_cache_entry_free(entry);
+		return;
+	}
+	if (!ht_pp_update(cache, code, entry)) {
+		type_expr_cache_entry_free(entry);
+	}
+}
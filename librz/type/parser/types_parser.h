@@ -11,6 +11,7 @@ typedef struct {
 typedef struct {
 	bool verbose;
 	HtPP *types;
+	HtPP *base_types; ///< Read-only types known before parsing, might be NULL
 	HtPP *callables;
 	HtPP *forward;
 	RzStrBuf *errors;
@@ -84,6 +85,12 @@ RZ_OWN ParserTypePair *c_parser_type_wrap_to_array(CParserState *state, ParserTy
 bool c_parser_pointer_set_subtype(CParserState *state, RZ_BORROW ParserTypePair *tpair, RZ_OWN ParserTypePair *subpair);
 bool c_parser_array_set_subtype(CParserState *state, RZ_BORROW ParserTypePair *tpair, RZ_OWN ParserTypePair *subpair);
 
+// Fast path and cache for the single type expressions
+RZ_OWN RzType *c_parser_type_expression_fast(CParserState *state, RZ_NONNULL const char *code);
+HtPP *c_parser_type_expression_cache_new(void);
+RZ_OWN RzType *c_parser_type_expression_cache_get(CParserState *state, HtPP *cache, RZ_NONNULL const char *code);
+void c_parser_type_expression_cache_put(CParserState *state, HtPP *cache, RZ_NONNULL const char *code, RZ_NONNULL const RzType *type);
+
 // Generators of the anonymous type names
 RZ_OWN char *c_parser_new_anonymous_structure_name(CParserState *state);
 RZ_OWN char *c_parser_new_anonymous_union_name(CParserState *state);
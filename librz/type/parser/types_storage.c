@@ -17,6 +17,9 @@
 RzBaseType *c_parser_base_type_find(CParserState *state, RZ_NONNULL const char *name) {
 	bool found = false;
 	RzBaseType *base_type = ht_pp_find(state->types, name, &found);
+	if ((!found || !base_type) && state->base_types) {
+		base_type = ht_pp_find(state->base_types, name, &found);
+	}
 	if (!found || !base_type) {
 		return NULL;
 	}
@@ -8,6 +8,7 @@
 #include <rz_type.h>
 #include <string.h>
 #include <sdb.h>
+#include "type_private.h"
 
 static void types_ht_free(HtPPKv *kv) {
 	free(kv->key);
@@ -1203,30 +1204,73 @@ RZ_API RZ_OWN RzType *rz_type_clone(RZ_BORROW RZ_NONNULL const RzType *type) {
 	return newtype;
 }
 
-/**
- * \brief Checks if two types are identical
- *
- * \param type1 RzType pointer
- * \param type2 RzType pointer
- */
-RZ_API bool rz_types_equal(RZ_NONNULL const RzType *type1, RZ_NONNULL const RzType *type2) {
-	rz_return_val_if_fail(type1 && type2, false);
+RZ_IPI void type_compare_init(TypeCompare *tc, const RzTypeAnonymousResolver *resolver) {
+	tc->resolver = resolver;
+	rz_pvector_init(&tc->stack, NULL);
+}
+
+RZ_IPI void type_compare_fini(TypeCompare *tc) {
+	rz_pvector_fini(&tc->stack);
+}
+
+static const RzBaseType *anonymous_base_type(TypeCompare *tc, const char *name) {
+	const RzTypeAnonymousResolver *r = tc->resolver;
+	return r && r->base_type && name ? r->base_type(r->user, name) : NULL;
+}
+
+static bool anonymous_callable(TypeCompare *tc, const RzCallable *callable) {
+	const RzTypeAnonymousResolver *r = tc->resolver;
+	return r && r->callable && callable->name && r->callable(r->user, callable->name);
+}
+
+static bool callable_signature_equal(TypeCompare *tc, const RzCallable *a, const RzCallable *b) {
+	if (a->noret != b->noret || a->has_unspecified_parameters != b->has_unspecified_parameters || RZ_STR_NE(a->cc, b->cc)) {
+		return false;
+	}
+	if (!a->ret || !b->ret ? a->ret != b->ret : !type_equal(tc, a->ret, b->ret)) {
+		return false;
+	}
+	size_t count = a->args ? rz_pvector_len(a->args) : 0;
+	if (count != (b->args ? rz_pvector_len(b->args) : 0)) {
+		return false;
+	}
+	for (size_t i = 0; i < count; i++) {
+		const RzCallableArg *x = rz_pvector_at(a->args, i);
+		const RzCallableArg *y = rz_pvector_at(b->args, i);
+		// the names of the arguments are not part of the type
+		if (!x->type || !y->type ? x->type != y->type : !type_equal(tc, x->type, y->type)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+RZ_IPI bool type_equal(TypeCompare *tc, const RzType *type1, const RzType *type2) {
 	if (type1->kind != type2->kind) {
 		return false;
 	}
 	switch (type1->kind) {
-	case RZ_TYPE_KIND_IDENTIFIER:
+	case RZ_TYPE_KIND_IDENTIFIER: {
+		const RzBaseType *b1 = anonymous_base_type(tc, type1->identifier.name);
+		const RzBaseType *b2 = b1 ? anonymous_base_type(tc, type2->identifier.name) : NULL;
+		if (b1 && b2) {
+			return base_type_equal(tc, b1, b2, true);
+		}
 		return !strcmp(type1->identifier.name, type2->identifier.name);
+	}
 	case RZ_TYPE_KIND_POINTER:
 		rz_return_val_if_fail(type1->pointer.type && type2->pointer.type, false);
-		return rz_types_equal(type1->pointer.type, type2->pointer.type);
+		return type_equal(tc, type1->pointer.type, type2->pointer.type);
 	case RZ_TYPE_KIND_ARRAY:
 		if (type1->array.count != type2->array.count) {
 			return false;
 		}
-		return rz_types_equal(type1->array.type, type2->array.type);
+		return type_equal(tc, type1->array.type, type2->array.type);
 	case RZ_TYPE_KIND_CALLABLE:
 		rz_return_val_if_fail(type1->callable && type2->callable, false);
+		if (anonymous_callable(tc, type1->callable) && anonymous_callable(tc, type2->callable)) {
+			return callable_signature_equal(tc, type1->callable, type2->callable);
+		}
 		rz_return_val_if_fail(type1->callable->name && type2->callable->name, false);
 		return !strcmp(type1->callable->name, type2->callable->name);
 	default:
@@ -1236,6 +1280,85 @@ RZ_API bool rz_types_equal(RZ_NONNULL const RzType *type1, RZ_NONNULL const RzTy
 	return false;
 }
 
+/**
+ * \brief Checks if two types are identical
+ *
+ * \param type1 RzType pointer
+ * \param type2 RzType pointer
+ */
+RZ_API bool rz_types_equal(RZ_NONNULL const RzType *type1, RZ_NONNULL const RzType *type2) {
+	rz_return_val_if_fail(type1 && type2, false);
+	TypeCompare tc;
+	type_compare_init(&tc, NULL);
+	bool ret = type_equal(&tc, type1, type2);
+	type_compare_fini(&tc);
+	return ret;
+}
+
+static inline ut64 hash_mix(ut64 h, ut64 v) {
+	return (h ^ v) * 0x100000001b3ULL;
+}
+
+static ut64 callable_signature_hash(TypeCompare *tc, ut64 h, const RzCallable *callable) {
+	h = hash_mix(h, callable->noret);
+	h = hash_mix(h, callable->has_unspecified_parameters);
+	h = hash_mix(h, rz_str_djb2_hash(callable->cc));
+	h = hash_mix(h, callable->ret ? type_hash(tc, callable->ret) : 0);
+	if (!callable->args) {
+		return h;
+	}
+	void **it;
+	rz_pvector_foreach (callable->args, it) {
+		RzCallableArg *arg = *it;
+		h = hash_mix(h, arg->type ? type_hash(tc, arg->type) : 0);
+	}
+	return h;
+}
+
+RZ_IPI ut64 type_hash(TypeCompare *tc, const RzType *type) {
+	ut64 h = hash_mix(0xcbf29ce484222325ULL, type->kind);
+	switch (type->kind) {
+	case RZ_TYPE_KIND_IDENTIFIER: {
+		const RzBaseType *btype = anonymous_base_type(tc, type->identifier.name);
+		if (btype) {
+			return hash_mix(h, base_type_hash(tc, btype, true));
+		}
+		return hash_mix(h, rz_str_djb2_hash(type->identifier.name));
+	}
+	case RZ_TYPE_KIND_POINTER:
+		return type->pointer.type ? hash_mix(h, type_hash(tc, type->pointer.type)) : h;
+	case RZ_TYPE_KIND_ARRAY:
+		h = hash_mix(h, type->array.count);
+		return type->array.type ? hash_mix(h, type_hash(tc, type->array.type)) : h;
+	case RZ_TYPE_KIND_CALLABLE:
+		if (!type->callable) {
+			return h;
+		}
+		if (anonymous_callable(tc, type->callable)) {
+			return callable_signature_hash(tc, h, type->callable);
+		}
+		return hash_mix(h, rz_str_djb2_hash(type->callable->name));
+	default:
+		return h;
+	}
+}
+
+/**
+ * \brief Hashes a type consistently with rz_types_equal()
+ *
+ * Types that are equal according to rz_types_equal() get the same hash.
+ *
+ * \param type RzType pointer
+ */
+RZ_API ut64 rz_type_hash(RZ_NONNULL const RzType *type) {
+	rz_return_val_if_fail(type, 0);
+	TypeCompare tc;
+	type_compare_init(&tc, NULL);
+	ut64 h = type_hash(&tc, type);
+	type_compare_fini(&tc);
+	return h;
+}
+
 /**
  * \brief Returns the RzBaseType for the chosen RzType
  *
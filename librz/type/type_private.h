@@ -0,0 +1,24 @@
+// SPDX-FileCopyrightText: 2023 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#ifndef _TYPE_PRIVATE_H_
+#define _TYPE_PRIVATE_H_
+
+#include <rz_type.h>
+
+/**
+ * State of comparing or hashing types, shared by the base types and the types they refer to
+ */
+typedef struct {
+	const RzTypeAnonymousResolver *resolver;
+	RzPVector /*<const RzBaseType *>*/ stack; ///< Anonymous base types being compared (in pairs) or hashed, to stop at cycles
+} TypeCompare;
+
+RZ_IPI void type_compare_init(TypeCompare *tc, const RzTypeAnonymousResolver *resolver);
+RZ_IPI void type_compare_fini(TypeCompare *tc);
+RZ_IPI bool type_equal(TypeCompare *tc, const RzType *a, const RzType *b);
+RZ_IPI ut64 type_hash(TypeCompare *tc, const RzType *type);
+RZ_IPI bool base_type_equal(TypeCompare *tc, const RzBaseType *a, const RzBaseType *b, bool anonymous);
+RZ_IPI ut64 base_type_hash(TypeCompare *tc, const RzBaseType *btype, bool anonymous);
+
+#endif
@@ -304,7 +304,11 @@ RZ_API bool rz_inflatew_buf(RZ_NONNULL RzBuffer *src, RZ_NONNULL RzBuffer *dst,
 			goto return_goto;
 		}
 
-		rz_buf_write(dst, dst_tmpbuf, stream.total_out);
+		if (rz_buf_write(dst, dst_tmpbuf, stream.total_out) != stream.total_out) {
+			// the destination may refuse to grow, e.g. to bound the inflated size
+			ret = false;
+			goto return_goto;
+		}
 	}
 
 	if (src_consumed) {
@@ -375,8 +379,10 @@ static bool lzma_action_buf(RZ_NONNULL RzBuffer *src, RZ_NONNULL RzBuffer *dst,
 	if (encode) {
 		ret = lzma_easy_encoder(&strm, LZMA_PRESET_DEFAULT, LZMA_CHECK_CRC64);
 	} else {
-		const ut64 memusage_limit = 0x1000000;
-		ret = lzma_stream_decoder(&strm, memusage_limit, 0);
+		// Enough for the 32 MiB dictionaries of xz compressed Linux kernels
+		const ut64 memusage_limit = 0x4000000;
+		// Accepts both the xz and the legacy .lzma formats
+		ret = lzma_auto_decoder(&strm, memusage_limit, 0);
 	}
 	if (ret != LZMA_OK) {
 		res = false;
@@ -211,6 +211,18 @@ RZ_API ut64 rz_file_size(const char *str) {
 	return (ut64)buf.st_size;
 }
 
+/**
+ * \brief Get the time of the last modification of \p str, in seconds since the epoch
+ */
+RZ_API ut64 rz_file_mtime(const char *str) {
+	rz_return_val_if_fail(!RZ_STR_ISEMPTY(str), 0);
+	StructStat buf = { 0 };
+	if (file_stat(str, &buf) == -1) {
+		return 0;
+	}
+	return (ut64)buf.st_mtime;
+}
+
 RZ_API bool rz_file_is_abspath(const char *file) {
 	rz_return_val_if_fail(!RZ_STR_ISEMPTY(file), 0);
 	return ((*file && file[1] == ':') || *file == '/');
@@ -19,6 +19,9 @@
 #define AR_ENTRY_MODE_OFF     (AR_ENTRY_DATE_LEN + AR_ENTRY_UID_LEN + AR_ENTRY_GID_LEN)
 #define AR_ENTRY_MODE_INVALID UT32_MAX
 
+// archives with opened members, indexed by "perm:arname"
+static HtPP /*<char *, RzArIndex *>*/ *ar_indexes = NULL;
+
 typedef struct Filetable {
 	char *data;
 	ut64 size;
@@ -34,6 +37,7 @@ static RzArFp *arfp_new(RzBuffer *b, bool shared_buf) {
 		f->buf = b;
 		f->start = 0;
 		f->end = 0;
+		f->index = NULL;
 	}
 	return f;
 }
@@ -50,11 +54,6 @@ bool ar_check_magic(RzBuffer *b) {
 	return true;
 }
 
-static inline void arf_clean_name(RzArFp *arf) {
-	free(arf->name);
-	arf->name = NULL;
-}
-
 static char *name_from_table(ut64 off, filetable *tbl) {
 	if (off > tbl->size) {
 		RZ_LOG_ERROR("ar: Malformed ar: name lookup out of bounds for header at offset 0x%" PFMT64x "\n", off);
@@ -160,90 +159,153 @@ static bool ar_read_entry(RzBuffer *buffer, char *e_name, ut64 *e_size, ut32 *e_
 	return true;
 }
 
-static void ar_sanitize_name(RzArFp *arf) {
+static void ar_sanitize_name(char *name) {
 	bool trim_end = true;
-	st64 len = strlen(arf->name);
+	st64 len = strlen(name);
 	if (len < 1) {
 		return;
 	}
 
 	// cleanup path which could be present in names
 	for (st64 i = len - 1; i >= 0; i--) {
-		if (trim_end && (arf->name[i] == '\\' || arf->name[i] == '/')) {
+		if (trim_end && (name[i] == '\\' || name[i] == '/')) {
 			// files shall never end with path delimeters.
-			arf->name[i] = '_';
-		} else if (arf->name[i] == '\\') {
+			name[i] = '_';
+		} else if (name[i] == '\\') {
 			// we use URI to access a single file
 			// thus the path needs to be unix only
-			arf->name[i] = '/';
-		} else if (!IS_PATH(arf->name[i])) {
-			arf->name[i] = '_';
+			name[i] = '/';
+		} else if (!IS_PATH(name[i])) {
+			name[i] = '_';
 		} else {
 			trim_end = false;
 		}
 	}
 }
 
-/* -1 error, 0 end, 1 continue */
-static int ar_parse_entry(RzArFp *arf, filetable *tbl, ut64 arsize) {
-	rz_return_val_if_fail(arf && arf->buf && tbl, -1);
-	RzBuffer *b = arf->buf;
-	// always ensure the strings are null terminated.
-	char e_name[AR_ENTRY_NAME_LEN + 1] = { 0 };
-	ut64 e_size = 0;
-	ut32 e_mode = 0;
-
-	ut64 e_offset = rz_buf_tell(b);
-	if (e_offset % 2 == 1) {
-		// headers start at even offset
-		ut8 tmp[1];
-		if (rz_buf_read(b, tmp, 1) != 1 || tmp[0] != '\n') {
-			return -1;
+static void ar_member_fini(void *e, void *user) {
+	RzArMember *m = e;
+	free(m->name);
+}
+
+/**
+ * Parses the GNU/SysV (`/`) and the 64-bit GNU (`/SYM64/`) symbol tables, which are
+ * big endian counters followed by the header offsets and the NUL separated symbols.
+ * The COFF import libraries use the same layout for their first linker member.
+ */
+static bool ar_armap_sysv(RzArIndex *idx, const ut8 *data, ut64 size, ut32 word) {
+	if (size < word) {
+		return false;
+	}
+	ut64 count = word == 8 ? rz_read_be64(data) : rz_read_be32(data);
+	if (count > (size - word) / word) {
+		return false;
+	}
+	ut64 strs_off = word + count * word;
+	char *strs = rz_str_newlen((const char *)data + strs_off, size - strs_off);
+	if (!strs) {
+		return false;
+	}
+	const char *s = strs;
+	const char *end = strs + (size - strs_off);
+	for (ut64 i = 0; i < count && s < end; i++) {
+		const ut8 *p = data + word + i * word;
+		RzArSymbol *sym = rz_vector_push(&idx->armap, NULL);
+		if (!sym) {
+			break;
 		}
-		e_offset++;
+		sym->header = word == 8 ? rz_read_be64(p) : rz_read_be32(p);
+		sym->name = s;
+		s += strlen(s) + 1;
 	}
+	idx->armap_strs = strs;
+	return true;
+}
 
-	if (!ar_read_entry(b, e_name, &e_size, &e_mode)) {
-		return -1;
+/**
+ * Parses the BSD (`__.SYMDEF`) and the 64-bit BSD (`__.SYMDEF_64`) symbol tables:
+ * the byte size of the ranlib array, the array of {string index, header offset}
+ * pairs, the byte size of the string table and then the string table itself,
+ * all made of \p word sized fields in the byte order of the producer.
+ */
+static bool ar_armap_bsd(RzArIndex *idx, const ut8 *data, ut64 size, ut32 word) {
+	if (size < 2 * word) {
+		return false;
 	}
-
-	/*
-	 * handle fake files
-	 */
-	if (!strcmp(e_name, "/")) {
-		// skip over symbol table
-		if (rz_buf_seek(b, e_size, RZ_BUF_CUR) <= 0 || rz_buf_tell(b) > arsize) {
-			RZ_LOG_ERROR("ar: Malformed ar: too short\n");
-			return -1;
-		}
-		// return next entry
-		return ar_parse_entry(arf, tbl, arsize);
-	} else if (!strcmp(e_name, "//")) {
-		// table of file names
-		if (tbl->data || tbl->size != 0) {
-			RZ_LOG_ERROR("ar: invalid ar file: two filename lookup tables (at 0x%" PFMT64x ", and 0x%" PFMT64x ")\n", tbl->offset, e_offset);
-			return -1;
+	bool big_endian = rz_read_ble(data, false, word * 8) > size - 2 * word;
+	ut64 ranlib_size = rz_read_ble(data, big_endian, word * 8);
+	if (ranlib_size > size - 2 * word || ranlib_size % (2 * word)) {
+		return false;
+	}
+	ut64 strs_size = rz_read_ble(data + word + ranlib_size, big_endian, word * 8);
+	ut64 strs_off = 2 * word + ranlib_size;
+	if (strs_size > size - strs_off) {
+		return false;
+	}
+	char *strs = rz_str_newlen((const char *)data + strs_off, strs_size);
+	if (!strs) {
+		return false;
+	}
+	for (ut64 i = 0; i < ranlib_size / (2 * word); i++) {
+		const ut8 *p = data + word + i * 2 * word;
+		ut64 strx = rz_read_ble(p, big_endian, word * 8);
+		if (strx >= strs_size) {
+			continue;
 		}
-		tbl->data = (char *)malloc(e_size + 1);
-		if (!tbl->data || rz_buf_read(b, (ut8 *)tbl->data, e_size) != e_size) {
-			return -1;
+		RzArSymbol *sym = rz_vector_push(&idx->armap, NULL);
+		if (!sym) {
+			break;
 		}
-		tbl->data[e_size] = '\0';
-		tbl->size = e_size;
-		tbl->offset = e_offset;
+		sym->header = rz_read_ble(p + word, big_endian, word * 8);
+		sym->name = strs + strx;
+	}
+	idx->armap_strs = strs;
+	return true;
+}
 
-		// return next entry
-		return ar_parse_entry(arf, tbl, arsize);
+static void ar_armap_load(RzArIndex *idx, ut64 e_offset, ut64 e_size, bool bsd, ut32 word) {
+	if (idx->armap_strs) {
+		// COFF import libraries have a second linker member, the first one is enough.
+		return;
+	}
+	ut8 *data = malloc(e_size);
+	if (!data) {
+		return;
+	}
+	if (rz_buf_read(idx->buf, data, e_size) != e_size ||
+		!(bsd ? ar_armap_bsd(idx, data, e_size, word) : ar_armap_sysv(idx, data, e_size, word))) {
+		RZ_LOG_WARN("ar: ignoring malformed symbol table at 0x%" PFMT64x "\n", e_offset);
+		rz_vector_clear(&idx->armap);
+	}
+	free(data);
+}
+
+static char *ar_member_name(RzBuffer *b, char *e_name, filetable *tbl, ut64 e_offset, ut64 *e_size) {
+	char *name = NULL;
+	if (rz_str_startswith(e_name, "#1/") && rz_str_isnumber(e_name + 3)) {
+		// BSD long names are stored in front of the member data
+		ut64 len = atol(e_name + 3);
+		if (len > *e_size || !(name = calloc(len + 1, 1)) ||
+			rz_buf_read(b, (ut8 *)name, len) != len) {
+			free(name);
+			RZ_LOG_ERROR("ar: invalid ar file: invalid file name in header at: 0x%" PFMT64x "\n", e_offset);
+			return NULL;
+		}
+		*e_size -= len;
+		return name;
 	}
 
-	/*
-	 * handle real files
-	 */
 	RzList *list = rz_str_split_duplist(e_name, "/", false); // don't strip spaces
-	if (rz_list_length(list) != 2) {
+	ut32 parts = rz_list_length(list);
+	if (parts == 1) {
+		// BSD short names are not terminated by '/'
+		name = rz_list_pop_head(list);
+		rz_list_free(list);
+		return name;
+	} else if (parts != 2) {
 		rz_list_free(list);
 		RZ_LOG_ERROR("ar: invalid ar file: invalid file name in header at: 0x%" PFMT64x "\n", e_offset);
-		return -1;
+		return NULL;
 	}
 
 	char *tmp = rz_list_pop_head(list);
@@ -251,39 +313,321 @@ static int ar_parse_entry(RzArFp *arf, filetable *tbl, ut64 arsize) {
 		free(tmp);
 		tmp = rz_list_pop(list);
 		if (rz_str_isnumber(tmp)) {
-			arf->name = name_from_table(atol(tmp), tbl);
+			name = name_from_table(atol(tmp), tbl);
 		} else {
 			RZ_LOG_ERROR("ar: invalid ar file: invalid file name in header at: 0x%" PFMT64x "\n", e_offset);
 		}
 		free(tmp);
 	} else {
-		arf->name = tmp;
+		name = tmp;
 		tmp = rz_list_pop(list);
 		if (tmp[0]) {
-			arf_clean_name(arf);
+			RZ_FREE(name);
 			RZ_LOG_ERROR("ar: invalid ar file: invalid file name in header at: 0x%" PFMT64x "\n", e_offset);
 		}
 		free(tmp);
 	}
 	rz_list_free(list);
+	return name;
+}
 
-	if (!arf->name) {
-		return -1;
+static bool ar_skip_data(RzBuffer *b, ut64 e_size, ut64 arsize) {
+	st64 cursor = rz_buf_tell(b);
+	return rz_buf_seek(b, e_size, RZ_BUF_CUR) >= cursor && rz_buf_tell(b) <= arsize;
+}
+
+/* -1 error, 0 end, 1 continue */
+static int ar_parse_entry(RzArIndex *idx, filetable *tbl, ut64 arsize, RzArMember *member) {
+	RzBuffer *b = idx->buf;
+	while (true) {
+		// always ensure the strings are null terminated.
+		char e_name[AR_ENTRY_NAME_LEN + 1] = { 0 };
+		ut64 e_size = 0;
+		ut32 e_mode = 0;
+
+		ut64 e_offset = rz_buf_tell(b);
+		if (e_offset % 2 == 1) {
+			// headers start at even offset
+			ut8 tmp[1];
+			if (rz_buf_read(b, tmp, 1) != 1 || tmp[0] != '\n') {
+				return -1;
+			}
+			e_offset++;
+		}
+
+		if (!ar_read_entry(b, e_name, &e_size, &e_mode)) {
+			return -1;
+		}
+		ut64 e_data = rz_buf_tell(b);
+		if (e_size > arsize - RZ_MIN(arsize, e_data)) {
+			RZ_LOG_ERROR("ar: Malformed ar: too short\n");
+			return -1;
+		}
+
+		/*
+		 * handle fake files
+		 */
+		if (!strcmp(e_name, "/") || !strcmp(e_name, "/SYM64/")) {
+			ar_armap_load(idx, e_offset, e_size, false, e_name[1] ? 8 : 4);
+			if (rz_buf_seek(b, e_data + e_size, RZ_BUF_SET) < 0) {
+				return -1;
+			}
+			continue;
+		} else if (!strcmp(e_name, "//")) {
+			// table of file names
+			if (tbl->data || tbl->size != 0) {
+				RZ_LOG_ERROR("ar: invalid ar file: two filename lookup tables (at 0x%" PFMT64x ", and 0x%" PFMT64x ")\n", tbl->offset, e_offset);
+				return -1;
+			}
+			tbl->data = (char *)malloc(e_size + 1);
+			if (!tbl->data || rz_buf_read(b, (ut8 *)tbl->data, e_size) != e_size) {
+				return -1;
+			}
+			tbl->data[e_size] = '\0';
+			tbl->size = e_size;
+			tbl->offset = e_offset;
+			continue;
+		}
+
+		/*
+		 * handle real files
+		 */
+		char *name = ar_member_name(b, e_name, tbl, e_offset, &e_size);
+		if (!name) {
+			return -1;
+		}
+		if (rz_str_startswith(name, "__.SYMDEF")) {
+			ut32 word = rz_str_startswith(name, "__.SYMDEF_64") ? 8 : 4;
+			free(name);
+			ut64 data = rz_buf_tell(b);
+			ar_armap_load(idx, e_offset, e_size, true, word);
+			if (rz_buf_seek(b, data + e_size, RZ_BUF_SET) < 0) {
+				return -1;
+			}
+			continue;
+		}
+
+		member->name = name;
+		member->header = e_offset;
+		member->start = rz_buf_tell(b);
+		member->end = member->start + e_size;
+		member->st_mode = e_mode;
+		ar_sanitize_name(member->name);
+
+		// skip over file content and make sure it is all there
+		if (!ar_skip_data(b, e_size, arsize)) {
+			RZ_LOG_ERROR("ar: Malformed ar: missing the end of %s (header offset: 0x%" PFMT64x ")\n", member->name, e_offset);
+			RZ_FREE(member->name);
+			return -1;
+		}
+		return 1;
 	}
+}
 
-	arf->start = rz_buf_tell(b);
-	arf->end = arf->start + e_size;
-	arf->st_mode = e_mode;
-	ar_sanitize_name(arf);
+/**
+ * Maps every symbol of the archive symbol table to the index of the
+ * member whose header offset it references; the first definition wins.
+ */
+static void ar_index_symbols(RzArIndex *idx) {
+	HtUU *headers = ht_uu_new0();
+	if (!headers) {
+		return;
+	}
+	RzArMember *m;
+	ut64 i = 0;
+	rz_vector_foreach(&idx->members, m) {
+		ht_uu_insert(headers, m->header, i++);
+	}
+	RzArSymbol *sym;
+	rz_vector_foreach(&idx->armap, sym) {
+		bool found = false;
+		ut64 member = ht_uu_find(headers, sym->header, &found);
+		if (found) {
+			ht_pu_insert(idx->symbols, sym->name, member);
+		}
+	}
+	ht_uu_free(headers);
+}
 
-	// skip over file content and make sure it is all there
-	if (rz_buf_seek(b, e_size, RZ_BUF_CUR) <= 0 || rz_buf_tell(b) > arsize) {
-		RZ_LOG_ERROR("ar: Malformed ar: missing the end of %s (header offset: 0x%" PFMT64x ")\n", arf->name, e_offset);
-		arf_clean_name(arf);
-		return -1;
+/**
+ * \brief Indexes all the members and the symbol table of an ar/lib file.
+ * \param arname the name of the .a file
+ * \param perm the permissions used to open it
+ * \return the archive index or NULL
+ *
+ * The archive headers are walked once; members can then be looked up by
+ * name or by the symbols they define without rescanning the archive and
+ * every opened member shares the same underlying buffer.
+ */
+RZ_API RZ_OWN RzArIndex *ar_index_new(RZ_NONNULL const char *arname, int perm) {
+	rz_return_val_if_fail(arname, NULL);
+	RzBuffer *b = rz_buf_new_file(arname, perm, 0);
+	if (!b) {
+		rz_sys_perror(__FUNCTION__);
+		return NULL;
+	}
+	if (!ar_check_magic(b)) {
+		rz_buf_free(b);
+		return NULL;
+	}
+	RzArIndex *idx = RZ_NEW0(RzArIndex);
+	if (!idx) {
+		rz_buf_free(b);
+		return NULL;
+	}
+	idx->buf = b;
+	rz_vector_init(&idx->members, sizeof(RzArMember), ar_member_fini, NULL);
+	rz_vector_init(&idx->armap, sizeof(RzArSymbol), NULL, NULL);
+	idx->names = ht_pu_new0();
+	idx->symbols = ht_pu_new0();
+	if (!idx->names || !idx->symbols) {
+		ar_index_free(idx);
+		return NULL;
 	}
 
-	return 1;
+	ut64 arsize = rz_buf_size(b);
+	filetable tbl = { NULL, 0, 0 };
+	RzArMember member = { 0 };
+	// on error the members parsed so far are kept, like the archive was truncated there.
+	while (ar_parse_entry(idx, &tbl, arsize, &member) > 0) {
+		ut64 i = rz_vector_len(&idx->members);
+		if (!rz_vector_push(&idx->members, &member)) {
+			free(member.name);
+			break;
+		}
+		// duplicated names resolve to the first member, like ar(1) does.
+		ht_pu_insert(idx->names, member.name, i);
+	}
+	free(tbl.data);
+	ar_index_symbols(idx);
+	return idx;
+}
+
+RZ_API void ar_index_free(RZ_NULLABLE RzArIndex *idx) {
+	if (!idx) {
+		return;
+	}
+	rz_vector_fini(&idx->members);
+	rz_vector_fini(&idx->armap);
+	free(idx->armap_strs);
+	ht_pu_free(idx->names);
+	ht_pu_free(idx->symbols);
+	rz_buf_free(idx->buf);
+	free(idx->key);
+	free(idx);
+}
+
+static void ar_index_unref(RzArIndex *idx) {
+	if (!idx || --idx->refs) {
+		return;
+	}
+	if (idx->key) {
+		ht_pp_delete(ar_indexes, idx->key);
+		if (!ar_indexes->count) {
+			ht_pp_free(ar_indexes);
+			ar_indexes = NULL;
+		}
+	}
+	ar_index_free(idx);
+}
+
+/**
+ * Returns a reference to the index of \p arname, reusing the one of the
+ * members still opened unless the archive changed on disk in the meantime.
+ */
+static RzArIndex *ar_index_get(const char *arname, int perm) {
+	char *key = rz_str_newf("%d:%s", perm, arname);
+	if (!key) {
+		return NULL;
+	}
+	ut64 mtime = rz_file_mtime(arname);
+	ut64 size = rz_file_size(arname);
+	RzArIndex *idx = ar_indexes ? ht_pp_find(ar_indexes, key, NULL) : NULL;
+	if (idx && idx->mtime == mtime && idx->size == size) {
+		free(key);
+		idx->refs++;
+		return idx;
+	}
+	if (idx) {
+		// the members still opened keep the stale index alive
+		ht_pp_delete(ar_indexes, key);
+		RZ_FREE(idx->key);
+	}
+	if (!ar_indexes && !(ar_indexes = ht_pp_new0())) {
+		free(key);
+		return NULL;
+	}
+	idx = ar_index_new(arname, perm);
+	if (!idx) {
+		if (!ar_indexes->count) {
+			ht_pp_free(ar_indexes);
+			ar_indexes = NULL;
+		}
+		free(key);
+		return NULL;
+	}
+	idx->mtime = mtime;
+	idx->size = size;
+	idx->refs = 1;
+	if (ht_pp_insert(ar_indexes, key, idx)) {
+		idx->key = key;
+	} else {
+		free(key);
+	}
+	return idx;
+}
+
+/**
+ * Opens a member of a cached index, the member keeps the index alive until it is closed.
+ */
+static RzArFp *ar_index_open_cached(RzArIndex *idx, const RzArMember *member) {
+	RzArFp *arf = ar_index_open(idx, member);
+	if (arf) {
+		arf->index = idx;
+		idx->refs++;
+	}
+	return arf;
+}
+
+/**
+ * \brief Returns the first member of the archive named \p name
+ */
+RZ_API RZ_BORROW RzArMember *ar_index_find(RZ_NONNULL RzArIndex *idx, RZ_NONNULL const char *name) {
+	rz_return_val_if_fail(idx && name, NULL);
+	bool found = false;
+	ut64 i = ht_pu_find(idx->names, name, &found);
+	return found ? rz_vector_index_ptr(&idx->members, i) : NULL;
+}
+
+/**
+ * \brief Returns the member defining \p symbol according to the archive symbol table
+ */
+RZ_API RZ_BORROW RzArMember *ar_index_find_symbol(RZ_NONNULL RzArIndex *idx, RZ_NONNULL const char *symbol) {
+	rz_return_val_if_fail(idx && symbol, NULL);
+	bool found = false;
+	ut64 i = ht_pu_find(idx->symbols, symbol, &found);
+	return found ? rz_vector_index_ptr(&idx->members, i) : NULL;
+}
+
+/**
+ * \brief Opens a member of the archive, sharing the buffer of the index.
+ */
+RZ_API RZ_OWN RzArFp *ar_index_open(RZ_NONNULL RzArIndex *idx, RZ_NONNULL const RzArMember *member) {
+	rz_return_val_if_fail(idx && member, NULL);
+	RzArFp *arf = arfp_new(rz_buf_ref(idx->buf), false);
+	if (!arf) {
+		rz_buf_free(idx->buf);
+		return NULL;
+	}
+	arf->name = strdup(member->name);
+	arf->start = member->start;
+	arf->end = member->end;
+	arf->st_mode = member->st_mode;
+	if (!arf->name) {
+		ar_close(arf);
+		return NULL;
+	}
+	return arf;
 }
 
 /**
@@ -300,69 +644,36 @@ RZ_API RzList /*<RzArFp *>*/ *ar_open_all(const char *arname, int perm) {
 		return NULL;
 	}
 
-	RzList *files = rz_list_newf((RzListFree)ar_close);
-	if (!files) {
-		rz_sys_perror(__FUNCTION__);
+	RzArIndex *idx = ar_index_get(arname, perm);
+	if (!idx) {
 		return NULL;
 	}
 
-	RzBuffer *b = rz_buf_new_file(arname, perm, 0);
-	if (!b) {
-		rz_list_free(files);
+	RzList *files = rz_list_newf((RzListFree)ar_close);
+	if (!files) {
+		ar_index_unref(idx);
 		rz_sys_perror(__FUNCTION__);
 		return NULL;
 	}
 
-	ut64 arsize = rz_buf_size(b);
-
-	if (!ar_check_magic(b)) {
-		rz_list_free(files);
-		rz_buf_free(b);
-		return NULL;
-	}
-
-	filetable tbl = { NULL, 0, 0 };
-	int res = -1;
-	bool shared = false;
-
-	do {
-		shared = !rz_list_empty(files);
-		RzArFp *arf = arfp_new(b, shared);
-		if (!arf) {
-			rz_list_free(files);
-			if (!shared) {
-				rz_buf_free(b);
-			}
-			return NULL;
-		}
-
-		if ((res = ar_parse_entry(arf, &tbl, arsize)) <= 0) {
-			// on error or when it has reached the EOF
-			free(tbl.data);
-			ar_close(arf);
-			return files;
-		}
-		// on linux the fmode is always 0, but arf->mode is non-zero
-		if (!arf->st_mode ||
-			((fmode = (arf->st_mode & S_IFMT)) && fmode != S_IFREG) ||
-			arf->start >= arf->end) {
+	RzArMember *m;
+	rz_vector_foreach(&idx->members, m) {
+		// on linux the fmode is always 0, but m->st_mode is non-zero
+		if (!m->st_mode ||
+			((fmode = (m->st_mode & S_IFMT)) && fmode != S_IFREG) ||
+			m->start >= m->end) {
 			// open only regular files.
-			// we do not need to close the buffer
-			arf->shared_buf = true;
-			ar_close(arf);
 			continue;
 		}
-
-		if (!rz_list_append(files, arf)) {
-			free(tbl.data);
+		RzArFp *arf = ar_index_open_cached(idx, m);
+		if (!arf || !rz_list_append(files, arf)) {
 			ar_close(arf);
 			rz_list_free(files);
-			return NULL;
+			files = NULL;
+			break;
 		}
-	} while (res > 0);
-
-	// this portion should never be reached
-	free(tbl.data);
+	}
+	ar_index_unref(idx);
 	return files;
 }
 
@@ -380,49 +691,45 @@ RZ_API RzArFp *ar_open_file(const char *arname, int perm, const char *filename)
 		return NULL;
 	}
 
-	RzBuffer *b = rz_buf_new_file(arname, perm, 0);
-	if (!b) {
-		rz_sys_perror(__FUNCTION__);
+	RzArIndex *idx = ar_index_get(arname, perm);
+	if (!idx) {
 		return NULL;
 	}
-
-	ut64 arsize = rz_buf_size(b);
-
-	if (!ar_check_magic(b)) {
-		rz_buf_free(b);
+	RzArMember *m = ar_index_find(idx, filename);
+	if (!m) {
+		RZ_LOG_ERROR("ar: Cound not find file '%s' in archive '%s'\n", filename, arname);
+		ar_index_unref(idx);
 		return NULL;
 	}
+	RzArFp *arf = ar_index_open_cached(idx, m);
+	ar_index_unref(idx);
+	return arf;
+}
 
-	RzArFp *arf = arfp_new(b, false);
-	if (!arf) {
-		rz_buf_free(b);
+/**
+ * \brief Open the member of a ar/lib file defining a symbol.
+ * \param arname the name of the .a file
+ * \param symbol the symbol to look up in the archive symbol table
+ * \return a handle of the member or NULL
+ */
+RZ_API RzArFp *ar_open_symbol(const char *arname, int perm, const char *symbol) {
+	if (!symbol || !arname) {
+		rz_sys_perror(__FUNCTION__);
 		return NULL;
 	}
 
-	filetable tbl = { NULL, 0, 0 };
-	int r;
-	while ((r = ar_parse_entry(arf, &tbl, arsize)) > 0) {
-		if (filename) {
-			if (!strcmp(filename, arf->name)) {
-				// found the right file
-				break;
-			}
-		}
-
-		// clean RzArFp for next loop
-		arf_clean_name(arf);
+	RzArIndex *idx = ar_index_get(arname, perm);
+	if (!idx) {
+		return NULL;
 	}
-
-	free(tbl.data);
-
-	if (r <= 0) {
-		if (r == 0 && filename) {
-			RZ_LOG_ERROR("ar: Cound not find file '%s' in archive '%s'\n", filename, arname);
-		}
-		ar_close(arf); // results in buf being free'd
+	RzArMember *m = ar_index_find_symbol(idx, symbol);
+	if (!m) {
+		RZ_LOG_ERROR("ar: Cound not find symbol '%s' in archive '%s'\n", symbol, arname);
+		ar_index_unref(idx);
 		return NULL;
 	}
-
+	RzArFp *arf = ar_index_open_cached(idx, m);
+	ar_index_unref(idx);
 	return arf;
 }
 
@@ -434,6 +741,7 @@ RZ_API void ar_close(RzArFp *f) {
 	if (!f->shared_buf) {
 		rz_buf_free(f->buf);
 	}
+	ar_index_unref(f->index);
 	free(f);
 }
 
@@ -4,6 +4,9 @@
 #ifndef RZ_AR_H
 #define RZ_AR_H
 #include <rz_util.h>
+#include <rz_util/ht_pp.h>
+#include <rz_util/ht_pu.h>
+#include <rz_util/ht_uu.h>
 
 typedef struct RZARFP {
 	char *name;
@@ -12,11 +15,44 @@ typedef struct RZARFP {
 	RzBuffer *buf;
 	bool shared_buf;
 	ut32 st_mode;
+	struct rz_ar_index_t *index; ///< cached index the member was opened from, if any
 } RzArFp;
 
+typedef struct rz_ar_member_t {
+	char *name; ///< sanitized member name
+	ut64 header; ///< offset of the member header within the archive
+	ut64 start; ///< offset of the member data within the archive
+	ut64 end; ///< end offset of the member data within the archive
+	ut32 st_mode;
+} RzArMember;
+
+typedef struct rz_ar_symbol_t {
+	ut64 header; ///< offset of the header of the member defining the symbol
+	const char *name; ///< points into RzArIndex.armap_strs
+} RzArSymbol;
+
+typedef struct rz_ar_index_t {
+	RzBuffer *buf; ///< the whole archive, shared by the opened members
+	RzVector /*<RzArMember>*/ members; ///< all members, in archive order
+	RzVector /*<RzArSymbol>*/ armap; ///< the archive symbol table (GNU, BSD or COFF)
+	char *armap_strs; ///< string table of the archive symbol table
+	HtPU /*<char *, ut64>*/ *names; ///< member name -> index of its first occurrence in members
+	HtPU /*<char *, ut64>*/ *symbols; ///< symbol name -> index in members of the member defining it
+	char *key; ///< key of the index in the cache of the opened archives, NULL when not cached
+	ut64 mtime; ///< modification time of the archive when it was indexed
+	ut64 size; ///< size of the archive when it was indexed
+	ut32 refs; ///< references held by the cache users and the opened members
+} RzArIndex;
+
 /* Offset passed is always the real io->off of the inspected file,
  * the functions automatically translate it to relative offset within the archive */
+RZ_API RZ_OWN RzArIndex *ar_index_new(RZ_NONNULL const char *arname, int perm);
+RZ_API void ar_index_free(RZ_NULLABLE RzArIndex *idx);
+RZ_API RZ_BORROW RzArMember *ar_index_find(RZ_NONNULL RzArIndex *idx, RZ_NONNULL const char *name);
+RZ_API RZ_BORROW RzArMember *ar_index_find_symbol(RZ_NONNULL RzArIndex *idx, RZ_NONNULL const char *symbol);
+RZ_API RZ_OWN RzArFp *ar_index_open(RZ_NONNULL RzArIndex *idx, RZ_NONNULL const RzArMember *member);
 RZ_API RzArFp *ar_open_file(const char *arname, int perm, const char *filename);
+RZ_API RzArFp *ar_open_symbol(const char *arname, int perm, const char *symbol);
 RZ_API RzList /*<RzArFp *>*/ *ar_open_all(const char *arname, int perm);
 RZ_API void ar_close(RzArFp *f);
 RZ_API int ar_read_at(RzArFp *f, ut64 off, void *buf, int count);
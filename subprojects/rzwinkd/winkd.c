@@ -870,7 +870,7 @@ static inline bool is_page_large(RZ_BORROW RZ_NONNULL WindCtx *ctx, ut64 page_de
 // http://blogs.msdn.com/b/ntdebugging/archive/2010/02/05/understanding-pte-part-1-let-s-get-physical.aspx
 // http://blogs.msdn.com/b/ntdebugging/archive/2010/04/14/understanding-pte-part2-flags-and-large-pages.aspx
 // http://blogs.msdn.com/b/ntdebugging/archive/2010/06/22/part-3-understanding-pte-non-pae-and-x64.aspx
-bool winkd_va_to_pa(RZ_BORROW RZ_NONNULL WindCtx *ctx, ut64 directory_table, ut64 va, RZ_BORROW RZ_NONNULL RZ_OUT ut64 *pa) {
+static bool va_to_pa_walk(RZ_BORROW RZ_NONNULL WindCtx *ctx, ut64 directory_table, ut64 va, RZ_BORROW RZ_NONNULL RZ_OUT ut64 *pa) {
 	ut64 pml4i, pdpi, pdi, pti;
 	ut64 tmp, mask;
 
@@ -958,6 +958,27 @@ bool winkd_va_to_pa(RZ_BORROW RZ_NONNULL WindCtx *ctx, ut64 directory_table, ut6
 	return false;
 }
 
+bool winkd_va_to_pa(RZ_BORROW RZ_NONNULL WindCtx *ctx, ut64 directory_table, ut64 va, RZ_BORROW RZ_NONNULL RZ_OUT ut64 *pa) {
+	if (!ctx->tlb) {
+		return va_to_pa_walk(ctx, directory_table, va, pa);
+	}
+	// direct-mapped on the virtual page, each reused entry costs a new walk of the page tables
+	const ut64 vpage = va >> 12;
+	WindTlbEntry *entry = &ctx->tlb[(vpage ^ (directory_table >> 12)) & (WINKD_TLB_SIZE - 1)];
+	if (entry->valid && entry->vpage == vpage && entry->dir_base_table == directory_table) {
+		*pa = (entry->ppage << 12) | (va & 0xfff);
+		return true;
+	}
+	if (!va_to_pa_walk(ctx, directory_table, va, pa)) {
+		return false;
+	}
+	entry->dir_base_table = directory_table;
+	entry->vpage = vpage;
+	entry->ppage = *pa >> 12;
+	entry->valid = true;
+	return true;
+}
+
 static bool winkd_send_state_manipulate_req(RZ_BORROW RZ_NONNULL KdCtx *ctx, kd_req_t *req, RZ_BORROW RZ_NULLABLE RZ_IN const ut8 *buf, const ut32 buf_len, RZ_BORROW RZ_NULLABLE RZ_OUT kd_packet_t **pkt) {
 	if (pkt) {
 		*pkt = NULL;
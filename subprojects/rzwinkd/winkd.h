@@ -73,6 +73,16 @@ typedef struct {
 	int f[O_Max];
 } Profile;
 
+#define WINKD_TLB_SIZE 0x400
+
+// Cached translation of a virtual page, see winkd_va_to_pa()
+typedef struct {
+	ut64 dir_base_table;
+	ut64 vpage;
+	ut64 ppage;
+	bool valid;
+} WindTlbEntry;
+
 typedef int WindReadAt(RZ_NONNULL void *user, ut64 address, RZ_BORROW RZ_NONNULL RZ_OUT ut8 *buf, int count);
 typedef int WindWriteAt(RZ_NONNULL void *user, ut64 address, RZ_BORROW RZ_NONNULL RZ_IN const ut8 *buf, int count);
 
@@ -90,6 +100,7 @@ typedef struct _WindCtx {
 	bool is_arm;
 	WindProc target;
 	WindThread target_thread;
+	WindTlbEntry *tlb; // WINKD_TLB_SIZE entries, only for targets whose page tables do not change by themselves
 } WindCtx;
 
 typedef struct _KdCtx {
@@ -141,6 +152,14 @@ static inline ut64 winkd_read_ptr_at(RZ_BORROW RZ_NONNULL WindCtx *ctx, RZ_BORRO
 static inline void winkd_ctx_fini(RZ_BORROW RZ_NONNULL WindCtx *ctx) {
 	free(ctx->user);
 	free(ctx->profile);
+	free(ctx->tlb);
+}
+
+// Drop all cached translations, needed whenever physical memory is written
+static inline void winkd_tlb_flush(RZ_BORROW RZ_NONNULL WindCtx *ctx) {
+	if (ctx->tlb) {
+		memset(ctx->tlb, 0, WINKD_TLB_SIZE * sizeof(WindTlbEntry));
+	}
 }
 
 // grep -e "^winkd_" subprojects/rzwinkd/winkd.c | sed -e 's/ {$/;/' -e 's/^/int /'
@@ -24,6 +24,7 @@ static bool block_check_invariants(RzAnalysis *analysis) {
 				mu_assert_ptrneq (fcn, fcn2, "duplicate function in basic block");
 			}
 			mu_assert ("block references function, but function does not reference block", rz_list_contains (fcn->bbs, block));
+			mu_assert ("block is not in the function index", rz_analysis_function_contains_block (fcn, block));
 		}
 	}
 
@@ -50,6 +51,8 @@ static bool block_check_invariants(RzAnalysis *analysis) {
 			mu_assert ("function references block, but block does not reference function", rz_list_contains (block->fcns, fcn));
 		}
 
+		mu_assert_eq (fcn->bbs_index->count, rz_list_length (fcn->bbs), "function block index count");
+
 		if (fcn->meta._min != UT64_MAX) {
 			mu_assert_eq (fcn->meta._min, min, "function min wrong");
 			mu_assert_eq (fcn->meta._max, max, "function max wrong");
@@ -0,0 +1,157 @@
+// SPDX-FileCopyrightText: 2023 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_analysis.h>
+#include "minunit.h"
+
+// struct point { int x; int y; }; int get(struct point *p);
+static const ut32 btf_types[] = {
+	// [1] INT "int" size 4, signed, 32 bits
+	1, 0x01000000, 4, 0x01000020,
+	// [2] STRUCT "point" size 8
+	5, 0x04000002, 8,
+	11, 1, 0,
+	13, 1, 32,
+	// [3] PTR to [2]
+	0, 0x02000000, 2,
+	// [4] FUNC_PROTO returning [1]
+	0, 0x0d000001, 1,
+	19, 3,
+	// [5] FUNC "get" of [4]
+	15, 0x0c000000, 4
+};
+
+static const char btf_strs[] = "\0int\0point\0x\0y\0get\0p";
+
+static RzBuffer *btf_buf_new_from(const ut32 *types, size_t types_count, const char *strs, size_t strs_len) {
+	ut32 types_len = types_count * sizeof(ut32);
+	ut8 hdr[0x18] = { 0 };
+	rz_write_le16(hdr, 0xeb9f);
+	hdr[2] = 1;
+	rz_write_le32(hdr + 4, sizeof(hdr));
+	rz_write_le32(hdr + 8, 0);
+	rz_write_le32(hdr + 12, types_len);
+	rz_write_le32(hdr + 16, types_len);
+	rz_write_le32(hdr + 20, strs_len);
+	RzBuffer *buf = rz_buf_new_empty(0);
+	rz_buf_append_bytes(buf, hdr, sizeof(hdr));
+	for (size_t i = 0; i < types_count; i++) {
+		ut8 word[4];
+		rz_write_le32(word, types[i]);
+		rz_buf_append_bytes(buf, word, sizeof(word));
+	}
+	rz_buf_append_bytes(buf, (const ut8 *)strs, strs_len);
+	return buf;
+}
+
+static RzBuffer *btf_buf_new(void) {
+	return btf_buf_new_from(btf_types, RZ_ARRAY_SIZE(btf_types), btf_strs, sizeof(btf_strs));
+}
+
+static bool test_btf_load(void) {
+	RzTypeDB *typedb = rz_type_db_new();
+	RzBuffer *buf = btf_buf_new();
+	RzAnalysisBTF *btf = rz_analysis_btf_new(typedb, buf);
+	rz_buf_free(buf);
+	mu_assert_notnull(btf, "btf");
+	mu_assert_eq(rz_analysis_btf_types_count(btf), 6, "types count");
+
+	RzType *type = rz_analysis_btf_type_load(btf, 3);
+	mu_assert_notnull(type, "pointer type");
+	mu_assert_streq_free(rz_type_as_string(typedb, type), "struct point *", "pointer type");
+	rz_type_free(type);
+
+	RzBaseType *base = rz_type_db_get_base_type(typedb, "point");
+	mu_assert_notnull(base, "struct loaded on demand");
+	mu_assert_eq(base->kind, RZ_BASE_TYPE_KIND_STRUCT, "struct kind");
+	mu_assert_eq(base->size, 64, "struct size");
+	mu_assert_eq(rz_vector_len(&base->struct_data.members), 2, "members");
+	RzTypeStructMember *member = rz_vector_index_ptr(&base->struct_data.members, 1);
+	mu_assert_streq(member->name, "y", "member name");
+	mu_assert_eq(member->offset, 4, "member offset");
+	mu_assert_eq(member->size, 32, "member size");
+	mu_assert_null(rz_type_func_get(typedb, "get"), "functions not loaded yet");
+
+	mu_assert_eq(rz_analysis_btf_load_all(btf), 1, "remaining function");
+	mu_assert_eq(rz_type_func_args_count(typedb, "get"), 1, "function args");
+	mu_assert_streq_free(rz_type_as_string(typedb, rz_type_func_ret(typedb, "get")), "int", "function return");
+	mu_assert_streq_free(rz_type_as_string(typedb, rz_type_func_args_type(typedb, "get", 0)), "struct point *", "function arg");
+
+	rz_analysis_btf_free(btf);
+	rz_type_db_free(typedb);
+	mu_end;
+}
+
+static bool test_btf_invalid(void) {
+	RzTypeDB *typedb = rz_type_db_new();
+	RzBuffer *buf = btf_buf_new();
+	// end the type section in the middle of a record
+	rz_buf_write_at(buf, 12, (const ut8 *)"\x44\x00\x00\x00", 4);
+	mu_assert_null(rz_analysis_btf_new(typedb, buf), "truncated records");
+	rz_buf_write_at(buf, 0, (const ut8 *)"\x00\x00", 2);
+	mu_assert_null(rz_analysis_btf_new(typedb, buf), "bad magic");
+	rz_buf_free(buf);
+	rz_type_db_free(typedb);
+	mu_end;
+}
+
+// an array containing itself and enums with the signedness in kind_flag
+static const ut32 btf_odd_types[] = {
+	// [1] INT "int" size 4, signed, 32 bits
+	1, 0x01000000, 4, 0x01000020,
+	// [2] ARRAY of [2] indexed by [1], 2 elements
+	0, 0x03000000, 0,
+	2, 1, 2,
+	// [3] STRUCT "loop" size 8
+	5, 0x04000001, 8,
+	10, 2, 0,
+	// [4] ENUM "color" size 4, unsigned
+	12, 0x06000001, 4,
+	18, 0xffffffff,
+	// [5] ENUM "sign" size 4, signed
+	22, 0x86000001, 4,
+	27, 0xffffffff
+};
+
+static const char btf_odd_strs[] = "\0int\0loop\0a\0color\0RED\0sign\0NEG";
+
+static bool test_btf_odd_types(void) {
+	RzTypeDB *typedb = rz_type_db_new();
+	RzBuffer *buf = btf_buf_new_from(btf_odd_types, RZ_ARRAY_SIZE(btf_odd_types), btf_odd_strs, sizeof(btf_odd_strs));
+	RzAnalysisBTF *btf = rz_analysis_btf_new(typedb, buf);
+	rz_buf_free(buf);
+	mu_assert_notnull(btf, "btf");
+
+	rz_type_free(rz_analysis_btf_type_load(btf, 3));
+	RzBaseType *base = rz_type_db_get_base_type(typedb, "loop");
+	mu_assert_notnull(base, "struct with a recursive array");
+	RzTypeStructMember *member = rz_vector_head(&base->struct_data.members);
+	mu_assert_eq(member->size, 0, "unbounded array size");
+
+	rz_type_free(rz_analysis_btf_type_load(btf, 4));
+	base = rz_type_db_get_base_type(typedb, "color");
+	mu_assert_notnull(base, "unsigned enum");
+	RzTypeEnumCase *cas = rz_vector_head(&base->enum_data.cases);
+	mu_assert_eq(cas->val, 0xffffffff, "unsigned enum value");
+	mu_assert_streq(base->type->identifier.name, "unsigned int", "unsigned enum type");
+
+	rz_type_free(rz_analysis_btf_type_load(btf, 5));
+	base = rz_type_db_get_base_type(typedb, "sign");
+	mu_assert_notnull(base, "signed enum");
+	cas = rz_vector_head(&base->enum_data.cases);
+	mu_assert_eq(cas->val, -1, "signed enum value");
+	mu_assert_streq(base->type->identifier.name, "int", "signed enum type");
+
+	rz_analysis_btf_free(btf);
+	rz_type_db_free(typedb);
+	mu_end;
+}
+
+bool all_tests() {
+	mu_run_test(test_btf_load);
+	mu_run_test(test_btf_invalid);
+	mu_run_test(test_btf_odd_types);
+	return tests_passed != tests_run;
+}
+
+mu_main(all_tests)
@@ -0,0 +1,62 @@
+// SPDX-FileCopyrightText: 2023 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_analysis.h>
+#include "minunit.h"
+
+static bool test_class_rebase(void) {
+	RzAnalysis *analysis = rz_analysis_new();
+	rz_analysis_class_create(analysis, "Foo");
+
+	RzAnalysisMethod meth = { 0 };
+	meth.name = "get";
+	meth.real_name = "get<char, int>";
+	meth.addr = 0x1000;
+	meth.vtable_offset = 8;
+	meth.method_type = RZ_ANALYSIS_CLASS_METHOD_VIRTUAL;
+	mu_assert_eq(rz_analysis_class_method_set(analysis, "Foo", &meth), RZ_ANALYSIS_CLASS_ERR_SUCCESS, "method set");
+	meth.name = "Foo";
+	meth.real_name = "Foo";
+	meth.addr = 0x1100;
+	meth.vtable_offset = -1;
+	meth.method_type = RZ_ANALYSIS_CLASS_METHOD_CONSTRUCTOR;
+	mu_assert_eq(rz_analysis_class_method_set(analysis, "Foo", &meth), RZ_ANALYSIS_CLASS_ERR_SUCCESS, "method set");
+
+	RzAnalysisVTable vtable = { 0 };
+	vtable.addr = 0x2000;
+	vtable.offset = 0x10;
+	vtable.size = 0x18;
+	mu_assert_eq(rz_analysis_class_vtable_set(analysis, "Foo", &vtable), RZ_ANALYSIS_CLASS_ERR_SUCCESS, "vtable set");
+	char *vtable_id = vtable.id;
+
+	rz_analysis_class_rebase(analysis, 0x400000);
+
+	mu_assert_eq(rz_analysis_class_method_get(analysis, "Foo", "get", &meth), RZ_ANALYSIS_CLASS_ERR_SUCCESS, "method get");
+	mu_assert_eq(meth.addr, 0x401000, "rebased method");
+	mu_assert_eq(meth.vtable_offset, 8, "vtable offset");
+	mu_assert_eq(meth.method_type, RZ_ANALYSIS_CLASS_METHOD_VIRTUAL, "method type");
+	mu_assert_streq(meth.real_name, "get<char, int>", "real name");
+	rz_analysis_class_method_fini(&meth);
+	mu_assert_eq(rz_analysis_class_method_get(analysis, "Foo", "Foo", &meth), RZ_ANALYSIS_CLASS_ERR_SUCCESS, "method get");
+	mu_assert_eq(meth.addr, 0x401100, "rebased method");
+	mu_assert_eq(meth.vtable_offset, -1, "not virtual");
+	mu_assert_eq(meth.method_type, RZ_ANALYSIS_CLASS_METHOD_CONSTRUCTOR, "method type");
+	rz_analysis_class_method_fini(&meth);
+
+	mu_assert_eq(rz_analysis_class_vtable_get(analysis, "Foo", vtable_id, &vtable), RZ_ANALYSIS_CLASS_ERR_SUCCESS, "vtable get");
+	mu_assert_eq(vtable.addr, 0x402000, "rebased vtable");
+	mu_assert_eq(vtable.offset, 0x10, "vtable offset");
+	mu_assert_eq(vtable.size, 0x18, "vtable size");
+	rz_analysis_class_vtable_fini(&vtable);
+	free(vtable_id);
+
+	rz_analysis_free(analysis);
+	mu_end;
+}
+
+bool all_tests() {
+	mu_run_test(test_class_rebase);
+	return tests_passed != tests_run;
+}
+
+mu_main(all_tests)
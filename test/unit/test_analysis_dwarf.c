@@ -0,0 +1,205 @@
+// SPDX-FileCopyrightText: 2023 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_analysis.h>
+#include <rz_bin_dwarf.h>
+#include "minunit.h"
+
+static const ut8 dwarf_abbrev[] = {
+	// [1] compile_unit, children: name string
+	0x01, 0x11, 0x01, 0x03, 0x08, 0x00, 0x00,
+	// [2] base_type: name string, byte_size data1, encoding data1
+	0x02, 0x24, 0x00, 0x03, 0x08, 0x0b, 0x0b, 0x3e, 0x0b, 0x00, 0x00,
+	// [3] structure_type, children: name string, byte_size data1
+	0x03, 0x13, 0x01, 0x03, 0x08, 0x0b, 0x0b, 0x00, 0x00,
+	// [4] member: name string, type ref4, data_member_location data1
+	0x04, 0x0d, 0x00, 0x03, 0x08, 0x49, 0x13, 0x38, 0x0b, 0x00, 0x00,
+	// [5] typedef: name string, type ref4
+	0x05, 0x16, 0x00, 0x03, 0x08, 0x49, 0x13, 0x00, 0x00,
+	// [6] pointer_type: byte_size data1, type ref4
+	0x06, 0x0f, 0x00, 0x0b, 0x0b, 0x49, 0x13, 0x00, 0x00,
+	// [7] structure_type, children: byte_size data1
+	0x07, 0x13, 0x01, 0x0b, 0x0b, 0x00, 0x00,
+	// [8] subroutine_type, children
+	0x08, 0x15, 0x01, 0x00, 0x00,
+	// [9] formal_parameter: type ref4
+	0x09, 0x05, 0x00, 0x49, 0x13, 0x00, 0x00,
+	0x00
+};
+
+// Three units each defining a different struct foo and a struct holder pointing to it
+static const ut8 dwarf_info[] = {
+	// unit 0: struct foo { int a; }; typedef struct foo foo; struct holder { struct foo *p; };
+	0x46, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08,
+	0x01, 'c', 'u', '0', '.', 'c', 0x00,
+	0x02, 'i', 'n', 't', 0x00, 0x04, 0x05,
+	0x03, 'f', 'o', 'o', 0x00, 0x04,
+	0x04, 'a', 0x00, 0x12, 0x00, 0x00, 0x00, 0x00,
+	0x00,
+	0x05, 'f', 'o', 'o', 0x00, 0x19, 0x00, 0x00, 0x00,
+	0x03, 'h', 'o', 'l', 'd', 'e', 'r', 0x00, 0x08,
+	0x04, 'p', 0x00, 0x43, 0x00, 0x00, 0x00, 0x00,
+	0x00,
+	0x06, 0x08, 0x19, 0x00, 0x00, 0x00,
+	0x00,
+	// unit 1: struct foo { int b; }; struct holder { struct foo *p; };
+	0x3d, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08,
+	0x01, 'c', 'u', '1', '.', 'c', 0x00,
+	0x02, 'i', 'n', 't', 0x00, 0x04, 0x05,
+	0x03, 'f', 'o', 'o', 0x00, 0x04,
+	0x04, 'b', 0x00, 0x12, 0x00, 0x00, 0x00, 0x00,
+	0x00,
+	0x03, 'h', 'o', 'l', 'd', 'e', 'r', 0x00, 0x08,
+	0x04, 'p', 0x00, 0x3a, 0x00, 0x00, 0x00, 0x00,
+	0x00,
+	0x06, 0x08, 0x19, 0x00, 0x00, 0x00,
+	0x00,
+	// unit 2: struct foo { int a; int b; }; struct holder { struct foo *p; };
+	0x45, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08,
+	0x01, 'c', 'u', '2', '.', 'c', 0x00,
+	0x02, 'i', 'n', 't', 0x00, 0x04, 0x05,
+	0x03, 'f', 'o', 'o', 0x00, 0x08,
+	0x04, 'a', 0x00, 0x12, 0x00, 0x00, 0x00, 0x00,
+	0x04, 'b', 0x00, 0x12, 0x00, 0x00, 0x00, 0x04,
+	0x00,
+	0x03, 'h', 'o', 'l', 'd', 'e', 'r', 0x00, 0x08,
+	0x04, 'p', 0x00, 0x42, 0x00, 0x00, 0x00, 0x00,
+	0x00,
+	0x06, 0x08, 0x19, 0x00, 0x00, 0x00,
+	0x00
+};
+
+// Two units defining the same struct bar with an anonymous struct member and a function pointer member
+static const ut8 dwarf_info_anonymous[] = {
+	// unit 0: struct bar { struct { int x; } a; void (*f)(int); };
+	0x45, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08,
+	0x01, 'c', 'u', '0', '.', 'c', 0x00,
+	0x02, 'i', 'n', 't', 0x00, 0x04, 0x05,
+	0x07, 0x04,
+	0x04, 'x', 0x00, 0x12, 0x00, 0x00, 0x00, 0x00,
+	0x00,
+	0x08,
+	0x09, 0x12, 0x00, 0x00, 0x00,
+	0x00,
+	0x06, 0x08, 0x24, 0x00, 0x00, 0x00,
+	0x03, 'b', 'a', 'r', 0x00, 0x10,
+	0x04, 'a', 0x00, 0x19, 0x00, 0x00, 0x00, 0x00,
+	0x04, 'f', 0x00, 0x2b, 0x00, 0x00, 0x00, 0x08,
+	0x00,
+	0x00,
+	// unit 1: the same in another unit, so the anonymous types get other names
+	0x45, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08,
+	0x01, 'c', 'u', '1', '.', 'c', 0x00,
+	0x02, 'i', 'n', 't', 0x00, 0x04, 0x05,
+	0x07, 0x04,
+	0x04, 'x', 0x00, 0x12, 0x00, 0x00, 0x00, 0x00,
+	0x00,
+	0x08,
+	0x09, 0x12, 0x00, 0x00, 0x00,
+	0x00,
+	0x06, 0x08, 0x24, 0x00, 0x00, 0x00,
+	0x03, 'b', 'a', 'r', 0x00, 0x10,
+	0x04, 'a', 0x00, 0x19, 0x00, 0x00, 0x00, 0x00,
+	0x04, 'f', 0x00, 0x2b, 0x00, 0x00, 0x00, 0x08,
+	0x00,
+	0x00
+};
+
+static RzBinEndianReader *reader_new(const ut8 *data, size_t size, const char *section) {
+	RzBinEndianReader *reader = RZ_NEW0(RzBinEndianReader);
+	if (!reader) {
+		return NULL;
+	}
+	reader->buffer = rz_buf_new_with_bytes(data, size);
+	reader->section_name = strdup(section);
+	reader->relocations = ht_up_new0();
+	return reader;
+}
+
+static RzBinDWARF *dwarf_new(const ut8 *info, size_t info_size) {
+	RzBinDWARF *dw = RZ_NEW0(RzBinDWARF);
+	if (!dw) {
+		return NULL;
+	}
+	dw->abbrev = rz_bin_dwarf_abbrev_new(reader_new(dwarf_abbrev, sizeof(dwarf_abbrev), ".debug_abbrev"));
+	if (dw->abbrev) {
+		dw->info = rz_bin_dwarf_info_from_buf(reader_new(info, info_size, ".debug_info"), dw);
+	}
+	return dw;
+}
+
+static char *member_type(RzTypeDB *typedb, const char *name, size_t idx) {
+	RzBaseType *base = rz_type_db_get_base_type(typedb, name);
+	if (!base || base->kind != RZ_BASE_TYPE_KIND_STRUCT || idx >= rz_vector_len(&base->struct_data.members)) {
+		return NULL;
+	}
+	RzTypeStructMember *member = rz_vector_index_ptr(&base->struct_data.members, idx);
+	char *type = rz_type_as_string(typedb, member->type);
+	char *ret = rz_str_newf("%s %s", type, member->name);
+	free(type);
+	return ret;
+}
+
+static bool test_dwarf_same_name_types(void) {
+	RzAnalysis *analysis = rz_analysis_new();
+	rz_analysis_use(analysis, "x86");
+	rz_analysis_set_bits(analysis, 64);
+	rz_analysis_set_cpu(analysis, "x86");
+	RzBinDWARF *dw = dwarf_new(dwarf_info, sizeof(dwarf_info));
+	mu_assert_notnull(dw, "dwarf");
+	mu_assert_notnull(dw->info, "debug info");
+	rz_analysis_dwarf_process_info(analysis, dw);
+	RzTypeDB *typedb = analysis->typedb;
+
+	// the typedef keeps the name and points to the struct of its unit
+	RzBaseType *base = rz_type_db_get_base_type(typedb, "foo");
+	mu_assert_notnull(base, "typedef foo");
+	mu_assert_eq(base->kind, RZ_BASE_TYPE_KIND_TYPEDEF, "typedef kind");
+	mu_assert_streq_free(rz_type_as_string(typedb, base->type), "struct foo_0", "typedef target");
+
+	mu_assert_streq_free(member_type(typedb, "foo_0", 0), "int a", "first struct foo");
+	mu_assert_streq_free(member_type(typedb, "foo_1", 0), "int b", "second struct foo");
+	mu_assert_streq_free(member_type(typedb, "foo_2", 1), "int b", "third struct foo");
+
+	// the structs pointing to different struct foo became different as well
+	mu_assert_streq_free(member_type(typedb, "holder", 0), "struct foo_0 * p", "first holder");
+	mu_assert_streq_free(member_type(typedb, "holder_0", 0), "struct foo_1 * p", "second holder");
+	mu_assert_streq_free(member_type(typedb, "holder_1", 0), "struct foo_2 * p", "third holder");
+	mu_assert_null(rz_type_db_get_base_type(typedb, "holder_2"), "no more holders");
+
+	rz_bin_dwarf_free(dw);
+	rz_analysis_free(analysis);
+	mu_end;
+}
+
+static bool test_dwarf_same_anonymous_types(void) {
+	RzAnalysis *analysis = rz_analysis_new();
+	rz_analysis_use(analysis, "x86");
+	rz_analysis_set_bits(analysis, 64);
+	rz_analysis_set_cpu(analysis, "x86");
+	RzBinDWARF *dw = dwarf_new(dwarf_info_anonymous, sizeof(dwarf_info_anonymous));
+	mu_assert_notnull(dw, "dwarf");
+	mu_assert_notnull(dw->info, "debug info");
+	rz_analysis_dwarf_process_info(analysis, dw);
+	RzTypeDB *typedb = analysis->typedb;
+
+	// the anonymous types of both units have the same structure, so both struct bar are the same
+	RzBaseType *base = rz_type_db_get_base_type(typedb, "bar");
+	mu_assert_notnull(base, "struct bar");
+	mu_assert_eq(base->kind, RZ_BASE_TYPE_KIND_STRUCT, "struct kind");
+	mu_assert_eq(rz_vector_len(&base->struct_data.members), 2, "struct bar members");
+	mu_assert_null(rz_type_db_get_base_type(typedb, "bar_0"), "struct bar not renamed");
+	mu_assert_null(rz_type_db_get_base_type(typedb, "bar_1"), "single struct bar");
+
+	rz_bin_dwarf_free(dw);
+	rz_analysis_free(analysis);
+	mu_end;
+}
+
+bool all_tests() {
+	mu_run_test(test_dwarf_same_name_types);
+	mu_run_test(test_dwarf_same_anonymous_types);
+	return tests_passed != tests_run;
+}
+
+mu_main(all_tests)
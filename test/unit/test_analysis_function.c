@@ -115,6 +115,141 @@ bool test_rz_analysis_function_relocate() {
 	mu_end;
 }
 
+static int block_cmp_addr_desc(const void *a, const void *b) {
+	const RzAnalysisBlock *ba = a;
+	const RzAnalysisBlock *bb = b;
+	return ba->addr < bb->addr ? 1 : ba->addr > bb->addr ? -1 : 0;
+}
+
+bool test_rz_analysis_function_blocks_index() {
+	RzAnalysis *analysis = rz_analysis_new();
+	RzAnalysisFunction *fcn = rz_analysis_create_function(analysis, "many_blocks", 0x1000, RZ_ANALYSIS_FCN_TYPE_NULL);
+	RzAnalysisFunction *other = rz_analysis_create_function(analysis, "other", 0x8000, RZ_ANALYSIS_FCN_TYPE_NULL);
+	RzAnalysisBlock *blocks[32];
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(blocks); i++) {
+		blocks[i] = rz_analysis_create_block(analysis, 0x1000 + i * 0x10, 0x10);
+		rz_analysis_function_add_block(fcn, blocks[i]);
+		rz_analysis_block_unref(blocks[i]);
+	}
+	rz_analysis_function_add_block(fcn, blocks[3]);
+	mu_assert_eq(rz_list_length(fcn->bbs), RZ_ARRAY_SIZE(blocks), "no duplicate blocks");
+	mu_assert_true(rz_analysis_function_contains_block(fcn, blocks[7]), "contains");
+	mu_assert_false(rz_analysis_function_contains_block(other, blocks[7]), "not contains");
+	assert_invariants(analysis);
+
+	// Sorting the list in place swaps the nodes data, removal must still work
+	rz_list_sort(fcn->bbs, block_cmp_addr_desc);
+	mu_assert_ptreq(rz_list_first(fcn->bbs), blocks[RZ_ARRAY_SIZE(blocks) - 1], "sorted");
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(blocks); i += 2) {
+		rz_analysis_function_remove_block(fcn, blocks[i]);
+	}
+	assert_invariants(analysis);
+	mu_assert_eq(rz_list_length(fcn->bbs), RZ_ARRAY_SIZE(blocks) / 2, "removed blocks");
+	mu_assert_false(rz_analysis_function_contains_block(fcn, blocks[2]), "removed block");
+	mu_assert_true(rz_analysis_function_contains_block(fcn, blocks[3]), "kept block");
+
+	// The order of the remaining blocks is kept
+	RzListIter *it;
+	RzAnalysisBlock *block;
+	ut64 prev = UT64_MAX;
+	rz_list_foreach (fcn->bbs, it, block) {
+		mu_assert_true(block->addr < prev, "order kept");
+		prev = block->addr;
+	}
+
+	mu_assert_true(rz_analysis_function_delete(other), "deleted function");
+	mu_assert_eq(rz_list_length(analysis->fcns), 1, "functions count");
+	assert_invariants(analysis);
+
+	assert_leaks(analysis);
+	rz_analysis_free(analysis);
+	mu_end;
+}
+
+bool test_rz_analysis_function_cfg() {
+	RzAnalysis *analysis = rz_analysis_new();
+	RzAnalysisFunction *fcn = rz_analysis_create_function(analysis, "loops", 0x1000, RZ_ANALYSIS_FCN_TYPE_NULL);
+	// 0 -> 1, outer loop 1 -> 2 -> 3 -> 4 -> 1, inner loop 2 -> 3 -> 2,
+	// diamond 1 -> 5 -> {6, 7} -> 8, 9 is unreachable
+	static const struct {
+		int jump, fail;
+	} edges[] = {
+		{ 1, -1 }, { 2, 5 }, { 3, -1 }, { 2, 4 }, { 1, -1 },
+		{ 6, 7 }, { 8, -1 }, { 8, -1 }, { -1, -1 }, { 8, -1 }
+	};
+	RzAnalysisBlock *b[RZ_ARRAY_SIZE(edges)];
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(b); i++) {
+		b[i] = rz_analysis_create_block(analysis, 0x1000 + i * 0x10, 0x10);
+		rz_analysis_function_add_block(fcn, b[i]);
+		rz_analysis_block_unref(b[i]);
+	}
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(b); i++) {
+		b[i]->jump = edges[i].jump < 0 ? UT64_MAX : 0x1000 + edges[i].jump * 0x10;
+		b[i]->fail = edges[i].fail < 0 ? UT64_MAX : 0x1000 + edges[i].fail * 0x10;
+	}
+
+	static const int idom[] = { -1, 0, 1, 2, 3, 1, 5, 5, 5, -1 };
+	static const int ipdom[] = { 1, 5, 3, 4, 1, 8, 8, 8, -1, 8 };
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(b); i++) {
+		mu_assert_ptreq(rz_analysis_function_idom(fcn, b[i]), idom[i] < 0 ? NULL : b[idom[i]], "idom");
+		mu_assert_ptreq(rz_analysis_function_ipdom(fcn, b[i]), ipdom[i] < 0 ? NULL : b[ipdom[i]], "ipdom");
+	}
+	mu_assert_true(rz_analysis_function_dominates(fcn, b[0], b[8]), "entry dominates all");
+	mu_assert_true(rz_analysis_function_dominates(fcn, b[1], b[4]), "dominates");
+	mu_assert_true(rz_analysis_function_dominates(fcn, b[3], b[3]), "dominates itself");
+	mu_assert_false(rz_analysis_function_dominates(fcn, b[6], b[8]), "diamond branch");
+	mu_assert_false(rz_analysis_function_dominates(fcn, b[0], b[9]), "unreachable");
+	mu_assert_true(rz_analysis_function_post_dominates(fcn, b[8], b[0]), "exit post-dominates all");
+	mu_assert_true(rz_analysis_function_post_dominates(fcn, b[5], b[2]), "post-dominates");
+	mu_assert_false(rz_analysis_function_post_dominates(fcn, b[4], b[1]), "loop exit");
+
+	const RzAnalysisLoop *inner = rz_analysis_function_block_loop(fcn, b[3]);
+	mu_assert_notnull(inner, "inner loop");
+	mu_assert_ptreq(inner->header, b[2], "inner loop header");
+	mu_assert_eq(inner->depth, 2, "inner loop depth");
+	mu_assert_eq(inner->size, 2, "inner loop size");
+	const RzAnalysisLoop *outer = rz_analysis_function_block_loop(fcn, b[4]);
+	mu_assert_notnull(outer, "outer loop");
+	mu_assert_ptreq(outer->header, b[1], "outer loop header");
+	mu_assert_eq(outer->depth, 1, "outer loop depth");
+	mu_assert_eq(outer->size, 4, "outer loop size");
+	RzAnalysisCFG *cfg = rz_analysis_function_get_cfg(fcn);
+	mu_assert_ptreq(rz_vector_index_ptr(&cfg->loops, inner->parent), outer, "loop nesting");
+	mu_assert_null(rz_analysis_function_block_loop(fcn, b[5]), "not in a loop");
+
+	static const size_t scc[] = { 0, 1, 1, 1, 1, 2, 3, 4, 5, 6 };
+	mu_assert_eq(cfg->n_sccs, 7, "sccs count");
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(b); i++) {
+		mu_assert_eq(rz_analysis_function_block_scc(fcn, b[i]), scc[i], "scc");
+	}
+
+	// Changing edges requires an explicit invalidation, removing blocks does not
+	b[3]->jump = UT64_MAX;
+	rz_analysis_function_invalidate_cfg(fcn);
+	outer = rz_analysis_function_block_loop(fcn, b[3]);
+	mu_assert_notnull(outer, "outer loop");
+	mu_assert_ptreq(outer->header, b[1], "inner loop removed");
+	rz_analysis_function_remove_block(fcn, b[9]);
+	cfg = rz_analysis_function_get_cfg(fcn);
+	mu_assert_eq(rz_pvector_len(&cfg->blocks), RZ_ARRAY_SIZE(b) - 1, "removed block");
+	mu_assert_eq(rz_vector_len(&cfg->loops), 1, "loops count");
+
+	// The cached metrics follow the edges changed by a resize
+	rz_analysis_use(analysis, "x86");
+	b[8]->jump = 0x2000; // tail call
+	rz_analysis_function_invalidate_cfg(fcn);
+	mu_assert_eq(rz_analysis_function_loops(fcn), 1, "jumps backwards");
+	mu_assert_eq(rz_analysis_function_complexity(fcn), 3, "complexity");
+	rz_analysis_function_resize(fcn, 0x90);
+	mu_assert_eq(rz_list_length(fcn->bbs), 9, "no block removed");
+	mu_assert_eq(b[8]->jump, UT64_MAX, "edge leaving the function removed");
+	mu_assert_eq(rz_analysis_function_complexity(fcn), 4, "complexity after resize");
+
+	assert_leaks(analysis);
+	rz_analysis_free(analysis);
+	mu_end;
+}
+
 bool test_rz_analysis_function_labels() {
 	RzAnalysis *analysis = rz_analysis_new();
 
@@ -435,6 +570,8 @@ bool test_rz_analysis_function_set_type() {
 int all_tests() {
 	mu_run_test(test_rz_analysis_function_relocate);
 	mu_run_test(test_rz_analysis_function_labels);
+	mu_run_test(test_rz_analysis_function_blocks_index);
+	mu_run_test(test_rz_analysis_function_cfg);
 	mu_run_test(test_ignore_prefixes);
 	mu_run_test(test_remove_rz_prefixes);
 	mu_run_test(test_dll_names);
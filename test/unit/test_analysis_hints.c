@@ -336,10 +336,87 @@ bool test_rz_analysis_addr_hints() {
 RANGED_TEST(arch, "6502", NULL, mu_assert_nullable_streq)
 RANGED_TEST(bits, 16, 0, mu_assert_eq)
 
+bool test_rz_analysis_hint_cursor() {
+	RzAnalysis *analysis = rz_analysis_new();
+	RzAnalysisHintCursor cursor;
+	rz_analysis_hint_cursor_init(&cursor, analysis);
+	mu_assert_null(rz_analysis_hint_cursor_at(&cursor, 0x100), "no hints");
+
+	rz_analysis_hint_set_bits(analysis, 0x100, 16);
+	rz_analysis_hint_set_arch(analysis, 0x104, "6502");
+	rz_analysis_hint_set_bits(analysis, 0x108, 0);
+	rz_analysis_hint_set_jump(analysis, 0x106, 0x1337);
+	rz_analysis_hint_set_opcode(analysis, 0x106, "nop");
+
+	mu_assert_null(rz_analysis_hint_cursor_at(&cursor, 0xff), "before hints");
+	for (ut64 addr = 0x100; addr < 0x110; addr++) {
+		const RzAnalysisHint *view = rz_analysis_hint_cursor_at(&cursor, addr);
+		RzAnalysisHint *hint = rz_analysis_hint_get(analysis, addr);
+		mu_assert_eq(!view, !hint, "view exists");
+		if (view) {
+			mu_assert_eq(view->addr, addr, "view addr");
+			mu_assert("view", hint_equals(view, hint));
+		}
+		rz_analysis_hint_free(hint);
+	}
+
+	// going backwards and changing hints must not return stale ranges
+	const RzAnalysisHint *view = rz_analysis_hint_cursor_at(&cursor, 0x102);
+	mu_assert_eq(view->bits, 16, "bits after seeking back");
+	mu_assert_null(view->arch, "no arch after seeking back");
+	rz_analysis_hint_set_arch(analysis, 0x101, "x86");
+	view = rz_analysis_hint_cursor_at(&cursor, 0x102);
+	mu_assert_streq(view->arch, "x86", "arch after change");
+	rz_analysis_hint_clear(analysis);
+	mu_assert_null(rz_analysis_hint_cursor_at(&cursor, 0x102), "cleared");
+
+	rz_analysis_hint_set_immbase(analysis, 0x200, 2);
+	view = rz_analysis_hint_view_at(analysis, 0x200);
+	mu_assert_notnull(view, "view");
+	mu_assert_eq(view->immbase, 2, "immbase");
+
+	rz_analysis_free(analysis);
+	mu_end;
+}
+
+bool test_rz_analysis_hint_rebase() {
+	RzAnalysis *analysis = rz_analysis_new();
+	rz_analysis_hint_set_jump(analysis, 0x1010, 0x1100);
+	rz_analysis_hint_set_opcode(analysis, 0x1010, "nop");
+	rz_analysis_hint_set_bits(analysis, 0x1000, 16);
+	rz_analysis_hint_set_bits(analysis, 0x1020, 0);
+	rz_analysis_hint_set_arch(analysis, 0x1008, "6502");
+
+	rz_analysis_hint_rebase(analysis, 0x1000);
+	RzAnalysisHint *hint = rz_analysis_hint_get(analysis, 0x2010);
+	mu_assert_notnull(hint, "hint moved");
+	mu_assert_eq(hint->jump, 0x2100, "jump target moved");
+	mu_assert_streq(hint->opcode, "nop", "opcode");
+	rz_analysis_hint_free(hint);
+	mu_assert_null(rz_analysis_addr_hints_at(analysis, 0x1010), "old address");
+	mu_assert_eq(rz_analysis_hint_bits_at(analysis, 0x2010, NULL), 16, "bits moved");
+	mu_assert_eq(rz_analysis_hint_bits_at(analysis, 0x2020, NULL), 0, "bits end moved");
+	mu_assert_nullable_streq(rz_analysis_hint_arch_at(analysis, 0x2008, NULL), "6502", "arch moved");
+	mu_assert_null(rz_analysis_hint_arch_at(analysis, 0x2000, NULL), "no arch before");
+
+	// records wrapping around must be reordered
+	rz_analysis_hint_rebase(analysis, -0x2010);
+	ut64 hint_addr = 0;
+	rz_analysis_hint_bits_at(analysis, 0x18, &hint_addr);
+	mu_assert_eq(hint_addr, 0x10, "bits end after wrap");
+	mu_assert_eq(rz_analysis_hint_bits_at(analysis, UT64_MAX - 1, &hint_addr), 16, "bits after wrap");
+	mu_assert_eq(hint_addr, UT64_MAX - 0xf, "bits address after wrap");
+
+	rz_analysis_free(analysis);
+	mu_end;
+}
+
 bool all_tests() {
 	mu_run_test(test_rz_analysis_addr_hints);
 	mu_run_test(test_rz_analysis_hints_arch);
 	mu_run_test(test_rz_analysis_hints_bits);
+	mu_run_test(test_rz_analysis_hint_cursor);
+	mu_run_test(test_rz_analysis_hint_rebase);
 	return tests_passed != tests_run;
 }
 
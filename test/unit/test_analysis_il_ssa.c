@@ -0,0 +1,115 @@
+// SPDX-FileCopyrightText: 2023 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_core.h>
+#include "minunit.h"
+
+static bool vec_contains(RzVector /*<ut64>*/ *vec, ut64 val) {
+	ut64 *it;
+	rz_vector_foreach(vec, it) {
+		if (*it == val) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static RzCore *core_with_code(const ut8 *code, int len) {
+	RzCore *core = rz_core_new();
+	rz_io_open_at(core->io, "malloc://0x100", RZ_PERM_RWX, 0644, 0, NULL);
+	rz_config_set(core->config, "asm.arch", "x86");
+	rz_config_set_i(core->config, "asm.bits", 64);
+	rz_io_write_at(core->io, 0, code, len);
+	rz_core_cmd0(core, "af");
+	return core;
+}
+
+static bool test_il_ssa_diamond(void) {
+	// mov eax, 1; test edi, edi; je 0xe; mov eax, 2; add eax, 3; ret
+	static const ut8 code[] = {
+		0xb8, 0x01, 0x00, 0x00, 0x00, 0x85, 0xff, 0x74, 0x05,
+		0xb8, 0x02, 0x00, 0x00, 0x00, 0x83, 0xc0, 0x03, 0xc3
+	};
+	RzCore *core = core_with_code(code, sizeof(code));
+	RzAnalysisFunction *fcn = rz_analysis_get_function_at(core->analysis, 0);
+	mu_assert_notnull(fcn, "function");
+	mu_assert_eq(rz_list_length(fcn->bbs), 3, "blocks");
+
+	RzAnalysisILSSA *ssa = rz_analysis_il_ssa_new(core->analysis, fcn);
+	mu_assert_notnull(ssa, "ssa");
+
+	RzAnalysisILSSADef *def = rz_analysis_il_ssa_reaching_def(ssa, 0xe, "rax");
+	mu_assert_notnull(def, "def at join");
+	mu_assert_eq(def->kind, RZ_ANALYSIS_IL_SSA_DEF_PHI, "phi at join");
+	mu_assert_eq(rz_vector_len(&def->operands), 2, "phi operands");
+	def = rz_analysis_il_ssa_reaching_def(ssa, 0x5, "rdi");
+	mu_assert_notnull(def, "def of argument");
+	mu_assert_eq(def->kind, RZ_ANALYSIS_IL_SSA_DEF_ENTRY, "argument comes from entry");
+	mu_assert_null(rz_analysis_il_ssa_constants_at(ssa, 0x5, "rdi"), "argument is unknown");
+
+	RzVector *vals = rz_analysis_il_ssa_constants_at(ssa, 0x9, "rax");
+	mu_assert_notnull(vals, "constants before else");
+	mu_assert_eq(rz_vector_len(vals), 1, "single constant");
+	mu_assert_true(vec_contains(vals, 1), "rax = 1");
+	rz_vector_free(vals);
+
+	vals = rz_analysis_il_ssa_constants_at(ssa, 0x11, "rax");
+	mu_assert_notnull(vals, "constants at ret");
+	mu_assert_eq(rz_vector_len(vals), 2, "two constants");
+	mu_assert_true(vec_contains(vals, 4), "rax = 1 + 3");
+	mu_assert_true(vec_contains(vals, 5), "rax = 2 + 3");
+	rz_vector_free(vals);
+
+	// the join block writes zf itself, but both paths bring the one of the test
+	def = rz_analysis_il_ssa_reaching_def(ssa, 0xe, "zf");
+	mu_assert_notnull(def, "flag at join");
+	mu_assert_eq(def->kind, RZ_ANALYSIS_IL_SSA_DEF_SET, "trivial phi removed");
+	mu_assert_eq(def->addr, 0x5, "flag of the test");
+	size_t defs = rz_pvector_len(&ssa->defs);
+	mu_assert_ptreq(rz_analysis_il_ssa_reaching_def(ssa, 0xe, "zf"), def, "same def");
+	mu_assert_ptreq(rz_analysis_il_ssa_reaching_def(ssa, 0xe, "zf"), def, "same def");
+	mu_assert_eq(rz_pvector_len(&ssa->defs), defs, "repeated queries create no phis");
+
+	vals = rz_analysis_il_ssa_jump_targets(ssa, 0x7);
+	mu_assert_notnull(vals, "jump targets");
+	mu_assert_eq(rz_vector_len(vals), 1, "single target");
+	mu_assert_true(vec_contains(vals, 0xe), "je target");
+	rz_vector_free(vals);
+
+	rz_analysis_il_ssa_free(ssa);
+	rz_core_free(core);
+	mu_end;
+}
+
+static bool test_il_ssa_loop(void) {
+	// xor ecx, ecx; inc ecx; cmp ecx, 0x10; jb 2; ret
+	static const ut8 code[] = {
+		0x31, 0xc9, 0xff, 0xc1, 0x83, 0xf9, 0x10, 0x72, 0xf9, 0xc3
+	};
+	RzCore *core = core_with_code(code, sizeof(code));
+	RzAnalysisFunction *fcn = rz_analysis_get_function_at(core->analysis, 0);
+	mu_assert_notnull(fcn, "function");
+
+	RzAnalysisILSSA *ssa = rz_analysis_il_ssa_new(core->analysis, fcn);
+	mu_assert_notnull(ssa, "ssa");
+	RzAnalysisILSSADef *def = rz_analysis_il_ssa_reaching_def(ssa, 0x2, "rcx");
+	mu_assert_notnull(def, "def at loop head");
+	mu_assert_eq(def->kind, RZ_ANALYSIS_IL_SSA_DEF_PHI, "phi at loop head");
+	size_t defs = rz_pvector_len(&ssa->defs);
+	mu_assert_null(rz_analysis_il_ssa_reaching_def(ssa, 0x9, "rdx"), "untouched register");
+	mu_assert_null(rz_analysis_il_ssa_constants_at(ssa, 0x9, "rdx"), "untouched register");
+	mu_assert_eq(rz_pvector_len(&ssa->defs), defs, "no definition for an untouched register");
+	mu_assert_null(rz_analysis_il_ssa_constants_at(ssa, 0x9, "rcx"), "induction variable is not constant");
+
+	rz_analysis_il_ssa_free(ssa);
+	rz_core_free(core);
+	mu_end;
+}
+
+bool all_tests() {
+	mu_run_test(test_il_ssa_diamond);
+	mu_run_test(test_il_ssa_loop);
+	return tests_passed != tests_run;
+}
+
+mu_main(all_tests)
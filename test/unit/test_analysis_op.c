@@ -171,10 +171,26 @@ bool test_rz_core_print_disasm() {
 	mu_end;
 }
 
+bool test_rz_analysis_set_mode_bits() {
+	RzAnalysis *analysis = rz_analysis_new();
+	SWITCH_TO_ARCH_BITS("x86", 32);
+	mu_assert_eq(rz_type_db_pointer_size(analysis->typedb), 32, "32 bits pointers");
+	mu_assert_true(rz_analysis_set_mode_bits(analysis, 16), "switch to 16 bits");
+	mu_assert_eq(analysis->bits, 16, "16 bits");
+	mu_assert_eq(rz_type_db_pointer_size(analysis->typedb), 16, "16 bits pointers");
+	mu_assert_true(rz_analysis_set_mode_bits(analysis, 32), "switch back to 32 bits");
+	mu_assert_eq(rz_type_db_pointer_size(analysis->typedb), 32, "32 bits pointers again");
+	mu_assert_false(rz_analysis_set_mode_bits(analysis, 12), "invalid bits");
+	mu_assert_eq(analysis->bits, 32, "bits kept");
+	rz_analysis_free(analysis);
+	mu_end;
+}
+
 int all_tests() {
 	mu_run_test(test_rz_analysis_op_val);
 	mu_run_test(test_rz_core_analysis_bytes);
 	mu_run_test(test_rz_core_print_disasm);
+	mu_run_test(test_rz_analysis_set_mode_bits);
 	return tests_passed != tests_run;
 }
 
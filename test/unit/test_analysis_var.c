@@ -404,11 +404,41 @@ bool test_rz_analysis_var_is_arg() {
 	mu_end;
 }
 
+bool test_rz_analysis_var_global_rebase() {
+	RzCore *core = rz_core_new();
+	RzAnalysis *analysis = core->analysis;
+	RzTypeDB *typedb = analysis->typedb;
+	mu_assert_true(rz_analysis_var_global_create(analysis, "a", rz_type_identifier_of_base_type_str(typedb, "int"), 0x1000), "create a");
+	mu_assert_true(rz_analysis_var_global_create(analysis, "b", rz_type_identifier_of_base_type_str(typedb, "int"), 0x2000), "create b");
+	mu_assert_true(rz_analysis_var_global_create(analysis, "c", rz_type_identifier_of_base_type_str(typedb, "int"), 0x3000), "create c");
+
+	// the order is kept
+	rz_analysis_var_global_rebase(analysis, 0x100);
+	mu_assert_ptreq(rz_analysis_var_global_get_byaddr_at(analysis, 0x1100), rz_analysis_var_global_get_byname(analysis, "a"), "rebased a");
+	mu_assert_ptreq(rz_analysis_var_global_get_byaddr_at(analysis, 0x2100), rz_analysis_var_global_get_byname(analysis, "b"), "rebased b");
+	mu_assert_ptreq(rz_analysis_var_global_get_byaddr_in(analysis, 0x3102), rz_analysis_var_global_get_byname(analysis, "c"), "rebased c");
+	mu_assert_null(rz_analysis_var_global_get_byaddr_at(analysis, 0x1000), "old address");
+
+	// a wraps around and becomes the last one
+	rz_analysis_var_global_rebase(analysis, -0x2100);
+	mu_assert_ptreq(rz_analysis_var_global_get_byaddr_at(analysis, 0xfffffffffffff000ULL), rz_analysis_var_global_get_byname(analysis, "a"), "wrapped a");
+	mu_assert_ptreq(rz_analysis_var_global_get_byaddr_at(analysis, 0x0), rz_analysis_var_global_get_byname(analysis, "b"), "rebased b");
+	mu_assert_ptreq(rz_analysis_var_global_get_byaddr_in(analysis, 0x1002), rz_analysis_var_global_get_byname(analysis, "c"), "rebased c");
+	RBIter it = rz_rbtree_first(analysis->global_var_tree);
+	mu_assert_streq(rz_rbtree_iter_get(&it, RzAnalysisVarGlobal, rb)->name, "b", "first global");
+	it = rz_rbtree_last(analysis->global_var_tree);
+	mu_assert_streq(rz_rbtree_iter_get(&it, RzAnalysisVarGlobal, rb)->name, "a", "last global");
+
+	rz_core_free(core);
+	mu_end;
+}
+
 int all_tests() {
 	mu_run_test(test_rz_analysis_var);
 	mu_run_test(test_rz_analysis_function_get_stack_var_in);
 	mu_run_test(test_rz_analysis_function_var_expr_for_reg_access_at);
 	mu_run_test(test_rz_analysis_var_is_arg);
+	mu_run_test(test_rz_analysis_var_global_rebase);
 	return tests_passed != tests_run;
 }
 
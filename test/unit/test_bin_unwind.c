@@ -0,0 +1,160 @@
+// SPDX-FileCopyrightText: 2023 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_bin.h>
+#include "minunit.h"
+
+// .eh_frame at 0x1000 with a single x86-64 function at 0x400 of size 0x20:
+// push rbp; mov rbp, rsp; ... pop rbp; ret
+static const ut8 eh_frame[] = {
+	// CIE
+	0x14, 0x00, 0x00, 0x00, // length
+	0x00, 0x00, 0x00, 0x00, // CIE id
+	0x01, 'z', 'R', 0x00, // version, augmentation
+	0x01, 0x78, 0x10, // code align 1, data align -8, return address r16
+	0x01, 0x1b, // augmentation data: pcrel sdata4 pointers
+	0x0c, 0x07, 0x08, // def_cfa rsp+8
+	0x90, 0x01, // offset r16
+	0x00, 0x00,
+	// FDE
+	0x1c, 0x00, 0x00, 0x00, // length
+	0x1c, 0x00, 0x00, 0x00, // CIE pointer
+	0xe0, 0xf3, 0xff, 0xff, // pc begin 0x400
+	0x20, 0x00, 0x00, 0x00, // pc range
+	0x00, // augmentation data length
+	0x41, 0x0e, 0x10, // advance 1, def_cfa_offset 16
+	0x86, 0x02, // offset rbp
+	0x43, 0x0d, 0x06, // advance 3, def_cfa_register rbp
+	0x58, 0x0c, 0x07, 0x08, // advance 0x18, def_cfa rsp+8
+	0x00, 0x00, 0x00,
+	// terminator
+	0x00, 0x00, 0x00, 0x00
+};
+
+static bool test_eh_frame_parse(void) {
+	RzPVector *fcns = rz_bin_eh_frame_parse(eh_frame, sizeof(eh_frame), 0x1000, 7, 8, false);
+	mu_assert_notnull(fcns, "parsed");
+	mu_assert_eq(rz_pvector_len(fcns), 1, "functions");
+	RzBinUnwindFunction *fcn = rz_pvector_at(fcns, 0);
+	mu_assert_eq(fcn->vaddr, 0x400, "function start");
+	mu_assert_eq(fcn->size, 0x20, "function size");
+	mu_assert_eq(rz_vector_len(&fcn->rows), 4, "rows");
+
+	const RzBinUnwindRow *row = rz_bin_unwind_function_row_at(fcn, 0x400);
+	mu_assert_eq(row->cfa_offset, 8, "entry");
+	mu_assert_false(row->frame_based, "entry");
+	row = rz_bin_unwind_function_row_at(fcn, 0x402);
+	mu_assert_eq(row->cfa_offset, 16, "after push");
+	mu_assert_false(row->frame_based, "after push");
+	row = rz_bin_unwind_function_row_at(fcn, 0x410);
+	mu_assert_true(row->frame_based, "frame pointer");
+	row = rz_bin_unwind_function_row_at(fcn, 0x41c);
+	mu_assert_eq(row->cfa_offset, 8, "after pop");
+	mu_assert_false(row->frame_based, "after pop");
+	mu_assert_null(rz_bin_unwind_function_row_at(fcn, 0x420), "outside");
+
+	rz_pvector_free(fcns);
+	mu_end;
+}
+
+static bool test_eh_frame_truncated(void) {
+	RzPVector *fcns = rz_bin_eh_frame_parse(eh_frame, 40, 0x1000, 7, 8, false);
+	mu_assert_notnull(fcns, "parsed");
+	mu_assert_eq(rz_pvector_len(fcns), 0, "FDE out of bounds");
+	rz_pvector_free(fcns);
+	mu_end;
+}
+
+// PE64 image at 0x140000000 with two functions in .pdata:
+// 0x140001000: push rbx; sub rsp, 0x20; add rsp, 0x20; pop rbx; ret
+// 0x140001010: push rbp; sub rsp, 0x30; lea rbp, [rsp + 0x20]; sub rsp, 0x100;
+//              lea rsp, [rbp + 0x10]; pop rbp; ret
+static const struct {
+	ut64 offset;
+	const char *hex;
+} pe64_pdata[] = {
+	{ 0x0, "4d5a" },
+	{ 0x3c, "40000000" },
+	// PE signature and COFF header: AMD64, 2 sections
+	{ 0x40, "5045000064860200000000000000000000000000f0002200" },
+	// PE32+ optional header
+	{ 0x58, "0b020000000200000002000000000000001000000010000000000040010000000010000000020000060000000000000006000000000000000030000000020000000000000300000000001000000000000010000000000000000010000000000000100000000000000000000010000000" },
+	// exception directory
+	{ 0xe0, "0020000018000000" },
+	// .text and .pdata section headers
+	{ 0x148, "2e7465787400000000010000001000000002000000020000000000000000000000000000200000602e706461746100000001000000200000000200000004000000000000000000000000000040000040" },
+	{ 0x200, "534883ec204883c4205bc3" },
+	{ 0x210, "554883ec30488d6c24204881ec00010000488d65105dc3" },
+	// runtime functions
+	{ 0x400, "001000000b10000018200000101000002710000020200000" },
+	// unwind info: push rbx, alloc 0x20
+	{ 0x418, "0105020005320130" },
+	// unwind info: push rbp, alloc 0x30, rbp = rsp + 0x20
+	{ 0x420, "010a03250a0305520150" },
+};
+
+static RzBuffer *pe64_pdata_buf(void) {
+	RzBuffer *buf = rz_buf_new_empty(0x600);
+	if (!buf) {
+		return NULL;
+	}
+	ut8 bytes[0x100];
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(pe64_pdata); i++) {
+		int len = rz_hex_str2bin(pe64_pdata[i].hex, bytes);
+		rz_buf_write_at(buf, pe64_pdata[i].offset, bytes, len);
+	}
+	return buf;
+}
+
+static bool test_pdata_parse(void) {
+	RzBin *bin = rz_bin_new();
+	RzBuffer *buf = pe64_pdata_buf();
+	mu_assert_notnull(buf, "buffer");
+	RzBinOptions opt;
+	rz_bin_options_init(&opt, -1, UT64_MAX, 0, false);
+	opt.filename = "pdata.exe";
+	opt.sz = rz_buf_size(buf);
+	RzBinFile *bf = rz_bin_open_buf(bin, buf, &opt);
+	rz_buf_free(buf);
+	mu_assert_notnull(bf, "opened");
+	RzPVector *fcns = rz_bin_file_get_unwind_functions(bf);
+	mu_assert_notnull(fcns, "parsed");
+	mu_assert_eq(rz_pvector_len(fcns), 2, "functions");
+
+	RzBinUnwindFunction *fcn = rz_pvector_at(fcns, 0);
+	mu_assert_eq(fcn->vaddr, 0x140001000, "function start");
+	mu_assert_eq(fcn->size, 0xb, "function size");
+	mu_assert_false(fcn->fragment, "not chained");
+	mu_assert_eq(rz_vector_len(&fcn->rows), 3, "rows");
+	const RzBinUnwindRow *row = rz_bin_unwind_function_row_at(fcn, 0x140001000);
+	mu_assert_eq(row->cfa_offset, 8, "entry");
+	row = rz_bin_unwind_function_row_at(fcn, 0x140001001);
+	mu_assert_eq(row->cfa_offset, 16, "after push");
+	row = rz_bin_unwind_function_row_at(fcn, 0x140001005);
+	mu_assert_eq(row->cfa_offset, 48, "after alloc");
+	mu_assert_false(row->frame_based, "after alloc");
+
+	fcn = rz_pvector_at(fcns, 1);
+	mu_assert_eq(fcn->vaddr, 0x140001010, "function start");
+	mu_assert_eq(fcn->size, 0x17, "function size");
+	mu_assert_eq(rz_vector_len(&fcn->rows), 4, "rows");
+	row = rz_bin_unwind_function_row_at(fcn, 0x140001015);
+	mu_assert_eq(row->cfa_offset, 64, "after alloc");
+	mu_assert_false(row->frame_based, "after alloc");
+	row = rz_bin_unwind_function_row_at(fcn, 0x14000101a);
+	mu_assert_eq(row->cfa_offset, 32, "frame pointer");
+	mu_assert_true(row->frame_based, "frame pointer");
+
+	rz_pvector_free(fcns);
+	rz_bin_free(bin);
+	mu_end;
+}
+
+bool all_tests() {
+	mu_run_test(test_eh_frame_parse);
+	mu_run_test(test_eh_frame_truncated);
+	mu_run_test(test_pdata_parse);
+	return tests_passed != tests_run;
+}
+
+mu_main(all_tests)
@@ -0,0 +1,172 @@
+// SPDX-FileCopyrightText: 2023 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_bin.h>
+#include "minunit.h"
+
+// More than 256 symbols, so that the names need two markers
+#define KS_SYMS        300
+#define KS_MARKER_STEP 256
+#define KS_BASE        0xffffffff81000000ULL
+
+static void ks_name(char *out, size_t size, size_t i) {
+	if (!i) {
+		snprintf(out, size, "T_text");
+	} else if (i == 1) {
+		snprintf(out, size, "Tstartup_64");
+	} else if (i == KS_SYMS - 1) {
+		snprintf(out, size, "D_end");
+	} else {
+		snprintf(out, size, "tfn_%03zu", i - 2);
+	}
+}
+
+static ut32 ks_offset(size_t i) {
+	if (i < 2) {
+		return 0;
+	}
+	return i == KS_SYMS - 1 ? 0x10000 : 0x10 * (ut32)(i - 1);
+}
+
+/**
+ * A raw 64-bit little endian kernel with the tables laid out like the kernels
+ * since 4.6: names, markers, token table and index, then relative offsets.
+ * Every token stands for a single character.
+ */
+static RzBuffer *kallsyms_buf(bool bad_marker) {
+	ut8 *b = calloc(1, 0x4000);
+	if (!b) {
+		return NULL;
+	}
+	size_t pos = 0x40;
+	rz_write_le32(b + pos, KS_SYMS);
+	pos += 4;
+	size_t names = pos;
+	ut32 marker = 0;
+	for (size_t i = 0; i < KS_SYMS; i++) {
+		if (i == KS_MARKER_STEP) {
+			marker = pos - names;
+		}
+		char name[32];
+		ks_name(name, sizeof(name), i);
+		size_t len = strlen(name);
+		b[pos++] = len;
+		memcpy(b + pos, name, len);
+		pos += len;
+	}
+	pos = RZ_ROUND(pos, 4);
+	rz_write_le32(b + pos, 0);
+	rz_write_le32(b + pos + 4, bad_marker ? marker + 1 : marker);
+	pos += 8;
+	size_t table = pos;
+	ut16 index[256];
+	for (size_t i = 0; i < 256; i++) {
+		index[i] = pos - table;
+		if (i > ' ' && i < 0x7f) {
+			b[pos++] = i;
+		} else {
+			pos += snprintf((char *)b + pos, 4, "~%02zx", i);
+		}
+		b[pos++] = 0;
+	}
+	pos = RZ_ROUND(pos, 2);
+	for (size_t i = 0; i < 256; i++, pos += 2) {
+		rz_write_le16(b + pos, index[i]);
+	}
+	pos = RZ_ROUND(pos, 8);
+	for (size_t i = 0; i < KS_SYMS; i++, pos += 4) {
+		rz_write_le32(b + pos, ks_offset(i));
+	}
+	pos = RZ_ROUND(pos, 8);
+	rz_write_le64(b + pos, KS_BASE);
+	pos += 8;
+	RzBuffer *buf = rz_buf_new_with_bytes(b, pos);
+	free(b);
+	return buf;
+}
+
+static RzBinFile *zimg_open(RzBin *bin, RzBuffer *buf) {
+	RzBinOptions opt;
+	rz_bin_options_init(&opt, -1, UT64_MAX, 0, false);
+	opt.filename = "vmlinux";
+	opt.pluginname = "zimg";
+	opt.sz = rz_buf_size(buf);
+	return rz_bin_open_buf(bin, buf, &opt);
+}
+
+static const RzBinSymbol *symbol_get(RzBinObject *o, const char *name) {
+	const RzList *symbols = rz_bin_object_get_symbols(o);
+	RzListIter *it;
+	RzBinSymbol *sym;
+	rz_list_foreach (symbols, it, sym) {
+		if (sym->name && !strcmp(sym->name, name)) {
+			return sym;
+		}
+	}
+	return NULL;
+}
+
+static bool test_kallsyms(void) {
+	RzBin *bin = rz_bin_new();
+	RzBuffer *buf = kallsyms_buf(false);
+	mu_assert_notnull(buf, "buffer");
+	RzBinFile *bf = zimg_open(bin, buf);
+	rz_buf_free(buf);
+	mu_assert_notnull(bf, "opened");
+
+	const RzBinInfo *info = rz_bin_object_get_info(bf->o);
+	mu_assert_notnull(info, "info");
+	mu_assert_streq(info->arch, "x86", "arch from startup_64");
+	mu_assert_eq(info->bits, 64, "bits from the relative base");
+	mu_assert_false(info->big_endian, "little endian tables");
+
+	const RzList *symbols = rz_bin_object_get_symbols(bf->o);
+	mu_assert_eq(rz_list_length(symbols), KS_SYMS, "all names decoded");
+	const RzBinSymbol *sym = symbol_get(bf->o, "startup_64");
+	mu_assert_notnull(sym, "startup_64");
+	mu_assert_eq(sym->vaddr, KS_BASE, "startup_64 address");
+	mu_assert_streq(sym->type, RZ_BIN_TYPE_FUNC_STR, "startup_64 type");
+	mu_assert_streq(sym->bind, RZ_BIN_BIND_GLOBAL_STR, "startup_64 bind");
+	sym = symbol_get(bf->o, "fn_010");
+	mu_assert_notnull(sym, "fn_010");
+	mu_assert_eq(sym->vaddr, KS_BASE + 0xb0, "fn_010 address");
+	mu_assert_streq(sym->bind, RZ_BIN_BIND_LOCAL_STR, "fn_010 bind");
+	mu_assert_eq(sym->size, 0x10, "fn_010 size up to the next symbol");
+	// the first name after the second marker
+	sym = symbol_get(bf->o, "fn_254");
+	mu_assert_notnull(sym, "fn_254");
+	mu_assert_eq(sym->vaddr, KS_BASE + 0xff0, "fn_254 address");
+	sym = symbol_get(bf->o, "_end");
+	mu_assert_notnull(sym, "_end");
+	mu_assert_eq(sym->vaddr, KS_BASE + 0x10000, "_end address");
+	mu_assert_streq(sym->type, RZ_BIN_TYPE_OBJECT_STR, "_end type");
+
+	const RzList *entries = rz_bin_object_get_entries(bf->o);
+	mu_assert_eq(rz_list_length(entries), 1, "entry");
+	RzBinAddr *entry = rz_list_first(entries);
+	mu_assert_eq(entry->vaddr, KS_BASE, "entry at _text");
+
+	rz_bin_free(bin);
+	mu_end;
+}
+
+static bool test_kallsyms_bad_marker(void) {
+	RzBin *bin = rz_bin_new();
+	RzBuffer *buf = kallsyms_buf(true);
+	mu_assert_notnull(buf, "buffer");
+	RzBinFile *bf = zimg_open(bin, buf);
+	rz_buf_free(buf);
+	mu_assert_notnull(bf, "opened");
+	// the names disagree with the markers, so no table is trusted
+	mu_assert_eq(rz_list_length(rz_bin_object_get_symbols(bf->o)), 0, "no symbols");
+	rz_bin_free(bin);
+	mu_end;
+}
+
+bool all_tests() {
+	mu_run_test(test_kallsyms);
+	mu_run_test(test_kallsyms_bad_marker);
+	return tests_passed != tests_run;
+}
+
+mu_main(all_tests)
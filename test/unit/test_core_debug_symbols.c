@@ -0,0 +1,187 @@
+// SPDX-FileCopyrightText: 2023 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_core.h>
+#include "minunit.h"
+
+#if __UNIX__
+#include <utime.h>
+
+#define MOD_BASE  0x400000
+#define MOD_MTIME 1000000000
+
+#define ELF_TEXT     0x100
+#define ELF_SYMTAB   0x200
+#define ELF_STRTAB   0x280
+#define ELF_SHSTRTAB 0x2c0
+#define ELF_SHDRS    0x300
+#define ELF_SIZE     (ELF_SHDRS + 5 * 0x40)
+
+static const char strtab[] = "\0first\0second\0third";
+static const char shstrtab[] = "\0.text\0.symtab\0.strtab\0.shstrtab";
+
+static void elf_shdr(ut8 *b, int idx, ut32 name, ut32 type, ut64 flags, ut64 addr, ut64 off, ut64 size, ut32 link, ut32 info, ut64 entsize) {
+	ut8 *s = b + ELF_SHDRS + idx * 0x40;
+	rz_write_le32(s, name);
+	rz_write_le32(s + 4, type);
+	rz_write_le64(s + 8, flags);
+	rz_write_le64(s + 0x10, addr);
+	rz_write_le64(s + 0x18, off);
+	rz_write_le64(s + 0x20, size);
+	rz_write_le32(s + 0x28, link);
+	rz_write_le32(s + 0x2c, info);
+	rz_write_le64(s + 0x30, 1);
+	rz_write_le64(s + 0x38, entsize);
+}
+
+static void elf_sym(ut8 *b, int idx, ut32 name, ut8 type, ut64 value, ut64 size) {
+	ut8 *s = b + ELF_SYMTAB + idx * 0x18;
+	rz_write_le32(s, name);
+	s[4] = (1 << 4) | type; // STB_GLOBAL
+	rz_write_le16(s + 6, 1); // .text
+	rz_write_le64(s + 8, value);
+	rz_write_le64(s + 0x10, size);
+}
+
+/**
+ * An x86-64 executable loaded at MOD_BASE with the symbols:
+ * first [0x100, 0x110), second [0x120, 0x140), third [0x180, 0x1c0)
+ */
+static void elf_build(ut8 *b) {
+	memset(b, 0, ELF_SIZE);
+	memcpy(b, "\x7f" "ELF\x02\x01\x01", 7);
+	rz_write_le16(b + 0x10, 2); // ET_EXEC
+	rz_write_le16(b + 0x12, 62); // EM_X86_64
+	rz_write_le32(b + 0x14, 1);
+	rz_write_le64(b + 0x18, MOD_BASE + ELF_TEXT);
+	rz_write_le64(b + 0x20, 0x40);
+	rz_write_le64(b + 0x28, ELF_SHDRS);
+	rz_write_le16(b + 0x34, 0x40);
+	rz_write_le16(b + 0x36, 0x38);
+	rz_write_le16(b + 0x38, 1);
+	rz_write_le16(b + 0x3a, 0x40);
+	rz_write_le16(b + 0x3c, 5);
+	rz_write_le16(b + 0x3e, 4);
+
+	ut8 *p = b + 0x40;
+	rz_write_le32(p, 1); // PT_LOAD
+	rz_write_le32(p + 4, 5); // R-X
+	rz_write_le64(p + 0x10, MOD_BASE);
+	rz_write_le64(p + 0x18, MOD_BASE);
+	rz_write_le64(p + 0x20, ELF_SIZE);
+	rz_write_le64(p + 0x28, ELF_SIZE);
+	rz_write_le64(p + 0x30, 0x1000);
+
+	memset(b + ELF_TEXT, 0x90, 0x100);
+	elf_sym(b, 1, 1, 2, MOD_BASE + 0x100, 0x10);
+	elf_sym(b, 2, 7, 2, MOD_BASE + 0x120, 0x20);
+	elf_sym(b, 3, 14, 1, MOD_BASE + 0x180, 0x40);
+	memcpy(b + ELF_STRTAB, strtab, sizeof(strtab));
+	memcpy(b + ELF_SHSTRTAB, shstrtab, sizeof(shstrtab));
+
+	elf_shdr(b, 1, 1, 1, 6, MOD_BASE + ELF_TEXT, ELF_TEXT, 0x100, 0, 0, 0); // SHT_PROGBITS, AX
+	elf_shdr(b, 2, 7, 2, 0, 0, ELF_SYMTAB, 4 * 0x18, 3, 1, 0x18); // SHT_SYMTAB
+	elf_shdr(b, 3, 15, 3, 0, 0, ELF_STRTAB, sizeof(strtab), 0, 0, 0); // SHT_STRTAB
+	elf_shdr(b, 4, 23, 3, 0, 0, ELF_SHSTRTAB, sizeof(shstrtab), 0, 0, 0);
+}
+
+/**
+ * Replace the file at \p path, renaming over it like a rebuild would,
+ * and set its modification time to \p mtime
+ */
+static bool module_write(const char *path, const ut8 *b, ut64 mtime) {
+	char *tmp = rz_str_newf("%s.new", path);
+	bool ret = tmp && rz_file_dump(tmp, b, ELF_SIZE, false) && !rename(tmp, path);
+	struct utimbuf times = { .actime = mtime, .modtime = mtime };
+	ret = ret && !utime(path, &times);
+	free(tmp);
+	return ret;
+}
+
+static bool module_map(RzCore *core, const char *path) {
+	RzDebugMap *map = rz_debug_map_new((char *)path, MOD_BASE, MOD_BASE + 0x1000, RZ_PERM_RX, 0);
+	if (!map || !rz_list_append(core->dbg->maps, map)) {
+		rz_debug_map_free(map);
+		return false;
+	}
+	core->dbg->maps_gen++;
+	return true;
+}
+
+static bool symbol_is(RzCore *core, ut64 addr, const char *name, ut64 expect_delta) {
+	RzBinFile *bf = NULL;
+	ut64 delta = UT64_MAX;
+	RzBinSymbol *sym = rz_core_debug_symbol_at(core, addr, &bf, &delta);
+	return sym && bf && sym->name && !strcmp(sym->name, name) && delta == expect_delta;
+}
+
+static bool test_debug_symbol_at(void) {
+	ut8 elf[ELF_SIZE];
+	elf_build(elf);
+	char *path = rz_file_temp("dbgsym");
+	mu_assert_notnull(path, "temp file");
+	mu_assert_true(module_write(path, elf, MOD_MTIME), "module written");
+	mu_assert_eq(rz_file_mtime(path), MOD_MTIME, "mtime");
+
+	RzCore *core = rz_core_new();
+	mu_assert_true(module_map(core, path), "module mapped");
+
+	mu_assert_true(symbol_is(core, MOD_BASE + 0x100, "first", 0), "at the start of first");
+	mu_assert_true(symbol_is(core, MOD_BASE + 0x10f, "first", 0xf), "at the end of first");
+	mu_assert_true(symbol_is(core, MOD_BASE + 0x118, "first", 0x18), "between first and second");
+	mu_assert_true(symbol_is(core, MOD_BASE + 0x120, "second", 0), "at the start of second");
+	mu_assert_true(symbol_is(core, MOD_BASE + 0x17f, "second", 0x5f), "between second and third");
+	mu_assert_true(symbol_is(core, MOD_BASE + 0x180, "third", 0), "at the start of third");
+	mu_assert_true(symbol_is(core, MOD_BASE + 0xfff, "third", 0xe7f), "at the end of the module");
+	mu_assert_null(rz_core_debug_symbol_at(core, MOD_BASE + 0x1000, NULL, NULL), "after the module");
+	mu_assert_null(rz_core_debug_symbol_at(core, MOD_BASE - 1, NULL, NULL), "before the module");
+
+	rz_core_free(core);
+	rz_file_rm(path);
+	free(path);
+	mu_end;
+}
+
+static bool test_debug_symbols_cache(void) {
+	ut8 elf[ELF_SIZE];
+	elf_build(elf);
+	char *path = rz_file_temp("dbgsym");
+	mu_assert_notnull(path, "temp file");
+	mu_assert_true(module_write(path, elf, MOD_MTIME), "module written");
+
+	RzCore *core = rz_core_new();
+	mu_assert_true(module_map(core, path), "module mapped");
+	RzBinFile *bf = rz_core_debug_module_at(core, MOD_BASE);
+	mu_assert_notnull(bf, "module parsed");
+	mu_assert_true(symbol_is(core, MOD_BASE + 0x100, "first", 0), "first");
+
+	// same size and mtime: the module is not parsed again, even after the maps change
+	memcpy(elf + ELF_STRTAB + 1, "fir5t", 5);
+	mu_assert_true(module_write(path, elf, MOD_MTIME), "module rewritten");
+	core->dbg->maps_gen++;
+	mu_assert_ptreq(rz_core_debug_module_at(core, MOD_BASE), bf, "cache hit");
+	mu_assert_true(symbol_is(core, MOD_BASE + 0x100, "first", 0), "cached symbol");
+
+	// only the mtime changes: the cached module is stale
+	mu_assert_true(module_write(path, elf, MOD_MTIME + 60), "module touched");
+	core->dbg->maps_gen++;
+	mu_assert_true(symbol_is(core, MOD_BASE + 0x100, "fir5t", 0), "module parsed again");
+	mu_assert_true(symbol_is(core, MOD_BASE + 0x120, "second", 0), "other symbols");
+
+	rz_core_free(core);
+	rz_file_rm(path);
+	free(path);
+	mu_end;
+}
+
+#endif
+
+bool all_tests() {
+#if __UNIX__
+	mu_run_test(test_debug_symbol_at);
+	mu_run_test(test_debug_symbols_cache);
+#endif
+	return tests_passed != tests_run;
+}
+
+mu_main(all_tests)
@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: 2023 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_core.h>
+#include "minunit.h"
+
+static bool test_core_lazy_instances(void) {
+	RzCore *core = rz_core_new();
+	mu_assert_notnull(core, "core");
+	mu_assert_null(core->egg, "egg not created at startup");
+	mu_assert_null(core->crypto, "crypto not created at startup");
+
+	rz_config_set(core->config, "asm.arch", "x86");
+	rz_config_set_i(core->config, "asm.bits", 32);
+	RzEgg *egg = rz_core_get_egg(core);
+	mu_assert_notnull(egg, "egg");
+	mu_assert_ptreq(rz_core_get_egg(core), egg, "egg created once");
+	mu_assert_eq(egg->bits, 32, "egg follows asm.bits");
+	RzCrypto *cry = rz_core_get_crypto(core);
+	mu_assert_notnull(cry, "crypto");
+	mu_assert_ptreq(rz_core_get_crypto(core), cry, "crypto created once");
+
+	// Both must be usable through the commands without any explicit setup
+	rz_core_free(core);
+	core = rz_core_new();
+	rz_core_cmd0(core, "o malloc://16");
+	char *out = rz_core_cmd_str(core, "wx 41414141; b 4; woE xor 01; p8 4");
+	mu_assert_streq_free(out, "40404040\n", "crypto through the commands");
+	mu_assert_notnull(core->crypto, "crypto created on demand");
+	rz_core_free(core);
+	mu_end;
+}
+
+static bool test_core_startup_time(void) {
+	RzCore *core = rz_core_new();
+	mu_assert_notnull(core, "core");
+	mu_assert_notnull(core->times, "times");
+	mu_assert_true(core->times->core_init_time > 0, "init time recorded");
+	mu_assert_true(core->times->cmd_init_time + core->times->config_init_time <= core->times->core_init_time, "stages are part of the init");
+	rz_core_free(core);
+	mu_end;
+}
+
+static int all_tests(void) {
+	mu_run_test(test_core_lazy_instances);
+	mu_run_test(test_core_startup_time);
+	return tests_passed != tests_run;
+}
+
+mu_main(all_tests)
@@ -52,9 +52,41 @@ bool test_rz_lzma_enc(void) {
 	mu_end;
 }
 
+static bool lzma_dec(const char *deflated, size_t size, const char *expected) {
+	RzBuffer *deflated_buf = rz_buf_new_with_bytes((const ut8 *)deflated, size);
+	RzBuffer *inflated_buf = rz_buf_new_empty(0);
+	bool ret = rz_lzma_dec_buf(deflated_buf, inflated_buf, 1 << 13, NULL);
+	if (ret) {
+		char *inflated = calloc(rz_buf_size(inflated_buf) + 1, sizeof(char));
+		rz_buf_read_at(inflated_buf, 0, (ut8 *)inflated, rz_buf_size(inflated_buf));
+		ret = inflated && !strcmp(inflated, expected);
+		free(inflated);
+	}
+	rz_buf_free(deflated_buf);
+	rz_buf_free(inflated_buf);
+	return ret;
+}
+
+bool test_rz_lzma_dec_auto(void) {
+	// legacy .lzma, as used for compressed kernels
+	static const char alone[] = "\x5d\x00\x00\x80\x00\xff\xff\xff\xff\xff\xff\xff\xff\x00\x18\x8c\x82\xb6\xc4\x11\x34\x5c\x4e\xe1\xd6\x5e\xd1\x46\xf2\x6e\xf8\x5b\xdf\x60\xc9\x34\x08\x05\x5f\xa3\xc3\x5d\x4c\xe6\xcd\x2d\x81\x37\xfe\x2c\x76\xd3\x09\xe7\xff\xff\xc9\x9d\x00\x00";
+	mu_assert_true(lzma_dec(alone, sizeof(alone) - 1, test_cases[2].inflated), "legacy lzma stream");
+
+	// xz with the 32 MiB dictionary of the kernels fits the memory limit
+	static const char xz_32m[] = "\xfd\x37\x7a\x58\x5a\x00\x00\x04\xe6\xd6\xb4\x46\x02\x00\x21\x01\x1a\x00\x00\x00\xcc\x90\x33\xe9\x01\x00\x24\x31\x32\x33\x34\x35\x36\x37\x38\x39\x30\x61\x62\x63\x64\x65\x66\x67\x68\x69\x6a\x6b\x6c\x6d\x6e\x6f\x70\x71\x72\x73\x74\x75\x76\x77\x78\x79\x7a\x0a\x00\x00\x00\x00\x93\xee\x03\x9e\xfe\xdb\xdd\xf8\x00\x01\x3d\x25\xd2\x29\x6a\x01\x1f\xb6\xf3\x7d\x01\x00\x00\x00\x00\x04\x59\x5a";
+	mu_assert_true(lzma_dec(xz_32m, sizeof(xz_32m) - 1, test_cases[2].inflated), "xz with a 32 MiB dictionary");
+
+	// a 128 MiB dictionary is above the limit
+	static const char xz_128m[] = "\xfd\x37\x7a\x58\x5a\x00\x00\x04\xe6\xd6\xb4\x46\x02\x00\x21\x01\x1e\x00\x00\x00\x9b\x07\x51\x66\x01\x00\x24\x31\x32\x33\x34\x35\x36\x37\x38\x39\x30\x61\x62\x63\x64\x65\x66\x67\x68\x69\x6a\x6b\x6c\x6d\x6e\x6f\x70\x71\x72\x73\x74\x75\x76\x77\x78\x79\x7a\x0a\x00\x00\x00\x00\x93\xee\x03\x9e\xfe\xdb\xdd\xf8\x00\x01\x3d\x25\xd2\x29\x6a\x01\x1f\xb6\xf3\x7d\x01\x00\x00\x00\x00\x04\x59\x5a";
+	mu_assert_false(lzma_dec(xz_128m, sizeof(xz_128m) - 1, test_cases[2].inflated), "xz with a 128 MiB dictionary");
+
+	mu_end;
+}
+
 int all_tests() {
 	mu_run_test(test_rz_lzma_dec);
 	mu_run_test(test_rz_lzma_enc);
+	mu_run_test(test_rz_lzma_dec_auto);
 
 	return tests_passed != tests_run;
 }
@@ -11,6 +11,7 @@
 #include <minunit.h>
 #include <rz_analysis.h>
 #include <rz_cons.h>
+#include <rz_core.h>
 #include <rz_util/rz_print.h>
 #include <rz_util/rz_str.h>
 
@@ -615,6 +616,105 @@ static bool test_rz_tokenize_custom_bf_0(void) {
 	mu_end;
 }
 
+static bool test_rz_tokenize_custom_x86_0(void) {
+	RzAsm *d = setup_x86_asm(64);
+	RzAsmOp *asmop = rz_asm_op_new();
+	// "mov eax, dword [rbp - 0x10]" 8b45f0
+	ut8 buf[] = "\x8b\x45\xf0";
+	rz_asm_disassemble(d, asmop, buf, sizeof(buf) - 1);
+	mu_assert_streq(rz_asm_op_get_asm(asmop), "mov eax, dword [rbp - 0x10]", "asm string");
+	mu_assert_notnull(asmop->asm_toks, "Tokens are set by the plugin");
+
+	RzAsmToken tokens[] = {
+		{ .start = 0, .len = 3, .type = RZ_ASM_TOKEN_MNEMONIC }, // mov
+		{ .start = 3, .len = 1, .type = RZ_ASM_TOKEN_SEPARATOR }, // \s
+		{ .start = 4, .len = 3, .type = RZ_ASM_TOKEN_REGISTER, .operand = 1, .operand_type = RZ_ASM_OPERAND_REG }, // eax
+		{ .start = 7, .len = 2, .type = RZ_ASM_TOKEN_SEPARATOR }, // ,\s
+		{ .start = 9, .len = 5, .type = RZ_ASM_TOKEN_UNKNOWN }, // dword
+		{ .start = 14, .len = 2, .type = RZ_ASM_TOKEN_SEPARATOR }, // \s[
+		{ .start = 16, .len = 3, .type = RZ_ASM_TOKEN_REGISTER, .operand = 2, .operand_type = RZ_ASM_OPERAND_MEM }, // rbp
+		{ .start = 19, .len = 1, .type = RZ_ASM_TOKEN_SEPARATOR }, // \s
+		{ .start = 20, .len = 1, .type = RZ_ASM_TOKEN_OPERATOR }, // -
+		{ .start = 21, .len = 1, .type = RZ_ASM_TOKEN_SEPARATOR }, // \s
+		{ .start = 22, .len = 4, .type = RZ_ASM_TOKEN_NUMBER, .val.number = 0x10, .operand = 2, .operand_type = RZ_ASM_OPERAND_MEM }, // 0x10
+		{ .start = 26, .len = 1, .type = RZ_ASM_TOKEN_SEPARATOR } // ]
+	};
+	mu_assert_eq(rz_vector_len(asmop->asm_toks->tokens), RZ_ARRAY_SIZE(tokens), "Number of generated tokens");
+
+	int i = 0;
+	RzAsmToken *it;
+	rz_vector_foreach(asmop->asm_toks->tokens, it) {
+		mu_assert_eq(it->start, tokens[i].start, "Token start");
+		mu_assert_eq(it->len, tokens[i].len, "Token length");
+		mu_assert_eq(it->type, tokens[i].type, "Token type");
+		mu_assert_eq(it->val.number, tokens[i].val.number, "Token value");
+		mu_assert_eq(it->operand, tokens[i].operand, "Token operand");
+		mu_assert_eq(it->operand_type, tokens[i].operand_type, "Token operand type");
+		++i;
+	}
+
+	rz_asm_op_free(asmop);
+	rz_asm_free(d);
+	mu_end;
+}
+
+static bool test_rz_tokenize_x86_decode_loop(void) {
+	RzAsm *d = setup_x86_asm(64);
+	RzAsmOp op;
+	// push rbp; mov rbp, rsp; mov eax, dword [rbp - 0x10]; pop rbp; ret
+	const ut8 buf[] = "\x55\x48\x89\xe5\x8b\x45\xf0\x5d\xc3";
+	const char *expect[] = { "push rbp", "mov rbp, rsp", "mov eax, dword [rbp - 0x10]", "pop rbp", "ret" };
+	rz_asm_op_init(&op);
+	int off = 0;
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(expect); i++) {
+		rz_asm_set_pc(d, off);
+		int len = rz_asm_disassemble(d, &op, buf + off, sizeof(buf) - 1 - off);
+		mu_assert_true(len > 0, "decoded");
+		mu_assert_streq(rz_asm_op_get_asm(&op), expect[i], "asm string");
+		mu_assert_notnull(op.asm_toks, "Tokens are set by the plugin");
+		// the tokens of every decode are owned by the op and released by fini
+		rz_asm_op_fini(&op);
+		mu_assert_null(op.asm_toks, "Tokens are released");
+		off += len;
+	}
+	rz_asm_op_fini(&op);
+
+	RzAsmCode *code = rz_asm_mdisassemble(d, buf, sizeof(buf) - 1);
+	mu_assert_notnull(code, "mdisassemble");
+	mu_assert_streq(code->assembly, "push rbp\nmov rbp, rsp\nmov eax, dword [rbp - 0x10]\npop rbp\nret\n", "assembly");
+	rz_asm_code_free(code);
+	rz_asm_free(d);
+	mu_end;
+}
+
+static bool test_rz_parse_filter_colored_tokens(void) {
+	RzCore *core = rz_core_new();
+	rz_config_set(core->config, "asm.arch", "x86");
+	rz_config_set_i(core->config, "asm.bits", 64);
+	rz_flag_set(core->flags, "obj.counter", 0x4010, 4);
+	RzPrint *p = setup_print();
+	RzAsmOp *asmop = rz_asm_op_new();
+	// "mov eax, dword [0x4010]" 8b042510400000
+	ut8 buf[] = "\x8b\x04\x25\x10\x40\x00\x00";
+	rz_asm_disassemble(core->rasm, asmop, buf, sizeof(buf) - 1);
+	mu_assert_streq(rz_asm_op_get_asm(asmop), "mov eax, dword [0x4010]", "asm string");
+	mu_assert_notnull(asmop->asm_toks, "Tokens are set by the plugin");
+
+	// The numbers are still taken from the tokens after coloring them
+	char *colored = rz_strbuf_drain(rz_asm_colorize_asm_str(&asmop->buf_asm, p, NULL, asmop->asm_toks));
+	mu_assert_notnull(strstr(colored, "\x1b["), "colored");
+	char out[256] = { 0 };
+	rz_parse_filter_tokens(core->parser, 0, core->flags, NULL, asmop->asm_toks, colored, out, sizeof(out), false);
+	char *expected = rz_str_replace(strdup(colored), "0x4010", "obj.counter", 0);
+	mu_assert_streq(out, expected, "flag substituted into the colored string");
+	free(expected);
+	free(colored);
+
+	rz_asm_op_free(asmop);
+	rz_core_free(core);
+	mu_end;
+}
+
 static int all_tests() {
 	mu_run_test(test_rz_tokenize_generic_0_no_reg_profile);
 	mu_run_test(test_rz_tokenize_generic_0);
@@ -633,6 +733,9 @@ static int all_tests() {
 	mu_run_test(test_rz_colorize_custom_hexagon_1);
 	mu_run_test(test_rz_colorize_custom_hexagon_2);
 	mu_run_test(test_rz_tokenize_custom_bf_0);
+	mu_run_test(test_rz_tokenize_custom_x86_0);
+	mu_run_test(test_rz_tokenize_x86_decode_loop);
+	mu_run_test(test_rz_parse_filter_colored_tokens);
 
 	return tests_passed != tests_run;
 }
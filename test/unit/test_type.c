@@ -969,6 +969,59 @@ static bool test_union_identifier_without_specifier(void) {
 	mu_end;
 }
 
+static bool test_type_expression_cache(void) {
+	RzTypeDB *typedb = rz_type_db_new();
+	mu_assert_notnull(typedb, "Couldn't create new RzTypeDB");
+	const char *types_dir = TEST_BUILD_TYPES_DIR;
+	rz_type_db_init(typedb, types_dir, "x86", 64, "linux");
+
+	int r = rz_type_parse_string(typedb, "struct bla { int a; };", NULL);
+	mu_assert_eq(r, 0, "parse struct definition");
+
+	static const char *exprs[][2] = {
+		{ "int", "int" },
+		{ "const char *", "const char *" },
+		{ "char * const", "char * const" },
+		{ "const char * const *", "const char * const *" },
+		{ "unsigned int", "unsigned int" },
+		{ "struct bla *", "struct bla *" },
+		{ "bla *[4]", "struct bla *[4]" },
+		{ "uint8_t [2][0x10]", "uint8_t [2][16]" },
+		{ "int a[65][5][0]", "int [65][5][0]" },
+	};
+	for (size_t i = 0; i < RZ_ARRAY_SIZE(exprs); i++) {
+		// Parse twice, the second one should come from the cache
+		RzType *first = rz_type_parse_string_single(typedb->parser, exprs[i][0], NULL);
+		mu_assert_notnull(first, "type parse successfull");
+		RzType *second = rz_type_parse_string_single(typedb->parser, exprs[i][0], NULL);
+		mu_assert_notnull(second, "cached type parse successfull");
+		mu_assert_ptrneq(first, second, "cached type is a copy");
+		mu_assert_true(rz_types_equal(first, second), "cached type is equal");
+		mu_assert_streq_free(rz_type_as_string(typedb, first), exprs[i][1], "type as string");
+		rz_type_free(first);
+		mu_assert_streq_free(rz_type_as_string(typedb, second), exprs[i][1], "cached type as string");
+		rz_type_free(second);
+	}
+
+	// Redefining the type must not return the stale cached expression
+	RzType *ttype = rz_type_parse_string_single(typedb->parser, "bla *", NULL);
+	mu_assert_notnull(ttype, "type parse successfull");
+	mu_assert_eq(ttype->pointer.type->identifier.kind, RZ_TYPE_IDENTIFIER_KIND_STRUCT, "struct identifier");
+	rz_type_free(ttype);
+	RzBaseType *btype = rz_type_db_get_base_type(typedb, "bla");
+	mu_assert_notnull(btype, "struct bla exists");
+	rz_type_db_delete_base_type(typedb, btype);
+	r = rz_type_parse_string(typedb, "union bla { int a; char b; };", NULL);
+	mu_assert_eq(r, 0, "parse union definition");
+	ttype = rz_type_parse_string_single(typedb->parser, "bla *", NULL);
+	mu_assert_notnull(ttype, "type parse successfull");
+	mu_assert_eq(ttype->pointer.type->identifier.kind, RZ_TYPE_IDENTIFIER_KIND_UNION, "union identifier");
+	rz_type_free(ttype);
+
+	rz_type_db_free(typedb);
+	mu_end;
+}
+
 static char *edit_array_old = "int a[65][5][0]";
 static char *edit_struct_array_ptr_old = "struct alb { const char *b; int * const *a[0][0][0][9]; }";
 static char *edit_struct_array_ptr_new = "struct alb { wchar_t * const b; int ***a[8][8][8]; float c; }";
@@ -1730,6 +1783,45 @@ bool test_callable_unspecified_parameters(void) {
 	mu_end;
 }
 
+static RzBaseType *struct_with_member(const char *name, const char *member_type, size_t offset) {
+	RzBaseType *btype = rz_type_base_type_new(RZ_BASE_TYPE_KIND_STRUCT);
+	btype->name = strdup(name);
+	btype->size = 64;
+	RzType *mtype = RZ_NEW0(RzType);
+	mtype->kind = RZ_TYPE_KIND_IDENTIFIER;
+	mtype->identifier.name = strdup(member_type);
+	RzTypeStructMember member = {
+		.name = strdup("m"),
+		.type = mtype,
+		.offset = offset,
+		.size = 32
+	};
+	rz_vector_push(&btype->struct_data.members, &member);
+	return btype;
+}
+
+bool test_base_type_structural_equal(void) {
+	RzBaseType *a = struct_with_member("S", "int", 0);
+	RzBaseType *b = struct_with_member("S", "int", 0);
+	mu_assert_true(rz_base_type_equal(a, b), "identical structs");
+	mu_assert_eq(rz_base_type_hash(a), rz_base_type_hash(b), "identical structs hash");
+
+	RzBaseType *c = struct_with_member("S", "int", 4);
+	mu_assert_false(rz_base_type_equal(a, c), "member offset differs");
+	RzBaseType *d = struct_with_member("S", "float", 0);
+	mu_assert_false(rz_base_type_equal(a, d), "member type differs");
+	mu_assert_neq(rz_base_type_hash(a), rz_base_type_hash(d), "member type hash");
+	RzBaseType *e = struct_with_member("T", "int", 0);
+	mu_assert_false(rz_base_type_equal(a, e), "name differs");
+
+	rz_type_base_type_free(a);
+	rz_type_base_type_free(b);
+	rz_type_base_type_free(c);
+	rz_type_base_type_free(d);
+	rz_type_base_type_free(e);
+	mu_end;
+}
+
 int all_tests() {
 	mu_run_test(test_types_get_base_type_struct);
 	mu_run_test(test_types_get_base_type_union);
@@ -1748,6 +1840,7 @@ int all_tests() {
 	mu_run_test(test_struct_array_types);
 	mu_run_test(test_struct_identifier_without_specifier);
 	mu_run_test(test_union_identifier_without_specifier);
+	mu_run_test(test_type_expression_cache);
 	mu_run_test(test_edit_types);
 	mu_run_test(test_references);
 	mu_run_test(test_addr_bits);
@@ -1759,6 +1852,7 @@ int all_tests() {
 	mu_run_test(test_path_by_offset_array);
 	mu_run_test(test_path_by_offset_typedef);
 	mu_run_test(test_callable_unspecified_parameters);
+	mu_run_test(test_base_type_structural_equal);
 	return tests_passed != tests_run;
 }
 
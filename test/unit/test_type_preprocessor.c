@@ -0,0 +1,217 @@
+// SPDX-FileCopyrightText: 2023 RizinOrg <info@rizin.re>
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include <rz_util.h>
+#include <rz_type.h>
+
+#include "test_config.h"
+#include "minunit.h"
+
+static char *preprocess(const char *cpu, int bits, const char *os, const char *code, char **error_msg) {
+	RzTypeTarget target = { .cpu = (char *)cpu, .bits = bits, .os = (char *)os };
+	RzTypePreprocessor *pp = rz_type_preprocessor_new(&target);
+	if (!pp) {
+		return NULL;
+	}
+	rz_type_preprocessor_define(pp, "FROM_API", NULL);
+	rz_type_preprocessor_define(pp, "TWICE(x)", "((x) * 2)");
+	char *out = rz_type_preprocess_string(pp, code, NULL, error_msg);
+	rz_type_preprocessor_free(pp);
+	return out;
+}
+
+static char *write_header(const char *content) {
+	char *path = NULL;
+	int fd = rz_file_mkstemp("rz_pp", &path);
+	if (fd == -1) {
+		return NULL;
+	}
+	rz_xwrite(fd, content, strlen(content));
+	close(fd);
+	return path;
+}
+
+static bool test_preprocess_object_macros(void) {
+	const char *code =
+		"#define N 4\n"
+		"#define T unsigned int\n"
+		"T arr[N];\n"
+		"#undef N\n"
+		"#ifdef N\n"
+		"int bad;\n"
+		"#endif\n";
+	mu_assert_streq_free(preprocess("x86", 64, "linux", code, NULL), "unsigned int arr[4];\n", "object-like macros");
+	mu_end;
+}
+
+static bool test_preprocess_function_macros(void) {
+	const char *code =
+		"#define STR(x) #x\n"
+		"#define CAT(a, b) a##b\n"
+		"#define LOG(fmt, ...) log(fmt, ##__VA_ARGS__)\n"
+		"const char *s = STR(a + b);\n"
+		"int CAT(foo, 42);\n"
+		"LOG(\"x\");\n"
+		"LOG(\"x\", 1, 2);\n"
+		"int y = TWICE(3);\n";
+	const char *expect =
+		"const char *s = \"a + b\";\n"
+		"int foo42;\n"
+		"log(\"x\");\n"
+		"log(\"x\",1, 2);\n"
+		"int y = ((3) * 2);\n";
+	mu_assert_streq_free(preprocess("x86", 64, "linux", code, NULL), expect, "function-like macros");
+
+	// The example from the C standard, the nested expansion must stop
+	code =
+		"#define f(a) a*g\n"
+		"#define g(a) f(a)\n"
+		"int x = f(2)(9);\n";
+	mu_assert_streq_free(preprocess("x86", 64, "linux", code, NULL), "int x = 2*9*g;\n", "rescanning");
+	mu_end;
+}
+
+static bool test_preprocess_conditions(void) {
+	const char *code =
+		"#if defined(__x86_64__) && __SIZEOF_POINTER__ == 8\n"
+		"int is64;\n"
+		"#elif defined(__i386__)\n"
+		"int is32;\n"
+		"#else\n"
+		"int other;\n"
+		"#endif\n"
+		"#if __SIZEOF_LONG__ == 4\n"
+		"int llp64;\n"
+		"#endif\n";
+	mu_assert_streq_free(preprocess("x86", 64, "linux", code, NULL), "int is64;\n", "linux x86_64");
+	mu_assert_streq_free(preprocess("x86", 32, "windows", code, NULL), "int is32;\nint llp64;\n", "windows x86");
+	mu_assert_streq_free(preprocess("arm", 64, "windows", code, NULL), "int other;\nint llp64;\n", "windows arm64");
+
+	code =
+		"#if FROM_API && (1 << 4) == 16 && !UNDEFINED && 'A' == 0x41\n"
+		"int api;\n"
+		"#endif\n";
+	mu_assert_streq_free(preprocess("x86", 64, "linux", code, NULL), "int api;\n", "expression");
+
+	code =
+		"#define SIZE_MAX 18446744073709551615UL\n"
+		"#if SIZE_MAX > 0xffffffff\n"
+		"int wide;\n"
+		"#endif\n"
+		"#if -1 > 0U && -1 < 0 && (-1 >> 1) == -1 && (-1U >> 63) == 1\n"
+		"int conversions;\n"
+		"#endif\n"
+		"#if (-9223372036854775807 - 1) / -1 < 0 && (-9223372036854775807 - 1) % -1 == 0\n"
+		"int overflow;\n"
+		"#endif\n";
+	mu_assert_streq_free(preprocess("x86", 64, "linux", code, NULL), "int wide;\nint conversions;\nint overflow;\n", "unsigned arithmetic");
+
+	char *error_msg = NULL;
+	char *out = preprocess("x86", 64, "linux", "#if 1\nint a;\n", &error_msg);
+	mu_assert_null(out, "unterminated conditional");
+	mu_assert_streq_free(error_msg, "<string>:3: unterminated conditional directive\n", "error message");
+	mu_end;
+}
+
+static bool test_preprocess_extensions(void) {
+	const char *code =
+		"struct s { int a; } __attribute__((packed));\n"
+		"__declspec(dllimport) int __cdecl f(void);\n";
+	mu_assert_streq_free(preprocess("x86", 64, "linux", code, NULL), "struct s { int a; } ;\n int  f(void);\n", "erased extensions");
+
+	// #error is reported, but the rest of the header is still useful
+	char *error_msg = NULL;
+	mu_assert_streq_free(preprocess("x86", 64, "linux", "#error nope\nint a;\n", &error_msg), "int a;\n", "#error");
+	mu_assert_streq_free(error_msg, "<string>:1: warning: #error nope\n", "#error message");
+	mu_end;
+}
+
+static bool test_preprocess_include(void) {
+	char *inner = write_header(
+		"#pragma once\n"
+		"struct inner { int x; };\n");
+	mu_assert_notnull(inner, "temporary header");
+	char *code = rz_str_newf(
+		"#include \"%s\"\n"
+		"#include \"%s\"\n"
+		"#if __has_include(\"%s\") && !__has_include(<surely_missing.h>)\n"
+		"int found;\n"
+		"#endif\n"
+		"#include <surely_missing.h>\n",
+		inner, inner, inner);
+	mu_assert_streq_free(preprocess("x86", 64, "linux", code, NULL), "struct inner { int x; };\nint found;\n", "included once");
+	free(code);
+	unlink(inner);
+	free(inner);
+	mu_end;
+}
+
+static bool test_parse_headers(void) {
+	RzTypeDB *typedb = rz_type_db_new();
+	mu_assert_notnull(typedb, "Couldn't create new RzTypeDB");
+	rz_type_db_init(typedb, TEST_BUILD_TYPES_DIR, "x86", 64, "linux");
+	RzTypePreprocessor *pp = rz_type_preprocessor_new(typedb->target);
+	mu_assert_notnull(pp, "preprocessor");
+
+	char *common = write_header(
+		"#ifndef COMMON_H\n"
+		"#define COMMON_H\n"
+		"#define COUNT 3\n"
+		"struct common { int v[COUNT]; };\n"
+		"#endif\n");
+	char *inc_a = rz_str_newf("#include \"%s\"\nstruct a { struct common c; };\nstruct clash { int x; };\n", common);
+	char *inc_b = rz_str_newf("#include \"%s\"\nstruct b { struct common *c; };\nstruct clash { char y; };\n", common);
+	char *a = write_header(inc_a);
+	char *b = write_header(inc_b);
+	free(inc_a);
+	free(inc_b);
+	mu_assert_true(common && a && b, "temporary headers");
+
+	RzPVector paths;
+	rz_pvector_init(&paths, NULL);
+	rz_pvector_push(&paths, a);
+	rz_pvector_push(&paths, b);
+	char *error_msg = NULL;
+	int failed = rz_type_parse_headers(typedb, pp, &paths, RZ_THREAD_POOL_ALL_CORES, &error_msg);
+	mu_assert_eq(failed, 0, "all headers parsed");
+
+	mu_assert_notnull(rz_type_db_get_struct(typedb, "a"), "struct a");
+	mu_assert_notnull(rz_type_db_get_struct(typedb, "b"), "struct b");
+	RzBaseType *btype = rz_type_db_get_struct(typedb, "common");
+	mu_assert_notnull(btype, "struct common");
+	RzTypeStructMember *member = rz_vector_head(&btype->struct_data.members);
+	mu_assert_streq_free(rz_type_as_string(typedb, member->type), "int [3]", "macro expanded");
+
+	// The first definition wins, the conflict is reported
+	btype = rz_type_db_get_struct(typedb, "clash");
+	mu_assert_notnull(btype, "struct clash");
+	member = rz_vector_head(&btype->struct_data.members);
+	mu_assert_streq(member->name, "x", "first definition");
+	mu_assert_notnull(error_msg, "conflict reported");
+	mu_assert_notnull(strstr(error_msg, "\"clash\""), "conflict reported");
+	mu_assert_null(strstr(error_msg, "\"common\""), "equal duplicates are not reported");
+	free(error_msg);
+
+	rz_pvector_fini(&paths);
+	unlink(common);
+	unlink(a);
+	unlink(b);
+	free(common);
+	free(a);
+	free(b);
+	rz_type_preprocessor_free(pp);
+	rz_type_db_free(typedb);
+	mu_end;
+}
+
+static int all_tests(void) {
+	mu_run_test(test_preprocess_object_macros);
+	mu_run_test(test_preprocess_function_macros);
+	mu_run_test(test_preprocess_conditions);
+	mu_run_test(test_preprocess_extensions);
+	mu_run_test(test_preprocess_include);
+	mu_run_test(test_parse_headers);
+	return tests_passed != tests_run;
+}
+
+mu_main(all_tests)